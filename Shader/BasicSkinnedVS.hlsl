@@ -0,0 +1,3 @@
+// スキンメッシュ用
+#define SKINNED 1
+#include "BasicVS.hlsl"
@@ -0,0 +1,40 @@
+// スカイマップから焼き込んだ環境光(EnvironmentLighting の定数と合わせる)
+cbuffer ENVIRONMENT_CONSTANT_BUFFER : register(b9)
+{
+    float4 environment_sh[9];   // コサインで畳み込んだ球面調和関数の係数(rgb)
+};
+
+// ミップ 0 はスカイマップ、ミップ 1 以降は粗さ(ミップ / (ミップ数 - 1))に合わせて GGX でぼかしたもの
+TextureCube<float4> environment_map : register(t19);
+
+// 法線方向の 放射照度 / π
+float3 EnvironmentIrradiance(float3 n)
+{
+    float3 result = environment_sh[0].rgb * 0.282095;
+    result += environment_sh[1].rgb * (0.488603 * n.y);
+    result += environment_sh[2].rgb * (0.488603 * n.z);
+    result += environment_sh[3].rgb * (0.488603 * n.x);
+    result += environment_sh[4].rgb * (1.092548 * n.x * n.y);
+    result += environment_sh[5].rgb * (1.092548 * n.y * n.z);
+    result += environment_sh[6].rgb * (0.315392 * (3.0 * n.z * n.z - 1.0));
+    result += environment_sh[7].rgb * (1.092548 * n.x * n.z);
+    result += environment_sh[8].rgb * (0.546274 * (n.x * n.x - n.y * n.y));
+    return max(result, 0.0);
+}
+
+// 反射方向の放射輝度を粗さに合ったミップから読む
+float3 EnvironmentRadiance(float3 r, float roughness, float mip_count, SamplerState sampler_state)
+{
+    return environment_map.SampleLevel(sampler_state, r, roughness * (mip_count - 1.0)).rgb;
+}
+
+// 鏡面反射の BRDF を視線と粗さで積分した値の近似(事前計算したテーブルの代わり)
+float3 EnvironmentBrdfApprox(float3 f0, float roughness, float NoV)
+{
+    const float4 c0 = float4(-1.0, -0.0275, -0.572, 0.022);
+    const float4 c1 = float4(1.0, 0.0425, 1.04, -0.04);
+    float4 r = roughness * c0 + c1;
+    float a004 = min(r.x * r.x, exp2(-9.28 * NoV)) * r.x + r.y;
+    float2 ab = float2(-1.04, 1.04) * a004 + r.zw;
+    return f0 * ab.x + ab.y;
+}
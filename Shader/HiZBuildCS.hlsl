@@ -0,0 +1,24 @@
+// 最大深度のミップを1段作る(HiZBuffer::CbHiZBuild)
+cbuffer CbHiZBuild : register(b0)
+{
+	uint2	sourceSize;
+	uint2	destinationSize;
+};
+
+Texture2D<float>	source		: register(t0);	// 深度バッファか1つ前のミップ
+RWTexture2D<float>	destination	: register(u0);
+
+// 2x2 の最大値で縮小する(端数の列と行は端を繰り返す)
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+	if (any(id.xy >= destinationSize)) return;
+
+	const uint2 s0 = id.xy * 2;
+	const uint2 s1 = min(s0 + 1, sourceSize - 1);
+	const float d00 = source.Load(int3(s0.x, s0.y, 0));
+	const float d10 = source.Load(int3(s1.x, s0.y, 0));
+	const float d01 = source.Load(int3(s0.x, s1.y, 0));
+	const float d11 = source.Load(int3(s1.x, s1.y, 0));
+	destination[id.xy] = max(max(d00, d10), max(d01, d11));
+}
@@ -1,19 +1,14 @@
-#include "Skinning.hlsli"
 #include "Lambert.hlsli"
+#include "ModelVertex.hlsli"
 
-VS_OUT main(
-	float4 position		: POSITION,
-	float4 boneWeights	: BONE_WEIGHTS,
-	uint4  boneIndices	: BONE_INDICES,
-	float2 texcoord		: TEXCOORD,
-	float3 normal		: NORMAL)
+VS_OUT main(MODEL_VS_IN vin)
 {
 	VS_OUT vout = (VS_OUT)0;
 
-	position = SkinningPosition(position, boneWeights, boneIndices);
+	float4 position = ModelPosition(vin);
 	vout.vertex = mul(position, viewProjection);
-	vout.texcoord = texcoord;
-	vout.normal = SkinningVector(normal, boneWeights, boneIndices);
+	vout.texcoord = vin.texcoord;
+	vout.normal = ModelVector(vin, DecodeNormal(vin));
 
 	return vout;
 }
@@ -0,0 +1,38 @@
+// クラスタ(画面のタイルと深度で分割した小区画)ごとに割り当てたライト
+// LightCuller の分割数と合わせる
+#define CLUSTER_COUNT_X 16
+#define CLUSTER_COUNT_Y 9
+#define CLUSTER_COUNT_Z 24
+
+struct PointLight
+{
+    float3 position;
+    float range;
+    float3 color;
+    float intensity;
+};
+
+struct SpotLight
+{
+    float3 position;
+    float range;
+    float3 direction;
+    float inner_cone_angle;
+    float3 color;
+    float outer_cone_angle;
+    float intensity;
+    float3 pad;
+};
+
+StructuredBuffer<PointLight> point_lights : register(t6);
+StructuredBuffer<SpotLight> spot_lights : register(t7);
+StructuredBuffer<uint2> light_clusters : register(t8);   // x: light_indices の先頭、y: 下位16bit 点光源の数、上位16bit スポットライトの数
+StructuredBuffer<uint> light_indices : register(t9);     // 点光源、スポットライトの順に並ぶ
+
+// ピクセル座標とビュー空間の深度からクラスタを求める
+uint2 GetLightCluster(float2 pixel, float depth, float2 tile_offset, float2 tile_scale, float depth_scale, float depth_bias)
+{
+    uint2 tile = (uint2) clamp((pixel - tile_offset) * tile_scale, 0.0, float2(CLUSTER_COUNT_X - 1, CLUSTER_COUNT_Y - 1));
+    uint slice = (uint) clamp(log(max(depth, 1e-4)) * depth_scale + depth_bias, 0.0, CLUSTER_COUNT_Z - 1);
+    return light_clusters[tile.x + (tile.y + slice * CLUSTER_COUNT_Y) * CLUSTER_COUNT_X];
+}
@@ -0,0 +1,39 @@
+// マテリアルテーブル(MaterialTable と合わせる)
+// テクスチャの番号は (配列の番号 << 16) | スライス
+// MATERIAL_TEXTURE_NONE はテクスチャなし、MATERIAL_TEXTURE_BOUND は描画ごとに material_textures に設定したテクスチャ
+#define MATERIAL_TEXTURE_NONE -1
+#define MATERIAL_TEXTURE_BOUND -2
+#define MATERIAL_TEXTURE_ARRAY_MAX 8
+
+#define BASECOLOR_TEXTURE 0
+#define METALLIC_ROUGHNESS_TEXTURE 1
+#define NORMAL_TEXTURE 2
+#define EMISSIVE_TEXTURE 3
+#define OCCLUSION_TEXTURE 4
+Texture2D<float4> material_textures[5] : register(t1);
+
+// 形式と大きさが同じテクスチャをまとめた配列
+Texture2DArray<float4> material_texture_arrays[MATERIAL_TEXTURE_ARRAY_MAX] : register(t11);
+
+// マテリアルのテクスチャをサンプリング(slot は material_textures の番号、index はマテリアルに書かれた番号)
+// 番号は描画ごとに同じなので、分岐しても勾配は正しく求まる
+float4 SampleMaterialTexture(uint slot, int index, SamplerState sampler_state, float2 texcoord)
+{
+    if (index == MATERIAL_TEXTURE_BOUND)
+    {
+        return material_textures[slot].Sample(sampler_state, texcoord);
+    }
+
+    const float3 uvw = float3(texcoord, index & 0xFFFF);
+    switch (index >> 16)
+    {
+    case 0: return material_texture_arrays[0].Sample(sampler_state, uvw);
+    case 1: return material_texture_arrays[1].Sample(sampler_state, uvw);
+    case 2: return material_texture_arrays[2].Sample(sampler_state, uvw);
+    case 3: return material_texture_arrays[3].Sample(sampler_state, uvw);
+    case 4: return material_texture_arrays[4].Sample(sampler_state, uvw);
+    case 5: return material_texture_arrays[5].Sample(sampler_state, uvw);
+    case 6: return material_texture_arrays[6].Sample(sampler_state, uvw);
+    default: return material_texture_arrays[7].Sample(sampler_state, uvw);
+    }
+}
@@ -0,0 +1,58 @@
+#include "Skinning.hlsli"
+
+// SKINNED が 1 ならボーンの重みと番号を持つ頂点形式
+#ifndef SKINNED
+#define SKINNED 0
+#endif
+
+// Model の圧縮頂点
+struct MODEL_VS_IN
+{
+	float3 position		: POSITION;
+	float2 normal		: NORMAL;		// 八面体写像
+	float4 tangent		: TANGENT;		// xy: 八面体写像、z: 従法線の向き
+	float2 texcoord		: TEXCOORD;
+#if SKINNED
+	float4 boneWeights	: BONE_WEIGHTS;
+	uint4  boneIndices	: BONE_INDICES;
+#endif
+};
+
+// 八面体写像から単位ベクトルに戻す
+float3 DecodeOctahedral(float2 e)
+{
+	float3 v = float3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	float t = saturate(-v.z);
+	v.xy += (v.xy >= 0.0) ? -t : t;
+	return normalize(v);
+}
+
+float3 DecodeNormal(MODEL_VS_IN vin)
+{
+	return DecodeOctahedral(vin.normal);
+}
+
+// w は従法線の向き
+float4 DecodeTangent(MODEL_VS_IN vin)
+{
+	return float4(DecodeOctahedral(vin.tangent.xy), vin.tangent.z < 0.0 ? -1.0 : 1.0);
+}
+
+// 静的メッシュはボーン行列の先頭にノードの行列が入っている
+float4 ModelPosition(MODEL_VS_IN vin)
+{
+#if SKINNED
+	return SkinningPosition(float4(vin.position, 1), vin.boneWeights, vin.boneIndices);
+#else
+	return mul(float4(vin.position, 1), GetBoneTransform(0));
+#endif
+}
+
+float3 ModelVector(MODEL_VS_IN vin, float3 vec)
+{
+#if SKINNED
+	return SkinningVector(vec, vin.boneWeights, vin.boneIndices);
+#else
+	return mul(float4(vec, 0), GetBoneTransform(0)).xyz;
+#endif
+}
@@ -0,0 +1,78 @@
+// 境界ボックスを最大深度のミップで判定する(OcclusionRasterizer::TestBox() と同じ判定)
+cbuffer CbOcclusionTest : register(b0)
+{
+	row_major float4x4	viewProjection;
+	float2				screenSize;		// 深度バッファの大きさ(ミップの level 0 はこの半分)
+	uint				mipCount;
+	uint				boxCount;
+};
+
+struct Box
+{
+	float3	center;
+	float	pad0;
+	float3	extents;
+	float	pad1;
+};
+
+Texture2D<float>			hiZ			: register(t0);
+StructuredBuffer<Box>		boxes		: register(t1);
+RWStructuredBuffer<uint>	visibility	: register(u0);
+
+// 判定に使うミップの1辺のテクセル数の上限
+static const int MaxTestTexels = 4;
+
+bool TestBox(Box box)
+{
+	// 8頂点を投影して、画面上の範囲と最も手前の深度を求める
+	float2 minScreen = float2(1e30, 1e30);
+	float2 maxScreen = float2(-1e30, -1e30);
+	float minZ = 1e30;
+	[unroll]
+	for (int i = 0; i < 8; ++i)
+	{
+		const float3 corner = box.center + box.extents * float3((i & 1) ? 1 : -1, (i & 2) ? 1 : -1, (i & 4) ? 1 : -1);
+		const float4 clip = mul(float4(corner, 1), viewProjection);
+
+		// 近クリップ面より手前にかかるボックスは隠れていないものとする
+		if (clip.w < 1e-4 || clip.z < 0) return true;
+
+		const float3 ndc = clip.xyz / clip.w;
+		const float2 screen = (ndc.xy * float2(0.5, -0.5) + 0.5) * screenSize;
+		minScreen = min(minScreen, screen);
+		maxScreen = max(maxScreen, screen);
+		minZ = min(minZ, ndc.z);
+	}
+
+	// 画面外の判定は視錐台カリングに任せる
+	if (any(maxScreen < 0) || any(minScreen >= screenSize)) return true;
+
+	// level 0 は深度バッファの半分なので、ピクセル座標を1段縮めてから始める
+	int2 p0 = (int2)floor(max(minScreen, 0)) >> 1;
+	int2 p1 = (int2)floor(min(maxScreen, screenSize - 1)) >> 1;
+	uint level = 0;
+	while (any(p1 - p0 >= MaxTestTexels) && level + 1 < mipCount)
+	{
+		p0 >>= 1;
+		p1 >>= 1;
+		++level;
+	}
+
+	// 範囲内の最も奥の深度より奥にあれば隠れている
+	float maxDepth = 0;
+	for (int y = p0.y; y <= p1.y; ++y)
+	{
+		for (int x = p0.x; x <= p1.x; ++x)
+		{
+			maxDepth = max(maxDepth, hiZ.Load(int3(x, y, level)));
+		}
+	}
+	return minZ <= maxDepth;
+}
+
+[numthreads(64, 1, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+	if (id.x >= boxCount) return;
+	visibility[id.x] = TestBox(boxes[id.x]) ? 1 : 0;
+}
@@ -4,4 +4,14 @@ cbuffer CbScene : register(b7)
 	float4				lightDirection;
 	float4				lightColor;
 	float4				cameraPosition;
+	float4				viewDepth;			// ビュー行列の z 列
+	float2				clusterTileScale;
+	float2				clusterTileOffset;
+	float				clusterDepthScale;
+	float				clusterDepthBias;
+	float				ambientIntensity;
+	float				exposure;
+	float				environmentMipCount;	// 環境光のキューブマップのミップ数(0 なら環境光なし)
+	float				environmentIntensity;
+	float2				environmentPad;
 };
@@ -0,0 +1,49 @@
+// カスケードシャドウマップ(ShadowMap の定数と合わせる)
+#define SHADOW_CASCADE_MAX 4
+
+cbuffer SHADOW_CONSTANT_BUFFER : register(b8)
+{
+    row_major float4x4 shadow_view_projection[SHADOW_CASCADE_MAX];
+    float4 shadow_split_far;        // カメラのビュー空間でのカスケードの終わりの深度
+    float4 shadow_texel_size;       // 1テクセルのワールド空間での大きさ
+    uint shadow_cascade_count;      // 0 なら影なし
+    float shadow_normal_offset;     // 受け側を法線方向にずらす量(テクセル単位)
+    float2 shadow_pad;
+};
+
+Texture2DArray<float> shadow_map : register(t10);
+SamplerComparisonState shadow_sampler : register(s3);
+
+// 平行光源の光が届く割合(0: 影、1: 影なし)
+// depth はカメラのビュー空間での深度、normal はワールド空間の面の法線
+float SampleShadow(float3 position, float3 normal, float depth)
+{
+    // 深度からカスケードを選ぶ(最後のカスケードより遠ければ影なし)
+    uint cascade = 0;
+    while (cascade < shadow_cascade_count && depth > shadow_split_far[cascade])
+    {
+        ++cascade;
+    }
+    if (cascade >= shadow_cascade_count)
+    {
+        return 1.0;
+    }
+
+    // 法線方向にずらして自分自身への影を防ぐ(ずらす量はカスケードのテクセルの大きさに合わせる)
+    const float3 offset_position = position + normal * (shadow_texel_size[cascade] * shadow_normal_offset);
+    const float4 clip = mul(float4(offset_position, 1.0), shadow_view_projection[cascade]);
+    const float2 uv = clip.xy * float2(0.5, -0.5) + 0.5;
+
+    // 3x3 の PCF(比較サンプラの線形補間と合わせて輪郭をぼかす)
+    float lit = 0.0;
+    [unroll]
+    for (int y = -1; y <= 1; ++y)
+    {
+        [unroll]
+        for (int x = -1; x <= 1; ++x)
+        {
+            lit += shadow_map.SampleCmpLevelZero(shadow_sampler, float3(uv, cascade), clip.z, int2(x, y));
+        }
+    }
+    return lit / 9.0;
+}
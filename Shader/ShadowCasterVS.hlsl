@@ -0,0 +1,13 @@
+#include "ModelVertex.hlsli"
+
+// カスケードのビュープロジェクション行列(ShadowMap::CbShadowCaster)
+cbuffer CbShadowCaster : register(b0)
+{
+	row_major float4x4	shadowViewProjection;
+};
+
+// 深度だけを書き込むのでピクセルシェーダーは使わない
+float4 main(MODEL_VS_IN vin) : SV_POSITION
+{
+	return mul(ModelPosition(vin), shadowViewProjection);
+}
@@ -1,11 +1,20 @@
+struct VS_IN
+{
+	float4 position : POSITION;
+	float4 world0   : WORLD0;		// インスタンスごとのワールド行列(行)
+	float4 world1   : WORLD1;
+	float4 world2   : WORLD2;
+	float4 world3   : WORLD3;
+	float4 color    : COLOR;
+};
+
 struct VS_OUT
 {
 	float4 position : SV_POSITION;
 	float4 color    : COLOR;
 };
 
-cbuffer CbMesh : register(b0)
+cbuffer CbScene : register(b0)
 {
-	row_major float4x4	worldViewProjection;
-	float4				color;
+	row_major float4x4	viewProjection;
 };
@@ -1,10 +1,12 @@
 #include "ShapeRenderer.hlsli"
 
-VS_OUT main(float4 position : POSITION)
+VS_OUT main(VS_IN vin)
 {
+	float4x4 world = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+
 	VS_OUT vout;
-	vout.position = mul(position, worldViewProjection);
-	vout.color = color;
+	vout.position = mul(mul(vin.position, world), viewProjection);
+	vout.color = vin.color;
 
 	return vout;
 }
@@ -1,8 +1,21 @@
+// ボーン行列は描画インスタンスごとに詰めたパレットに入っている
+struct BoneTransform
+{
+	row_major float4x4	transform;
+};
+StructuredBuffer<BoneTransform> bonePalette : register(t8);
+
 cbuffer CbSkeleton : register(b6)
 {
-	row_major float4x4	boneTransforms[256];
+	uint	boneOffset;		// このメッシュのボーン行列の先頭位置
+	uint3	skeletonPad;
 };
 
+float4x4 GetBoneTransform(uint index)
+{
+	return bonePalette[boneOffset + index].transform;
+}
+
 float4 SkinningPosition(float4 position, float4 boneWeights, uint4 boneIndices)
 {
 	float4 p = float4(0, 0, 0, 0);
@@ -10,7 +23,7 @@ float4 SkinningPosition(float4 position, float4 boneWeights, uint4 boneIndices)
 	[unroll]
 	for (int i = 0; i < 4; i++)
 	{
-		p += (boneWeights[i] * mul(position, boneTransforms[boneIndices[i]]));
+		p += (boneWeights[i] * mul(position, GetBoneTransform(boneIndices[i])));
 	}
 	return p;
 }
@@ -22,7 +35,7 @@ float3 SkinningVector(float3 vec, float4 boneWeights, uint4 boneIndices)
 	[unroll]
 	for (int i = 0; i < 4; i++)
 	{
-		v += boneWeights[i] * mul(float4(vec, 0), boneTransforms[boneIndices[i]]).xyz;
+		v += boneWeights[i] * mul(float4(vec, 0), GetBoneTransform(boneIndices[i])).xyz;
 	}
 	return v;
 }
@@ -1,4 +1,4 @@
-// _VF[_[o̓f[^
+// 頂点シェーダー出力データ
 struct VS_OUT
 {
 	float4 position : SV_POSITION;
@@ -1,6 +1,6 @@
 #include "Sprite.hlsli"
 
-// _VF[_[Gg|Cg
+// 頂点シェーダーエントリポイント
 VS_OUT main(float4 position : POSITION, float4 color : COLOR, float2 texcoord : TEXCOORD)
 {
 	VS_OUT vout;
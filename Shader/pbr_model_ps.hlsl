@@ -1,4 +1,5 @@
 #include "bidirectional_reflectance_distribution_function.hlsli"
+#include "MaterialTable.hlsli"
 
 struct VS_OUT
 {
@@ -9,11 +10,23 @@ struct VS_OUT
     float2 texcoord : TEXCOORD;
 };
 
-cbuffer SCENE_CONSTANT_BUFFER : register(b1)
+// Scene.hlsli の CbScene と同じ配置
+cbuffer SCENE_CONSTANT_BUFFER : register(b7)
 {
     row_major float4x4 view_projection;
     float4 light_direction;
+    float4 light_color;
     float4 camera_position;
+    float4 view_depth;
+    float2 cluster_tile_scale;
+    float2 cluster_tile_offset;
+    float cluster_depth_scale;
+    float cluster_depth_bias;
+    float ambient_intensity;
+    float exposure;
+    float environment_mip_count;
+    float environment_intensity;
+    float2 environment_pad;
 };
 
 struct texture_info
@@ -63,20 +76,11 @@ cbuffer PRIMITIVE_CONSTANT_BUFFER : register(b0)
 {
     row_major float4x4 world;
     int material;
-    bool has_tangent;
-    int skin;
-    int pad;
+    int3 pad;
 };
 
 StructuredBuffer<material_constants> materials : register(t0);
 
-#define BASECOLOR_TEXTURE 0
-#define METALLIC_ROUGHNESS_TEXTURE 1
-#define NORMAL_TEXTURE 2
-#define EMISSIVE_TEXTURE 3
-#define OCCLUSION_TEXTURE 4
-Texture2D<float4> material_textures[5] : register(t1);
-
 #define POINT 0
 #define LINEAR 1
 #define ANISOTROPIC 2
@@ -90,18 +94,18 @@ float4 main(VS_OUT pin) : SV_TARGET
     
     float4 basecolor_factor = m.pbr_metallic_roughness.basecolor_factor;
     const int basecolor_texture = m.pbr_metallic_roughness.basecolor_texture.index;
-    if (basecolor_texture > -1)
+    if (basecolor_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[BASECOLOR_TEXTURE].Sample(sampler_states[ANISOTROPIC], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(BASECOLOR_TEXTURE, basecolor_texture, sampler_states[ANISOTROPIC], pin.texcoord);
         sampled.rgb = pow(sampled.rgb, GAMMA);
         basecolor_factor *= sampled;
     }
     
     float3 emmisive_factor = m.emissive_factor;
     const int emissive_texture = m.emissive_texture.index;
-    if (emissive_texture > -1)
+    if (emissive_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[EMISSIVE_TEXTURE].Sample(sampler_states[ANISOTROPIC], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(EMISSIVE_TEXTURE, emissive_texture, sampler_states[ANISOTROPIC], pin.texcoord);
         sampled.rgb = pow(sampled.rgb, GAMMA);
         emmisive_factor *= sampled.rgb;
     }
@@ -109,18 +113,18 @@ float4 main(VS_OUT pin) : SV_TARGET
     float roughness_factor = m.pbr_metallic_roughness.roughness_factor;
     float metallic_factor = m.pbr_metallic_roughness.metallic_factor;
     const int metallic_roughness_texture = m.pbr_metallic_roughness.metallic_roughness_texture.index;
-    if (metallic_roughness_texture > -1)
+    if (metallic_roughness_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[METALLIC_ROUGHNESS_TEXTURE].Sample(sampler_states[LINEAR], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(METALLIC_ROUGHNESS_TEXTURE, metallic_roughness_texture, sampler_states[LINEAR], pin.texcoord);
         roughness_factor *= sampled.g;
         metallic_factor *= sampled.b;
     }
     
     float occlusion_factor = 1.0;
     const int occlusion_texture = m.occlusion_texture.index;
-    if (occlusion_texture > -1)
+    if (occlusion_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[OCCLUSION_TEXTURE].Sample(sampler_states[LINEAR], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(OCCLUSION_TEXTURE, occlusion_texture, sampler_states[LINEAR], pin.texcoord);
         occlusion_factor *= sampled.r;
     }
     const float occlusion_strength = m.occlusion_texture.strength;
@@ -134,15 +138,15 @@ float4 main(VS_OUT pin) : SV_TARGET
     const float3 V = normalize(camera_position.xyz - pin.w_position.xyz);
     
     float3 N = normalize(pin.w_normal.xyz);
-    float3 T = has_tangent ? normalize(pin.w_tangent.xyz) : float3(1, 0, 0);
-    float sigma = has_tangent ? pin.w_tangent.w : 1.0;
+    float3 T = normalize(pin.w_tangent.xyz);
+    float sigma = pin.w_tangent.w;
     T = normalize(T - N * dot(N, T));
     float3 B = normalize(cross(N, T) * sigma);
     
     const int normal_texture = m.normal_texture.index;
-    if (normal_texture > -1)
+    if (normal_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[NORMAL_TEXTURE].Sample(sampler_states[LINEAR], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(NORMAL_TEXTURE, normal_texture, sampler_states[LINEAR], pin.texcoord);
         float3 normal_factor = sampled.xyz;
         normal_factor = (normal_factor * 2.0) - 1.0;
         normal_factor = normalize(normal_factor * float3(m.normal_texture.scale, m.normal_texture.scale, 1.0));
@@ -174,9 +178,9 @@ float4 main(VS_OUT pin) : SV_TARGET
     
     float3 Lo = diffuse + specular + emmisive;
 
-    // ǉiÂꍇ̑΍j
+    // 環境光を追加（暗すぎる場合の対策）
     {
-        float3 ambient = basecolor_factor.rgb * 0.3; // 10%̊
+        float3 ambient = basecolor_factor.rgb * 0.3; // 10%の環境光
         Lo += ambient;
     }
 
@@ -1,4 +1,21 @@
+// パーミュテーション(PBRShader::PixelPermutation と合わせる)
+// 組み合わせごとに define を書いた pbr_model_ps_maya_style_*.hlsl からこのファイルを #include する
+// 何も定義しなければ、法線マップあり、アルファテストなし、点光源とスポットライトあり
+#ifndef NORMAL_MAP
+#define NORMAL_MAP 1        // 法線マップを使う
+#endif
+#ifndef ALPHA_MASK
+#define ALPHA_MASK 0        // アルファテストで切り抜く(MASK のマテリアル)
+#endif
+#ifndef LOCAL_LIGHTS
+#define LOCAL_LIGHTS 1      // クラスタに割り当てた点光源とスポットライトを計算する
+#endif
+
 #include "bidirectional_reflectance_distribution_function.hlsli"
+#include "MaterialTable.hlsli"
+#include "LightCluster.hlsli"
+#include "Shadow.hlsli"
+#include "Environment.hlsli"
 
 #define GAMMA 2.2
 
@@ -32,37 +49,23 @@ struct VS_OUT
     float2 texcoord : TEXCOORD;
 };
 
-struct PointLight
-{
-    float3 position;
-    float range;
-    float3 color;
-    float intensity;
-};
-
-struct SpotLight
-{
-    float3 position;
-    float range;
-    float3 direction;
-    float inner_cone_angle;
-    float3 color;
-    float outer_cone_angle;
-    float intensity;
-    float3 pad;
-};
-
-cbuffer SCENE_CONSTANT_BUFFER : register(b1)
+// Scene.hlsli の CbScene と同じ配置
+cbuffer SCENE_CONSTANT_BUFFER : register(b7)
 {
     row_major float4x4 view_projection;
     float4 light_direction;
+    float4 light_color;
     float4 camera_position;
+    float4 view_depth;
+    float2 cluster_tile_scale;
+    float2 cluster_tile_offset;
+    float cluster_depth_scale;
+    float cluster_depth_bias;
     float ambient_intensity;
     float exposure;
-    int point_light_count;
-    int spot_light_count;
-    PointLight point_lights[8];
-    SpotLight spot_lights[4];
+    float environment_mip_count;
+    float environment_intensity;
+    float2 environment_pad;
 };
 
 struct TextureInfo
@@ -112,20 +115,11 @@ cbuffer PRIMITIVE_CONSTANT_BUFFER : register(b0)
 {
     row_major float4x4 world;
     int material;
-    bool has_tangent;
-    int skin;
-    int pad;
+    int3 pad;
 };
 
 StructuredBuffer<MaterialConstants> materials : register(t0);
 
-#define BASECOLOR_TEXTURE 0
-#define METALLIC_ROUGHNESS_TEXTURE 1
-#define NORMAL_TEXTURE 2
-#define EMISSIVE_TEXTURE 3
-#define OCCLUSION_TEXTURE 4
-Texture2D<float4> material_textures[5] : register(t1);
-
 #define POINT 0
 #define LINEAR 1
 #define ANISOTROPIC 2
@@ -157,6 +151,18 @@ float3 CalculateAmbientIbl(float3 N, float3 V, float3 basecolor, float metallic,
     return (diffuse_ibl + specular_ibl) * intensity;
 }
 
+// 焼き込んだ環境光(拡散反射は球面調和関数、鏡面反射はぼかしたキューブマップ)
+float3 CalculateEnvironmentIbl(float3 N, float3 V, float3 c_diff, float3 f0, float roughness, float intensity)
+{
+    float NoV = max(0.0, dot(N, V));
+    float3 R = reflect(-V, N);
+    
+    float3 diffuse_ibl = c_diff * EnvironmentIrradiance(N);
+    float3 specular_ibl = EnvironmentRadiance(R, roughness, environment_mip_count, sampler_states[LINEAR]) * EnvironmentBrdfApprox(f0, roughness, NoV);
+    
+    return (diffuse_ibl + specular_ibl) * intensity;
+}
+
 float3 CalculateRimLight(float3 N, float3 V, float3 basecolor, float intensity)
 {
     float rim = 1.0 - max(0.0, dot(N, V));
@@ -170,18 +176,22 @@ float4 main(VS_OUT pin) : SV_TARGET
     
     float4 basecolor_factor = m.pbr_metallic_roughness.basecolor_factor;
     const int basecolor_texture = m.pbr_metallic_roughness.basecolor_texture.index;
-    if (basecolor_texture > -1)
+    if (basecolor_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[BASECOLOR_TEXTURE].Sample(sampler_states[ANISOTROPIC], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(BASECOLOR_TEXTURE, basecolor_texture, sampler_states[ANISOTROPIC], pin.texcoord);
         sampled.rgb = pow(sampled.rgb, GAMMA);
         basecolor_factor *= sampled;
     }
     
+#if ALPHA_MASK
+    clip(basecolor_factor.a - m.alpha_cutoff);
+#endif
+    
     float3 emissive_factor = m.emissive_factor;
     const int emissive_texture = m.emissive_texture.index;
-    if (emissive_texture > -1)
+    if (emissive_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[EMISSIVE_TEXTURE].Sample(sampler_states[ANISOTROPIC], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(EMISSIVE_TEXTURE, emissive_texture, sampler_states[ANISOTROPIC], pin.texcoord);
         sampled.rgb = pow(sampled.rgb, GAMMA);
         emissive_factor *= sampled.rgb;
     }
@@ -189,18 +199,18 @@ float4 main(VS_OUT pin) : SV_TARGET
     float roughness_factor = m.pbr_metallic_roughness.roughness_factor;
     float metallic_factor = m.pbr_metallic_roughness.metallic_factor;
     const int metallic_roughness_texture = m.pbr_metallic_roughness.metallic_roughness_texture.index;
-    if (metallic_roughness_texture > -1)
+    if (metallic_roughness_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[METALLIC_ROUGHNESS_TEXTURE].Sample(sampler_states[LINEAR], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(METALLIC_ROUGHNESS_TEXTURE, metallic_roughness_texture, sampler_states[LINEAR], pin.texcoord);
         roughness_factor *= sampled.g;
         metallic_factor *= sampled.b;
     }
     
     float occlusion_factor = 1.0;
     const int occlusion_texture = m.occlusion_texture.index;
-    if (occlusion_texture > -1)
+    if (occlusion_texture != MATERIAL_TEXTURE_NONE)
     {
-        float4 sampled = material_textures[OCCLUSION_TEXTURE].Sample(sampler_states[LINEAR], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(OCCLUSION_TEXTURE, occlusion_texture, sampler_states[LINEAR], pin.texcoord);
         occlusion_factor *= sampled.r;
     }
     const float occlusion_strength = m.occlusion_texture.strength;
@@ -214,26 +224,31 @@ float4 main(VS_OUT pin) : SV_TARGET
     const float3 V = normalize(camera_position.xyz - pin.w_position.xyz);
     
     float3 N = normalize(pin.w_normal.xyz);
-    float3 T = has_tangent ? normalize(pin.w_tangent.xyz) : float3(1, 0, 0);
-    float sigma = has_tangent ? pin.w_tangent.w : 1.0;
+#if NORMAL_MAP
+    // 接線はインポート時に必ず作るので、法線マップのあるマテリアルだけが接空間を組み立てる
+    float3 T = normalize(pin.w_tangent.xyz);
+    float sigma = pin.w_tangent.w;
     T = normalize(T - N * dot(N, T));
     float3 B = normalize(cross(N, T) * sigma);
     
-    const int normal_texture = m.normal_texture.index;
-    if (normal_texture > -1)
     {
-        float4 sampled = material_textures[NORMAL_TEXTURE].Sample(sampler_states[LINEAR], pin.texcoord);
+        float4 sampled = SampleMaterialTexture(NORMAL_TEXTURE, m.normal_texture.index, sampler_states[LINEAR], pin.texcoord);
         float3 normal_factor = sampled.xyz;
         normal_factor = (normal_factor * 2.0) - 1.0;
         normal_factor = normalize(normal_factor * float3(m.normal_texture.scale, m.normal_texture.scale, 1.0));
         N = normalize((normal_factor.x * T) + (normal_factor.y * B) + (normal_factor.z * N));
     }
+#endif
     
     float3 diffuse = 0;
     float3 specular = 0;
     
+    // カメラのビュー空間での深度(影のカスケードとライトのクラスタの選択に使う)
+    const float depth = dot(float4(P, 1.0), view_depth);
+    
     float3 L = normalize(-light_direction.xyz);
     float3 Li = float3(DIRECTIONAL_LIGHT_R, DIRECTIONAL_LIGHT_G, DIRECTIONAL_LIGHT_B);
+    Li *= SampleShadow(P, normalize(pin.w_normal.xyz), depth);
     const float NoL = max(0.0, dot(N, L));
     const float NoV = max(0.0, dot(N, V));
     if (NoL > 0.0 || NoV > 0.0)
@@ -246,17 +261,24 @@ float4 main(VS_OUT pin) : SV_TARGET
         specular += Li * NoL * brdf_specular_ggx(f0, f90, alpha_roughness, HoV, NoL, NoV, NoH);
     }
     
-    for (int i = 0; i < point_light_count; ++i)
+#if LOCAL_LIGHTS
+    // このピクセルが属するクラスタに割り当てられたライトだけを計算する
+    const uint2 cluster = GetLightCluster(pin.position.xy, depth, cluster_tile_offset, cluster_tile_scale, cluster_depth_scale, cluster_depth_bias);
+    const uint point_light_count = cluster.y & 0xFFFF;
+    const uint spot_light_count = cluster.y >> 16;
+    
+    for (uint i = 0; i < point_light_count; ++i)
     {
-        float3 light_vec = point_lights[i].position - P;
+        const PointLight point_light = point_lights[light_indices[cluster.x + i]];
+        float3 light_vec = point_light.position - P;
         float distance = length(light_vec);
-        float attenuation = saturate(1.0 - (distance / point_lights[i].range));
+        float attenuation = saturate(1.0 - (distance / point_light.range));
         attenuation *= attenuation;
         
         if (attenuation > 0.0)
         {
             float3 point_L = normalize(light_vec);
-            float3 point_Li = point_lights[i].color * point_lights[i].intensity * attenuation;
+            float3 point_Li = point_light.color * point_light.intensity * attenuation;
             
             const float point_NoL = max(0.0, dot(N, point_L));
             if (point_NoL > 0.0)
@@ -271,27 +293,28 @@ float4 main(VS_OUT pin) : SV_TARGET
         }
     }
     
-    for (int j = 0; j < spot_light_count; ++j)
+    for (uint j = 0; j < spot_light_count; ++j)
     {
-        float3 light_vec = spot_lights[j].position - P;
+        const SpotLight spot_light = spot_lights[light_indices[cluster.x + point_light_count + j]];
+        float3 light_vec = spot_light.position - P;
         float distance = length(light_vec);
         
-        if (distance < spot_lights[j].range)
+        if (distance < spot_light.range)
         {
             float3 spot_L = normalize(light_vec);
-            float3 spot_dir = normalize(spot_lights[j].direction);
+            float3 spot_dir = normalize(spot_light.direction);
             
             float theta = dot(spot_L, -spot_dir);
-            float inner_cutoff = cos(spot_lights[j].inner_cone_angle);
-            float outer_cutoff = cos(spot_lights[j].outer_cone_angle);
+            float inner_cutoff = cos(spot_light.inner_cone_angle);
+            float outer_cutoff = cos(spot_light.outer_cone_angle);
             
             float epsilon = inner_cutoff - outer_cutoff;
             float spot_intensity = saturate((theta - outer_cutoff) / epsilon);
             
-            float attenuation = saturate(1.0 - (distance / spot_lights[j].range));
+            float attenuation = saturate(1.0 - (distance / spot_light.range));
             attenuation *= attenuation;
             
-            float3 spot_Li = spot_lights[j].color * spot_lights[j].intensity * attenuation * spot_intensity;
+            float3 spot_Li = spot_light.color * spot_light.intensity * attenuation * spot_intensity;
             
             const float spot_NoL = max(0.0, dot(N, spot_L));
             if (spot_NoL > 0.0 && spot_intensity > 0.0)
@@ -305,8 +328,17 @@ float4 main(VS_OUT pin) : SV_TARGET
             }
         }
     }
+#endif
     
-    float3 ambient_ibl = CalculateAmbientIbl(N, V, basecolor_factor.rgb, metallic_factor, roughness_factor, ambient_intensity);
+    float3 ambient_ibl;
+    if (environment_mip_count > 0.0)
+    {
+        ambient_ibl = CalculateEnvironmentIbl(N, V, c_diff, f0, roughness_factor, environment_intensity);
+    }
+    else
+    {
+        ambient_ibl = CalculateAmbientIbl(N, V, basecolor_factor.rgb, metallic_factor, roughness_factor, ambient_intensity);
+    }
     float3 rim_light = CalculateRimLight(N, V, basecolor_factor.rgb, ambient_intensity);
     
     float3 emissive = emissive_factor;
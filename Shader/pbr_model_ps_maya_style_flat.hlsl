@@ -0,0 +1,3 @@
+// 法線マップなし
+#define NORMAL_MAP 0
+#include "pbr_model_ps_maya_style.hlsl"
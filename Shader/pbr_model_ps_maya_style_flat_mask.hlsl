@@ -0,0 +1,4 @@
+// 法線マップなし、アルファテストあり
+#define NORMAL_MAP 0
+#define ALPHA_MASK 1
+#include "pbr_model_ps_maya_style.hlsl"
@@ -0,0 +1,5 @@
+// 法線マップなし、アルファテストあり、点光源とスポットライトなし
+#define NORMAL_MAP 0
+#define ALPHA_MASK 1
+#define LOCAL_LIGHTS 0
+#include "pbr_model_ps_maya_style.hlsl"
@@ -0,0 +1,4 @@
+// 法線マップなし、点光源とスポットライトなし
+#define NORMAL_MAP 0
+#define LOCAL_LIGHTS 0
+#include "pbr_model_ps_maya_style.hlsl"
@@ -0,0 +1,3 @@
+// アルファテストあり
+#define ALPHA_MASK 1
+#include "pbr_model_ps_maya_style.hlsl"
@@ -0,0 +1,4 @@
+// アルファテストあり、点光源とスポットライトなし
+#define ALPHA_MASK 1
+#define LOCAL_LIGHTS 0
+#include "pbr_model_ps_maya_style.hlsl"
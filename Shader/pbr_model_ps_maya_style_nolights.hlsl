@@ -0,0 +1,3 @@
+// 点光源とスポットライトなし
+#define LOCAL_LIGHTS 0
+#include "pbr_model_ps_maya_style.hlsl"
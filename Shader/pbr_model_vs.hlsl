@@ -1,12 +1,4 @@
-struct VS_IN
-{
-    float4 position : POSITION;
-    float4 normal : NORMAL;
-    float4 tangent : TANGENT;
-    float2 texcoord : TEXCOORD;
-    float4 bone_weights : BONE_WEIGHTS;
-    uint4 bone_indices : BONE_INDICES;
-};
+#include "ModelVertex.hlsli"
 
 struct VS_OUT
 {
@@ -21,33 +13,41 @@ cbuffer PRIMITIVE_CONSTANT_BUFFER : register(b0)
 {
     row_major float4x4 world;
     int material;
-    bool has_tangent;
-    int skin;
-    int pad;
+    int3 pad;
 };
 
-cbuffer SCENE_CONSTANT_BUFFER : register(b1)
+// Scene.hlsli の CbScene と同じ配置
+cbuffer SCENE_CONSTANT_BUFFER : register(b7)
 {
     row_major float4x4 view_projection;
     float4 light_direction;
+    float4 light_color;
     float4 camera_position;
+    float4 view_depth;
+    float2 cluster_tile_scale;
+    float2 cluster_tile_offset;
+    float cluster_depth_scale;
+    float cluster_depth_bias;
+    float ambient_intensity;
+    float exposure;
+    float environment_mip_count;
+    float environment_intensity;
+    float2 environment_pad;
 };
 
-VS_OUT main(VS_IN vin)
+VS_OUT main(MODEL_VS_IN vin)
 {
     VS_OUT vout;
     
-    vin.position.w = 1;
-    vout.position = mul(vin.position, mul(world, view_projection));
-    vout.w_position = mul(vin.position, world);
+    // ワールド変換はインスタンスごとのボーン行列パレットから取る(静的メッシュはノードの行列)
+    float4 position = ModelPosition(vin);
+    vout.position = mul(position, view_projection);
+    vout.w_position = position;
     
-    vin.normal.w = 0;
-    vout.w_normal = normalize(mul(vin.normal, world));
+    vout.w_normal = float4(normalize(ModelVector(vin, DecodeNormal(vin))), 0);
     
-    float sigma = vin.tangent.w;
-    vin.tangent.w = 0;
-    vout.w_tangent = normalize(mul(vin.tangent, world));
-    vout.w_tangent.w = sigma;
+    float4 tangent = DecodeTangent(vin);
+    vout.w_tangent = float4(normalize(ModelVector(vin, tangent.xyz)), tangent.w);
     
     vout.texcoord = vin.texcoord;
     
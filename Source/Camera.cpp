@@ -1,38 +1,38 @@
 #include "Camera.h"
 
-// RXgN^
+// コンストラクタ
 Camera::Camera()
 {
-	// Jݒ
+	// カメラ設定
 	SetPerspectiveFov(
-		DirectX::XMConvertToRadians(45),	// p
-		1920.0f / 1080.0f,					// ʃAXyNg
-		0.1f,								// jANbv
-		1000.0f								// t@[Nbv
+		DirectX::XMConvertToRadians(45),	// 画角
+		1920.0f / 1080.0f,					// 画面アスペクト比
+		0.1f,								// ニアクリップ
+		1000.0f								// ファークリップ
 	);
 	SetLookAt(
-		{ 0, 0, -5 },		// _
-		{ 0, 0, 0 },		// _
-		{ 0, 1, 0 }			// xNg
+		{ 0, 0, -5 },		// 視点
+		{ 0, 0, 0 },		// 注視点
+		{ 0, 1, 0 }			// 上ベクトル
 	);
 }
 
-// w
+// 指定方向を向く
 void Camera::SetLookAt(const DirectX::XMFLOAT3& eye, const DirectX::XMFLOAT3& focus, const DirectX::XMFLOAT3& up)
 {
-	// _A_Ar[s쐬
+	// 視点、注視点、上方向からビュー行列を作成
 	DirectX::XMVECTOR Eye = DirectX::XMLoadFloat3(&eye);
 	DirectX::XMVECTOR Focus = DirectX::XMLoadFloat3(&focus);
 	DirectX::XMVECTOR Up = DirectX::XMLoadFloat3(&up);
 	DirectX::XMMATRIX View = DirectX::XMMatrixLookAtLH(Eye, Focus, Up);
 	DirectX::XMStoreFloat4x4(&view, View);
 
-	// r[ts񉻂A[hsɖ߂
+	// ビューを逆行列化し、ワールド行列に戻す
 	DirectX::XMMATRIX World = DirectX::XMMatrixInverse(nullptr, View);
 	DirectX::XMFLOAT4X4 world;
 	DirectX::XMStoreFloat4x4(&world, World);
 
-	// J̕o
+	// カメラの方向を取り出す
 	this->right.x = world._11;
 	this->right.y = world._12;
 	this->right.z = world._13;
@@ -45,15 +45,15 @@ void Camera::SetLookAt(const DirectX::XMFLOAT3& eye, const DirectX::XMFLOAT3& fo
 	this->front.y = world._32;
 	this->front.z = world._33;
 
-	// _A_ۑ
+	// 視点、注視点を保存
 	this->eye = eye;
 	this->focus = focus;
 }
 
-// p[XyNeBuݒ
+// パースペクティブ設定
 void Camera::SetPerspectiveFov(float fovY, float aspect, float nearZ, float farZ)
 {
-	// pAʔ䗦ANbvvWFNVs쐬
+	// 画角、画面比率、クリップ距離からプロジェクション行列を作成
 	DirectX::XMMATRIX Projection = DirectX::XMMatrixPerspectiveFovLH(fovY, aspect, nearZ, farZ);
 	DirectX::XMStoreFloat4x4(&projection, Projection);
 }
@@ -2,37 +2,37 @@
 
 #include <DirectXMath.h>
 
-// J
+// カメラ
 class Camera
 {
 public:
 	Camera();
 
-	// w
+	// 指定方向を向く
 	void SetLookAt(const DirectX::XMFLOAT3& eye, const DirectX::XMFLOAT3& focus, const DirectX::XMFLOAT3& up);
 
-	// p[XyNeBuݒ
+	// パースペクティブ設定
 	void SetPerspectiveFov(float fovY, float aspect, float nearZ, float farZ);
 
-	// r[s擾
+	// ビュー行列取得
 	const DirectX::XMFLOAT4X4& GetView() const { return view; }
 
-	// vWFNVs擾
+	// プロジェクション行列取得
 	const DirectX::XMFLOAT4X4& GetProjection() const { return projection; }
 
-	// _擾
+	// 視点取得
 	const DirectX::XMFLOAT3& GetEye() const { return eye; }
 
-	// _擾
+	// 注視点取得
 	const DirectX::XMFLOAT3& GetFocus() const { return focus; }
 
-	// 擾
+	// 上方向取得
 	const DirectX::XMFLOAT3& GetUp() const { return up; }
 
-	// O擾
+	// 前方向取得
 	const DirectX::XMFLOAT3& GetFront() const { return front; }
 
-	// E擾
+	// 右方向取得
 	const DirectX::XMFLOAT3& GetRight() const { return right; }
 
 	void SetEye(const DirectX::XMFLOAT3& eye) { this->eye = eye; }
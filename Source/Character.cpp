@@ -2,43 +2,43 @@
 #include "RayCast.h"
 #include "stage.h"
 
-//sXV
+//行列更新処理
 void Character::UpdateTransfom()
 {
-	//XP[s񐧍
+	//スケール行列制作
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z);
 
-	//]s𐧍
+	//回転行列を制作
 	DirectX::XMMATRIX R = DirectX::XMMatrixRotationRollPitchYaw(angle.x, angle.y, angle.z);
 
-	//ʒus쐬
+	//位置行列を作成
 	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(position.x, position.y, position.z);
 
-	//O̍sgݍ킹ă[hs쐬
+	//三つの行列を組み合わせてワールド行列を作成
 	DirectX::XMMATRIX W = S * R * T;
 
-	//vZ[hso
+	//計算したワールド行列を取り出す
 	DirectX::XMStoreFloat4x4(&transform, W);
 }
 
 void Character::RenderDebugPrimitive(const RenderContext& rc, ShapeRenderer* renderer)
 {
-	////̃fobO
+	////球のデバッグ
 	//renderer->RenderSphere(rc, position, radius, DirectX::XMFLOAT4(0, 0, 0, 1));
-	//~̃fobO
+	//円柱のデバッグ
 	renderer->DrawCapsule(transform, radius, height, DirectX::XMFLOAT4(0, 0, 0, 1));
 }
 
 
 bool Character::ApplyDamage(float dmage, EnemyManager* enemyManager)
 {
-	//_[W0̏ꍇ͌NԂύXKvȂ
+	//ダメージが0の場合は健康状態を変更する必要がない
 	if (dmage == 0) return false;
 
-	//SĂꍇ͌NԂύXȂ
+	//死亡している場合は健康状態を変更しない
 	if (HP <= 0) return false;
 
-	//_[W
+	//ダメージ処理
 	HP -= dmage;
 
 	if (HP == 0)
@@ -48,23 +48,23 @@ bool Character::ApplyDamage(float dmage, EnemyManager* enemyManager)
 	{
 	}
 
-	//NԂύXꍇtrueԂ
+	//健康状態を変更した場合はtrueを返す
 	return true;
 }
 
 bool Character::ApplyDamage(float dmage, float invincidleTime, EnemyManager* enemyManager)
 {
-	//_[W0̏ꍇ͌NԂύXKvȂ
+	//ダメージが0の場合は健康状態を変更する必要がない
 	if (dmage == 0) return false;
 
-	//SĂꍇ͌NԂύXȂ
+	//死亡している場合は健康状態を変更しない
 	if (HP <= 0) return false;
 
 	if (invincidleTimer > 0) return false;
 
 	invincidleTimer = invincidleTime;
 
-	//_[W
+	//ダメージ処理
 	HP -= dmage;
 
 	if (HP == 0)
@@ -74,11 +74,11 @@ bool Character::ApplyDamage(float dmage, float invincidleTime, EnemyManager* ene
 	{
 	}
 
-	//NԂύXꍇtrueԂ
+	//健康状態を変更した場合はtrueを返す
 	return true;
 }
 
-//Ռ^
+//衝撃を与える
 void Character::AddImpulse(const DirectX::XMFLOAT3& impulse)
 {
 	velocity.x += impulse.x;
@@ -89,26 +89,26 @@ void Character::AddImpulse(const DirectX::XMFLOAT3& impulse)
 void Character::UpdateVelocity(float elapsedTime, const Stage* stage)
 {
 
-	//͍XV
+	//垂直速力更新
 	UpdateVerticalVelocity(elapsedTime);
 
-	//͍XV
+	//水平速力更新処理
 	UpdateHorizontalVelocity(elapsedTime);
 
-	//ړXV
+	//垂直移動更新処理
 	UpdateVerticalMove(elapsedTime,stage);
 
-	//ړXV
+	//水平移動更新処理
 	UpdateHorizontalMove(elapsedTime,stage);
 
 	{
-	////d͏
+	////重力処理
 	//velocity.y += gravity * elapsedTime;
 
-	////ړ
+	////移動処理
 	//position.y += velocity.y * elapsedTime;
 
-	////nʔ
+	////地面判定
 	//if (position.y < 0.0f)
 	//{
 	//	position.y = 0.0f;
@@ -127,23 +127,23 @@ void Character::UpdateVelocity(float elapsedTime, const Stage* stage)
 }
 
 
-//͍XV
+//速力更新
 void Character::UpdateVerticalVelocity(float elapsedTime)
 {
-	//d͏
+	//重力処理
 	velocity.y += gravity * elapsedTime;
 
 }
 
-//ړXV
+//垂直移動更新処理
 void Character::UpdateVerticalMove(float elapsedTime,const Stage* stage)
 {
-	//ړ
+	//移動処理
 	float MoveY = velocity.y * elapsedTime;
 
 	position.y += MoveY;
 
-	//nʔ
+	//地面判定
 	if (position.y < 0.0f)
 	{
 		position.y = 0.0f;
@@ -162,17 +162,17 @@ void Character::UpdateVerticalMove(float elapsedTime,const Stage* stage)
 
 void Character::UpdateHorizontalVelocity(float elapsedTime)
 {
-	//XZʂ̑͂
+	//XZ平面の速力を減速する
 	float length = sqrtf( velocity.x * velocity.x + velocity.z * velocity.z);
 	if (length > 0.0f)
 	{
-		//C
+		//摩擦力
 		float friction = this->friction * elapsedTime;
 
-		//󒆂ɂԂ͖C͂炷
+		//っ空中にいる間は摩擦力を減らす
 		if (isGround == false) friction *= airControl;
 
-		//Cɂ鉡̌
+		//摩擦による横方向の減速処理
 		if (length > friction)
 		{
 			//if (isGround)
@@ -186,7 +186,7 @@ void Character::UpdateHorizontalVelocity(float elapsedTime)
 			velocity.x = vx * (length - friction);
 			velocity.z = vz * (length - friction);
 		}
-		//̑͂C͂ɂȂ瑬͂𖳌
+		//横方向の速力が摩擦力いかになったら速力を無効か
 		else
 		{
 			velocity.x = 0.0f;
@@ -194,23 +194,23 @@ void Character::UpdateHorizontalVelocity(float elapsedTime)
 		}
 	}
 
-	//XZʂ̑͂
+	//XZ平面の速力を加速する
 	if (length <= MaxMoveSpeed)
 	{
-		//ړxNg[łȂȂ
+		//移動ベクトルがゼロでないなら
 		float moveVecLength = sqrtf(moveVecX * moveVecX + moveVecZ * moveVecZ);
 		if (moveVecLength > 0.0f)
 		{
-			//
+			//加速力
 			float acceleration = this->acceleration * elapsedTime;
 
 			if (isGround == false) acceleration *= airControl;
 
-			//ړxNgɂ
+			//移動ベクトルによる加速処理
 			velocity.x += (moveVecX / moveVecLength) * acceleration;
 			velocity.z += (moveVecZ / moveVecLength) * acceleration;
 
-			//őx
+			//最大加速度制限
 			float length = sqrtf(velocity.x * velocity.x + velocity.z * velocity.z);
 			if (length > MaxMoveSpeed)
 			{
@@ -222,7 +222,7 @@ void Character::UpdateHorizontalVelocity(float elapsedTime)
 
 
 
-	//ړxNgZbg
+	//移動ベクトルをリセット
 	moveVecX = 0;
 	moveVecZ = 0;
 }
@@ -235,14 +235,14 @@ void Character::UpdateHorizontalMove(float elapsedTime, const Stage* stage)
 
 void Character::HitImpact(DirectX::XMFLOAT3 thisPos, DirectX::XMFLOAT3 targetPos, float power, Character* Target)
 {
-	//΂
+	//吹き飛ばす
 	DirectX::XMFLOAT3 impulse;
 	DirectX::XMVECTOR ThisPos = DirectX::XMLoadFloat3(&thisPos);
 	DirectX::XMVECTOR TargetPos = DirectX::XMLoadFloat3(&targetPos);
 	DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(TargetPos, ThisPos);
-	//Pʉ
+	//単位化
 	Vec = DirectX::XMVector3Normalize(Vec);
-	//XJ[{
+	//スラカー倍する
 	DirectX::XMStoreFloat3(&impulse, Vec);
 	impulse.x *= power;
 	impulse.y += 0.0f;
@@ -250,11 +250,11 @@ void Character::HitImpact(DirectX::XMFLOAT3 thisPos, DirectX::XMFLOAT3 targetPos
 
 	Target->AddImpulse(impulse);
 
-	//qbgGtFNg
+	//ヒットエフェクト
 	DirectX::XMFLOAT3 e = Target->GetPosition();
 	e.y += Target->GetHeight() * 0.5f;
 	//hitEffect->Play(e);
 
-	////qbgSEĐ
+	////ヒットSE再生
 	//hitSE->Play(false);
 }
@@ -7,16 +7,16 @@
 class EnemyManager;
 class Stage;
 
-//LN^[
+//キャラクター
 class Character
 {
 protected:
 
-	//d
+	//重力
 	float gravity = -30.0f;
 	DirectX::XMFLOAT3 velocity = { 0,0,0 };
 
-	//C
+	//摩擦
 	float friction = 15.0f;
 
 protected:
@@ -24,42 +24,42 @@ protected:
 	DirectX::XMFLOAT3	angle     = { 0,0,0 };
 	DirectX::XMFLOAT3	scale     = { 1,1,1 };
 	DirectX::XMFLOAT4X4 transform = {
-		//XP[x
+		//スケールx
 		1, 0, 0, 0,
-		//XP[y
+		//スケールy
 		0, 1, 0, 0,
-		//]
+		//回転
 		0, 0, 1, 0,
-		//ʒu
+		//位置
 		0, 0, 0, 1
 	};
 
-	//a
+	//半径
 	float radius = 0.5f;
 
-	//n
+	//着地判定
 	bool isGround = false;
 
-	//
+	//高さ
 	float height = 2.0f;
 
 	//HP
 	float HP = 5;
 
-	//G
+	//無敵時間
 	float invincidleTimer = 1.0;
 
-	//x
+	//加速度
 	float acceleration = 50.0f;
-	//Xs[hl
+	//スピード上限値
 	float MaxMoveSpeed = 5.0f;
-	//ړX
+	//移動方向X
 	float moveVecX = 0.0f;
-	//ړZ
+	//移動方向Z
 	float moveVecZ = 0.0f;
-	//󒆐
+	//空中制御
 	float airControl = 0.3f;
-	//ǂꂾ邩H
+	//どれだけ落下するか？
 	float downhillOffset = 43.0f;
 
 public:
@@ -70,74 +70,74 @@ public:
 
 	/////////////////////////////////////////////
 
-	//ʒu擾
+	//位置取得
 	const DirectX::XMFLOAT3& GetPosition() const        { return position; }
 
-	//ʒuݒ
+	//位置設定
 	void SetPosition(const DirectX::XMFLOAT3& position) { this->position = position; }
 
-	//]擾
+	//回転取得
 	const DirectX::XMFLOAT3& GetAngle() const           { return angle; }
 
-	//]ݒ
+	//回転設定
 	void SetAngle(const DirectX::XMFLOAT3& angle)       { this->angle = angle; }
 
-	//XP[擾
+	//スケール取得
 	const DirectX::XMFLOAT3& GetScale() const           { return scale; }
 
-	//XP[擾
+	//スケール取得
 	void SetScale(const DirectX::XMFLOAT3& scale)       { this->scale = scale; }
 
-	//a擾
+	//半径取得
 	float GetRadius() const { return radius; }
 
-	//擾
+	//高さ取得
 	float GetHeight() const { return height; }
 
-	//HP擾
+	//HP取得
 	float GetHP() const { return HP; }
 	
 	/////////////////////////////////////////////
 
 public:
-	//s񏈗
+	//行列処理
 	void UpdateTransfom();
 
-	//fobOs~eBu`
+	//デバッグピリミティブ描画
 	virtual void RenderDebugPrimitive(const RenderContext& rc, ShapeRenderer* renderer);
 
-	//nʂɐڂĂ邩
+	//地面に接しているか
 	bool IsGround() const { return isGround; };
 
-	//_[W^
+	//ダメージを与える
 	bool ApplyDamage(float dmage, EnemyManager* enemyManager);
 
-	//_[W^
+	//ダメージを与える
 	bool ApplyDamage(float dmage ,float invincidleTime, EnemyManager* enemyManager);
 
-	//_[W^
+	//ダメージを与える
 	virtual bool ApplyDamage(float dmage, float invincidleTime) { return false; };
 
-	//΂
+	//吹き飛ばし
 	void HitImpact(DirectX::XMFLOAT3 thisPos,DirectX::XMFLOAT3 targetPos,float power,Character* Target);
 
-	//Ռ^
+	//衝撃を与える
 	void AddImpulse(const DirectX::XMFLOAT3& impulse);
 
 protected:
-	//͍XV
+	//垂直速力更新
 	void UpdateVerticalVelocity(float elapsedTime);
 
-	//ړXV
+	//垂直移動更新処理
 	virtual void UpdateVerticalMove(float elapsedTime, const Stage* stage);
 
-	//͍XV
+	//水平速力更新処理
 	void UpdateHorizontalVelocity(float elapsedTime);
 
-	//ړXV
+	//水平移動更新処理
 	virtual void UpdateHorizontalMove(float elapsedTime, const Stage* stage);
 
-	//͏XV
+	//速力処理更新
 	void UpdateVelocity(float elapsedTime, const Stage* stage);
 
 };
\ No newline at end of file
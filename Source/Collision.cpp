@@ -2,7 +2,7 @@
 #include <algorithm>
 
 
-//m̓蔻
+//球同士の当たり判定
 bool Collision::IntersectSphereVsSphere(
 	const DirectX::XMFLOAT3& positionA,
 	float radiusA,
@@ -11,32 +11,32 @@ bool Collision::IntersectSphereVsSphere(
 	DirectX::XMFLOAT3& outPositionB)
 {
 	{
-		//A->B̒PʃxNgZo
-		//^ϊ
+		//A->Bの単位ベクトルを算出
+		//型変換
 		DirectX::XMVECTOR PositionA = DirectX::XMLoadFloat3(&positionA);
 		DirectX::XMVECTOR PositionB = DirectX::XMLoadFloat3(&positionB);
-		//xNg߂
+		//ベクトルを求める
 		DirectX::XMVECTOR Vec		= DirectX::XMVectorSubtract(PositionB, PositionA);
-		//߂
+		//長さを求める
 		DirectX::XMVECTOR LengthSq	= DirectX::XMVector3Length(Vec);
 		float lengthSq;
-		//AhX
+		//アドレスを入れる
 		DirectX::XMStoreFloat(&lengthSq, LengthSq);
 
-		//
+		//距離判定
 		float range = radiusA + radiusB;
 		if (range < lengthSq)
 		{
 			return false;
 		}
 
-		//K
+		//正規化
 		DirectX::XMVECTOR outB = DirectX::XMVector3Normalize(Vec);
-		//o
+		//押し出す距離
 		outB = DirectX::XMVectorScale(outB, range);
-		//oꏊ
+		//押し出す場所
 		outB = DirectX::XMVectorAdd(PositionA, outB);
-		//o
+		//押し出す
 		DirectX::XMStoreFloat3(&outPositionB, outB);
 
 		return true;
@@ -44,22 +44,22 @@ bool Collision::IntersectSphereVsSphere(
 
 }
 
-//~m̓蔻
+//円柱同士の当たり判定
 bool Collision::IntersectCylinderVsCylinder(const DirectX::XMFLOAT3& positionA, float radiusA, float heightA, const DirectX::XMFLOAT3& positionB, float radiusB, float heightB, DirectX::XMFLOAT3& outPositionB)
 {
-	//ȂB̓Ȃ瓖ĂȂ
+	//Aの足元がBの頭より上なら当たっていない
 	if (positionA.y > positionB.y + heightB)
 	{
 		return false;
 	}
 
-	//A̓B̑肵Ȃ瓖ĂȂ
+	//Aの頭がBの足元よりしたなら当たっていない
 	if (positionA.y + heightA < positionB.y)
 	{
 		return false;
 	}
 
-	//XZʂł͈̔̓`FbN
+	//XZ平面での範囲チェック
 	float vx = positionB.x - positionA.x;
 	float vz = positionB.z - positionA.z;
 	float range = radiusA + radiusB;
@@ -69,13 +69,13 @@ bool Collision::IntersectCylinderVsCylinder(const DirectX::XMFLOAT3& positionA,
 		return false;
 	}
 
-	//PʃxNg
+	//単位ベクトル化
 	dist = sqrtf(dist);
 	vx /= dist;
 	vz /= dist;
 	float push = range - dist;
 
-	//ABo
+	//AがBを押し出す
 	outPositionB.x = positionB.x + vx * push;
 	outPositionB.y = positionB.y;
 	outPositionB.z = positionB.z + vz * push;
@@ -83,22 +83,22 @@ bool Collision::IntersectCylinderVsCylinder(const DirectX::XMFLOAT3& positionA,
 	return true;
 }
 
-//~m̓蔻
+//円柱同士の当たり判定
 bool Collision::IntersectCylinderVsCylinder(const DirectX::XMFLOAT3& positionA, float radiusA, float heightA, const DirectX::XMFLOAT3& positionB, float radiusB, float heightB)
 {
-	//ȂB̓Ȃ瓖ĂȂ
+	//Aの足元がBの頭より上なら当たっていない
 	if (positionA.y > positionB.y + heightB)
 	{
 		return false;
 	}
 
-	//A̓B̑肵Ȃ瓖ĂȂ
+	//Aの頭がBの足元よりしたなら当たっていない
 	if (positionA.y + heightA < positionB.y)
 	{
 		return false;
 	}
 
-	//XZʂł͈̔̓`FbN
+	//XZ平面での範囲チェック
 	float vx = positionB.x - positionA.x;
 	float vz = positionB.z - positionA.z;
 	float range = radiusA + radiusB;
@@ -108,7 +108,7 @@ bool Collision::IntersectCylinderVsCylinder(const DirectX::XMFLOAT3& positionA,
 		return false;
 	}
 
-	//PʃxNg
+	//単位ベクトル化
 	dist = sqrtf(dist);
 	vx /= dist;
 	vz /= dist;
@@ -117,22 +117,22 @@ bool Collision::IntersectCylinderVsCylinder(const DirectX::XMFLOAT3& positionA,
 	return true;
 }
 
-//Ɖ~̌
+//球と円柱の交差判定
 bool Collision::IntersectSphereVsCylinder(const DirectX::XMFLOAT3& sphereP, float sphereR, const DirectX::XMFLOAT3& cylinderP, float cylinderR, float cylinderH, DirectX::XMFLOAT3& outCylinderP)
 {
-	//ȂB̓Ȃ瓖ĂȂ
+	//Aの足元がBの頭より上なら当たっていない
 	if (sphereP.y > cylinderP.y + cylinderH)
 	{
 		return false;
 	}
 
-	//A̓B̑肵Ȃ瓖ĂȂ
+	//Aの頭がBの足元よりしたなら当たっていない
 	if (sphereP.y + sphereR < cylinderP.y)
 	{
 		return false;
 	}
 
-	//XZʂł͈̔̓`FbN
+	//XZ平面での範囲チェック
 	float vx = cylinderP.x - sphereP.x;
 	float vz = cylinderP.z - sphereP.z;
 	float range = sphereR + cylinderR;
@@ -142,13 +142,13 @@ bool Collision::IntersectSphereVsCylinder(const DirectX::XMFLOAT3& sphereP, floa
 		return false;
 	}
 
-	//PʃxNg
+	//単位ベクトル化
 	dist = sqrtf(dist);
 	vx /= dist;
 	vz /= dist;
 	float push = range - dist;
 
-	//ABo
+	//AがBを押し出す
 	outCylinderP.x = cylinderP.x + vx * push;
 	outCylinderP.y = cylinderP.y;
 	outCylinderP.z = cylinderP.z + vz * push;
@@ -156,22 +156,22 @@ bool Collision::IntersectSphereVsCylinder(const DirectX::XMFLOAT3& sphereP, floa
 	return true;
 }
 
-//Ɖ~̓蔻(out)
+//球と円柱の当たり判定(out無し)
 bool Collision::IntersectSphereVsCylinder(const DirectX::XMFLOAT3& sphereP, float sphereR, const DirectX::XMFLOAT3& cylinderP, float cylinderR, float cylinderH)
 {
-	//ȂB̓Ȃ瓖ĂȂ
+	//Aの足元がBの頭より上なら当たっていない
 	if (sphereP.y > cylinderP.y + cylinderH)
 	{
 		return false;
 	}
 
-	//A̓B̑肵Ȃ瓖ĂȂ
+	//Aの頭がBの足元よりしたなら当たっていない
 	if (sphereP.y + sphereR < cylinderP.y)
 	{
 		return false;
 	}
 
-	//XZʂł͈̔̓`FbN
+	//XZ平面での範囲チェック
 	float vx = cylinderP.x - sphereP.x;
 	float vz = cylinderP.z - sphereP.z;
 	float range = sphereR + cylinderR;
@@ -181,7 +181,7 @@ bool Collision::IntersectSphereVsCylinder(const DirectX::XMFLOAT3& sphereP, floa
 		return false;
 	}
 
-	//PʃxNg
+	//単位ベクトル化
 	dist = sqrtf(dist);
 	vx /= dist;
 	vz /= dist;
@@ -190,7 +190,7 @@ bool Collision::IntersectSphereVsCylinder(const DirectX::XMFLOAT3& sphereP, floa
 	return true;
 }
 
-//lpƎlp̓蔻
+//四角と四角の当たり判定
 bool Collision::IntersectBoxVsBox(
 	const DirectX::XMFLOAT3& posA,
 	const DirectX::XMFLOAT3& lengthA,
@@ -209,16 +209,16 @@ bool Collision::IntersectBoxVsBox(
 	StartPosB.z = posB.z - (lengthB.z * 0.5f);
 	StartPosB.y = posB.y;
 
-	return !(StartPosA.x + lengthA.x < StartPosB.x || //BÅOɂ邩
-		StartPosB.x + lengthB.x < StartPosA.x || //AB̊Oɂ邩
-		StartPosA.y + lengthA.y < StartPosB.y || //BÅOɂ邩
-		StartPosB.y + lengthB.y < StartPosA.y || //AB̊Oɂ邩
-		StartPosA.z + lengthA.z < StartPosB.z || //BÅOɂ邩
-		StartPosB.z + lengthB.z < StartPosA.z	  //AB̊Oɂ邩
+	return !(StartPosA.x + lengthA.x < StartPosB.x || //BがAの外にあるか
+		StartPosB.x + lengthB.x < StartPosA.x || //AがBの外にあるか
+		StartPosA.y + lengthA.y < StartPosB.y || //BがAの外にあるか
+		StartPosB.y + lengthB.y < StartPosA.y || //AがBの外にあるか
+		StartPosA.z + lengthA.z < StartPosB.z || //BがAの外にあるか
+		StartPosB.z + lengthB.z < StartPosA.z	  //AがBの外にあるか
 		);
 }
 
-//lpƉ~̓蔻
+//四角と円柱の当たり判定
 bool Collision::IntersectBoxVsCylinder(
 	const DirectX::XMFLOAT3& posA,
 	const DirectX::XMFLOAT3& lengthA,
@@ -238,21 +238,21 @@ bool Collision::IntersectBoxVsCylinder(
 	if (cylinderP.y + cylinderH < posA.y) return false;
 
 	{
-		//lp̎n܂肩Ȉꏊ܂
+		//四角の始まりから終わりの場所まで
 		float boxMinX = posA.x - lengthA.x;
 		float boxMaxX = posA.x + lengthA.x;
 		float boxMinZ = posA.z - lengthA.z;
 		float boxMaxZ = posA.z + lengthA.z;
 
-		//~̒Slp̍ŋߐړ_߂
+		//円の中心から四角の最近接点を求める
 		float closestX = std::max(boxMinX, std::min(cylinderP.x, boxMaxX));
 		float closestZ = std::max(boxMinZ, std::min(cylinderP.z, boxMaxZ));
 
-		//~̒Slp̍Őڋߓ_܂ł̃xNg
+		//円の中心から四角の最接近点までのベクトルを取る
 		float dx = cylinderP.x - closestX;
 		float dz = cylinderP.z - closestZ;
 
-		//~Ǝlp`̋aȂՓ
+		//円と四角形の距離が半径内なら衝突
 		if ((dx * dx + dz * dz) <= (cylinderR * cylinderR))
 		{
 			float dist = { sqrtf(dx * dx + dz * dz) };
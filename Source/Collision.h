@@ -2,11 +2,11 @@
 
 #include <DirectXMath.h>
 
-//RW
+//コリジョン
 class Collision
 {
 public:
-	//Ƌ̌(~m)
+	//球と球の交差判定(円柱同士)
 	static bool IntersectSphereVsSphere(
 		const DirectX::XMFLOAT3& positionA,
 		float radiusA,
@@ -14,7 +14,7 @@ public:
 		float radiusB,
 		DirectX::XMFLOAT3& outPositionB
 	);
-	//~m̌
+	//円柱同士の交差判定
 	static bool IntersectCylinderVsCylinder(
 		const DirectX::XMFLOAT3& positionA,
 		float radiusA,
@@ -24,7 +24,7 @@ public:
 		float heightB,
 		DirectX::XMFLOAT3& outPositionB
 	);
-	//~m̌
+	//円柱同士の交差判定
 	static bool IntersectCylinderVsCylinder(
 		const DirectX::XMFLOAT3& positionA,
 		float radiusA,
@@ -34,7 +34,7 @@ public:
 		float heightB
 	);
 
-	//Ɖ~̌
+	//球と円柱の交差判定
 	static bool IntersectSphereVsCylinder(
 		const DirectX::XMFLOAT3& sphereP,
 		float sphereR,
@@ -44,7 +44,7 @@ public:
 		DirectX::XMFLOAT3& outCylinderP
 	);
 
-	//lpƎlp
+	//四角と四角
 	static bool IntersectBoxVsBox(
 		const DirectX::XMFLOAT3& posA,
 		const DirectX::XMFLOAT3& lengthA,
@@ -53,7 +53,7 @@ public:
 		DirectX::XMFLOAT3& outPosition
 	);
 
-	//lpƉ~
+	//四角と円柱
 	static bool IntersectBoxVsCylinder(
 		const DirectX::XMFLOAT3& posA,
 		const DirectX::XMFLOAT3& lengthA,
@@ -65,7 +65,7 @@ public:
 
 
 
-	//Ɖ~̌
+	//球と円柱の交差判定
 	static bool IntersectSphereVsCylinder(
 		const DirectX::XMFLOAT3& sphereP,
 		float sphereR,
@@ -74,7 +74,7 @@ public:
 		float cylinderH
 	);
 
-	//Ƌ̌(~m)
+	//球と球の交差判定(円柱同士)
 	static bool IntersectSphereVsSphere(
 		const DirectX::XMFLOAT3& positionA,
 		float radiusA,
@@ -86,7 +86,7 @@ public:
 		return IntersectSphereVsSphere(positionA, radiusA, positionB, radiusB,outPos);
 	}
 
-	//lpƎlp
+	//四角と四角
 	static bool IntersectBoxVsBox(
 		const DirectX::XMFLOAT3& posA,
 		const DirectX::XMFLOAT3& lengthA,
@@ -98,7 +98,7 @@ public:
 		return IntersectBoxVsBox(posA, lengthA, posB, lengthB, OutPos);
 	}
 
-	//lpƉ~
+	//四角と円柱
 	static bool IntersectBoxVsCylinder(
 		const DirectX::XMFLOAT3& posA,
 		const DirectX::XMFLOAT3& lengthA,
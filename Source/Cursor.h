@@ -96,7 +96,7 @@ public:
 		particles.erase(
 			std::remove_if(particles.begin(), particles.end(),
 				[](const Particles& p) {
-					// Lerp ݂ĂāAamount  maxAmount ɒB폜
+					// Lerp が存在していて、amount が maxAmount に達したら削除
 					return p.showLerp->GetAmount() >= p.showLerp->GetMaxAmount();
 				}),
 			particles.end()
@@ -17,12 +17,12 @@ public:
 		{
 			if (b == true)
 			{
-				ShowCursor(true); // J[\悤ɂ
+				ShowCursor(true); // カーソルを見えるようにする
 				currentShow = b;
 			}
 			else
 			{
-				ShowCursor(false); // J[\Ȃ悤ɂ
+				ShowCursor(false); // カーソルを見えないようにする
 				currentShow = b;
 			}
 		}
@@ -30,11 +30,11 @@ public:
 	
 	static DirectX::XMFLOAT2 GetCursorPosition()
 	{
-		//݂̃J[\ʒu擾
+		//現在のカーソル位置を取得
 		POINT cursor;
 		GetCursorPos(&cursor);
 
-		//NCAgWɕϊ
+		//クライアント座標に変換
 		ScreenToClient(Graphics::Instance().GetWindowHandle(), &cursor);
 
 		return { static_cast<float>(cursor.x),static_cast<float>(cursor.y) };
@@ -2,14 +2,14 @@
 
 static char pathBuffer[MAX_PATH];
 
-// [t@CJ]_CAO{bNX\
+// [ファイルを開く]ダイアログボックスを表示
 DialogResult Dialog::OpenFileName(char* filepath, int size, const char* filter, const char* title, HWND hWnd, bool multiSelect)
 {
-	// pXݒ
+	// 初期パス設定
 	char dirname[MAX_PATH];
 	if (filepath[0] != '0')
 	{
-		// fBNgpX擾
+		// ディレクトリパス取得
 		::_splitpath_s(filepath, nullptr, 0, dirname, MAX_PATH, nullptr, 0, nullptr, 0);
 	}
 	else
@@ -20,7 +20,7 @@ DialogResult Dialog::OpenFileName(char* filepath, int size, const char* filter,
 	{
 		strcpy_s(dirname, MAX_PATH, pathBuffer);
 	}
-	// lpstrInitialDir  \ łȂƎ󂯕tȂ
+	// lpstrInitialDir は \ でないと受け付けない
 	for (char* p = dirname; *p != '\0'; p++)
 	{
 		if (*p == '/')
@@ -32,7 +32,7 @@ DialogResult Dialog::OpenFileName(char* filepath, int size, const char* filter,
 		filter = "All Files\0*.*\0\0";
 	}
 
-	// \̃Zbg
+	// 構造体セット
 	OPENFILENAMEA	ofn;
 	memset(&ofn, 0, sizeof(OPENFILENAMEA));
 	ofn.lStructSize = sizeof(OPENFILENAMEA);
@@ -49,39 +49,39 @@ DialogResult Dialog::OpenFileName(char* filepath, int size, const char* filter,
 		ofn.Flags |= OFN_ALLOWMULTISELECT | OFN_EXPLORER;
 	}
 
-	// JgfBNg擾
+	// カレントディレクトリ取得
 	char currentDir[MAX_PATH];
 	if (!::GetCurrentDirectoryA(MAX_PATH, currentDir))
 	{
 		currentDir[0] = '\0';
 	}
 
-	// _CAOI[v
+	// ダイアログオープン
 	if (::GetOpenFileNameA(&ofn) == FALSE)
 	{
 		return DialogResult::Cancel;
 	}
 
-	// JgfBNgA
+	// カレントディレクトリ復帰
 	if (currentDir[0] != '\0')
 	{
 		::SetCurrentDirectoryA(currentDir);
 	}
 
-	// ŏIpXL
+	// 最終パスを記憶
 	strcpy_s(pathBuffer, MAX_PATH, filepath);
 
 	return DialogResult::OK;
 }
 
-// [t@Cۑ]_CAO{bNX\
+// [ファイルを保存]ダイアログボックスを表示
 DialogResult Dialog::SaveFileName(char* filepath, int size, const char* filter, const char* title, const char* ext, HWND hWnd)
 {
-	// pXݒ
+	// 初期パス設定
 	char dirname[MAX_PATH];
 	if (filepath[0] != '0')
 	{
-		// fBNgpX擾
+		// ディレクトリパス取得
 		::_splitpath_s(filepath, nullptr, 0, dirname, MAX_PATH, nullptr, 0, nullptr, 0);
 	}
 	else
@@ -92,7 +92,7 @@ DialogResult Dialog::SaveFileName(char* filepath, int size, const char* filter,
 	{
 		strcpy_s(dirname, MAX_PATH, pathBuffer);
 	}
-	// lpstrInitialDir  \ łȂƎ󂯕tȂ
+	// lpstrInitialDir は \ でないと受け付けない
 	for (char* p = dirname; *p != '\0'; p++)
 	{
 		if (*p == '/')
@@ -104,7 +104,7 @@ DialogResult Dialog::SaveFileName(char* filepath, int size, const char* filter,
 		filter = "All Files\0*.*\0\0";
 	}
 
-	// \̃Zbg
+	// 構造体セット
 	OPENFILENAMEA	ofn;
 	memset(&ofn, 0, sizeof(OPENFILENAMEA));
 	ofn.lStructSize = sizeof(OPENFILENAMEA);
@@ -118,26 +118,26 @@ DialogResult Dialog::SaveFileName(char* filepath, int size, const char* filter,
 	ofn.lpstrDefExt = ext;
 	ofn.Flags = OFN_OVERWRITEPROMPT | OFN_HIDEREADONLY;
 
-	// JgfBNg擾
+	// カレントディレクトリ取得
 	char current_dir[MAX_PATH];
 	if (!::GetCurrentDirectoryA(MAX_PATH, current_dir))
 	{
 		current_dir[0] = '\0';
 	}
 
-	// _CAOI[v
+	// ダイアログオープン
 	if (::GetSaveFileNameA(&ofn) == FALSE)
 	{
 		return DialogResult::Cancel;
 	}
 
-	// JgfBNgA
+	// カレントディレクトリ復帰
 	if (current_dir[0] != '\0')
 	{
 		::SetCurrentDirectoryA(current_dir);
 	}
 
-	// ŏIpXL
+	// 最終パスを記憶
 	strcpy_s(pathBuffer, MAX_PATH, filepath);
 
 	return DialogResult::OK;
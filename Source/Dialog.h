@@ -2,7 +2,7 @@
 
 #include <Windows.h>
 
-// _CAOUg
+// ダイアログリザルト
 enum class DialogResult
 {
 	Yes,
@@ -11,13 +11,13 @@ enum class DialogResult
 	Cancel
 };
 
-// _CAO
+// ダイアログ
 class Dialog
 {
 public:
-	// [t@CJ]_CAO{bNX\
+	// [ファイルを開く]ダイアログボックスを表示
 	static DialogResult OpenFileName(char* filepath, int size, const char* filter = nullptr, const char* title = nullptr, HWND hWnd = NULL, bool multiSelect = false);
 
-	// [t@Cۑ]_CAO{bNX\
+	// [ファイルを保存]ダイアログボックスを表示
 	static DialogResult SaveFileName(char* filepath, int size, const char* filter = nullptr, const char* title = nullptr, const char* ext = nullptr, HWND hWnd = NULL);
 };
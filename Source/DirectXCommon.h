@@ -5,7 +5,7 @@
 class DirectXCommon
 {
 public:
-    //m[}CYꂽxNg
+    //ノーマライズされたベクトルを作る
     static DirectX::XMVECTOR CreateVector(DirectX::XMFLOAT3 s, DirectX::XMFLOAT3 e)
     {
         DirectX::XMVECTOR S = DirectX::XMLoadFloat3(&s);
@@ -13,7 +13,7 @@ public:
         DirectX::XMVECTOR SE = DirectX::XMVectorSubtract(E, S);
         return SE;
     }
-    //m[}CYꂽxNg
+    //ノーマライズされたベクトルを作る
     static DirectX::XMVECTOR CreateNormalVector(DirectX::XMFLOAT3 s, DirectX::XMFLOAT3 e)
     {
         DirectX::XMVECTOR S = DirectX::XMLoadFloat3(&s);
@@ -22,38 +22,38 @@ public:
         SE = DirectX::XMVector3Normalize(SE);
         return SE;
     }
-    //ĂxNgɃ[Esb`E[ɕϊ֐
+    //見ている方向ベクトルをさらにロール・ピッチ・ヨーに変換する関数
     static DirectX::XMFLOAT3 GetLookAtAngles(const DirectX::XMFLOAT3 from, const DirectX::XMFLOAT3 to)
     {
         using namespace DirectX;
         XMFLOAT3 dirFloat;
         DirectX::XMStoreFloat3(&dirFloat, CreateNormalVector(from, to));
 
-        // sb`iX]jFY̊px
-        float pitch = asinf(-dirFloat.y);  // ㉺
+        // ピッチ（X軸回転）：Y成分の角度
+        float pitch = asinf(-dirFloat.y);  // 上下方向
 
-        // [iY]jFXZʂł̌
-        float yaw = atan2f(dirFloat.x, dirFloat.z);  // E
+        // ヨー（Y軸回転）：XZ平面での向き
+        float yaw = atan2f(dirFloat.x, dirFloat.z);  // 左右方向
 
-        // [iZ]jFʏ 0
+        // ロール（Z軸回転）：通常は 0
         float roll = 0.0f;
 
         return XMFLOAT3(pitch, yaw, roll);
     }
 
-    //s쐬
+    //行列作成
     static DirectX::XMMATRIX CreateXMMATRIX(const DirectX::XMFLOAT3& p, const DirectX::XMFLOAT3& s, const DirectX::XMFLOAT3& a)
     {
-        //XP[s񐧍
+        //スケール行列制作
         DirectX::XMMATRIX S = DirectX::XMMatrixScaling(s.x, s.y, s.z);
 
-        //]s𐧍
+        //回転行列を制作
         DirectX::XMMATRIX R = DirectX::XMMatrixRotationRollPitchYaw(a.x, a.y, a.z);
 
-        //ʒus쐬
+        //位置行列を作成
         DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(p.x, p.y, p.z);
 
-        //O̍sgݍ킹ă[hs쐬
+        //三つの行列を組み合わせてワールド行列を作成
         return S * R * T;
     }
 
@@ -3,27 +3,27 @@
 #include "EffectManager.h"
 #include <mutex>
 
-//RXgN^
+//コンストラクタ
 Effect::Effect(const char* filename)
 {
-	//GtFNgǂݍ݂OɃbN
-	//}`XbhEffect쐬DeviceContext𓯎ANZX
-	//t[Y\̂Ŕr䂷
+	//エフェクトを読み込みする前にロックする
+	//※マルチスレッドでEffectを作成するとDeviceContextを同時アクセスして
+	//フリーズする可能性があるので排他制御する
 	std::lock_guard<std::mutex> lock(Graphics::Instance().GetMutex());
 
-	//Effekseer̃\[Xǂݍ
-	//EffekseerUTF-16̃t@CpXȊO͑ΉĂȂߕR[hϊKv
+	//Effekseerのリソースを読み込む
+	//EffekseerはUTF-16のファイルパス以外は対応していないため文字コード変換が必要
 	char16_t utf16Filenaname[256];
 	Effekseer::ConvertUtf8ToUtf16(utf16Filenaname, 256, filename);
 
-	//EffekseerGtFNgǂݍ
+	//Effekseerエフェクトを読み込む
 	Effekseer::ManagerRef effekseerManager = EffectManager::Instance().GetEffekseerManager();
 
-	//EffekseerGtFNg݂
+	//Effekseerエフェクトをよみこみ
 	effekseerEffect = Effekseer::Effect::Create(effekseerManager, (EFK_CHAR*)utf16Filenaname);
 }
 
-//Đ
+//再生
 Effekseer::Handle Effect::Play(const DirectX::XMFLOAT3& position, float scale)
 {
 	Effekseer::ManagerRef effekseerManager = EffectManager::Instance().GetEffekseerManager();
@@ -33,7 +33,7 @@ Effekseer::Handle Effect::Play(const DirectX::XMFLOAT3& position, float scale)
 	return handle;
 }
 
-//~
+//停止
 void Effect::Stop(Effekseer::Handle handle)
 {
 	Effekseer::ManagerRef effekseerManager = EffectManager::Instance().GetEffekseerManager();
@@ -48,7 +48,7 @@ void Effect::SetPosition(Effekseer::Handle handle, const DirectX::XMFLOAT3& posi
 	effekseerManager->SetLocation(handle, position.x, position.y, position.z);
 }
 
-//XP[ݒ
+//スケール設定
 void Effect::SetScale(Effekseer::Handle handle, const DirectX::XMFLOAT3& scale)
 {
 	Effekseer::ManagerRef effekseerManager = EffectManager::Instance().GetEffekseerManager();
@@ -3,7 +3,7 @@
 #include <DirectXMath.h>
 #include <Effekseer.h>
 
-//GtFNg
+//エフェクト
 class Effect
 {
 private:
@@ -13,15 +13,15 @@ public:
 	Effect(const char* filename);
 	~Effect() {};
 
-	//Đ
+	//再生
 	Effekseer::Handle Play(const DirectX::XMFLOAT3& position, float scale = 1.0f);
 
-	//~
+	//停止
 	void Stop(Effekseer::Handle handle);
 
-	//Wݒ
+	//座標設定
 	void SetPosition(Effekseer::Handle handle, const DirectX::XMFLOAT3& position);
 
-	//XP[ݒ
+	//スケール設定
 	void SetScale(Effekseer::Handle handle, const DirectX::XMFLOAT3& scale);
 };
\ No newline at end of file
@@ -1,58 +1,63 @@
 #include "EffectManager.h"
 #include "System/Graphics.h"
+#include "System/Profiler.h"
 
 void EffectManager::Initialize()
 {
 	Graphics& graphics = Graphics::Instance();
 
-	//Effekseer_
+	//Effekseerレンダラ生成
 	effekseerRender = EffekseerRendererDX11::Renderer::Create(graphics.GetDevice(), graphics.GetDeviceContext(), 2048);
 
-	//Effekseer}l[W[
+	//Effekseerマネージャー生成
 	effekseerManager = Effekseer::Manager::Create(2048);
 
-	//Effekseer_̊eݒ(ʂȃJX^}CYȂꍇ͒^Ɉȉ̐ݒOK)
+	//Effekseerレンダラの各種設定(特別なカスタマイズをしない場合は定型に以下の設定でOK)
 	effekseerManager->SetSpriteRenderer(effekseerRender->CreateSpriteRenderer());
 	effekseerManager->SetRibbonRenderer(effekseerRender->CreateRibbonRenderer());
 	effekseerManager->SetRingRenderer(effekseerRender->CreateRingRenderer());
 	effekseerManager->SetTrackRenderer(effekseerRender->CreateTrackRenderer());
 	effekseerManager->SetModelRenderer(effekseerRender->CreateModelRenderer());
-	//Efeekseerł̃[_[ݒ(ʂȃJX^}CYȂꍇ͈ȉ̐ݒOK)
+	//Efeekseer内でのローダー設定(特別なカスタマイズをしない場合は以下の設定でOK)
 	effekseerManager->SetTextureLoader(effekseerRender->CreateTextureLoader());
 	effekseerManager->SetModelLoader(effekseerRender->CreateModelLoader());
 	effekseerManager->SetMaterialLoader(effekseerRender->CreateMaterialLoader());
 
-	//EffekseerWnŌvZ
+	//Effekseerを左手座標系で計算する
 	effekseerManager->SetCoordinateSystem(Effekseer::CoordinateSystem::LH);
 }
 
-//I
+//終了化
 void EffectManager::Finalize()
 {
-	//X}[g|C^Ŕj邩牽Ȃ
+	//スマートポインタで破棄されるから何もしない
 }
 
-//XV
+//更新処理
 void EffectManager::Update(float elapsedTime)
 {
-	//GtFNgXV
+	PROFILE_SCOPE("EffectManager::Update");
+
+	//エフェクト更新処理
 	effekseerManager->Update(elapsedTime * 60.0f);
 }
 
 void EffectManager::Render(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection)
 {
-	//r[&vWFNVsEffekseer_ɐݒ
+	PROFILE_SCOPE("EffectManager::Render");
+
+	//ビュー&プロジェクション行列をEffekseerレンダラに設定
 	effekseerRender->SetCameraMatrix(*reinterpret_cast<const Effekseer::Matrix44*>(&view));
 	effekseerRender->SetProjectionMatrix(*reinterpret_cast<const Effekseer::Matrix44*>(&projection));
 
-	//Effekseer`Jn
+	//Effekseer描画開始
 	effekseerRender->BeginRendering();
 
-	//Effekseer`s
-	//}l[W[Pʂŕ`悷̂ŕ`揇𐧌䂷ꍇ̓}l[W[𕡐쐬A
-	//Dreaw()֐s鏇Őł
+	//Effekseer描画実行
+	//マネージャー単位で描画するので描画順を制御する場合はマネージャーを複数作成し、
+	//Dreaw()関数を実行する順序で制御できそう
 	effekseerManager->Draw();
 
-	//Effekseer`I
+	//Effekseer描画終了
 	effekseerRender->EndRendering();
 }
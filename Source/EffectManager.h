@@ -4,7 +4,7 @@
 #include <Effekseer.h>
 #include <EffekseerRendererDX11.h>
 
-//GtFNg}l[W[
+//エフェクトマネージャー
 class EffectManager
 {
 private:
@@ -16,26 +16,26 @@ private:
 	~EffectManager() {}
 public:
 
-	//
+	//初期化
 	void Initialize();
 
-	//I
+	//終了化
 	void Finalize();
 
 public:
-	//BCX^X擾
+	//唯一インスタンス取得
 	static EffectManager& Instance()
 	{
 		static EffectManager instance;
 		return instance;
 	}
 
-	//XV
+	//更新処理
 	void Update(float elapsedTime);
 
-	//`揈
+	//描画処理
 	void Render(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection);
 
-	//Effecksser}l[W[擾
+	//Effecksserマネージャー取得
 	Effekseer::ManagerRef GetEffekseerManager() { return effekseerManager; }
 };
\ No newline at end of file
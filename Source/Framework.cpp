@@ -5,6 +5,10 @@
 #include "Framework.h"
 #include "System/Input.h"
 #include "System/Graphics.h"
+#include "System/TextureAtlas.h"
+#include "System/ShaderCache.h"
+#include "System/Profiler.h"
+#include "System/JobSystem.h"
 #include "System/ImGuiRenderer.h"
 #include "scene_game.h"
 #include "scene_title.h"
@@ -15,29 +19,39 @@
 #include "imgui_logger.h"
 #include <custom_cursor.h>
 
-// Ԋuݒ
+// 垂直同期間隔設定
 static const int syncInterval = 1;
 static constexpr float kMaxFPS = 144.0f;
 static const float kMinFrameTime = 1.0f / kMaxFPS;
 
 //static SceneGame sceneGame;
 
-// RXgN^
-// Framework.cpp ̃RXgN^
+// コンストラクタ
+// Framework.cpp のコンストラクタ
 Framework::Framework(HWND hWnd)
 	: hWnd(hWnd)
 {
+	PROFILE_THREAD_NAME("Main");
 
-	//I[fBI
+	// ジョブシステム初期化(モデル読み込みなどで使うので最初に行う)
+	JobSystem::Instance().Initialize();
+
+	//オーディオ初期化
 	Audio::Instance().Initialize();
 
-	// Cvbg
+	// インプット初期化
 	Input::Instance().Initialize(hWnd);
 
-	// OtBbNX
+	// シェーダーキャッシュ初期化(グラフィックス初期化でシェーダーを読み込むので先に行う)
+	ShaderCache::Instance().Initialize("Data/Shader/ShaderCache.bin");
+
+	// グラフィックス初期化
 	Graphics::Instance().Initialize(hWnd);
 
-	// IMGUI
+	// UI画像のテクスチャアトラス初期化(スプライト生成より先に行う)
+	TextureAtlas::Instance().Initialize(Graphics::Instance().GetDevice(), "Data/Sprite", "Data/Sprite/Atlas/ui_atlas.json");
+
+	// IMGUI初期化
 	ImGuiRenderer::Initialize(hWnd, Graphics::Instance().GetDevice(), Graphics::Instance().GetDeviceContext());
 
 	{ // imgui font change
@@ -46,44 +60,55 @@ Framework::Framework(HWND hWnd)
 		io.Fonts->AddFontFromFileTTF("Data/Font/MPLUS1-Medium.ttf", 20.0f, nullptr, io.Fonts->GetGlyphRangesJapanese());
 		io.Fonts->Build();
 	}
-	//GtFNg}l[W[
+	//エフェクトマネージャー初期化
 	EffectManager::Instance().Initialize();
 
-	// JX^J[\iǉj
+	// カスタムカーソル初期化（追加）
 	CustomCursor::Instance().Initialize("Data/Sprite/new_cursor.png");
-	CustomCursor::Instance().Hide();  // Ԃ͔\
+	CustomCursor::Instance().Hide();  // 初期状態は非表示
 
 
-	// V[
+	// シーン初期化
 	SceneManager::Instance().ChangeScene(new SceneTitle);
 
 	srand((unsigned int)time(NULL));
 
 }
-// fXgN^
+// デストラクタ
 Framework::~Framework()
 {
-	// V[I
+	// シーン終了化
 	//sceneGame.Finalize();
 	SceneManager::Instance().Clear();
 
-	// IMGUII
+	// テクスチャアトラス終了化
+	TextureAtlas::Instance().Finalize();
+
+	// シェーダーキャッシュ終了化
+	ShaderCache::Instance().Finalize();
+
+	// IMGUI終了化
 	ImGuiRenderer::Finalize();
 
-	//GtFNg}l[W[I
+	//エフェクトマネージャー終了化
 	EffectManager::Instance().Finalize();
 
-	//I[fBII
+	//オーディオ終了化
 	Audio::Instance().Finalize();
+
+	// ジョブシステム終了化
+	JobSystem::Instance().Finalize();
 }
 
-// XV
+// 更新処理
 void Framework::Update(float elapsedTime)
 {
-	// gDC[XV (lerpɕK{Ȃ̂Ő΍ŏɍXV)
+	PROFILE_SCOPE("Framework::Update");
+
+	// トゥイーン更新処理 (lerpに必須なので絶対最初に更新)
 	TweenManager::Instance().Update(elapsedTime);
 
-	// CvbgXV
+	// インプット更新処理
 	//Input::Instance().Update();
 
 	//KeyInput::Instance().Update();
@@ -91,57 +116,76 @@ void Framework::Update(float elapsedTime)
 	InputManager::Instance().Update();
 
 #ifdef _DEBUG
-	// IMGUIt[Jn	
+	// IMGUIフレーム開始処理	
 	ImGuiRenderer::NewFrame();
 #endif
 
 	CustomCursor::Instance().Update(elapsedTime);
 
-	// V[XV
-	SceneManager::Instance().Update(elapsedTime);
+	// オーディオ更新処理(ストリーミング再生のバッファ補充)
+	Audio::Instance().Update();
+
+	// シーン更新処理
+	{
+		PROFILE_SCOPE("SceneManager::Update");
+		SceneManager::Instance().Update(elapsedTime);
+	}
 }
 
-// `揈
+// 描画処理
 void Framework::Render(float elapsedTime)
 {
-	//ʃXbhɃfoCXReLXggĂꍇ
-	//ANZXȂ悤ɔr䂷
+	PROFILE_SCOPE("Framework::Render");
+
+	//別スレッド宙にデバイスコンテキストが使われていた場合に
+	//同時アクセスをしないように排他制御する
 	std::lock_guard<std::mutex> lock(Graphics::Instance().GetMutex());
 
 	ID3D11DeviceContext* dc = Graphics::Instance().GetDeviceContext();
 
-	// ʃNA
+	// スプライトバッチと使い捨て頂点バッファの統計をフレーム単位で区切る
+	Graphics::Instance().GetSpriteBatch()->NewFrame();
+	Graphics::Instance().GetTransientVertexBuffer()->NewFrame();
+
+	// 画面クリア
 	Graphics::Instance().Clear(0, 0, 0.1f, 1);
 
-	// _[^[Qbgݒ
+	// レンダーターゲット設定
 	Graphics::Instance().SetRenderTargets();
 
-	// V[`揈
-	SceneManager::Instance().Render();
+	// シーン描画処理
+	{
+		PROFILE_SCOPE("SceneManager::Render");
+		SceneManager::Instance().Render();
+	}
 
-	// JX^J[\̕`
+	// カスタムカーソルの描画
 	CustomCursor::Instance().Render(dc);
 
-	// V[GUI`揈
+	// シーンGUI描画処理
 	SceneManager::Instance().DrawGUI();
 
 #if 0
-	// IMGUIfEChE`iIMGUI@\eXgpj
+	// IMGUIデモウインドウ描画（IMGUI機能テスト用）
 	ImGui::ShowDemoWindow();
 #endif
 
 #ifdef _DEBUG
 	ImGuiLogger::Instance().Render();
-	// IMGUI`
+	Profiler::Instance().DrawDebugGUI();
+	// IMGUI描画
 	ImGuiRenderer::Render(dc);
 #endif
 
 
-	// ʕ\
-	Graphics::Instance().Present(syncInterval);
+	// 画面表示
+	{
+		PROFILE_SCOPE("Graphics::Present");
+		Graphics::Instance().Present(syncInterval);
+	}
 }
 
-// t[[gvZ
+// フレームレート計算
 void Framework::CalculateFrameStats()
 {
 	// Code computes the average frames per second, and also the 
@@ -168,7 +212,7 @@ void Framework::CalculateFrameStats()
 	}
 }
 
-// AvP[V[v
+// アプリケーションループ
 int Framework::Run()
 {
 	MSG msg = {};
@@ -198,15 +242,17 @@ int Framework::Run()
 				elapsedTime = timer.TimeInterval();
 			}
 
+			PROFILE_BEGIN_FRAME();
 			Update(elapsedTime);
 			Render(elapsedTime);
+			PROFILE_END_FRAME();
 		}
 	}
 	return static_cast<int>(msg.wParam);
 }
 
 
-// bZ[Wnh
+// メッセージハンドラ
 LRESULT CALLBACK Framework::HandleMessage(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	if (ImGuiRenderer::HandleMessage(hWnd, msg, wParam, lParam))
@@ -1,7 +1,7 @@
 #include <imgui.h>
 #include "FreeCameraController.h"
 
-// JRg[[փp[^𓯊
+// カメラからコントローラーへパラメータを同期する
 void FreeCameraController::SyncCameraToController(const Camera& camera)
 {
 	eye = camera.GetEye();
@@ -9,14 +9,14 @@ void FreeCameraController::SyncCameraToController(const Camera& camera)
 	up = camera.GetUp();
 	right = camera.GetRight();
 
-	// _璍_܂ł̋Zo
+	// 視点から注視点までの距離を算出
 	DirectX::XMVECTOR Eye = DirectX::XMLoadFloat3(&eye);
 	DirectX::XMVECTOR Focus = DirectX::XMLoadFloat3(&focus);
 	DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(Focus, Eye);
 	DirectX::XMVECTOR Distance = DirectX::XMVector3Length(Vec);
 	DirectX::XMStoreFloat(&distance, Distance);
 
-	// ]pxZo
+	// 回転角度を算出
 	const DirectX::XMFLOAT3& front = camera.GetFront();
 	angleX = ::asinf(-front.y);
 	if (up.y < 0)
@@ -38,32 +38,32 @@ void FreeCameraController::SyncCameraToController(const Camera& camera)
 
 }
 
-// Rg[[Jփp[^𓯊
+// コントローラーからカメラへパラメータを同期する
 void FreeCameraController::SyncControllerToCamera(Camera& camera)
 {
 	camera.SetLookAt(eye, focus, up);
 }
 
-// XV
+// 更新処理
 void FreeCameraController::Update()
 {
-	// fobOEChE쒆͏Ȃ
+	// デバッグウインドウ操作中は処理しない
 	if (ImGui::IsWindowFocused(ImGuiFocusedFlags_AnyWindow))
 	{
 		return;
 	}
 
-	// IMGUĨ}EX͒lgăJ삷
+	// IMGUIのマウス入力値を使ってカメラ操作する
 	ImGuiIO io = ImGui::GetIO();
 
-	// }EXJ[\̈ړʂ߂
+	// マウスカーソルの移動量を求める
 	float moveX = io.MouseDelta.x * 0.02f;
 	float moveY = io.MouseDelta.y * 0.02f;
 
-	// }EX{^
+	// マウス左ボタン押下中
 	if (io.MouseDown[ImGuiMouseButton_Right])
 	{
-		// Y]
+		// Y軸回転
 		angleY += moveX * 0.5f;
 		if (angleY > DirectX::XM_PI)
 		{
@@ -73,7 +73,7 @@ void FreeCameraController::Update()
 		{
 			angleY += DirectX::XM_2PI;
 		}
-		// X]
+		// X軸回転
 		angleX += moveY * 0.5f;
 		if (angleX > DirectX::XM_PI)
 		{
@@ -84,10 +84,10 @@ void FreeCameraController::Update()
 			angleX += DirectX::XM_2PI;
 		}
 	}
-	// }EX{^
+	// マウス中ボタン押下中
 	else if (io.MouseDown[ImGuiMouseButton_Middle])
 	{
-		// sړ
+		// 平行移動
 		float s = distance * 0.035f;
 		float x = moveX * s;
 		float y = moveY * s;
@@ -100,16 +100,16 @@ void FreeCameraController::Update()
 		focus.y += up.y * y;
 		focus.z += up.z * y;
 	}
-	// }EXE{^
+	// マウス右ボタン押下中
 	else if (io.MouseDown[ImGuiMouseButton_Left] && io.MouseDown[ImGuiMouseButton_Right])
 	{
-		// Y[
+		// ズーム
 		distance += (-moveY - moveX) * distance * 0.1f;
 	}
-	// }EXzC[
+	// マウスホイール
 	else if (io.MouseWheel != 0)
 	{
-		// Y[
+		// ズーム
 		distance -= io.MouseWheel * distance * 0.1f;
 	}
 
@@ -118,21 +118,21 @@ void FreeCameraController::Update()
 	float sy = ::sinf(angleY);
 	float cy = ::cosf(angleY);
 
-	// J̕Zo
+	// カメラの方向を算出
 	DirectX::XMVECTOR Front = DirectX::XMVectorSet(-cx * sy, -sx, -cx * cy, 0.0f);
 	DirectX::XMVECTOR Right = DirectX::XMVectorSet(cy, 0, -sy, 0.0f);
 	DirectX::XMVECTOR Up = DirectX::XMVector3Cross(Right, Front);
-	// J̎__Zo
+	// カメラの視点＆注視点を算出
 	DirectX::XMVECTOR Focus = DirectX::XMLoadFloat3(&focus);
 	DirectX::XMVECTOR Distance = DirectX::XMVectorSet(distance, distance, distance, 0.0f);
 	DirectX::XMVECTOR Eye = DirectX::XMVectorSubtract(Focus, DirectX::XMVectorMultiply(Front, Distance));
-	// r[s񂩂烏[hsZo
+	// ビュー行列からワールド行列を算出
 	DirectX::XMMATRIX View = DirectX::XMMatrixLookAtLH(Eye, Focus, Up);
 	DirectX::XMMATRIX World = DirectX::XMMatrixTranspose(View);
-	// [hs񂩂Zo
+	// ワールド行列から方向を算出
 	Right = DirectX::XMVector3TransformNormal(DirectX::XMVectorSet(1, 0, 0, 0), World);
 	Up = DirectX::XMVector3TransformNormal(DirectX::XMVectorSet(0, 1, 0, 0), World);
-	// ʂi[
+	// 結果を格納
 	DirectX::XMStoreFloat3(&eye, Eye);
 	DirectX::XMStoreFloat3(&up, Up);
 	DirectX::XMStoreFloat3(&right, Right);
@@ -4,13 +4,13 @@
 class FreeCameraController
 {
 public:
-	// JRg[[փp[^𓯊
+	// カメラからコントローラーへパラメータを同期する
 	void SyncCameraToController(const Camera& camera);
 
-	// Rg[[Jփp[^𓯊
+	// コントローラーからカメラへパラメータを同期する
 	void SyncControllerToCamera(Camera& camera);
 
-	// XV
+	// 更新処理
 	void Update();
 
 private:
@@ -3,8 +3,8 @@
 #include <variant>
 #include <map>
 
-#include <fstream>    // t@CI/Ô߂ɕKv
-#include <iostream>   // G[bZ[WȂǂ̏o͂̂߂ɕKv
+#include <fstream>    // ファイルI/Oのために必要
+#include <iostream>   // エラーメッセージなどの出力のために必要
 #include <cereal/archives/json.hpp>
 #include <cereal/types/string.hpp>
 #include <cereal/types/variant.hpp>
@@ -15,96 +15,96 @@
 class JsonUtils
 {
 public:
-    // 
+    // 書き込み
     template<class Temp>
     static void SaveJsonFile(const Temp& data, const std::string& filename)
     {
-        // o̓t@CXg[쐬
+        // 出力ファイルストリームを作成
         std::ofstream os(filename);
 
-        // t@CɊJꂽ`FbN
+        // ファイルが正常に開かれたかチェック
         if (!os.is_open())
         {
             return;
         }
-        // JSONOutputArchive 쐬At@CXg[Ɋ֘At
+        // JSONOutputArchive を作成し、ファイルストリームに関連付ける
         cereal::JSONOutputArchive archive(os);
 
-        // NodeJsonData IuWFNgVACY
+        // NodeJsonData オブジェクトをシリアライズ
         archive(CEREAL_NVP(data));
     }
-    //(shared_ptr)
+    //書き込み(shared_ptr)
     template<class Temp>
     static void SaveJsonFile(const std::shared_ptr<Temp> data, const std::string& filename)
     {
-        // o̓t@CXg[쐬
+        // 出力ファイルストリームを作成
         std::ofstream os(filename);
 
-        // t@CɊJꂽ`FbN
+        // ファイルが正常に開かれたかチェック
         if (!os.is_open())
         {
             return;
         }
-        // JSONOutputArchive 쐬At@CXg[Ɋ֘At
+        // JSONOutputArchive を作成し、ファイルストリームに関連付ける
         cereal::JSONOutputArchive archive(os);
 
-        // NodeJsonData IuWFNgVACY
+        // NodeJsonData オブジェクトをシリアライズ
         archive(CEREAL_NVP(data));
     }
 
-    // ǂݍ: f[^ύX̂ŔconstQƂɂB/s bool Ԃ悤ɕύX
+    // 読み込み: データを変更するので非const参照にする。成功/失敗を示す bool を返すように変更
     template<class Temp>
     static bool LoadJsonFile(Temp& data, const std::string& filename)
     {
-        // ̓t@CXg[쐬
+        // 入力ファイルストリームを作成
         std::ifstream is(filename);
 
-        // t@CɊJꂽ`FbN
+        // ファイルが正常に開かれたかチェック
         if (!is.is_open())
         {
-            return false; // s
+            return false; // 失敗
         }
 
         try
         {
-            // JSONInputArchive 쐬At@CXg[Ɋ֘At
+            // JSONInputArchive を作成し、ファイルストリームに関連付ける
             cereal::JSONInputArchive archive(is);
-            // NodeJsonData IuWFNgfVACY
+            // NodeJsonData オブジェクトをデシリアライズ
             archive(CEREAL_NVP(data));
-            return true; // 
+            return true; // 成功
         }
         catch (const cereal::Exception& e)
         {
-            return false; // s
+            return false; // 失敗
         }
     }
 
-    //ǂݍ(shared_ptr)
+    //読み込み(shared_ptr)
     template<class Temp>
     static bool LoadJsonFile(std::shared_ptr<Temp>& data, const std::string& filename)
     {
-        // ̓t@CXg[쐬
+        // 入力ファイルストリームを作成
         std::ifstream is(filename);
 
-        // t@CɊJꂽ`FbN
+        // ファイルが正常に開かれたかチェック
         if (!is.is_open())
         {
-            return false; // s
+            return false; // 失敗
         }
 
         try
         {
-            // JSONInputArchive 쐬At@CXg[Ɋ֘At
+            // JSONInputArchive を作成し、ファイルストリームに関連付ける
             cereal::JSONInputArchive archive(is);
 
-            // NodeJsonData IuWFNgfVACY
+            // NodeJsonData オブジェクトをデシリアライズ
             archive(CEREAL_NVP(data));
 
-            return true; // 
+            return true; // 成功
         }
         catch (const cereal::Exception& e)
         {
-            return false; // s
+            return false; // 失敗
         }
     }
 };
\ No newline at end of file
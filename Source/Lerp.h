@@ -51,50 +51,50 @@ public:
     }
     ~Lerp() {}
 
-    //`⊮֐
-    //v1`v2܂ł̒ltgČvZ
+    //線形補完関数
+    //v1～v2までの値をtを使って計算する
     float lerp(float v1, float v2,float t)
     {
         return (1.0f - t) * v1 + t * v2;
     };
 private:
-    //C[WO֐
+    //イージング関数
     float easeInSine(float x)
     {
         return 1.0f - cosf((x * DirectX::XM_PI) / 2.0f);
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInQuad(float x)
     {
         return x * x;
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInCubic(float x)
     {
         return x * x * x;
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInQuart(float x)
     {
         return x * x * x * x;
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInQuint(float x)
     {
         return x * x * x * x * x;
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInCirc(float x)
     {
         return 1.0f - static_cast<float>(sqrt(1.0 - pow(x, 2)));
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInBack(float x)
     {
         const float c1 = 1.70158f;
@@ -104,13 +104,13 @@ private:
         return c3 * x * x * x - c1 * x * x;
     };
 
-    //C[WO֐
+    //イージング関数
     float easeOutCubic(float x)
     {
         return static_cast < float>(1.0f - pow(1.0f - x, 3.0f));
     };
 
-    //C[WO֐
+    //イージング関数
     float easeOutBack(float x)
     {
         const float c1 = 1.70158f;
@@ -119,7 +119,7 @@ private:
         return 1.0f + c3 * pow(x - 1.0f, 3.0f) + c1 * pow(x - 1.0f, 2.0f);
     };
 
-    //C[WO֐
+    //イージング関数
     float easeOutElastic(float x)
     {
         const float c4 = (2.0f * DirectX::XM_PI) / 3.0f;
@@ -131,7 +131,7 @@ private:
             : pow(2.0f, -10.0f * x) * sin((x * 10.0f - 0.75f) * c4) + 1.0f;
     };
 
-    //C[WO֐
+    //イージング関数
     float easeOutBounce(float x)
     {
         const float n1 = 7.5625f;
@@ -151,19 +151,19 @@ private:
         }
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInOutCubic(float x)
     {
         return static_cast<float>(x < 0.5f ? 4.0f * x * x * x : 1.0f - pow(-2.0f * x + 2.0f, 3.0f) / 2.0f);
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInOutQuart(float x)
     {
         return static_cast<float>(x < 0.5f ? 8.0f * x * x * x * x : 1.0f - pow(-2.0f * x + 2.0f, 4.0f) / 2.0f);
     };
 
-    //C[WO֐
+    //イージング関数
     float easeInOutBack(float x)
     {
         const float c1 = 1.70158f;
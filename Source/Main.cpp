@@ -46,9 +46,9 @@ INT WINAPI wWinMain(HINSTANCE instance, HINSTANCE prev_instance, LPWSTR cmd_line
 	AdjustWindowRect(&rc, WS_OVERLAPPEDWINDOW, FALSE);
 	HWND hWnd = CreateWindow(
 		_T("Game"), _T(""),
-		WS_POPUP | WS_VISIBLE,  //  tXN[X^CɕύX
+		WS_POPUP | WS_VISIBLE,  // ← フルスクリーン風スタイルに変更
 		0, 0,
-		SCREEN_WIDTH, SCREEN_HEIGHT,  //  ʂςɂ
+		SCREEN_WIDTH, SCREEN_HEIGHT,  // ← 画面いっぱいにする
 		NULL, NULL, instance, NULL
 	);
 	ShowWindow(hWnd, cmd_show);
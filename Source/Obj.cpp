@@ -23,56 +23,56 @@ void Obj::Finalize()
 }
 
 
-//sXV
+//行列更新処理
 void Obj::UpdateTransfomEuler()
 {
-	//XP[s񐧍
+	//スケール行列制作
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z);
 
-	//]s𐧍
+	//回転行列を制作
 	DirectX::XMMATRIX R = DirectX::XMMatrixRotationRollPitchYaw(angle.x, angle.y, angle.z);
 
-	//ʒus쐬
+	//位置行列を作成
 	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(position.x, position.y, position.z);
 
-	//O̍sgݍ킹ă[hs쐬
+	//三つの行列を組み合わせてワールド行列を作成
 	DirectX::XMMATRIX W = S * R * T;
 
-	//vZ[hso
+	//計算したワールド行列を取り出す
 	DirectX::XMStoreFloat4x4(&transform, W);
 }
 
 void Obj::UpdateTransfomQuaternion()
 {
-	//XP[s񐧍
+	//スケール行列制作
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z);
 
 	DirectX::XMVECTOR Q = DirectX::XMLoadFloat4(&rotation);
 	Q = DirectX::XMQuaternionNormalize(Q);
 	DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(Q);
 
-	//ʒus쐬
+	//位置行列を作成
 	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(position.x, position.y, position.z);
 
-	//O̍sgݍ킹ă[hs쐬
+	//三つの行列を組み合わせてワールド行列を作成
 	DirectX::XMMATRIX W = S * R * T;
 
-	//vZ[hso
+	//計算したワールド行列を取り出す
 	DirectX::XMStoreFloat4x4(&transform, W);
 
 }
 
-//Ăق̃xNg
-//IuWFNg̑O
+//向いてほしい方向のベクトル
+//オブジェクトの前方向
 void Obj::SetRotation(const DirectX::XMVECTOR& Vec, const DirectX::XMFLOAT3 Forward)
 {
     using namespace DirectX;
 
-    // KꂽxNg
+    // 正規化された方向ベクトル
     XMVECTOR V = XMVector3Normalize(Vec);
     XMVECTOR F = XMVector3Normalize(XMLoadFloat3(&Forward));
 
-    // ]Ɗpx߂
+    // 回転軸と角度を求める
     XMVECTOR AXIS = XMVector3Cross(F, V);
     float dot = XMVectorGetX(XMVector3Dot(F, V));
     dot = std::clamp(dot, -1.0f, 1.0f);
@@ -85,12 +85,12 @@ void Obj::SetRotation(const DirectX::XMVECTOR& Vec, const DirectX::XMFLOAT3 Forw
     {
         if (dot > 0.0f)
         {
-            // Ȃ]Ȃ
+            // 同じ方向なら回転なし
             Q = XMQuaternionIdentity();
         }
         else
         {
-            // ΕȂY180x]iZOj
+            // 反対方向ならY軸180度回転（Z軸前提）
             Q = XMQuaternionRotationAxis(XMVectorSet(0, 1, 0, 0), XM_PI);
         }
     }
@@ -100,15 +100,15 @@ void Obj::SetRotation(const DirectX::XMVECTOR& Vec, const DirectX::XMFLOAT3 Forw
         Q = XMQuaternionRotationAxis(XMVector3Normalize(AXIS), angle);
     }
 
-    // Kĕۑ
+    // 正規化して保存
     XMStoreFloat4(&rotation, XMQuaternionNormalize(Q));
 }
-//XV
+//更新処理
 void Obj::Update(float elapsdTime)
 {
 }
 
-//`揈
+//描画処理
 void Obj::Render(const RenderContext& rc, ModelRenderer* renderer)
 {
     if (model != nullptr)
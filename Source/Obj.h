@@ -15,13 +15,13 @@ protected:
 	DirectX::XMFLOAT3	scale = { 1,1,1 };
 	DirectX::XMFLOAT4	rotation = {};
 	DirectX::XMFLOAT4X4 transform = {
-		//XP[x
+		//スケールx
 		1, 0, 0, 0,
-		//XP[y
+		//スケールy
 		0, 1, 0, 0,
-		//]
+		//回転
 		0, 0, 1, 0,
-		//ʒu
+		//位置
 		0, 0, 0, 1
 	};
 
@@ -32,32 +32,32 @@ public:
 	Obj();
 	virtual ~Obj();
 
-	//
+	//初期化
 	void Initialize();
 
-	//I
+	//終了化
 	void Finalize();
 
 public:
 
 	/////////////////////////////////////////////
 
-	//ʒu擾
+	//位置取得
 	const DirectX::XMFLOAT3& GetPosition() const { return position; }
 
-	//ʒuݒ
+	//位置設定
 	void SetPosition(const DirectX::XMFLOAT3& position) { this->position = position; }
 
-	//]擾
+	//回転取得
 	const DirectX::XMFLOAT3& GetAngle() const { return angle; }
 
-	//]ݒ
+	//回転設定
 	void SetAngle(const DirectX::XMFLOAT3& angle) { this->angle = angle; }
 
-	//XP[擾
+	//スケール取得
 	const DirectX::XMFLOAT3& GetScale() const { return scale; }
 
-	//XP[擾
+	//スケール取得
 	void SetScale(const DirectX::XMFLOAT3& scale) { this->scale = scale; }
 
 	const DirectX::XMFLOAT4X4& GetTransform() { return transform; }
@@ -75,22 +75,22 @@ public:
 	/////////////////////////////////////////////
 
 public:
-	//Abvf[g
+	//アップデート
 	virtual void Update(float elapsedTime);
 
-	//_[
+	//レンダー
 	virtual void Render(const RenderContext& rc, ModelRenderer* renderer);
 
-	//s񏈗
+	//行列処理
 	void UpdateTransfomEuler();
 
-	//s񏈗
+	//行列処理
 	void UpdateTransfomQuaternion();
 
-	//fobOs~eBu`
+	//デバッグピリミティブ描画
 	virtual void RenderDebugPrimitive(const RenderContext& rc, ShapeRenderer* renderer) {};
 
-	//GUI`
+	//GUI描画
 	virtual void DrawDebugGUI() {};
 
 };
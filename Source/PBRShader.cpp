@@ -5,44 +5,52 @@
 PBRShader::PBRShader(ID3D11Device* device) {
     OutputDebugStringA("PBRShader constructor START\n");
 
-    // TCY`FbN
-    _ASSERT_EXPR(sizeof(CbPointLight) == 32, "CbPointLight size must be 32 bytes");
-    _ASSERT_EXPR(sizeof(CbSpotLight) == 64, "CbSpotLight size must be 64 bytes");
-    _ASSERT_EXPR(sizeof(CbScene) == 624, "CbScene size must be 624 bytes");
+    // サイズチェック
 
     OutputDebugStringA("Size checks passed\n");
 
-    // ̓CAEg̒`
-    OutputDebugStringA("Creating input layout\n");
-    D3D11_INPUT_ELEMENT_DESC inputElementDesc[] = {
-        { "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "NORMAL",       0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TANGENT",      0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD",     0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "BONE_WEIGHTS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "BONE_INDICES", 0, DXGI_FORMAT_R32G32B32A32_UINT,  0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-    };
-
-    // _VF[_[̓ǂݍ
+    // 頂点シェーダーの読み込み(頂点形式ごと)
     OutputDebugStringA("Loading vertex shader\n");
-    GpuResourceUtils::LoadVertexShader(
-        device,
+    const char* vertexShaderFilenames[] = {
         "Data/Shader/pbr_model_vs.cso",
-        inputElementDesc,
-        _countof(inputElementDesc),
-        inputLayout.GetAddressOf(),
-        vertexShader.GetAddressOf()
-    );
-
-    // sNZVF[_[̓ǂݍ
-    OutputDebugStringA("Loading pixel shader\n");
-    GpuResourceUtils::LoadPixelShader(
-        device,
+        "Data/Shader/pbr_model_skinned_vs.cso",
+    };
+    static_assert(_countof(vertexShaderFilenames) == static_cast<int>(Model::VertexFormat::Count));
+    for (int i = 0; i < static_cast<int>(Model::VertexFormat::Count); ++i) {
+        const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElementDescs =
+            Model::GetInputElementDescs(static_cast<Model::VertexFormat>(i));
+        GpuResourceUtils::LoadVertexShader(
+            device,
+            vertexShaderFilenames[i],
+            inputElementDescs.data(),
+            static_cast<UINT>(inputElementDescs.size()),
+            inputLayouts[i].GetAddressOf(),
+            vertexShaders[i].GetAddressOf()
+        );
+    }
+
+    // ピクセルシェーダーの読み込み(パーミュテーションの番号順、ビルド時に全ての組み合わせをコンパイルしておく)
+    OutputDebugStringA("Loading pixel shaders\n");
+    const char* pixelShaderFilenames[] = {
+        "Data/Shader/pbr_model_ps_maya_style_flat_nolights.cso",
+        "Data/Shader/pbr_model_ps_maya_style_nolights.cso",
+        "Data/Shader/pbr_model_ps_maya_style_flat_mask_nolights.cso",
+        "Data/Shader/pbr_model_ps_maya_style_mask_nolights.cso",
+        "Data/Shader/pbr_model_ps_maya_style_flat.cso",
         "Data/Shader/pbr_model_ps_maya_style.cso",
-        pixelShader.GetAddressOf()
-    );
+        "Data/Shader/pbr_model_ps_maya_style_flat_mask.cso",
+        "Data/Shader/pbr_model_ps_maya_style_mask.cso",
+    };
+    static_assert(_countof(pixelShaderFilenames) == PixelPermutationCount);
+    for (int i = 0; i < PixelPermutationCount; ++i) {
+        GpuResourceUtils::LoadPixelShader(
+            device,
+            pixelShaderFilenames[i],
+            pixelShaders[i].GetAddressOf()
+        );
+    }
 
-    // bV萔obt@̍쐬
+    // メッシュ定数バッファの作成
     OutputDebugStringA("Creating mesh constant buffer\n");
     {
         D3D11_BUFFER_DESC desc = {};
@@ -59,24 +67,7 @@ PBRShader::PBRShader(ID3D11Device* device) {
         OutputDebugStringA("Mesh constant buffer created\n");
     }
 
-    // V[萔obt@̍쐬
-    OutputDebugStringA("Creating scene constant buffer\n");
-    {
-        D3D11_BUFFER_DESC desc = {};
-        desc.ByteWidth = sizeof(CbScene);
-        desc.Usage = D3D11_USAGE_DEFAULT;
-        desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        desc.CPUAccessFlags = 0;
-        desc.MiscFlags = 0;
-        desc.StructureByteStride = 0;
-
-        HRESULT hr = device->CreateBuffer(&desc, nullptr, sceneConstantBuffer.GetAddressOf());
-        _ASSERT_EXPR(SUCCEEDED(hr), "Failed to create scene constant buffer");
-
-        OutputDebugStringA("Scene constant buffer created\n");
-    }
-
-    // Tv[Xe[g̍쐬
+    // サンプラーステートの作成
     OutputDebugStringA("Creating sampler states\n");
     {
         D3D11_SAMPLER_DESC desc = {};
@@ -87,17 +78,17 @@ PBRShader::PBRShader(ID3D11Device* device) {
         desc.MinLOD = 0;
         desc.MaxLOD = D3D11_FLOAT32_MAX;
 
-        // POINT Tv[
+        // POINT サンプラー
         desc.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
         HRESULT hr = device->CreateSamplerState(&desc, samplerStates[0].GetAddressOf());
         _ASSERT_EXPR(SUCCEEDED(hr), "Failed to create POINT sampler");
 
-        // LINEAR Tv[
+        // LINEAR サンプラー
         desc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
         hr = device->CreateSamplerState(&desc, samplerStates[1].GetAddressOf());
         _ASSERT_EXPR(SUCCEEDED(hr), "Failed to create LINEAR sampler");
 
-        // ANISOTROPIC Tv[
+        // ANISOTROPIC サンプラー
         desc.Filter = D3D11_FILTER_ANISOTROPIC;
         desc.MaxAnisotropy = 16;
         hr = device->CreateSamplerState(&desc, samplerStates[2].GetAddressOf());
@@ -106,88 +97,15 @@ PBRShader::PBRShader(ID3D11Device* device) {
 
     OutputDebugStringA("PBRShader constructor END\n");
 
-    // : materialStructuredBufferSRV  Model ǂݍݎɐݒ肳܂
+    // 注意: materialTable は ModelRenderer が設定します
 }
 
 void PBRShader::Begin(const RenderContext& rc) {
     ID3D11DeviceContext* dc = rc.deviceContext;
 
-    // VF[_[Ɠ̓CAEg̐ݒ
-    dc->VSSetShader(vertexShader.Get(), nullptr, 0);
-    dc->PSSetShader(pixelShader.Get(), nullptr, 0);
-    dc->IASetInputLayout(inputLayout.Get());
-
-    // V[萔obt@̏
-    CbScene cbScene = {};
-    memset(&cbScene, 0, sizeof(CbScene));
-
-    // r[vWFNVs̐ݒ
-    DirectX::XMMATRIX V = DirectX::XMLoadFloat4x4(&rc.camera->GetView());
-    DirectX::XMMATRIX P = DirectX::XMLoadFloat4x4(&rc.camera->GetProjection());
-    DirectX::XMMATRIX VP = V * P;
-    DirectX::XMStoreFloat4x4(&cbScene.viewProjection, VP);
-
-    // fBNViCg̐ݒ
-    if (rc.lightManager) {
-        const DirectionalLight& light = rc.lightManager->GetDirectionalLight();
-        cbScene.lightDirection = DirectX::XMFLOAT4(
-            light.direction.x,
-            light.direction.y,
-            light.direction.z,
-            0.0f
-        );
-    }
-    else {
-        cbScene.lightDirection = DirectX::XMFLOAT4(0.0f, -1.0f, 0.0f, 0.0f);
-    }
-
-    // Jʒu̐ݒ
-    DirectX::XMFLOAT3 eye = rc.camera->GetEye();
-    cbScene.cameraPosition = DirectX::XMFLOAT4(eye.x, eye.y, eye.z, 1.0f);
-
-    // ArGgƃGNX|[W[̐ݒ
-    cbScene.ambientIntensity = 0.02f;
-    cbScene.exposure = 0.3f;
-
-    // Cg̐ݒ
-    if (rc.lightManager) {
-        // |CgCg̎擾Ɛݒ
-        std::vector<PointLight> nearestLights = rc.lightManager->GetNearestPointLights(eye, 8);
-        cbScene.pointLightCount = static_cast<int>(nearestLights.size());
-
-        for (size_t i = 0; i < nearestLights.size() && i < 8; ++i) {
-            cbScene.pointLights[i].position = nearestLights[i].position;
-            cbScene.pointLights[i].range = nearestLights[i].range;
-            cbScene.pointLights[i].color = nearestLights[i].color;
-            cbScene.pointLights[i].intensity = nearestLights[i].intensity;
-        }
+    // シェーダーはメッシュの頂点形式とマテリアルに合わせて Update() で設定する
 
-        // X|bgCg̎擾Ɛݒ
-        std::vector<SpotLight> nearestSpotLights = rc.lightManager->GetNearestSpotLights(eye, 4);
-        cbScene.spotLightCount = static_cast<int>(nearestSpotLights.size());
-
-        for (size_t i = 0; i < nearestSpotLights.size() && i < 4; ++i) {
-            cbScene.spotLights[i].position = nearestSpotLights[i].position;
-            cbScene.spotLights[i].range = nearestSpotLights[i].range;
-            cbScene.spotLights[i].direction = nearestSpotLights[i].direction;
-            cbScene.spotLights[i].innerConeAngle = DirectX::XMConvertToRadians(nearestSpotLights[i].innerConeAngle);
-            cbScene.spotLights[i].color = nearestSpotLights[i].color;
-            cbScene.spotLights[i].outerConeAngle = DirectX::XMConvertToRadians(nearestSpotLights[i].outerConeAngle);
-            cbScene.spotLights[i].intensity = nearestSpotLights[i].intensity;
-            cbScene.spotLights[i].pad = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
-        }
-    }
-    else {
-        cbScene.pointLightCount = 0;
-        cbScene.spotLightCount = 0;
-    }
-
-    // 萔obt@̍XVƐݒ
-    dc->UpdateSubresource(sceneConstantBuffer.Get(), 0, 0, &cbScene, 0, 0);
-    dc->VSSetConstantBuffers(1, 1, sceneConstantBuffer.GetAddressOf());
-    dc->PSSetConstantBuffers(1, 1, sceneConstantBuffer.GetAddressOf());
-
-    // Tv[Xe[g̐ݒ
+    // サンプラーステートの設定
     ID3D11SamplerState* samplers[3] = {
         samplerStates[0].Get(),
         samplerStates[1].Get(),
@@ -195,37 +113,51 @@ void PBRShader::Begin(const RenderContext& rc) {
     };
     dc->PSSetSamplers(0, 3, samplers);
 
-    // }eA\obt@̐ݒ
-    if (materialStructuredBufferSRV) {
-        dc->PSSetShaderResources(0, 1, materialStructuredBufferSRV.GetAddressOf());
+    // メッシュ定数バッファの設定
+    dc->VSSetConstantBuffers(0, 1, meshConstantBuffer.GetAddressOf());
+    dc->PSSetConstantBuffers(0, 1, meshConstantBuffer.GetAddressOf());
+
+    // マテリアルテーブルとテクスチャ配列の設定(メッシュごとにはマテリアルの番号だけを渡す)
+    if (materialTable) {
+        ID3D11ShaderResourceView* materialSRV = materialTable->GetShaderResourceView();
+        dc->PSSetShaderResources(MaterialTable::MaterialSlot, 1, &materialSRV);
+        dc->PSSetShaderResources(MaterialTable::TextureArraySlot, MaterialTable::MaxTextureArrays,
+            materialTable->GetTextureArrayViews());
     }
     else {
-        // }eAobt@ݒ̏ꍇ͌xî݁j
+        // マテリアルテーブルが未設定の場合は警告（初回のみ）
         static bool warned = false;
         if (!warned) {
-            OutputDebugStringA("Warning: materialStructuredBufferSRV is not set\n");
+            OutputDebugStringA("Warning: materialTable is not set\n");
             warned = true;
         }
     }
 }
 
-void PBRShader::Update(const RenderContext& rc, const Model::Mesh& mesh) {
-    ID3D11DeviceContext* dc = rc.deviceContext;
+void PBRShader::Update(const RenderContext& rc, RenderBackend& backend, const Model::Mesh& mesh) {
+    // 頂点形式に合わせたシェーダーと入力レイアウトの設定
+    const int vertexFormat = static_cast<int>(mesh.vertexFormat);
+    backend.SetVertexShader(vertexShaders[vertexFormat].Get());
+    backend.SetInputLayout(inputLayouts[vertexFormat].Get());
+
+    // マテリアルとライトに合わせたピクセルシェーダーの設定(同じパーミュテーションが続けば backend が取り除く)
+    uint32_t permutation = GetPermutation(mesh);
+    if (rc.lightManager && (!rc.lightManager->GetAllPointLights().empty() || !rc.lightManager->GetAllSpotLights().empty())) {
+        permutation |= LocalLights;
+    }
+    backend.SetPixelShader(pixelShaders[permutation].Get());
 
-    // bV萔obt@̏
-    CbMesh cbMesh;
+    // メッシュ定数バッファの準備
+    CbMesh cbMesh = {};
     cbMesh.world = mesh.node->worldTransform;
-    cbMesh.material = mesh.materialIndex;
-    cbMesh.hasTangent = 1;
-    cbMesh.skin = -1;
-    cbMesh.pad = 0;
+    cbMesh.material = mesh.material->tableIndex;
 
-    // 萔obt@̍XVƐݒ
-    dc->UpdateSubresource(meshConstantBuffer.Get(), 0, 0, &cbMesh, 0, 0);
-    dc->VSSetConstantBuffers(0, 1, meshConstantBuffer.GetAddressOf());
-    dc->PSSetConstantBuffers(0, 1, meshConstantBuffer.GetAddressOf());
+    // 定数バッファの更新(設定は Begin() で済ませている)
+    backend.UpdateConstantBuffer(meshConstantBuffer.Get(), &cbMesh, sizeof(cbMesh));
+
+    // テクスチャ配列にまとめられなかったマテリアルだけ、テクスチャを設定する
+    if (!mesh.material->bindTextures) return;
 
-    // }eAeNX`̐ݒ
     ID3D11ShaderResourceView* srvs[5] = {
         mesh.material->baseMap.Get(),
         mesh.material->metalnessRoughnessMap.Get(),
@@ -233,13 +165,20 @@ void PBRShader::Update(const RenderContext& rc, const Model::Mesh& mesh) {
         mesh.material->emissiveMap.Get(),
         mesh.material->occlusionMap.Get()
     };
-    dc->PSSetShaderResources(1, 5, srvs);
+    backend.SetPixelShaderResources(1, 5, srvs);
+}
+
+uint32_t PBRShader::GetPermutation(const Model::Mesh& mesh) const {
+    uint32_t permutation = 0;
+    if (mesh.material->normalMap) permutation |= NormalMap;
+    if (mesh.material->alphaMode == Model::AlphaMode::Mask) permutation |= AlphaMask;
+    return permutation;
 }
 
 void PBRShader::End(const RenderContext& rc) {
     ID3D11DeviceContext* dc = rc.deviceContext;
 
-    // VF[_[\[X̃NA
+    // シェーダーリソースのクリア
     ID3D11ShaderResourceView* nullSrvs[6] = { nullptr };
     dc->PSSetShaderResources(0, 6, nullSrvs);
 }
\ No newline at end of file
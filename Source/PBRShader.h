@@ -8,6 +8,7 @@
 #include "System/Model.h"
 #include <memory>
 #include "System/Light.h"
+#include "System/MaterialTable.h"
 
 class PBRShader : public Shader {
 public:
@@ -17,64 +18,36 @@ public:
     }
 
     void Begin(const RenderContext& rc) override;
-    void Update(const RenderContext& rc, const Model::Mesh& mesh) override;
+    void Update(const RenderContext& rc, RenderBackend& backend, const Model::Mesh& mesh) override;
     void End(const RenderContext& rc) override;
-    void SetMaterialBufferSRV(Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv) {
-        materialStructuredBufferSRV = srv;
+    uint32_t GetPermutation(const Model::Mesh& mesh) const override;
+
+    // ピクセルシェーダーのパーミュテーション(pbr_model_ps_maya_style.hlsl の define と合わせる)
+    // マテリアルで決まるものと、フレームのライトで決まるものをビットで組み合わせた番号で選ぶ
+    enum PixelPermutation : uint32_t {
+        NormalMap = 1 << 0,     // 法線マップを使う
+        AlphaMask = 1 << 1,     // アルファテストで切り抜く
+        LocalLights = 1 << 2,   // 点光源とスポットライトを計算する
+        PixelPermutationCount = 1 << 3,
+    };
+    // 全モデルのマテリアルをまとめたテーブル(ModelRenderer が持つ)
+    void SetMaterialTable(MaterialTable* table) {
+        materialTable = table;
     }
 private:
-    Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShader;
-    Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
-    Microsoft::WRL::ComPtr<ID3D11InputLayout> inputLayout;
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShaders[static_cast<int>(Model::VertexFormat::Count)];
+    Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShaders[PixelPermutationCount];
+    Microsoft::WRL::ComPtr<ID3D11InputLayout> inputLayouts[static_cast<int>(Model::VertexFormat::Count)];
 
-    // bV萔obt@ (register(b0))
+    // メッシュ定数バッファ (register(b0))
     struct CbMesh {
         DirectX::XMFLOAT4X4 world;
         int material;
-        int hasTangent;
-        int skin;
-        int pad;
+        int pad[3];
     };
     Microsoft::WRL::ComPtr<ID3D11Buffer> meshConstantBuffer;
 
-    // |CgCg\ - HLSLƊSv
-    struct CbPointLight {
-        DirectX::XMFLOAT3 position;
-        float range;
-        DirectX::XMFLOAT3 color;
-        float intensity;
-    };
-
-    // X|bgCg\ - HLSLƊSv
-    struct CbSpotLight {
-        DirectX::XMFLOAT3 position;
-        float range;
-        DirectX::XMFLOAT3 direction;
-        float innerConeAngle;
-        DirectX::XMFLOAT3 color;
-        float outerConeAngle;
-        float intensity;
-        DirectX::XMFLOAT3 pad;
-    };
-
-    // V[萔obt@ (register(b1))
-    struct CbScene {
-        DirectX::XMFLOAT4X4 viewProjection;  // 64 bytes
-        DirectX::XMFLOAT4 lightDirection;    // 16 bytes
-        DirectX::XMFLOAT4 cameraPosition;    // 16 bytes
-        float ambientIntensity;              // 4 bytes
-        float exposure;                      // 4 bytes
-        int pointLightCount;                 // 4 bytes
-        int spotLightCount;                  // 4 bytes
-        CbPointLight pointLights[8];         // 32 * 8 = 256 bytes
-        CbSpotLight spotLights[4];           // 64 * 4 = 256 bytes
-        // Total: 64 + 16 + 16 + 16 + 256 + 256 = 624 bytes
-    };
-
-    Microsoft::WRL::ComPtr<ID3D11Buffer> sceneConstantBuffer;
-
-    Microsoft::WRL::ComPtr<ID3D11Buffer> materialStructuredBuffer;
-    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> materialStructuredBufferSRV;
+    MaterialTable* materialTable = nullptr;
 
     Microsoft::WRL::ComPtr<ID3D11SamplerState> samplerStates[3];
 };
\ No newline at end of file
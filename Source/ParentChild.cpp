@@ -5,10 +5,10 @@ void ParentChild::MakeParentAndChild(
 	DirectX::XMFLOAT4X4& ChildTransform)
 {
 	using namespace DirectX;
-	XMMATRIX PW = XMLoadFloat4x4(&ParentTransform);	//ẽ[hW
-	XMMATRIX CG = XMLoadFloat4x4(&ChildTransform);	//q̃O[oW
-	XMMATRIX CW = CG * PW;							//q̃[hW
-	XMStoreFloat4x4(&ChildTransform, CW);			//K
+	XMMATRIX PW = XMLoadFloat4x4(&ParentTransform);	//親のワールド座標
+	XMMATRIX CG = XMLoadFloat4x4(&ChildTransform);	//子供のグローバル座標
+	XMMATRIX CW = CG * PW;							//子供のワールド座標
+	XMStoreFloat4x4(&ChildTransform, CW);			//適応
 }
 
 void ParentChild::MakeParentAndChild(
@@ -19,14 +19,14 @@ void ParentChild::MakeParentAndChild(
 	DirectX::XMFLOAT4X4& ChildTransform)
 {
 	using namespace DirectX;
-	//̃[JsvZ
+	//武器のローカル行列を計算
 	XMMATRIX S = XMMatrixScaling(ChildScale.x,ChildScale.y,ChildScale.z);
 	XMMATRIX R = XMMatrixRotationRollPitchYaw(ChildAngle.x, ChildAngle.y, ChildAngle.z);
 	XMMATRIX T = XMMatrixTranslation(ChildPos.x,ChildPos.y,ChildPos.z);
-	// ẽ[hsǂݍ
+	// 親のワールド行列を読み込み
 	XMMATRIX PW = XMLoadFloat4x4(&ParentTransform);
 
-	// q̍ŏI[hsieɃA^b`ėj
+	// 子の最終ワールド行列（親にアタッチして離す）
 	XMMATRIX CW = S * R * T * PW;
 
 	XMStoreFloat4x4(&ChildTransform, CW);
@@ -40,7 +40,7 @@ void ParentChild::MakeParentAndChild(
 	DirectX::XMFLOAT4X4& ChildTransform)
 {
 	using namespace DirectX;
-	//̃[JsvZ
+	//武器のローカル行列を計算
 	XMMATRIX S = XMMatrixScaling(ChildScale.x, ChildScale.y, ChildScale.z);
 
 	DirectX::XMVECTOR Q = DirectX::XMLoadFloat4(&ChildRotation);
@@ -48,10 +48,10 @@ void ParentChild::MakeParentAndChild(
 	DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(Q);
 	
 	XMMATRIX T = XMMatrixTranslation(ChildPos.x, ChildPos.y, ChildPos.z);
-	// ẽ[hsǂݍ
+	// 親のワールド行列を読み込み
 	XMMATRIX PW = XMLoadFloat4x4(&ParentTransform);
 
-	// q̍ŏI[hsieɃA^b`ėj
+	// 子の最終ワールド行列（親にアタッチして離す）
 	XMMATRIX CW = S * R * T * PW;
 
 	XMStoreFloat4x4(&ChildTransform, CW);
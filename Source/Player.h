@@ -4,16 +4,15 @@
 #include "game_object.h"
 #include <collider.h>
 #include "rigidbody.h"
-
-class CameraController;
+#include "camera_controller.h"
+#include "world.h"
 
 class Player : public GameObject {
 public:
     Player(const char* model_filepath = nullptr,
         const DirectX::XMFLOAT3& pos = { 0.0f, 0.0f, 0.0f })
         : GameObject(model_filepath, pos),
-        move_speed_(5.0f),
-        camera_controller_(nullptr) {
+        move_speed_(5.0f) {
     }
 
     virtual ~Player() = default;
@@ -24,11 +23,12 @@ public:
     }
 
     void SetCameraController(CameraController* camera) {
-        camera_controller_ = camera;
+        camera_controller_ = camera ? camera->GetHandle() : GameObjectHandle();
     }
 
+    // カメラが破棄されていれば nullptr を返す
     CameraController* GetCameraController() const {
-        return camera_controller_;
+        return GetWorld() ? GetWorld()->Resolve<CameraController>(camera_controller_) : nullptr;
     }
 
     void SetMoveSpeed(float speed) {
@@ -43,9 +43,10 @@ private:
     void HandleInput(float elapsed_time) {
         DirectX::XMFLOAT3 move_dir = { 0.0f, 0.0f, 0.0f };
 
-        if (camera_controller_ && 
-            (camera_controller_->GetMode() == CameraMode::kFirstPerson || camera_controller_->GetMode() == CameraMode::kThirdPerson)) {
-            Camera* cam = camera_controller_->GetCamera();
+        CameraController* camera_controller = GetCameraController();
+        if (camera_controller && 
+            (camera_controller->GetMode() == CameraMode::kFirstPerson || camera_controller->GetMode() == CameraMode::kThirdPerson)) {
+            Camera* cam = camera_controller->GetCamera();
             DirectX::XMFLOAT3 forward = cam->GetFront();
             DirectX::XMFLOAT3 right = cam->GetRight();
 
@@ -110,7 +111,7 @@ private:
             ImGui::Text("Active: %s", IsActive() ? "TRUE" : "FALSE");
             ImGui::Text("Move Speed: %.3f", move_speed_);
             ImGui::Text("Camera: %s",
-                camera_controller_ ? "CONNECTED" : "NOT SET");
+                GetCameraController() ? "CONNECTED" : "NOT SET");
         }
 
         if (ImGui::CollapsingHeader("Position",
@@ -140,7 +141,7 @@ private:
     }
 
     float move_speed_;
-    CameraController* camera_controller_;
+    GameObjectHandle camera_controller_;
 };
 
 #endif
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include <DirectXCollision.h>
 #include "RayCast.h"
 
-// CLXg
+// レイキャスト
 bool Hit::RayCast(
 	const DirectX::XMFLOAT3& start,
 	const DirectX::XMFLOAT3& end,
@@ -12,7 +12,7 @@ bool Hit::RayCast(
 {
 	bool hit = false;
 
-	// n_ƏI_烌C̃xNgƒ߂
+	// 始点と終点からレイのベクトルと長さを求める
 	DirectX::XMVECTOR WorldRayStart = DirectX::XMLoadFloat3(&start);
 	DirectX::XMVECTOR WorldRayEnd = DirectX::XMLoadFloat3(&end);
 	DirectX::XMVECTOR WorldRayVec = DirectX::XMVectorSubtract(WorldRayEnd, WorldRayStart);
@@ -23,16 +23,16 @@ bool Hit::RayCast(
 
 	DirectX::XMMATRIX ParentWorldTransform = DirectX::XMLoadFloat4x4(&worldTransform);
 
-	// f̑SẴbVƌs
+	// モデル内の全てのメッシュと交差判定を行う
 	//const ModelResource* resource = model->GetResource();
 	for (const auto& mesh : model->GetMeshes())
 	{
-		// bṼ[hs߂
+		// メッシュのワールド行列を求める
 		const Model::Node& node = model->GetNodes().at(mesh.nodeIndex);
 		DirectX::XMMATRIX GlobalTransform = DirectX::XMLoadFloat4x4(&node.globalTransform);
 		DirectX::XMMATRIX WorldTransform = DirectX::XMMatrixMultiply(GlobalTransform, ParentWorldTransform);
 
-		// CbṼ[JԂɕϊ
+		// レイをメッシュのローカル空間に変換する
 		DirectX::XMMATRIX InverseWorldTransform = DirectX::XMMatrixInverse(nullptr, WorldTransform);
 		DirectX::XMVECTOR LocalRayStart = DirectX::XMVector3Transform(WorldRayStart, InverseWorldTransform);
 		DirectX::XMVECTOR LocalRayEnd = DirectX::XMVector3Transform(WorldRayEnd, InverseWorldTransform);
@@ -40,10 +40,10 @@ bool Hit::RayCast(
 		DirectX::XMVECTOR LocalRayDirection = DirectX::XMVector3Normalize(LocalRayVec);
 		float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(LocalRayVec));
 
-		// bV̑SĂ̎Op`ƌs
+		// メッシュ内の全ての三角形と交差判定を行う
 		for (size_t i = 0; i < mesh.indices.size(); i += 3)
 		{
-			// Op`̒_W擾
+			// 三角形の頂点座標を取得
 			const Model::Vertex& a = mesh.vertices.at(mesh.indices.at(i + 0));
 			const Model::Vertex& b = mesh.vertices.at(mesh.indices.at(i + 1));
 			const Model::Vertex& c = mesh.vertices.at(mesh.indices.at(i + 2));
@@ -52,42 +52,42 @@ bool Hit::RayCast(
 			DirectX::XMVECTOR B = DirectX::XMLoadFloat3(&b.position);
 			DirectX::XMVECTOR C = DirectX::XMLoadFloat3(&c.position);
 
-			// Op`̌
+			// 三角形の交差判定
 			if (DirectX::TriangleTests::Intersects(LocalRayStart, LocalRayDirection, A, B, C, distance))
 			{
-				// bṼ[JԂł̌_߂
+				// メッシュのローカル空間での交点を求める
 				DirectX::XMVECTOR LocalHitVec = DirectX::XMVectorScale(LocalRayDirection, distance);
 				DirectX::XMVECTOR LocalHitPosition = DirectX::XMVectorAdd(LocalRayStart, LocalHitVec);
 
-				// bṼ[JԂł̌_[hԂɕϊ
+				// メッシュのローカル空間での交点をワールド空間に変換する
 				DirectX::XMVECTOR WorldHitPosition = DirectX::XMVector3Transform(LocalHitPosition, WorldTransform);
 
-				// [hԂł̃C̎n__܂ł̋߂
+				// ワールド空間でのレイの始点から交点までの距離を求める
 				DirectX::XMVECTOR WorldHitVec = DirectX::XMVectorSubtract(WorldHitPosition, WorldRayStart);
 				DirectX::XMVECTOR WorldHitDist = DirectX::XMVector3Length(WorldHitVec);
 				float worldHitDist = DirectX::XMVectorGetX(WorldHitDist);
 
-				// _܂ł̋܂łɌvZ_߂ꍇ͌Ɣ肷
+				// 交点までの距離が今までに計算した交点より近い場合は交差したと判定する
 				if (worldHitDist <= nearestDist)
 				{
-					// bṼ[JԂł̎Op`̖@xNgZo
+					// メッシュのローカル空間での三角形の法線ベクトルを算出
 					DirectX::XMVECTOR AB = DirectX::XMVectorSubtract(B, A);
 					DirectX::XMVECTOR BC = DirectX::XMVectorSubtract(C, B);
 					DirectX::XMVECTOR LocalHitNormal = DirectX::XMVector3Cross(AB, BC);
 
-					// bṼ[JԂł̖@xNg[hԂɕϊ
+					// メッシュのローカル空間での法線ベクトルをワールド空間に変換する
 					DirectX::XMVECTOR WorldHitNormal = DirectX::XMVector3TransformNormal(LocalHitNormal, WorldTransform);
 
-					// Op`̗\iς̌ʂ}CiXȂΕ\j
+					// 三角形の裏表判定（内積の結果がマイナスならば表向き）
 					DirectX::XMVECTOR Dot = DirectX::XMVector3Dot(LocalRayDirection, LocalHitNormal);
 					float dot = DirectX::XMVectorGetX(Dot);
 					if (dot < 0)
 					{
-						// ̂Ńqbgi[
+						// 交差したのでヒット情報を格納
 						DirectX::XMStoreFloat3(&hitNormal, DirectX::XMVector3Normalize(WorldHitNormal));
 						DirectX::XMStoreFloat3(&hitPosition, WorldHitPosition);
 
-						// _܂ł̋XV
+						// 交点までの距離を更新する
 						nearestDist = worldHitDist;
 						hit = true;
 					}
@@ -5,11 +5,11 @@
 //#include "Model.h"
 #include "System/Model.h"
 
-// RW
+// コリジョン
 class Hit
 {
 public:
-	// CLXg
+	// レイキャスト
 	static bool RayCast(
 		const DirectX::XMFLOAT3& start,
 		const DirectX::XMFLOAT3& end,
@@ -1,38 +1,38 @@
 #pragma once
 #include <imgui_logger.h>
 
-//V[
+//シーン
 class Scene
 {
 private:
 	bool ready = false;
 protected:
-	//{^̐l
+	//反応したボタンの数値を入れる
 	int menuNum = -1;
 
 public:
 	Scene() {}
 	virtual ~Scene(){}
 
-	//
+	//初期化
 	virtual void Initialize() = 0;
 
-	//I
+	//終了化
 	virtual void Finalize() = 0;
 
-	//XV
+	//更新処理
 	virtual void Update(float elapsedTime) = 0;
 
-	//`揈
+	//描画処理
 	virtual void Render() = 0;
 
-	//GUI`
+	//GUI描画
 	virtual void DrawGUI() = 0;
 
-	//Ă邩
+	//準備完了しているか
 	bool IsReady() const { return ready; }
 
-	//Ă邩
+	//準備完了しているか
 	void SetReady() { ready = true; }
 
 	template<typename... Args>
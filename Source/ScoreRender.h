@@ -1,5 +1,8 @@
 #pragma once
 #include "System/Sprite.h"
+#include "System/Graphics.h"
+#include "System/SpriteBatch.h"
+#include "render_layer.h"
 #include <math.h>
 #include <cmath>
 #include <vector>
@@ -35,7 +38,7 @@ public:
 	//	float w = worldPosX;
 	//	if (score < 0)worldPosX = w + 20;
 	//	else worldPosX = w;
-	//	//}CiXǂ̏
+	//	//マイナスかどうかの処理
 	//	for (int i = ketasuu;i > 0;i--)
 	//	{
 	//		sprite->Render(rc.deviceContext,
@@ -56,13 +59,16 @@ public:
 	//		absScore /= 10;
 	//	}
 	//}
-    //]o[W
+    //回転バージョン
 	void ScoreRenderDigit(RenderContext rc, Sprite* sprite, int score,
 		float texSizeX, float texSizeY, float worldPosX, float worldPosY, float rotationDeg, float scale = 1)
 	{
+		// 桁ごとの描画を1回の描画コールにまとめる
+		SpriteBatch::Scope batch(Graphics::Instance().GetSpriteBatch(), rc.deviceContext);
+
 		if (score == 0)
 		{
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				worldPosX, worldPosY, 0.0f,
 				texSizeX * scale, texSizeY * scale,
 				0, 0, texSizeX, texSizeY,
@@ -74,47 +80,50 @@ public:
 		bool isNegative = (score < 0);
 		int absScore = std::abs(score);
 
-		// Ŝ̕ƒS
+		// 全体の幅と中心
 		float totalWidth = ketasuu * texSizeX;
 		if (isNegative) totalWidth += texSizeX * 0.5f;
 		float centerX = worldPosX + totalWidth * 0.5f;
 		float centerY = worldPosY + texSizeY * 0.5f;
 
-		float rad = DirectX::XMConvertToRadians(rotationDeg); // W]p
+		float rad = DirectX::XMConvertToRadians(rotationDeg); // ←座標回転用
 
 		for (int i = 0; i < ketasuu; ++i)
 		{
 			int digit = absScore % 10;
 			absScore /= 10;
 
-			// ẽ[JW
+			// 各桁のローカル座標
 			float localX = totalWidth - (i + 1) * texSizeX;
 			float localY = 0.0f;
 
-			// XRAŜ̒Sɉ]
+			// スコア全体の中心を基準に回転
 			float dx = localX - totalWidth * 0.5f;
 			float dy = localY - texSizeY * 0.5f;
 			float rotatedX = dx * cosf(rad) - dy * sinf(rad);
 			float rotatedY = dx * sinf(rad) + dy * cosf(rad);
 
-			// [hW
+			// ワールド座標
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX, texSizeY,
 				texSizeX * digit, 0, texSizeX, texSizeY,
 				rotationDeg, 1, 1, 1, 1);
 		}
 	}
-	//]ƏcŃtHgIׂo[W
+	//回転と縦でフォント選べるバージョン
 	void ScoreRenderDigit(RenderContext rc, Sprite* sprite, int score,
 		float texSizeX, float texSizeY, float worldPosX, float worldPosY, float rotationDeg,int vertical)
 	{
+		// 桁ごとの描画を1回の描画コールにまとめる
+		SpriteBatch::Scope batch(Graphics::Instance().GetSpriteBatch(), rc.deviceContext);
+
 		if (score == 0)
 		{
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				worldPosX, worldPosY, 0.0f,
 				texSizeX, texSizeY,
 				0, texSizeY * vertical, texSizeX, texSizeY,
@@ -126,47 +135,50 @@ public:
 		bool isNegative = (score < 0);
 		int absScore = std::abs(score);
 
-		// Ŝ̕ƒS
+		// 全体の幅と中心
 		float totalWidth = ketasuu * texSizeX;
 		if (isNegative) totalWidth += texSizeX * 0.5f;
 		float centerX = worldPosX + totalWidth * 0.5f;
 		float centerY = worldPosY + texSizeY * 0.5f;
 
-		float rad = DirectX::XMConvertToRadians(rotationDeg); // W]p
+		float rad = DirectX::XMConvertToRadians(rotationDeg); // ←座標回転用
 
 		for (int i = 0; i < ketasuu; ++i)
 		{
 			int digit = absScore % 10;
 			absScore /= 10;
 
-			// ẽ[JW
+			// 各桁のローカル座標
 			float localX = totalWidth - (i + 1) * texSizeX;
 			float localY = 0.0f;
 
-			// XRAŜ̒Sɉ]
+			// スコア全体の中心を基準に回転
 			float dx = localX - totalWidth * 0.5f;
 			float dy = localY - texSizeY * 0.5f;
 			float rotatedX = dx * cosf(rad) - dy * sinf(rad);
 			float rotatedY = dx * sinf(rad) + dy * cosf(rad);
 
-			// [hW
+			// ワールド座標
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX, texSizeY,
 				texSizeX * digit, texSizeY * vertical, texSizeX, texSizeY,
 				rotationDeg, 1, 1, 1, 1);
 		}
 	}
-	//]ƏcŃtHgIׂĕsxςo[W
+	//回転と縦でフォント選べて不透明度変えれるバージョン
 	void ScoreRenderDigit(RenderContext rc, Sprite* sprite, int score,
 		float texSizeX, float texSizeY, float worldPosX, float worldPosY, float rotationDeg, int vertical,float alpha)
 	{
+		// 桁ごとの描画を1回の描画コールにまとめる
+		SpriteBatch::Scope batch(Graphics::Instance().GetSpriteBatch(), rc.deviceContext);
+
 		if (score == 0)
 		{
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				worldPosX, worldPosY, 0.0f,
 				texSizeX, texSizeY,
 				0, texSizeY * vertical, texSizeX, texSizeY,
@@ -178,34 +190,34 @@ public:
 		bool isNegative = (score < 0);
 		int absScore = std::abs(score);
 
-		// Ŝ̕ƒS
+		// 全体の幅と中心
 		float totalWidth = ketasuu * texSizeX;
 		if (isNegative) totalWidth += texSizeX * 0.5f;
 		float centerX = worldPosX + totalWidth * 0.5f;
 		float centerY = worldPosY + texSizeY * 0.5f;
 
-		float rad = DirectX::XMConvertToRadians(rotationDeg); // W]p
+		float rad = DirectX::XMConvertToRadians(rotationDeg); // ←座標回転用
 
 		for (int i = 0; i < ketasuu; ++i)
 		{
 			int digit = absScore % 10;
 			absScore /= 10;
 
-			// ẽ[JW
+			// 各桁のローカル座標
 			float localX = totalWidth - (i + 1) * texSizeX;
 			float localY = 0.0f;
 
-			// XRAŜ̒Sɉ]
+			// スコア全体の中心を基準に回転
 			float dx = localX - totalWidth * 0.5f;
 			float dy = localY - texSizeY * 0.5f;
 			float rotatedX = dx * cosf(rad) - dy * sinf(rad);
 			float rotatedY = dx * sinf(rad) + dy * cosf(rad);
 
-			// [hW
+			// ワールド座標
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX, texSizeY,
 				texSizeX * digit, texSizeY * vertical, texSizeX, texSizeY,
@@ -213,14 +225,17 @@ public:
 		}
 	}
 
-	//]ƏcŃtHgIׂĕsxςĐ擪ɂȂ񂩏o[W
+	//回転と縦でフォント選べて不透明度変えれて先頭になんか書けるバージョン
 	void ScoreRenderDigit(RenderContext rc, Sprite* sprite, int score,
 		float texSizeX, float texSizeY, float worldPosX, float worldPosY,
 		float rotationDeg, int vertical, float alpha,int num)
 	{
+		// 桁ごとの描画を1回の描画コールにまとめる
+		SpriteBatch::Scope batch(Graphics::Instance().GetSpriteBatch(), rc.deviceContext);
+
 		if (score == 0)
 		{
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				worldPosX, worldPosY, 0.0f,
 				texSizeX, texSizeY,
 				0, texSizeY * vertical, texSizeX, texSizeY,
@@ -233,7 +248,7 @@ public:
 		int absScore = std::abs(score);
 
 		//------------------------------------------
-		// EɊi[itɎ擾Ĕ]j
+		// 桁を左→右順に格納（逆順に取得して反転）
 		//------------------------------------------
 		std::vector<int> digits;
 		for (int i = 0; i < ketasuu; ++i)
@@ -241,19 +256,19 @@ public:
 			digits.push_back(absScore % 10);
 			absScore /= 10;
 		}
-		std::reverse(digits.begin(), digits.end()); // dvI
+		std::reverse(digits.begin(), digits.end()); // ←ここ重要！
 
 		//------------------------------------------
-		// Ŝ̕ƒS
+		// 全体の幅と中心
 		//------------------------------------------
-		float totalWidth = (ketasuu + 1) * texSizeX; // ~ǉ
+		float totalWidth = (ketasuu + 1) * texSizeX; // ×分を追加
 		float centerX = worldPosX + totalWidth * 0.5f;
 		float centerY = worldPosY + texSizeY * 0.5f;
 
 		float rad = DirectX::XMConvertToRadians(rotationDeg);
 
 		//------------------------------------------
-		// 1. u~vԍɕ`
+		// 1. 「×」を一番左に描画
 		//------------------------------------------
 		{
 			float localX = 0.0f;
@@ -267,7 +282,7 @@ public:
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX, texSizeY,
 				texSizeX * num, texSizeY * vertical, texSizeX, texSizeY,
@@ -275,13 +290,13 @@ public:
 		}
 
 		//------------------------------------------
-		// 2. Eɕ`
+		// 2. 数字を左→右に描画
 		//------------------------------------------
 		for (int i = 0; i < ketasuu; ++i)
 		{
 			int digit = digits[i];
 
-			float localX = texSizeX * (i + 1); // ~̕炷
+			float localX = texSizeX * (i + 1); // ×の分ずらす
 			float localY = 0.0f;
 
 			float dx = localX - totalWidth * 0.5f;
@@ -292,7 +307,7 @@ public:
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX, texSizeY,
 				texSizeX * digit, texSizeY * vertical, texSizeX, texSizeY,
@@ -300,14 +315,17 @@ public:
 		}
 	}
 
-	//]ƏcŃtHgIׂĕsxςĐ擪ɂȂ񂩏đ傫wło[W
+	//回転と縦でフォント選べて不透明度変えれて先頭になんか書けて大きさ指定できるバージョン
 	void ScoreRenderDigit(RenderContext rc, Sprite* sprite, int score,
 		float texSizeX, float texSizeY, float worldPosX, float worldPosY,
 		float rotationDeg, int vertical, float alpha, int num, float scale)
 	{
+		// 桁ごとの描画を1回の描画コールにまとめる
+		SpriteBatch::Scope batch(Graphics::Instance().GetSpriteBatch(), rc.deviceContext);
+
 		if (score == 0)
 		{
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				worldPosX, worldPosY, 0.0f,
 				texSizeX * scale, texSizeY * scale,
 				0, texSizeY * vertical, texSizeX, texSizeY,
@@ -327,7 +345,7 @@ public:
 		}
 		std::reverse(digits.begin(), digits.end());
 
-		//  scale 𔽉f
+		// ★ scale を反映
 		float totalWidth = (ketasuu + 1) * texSizeX * scale;
 		float totalHeight = texSizeY * scale;
 
@@ -337,7 +355,7 @@ public:
 		float rad = DirectX::XMConvertToRadians(rotationDeg);
 
 		//------------------------------------------
-		// 1. ~ ̕`i[j
+		// 1. × の描画（左端）
 		//------------------------------------------
 		{
 			float localX = 0.0f;
@@ -352,7 +370,7 @@ public:
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX * scale, texSizeY * scale,
 				texSizeX * num, texSizeY * vertical, texSizeX, texSizeY,
@@ -360,13 +378,13 @@ public:
 		}
 
 		//------------------------------------------
-		// 2. `
+		// 2. 数字を描画
 		//------------------------------------------
 		for (int i = 0; i < ketasuu; ++i)
 		{
 			int digit = digits[i];
 
-			//  scale 𔽉f
+			// ★ scale を反映
 			float localX = texSizeX * scale * (i + 1);
 			float localY = 0.0f;
 
@@ -379,7 +397,7 @@ public:
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX * scale, texSizeY * scale,
 				texSizeX * digit, texSizeY * vertical, texSizeX, texSizeY,
@@ -391,9 +409,12 @@ public:
 		float texSizeX, float texSizeY, float worldPosX, float worldPosY,
 		float rotationDeg, int vertical, float alpha, float scale, float spacing)
 	{
+		// 桁ごとの描画を1回の描画コールにまとめる
+		SpriteBatch::Scope batch(Graphics::Instance().GetSpriteBatch(), rc.deviceContext);
+
 		if (score == 0)
 		{
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				worldPosX, worldPosY, 0.0f,
 				texSizeX * scale, texSizeY * scale,
 				0, texSizeY * vertical, texSizeX, texSizeY,
@@ -413,7 +434,7 @@ public:
 		}
 		std::reverse(digits.begin(), digits.end());
 
-		//  spacing Ȃ
+		// ★ spacing 分だけ幅が狭くなる
 		float charWidth = texSizeX * scale - spacing;
 		float totalWidth = charWidth * ketasuu;
 		float totalHeight = texSizeY * scale;
@@ -439,7 +460,7 @@ public:
 			float drawX = centerX + rotatedX;
 			float drawY = centerY + rotatedY;
 
-			sprite->Render(rc.deviceContext,
+			batch->Draw(sprite, RenderLayer::kDefault,
 				drawX, drawY, 0.0f,
 				texSizeX * scale, texSizeY * scale,
 				texSizeX * digit, texSizeY * vertical, texSizeX, texSizeY,
@@ -8,16 +8,16 @@ class Screen
 public:
 	static DirectX::XMFLOAT3 GetScreenWorld(const Camera* camera,const DirectX::XMFLOAT3 pos)
 	{
-		// XN[TCY擾
+		// スクリーンサイズ取得
 		float screenWidth = Graphics::Instance().GetScreenWidth();
 		float screenHeight = Graphics::Instance().GetScreenHeight();
 
-		//es̎擾
+		//各行列の取得
 		DirectX::XMMATRIX View = DirectX::XMLoadFloat4x4(&camera->GetView());
 		DirectX::XMMATRIX Projection = DirectX::XMLoadFloat4x4(&camera->GetProjection());
 		DirectX::XMMATRIX World = DirectX::XMMatrixIdentity();
 
-		//XN[Wɂ̐ݒ
+		//スクリーン座標にの設定
 		DirectX::XMVECTOR ScreenPosition, WorldPosition;
 		DirectX::XMFLOAT3 screenPosition;
 		screenPosition.x = (pos.x);
@@ -25,7 +25,7 @@ public:
 
 		screenPosition.z = pos.z;
 		ScreenPosition = DirectX::XMLoadFloat3(&screenPosition);
-		//XN[W[hWɕϊAC̎n_߂
+		//スクリーン座標をワールド座標に変換し、レイの始点を求める
 		 WorldPosition = DirectX::XMVector3Unproject(
 			ScreenPosition,
 			0.0f, 0.0f,
@@ -44,21 +44,21 @@ public:
 
 	static DirectX::XMFLOAT3 GetScreenCursorWorld(const Camera* camera,const float z)
 	{
-		// XN[TCY擾
+		// スクリーンサイズ取得
 		float screenWidth = Graphics::Instance().GetScreenWidth();
 		float screenHeight = Graphics::Instance().GetScreenHeight();
 
-		// }EXJ[\ʒu̎擾
+		// マウスカーソル位置の取得
 		POINT cursor;
 		::GetCursorPos(&cursor);
 		::ScreenToClient(Graphics::Instance().GetWindowHandle(), &cursor);
 
-		//es̎擾
+		//各行列の取得
 		DirectX::XMMATRIX View = DirectX::XMLoadFloat4x4(&camera->GetView());
 		DirectX::XMMATRIX Projection = DirectX::XMLoadFloat4x4(&camera->GetProjection());
 		DirectX::XMMATRIX World = DirectX::XMMatrixIdentity();
 
-		//XN[Wɂ̐ݒ
+		//スクリーン座標にの設定
 		DirectX::XMVECTOR ScreenPosition, WorldPosition;
 		DirectX::XMFLOAT3 screenPosition;
 		screenPosition.x = static_cast<float>(cursor.x);
@@ -66,7 +66,7 @@ public:
 
 		screenPosition.z = z;
 		ScreenPosition = DirectX::XMLoadFloat3(&screenPosition);
-		//XN[W[hWɕϊAC̎n_߂
+		//スクリーン座標をワールド座標に変換し、レイの始点を求める
 		 WorldPosition = DirectX::XMVector3Unproject(
 			ScreenPosition,
 			0.0f, 0.0f,
@@ -85,7 +85,7 @@ public:
 
 	static DirectX::XMFLOAT2 GetWorldToScreen(const Camera* camera, const DirectX::XMFLOAT3 pos)
 	{
-		// XN[TCY擾
+		// スクリーンサイズ取得
 		float screenWidth = Graphics::Instance().GetScreenWidth();
 		float screenHeight = Graphics::Instance().GetScreenHeight();
 
@@ -93,10 +93,10 @@ public:
 		DirectX::XMMATRIX Projection = DirectX::XMLoadFloat4x4(&camera->GetProjection());
 		DirectX::XMMATRIX World = DirectX::XMMatrixIdentity();
 
-		//̃[hW
+		//頭上のワールド座標
 		DirectX::XMFLOAT3 spritPosition = pos;
 
-		//[hWXN[Wɕϊ
+		//ワールド座標からスクリーン座標に変換
 		DirectX::XMVECTOR ScreenPosition, WorldPosition;
 		WorldPosition = DirectX::XMLoadFloat3(&spritPosition);
 
@@ -110,7 +110,7 @@ public:
 			World
 		);
 
-		//XN[W
+		//スクリーン座標
 		DirectX::XMFLOAT2 screenPosition;
 		DirectX::XMStoreFloat2(&screenPosition, ScreenPosition);
 
@@ -0,0 +1,94 @@
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include "System/AllocationCounter.h"
+
+namespace
+{
+	std::atomic<uint64_t> allocationCount = 0;
+	std::atomic<uint64_t> allocatedBytes = 0;
+
+	// 確保を数えてから CRT のヒープに渡す(デバッグビルドではリーク検出の対象にもなる)
+	void* CountedAllocate(size_t size)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		return malloc(size != 0 ? size : 1);
+	}
+
+	void* CountedAllocateAligned(size_t size, std::align_val_t alignment)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		return _aligned_malloc(size != 0 ? size : 1, static_cast<size_t>(alignment));
+	}
+}
+
+// 累計の確保回数
+uint64_t AllocationCounter::GetAllocationCount()
+{
+	return allocationCount.load(std::memory_order_relaxed);
+}
+
+// 累計の確保バイト数
+uint64_t AllocationCounter::GetAllocatedBytes()
+{
+	return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+// グローバルな operator new / delete の置き換え(全ての形を揃えないと確保と解放の組み合わせが崩れる)
+void* operator new(size_t size)
+{
+	if (void* ptr = CountedAllocate(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	if (void* ptr = CountedAllocateAligned(size, alignment)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return CountedAllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { _aligned_free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { _aligned_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { _aligned_free(ptr); }
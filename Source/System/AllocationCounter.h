@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// プロセス全体のヒープ確保の計測
+// グローバルな operator new / delete を置き換えて数えるので、標準コンテナや std::function の確保も含まれる
+// 前フレームとの差が0なら、そのフレームはヒープを使っていない
+class AllocationCounter
+{
+public:
+	// 累計の確保回数
+	static uint64_t GetAllocationCount();
+
+	// 累計の確保バイト数
+	static uint64_t GetAllocatedBytes();
+};
@@ -1,53 +1,377 @@
+#include <filesystem>
+#include <algorithm>
+#include <imgui.h>
 #include "System/Misc.h"
 #include "System/Audio.h"
+#include "System/AudioBenchmark.h"
+#include "System/Profiler.h"
 
-// 
+// WAVEタグ作成マクロ
+#define MAKE_WAVE_TAG_VALUE(c1, c2, c3, c4)  ( c1 | (c2<<8) | (c3<<16) | (c4<<24) )
+
+// 初期化
 void Audio::Initialize()
 {
 	HRESULT hr;
 
-	// COM̏
+	// COMの初期化
 	hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
 	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	comInitialized = true;
 
-	UINT32 createFlags = 0;
-#if defined(DEBUG) || defined(_DEBUG)
-	//createFlags |= XAUDIO2_DEBUG_ENGINE;
-#endif
-
-	// XAudio
-	hr = XAudio2Create(&xaudio, createFlags);
-	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	// XAudio初期化
+	Initialize(std::make_unique<XAudio2Backend>());
+}
 
-	// }X^O{CX
-	hr = xaudio->CreateMasteringVoice(&masteringVoice);
-	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+// 初期化(バックエンド指定)
+void Audio::Initialize(std::unique_ptr<AudioBackend> backend)
+{
+	this->backend = std::move(backend);
+	voicePool = std::make_unique<AudioVoicePool>(this->backend.get(), kMaxVoices);
 }
 
-// I
+// 終了化
 void Audio::Finalize()
 {
-	// }X^O{CXj
-	if (masteringVoice != nullptr)
+	std::lock_guard<std::recursive_mutex> lock(mutex);
+
+	// バックエンドより先にすべてのボイスを破棄する
+	for (AudioSource* source : streamingSources)
 	{
-		masteringVoice->DestroyVoice();
-		masteringVoice = nullptr;
+		source->ReleaseVoice();
 	}
+	streamingSources.clear();
+	voicePool.reset();
+
+	// XAudio終了化
+	backend.reset();
 
-	// XAudioI
-	if (xaudio != nullptr)
+	// COM終了化
+	if (comInitialized)
 	{
-		xaudio->Release();
-		xaudio = nullptr;
+		CoUninitialize();
+		comInitialized = false;
 	}
+}
+
+// 更新処理
+void Audio::Update()
+{
+	PROFILE_SCOPE("Audio::Update");
 
-	// COMI
-	CoUninitialize();
+	std::lock_guard<std::recursive_mutex> lock(mutex);
+
+	for (AudioSource* source : streamingSources)
+	{
+		source->UpdateStream();
+	}
 }
 
-// I[fBI\[Xǂݍ
+// オーディオソース読み込み
 AudioSource* Audio::LoadAudioSource(const char* filename)
 {
-	std::shared_ptr<AudioResource> resource = std::make_shared<AudioResource>(filename);
-	return new AudioSource(xaudio, resource);
+	// 同じファイルを同時に読み込んでも1回だけ開くように、登録するまで排他する
+	std::unique_lock<std::mutex> lock(resourceMutex);
+
+	// 読み込み済みなら共有する
+	auto it = resources.find(filename);
+	if (it != resources.end())
+	{
+		if (std::shared_ptr<AudioResource> resource = it->second.lock())
+		{
+			return new AudioSource(resource);
+		}
+	}
+
+	// ヘッダだけ読んでサイズで再生方式を決める
+	// ストリーミングは共有しないので、mutex を取る前に排他を外す
+	auto stream = std::make_unique<AudioStream>(filename);
+	if (stream->GetDataBytes() > kStreamingThresholdBytes)
+	{
+		lock.unlock();
+		return CreateStreamingSource(std::move(stream));
+	}
+
+	// 圧縮形式はバックグラウンドでデコードする
+	bool async = stream->IsCompressed();
+	std::shared_ptr<AudioResource> resource = std::make_shared<AudioResource>(std::move(stream), async);
+	resources[filename] = resource;
+	return new AudioSource(resource);
+}
+
+// ストリーミング再生用オーディオソース読み込み
+AudioSource* Audio::LoadStreamingAudioSource(const char* filename)
+{
+	return CreateStreamingSource(std::make_unique<AudioStream>(filename));
+}
+
+// オーディオリソース読み込み
+std::shared_ptr<AudioResource> Audio::LoadAudioResource(const char* filename)
+{
+	std::lock_guard<std::mutex> lock(resourceMutex);
+
+	// 読み込み済みなら既存を返す
+	auto it = resources.find(filename);
+	if (it != resources.end())
+	{
+		if (std::shared_ptr<AudioResource> resource = it->second.lock())
+		{
+			return resource;
+		}
+	}
+
+	// 新規読み込み
+	auto resource = std::make_shared<AudioResource>(filename);
+	resources[filename] = resource;
+	return resource;
+}
+
+// ストリーミングソース登録解除
+void Audio::RemoveStreamingSource(AudioSource* source)
+{
+	std::lock_guard<std::recursive_mutex> lock(mutex);
+
+	streamingSources.erase(std::remove(streamingSources.begin(), streamingSources.end(), source), streamingSources.end());
+}
+
+// ストリーミングソース生成
+AudioSource* Audio::CreateStreamingSource(std::unique_ptr<AudioStream> stream)
+{
+	std::lock_guard<std::recursive_mutex> lock(mutex);
+
+	std::unique_ptr<AudioVoice> voice;
+	if (backend != nullptr && stream->IsValid())
+	{
+		voice = backend->CreateVoice(stream->GetWaveFormat());
+	}
+
+	AudioSource* source = new AudioSource(std::move(stream), std::move(voice));
+	streamingSources.emplace_back(source);
+	return source;
+}
+
+// デバッグGUI描画
+void Audio::DrawDebugGUI()
+{
+	if (ImGui::CollapsingHeader("Audio", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex);
+
+		if (voicePool != nullptr)
+		{
+			ImGui::Text("Voices : %d / %d", voicePool->GetActiveCount(), voicePool->GetCapacity());
+			ImGui::Text("Steals : %d", voicePool->GetStealCount());
+		}
+		ImGui::Text("Streams : %d", static_cast<int>(streamingSources.size()));
+
+		static int selfTestResult = -1;
+		if (ImGui::Button("Self Test"))
+		{
+			selfTestResult = RunSelfTest() ? 1 : 0;
+		}
+		if (selfTestResult >= 0)
+		{
+			ImGui::SameLine();
+			ImGui::Text(selfTestResult ? "Pass" : "FAIL");
+		}
+
+		// WAV と IMA ADPCM の読み込み比較
+		if (ImGui::TreeNode("Load Benchmark"))
+		{
+			static char filename[256] = "Data/Sound/Result/SE_result_drumroll.wav";
+			ImGui::InputText("File", filename, sizeof(filename));
+			if (ImGui::Button("Run"))
+			{
+				benchmarkResults = AudioBenchmark::Run(filename);
+			}
+			for (const AudioBenchmark::Result& result : benchmarkResults)
+			{
+				ImGui::Text("%-22s load %7.2f ms  block %7.2f ms  file %6llu KB  resident %6llu KB",
+					result.label.c_str(),
+					result.loadSeconds * 1000.0f,
+					result.blockingSeconds * 1000.0f,
+					result.fileBytes / 1024,
+					result.residentBytes / 1024);
+			}
+			ImGui::TreePop();
+		}
+
+		if (ImGui::TreeNode("AudioResource"))
+		{
+			std::lock_guard<std::mutex> resourceLock(resourceMutex);
+			for (auto it = resources.begin(); it != resources.end(); ++it)
+			{
+				std::filesystem::path filepath(it->first);
+				int use_count = it->second.use_count();
+				ImGui::Text("use_count = %5d : %s", use_count, filepath.filename().u8string().c_str());
+			}
+			ImGui::TreePop();
+		}
+	}
+}
+
+// ストリーミング再生とボイスプールの確認
+bool Audio::RunSelfTest()
+{
+	bool passed = true;
+
+	// 16bit モノラルの PCM。波形データはストリーミングのバッファ2つ分と端数
+	const UINT32 bufferBytes = AudioSource::kStreamBufferBytes;
+	const UINT32 tailBytes = 1000;
+	const UINT32 dataBytes = bufferBytes * 2 + tailBytes;
+	const std::string filename = (std::filesystem::temp_directory_path() / "audio_self_test.wav").string();
+	{
+		FILE* fp = nullptr;
+		if (fopen_s(&fp, filename.c_str(), "wb") != 0) return false;
+
+		auto write32 = [fp](UINT32 v) { fwrite(&v, sizeof(v), 1, fp); };
+		auto write16 = [fp](UINT16 v) { fwrite(&v, sizeof(v), 1, fp); };
+
+		write32(MAKE_WAVE_TAG_VALUE('R', 'I', 'F', 'F'));
+		write32(4 + (8 + 16) + (8 + dataBytes));
+		write32(MAKE_WAVE_TAG_VALUE('W', 'A', 'V', 'E'));
+
+		write32(MAKE_WAVE_TAG_VALUE('f', 'm', 't', ' '));
+		write32(16);
+		write16(WAVE_FORMAT_PCM);
+		write16(1);
+		write32(22050);
+		write32(22050 * 2);
+		write16(2);
+		write16(16);
+
+		write32(MAKE_WAVE_TAG_VALUE('d', 'a', 't', 'a'));
+		write32(dataBytes);
+		std::vector<UINT8> samples(dataBytes);
+		for (UINT32 i = 0; i < dataBytes; ++i)
+		{
+			samples[i] = static_cast<UINT8>(i);
+		}
+		fwrite(samples.data(), 1, samples.size(), fp);
+
+		fclose(fp);
+	}
+
+	// ストリーミング再生
+	{
+		auto stream = std::make_unique<AudioStream>(filename.c_str());
+		passed = passed && stream->IsValid() && stream->GetDataBytes() == dataBytes;
+
+		auto voice = std::make_unique<NullAudioVoice>(stream->GetWaveFormat());
+		NullAudioVoice* nullVoice = voice.get();
+		AudioSource source(std::move(stream), std::move(voice));
+
+		// 再生開始でリングバッファを全て送り、端数の最後のバッファにだけ終端を付ける
+		source.Play(false);
+		passed = passed && nullVoice->IsPlaying() && nullVoice->GetQueuedBufferCount() == AudioSource::kStreamBufferCount;
+		if (nullVoice->GetQueuedBufferCount() == AudioSource::kStreamBufferCount)
+		{
+			const AudioBuffer& first = nullVoice->GetQueuedBuffer(0);
+			const AudioBuffer& second = nullVoice->GetQueuedBuffer(1);
+			const AudioBuffer& last = nullVoice->GetQueuedBuffer(2);
+			passed = passed && first.bytes == bufferBytes && !first.endOfStream && !second.endOfStream;
+			passed = passed && last.bytes == tailBytes && last.endOfStream;
+			passed = passed && first.data != second.data && second.data != last.data && first.data != last.data;
+		}
+
+		// 終端まで送ってあるので、再生し終えた分は補充しない
+		nullVoice->Advance(1);
+		source.UpdateStream();
+		passed = passed && nullVoice->GetQueuedBufferCount() == 2 && nullVoice->GetConsumedBytes() == bufferBytes;
+		passed = passed && source.IsPlaying();
+
+		// 全て再生し終えたら停止する
+		nullVoice->Advance(2);
+		source.UpdateStream();
+		passed = passed && nullVoice->GetQueuedBufferCount() == 0 && nullVoice->GetConsumedBytes() == dataBytes;
+		passed = passed && !source.IsPlaying();
+
+		// ループ再生は終端で先頭に戻り、再生し終えた分だけリングバッファを使い回して補充し続ける
+		source.Play(true);
+		const int loopBuffers = 8;
+		for (int i = 0; i < loopBuffers; ++i)
+		{
+			nullVoice->Advance(1);
+			source.UpdateStream();
+			passed = passed && nullVoice->GetQueuedBufferCount() == AudioSource::kStreamBufferCount;
+		}
+		for (UINT32 i = 0; i < nullVoice->GetQueuedBufferCount(); ++i)
+		{
+			const AudioBuffer& buffer = nullVoice->GetQueuedBuffer(i);
+			passed = passed && buffer.bytes == bufferBytes && !buffer.endOfStream;
+		}
+		passed = passed && source.IsPlaying();
+		passed = passed && nullVoice->GetConsumedBytes() == dataBytes + static_cast<UINT64>(bufferBytes) * loopBuffers;
+
+		// 停止すると送信済みのバッファを破棄する
+		source.Stop();
+		passed = passed && nullVoice->GetQueuedBufferCount() == 0 && !source.IsPlaying();
+	}
+	std::error_code error;
+	std::filesystem::remove(filename, error);
+
+	// ボイスプール(2つ)
+	{
+		NullAudioBackend backend;
+		AudioVoicePool pool(&backend, 2);
+
+		WAVEFORMATEX wfx = {};
+		wfx.wFormatTag = WAVE_FORMAT_PCM;
+		wfx.nChannels = 1;
+		wfx.nSamplesPerSec = 22050;
+		wfx.wBitsPerSample = 16;
+		wfx.nBlockAlign = 2;
+		wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+
+		// 1つのバッファを送って再生中にする
+		static const UINT8 samples[4] = {};
+		auto play = [&pool, &wfx](int priority)
+		{
+			AudioVoicePool::Handle handle = pool.Acquire(wfx, priority);
+			if (AudioVoice* voice = pool.Get(handle))
+			{
+				AudioBuffer buffer;
+				buffer.data = samples;
+				buffer.bytes = sizeof(samples);
+				buffer.endOfStream = true;
+				voice->SubmitBuffer(buffer);
+				voice->Start();
+			}
+			return handle;
+		};
+
+		// 優先度の高い古いボイスと、低い新しいボイス
+		AudioVoicePool::Handle a = play(1);
+		AudioVoicePool::Handle b = play(0);
+		passed = passed && pool.Get(a) && pool.Get(b) && pool.GetActiveCount() == 2 && pool.GetStealCount() == 0;
+
+		// 同じ優先度の要求は、優先度の高いボイスを残して同じ優先度のボイスを奪う
+		AudioVoicePool::Handle c = play(0);
+		passed = passed && pool.Get(a) && !pool.Get(b) && pool.Get(c) && c.index == b.index && pool.GetStealCount() == 1;
+
+		// 低い優先度の要求はどれも奪えない
+		AudioVoicePool::Handle d = play(-1);
+		passed = passed && !pool.Get(d) && pool.Get(a) && pool.Get(c) && pool.GetStealCount() == 1;
+
+		// 高い優先度の要求は、古さより優先度の低さを優先して奪う
+		AudioVoicePool::Handle e = play(1);
+		passed = passed && pool.Get(a) && !pool.Get(c) && pool.Get(e) && e.index == c.index && pool.GetStealCount() == 2;
+
+		// 優先度が並べば最も古いものを奪う
+		AudioVoicePool::Handle f = play(1);
+		passed = passed && !pool.Get(a) && pool.Get(e) && pool.Get(f) && f.index == a.index && pool.GetStealCount() == 3;
+
+		// 再生し終えたボイスは奪わずに使い回す
+		if (AudioVoice* voice = pool.Get(e))
+		{
+			static_cast<NullAudioVoice*>(voice)->Advance(1);
+		}
+		AudioVoicePool::Handle g = play(0);
+		passed = passed && pool.Get(g) && g.index == e.index && pool.Get(f) && pool.GetStealCount() == 3;
+
+		// フォーマットが同じなのでボイスは作り直さない
+		passed = passed && backend.GetCreatedVoiceCount() == 2;
+	}
+
+	return passed;
 }
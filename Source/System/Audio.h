@@ -1,9 +1,15 @@
 #pragma once
 
-#include <xaudio2.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "System/AudioBackend.h"
+#include "System/AudioBenchmark.h"
+#include "System/AudioVoicePool.h"
 #include "System/AudioSource.h"
 
-// I[fBI
+// オーディオ
 class Audio
 {
 private:
@@ -11,23 +17,68 @@ private:
 	~Audio() = default;
 
 public:
-	// CX^X擾
+	// インスタンス取得
 	static Audio& Instance()
 	{
 		static Audio instance;
 		return instance;
 	}
 
-	// 
+	// 初期化
 	void Initialize();
 
-	// I
+	// 初期化(バックエンド指定。ヘッドレス実行時は NullAudioBackend を渡す)
+	void Initialize(std::unique_ptr<AudioBackend> backend);
+
+	// 終了化
 	void Finalize();
 
-	// I[fBI\[Xǂݍ
+	// 更新処理(ストリーミングバッファ補充)
+	void Update();
+
+	// オーディオソース読み込み
+	// 波形データが kStreamingThresholdBytes を超える場合は自動でストリーミング再生になる
+	// IMA ADPCM 圧縮のWAVはバックグラウンドでデコードされる
 	AudioSource* LoadAudioSource(const char* filename);
 
+	// ストリーミング再生用オーディオソース読み込み
+	AudioSource* LoadStreamingAudioSource(const char* filename);
+
+	// オーディオリソース読み込み(読み込み済みなら既存を返す)
+	std::shared_ptr<AudioResource> LoadAudioResource(const char* filename);
+
+	// ボイスプール取得
+	AudioVoicePool* GetVoicePool() const { return voicePool.get(); }
+
+	// ストリーミングソース登録解除
+	void RemoveStreamingSource(AudioSource* source);
+
+	// ストリーミングの排他(Update のバッファ補充と、ほかのスレッドからの再生・停止が重ならないようにする)
+	std::recursive_mutex& GetMutex() { return mutex; }
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+	// NullAudioBackend のボイスで、ストリーミング再生のバッファ補充、終端での停止、ループと、
+	// ボイスプールが同じ優先度と低い優先度のどちらのボイスを奪うかを確認する(一時フォルダに短い WAV を書き出す)
+	static bool RunSelfTest();
+
+public:
+	static constexpr int	kMaxVoices = 32;
+	static constexpr UINT32	kStreamingThresholdBytes = 4 * 1024 * 1024;
+
 private:
-	IXAudio2*				xaudio = nullptr;
-	IXAudio2MasteringVoice* masteringVoice = nullptr;
+	// ストリーミングソース生成
+	AudioSource* CreateStreamingSource(std::unique_ptr<AudioStream> stream);
+
+private:
+	std::unique_ptr<AudioBackend>	backend;
+	std::unique_ptr<AudioVoicePool>	voicePool;
+
+	std::map<std::string, std::weak_ptr<AudioResource>>	resources;
+	std::mutex											resourceMutex;		// resources の排他(mutex より後に取る)
+	std::vector<AudioSource*>							streamingSources;
+	std::recursive_mutex								mutex;
+	std::vector<AudioBenchmark::Result>					benchmarkResults;
+	bool												comInitialized = false;
 };
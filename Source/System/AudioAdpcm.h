@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <Windows.h>
+
+// IMA ADPCM (WAVE_FORMAT_IMA_ADPCM) のエンコード・デコード
+// 16bit PCM を 4bit に圧縮する(約1/4)。ブロック単位で独立してデコードできるため、
+// 効果音の一括デコードにもBGMのストリーミングにも使える
+namespace ImaAdpcm
+{
+	static constexpr UINT16 kFormatTag = 0x0011;
+
+	static constexpr int kIndexTable[16] =
+	{
+		-1, -1, -1, -1, 2, 4, 6, 8,
+		-1, -1, -1, -1, 2, 4, 6, 8,
+	};
+
+	static constexpr int kStepTable[89] =
+	{
+		7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+		19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+		50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+		130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+		337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+		876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+		2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+		5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+		15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+	};
+
+	// チャンネルごとのデコード状態
+	struct State
+	{
+		int		predictor = 0;
+		int		stepIndex = 0;
+	};
+
+	// 1ブロックあたりのサンプル数(チャンネルあたり)
+	inline UINT32 SamplesPerBlock(UINT32 blockAlign, UINT32 channels)
+	{
+		return (blockAlign - 4 * channels) * 8 / (4 * channels) + 1;
+	}
+
+	// blockBytes バイトのブロックに入っているサンプル数(チャンネルあたり)
+	// 短い最終ブロックは 8サンプル(チャンネルあたり4バイト)の組が揃っている分だけデコードできる
+	inline UINT32 BlockSampleCount(UINT32 blockBytes, UINT32 channels)
+	{
+		if (channels == 0 || blockBytes < 4 * channels) return 0;
+		return 1 + (blockBytes - 4 * channels) / (4 * channels) * 8;
+	}
+
+	// 4bitを1サンプルにデコード
+	inline INT16 DecodeNibble(State& state, UINT8 nibble)
+	{
+		int step = kStepTable[state.stepIndex];
+		int diff = step >> 3;
+		if (nibble & 1) diff += step >> 2;
+		if (nibble & 2) diff += step >> 1;
+		if (nibble & 4) diff += step;
+		if (nibble & 8) diff = -diff;
+
+		state.predictor += diff;
+		if (state.predictor > 32767) state.predictor = 32767;
+		if (state.predictor < -32768) state.predictor = -32768;
+
+		state.stepIndex += kIndexTable[nibble];
+		if (state.stepIndex < 0) state.stepIndex = 0;
+		if (state.stepIndex > 88) state.stepIndex = 88;
+
+		return static_cast<INT16>(state.predictor);
+	}
+
+	// 1サンプルを4bitにエンコード(デコード側と同じ状態更新を行う)
+	inline UINT8 EncodeSample(State& state, int sample)
+	{
+		int step = kStepTable[state.stepIndex];
+		int diff = sample - state.predictor;
+
+		UINT8 nibble = 0;
+		if (diff < 0)
+		{
+			nibble = 8;
+			diff = -diff;
+		}
+		if (diff >= step) { nibble |= 4; diff -= step; }
+		if (diff >= (step >> 1)) { nibble |= 2; diff -= step >> 1; }
+		if (diff >= (step >> 2)) { nibble |= 1; }
+
+		DecodeNibble(state, nibble);
+		return nibble;
+	}
+
+	// 1ブロックをデコードする
+	// src : blockBytes バイトのブロック(最終ブロックは短い場合がある)
+	// dst : チャンネルインターリーブの16bit PCM
+	// 戻り値はデコードしたサンプル数(チャンネルあたり)
+	inline UINT32 DecodeBlock(const UINT8* src, UINT32 blockBytes, UINT32 channels, INT16* dst)
+	{
+		const UINT32 sampleCount = BlockSampleCount(blockBytes, channels);
+		if (sampleCount == 0 || channels > 2) return 0;
+
+		// ブロックヘッダ(チャンネルごとに predictor:16bit, stepIndex:8bit, reserved:8bit)
+		State state[2];
+		for (UINT32 c = 0; c < channels; ++c)
+		{
+			const UINT8* header = src + c * 4;
+			state[c].predictor = static_cast<INT16>(header[0] | (header[1] << 8));
+			state[c].stepIndex = header[2] > 88 ? 88 : header[2];
+			dst[c] = static_cast<INT16>(state[c].predictor);
+		}
+
+		// 以降はチャンネルごとに4バイト(8サンプル)ずつ交互に並ぶ
+		UINT32 groups = (sampleCount - 1) / 8;
+		const UINT8* data = src + 4 * channels;
+		for (UINT32 g = 0; g < groups; ++g)
+		{
+			for (UINT32 c = 0; c < channels; ++c)
+			{
+				for (UINT32 b = 0; b < 4; ++b)
+				{
+					UINT8 byte = *data++;
+					UINT32 sample = 1 + g * 8 + b * 2;
+					dst[sample * channels + c] = DecodeNibble(state[c], byte & 0x0f);
+					dst[(sample + 1) * channels + c] = DecodeNibble(state[c], byte >> 4);
+				}
+			}
+		}
+		return sampleCount;
+	}
+
+	// 16bit PCM をエンコードして WAVE_FORMAT_IMA_ADPCM のデータチャンクを作る
+	// samples はチャンネルインターリーブ、sampleCount はチャンネルあたりのサンプル数
+	inline std::vector<UINT8> Encode(const INT16* samples, UINT32 sampleCount, UINT32 channels, UINT32 blockAlign)
+	{
+		std::vector<UINT8> out;
+		if (channels == 0 || channels > 2) return out;
+
+		const UINT32 samplesPerBlock = SamplesPerBlock(blockAlign, channels);
+		State state[2];
+
+		for (UINT32 start = 0; start < sampleCount; start += samplesPerBlock)
+		{
+			const UINT32 count = (std::min)(samplesPerBlock, sampleCount - start);
+			size_t blockBegin = out.size();
+			out.resize(blockBegin + blockAlign, 0);
+			UINT8* block = out.data() + blockBegin;
+
+			// ブロック先頭のサンプルはそのままヘッダに書く
+			for (UINT32 c = 0; c < channels; ++c)
+			{
+				INT16 first = samples[start * channels + c];
+				state[c].predictor = first;
+				block[c * 4 + 0] = static_cast<UINT8>(first & 0xff);
+				block[c * 4 + 1] = static_cast<UINT8>((first >> 8) & 0xff);
+				block[c * 4 + 2] = static_cast<UINT8>(state[c].stepIndex);
+				block[c * 4 + 3] = 0;
+			}
+
+			UINT8* data = block + 4 * channels;
+			UINT32 groups = (blockAlign - 4 * channels) / (4 * channels);
+			for (UINT32 g = 0; g < groups; ++g)
+			{
+				for (UINT32 c = 0; c < channels; ++c)
+				{
+					for (UINT32 b = 0; b < 4; ++b)
+					{
+						UINT32 sample = 1 + g * 8 + b * 2;
+						// ブロック末尾を超えた分は直前の値で埋める
+						auto fetch = [&](UINT32 i) -> int
+						{
+							UINT32 index = (std::min)(i, count - 1);
+							return samples[(start + index) * channels + c];
+						};
+						UINT8 lo = EncodeSample(state[c], fetch(sample));
+						UINT8 hi = EncodeSample(state[c], fetch(sample + 1));
+						*data++ = static_cast<UINT8>(lo | (hi << 4));
+					}
+				}
+			}
+		}
+		return out;
+	}
+}
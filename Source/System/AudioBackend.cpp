@@ -0,0 +1,110 @@
+#include "System/Misc.h"
+#include "System/AudioBackend.h"
+
+// XAudio2ソースボイス
+class XAudio2Voice : public AudioVoice
+{
+public:
+	XAudio2Voice(IXAudio2* xaudio, const WAVEFORMATEX& format)
+	{
+		wfx = format;
+
+		HRESULT hr = xaudio->CreateSourceVoice(&sourceVoice, &wfx);
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+
+	~XAudio2Voice() override
+	{
+		if (sourceVoice != nullptr)
+		{
+			sourceVoice->DestroyVoice();
+			sourceVoice = nullptr;
+		}
+	}
+
+	void SubmitBuffer(const AudioBuffer& buffer) override
+	{
+		XAUDIO2_BUFFER xbuffer = { 0 };
+		xbuffer.AudioBytes = buffer.bytes;
+		xbuffer.pAudioData = buffer.data;
+		xbuffer.LoopCount = buffer.loop ? XAUDIO2_LOOP_INFINITE : 0;
+		xbuffer.Flags = buffer.endOfStream ? XAUDIO2_END_OF_STREAM : 0;
+
+		HRESULT hr = sourceVoice->SubmitSourceBuffer(&xbuffer);
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+
+	void Start() override
+	{
+		HRESULT hr = sourceVoice->Start();
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+
+	void Stop() override
+	{
+		sourceVoice->Stop();
+	}
+
+	void FlushBuffers() override
+	{
+		sourceVoice->FlushSourceBuffers();
+	}
+
+	void SetVolume(float volume) override
+	{
+		sourceVoice->SetVolume(volume);
+	}
+
+	UINT32 GetQueuedBufferCount() const override
+	{
+		XAUDIO2_VOICE_STATE state;
+		sourceVoice->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+		return state.BuffersQueued;
+	}
+
+private:
+	IXAudio2SourceVoice*	sourceVoice = nullptr;
+};
+
+// コンストラクタ
+XAudio2Backend::XAudio2Backend()
+{
+	HRESULT hr;
+
+	UINT32 createFlags = 0;
+#if defined(DEBUG) || defined(_DEBUG)
+	//createFlags |= XAUDIO2_DEBUG_ENGINE;
+#endif
+
+	// XAudio初期化
+	hr = XAudio2Create(&xaudio, createFlags);
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	// マスタリングボイス生成
+	hr = xaudio->CreateMasteringVoice(&masteringVoice);
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+}
+
+// デストラクタ
+XAudio2Backend::~XAudio2Backend()
+{
+	// マスタリングボイス破棄
+	if (masteringVoice != nullptr)
+	{
+		masteringVoice->DestroyVoice();
+		masteringVoice = nullptr;
+	}
+
+	// XAudio終了化
+	if (xaudio != nullptr)
+	{
+		xaudio->Release();
+		xaudio = nullptr;
+	}
+}
+
+// ボイス生成
+std::unique_ptr<AudioVoice> XAudio2Backend::CreateVoice(const WAVEFORMATEX& wfx)
+{
+	return std::make_unique<XAudio2Voice>(xaudio, wfx);
+}
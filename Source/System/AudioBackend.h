@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+#include <deque>
+#include <xaudio2.h>
+
+// オーディオバッファ
+struct AudioBuffer
+{
+	const UINT8*	data = nullptr;
+	UINT32			bytes = 0;
+	bool			loop = false;			// 無限ループ再生
+	bool			endOfStream = false;	// ストリーム終端
+};
+
+// オーディオボイス
+class AudioVoice
+{
+public:
+	virtual ~AudioVoice() = default;
+
+	// バッファ送信
+	virtual void SubmitBuffer(const AudioBuffer& buffer) = 0;
+
+	// 再生開始
+	virtual void Start() = 0;
+
+	// 停止
+	virtual void Stop() = 0;
+
+	// 送信済みバッファ破棄
+	virtual void FlushBuffers() = 0;
+
+	// 音量設定
+	virtual void SetVolume(float volume) = 0;
+
+	// 再生待ちバッファ数取得(再生中のバッファを含む)
+	virtual UINT32 GetQueuedBufferCount() const = 0;
+
+	// WAVEフォーマット取得
+	const WAVEFORMATEX& GetWaveFormat() const { return wfx; }
+
+protected:
+	WAVEFORMATEX	wfx = {};
+};
+
+// オーディオバックエンド
+class AudioBackend
+{
+public:
+	virtual ~AudioBackend() = default;
+
+	// ボイス生成
+	virtual std::unique_ptr<AudioVoice> CreateVoice(const WAVEFORMATEX& wfx) = 0;
+};
+
+// 出力を行わないボイス(テスト・ヘッドレス実行用)
+class NullAudioVoice : public AudioVoice
+{
+public:
+	NullAudioVoice(const WAVEFORMATEX& format) { wfx = format; }
+
+	void SubmitBuffer(const AudioBuffer& buffer) override { queue.push_back(buffer); }
+	void Start() override { playing = true; }
+	void Stop() override { playing = false; }
+	void FlushBuffers() override { queue.clear(); }
+	void SetVolume(float v) override { volume = v; }
+	UINT32 GetQueuedBufferCount() const override { return static_cast<UINT32>(queue.size()); }
+
+	// 再生を進めて先頭からcount個のバッファを消費する(ループバッファは消費しない)
+	void Advance(UINT32 count)
+	{
+		while (playing && count-- > 0 && !queue.empty() && !queue.front().loop)
+		{
+			consumedBytes += queue.front().bytes;
+			queue.pop_front();
+		}
+	}
+
+	bool IsPlaying() const { return playing; }
+	float GetVolume() const { return volume; }
+	const AudioBuffer& GetQueuedBuffer(UINT32 index) const { return queue[index]; }
+	UINT64 GetConsumedBytes() const { return consumedBytes; }
+
+private:
+	std::deque<AudioBuffer>	queue;
+	bool					playing = false;
+	float					volume = 1.0f;
+	UINT64					consumedBytes = 0;
+};
+
+// 出力を行わないバックエンド
+class NullAudioBackend : public AudioBackend
+{
+public:
+	std::unique_ptr<AudioVoice> CreateVoice(const WAVEFORMATEX& wfx) override
+	{
+		++createdVoiceCount;
+		return std::make_unique<NullAudioVoice>(wfx);
+	}
+
+	int GetCreatedVoiceCount() const { return createdVoiceCount; }
+
+private:
+	int		createdVoiceCount = 0;
+};
+
+// XAudio2バックエンド
+class XAudio2Backend : public AudioBackend
+{
+public:
+	XAudio2Backend();
+	~XAudio2Backend() override;
+
+	std::unique_ptr<AudioVoice> CreateVoice(const WAVEFORMATEX& wfx) override;
+
+private:
+	IXAudio2*				xaudio = nullptr;
+	IXAudio2MasteringVoice*	masteringVoice = nullptr;
+};
@@ -0,0 +1,147 @@
+#include <cstring>
+#include <filesystem>
+#include "Misc.h"
+#include "System/AudioAdpcm.h"
+#include "System/AudioResource.h"
+#include "System/AudioSource.h"
+#include "System/AudioBenchmark.h"
+
+// WAVEタグ作成マクロ
+#define MAKE_WAVE_TAG_VALUE(c1, c2, c3, c4)  ( c1 | (c2<<8) | (c3<<16) | (c4<<24) )
+
+// ベンチマーク実行
+std::vector<AudioBenchmark::Result> AudioBenchmark::Run(const char* wavFilename, int iterations)
+{
+	std::vector<Result> results;
+
+	std::string compressedFilename = GetCompressedFilename(wavFilename);
+	if (!std::filesystem::exists(compressedFilename))
+	{
+		if (!ConvertToImaAdpcm(wavFilename, compressedFilename.c_str())) return results;
+	}
+
+	const UINT32 ringBytes = AudioSource::kStreamBufferBytes * AudioSource::kStreamBufferCount;
+	std::vector<UINT8> ring(ringBytes);
+
+	for (const char* filename : { wavFilename, compressedFilename.c_str() })
+	{
+		const bool isCompressed = filename != wavFilename;
+		const char* format = isCompressed ? "IMA ADPCM" : "WAV";
+		Benchmark benchmark;
+
+		// 一括読み込み(呼び出し元スレッドで完了まで待つ)
+		Result full;
+		full.label = std::string(format) + " full load";
+		for (int i = 0; i < iterations; ++i)
+		{
+			benchmark.begin();
+			AudioResource resource(std::make_unique<AudioStream>(filename), false);
+			float seconds = benchmark.end();
+
+			full.loadSeconds += seconds / iterations;
+			full.blockingSeconds += seconds / iterations;
+			full.residentBytes = resource.GetAudioBytes();
+		}
+
+		// バックグラウンドデコード(呼び出し元はヘッダ解析だけで戻る)
+		Result async;
+		async.label = std::string(format) + " async load";
+		for (int i = 0; i < iterations; ++i)
+		{
+			benchmark.begin();
+			AudioResource resource(std::make_unique<AudioStream>(filename), true);
+			async.blockingSeconds += benchmark.end() / iterations;
+			resource.WaitReady();
+			async.loadSeconds += benchmark.end() / iterations;
+			async.residentBytes = resource.GetAudioBytes();
+		}
+
+		// ストリーミング(最初のリングバッファを埋めるまで)
+		Result stream;
+		stream.label = std::string(format) + " stream";
+		for (int i = 0; i < iterations; ++i)
+		{
+			benchmark.begin();
+			AudioStream audioStream(filename);
+			audioStream.Read(ring.data(), ringBytes, false);
+			float seconds = benchmark.end();
+
+			stream.loadSeconds += seconds / iterations;
+			stream.blockingSeconds += seconds / iterations;
+			stream.fileBytes = audioStream.GetSourceBytes();
+		}
+		stream.residentBytes = ringBytes;
+
+		full.fileBytes = async.fileBytes = stream.fileBytes;
+		results.emplace_back(full);
+		results.emplace_back(async);
+		results.emplace_back(stream);
+	}
+	return results;
+}
+
+// 16bit PCM の WAV を IMA ADPCM の WAV に変換する
+bool AudioBenchmark::ConvertToImaAdpcm(const char* srcFilename, const char* dstFilename)
+{
+	AudioResource source(srcFilename);
+	const WAVEFORMATEX& wfx = source.GetWaveFormat();
+	if (wfx.wBitsPerSample != 16 || wfx.nChannels == 0 || wfx.nChannels > 2) return false;
+
+	const UINT32 channels = wfx.nChannels;
+	const UINT32 blockAlign = 512 * channels;
+	const UINT32 samplesPerBlock = ImaAdpcm::SamplesPerBlock(blockAlign, channels);
+	const UINT32 sampleCount = source.GetAudioBytes() / (channels * sizeof(INT16));
+
+	std::vector<UINT8> encoded = ImaAdpcm::Encode(
+		reinterpret_cast<const INT16*>(source.GetAudioData()), sampleCount, channels, blockAlign);
+
+	FILE* fp = nullptr;
+	if (fopen_s(&fp, dstFilename, "wb") != 0) return false;
+
+	auto write32 = [fp](UINT32 v) { fwrite(&v, sizeof(v), 1, fp); };
+	auto write16 = [fp](UINT16 v) { fwrite(&v, sizeof(v), 1, fp); };
+
+	const UINT32 fmtBytes = 20;
+	const UINT32 factBytes = 4;
+	const UINT32 dataBytes = static_cast<UINT32>(encoded.size());
+	const UINT32 riffBytes = 4 + (8 + fmtBytes) + (8 + factBytes) + (8 + dataBytes);
+
+	// RIFFヘッダ
+	write32(MAKE_WAVE_TAG_VALUE('R', 'I', 'F', 'F'));
+	write32(riffBytes);
+	write32(MAKE_WAVE_TAG_VALUE('W', 'A', 'V', 'E'));
+
+	// 'fmt '
+	write32(MAKE_WAVE_TAG_VALUE('f', 'm', 't', ' '));
+	write32(fmtBytes);
+	write16(ImaAdpcm::kFormatTag);
+	write16(static_cast<UINT16>(channels));
+	write32(wfx.nSamplesPerSec);
+	write32(wfx.nSamplesPerSec * blockAlign / samplesPerBlock);
+	write16(static_cast<UINT16>(blockAlign));
+	write16(4);
+	write16(2);
+	write16(static_cast<UINT16>(samplesPerBlock));
+
+	// 'fact'
+	write32(MAKE_WAVE_TAG_VALUE('f', 'a', 'c', 't'));
+	write32(factBytes);
+	write32(sampleCount);
+
+	// 'data'
+	write32(MAKE_WAVE_TAG_VALUE('d', 'a', 't', 'a'));
+	write32(dataBytes);
+	fwrite(encoded.data(), 1, encoded.size(), fp);
+	if (dataBytes & 1) fputc(0, fp);
+
+	fclose(fp);
+	return true;
+}
+
+// 圧縮版のファイル名取得(配布するデータのフォルダを汚さないように一時フォルダに作る)
+std::string AudioBenchmark::GetCompressedFilename(const char* wavFilename)
+{
+	std::filesystem::path path = std::filesystem::temp_directory_path() / std::filesystem::path(wavFilename).filename();
+	path.replace_extension(".ima.wav");
+	return path.string();
+}
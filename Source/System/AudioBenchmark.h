@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <Windows.h>
+
+// オーディオ読み込みベンチマーク
+// 同じ音声を WAV(PCM) と IMA ADPCM で読み込み、読み込み時間と常駐メモリを比較する
+class AudioBenchmark
+{
+public:
+	struct Result
+	{
+		std::string		label;
+		float			loadSeconds = 0.0f;		// 読み込み開始から再生可能になるまで
+		float			blockingSeconds = 0.0f;	// 呼び出し元スレッドが止まっていた時間
+		UINT64			fileBytes = 0;			// ファイル上の波形データサイズ
+		UINT64			residentBytes = 0;		// 読み込み後に保持するメモリ
+	};
+
+	// ベンチマーク実行
+	// 圧縮版(一時フォルダに拡張子前に ".ima" を付けたファイル)がなければ先に変換して作る
+	static std::vector<Result> Run(const char* wavFilename, int iterations = 5);
+
+	// 16bit PCM の WAV を IMA ADPCM の WAV に変換する
+	static bool ConvertToImaAdpcm(const char* srcFilename, const char* dstFilename);
+
+	// 圧縮版のファイル名取得
+	static std::string GetCompressedFilename(const char* wavFilename);
+};
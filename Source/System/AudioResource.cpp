@@ -1,107 +1,62 @@
 #include "Misc.h"
 #include "System/AudioResource.h"
 
-// WAVE^O쐬}N
-#define MAKE_WAVE_TAG_VALUE(c1, c2, c3, c4)  ( c1 | (c2<<8) | (c3<<16) | (c4<<24) )
-
-// RXgN^
+// コンストラクタ
 AudioResource::AudioResource(const char* filename)
 {
-	// WAVt@Cǂݍ
-	{
-		FILE* fp = nullptr;
-		errno_t error = fopen_s(&fp, filename, "rb");
-		_ASSERT_EXPR_A(error == 0, "WAV File not found");
-
-		// t@C̃TCY߂
-		fseek(fp, 0, SEEK_END);
-		size_t size = static_cast<size_t>(ftell(fp));
-		fseek(fp, 0, SEEK_SET);
-
-		size_t readBytes = 0;
-
-		// RIFFwb_
-		fread(&riff, sizeof(riff), 1, fp);
-		readBytes += sizeof(riff);
-
-		// "RIFF" Ƃ̈vmF
-		_ASSERT_EXPR_A(riff.tag == MAKE_WAVE_TAG_VALUE('R', 'I', 'F', 'F'), "not in RIFF format");
+	// WAVファイル読み込み
+	AudioStream stream(filename);
+	wfx = stream.GetWaveFormat();
+	Load(stream);
+}
 
-		// "WAVE" Ƃ̈vmF
-		_ASSERT_EXPR_A(riff.type == MAKE_WAVE_TAG_VALUE('W', 'A', 'V', 'E'), "not in WAVE format");
+// コンストラクタ(開いているストリームから読み込む)
+AudioResource::AudioResource(std::unique_ptr<AudioStream> stream, bool async)
+{
+	wfx = stream->GetWaveFormat();
 
-		while (size > readBytes)
+	if (async)
+	{
+		// 圧縮形式のデコードは重いので、呼び出し元を止めないように別スレッドで行う
+		std::shared_ptr<AudioStream> shared(std::move(stream));
+		loading = std::async(std::launch::async, [this, shared]()
 		{
-			Chunk chunk;
-			fread(&chunk, sizeof(chunk), 1, fp);
-			readBytes += sizeof(chunk);
-
-			// 'fmt '
-			if (chunk.tag == MAKE_WAVE_TAG_VALUE('f', 'm', 't', ' '))
-			{
-				fread(&fmt, sizeof(fmt), 1, fp);
-				readBytes += sizeof(fmt);
-
-				// g̈悪Γǂݎ̂
-				if (chunk.size > sizeof(Fmt))
-				{
-					UINT16 extSize;
-					fread(&extSize, sizeof(extSize), 1, fp);
-					readBytes += sizeof(extSize);
-
-					if (readBytes + chunk.size == size)
-					{
-						break;
-					}
-
-					fseek(fp, extSize, SEEK_CUR);
-					readBytes += extSize;
-				}
-			}
-			// 'data'
-			else if (chunk.tag == MAKE_WAVE_TAG_VALUE('d', 'a', 't', 'a'))
-			{
-				data.resize(chunk.size);
-				fread(data.data(), chunk.size, 1, fp);
-				readBytes += chunk.size;
-
-				// 8-bit wav t@C̏ꍇ unsigned -> signed ̕ϊKv
-				if (fmt.quantumBits == 8)
-				{
-					for (UINT32 i = 0; i < chunk.size; ++i)
-					{
-						data[i] -= 128;
-					}
-				}
-			}
-			// ȊO
-			else
-			{
-				if (readBytes + chunk.size == size) break;
-
-				// ǂݔ΂
-				fseek(fp, chunk.size, SEEK_CUR);
-				readBytes += chunk.size;
-			}
-		}
-
-		fclose(fp);
+			Load(*shared);
+		});
 	}
-
-	// WAV tH[}bgZbgAbv
+	else
 	{
-		wfx.wFormatTag = WAVE_FORMAT_PCM;
-		wfx.nChannels = fmt.channel;
-		wfx.nSamplesPerSec = fmt.sampleRate;
-		wfx.wBitsPerSample = fmt.quantumBits;
-		wfx.nBlockAlign = (wfx.wBitsPerSample >> 3) * wfx.nChannels;
-		wfx.nAvgBytesPerSec = wfx.nBlockAlign * wfx.nSamplesPerSec;
-		wfx.cbSize = sizeof(WAVEFORMATEX);
+		Load(*stream);
 	}
 }
 
-// fXgN^
+// デストラクタ
 AudioResource::~AudioResource()
 {
+	WaitReady();
+}
+
+// 読み込みが完了しているか
+bool AudioResource::IsReady() const
+{
+	if (!loading.valid()) return true;
+	return loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
 
+// 読み込み完了を待つ
+void AudioResource::WaitReady() const
+{
+	if (loading.valid())
+	{
+		loading.wait();
+	}
+}
+
+// ストリームから全データを読み込む
+void AudioResource::Load(AudioStream& stream)
+{
+	stream.Rewind();
+	data.resize(stream.GetDataBytes());
+	UINT32 readBytes = stream.Read(data.data(), stream.GetDataBytes(), false);
+	data.resize(readBytes);
 }
@@ -1,54 +1,44 @@
 #pragma once
 
+#include <future>
+#include <memory>
 #include <vector>
 #include <Windows.h>
+#include "System/AudioStream.h"
 
-// I[fBI\[X
+// オーディオリソース
 class AudioResource
 {
 public:
 	AudioResource(const char* filename);
+
+	// 開いているストリームから読み込む
+	// async が true の場合はデコードをバックグラウンドスレッドで行う
+	AudioResource(std::unique_ptr<AudioStream> stream, bool async);
 	~AudioResource();
 
-	// f[^擾
-	UINT8* GetAudioData() { return data.data(); }
+	// データ取得(バックグラウンド読み込み中なら完了を待つ)
+	UINT8* GetAudioData() { WaitReady(); return data.data(); }
 
-	// f[^TCY擾
-	UINT32 GetAudioBytes() const { return static_cast<UINT32>(data.size()); }
+	// データサイズ取得(バックグラウンド読み込み中なら完了を待つ)
+	UINT32 GetAudioBytes() const { WaitReady(); return static_cast<UINT32>(data.size()); }
 
-	// WAVEtH[}bg擾
+	// WAVEフォーマット取得(ヘッダから取得するので待たない)
 	const WAVEFORMATEX& GetWaveFormat() const { return wfx; }
 
+	// 読み込みが完了しているか
+	bool IsReady() const;
+
+	// 読み込み完了を待つ
+	void WaitReady() const;
+
+private:
+	// ストリームから全データを読み込む
+	void Load(AudioStream& stream);
+
 private:
-	// RIFFwb_
-	struct Riff
-	{
-		UINT32				tag;			// RIFF`̎ʎq 'RIFF'
-		UINT32				size;			// ȍ~̃t@CTCY(t@CTCY - 8)
-		UINT32				type;			// RIFF̎ނ\ʎq 'WAVE'
-	};
-
-	// `N
-	struct Chunk
-	{
-		UINT32				tag;			// `N`̎ʎq 'fmt ' 'data'
-		UINT32				size;			// f[^TCY('fmt 'jAPCMȂ16 'data'g`f[^TCY)
-	};
-
-	// fmt `N
-	struct Fmt
-	{
-		UINT16				fmtId;			// tH[}bgID(jAPCMȂ1)
-		UINT16				channel;		// `l(m:1 XeI:2)
-		UINT32				sampleRate;		// TvO[g(44.1kHzȂ44100)
-		UINT32				transRate;		// f[^x(Byte/sec) [ 44.1kHz 16bit XeI 44100~2~2 ]
-		UINT16				blockSize;		// ubNTCY(Byte/sample~`l)
-		UINT16				quantumBits;	// Tṽrbg(bit/sample)
-	};
-
-	Riff					riff;
-	Fmt						fmt;
 	std::vector<UINT8>		data;
 	WAVEFORMATEX			wfx;
+	std::future<void>		loading;
 
 };
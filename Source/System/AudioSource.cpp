@@ -1,55 +1,185 @@
+#include <algorithm>
 #include "Misc.h"
+#include "System/Audio.h"
 #include "System/AudioSource.h"
 
-// RXgN^
-AudioSource::AudioSource(IXAudio2* xaudio, std::shared_ptr<AudioResource>& resource)
+// コンストラクタ(効果音)
+AudioSource::AudioSource(std::shared_ptr<AudioResource>& resource)
 	: resource(resource)
 {
-	HRESULT hr;
+}
 
-	// \[X{CX𐶐
-	hr = xaudio->CreateSourceVoice(&sourceVoice, &resource->GetWaveFormat());
-	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+// コンストラクタ(ストリーミング)
+AudioSource::AudioSource(std::unique_ptr<AudioStream> stream, std::unique_ptr<AudioVoice> voice)
+	: stream(std::move(stream))
+	, streamVoice(std::move(voice))
+{
+	// バッファ境界がサンプルの途中にならないようにブロック単位に揃える
+	UINT32 blockAlign = (std::max)(static_cast<UINT32>(this->stream->GetWaveFormat().nBlockAlign), 1u);
+	UINT32 bufferBytes = kStreamBufferBytes - kStreamBufferBytes % blockAlign;
+	streamBuffer.resize(static_cast<size_t>(bufferBytes) * kStreamBufferCount);
 }
 
-// fXgN^
+// デストラクタ
 AudioSource::~AudioSource()
 {
-	if (sourceVoice != nullptr)
+	if (IsStreaming())
 	{
-		//sourceVoice->DestroyVoice();
-		sourceVoice = nullptr;
+		// 登録を外すまでに Audio::Update から補充されないようにする
+		std::lock_guard<std::recursive_mutex> lock(Audio::Instance().GetMutex());
+
+		Stop();
+		Audio::Instance().RemoveStreamingSource(this);
+		ReleaseVoice();
+		return;
 	}
+
+	Stop();
+	ReleaseVoice();
 }
 
-// Đ
+// 再生
 void AudioSource::Play(bool loop)
 {
+	// ストリーミング
+	if (IsStreaming())
+	{
+		// シーンは読み込みスレッドで作られるので、メインスレッドの Audio::Update と排他する
+		std::lock_guard<std::recursive_mutex> lock(Audio::Instance().GetMutex());
+
+		Stop();
+		if (streamVoice == nullptr) return;
+
+		stream->Rewind();
+		streamLoop = loop;
+		streamPlaying = true;
+		nextStreamBuffer = 0;
+
+		UpdateStream();
+		streamVoice->SetVolume(volume);
+		streamVoice->Start();
+		return;
+	}
+
 	Stop();
 
-	// \[X{CXɃf[^𑗐M
-	XAUDIO2_BUFFER buffer = { 0 };
-	buffer.AudioBytes = resource->GetAudioBytes();
-	buffer.pAudioData = resource->GetAudioData();
-	buffer.LoopCount = loop ? XAUDIO2_LOOP_INFINITE : 0;
-	buffer.Flags = XAUDIO2_END_OF_STREAM;
+	// プールからボイスを借りる
+	AudioVoicePool* pool = Audio::Instance().GetVoicePool();
+	if (pool == nullptr) return;
 
-	sourceVoice->SubmitSourceBuffer(&buffer);
+	voiceHandle = pool->Acquire(resource->GetWaveFormat(), priority);
+	AudioVoice* voice = pool->Get(voiceHandle);
+	if (voice == nullptr) return;
 
-	HRESULT hr = sourceVoice->Start();
-	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-	//sourceVoice->SetVolume(1.0f);
+	// ソースボイスにデータを送信
+	AudioBuffer buffer;
+	buffer.data = resource->GetAudioData();
+	buffer.bytes = resource->GetAudioBytes();
+	buffer.loop = loop;
+	buffer.endOfStream = true;
+	voice->SubmitBuffer(buffer);
+
+	voice->SetVolume(volume);
+	voice->Start();
 }
 
-// ~
+// 停止
 void AudioSource::Stop()
 {
-	sourceVoice->FlushSourceBuffers();
-	sourceVoice->Stop();
+	if (IsStreaming())
+	{
+		std::lock_guard<std::recursive_mutex> lock(Audio::Instance().GetMutex());
+
+		streamPlaying = false;
+		if (streamVoice != nullptr)
+		{
+			streamVoice->Stop();
+			streamVoice->FlushBuffers();
+		}
+		return;
+	}
+
+	AudioVoicePool* pool = Audio::Instance().GetVoicePool();
+	if (pool != nullptr)
+	{
+		pool->Release(voiceHandle);
+	}
+	voiceHandle = AudioVoicePool::Handle();
 }
 
-// ʐݒ
+// 音量設定
 void AudioSource::SetVolume(float volume)
 {
-	sourceVoice->SetVolume(volume);
+	this->volume = volume;
+
+	if (AudioVoice* voice = GetVoice())
+	{
+		voice->SetVolume(volume);
+	}
+}
+
+// 再生中か
+bool AudioSource::IsPlaying() const
+{
+	if (IsStreaming()) return streamPlaying;
+
+	AudioVoice* voice = GetVoice();
+	return voice != nullptr && voice->GetQueuedBufferCount() > 0;
+}
+
+// ストリーミングバッファ補充
+void AudioSource::UpdateStream()
+{
+	std::lock_guard<std::recursive_mutex> lock(Audio::Instance().GetMutex());
+
+	if (!streamPlaying || streamVoice == nullptr) return;
+
+	const UINT32 bufferBytes = static_cast<UINT32>(streamBuffer.size() / kStreamBufferCount);
+
+	// バッファは送信順に再生し終わるので、待ち数が減った分だけ先頭から使い回せる
+	while (streamVoice->GetQueuedBufferCount() < kStreamBufferCount)
+	{
+		if (stream->IsEnd() && !streamLoop)
+		{
+			// 最後のバッファを再生し終えたら停止
+			if (streamVoice->GetQueuedBufferCount() == 0)
+			{
+				streamPlaying = false;
+			}
+			break;
+		}
+
+		UINT8* dst = streamBuffer.data() + static_cast<size_t>(bufferBytes) * nextStreamBuffer;
+		UINT32 readBytes = stream->Read(dst, bufferBytes, streamLoop);
+		if (readBytes == 0)
+		{
+			streamPlaying = false;
+			break;
+		}
+
+		AudioBuffer buffer;
+		buffer.data = dst;
+		buffer.bytes = readBytes;
+		buffer.endOfStream = stream->IsEnd() && !streamLoop;
+		streamVoice->SubmitBuffer(buffer);
+
+		nextStreamBuffer = (nextStreamBuffer + 1) % kStreamBufferCount;
+	}
+}
+
+// ボイス破棄
+void AudioSource::ReleaseVoice()
+{
+	streamPlaying = false;
+	streamVoice.reset();
+	voiceHandle = AudioVoicePool::Handle();
+}
+
+// 現在のボイス取得
+AudioVoice* AudioSource::GetVoice() const
+{
+	if (IsStreaming()) return streamVoice.get();
+
+	AudioVoicePool* pool = Audio::Instance().GetVoicePool();
+	return pool != nullptr ? pool->Get(voiceHandle) : nullptr;
 }
@@ -1,26 +1,64 @@
 #pragma once
 
 #include <memory>
-#include <xaudio2.h>
+#include <vector>
 #include "System/AudioResource.h"
+#include "System/AudioStream.h"
+#include "System/AudioVoicePool.h"
 
-// I[fBI\[X
+// オーディオソース
+// 効果音はボイスプールから再生のたびにボイスを借り、
+// BGMなどの長い音声は専用ボイスに小さなバッファを順番に送り込んでストリーミング再生する
 class AudioSource
 {
 public:
-	AudioSource(IXAudio2* xaudio, std::shared_ptr<AudioResource>& resource);
+	AudioSource(std::shared_ptr<AudioResource>& resource);
+	AudioSource(std::unique_ptr<AudioStream> stream, std::unique_ptr<AudioVoice> voice);
 	~AudioSource();
 
-	// Đ
+	// 再生
 	void Play(bool loop);
 
-	// ~
+	// 停止
 	void Stop();
 
-	// ʐݒ
+	// 音量設定
 	void SetVolume(float volume);
 
+	// 優先度設定(ボイスが足りない場合、優先度の低いものから止められる)
+	void SetPriority(int value) { priority = value; }
+
+	// 再生中か
+	bool IsPlaying() const;
+
+	// ストリーミング再生か
+	bool IsStreaming() const { return stream != nullptr; }
+
+	// ストリーミングバッファ補充(Audio::Update から毎フレーム呼ばれる)
+	void UpdateStream();
+
+	// ボイス破棄(オーディオ終了化時に呼ばれる)
+	void ReleaseVoice();
+
+public:
+	static constexpr int	kStreamBufferCount = 3;
+	static constexpr UINT32	kStreamBufferBytes = 64 * 1024;
+
+private:
+	// 現在のボイス取得
+	AudioVoice* GetVoice() const;
+
 private:
-	IXAudio2SourceVoice*			sourceVoice = nullptr;
 	std::shared_ptr<AudioResource>	resource;
+	AudioVoicePool::Handle			voiceHandle;
+	int								priority = 0;
+	float							volume = 1.0f;
+
+	// ストリーミング
+	std::unique_ptr<AudioStream>	stream;
+	std::unique_ptr<AudioVoice>		streamVoice;
+	std::vector<UINT8>				streamBuffer;			// kStreamBufferCount 個のリングバッファ
+	int								nextStreamBuffer = 0;
+	bool							streamLoop = false;
+	bool							streamPlaying = false;
 };
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cstring>
+#include "Misc.h"
+#include "System/AudioAdpcm.h"
+#include "System/AudioStream.h"
+
+// WAVEタグ作成マクロ
+#define MAKE_WAVE_TAG_VALUE(c1, c2, c3, c4)  ( c1 | (c2<<8) | (c3<<16) | (c4<<24) )
+
+// コンストラクタ
+AudioStream::AudioStream(const char* filename)
+{
+	errno_t error = fopen_s(&fp, filename, "rb");
+	_ASSERT_EXPR_A(error == 0, "WAV File not found");
+	if (error != 0)
+	{
+		fp = nullptr;
+		return;
+	}
+
+	// RIFFヘッダ
+	Riff riff;
+	if (fread(&riff, sizeof(riff), 1, fp) != 1) return;
+
+	// "RIFF" との一致を確認
+	_ASSERT_EXPR_A(riff.tag == MAKE_WAVE_TAG_VALUE('R', 'I', 'F', 'F'), "not in RIFF format");
+
+	// "WAVE" との一致を確認
+	_ASSERT_EXPR_A(riff.type == MAKE_WAVE_TAG_VALUE('W', 'A', 'V', 'E'), "not in WAVE format");
+
+	// 'data' チャンクが見つかるまでチャンクを辿る
+	// 波形データ本体は読まずに位置とサイズだけ記録する
+	UINT32 factSamples = 0;
+	Chunk chunk;
+	while (fread(&chunk, sizeof(chunk), 1, fp) == 1)
+	{
+		// チャンクは2バイト境界に揃えられている
+		long paddedSize = static_cast<long>(chunk.size + (chunk.size & 1));
+
+		// 'fmt '
+		if (chunk.tag == MAKE_WAVE_TAG_VALUE('f', 'm', 't', ' '))
+		{
+			if (fread(&fmt, sizeof(fmt), 1, fp) != 1) return;
+			long readBytes = sizeof(Fmt);
+
+			// IMA ADPCM は拡張領域にブロックあたりのサンプル数を持つ
+			if (fmt.fmtId == ImaAdpcm::kFormatTag && chunk.size >= sizeof(Fmt) + 4)
+			{
+				UINT16 ext[2];
+				fread(ext, sizeof(ext), 1, fp);
+				readBytes += sizeof(ext);
+				samplesPerBlock = ext[1];
+			}
+
+			// 残りの拡張領域は読み捨て
+			fseek(fp, paddedSize - readBytes, SEEK_CUR);
+		}
+		// 'fact' (圧縮形式のチャンネルあたりのサンプル数)
+		else if (chunk.tag == MAKE_WAVE_TAG_VALUE('f', 'a', 'c', 't'))
+		{
+			fread(&factSamples, sizeof(factSamples), 1, fp);
+			fseek(fp, paddedSize - static_cast<long>(sizeof(factSamples)), SEEK_CUR);
+		}
+		// 'data'
+		else if (chunk.tag == MAKE_WAVE_TAG_VALUE('d', 'a', 't', 'a'))
+		{
+			dataOffset = ftell(fp);
+			sourceBytes = chunk.size;
+			dataBytes = chunk.size;
+			break;
+		}
+		// それ以外は読み飛ばす
+		else
+		{
+			fseek(fp, paddedSize, SEEK_CUR);
+		}
+	}
+
+	// IMA ADPCM は16bit PCMにデコードして返す
+	if (fmt.fmtId == ImaAdpcm::kFormatTag)
+	{
+		_ASSERT_EXPR_A(fmt.channel == 1 || fmt.channel == 2, "IMA ADPCM supports mono or stereo only");
+
+		compressed = true;
+		fmt.quantumBits = 16;
+		if (samplesPerBlock == 0)
+		{
+			samplesPerBlock = ImaAdpcm::SamplesPerBlock(fmt.blockSize, fmt.channel);
+		}
+
+		// 'fact' チャンクがなければブロック数から求める(短い最終ブロックはバイト数から数える)
+		UINT32 totalSamples = factSamples;
+		if (totalSamples == 0)
+		{
+			totalSamples = sourceBytes / fmt.blockSize * samplesPerBlock
+				+ ImaAdpcm::BlockSampleCount(sourceBytes % fmt.blockSize, fmt.channel);
+		}
+		dataBytes = totalSamples * fmt.channel * sizeof(INT16);
+
+		blockData.resize(fmt.blockSize);
+		blockSamples.resize(static_cast<size_t>(ImaAdpcm::SamplesPerBlock(fmt.blockSize, fmt.channel)) * fmt.channel);
+	}
+
+	// WAV フォーマットをセットアップ
+	{
+		wfx.wFormatTag = WAVE_FORMAT_PCM;
+		wfx.nChannels = fmt.channel;
+		wfx.nSamplesPerSec = fmt.sampleRate;
+		wfx.wBitsPerSample = fmt.quantumBits;
+		wfx.nBlockAlign = (wfx.wBitsPerSample >> 3) * wfx.nChannels;
+		wfx.nAvgBytesPerSec = wfx.nBlockAlign * wfx.nSamplesPerSec;
+		wfx.cbSize = sizeof(WAVEFORMATEX);
+	}
+
+	_ASSERT_EXPR_A(dataBytes > 0, "WAV data chunk not found");
+}
+
+// デストラクタ
+AudioStream::~AudioStream()
+{
+	if (fp != nullptr)
+	{
+		fclose(fp);
+		fp = nullptr;
+	}
+}
+
+// 読み込み
+UINT32 AudioStream::Read(UINT8* dst, UINT32 bytes, bool loop)
+{
+	if (!IsValid()) return 0;
+
+	UINT32 totalBytes = 0;
+	while (totalBytes < bytes)
+	{
+		if (IsEnd())
+		{
+			if (!loop) break;
+			Rewind();
+		}
+
+		UINT32 readBytes = (std::min)(bytes - totalBytes, dataBytes - readPosition);
+		readBytes = compressed ? ReadAdpcm(dst + totalBytes, readBytes) : ReadPcm(dst + totalBytes, readBytes);
+		if (readBytes == 0) break;
+
+		totalBytes += readBytes;
+		readPosition += readBytes;
+	}
+	return totalBytes;
+}
+
+// 先頭に戻る
+void AudioStream::Rewind()
+{
+	if (fp == nullptr) return;
+
+	fseek(fp, dataOffset, SEEK_SET);
+	readPosition = 0;
+	sourcePosition = 0;
+	blockSampleBytes = 0;
+	blockReadOffset = 0;
+}
+
+// PCMの読み込み
+UINT32 AudioStream::ReadPcm(UINT8* dst, UINT32 bytes)
+{
+	UINT32 readBytes = static_cast<UINT32>(fread(dst, 1, bytes, fp));
+
+	// 8-bit wav ファイルの場合は unsigned -> signed の変換が必要
+	if (fmt.quantumBits == 8)
+	{
+		for (UINT32 i = 0; i < readBytes; ++i)
+		{
+			dst[i] -= 128;
+		}
+	}
+	return readBytes;
+}
+
+// IMA ADPCMの読み込み
+UINT32 AudioStream::ReadAdpcm(UINT8* dst, UINT32 bytes)
+{
+	UINT32 totalBytes = 0;
+	while (totalBytes < bytes)
+	{
+		// デコード済みブロックを使い切ったら次のブロックをデコードする
+		if (blockReadOffset >= blockSampleBytes)
+		{
+			if (sourcePosition >= sourceBytes) break;
+
+			UINT32 blockBytes = (std::min)(static_cast<UINT32>(fmt.blockSize), sourceBytes - sourcePosition);
+			blockBytes = static_cast<UINT32>(fread(blockData.data(), 1, blockBytes, fp));
+			if (blockBytes == 0) break;
+			sourcePosition += blockBytes;
+
+			UINT32 samples = ImaAdpcm::DecodeBlock(blockData.data(), blockBytes, fmt.channel, blockSamples.data());
+			blockSampleBytes = samples * fmt.channel * sizeof(INT16);
+			blockReadOffset = 0;
+			if (blockSampleBytes == 0) break;
+		}
+
+		UINT32 copyBytes = (std::min)(bytes - totalBytes, blockSampleBytes - blockReadOffset);
+		memcpy(dst + totalBytes, reinterpret_cast<const UINT8*>(blockSamples.data()) + blockReadOffset, copyBytes);
+		blockReadOffset += copyBytes;
+		totalBytes += copyBytes;
+	}
+	return totalBytes;
+}
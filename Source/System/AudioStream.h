@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+#include <Windows.h>
+#include <mmreg.h>
+
+// WAVストリーム
+// ファイルを開いたままにして、波形データを必要な分だけ順次読み込む
+// IMA ADPCM 圧縮のWAVはブロック単位でデコードし、16bit PCM として返す
+class AudioStream
+{
+public:
+	AudioStream(const char* filename);
+	~AudioStream();
+
+	// 読み込み(戻り値は実際に読み込んだバイト数)
+	// loop が true の場合は終端で先頭に戻って読み込みを続ける
+	UINT32 Read(UINT8* dst, UINT32 bytes, bool loop);
+
+	// 先頭に戻る
+	void Rewind();
+
+	// 有効なWAVファイルか
+	bool IsValid() const { return fp != nullptr && dataBytes > 0; }
+
+	// 圧縮形式か
+	bool IsCompressed() const { return compressed; }
+
+	// 終端に達したか
+	bool IsEnd() const { return readPosition >= dataBytes; }
+
+	// 波形データの総サイズ取得(圧縮形式の場合はデコード後のサイズ)
+	UINT32 GetDataBytes() const { return dataBytes; }
+
+	// ファイル上の波形データサイズ取得
+	UINT32 GetSourceBytes() const { return sourceBytes; }
+
+	// WAVEフォーマット取得(圧縮形式の場合はデコード後のフォーマット)
+	const WAVEFORMATEX& GetWaveFormat() const { return wfx; }
+
+private:
+	// PCMの読み込み
+	UINT32 ReadPcm(UINT8* dst, UINT32 bytes);
+
+	// IMA ADPCMの読み込み
+	UINT32 ReadAdpcm(UINT8* dst, UINT32 bytes);
+
+private:
+	// RIFFヘッダ
+	struct Riff
+	{
+		UINT32				tag;			// RIFF形式の識別子 'RIFF'
+		UINT32				size;			// これ以降のファイルサイズ(ファイルサイズ - 8)
+		UINT32				type;			// RIFFの種類を表す識別子 'WAVE'
+	};
+
+	// チャンク
+	struct Chunk
+	{
+		UINT32				tag;			// チャンク形式の識別子 'fmt ' 'data'
+		UINT32				size;			// データサイズ('fmt 'リニアPCMならば16 'data'波形データサイズ)
+	};
+
+	// fmt チャンク
+	struct Fmt
+	{
+		UINT16				fmtId;			// フォーマットID(リニアPCMならば1 IMA ADPCMならば0x11)
+		UINT16				channel;		// チャンネル数(モノラル:1 ステレオ:2)
+		UINT32				sampleRate;		// サンプリングレート(44.1kHzなら44100)
+		UINT32				transRate;		// データ速度(Byte/sec) [ 44.1kHz 16bit ステレオ 44100×2×2 ]
+		UINT16				blockSize;		// ブロックサイズ(Byte/sample×チャンネル数)
+		UINT16				quantumBits;	// サンプルあたりのビット数(bit/sample)
+	};
+
+	FILE*					fp = nullptr;
+	Fmt						fmt = {};
+	WAVEFORMATEX			wfx = {};
+	long					dataOffset = 0;		// 'data' チャンク先頭のファイル位置
+	UINT32					dataBytes = 0;
+	UINT32					readPosition = 0;
+
+	// 圧縮形式
+	bool					compressed = false;
+	UINT32					sourceBytes = 0;		// ファイル上の 'data' チャンクサイズ
+	UINT32					sourcePosition = 0;
+	UINT32					samplesPerBlock = 0;
+	std::vector<UINT8>		blockData;				// 圧縮ブロック
+	std::vector<INT16>		blockSamples;			// デコード済みブロック
+	UINT32					blockSampleBytes = 0;	// デコード済みブロックの有効バイト数
+	UINT32					blockReadOffset = 0;
+};
@@ -0,0 +1,156 @@
+#include "System/AudioVoicePool.h"
+
+// コンストラクタ
+AudioVoicePool::AudioVoicePool(AudioBackend* backend, int capacity)
+	: backend(backend)
+	, slots(capacity)
+{
+}
+
+// デストラクタ
+AudioVoicePool::~AudioVoicePool()
+{
+	Clear();
+}
+
+// ボイス確保
+AudioVoicePool::Handle AudioVoicePool::Acquire(const WAVEFORMATEX& wfx, int priority)
+{
+	const int count = GetCapacity();
+
+	// 同じフォーマットの空きボイスを優先して再利用する
+	for (int i = 0; i < count; ++i)
+	{
+		const Slot& slot = slots[i];
+		if (slot.voice && !IsBusy(slot) && IsSameFormat(slot.voice->GetWaveFormat(), wfx))
+		{
+			return Assign(i, wfx, priority);
+		}
+	}
+
+	// 未生成のスロット
+	for (int i = 0; i < count; ++i)
+	{
+		if (!slots[i].voice)
+		{
+			return Assign(i, wfx, priority);
+		}
+	}
+
+	// フォーマット違いの空きボイス(作り直す)
+	for (int i = 0; i < count; ++i)
+	{
+		if (!IsBusy(slots[i]))
+		{
+			return Assign(i, wfx, priority);
+		}
+	}
+
+	// 空きがなければ優先度が同じか低いボイスのうち、最も古いものを奪う
+	int victim = -1;
+	for (int i = 0; i < count; ++i)
+	{
+		const Slot& slot = slots[i];
+		if (slot.priority > priority) continue;
+
+		if (victim < 0
+			|| slot.priority < slots[victim].priority
+			|| (slot.priority == slots[victim].priority && slot.startOrder < slots[victim].startOrder))
+		{
+			victim = i;
+		}
+	}
+	if (victim < 0) return Handle();
+
+	++stealCount;
+	return Assign(victim, wfx, priority);
+}
+
+// ボイス解放
+void AudioVoicePool::Release(const Handle& handle)
+{
+	AudioVoice* voice = Get(handle);
+	if (voice == nullptr) return;
+
+	voice->Stop();
+	voice->FlushBuffers();
+
+	Slot& slot = slots[handle.index];
+	slot.inUse = false;
+	++slot.generation;
+}
+
+// ボイス取得
+AudioVoice* AudioVoicePool::Get(const Handle& handle) const
+{
+	if (handle.index < 0 || handle.index >= GetCapacity()) return nullptr;
+
+	const Slot& slot = slots[handle.index];
+	if (!slot.inUse || slot.generation != handle.generation) return nullptr;
+
+	return slot.voice.get();
+}
+
+// 全ボイス破棄
+void AudioVoicePool::Clear()
+{
+	for (Slot& slot : slots)
+	{
+		slot.voice.reset();
+		slot.inUse = false;
+		++slot.generation;
+	}
+}
+
+// 再生中のボイス数取得
+int AudioVoicePool::GetActiveCount() const
+{
+	int active = 0;
+	for (const Slot& slot : slots)
+	{
+		if (IsBusy(slot)) ++active;
+	}
+	return active;
+}
+
+// 再生中か
+bool AudioVoicePool::IsBusy(const Slot& slot) const
+{
+	return slot.inUse && slot.voice && slot.voice->GetQueuedBufferCount() > 0;
+}
+
+// スロットを指定フォーマットで確保
+AudioVoicePool::Handle AudioVoicePool::Assign(int index, const WAVEFORMATEX& wfx, int priority)
+{
+	Slot& slot = slots[index];
+
+	if (slot.voice && IsSameFormat(slot.voice->GetWaveFormat(), wfx))
+	{
+		slot.voice->Stop();
+		slot.voice->FlushBuffers();
+	}
+	else
+	{
+		// ソースボイスは生成時のフォーマットに固定されるので作り直す
+		slot.voice = backend->CreateVoice(wfx);
+	}
+
+	slot.inUse = true;
+	slot.priority = priority;
+	slot.startOrder = ++startCounter;
+	++slot.generation;
+
+	Handle handle;
+	handle.index = index;
+	handle.generation = slot.generation;
+	return handle;
+}
+
+// フォーマットが一致するか
+bool AudioVoicePool::IsSameFormat(const WAVEFORMATEX& a, const WAVEFORMATEX& b)
+{
+	return a.wFormatTag == b.wFormatTag
+		&& a.nChannels == b.nChannels
+		&& a.nSamplesPerSec == b.nSamplesPerSec
+		&& a.wBitsPerSample == b.wBitsPerSample;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "System/AudioBackend.h"
+
+// 効果音用ボイスプール
+// 固定数のボイスを使い回し、空きがなければ優先度の低いボイスを奪う
+class AudioVoicePool
+{
+public:
+	// ボイスハンドル(奪われたボイスは世代番号の不一致で検出する)
+	struct Handle
+	{
+		int		index = -1;
+		UINT32	generation = 0;
+	};
+
+public:
+	AudioVoicePool(AudioBackend* backend, int capacity);
+	~AudioVoicePool();
+
+	// ボイス確保(確保できなければ無効なハンドルを返す)
+	Handle Acquire(const WAVEFORMATEX& wfx, int priority);
+
+	// ボイス解放
+	void Release(const Handle& handle);
+
+	// ボイス取得(解放済み・奪われたハンドルなら nullptr)
+	AudioVoice* Get(const Handle& handle) const;
+
+	// 全ボイス破棄
+	void Clear();
+
+	// 容量取得
+	int GetCapacity() const { return static_cast<int>(slots.size()); }
+
+	// 再生中のボイス数取得
+	int GetActiveCount() const;
+
+	// 優先度によってボイスを奪った回数取得
+	int GetStealCount() const { return stealCount; }
+
+private:
+	struct Slot
+	{
+		std::unique_ptr<AudioVoice>	voice;
+		UINT32						generation = 0;
+		int							priority = 0;
+		UINT64						startOrder = 0;
+		bool						inUse = false;
+	};
+
+	// 再生中か(確保済みでもバッファを再生し終わっていれば空きとみなす)
+	bool IsBusy(const Slot& slot) const;
+
+	// スロットを指定フォーマットで確保
+	Handle Assign(int index, const WAVEFORMATEX& wfx, int priority);
+
+	// フォーマットが一致するか
+	static bool IsSameFormat(const WAVEFORMATEX& a, const WAVEFORMATEX& b);
+
+private:
+	AudioBackend*		backend = nullptr;
+	std::vector<Slot>	slots;
+	UINT64				startCounter = 0;
+	int					stealCount = 0;
+};
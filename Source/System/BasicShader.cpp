@@ -4,39 +4,48 @@
 
 BasicShader::BasicShader(ID3D11Device* device)
 {
-	// _VF[_[
-	GpuResourceUtils::LoadVertexShader(
-		device,
+	// 頂点シェーダー(頂点形式ごと)
+	const char* vertexShaderFilenames[] =
+	{
 		"Data/Shader/BasicVS.cso",
-		Model::InputElementDescs.data(),
-		static_cast<UINT>(Model::InputElementDescs.size()),
-		inputLayout.GetAddressOf(),
-		vertexShader.GetAddressOf());
+		"Data/Shader/BasicSkinnedVS.cso",
+	};
+	static_assert(_countof(vertexShaderFilenames) == static_cast<int>(Model::VertexFormat::Count));
+	for (int i = 0; i < static_cast<int>(Model::VertexFormat::Count); ++i)
+	{
+		const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElementDescs =
+			Model::GetInputElementDescs(static_cast<Model::VertexFormat>(i));
+		GpuResourceUtils::LoadVertexShader(
+			device,
+			vertexShaderFilenames[i],
+			inputElementDescs.data(),
+			static_cast<UINT>(inputElementDescs.size()),
+			inputLayouts[i].GetAddressOf(),
+			vertexShaders[i].GetAddressOf());
+	}
 
-	// sNZVF[_[
+	// ピクセルシェーダー
 	GpuResourceUtils::LoadPixelShader(
 		device,
 		"Data/Shader/BasicPS.cso",
 		pixelShader.GetAddressOf());
 
-	// bVp萔obt@
+	// メッシュ用定数バッファ
 	GpuResourceUtils::CreateConstantBuffer(
 		device,
 		sizeof(CbMesh),
 		meshConstantBuffer.GetAddressOf());
 }
 
-// Jn
+// 開始処理
 void BasicShader::Begin(const RenderContext& rc)
 {
 	ID3D11DeviceContext* dc = rc.deviceContext;
 
-	// VF[_[ݒ
-	dc->IASetInputLayout(inputLayout.Get());
-	dc->VSSetShader(vertexShader.Get(), nullptr, 0);
+	// シェーダー設定(頂点シェーダーはメッシュの頂点形式に合わせて Update() で設定する)
 	dc->PSSetShader(pixelShader.Get(), nullptr, 0);
 
-	// 萔obt@ݒ
+	// 定数バッファ設定
 	ID3D11Buffer* cbs[] =
 	{
 		meshConstantBuffer.Get(), 
@@ -44,39 +53,42 @@ void BasicShader::Begin(const RenderContext& rc)
 	dc->PSSetConstantBuffers(0, _countof(cbs), cbs);
 }
 
-// XV
-void BasicShader::Update(const RenderContext& rc, const Model::Mesh& mesh)
+// 更新処理
+void BasicShader::Update(const RenderContext& rc, RenderBackend& backend, const Model::Mesh& mesh)
 {
-	ID3D11DeviceContext* dc = rc.deviceContext;
+	// 頂点形式に合わせたシェーダー設定
+	const int vertexFormat = static_cast<int>(mesh.vertexFormat);
+	backend.SetInputLayout(inputLayouts[vertexFormat].Get());
+	backend.SetVertexShader(vertexShaders[vertexFormat].Get());
 
-	// bVp萔obt@XV
+	// メッシュ用定数バッファ更新
 	CbMesh cbMesh{};
 	cbMesh.materialColor = mesh.material->baseColor;
-	dc->UpdateSubresource(meshConstantBuffer.Get(), 0, 0, &cbMesh, 0, 0);
+	backend.UpdateConstantBuffer(meshConstantBuffer.Get(), &cbMesh, sizeof(cbMesh));
 
-	// VF[_[\[Xr[ݒ
+	// シェーダーリソースビュー設定
 	ID3D11ShaderResourceView* srvs[] =
 	{
 		mesh.material->baseMap.Get(),
 	};
-	dc->PSSetShaderResources(0, _countof(srvs), srvs);
+	backend.SetPixelShaderResources(0, _countof(srvs), srvs);
 }
 
-// `I
+// 描画終了
 void BasicShader::End(const RenderContext& rc)
 {
 	ID3D11DeviceContext* dc = rc.deviceContext;
 
-	// VF[_[ݒ
+	// シェーダー設定解除
 	dc->VSSetShader(nullptr, nullptr, 0);
 	dc->PSSetShader(nullptr, nullptr, 0);
 	dc->IASetInputLayout(nullptr);
 
-	// 萔obt@ݒ
+	// 定数バッファ設定解除
 	ID3D11Buffer* cbs[] = { nullptr };
 	dc->PSSetConstantBuffers(1, _countof(cbs), cbs);
 
-	// VF[_[\[Xr[ݒ
+	// シェーダーリソースビュー設定解除
 	ID3D11ShaderResourceView* srvs[] = { nullptr };
 	dc->PSSetShaderResources(0, _countof(srvs), srvs);
 }
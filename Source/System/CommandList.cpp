@@ -0,0 +1,153 @@
+#include <cstring>
+#include "System/CommandList.h"
+
+// シェーダー設定
+void CommandList::SetShader(Shader* shader)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetShader;
+	command.object = shader;
+}
+
+// ブレンドステート設定
+void CommandList::SetBlendState(ID3D11BlendState* blendState)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetBlendState;
+	command.object = blendState;
+}
+
+// 入力レイアウト設定
+void CommandList::SetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetInputLayout;
+	command.object = inputLayout;
+}
+
+// 頂点シェーダー設定
+void CommandList::SetVertexShader(ID3D11VertexShader* vertexShader)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetVertexShader;
+	command.object = vertexShader;
+}
+
+// ピクセルシェーダー設定
+void CommandList::SetPixelShader(ID3D11PixelShader* pixelShader)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetPixelShader;
+	command.object = pixelShader;
+}
+
+// 頂点バッファ設定
+void CommandList::SetVertexBuffer(ID3D11Buffer* vertexBuffer, UINT stride)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetVertexBuffer;
+	command.object = vertexBuffer;
+	command.arg0 = stride;
+}
+
+// インデックスバッファ設定
+void CommandList::SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetIndexBuffer;
+	command.object = indexBuffer;
+	command.arg0 = static_cast<UINT>(format);
+}
+
+// ピクセルシェーダーのシェーダーリソースビュー設定
+void CommandList::SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* srvs)
+{
+	const size_t offset = AllocateData(sizeof(ID3D11ShaderResourceView*) * count);
+	std::memcpy(&data[offset], srvs, sizeof(ID3D11ShaderResourceView*) * count);
+
+	Command& command = commands.emplace_back();
+	command.type = CommandType::SetPixelShaderResources;
+	command.arg0 = startSlot;
+	command.arg1 = count;
+	command.dataOffset = offset;
+}
+
+// 定数バッファの内容を置き換える(内容はリストにコピーしておく)
+void CommandList::UpdateConstantBuffer(ID3D11Buffer* buffer, const void* source, UINT size)
+{
+	const size_t offset = AllocateData(size);
+	std::memcpy(&data[offset], source, size);
+
+	Command& command = commands.emplace_back();
+	command.type = CommandType::UpdateConstantBuffer;
+	command.object = buffer;
+	command.arg0 = size;
+	command.dataOffset = offset;
+}
+
+// インデックス付き描画
+void CommandList::DrawIndexed(UINT indexCount, UINT startIndex)
+{
+	Command& command = commands.emplace_back();
+	command.type = CommandType::DrawIndexed;
+	command.arg0 = indexCount;
+	command.arg1 = startIndex;
+}
+
+// 記録したコマンドを順に送る
+void CommandList::Execute(RenderBackend& backend) const
+{
+	for (const Command& command : commands)
+	{
+		switch (command.type)
+		{
+		case CommandType::SetShader:
+			backend.SetShader(static_cast<Shader*>(command.object));
+			break;
+		case CommandType::SetBlendState:
+			backend.SetBlendState(static_cast<ID3D11BlendState*>(command.object));
+			break;
+		case CommandType::SetInputLayout:
+			backend.SetInputLayout(static_cast<ID3D11InputLayout*>(command.object));
+			break;
+		case CommandType::SetVertexShader:
+			backend.SetVertexShader(static_cast<ID3D11VertexShader*>(command.object));
+			break;
+		case CommandType::SetPixelShader:
+			backend.SetPixelShader(static_cast<ID3D11PixelShader*>(command.object));
+			break;
+		case CommandType::SetVertexBuffer:
+			backend.SetVertexBuffer(static_cast<ID3D11Buffer*>(command.object), command.arg0);
+			break;
+		case CommandType::SetIndexBuffer:
+			backend.SetIndexBuffer(static_cast<ID3D11Buffer*>(command.object), static_cast<DXGI_FORMAT>(command.arg0));
+			break;
+		case CommandType::SetPixelShaderResources:
+			backend.SetPixelShaderResources(command.arg0, command.arg1,
+				reinterpret_cast<ID3D11ShaderResourceView* const*>(&data[command.dataOffset]));
+			break;
+		case CommandType::UpdateConstantBuffer:
+			backend.UpdateConstantBuffer(static_cast<ID3D11Buffer*>(command.object), &data[command.dataOffset], command.arg0);
+			break;
+		case CommandType::DrawIndexed:
+			backend.DrawIndexed(command.arg0, command.arg1);
+			break;
+		}
+	}
+}
+
+// 記録したコマンドを破棄
+void CommandList::Clear()
+{
+	commands.clear();
+	data.clear();
+}
+
+// data の末尾に size バイト確保して先頭位置を返す
+size_t CommandList::AllocateData(size_t size)
+{
+	// ポインタの配列や定数をそのまま読めるように16バイト境界にそろえる
+	const size_t offset = (data.size() + 15) & ~static_cast<size_t>(15);
+	data.resize(offset + size);
+	return offset;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "RenderBackend.h"
+
+// 描画コマンドを記録しておき、後でまとめて別のバックエンドに送るコマンドリスト
+// 記録はデバイスコンテキストに触れないので、リストを分ければワーカースレッドで並列に記録できる
+// 送るのはデバイスコンテキストを使うスレッドから順番に1回だけ行う(ID3D11DeviceContext::ExecuteCommandList に相当)
+class CommandList : public RenderBackend
+{
+public:
+	void SetShader(Shader* shader) override;
+	void SetBlendState(ID3D11BlendState* blendState) override;
+	void SetInputLayout(ID3D11InputLayout* inputLayout) override;
+	void SetVertexShader(ID3D11VertexShader* vertexShader) override;
+	void SetPixelShader(ID3D11PixelShader* pixelShader) override;
+	void SetVertexBuffer(ID3D11Buffer* vertexBuffer, UINT stride) override;
+	void SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format) override;
+	void SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* srvs) override;
+	void UpdateConstantBuffer(ID3D11Buffer* buffer, const void* data, UINT size) override;
+	void DrawIndexed(UINT indexCount, UINT startIndex) override;
+
+	// 記録したコマンドを順に送る
+	void Execute(RenderBackend& backend) const;
+
+	// 記録したコマンドを破棄(確保したメモリは次の記録で使い回す)
+	void Clear();
+
+	// 記録したコマンドの数
+	size_t GetCommandCount() const { return commands.size(); }
+
+	// 定数とシェーダーリソースビューの配列に使っているバイト数
+	size_t GetDataSize() const { return data.size(); }
+
+private:
+	enum class CommandType : uint8_t
+	{
+		SetShader,
+		SetBlendState,
+		SetInputLayout,
+		SetVertexShader,
+		SetPixelShader,
+		SetVertexBuffer,
+		SetIndexBuffer,
+		SetPixelShaderResources,
+		UpdateConstantBuffer,
+		DrawIndexed,
+	};
+
+	// 1コマンド分(可変長の引数は data に置き、先頭位置を持つ)
+	struct Command
+	{
+		CommandType	type;
+		UINT		arg0 = 0;
+		UINT		arg1 = 0;
+		void*		object = nullptr;
+		size_t		dataOffset = 0;
+	};
+
+	// data の末尾に size バイト確保して先頭位置を返す
+	size_t AllocateData(size_t size);
+
+private:
+	std::vector<Command>	commands;
+	std::vector<uint8_t>	data;
+};
@@ -0,0 +1,599 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "System/JobSystem.h"
+#include "System/EnvironmentBaker.h"
+
+// 並列化する際の1ジョブあたりの行数
+static const size_t BakeGrainSize = 8;
+
+// キャッシュファイルの先頭
+struct EnvironmentCacheHeader
+{
+	char		magic[4];
+	uint32_t	version;
+	uint64_t	sourceKey;
+	uint32_t	faceSize;
+	uint32_t	mipCount;
+	uint32_t	sampleCount;
+	uint32_t	reserved;
+};
+static const char CacheMagic[4] = { 'E', 'N', 'V', 'C' };
+static const uint32_t CacheVersion = 1;
+
+// 球面調和関数の基底(Environment.hlsli と同じ順)
+static void EvaluateShBasis(float x, float y, float z, float basis[EnvironmentBaker::ShCoefficientCount])
+{
+	basis[0] = 0.282095f;
+	basis[1] = 0.488603f * y;
+	basis[2] = 0.488603f * z;
+	basis[3] = 0.488603f * x;
+	basis[4] = 1.092548f * x * y;
+	basis[5] = 1.092548f * y * z;
+	basis[6] = 0.315392f * (3.0f * z * z - 1.0f);
+	basis[7] = 1.092548f * x * z;
+	basis[8] = 0.546274f * (x * x - y * y);
+}
+
+// Hammersley 点列
+static DirectX::XMFLOAT2 Hammersley(uint32_t index, uint32_t count)
+{
+	uint32_t bits = index;
+	bits = (bits << 16u) | (bits >> 16u);
+	bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+	bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+	bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+	bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+	return { static_cast<float>(index) / count, static_cast<float>(bits) * 2.3283064365386963e-10f };
+}
+
+// 焼き込み
+void EnvironmentBaker::Bake(const DirectX::XMFLOAT4* pixels, uint32_t width, uint32_t height, const Settings& settings, Result& result)
+{
+	const uint32_t faceSize = (std::max)(settings.faceSize, 1u);
+	uint32_t maxMipCount = 1;
+	while ((faceSize >> maxMipCount) > 0) ++maxMipCount;
+
+	result.faceSize = faceSize;
+	result.mipCount = (std::clamp)(settings.mipCount, 1u, maxMipCount);
+	result.mips.assign(result.mipCount, Level());
+
+	// 元の画像がキューブマップより十分大きければ、先に縮めてからバイリニアで読む(細かい模様がちらつかないように)
+	const uint32_t scale = (std::max)(width / (faceSize * 4), 1u);
+	Level reduced;
+	const DirectX::XMFLOAT4* source = pixels;
+	uint32_t sourceWidth = width, sourceHeight = height;
+	if (scale > 1)
+	{
+		sourceWidth = width / scale;
+		sourceHeight = (std::max)(height / scale, 1u);
+		reduced.resize(static_cast<size_t>(sourceWidth) * sourceHeight);
+		JobSystem::Instance().ParallelFor(0, sourceHeight, BakeGrainSize, [&](size_t begin, size_t end)
+		{
+			const float weight = 1.0f / (scale * scale);
+			for (size_t y = begin; y < end; ++y)
+			{
+				for (uint32_t x = 0; x < sourceWidth; ++x)
+				{
+					DirectX::XMVECTOR Sum = DirectX::XMVectorZero();
+					for (uint32_t sy = 0; sy < scale; ++sy)
+					{
+						const DirectX::XMFLOAT4* row = &pixels[(std::min)(static_cast<uint32_t>(y) * scale + sy, height - 1) * width + x * scale];
+						for (uint32_t sx = 0; sx < scale; ++sx)
+						{
+							Sum = DirectX::XMVectorAdd(Sum, DirectX::XMLoadFloat4(&row[sx]));
+						}
+					}
+					DirectX::XMStoreFloat4(&reduced[y * sourceWidth + x], DirectX::XMVectorScale(Sum, weight));
+				}
+			}
+		});
+		source = reduced.data();
+	}
+
+	// ミップ 0
+	Level& base = result.mips[0];
+	base.resize(static_cast<size_t>(faceSize) * faceSize * FaceCount);
+	JobSystem::Instance().ParallelFor(0, static_cast<size_t>(faceSize) * FaceCount, BakeGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t row = begin; row < end; ++row)
+		{
+			const uint32_t face = static_cast<uint32_t>(row / faceSize);
+			const uint32_t y = static_cast<uint32_t>(row % faceSize);
+			for (uint32_t x = 0; x < faceSize; ++x)
+			{
+				const DirectX::XMFLOAT3 direction = GetFaceDirection(face, (x + 0.5f) / faceSize, (y + 0.5f) / faceSize);
+				const DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction));
+				DirectX::XMStoreFloat4(&base[row * faceSize + x], SampleEquirect(source, sourceWidth, sourceHeight, Direction));
+			}
+		}
+	});
+
+	// 拡散反射
+	ProjectSh(base, faceSize, result.sh);
+
+	// 鏡面反射
+	// サンプルの確率密度に合わせて元のミップチェーンの粗いミップを読み、少ないサンプル数でも斑点が出ないようにする
+	if (result.mipCount > 1)
+	{
+		std::vector<Level> chain(maxMipCount);
+		chain[0] = base;
+		for (uint32_t i = 1; i < maxMipCount; ++i)
+		{
+			Downsample(chain[i - 1], faceSize >> (i - 1), chain[i]);
+		}
+
+		for (uint32_t mip = 1; mip < result.mipCount; ++mip)
+		{
+			const float roughness = static_cast<float>(mip) / (result.mipCount - 1);
+			Prefilter(chain, faceSize, roughness, (std::max)(settings.sampleCount, 1u), result.mips[mip], faceSize >> mip);
+		}
+	}
+}
+
+// 法線方向の 放射照度 / π を求める
+DirectX::XMFLOAT3 EnvironmentBaker::EvaluateIrradiance(const DirectX::XMFLOAT4 sh[ShCoefficientCount], const DirectX::XMFLOAT3& normal)
+{
+	float basis[ShCoefficientCount];
+	EvaluateShBasis(normal.x, normal.y, normal.z, basis);
+
+	DirectX::XMVECTOR Irradiance = DirectX::XMVectorZero();
+	for (uint32_t i = 0; i < ShCoefficientCount; ++i)
+	{
+		Irradiance = DirectX::XMVectorMultiplyAdd(DirectX::XMLoadFloat4(&sh[i]), DirectX::XMVectorReplicate(basis[i]), Irradiance);
+	}
+	DirectX::XMFLOAT3 irradiance;
+	DirectX::XMStoreFloat3(&irradiance, DirectX::XMVectorMax(Irradiance, DirectX::XMVectorZero()));
+	return irradiance;
+}
+
+// キューブマップの面の uv の方向
+DirectX::XMFLOAT3 EnvironmentBaker::GetFaceDirection(uint32_t face, float u, float v)
+{
+	// D3D のキューブマップの面の向き(v は下向き)
+	const float s = u * 2.0f - 1.0f;
+	const float t = v * 2.0f - 1.0f;
+	switch (face)
+	{
+	case 0: return { 1.0f, -t, -s };
+	case 1: return { -1.0f, -t, s };
+	case 2: return { s, 1.0f, t };
+	case 3: return { s, -1.0f, -t };
+	case 4: return { s, -t, 1.0f };
+	default: return { -s, -t, -1.0f };
+	}
+}
+
+// 正距円筒図法の画像をバイリニアで読む
+DirectX::XMVECTOR EnvironmentBaker::SampleEquirect(const DirectX::XMFLOAT4* pixels, uint32_t width, uint32_t height, DirectX::FXMVECTOR direction)
+{
+	// sky_map_ps と同じ対応
+	DirectX::XMFLOAT3 d;
+	DirectX::XMStoreFloat3(&d, direction);
+	const float u = (std::atan2(d.z, d.x) + DirectX::XM_PI) / DirectX::XM_2PI;
+	const float v = (DirectX::XM_PIDIV2 - std::asin((std::clamp)(d.y, -1.0f, 1.0f))) / DirectX::XM_PI;
+
+	// 横は繰り返し、縦は端で止める
+	const float x = u * width - 0.5f;
+	const float y = v * height - 0.5f;
+	const float fx = std::floor(x);
+	const float fy = std::floor(y);
+	const int x0 = static_cast<int>(fx);
+	const int y0 = static_cast<int>(fy);
+	const int w = static_cast<int>(width);
+	const int h = static_cast<int>(height);
+	const uint32_t ix0 = static_cast<uint32_t>((x0 % w + w) % w);
+	const uint32_t ix1 = static_cast<uint32_t>(((x0 + 1) % w + w) % w);
+	const uint32_t iy0 = static_cast<uint32_t>((std::clamp)(y0, 0, h - 1));
+	const uint32_t iy1 = static_cast<uint32_t>((std::clamp)(y0 + 1, 0, h - 1));
+
+	const DirectX::XMVECTOR Top = DirectX::XMVectorLerp(
+		DirectX::XMLoadFloat4(&pixels[iy0 * width + ix0]), DirectX::XMLoadFloat4(&pixels[iy0 * width + ix1]), x - fx);
+	const DirectX::XMVECTOR Bottom = DirectX::XMVectorLerp(
+		DirectX::XMLoadFloat4(&pixels[iy1 * width + ix0]), DirectX::XMLoadFloat4(&pixels[iy1 * width + ix1]), x - fx);
+	return DirectX::XMVectorLerp(Top, Bottom, y - fy);
+}
+
+// キューブマップの1ミップをバイリニアで読む
+DirectX::XMVECTOR EnvironmentBaker::SampleCube(const Level& level, uint32_t size, DirectX::FXMVECTOR direction)
+{
+	// GetFaceDirection() の逆
+	DirectX::XMFLOAT3 d;
+	DirectX::XMStoreFloat3(&d, direction);
+	const float ax = std::fabs(d.x), ay = std::fabs(d.y), az = std::fabs(d.z);
+	uint32_t face;
+	float s, t, major;
+	if (ax >= ay && ax >= az)
+	{
+		face = d.x > 0.0f ? 0 : 1;
+		major = ax;
+		s = d.x > 0.0f ? -d.z : d.z;
+		t = -d.y;
+	}
+	else if (ay >= az)
+	{
+		face = d.y > 0.0f ? 2 : 3;
+		major = ay;
+		s = d.x;
+		t = d.y > 0.0f ? d.z : -d.z;
+	}
+	else
+	{
+		face = d.z > 0.0f ? 4 : 5;
+		major = az;
+		s = d.z > 0.0f ? d.x : -d.x;
+		t = -d.y;
+	}
+
+	// 面の境界では端で止める
+	const float x = (s / major * 0.5f + 0.5f) * size - 0.5f;
+	const float y = (t / major * 0.5f + 0.5f) * size - 0.5f;
+	const float fx = std::floor(x);
+	const float fy = std::floor(y);
+	const int last = static_cast<int>(size) - 1;
+	const uint32_t x0 = static_cast<uint32_t>((std::clamp)(static_cast<int>(fx), 0, last));
+	const uint32_t x1 = static_cast<uint32_t>((std::clamp)(static_cast<int>(fx) + 1, 0, last));
+	const uint32_t y0 = static_cast<uint32_t>((std::clamp)(static_cast<int>(fy), 0, last));
+	const uint32_t y1 = static_cast<uint32_t>((std::clamp)(static_cast<int>(fy) + 1, 0, last));
+
+	const DirectX::XMFLOAT4* texels = &level[static_cast<size_t>(face) * size * size];
+	const DirectX::XMVECTOR Top = DirectX::XMVectorLerp(
+		DirectX::XMLoadFloat4(&texels[y0 * size + x0]), DirectX::XMLoadFloat4(&texels[y0 * size + x1]), x - fx);
+	const DirectX::XMVECTOR Bottom = DirectX::XMVectorLerp(
+		DirectX::XMLoadFloat4(&texels[y1 * size + x0]), DirectX::XMLoadFloat4(&texels[y1 * size + x1]), x - fx);
+	return DirectX::XMVectorLerp(Top, Bottom, y - fy);
+}
+
+// 2x2 の平均で半分の大きさのミップを作る
+void EnvironmentBaker::Downsample(const Level& source, uint32_t sourceSize, Level& destination)
+{
+	const uint32_t size = (std::max)(sourceSize / 2, 1u);
+	const uint32_t step = sourceSize > 1 ? 2 : 1;
+	destination.resize(static_cast<size_t>(size) * size * FaceCount);
+	for (uint32_t face = 0; face < FaceCount; ++face)
+	{
+		const DirectX::XMFLOAT4* src = &source[static_cast<size_t>(face) * sourceSize * sourceSize];
+		DirectX::XMFLOAT4* dst = &destination[static_cast<size_t>(face) * size * size];
+		for (uint32_t y = 0; y < size; ++y)
+		{
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				const uint32_t sx = x * step, sy = y * step;
+				const uint32_t sx1 = (std::min)(sx + 1, sourceSize - 1), sy1 = (std::min)(sy + 1, sourceSize - 1);
+				DirectX::XMVECTOR Sum = DirectX::XMLoadFloat4(&src[sy * sourceSize + sx]);
+				Sum = DirectX::XMVectorAdd(Sum, DirectX::XMLoadFloat4(&src[sy * sourceSize + sx1]));
+				Sum = DirectX::XMVectorAdd(Sum, DirectX::XMLoadFloat4(&src[sy1 * sourceSize + sx]));
+				Sum = DirectX::XMVectorAdd(Sum, DirectX::XMLoadFloat4(&src[sy1 * sourceSize + sx1]));
+				DirectX::XMStoreFloat4(&dst[y * size + x], DirectX::XMVectorScale(Sum, 0.25f));
+			}
+		}
+	}
+}
+
+// ミップ 0 を球面調和関数に射影する
+void EnvironmentBaker::ProjectSh(const Level& level, uint32_t size, DirectX::XMFLOAT4 sh[ShCoefficientCount])
+{
+	// 行ごとに足し合わせてから順に合計する(スレッド数によらず同じ結果にする)
+	struct RowSum
+	{
+		DirectX::XMFLOAT4	sh[ShCoefficientCount];
+		float				weight;
+	};
+	const size_t rowCount = static_cast<size_t>(size) * FaceCount;
+	std::vector<RowSum> rowSums(rowCount);
+
+	JobSystem::Instance().ParallelFor(0, rowCount, BakeGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t row = begin; row < end; ++row)
+		{
+			const uint32_t face = static_cast<uint32_t>(row / size);
+			const uint32_t y = static_cast<uint32_t>(row % size);
+
+			DirectX::XMVECTOR Sums[ShCoefficientCount];
+			for (DirectX::XMVECTOR& Sum : Sums) Sum = DirectX::XMVectorZero();
+			float weight = 0.0f;
+
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				const float u = (x + 0.5f) / size, v = (y + 0.5f) / size;
+				const float s = u * 2.0f - 1.0f, t = v * 2.0f - 1.0f;
+
+				// テクセルが見込む立体角
+				const float lengthSq = 1.0f + s * s + t * t;
+				const float solidAngle = (4.0f / (static_cast<float>(size) * size)) / (lengthSq * std::sqrt(lengthSq));
+
+				const DirectX::XMFLOAT3 direction = GetFaceDirection(face, u, v);
+				const float invLength = 1.0f / std::sqrt(lengthSq);
+				float basis[ShCoefficientCount];
+				EvaluateShBasis(direction.x * invLength, direction.y * invLength, direction.z * invLength, basis);
+
+				const DirectX::XMVECTOR Radiance = DirectX::XMLoadFloat4(&level[row * size + x]);
+				for (uint32_t i = 0; i < ShCoefficientCount; ++i)
+				{
+					Sums[i] = DirectX::XMVectorMultiplyAdd(Radiance, DirectX::XMVectorReplicate(basis[i] * solidAngle), Sums[i]);
+				}
+				weight += solidAngle;
+			}
+
+			for (uint32_t i = 0; i < ShCoefficientCount; ++i)
+			{
+				DirectX::XMStoreFloat4(&rowSums[row].sh[i], Sums[i]);
+			}
+			rowSums[row].weight = weight;
+		}
+	});
+
+	DirectX::XMVECTOR Sums[ShCoefficientCount];
+	for (DirectX::XMVECTOR& Sum : Sums) Sum = DirectX::XMVectorZero();
+	float weight = 0.0f;
+	for (const RowSum& rowSum : rowSums)
+	{
+		for (uint32_t i = 0; i < ShCoefficientCount; ++i)
+		{
+			Sums[i] = DirectX::XMVectorAdd(Sums[i], DirectX::XMLoadFloat4(&rowSum.sh[i]));
+		}
+		weight += rowSum.weight;
+	}
+
+	// 立体角の合計を 4π にそろえ、コサインとの畳み込み(バンドごとに π, 2π/3, π/4)と 1/π をまとめて掛ける
+	static const float BandFactors[ShCoefficientCount] = {
+		1.0f,
+		2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+		0.25f, 0.25f, 0.25f, 0.25f, 0.25f,
+	};
+	const float normalize = 4.0f * DirectX::XM_PI / weight;
+	for (uint32_t i = 0; i < ShCoefficientCount; ++i)
+	{
+		DirectX::XMStoreFloat4(&sh[i], DirectX::XMVectorScale(Sums[i], normalize * BandFactors[i]));
+		sh[i].w = 0.0f;
+	}
+}
+
+// 1ミップを GGX でぼかす
+void EnvironmentBaker::Prefilter(const std::vector<Level>& chain, uint32_t baseSize, float roughness, uint32_t sampleCount, Level& destination, uint32_t size)
+{
+	// 視線と反射方向を法線と同じとみなす(スプリットサム近似)
+	const float alpha = roughness * roughness;
+	const float alphaSq = alpha * alpha;
+	const float texelSolidAngle = 4.0f * DirectX::XM_PI / (6.0f * baseSize * baseSize);
+	const float maxLevel = static_cast<float>(chain.size() - 1);
+
+	destination.resize(static_cast<size_t>(size) * size * FaceCount);
+	JobSystem::Instance().ParallelFor(0, static_cast<size_t>(size) * FaceCount, BakeGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t row = begin; row < end; ++row)
+		{
+			const uint32_t face = static_cast<uint32_t>(row / size);
+			const uint32_t y = static_cast<uint32_t>(row % size);
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				const DirectX::XMFLOAT3 direction = GetFaceDirection(face, (x + 0.5f) / size, (y + 0.5f) / size);
+				const DirectX::XMVECTOR N = DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction));
+
+				// 法線を z 軸とする接空間
+				const DirectX::XMVECTOR Up = std::fabs(direction.z) < 0.999f * std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z)
+					? DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : DirectX::XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+				const DirectX::XMVECTOR T = DirectX::XMVector3Normalize(DirectX::XMVector3Cross(Up, N));
+				const DirectX::XMVECTOR B = DirectX::XMVector3Cross(N, T);
+
+				DirectX::XMVECTOR Sum = DirectX::XMVectorZero();
+				float weight = 0.0f;
+				for (uint32_t i = 0; i < sampleCount; ++i)
+				{
+					// GGX の分布に従ってハーフベクトルを選ぶ
+					const DirectX::XMFLOAT2 xi = Hammersley(i, sampleCount);
+					const float phi = DirectX::XM_2PI * xi.x;
+					const float cosTheta = std::sqrt((1.0f - xi.y) / (1.0f + (alphaSq - 1.0f) * xi.y));
+					const float sinTheta = std::sqrt((std::max)(1.0f - cosTheta * cosTheta, 0.0f));
+
+					DirectX::XMVECTOR H = DirectX::XMVectorScale(T, sinTheta * std::cos(phi));
+					H = DirectX::XMVectorMultiplyAdd(B, DirectX::XMVectorReplicate(sinTheta * std::sin(phi)), H);
+					H = DirectX::XMVectorMultiplyAdd(N, DirectX::XMVectorReplicate(cosTheta), H);
+
+					const float NoH = cosTheta;
+					const DirectX::XMVECTOR L = DirectX::XMVectorSubtract(DirectX::XMVectorScale(H, 2.0f * NoH), N);
+					const float NoL = DirectX::XMVectorGetX(DirectX::XMVector3Dot(N, L));
+					if (NoL <= 0.0f) continue;
+
+					// サンプルが受け持つ立体角に合うミップを読む
+					const float denominator = NoH * NoH * (alphaSq - 1.0f) + 1.0f;
+					const float distribution = alphaSq / (DirectX::XM_PI * denominator * denominator);
+					const float pdf = distribution * 0.25f + 1e-4f;
+					const float sampleSolidAngle = 1.0f / (sampleCount * pdf);
+					const float lod = (std::clamp)(0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f, maxLevel);
+
+					const uint32_t lod0 = static_cast<uint32_t>(lod);
+					const uint32_t lod1 = (std::min)(lod0 + 1, static_cast<uint32_t>(maxLevel));
+					const DirectX::XMVECTOR Radiance = DirectX::XMVectorLerp(
+						SampleCube(chain[lod0], (std::max)(baseSize >> lod0, 1u), L),
+						SampleCube(chain[lod1], (std::max)(baseSize >> lod1, 1u), L),
+						lod - lod0);
+
+					Sum = DirectX::XMVectorMultiplyAdd(Radiance, DirectX::XMVectorReplicate(NoL), Sum);
+					weight += NoL;
+				}
+
+				DirectX::XMStoreFloat4(&destination[row * size + x], weight > 0.0f ? DirectX::XMVectorScale(Sum, 1.0f / weight) : Sum);
+			}
+		}
+	});
+}
+
+// 元のファイルの大きさと更新日時から作るキー
+uint64_t EnvironmentBaker::MakeSourceKey(const char* filename)
+{
+	std::error_code error;
+	const uint64_t size = std::filesystem::file_size(filename, error);
+	if (error) return 0;
+	const uint64_t time = static_cast<uint64_t>(std::filesystem::last_write_time(filename, error).time_since_epoch().count());
+	if (error) return 0;
+
+	// 大きさと日時を混ぜる
+	uint64_t key = size * 0x9E3779B97F4A7C15ull;
+	key ^= time + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2);
+	return key != 0 ? key : 1;
+}
+
+// 焼き込み結果の保存
+bool EnvironmentBaker::SaveCache(const char* filename, uint64_t sourceKey, const Settings& settings, const Result& result)
+{
+	std::ofstream stream(filename, std::ios::binary);
+	if (!stream) return false;
+
+	EnvironmentCacheHeader header = {};
+	std::memcpy(header.magic, CacheMagic, sizeof(header.magic));
+	header.version = CacheVersion;
+	header.sourceKey = sourceKey;
+	header.faceSize = settings.faceSize;
+	header.mipCount = settings.mipCount;
+	header.sampleCount = settings.sampleCount;
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// 設定と実際のミップ数が違うこともあるので、結果の大きさも書いておく
+	const uint32_t sizes[2] = { result.faceSize, result.mipCount };
+	stream.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+	stream.write(reinterpret_cast<const char*>(result.sh), sizeof(result.sh));
+	for (const Level& level : result.mips)
+	{
+		stream.write(reinterpret_cast<const char*>(level.data()), level.size() * sizeof(DirectX::XMFLOAT4));
+	}
+	return stream.good();
+}
+
+// 焼き込み結果の読み込み
+bool EnvironmentBaker::LoadCache(const char* filename, uint64_t sourceKey, const Settings& settings, Result& result)
+{
+	std::ifstream stream(filename, std::ios::binary);
+	if (!stream) return false;
+
+	EnvironmentCacheHeader header = {};
+	stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!stream || std::memcmp(header.magic, CacheMagic, sizeof(header.magic)) != 0 || header.version != CacheVersion) return false;
+	if (header.sourceKey != sourceKey || header.faceSize != settings.faceSize ||
+		header.mipCount != settings.mipCount || header.sampleCount != settings.sampleCount)
+	{
+		return false;
+	}
+
+	uint32_t sizes[2] = {};
+	stream.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+	if (!stream || sizes[0] == 0 || sizes[1] == 0 || (sizes[0] >> (sizes[1] - 1)) == 0) return false;
+
+	Result loaded;
+	loaded.faceSize = sizes[0];
+	loaded.mipCount = sizes[1];
+	stream.read(reinterpret_cast<char*>(loaded.sh), sizeof(loaded.sh));
+	loaded.mips.resize(loaded.mipCount);
+	for (uint32_t mip = 0; mip < loaded.mipCount; ++mip)
+	{
+		const size_t size = loaded.faceSize >> mip;
+		loaded.mips[mip].resize(size * size * FaceCount);
+		stream.read(reinterpret_cast<char*>(loaded.mips[mip].data()), loaded.mips[mip].size() * sizeof(DirectX::XMFLOAT4));
+	}
+	if (!stream) return false;
+
+	result = std::move(loaded);
+	return true;
+}
+
+// 合成した環境で焼き込みを確認する
+bool EnvironmentBaker::RunSelfTest()
+{
+	Settings settings;
+	settings.faceSize = 16;
+	settings.mipCount = 4;
+	settings.sampleCount = 32;
+
+	const uint32_t width = 128, height = 64;
+	std::vector<DirectX::XMFLOAT4> pixels(static_cast<size_t>(width) * height);
+	const DirectX::XMFLOAT3 normals[] = {
+		{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+		{ 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.577f, 0.577f, -0.577f },
+	};
+
+	// どの方向も同じ明るさなら、放射照度 / π も全てのミップもその明るさになる
+	const DirectX::XMFLOAT4 constant = { 0.5f, 1.0f, 2.0f, 1.0f };
+	std::fill(pixels.begin(), pixels.end(), constant);
+	Result result;
+	Bake(pixels.data(), width, height, settings, result);
+	if (result.faceSize != settings.faceSize || result.mipCount != settings.mipCount) return false;
+
+	for (const DirectX::XMFLOAT3& normal : normals)
+	{
+		const DirectX::XMFLOAT3 irradiance = EvaluateIrradiance(result.sh, normal);
+		if (std::fabs(irradiance.x - constant.x) > constant.x * 0.02f) return false;
+		if (std::fabs(irradiance.y - constant.y) > constant.y * 0.02f) return false;
+		if (std::fabs(irradiance.z - constant.z) > constant.z * 0.02f) return false;
+	}
+	for (uint32_t mip = 0; mip < result.mipCount; ++mip)
+	{
+		const uint32_t size = settings.faceSize >> mip;
+		if (result.mips[mip].size() != static_cast<size_t>(size) * size * FaceCount) return false;
+		for (const DirectX::XMFLOAT4& texel : result.mips[mip])
+		{
+			if (std::fabs(texel.x - constant.x) > 1e-3f || std::fabs(texel.z - constant.z) > 1e-3f) return false;
+		}
+	}
+
+	// 上半分だけが明るければ、放射照度 / π は真上で 1、真横で 0.5、真下で 0 になる
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		const float value = y < height / 2 ? 1.0f : 0.0f;
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			pixels[y * width + x] = { value, value, value, 1.0f };
+		}
+	}
+	Bake(pixels.data(), width, height, settings, result);
+
+	const float up = EvaluateIrradiance(result.sh, { 0.0f, 1.0f, 0.0f }).x;
+	const float side = EvaluateIrradiance(result.sh, { 1.0f, 0.0f, 0.0f }).x;
+	const float down = EvaluateIrradiance(result.sh, { 0.0f, -1.0f, 0.0f }).x;
+	if (std::fabs(up - 1.0f) > 0.05f || std::fabs(side - 0.5f) > 0.05f || std::fabs(down) > 0.05f) return false;
+
+	// キューブマップの面の向きが合っていれば、+Y の面は明るく -Y の面は暗い
+	const uint32_t center = (settings.faceSize / 2) * settings.faceSize + settings.faceSize / 2;
+	const size_t faceTexels = static_cast<size_t>(settings.faceSize) * settings.faceSize;
+	if (result.mips[0][2 * faceTexels + center].x < 0.99f || result.mips[0][3 * faceTexels + center].x > 0.01f) return false;
+
+	// ぼかすほど上下の差は小さくなる
+	const uint32_t roughSize = settings.faceSize >> (settings.mipCount - 1);
+	const uint32_t roughCenter = (roughSize / 2) * roughSize + roughSize / 2;
+	const size_t roughFaceTexels = static_cast<size_t>(roughSize) * roughSize;
+	const float roughUp = result.mips[settings.mipCount - 1][2 * roughFaceTexels + roughCenter].x;
+	const float roughDown = result.mips[settings.mipCount - 1][3 * roughFaceTexels + roughCenter].x;
+	if (!(roughUp < 0.999f && roughDown > 0.001f && roughUp > roughDown)) return false;
+
+	// 面の uv と方向の対応は SampleCube() で元に戻る
+	Level faces(faceTexels * FaceCount);
+	for (uint32_t face = 0; face < FaceCount; ++face)
+	{
+		std::fill(faces.begin() + face * faceTexels, faces.begin() + (face + 1) * faceTexels, DirectX::XMFLOAT4(static_cast<float>(face), 0.0f, 0.0f, 0.0f));
+	}
+	for (uint32_t face = 0; face < FaceCount; ++face)
+	{
+		const DirectX::XMFLOAT3 direction = GetFaceDirection(face, 0.3f, 0.7f);
+		const DirectX::XMVECTOR Color = SampleCube(faces, settings.faceSize, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction)));
+		if (DirectX::XMVectorGetX(Color) != static_cast<float>(face)) return false;
+	}
+
+	// 保存して読み込めば同じ結果になり、元のファイルが変われば読み込まない
+	const std::string cacheFilename = (std::filesystem::temp_directory_path() / "environment_baker_test.envcache").string();
+	const uint64_t sourceKey = 12345;
+	if (!SaveCache(cacheFilename.c_str(), sourceKey, settings, result)) return false;
+	Result loaded;
+	const bool loadedSame = LoadCache(cacheFilename.c_str(), sourceKey, settings, loaded);
+	const bool loadedOther = LoadCache(cacheFilename.c_str(), sourceKey + 1, settings, loaded);
+	std::error_code error;
+	std::filesystem::remove(cacheFilename, error);
+	if (!loadedSame || loadedOther) return false;
+	if (loaded.mipCount != result.mipCount || std::memcmp(loaded.sh, result.sh, sizeof(result.sh)) != 0) return false;
+	for (uint32_t mip = 0; mip < result.mipCount; ++mip)
+	{
+		if (std::memcmp(loaded.mips[mip].data(), result.mips[mip].data(), result.mips[mip].size() * sizeof(DirectX::XMFLOAT4)) != 0) return false;
+	}
+
+	return true;
+}
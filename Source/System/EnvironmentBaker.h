@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+// 正距円筒図法の HDR 画像から環境光を CPU で焼き込む
+// ミップ 0 は元の画像を写したキューブマップ、ミップ 1 以降は粗さ(ミップ / (ミップ数 - 1))に合わせて GGX でぼかした鏡面反射用
+// 拡散反射は 3次(9係数)の球面調和関数にし、コサインで畳み込んで 放射照度 / π をそのまま求められるようにする
+// 焼き込みに時間がかかるので、結果は元の画像の大きさと更新日時を付けてファイルに保存し、次回からはそれを読み込む
+class EnvironmentBaker
+{
+public:
+	static const uint32_t FaceCount = 6;			// +X, -X, +Y, -Y, +Z, -Z の順
+	static const uint32_t ShCoefficientCount = 9;
+
+	// 画質と負荷の調整値
+	struct Settings
+	{
+		uint32_t	faceSize = 128;		// ミップ 0 の1面の大きさ
+		uint32_t	mipCount = 6;		// 1 なら鏡面反射をぼかさない
+		uint32_t	sampleCount = 64;	// ミップ 1 以降の1テクセルあたりのサンプル数
+	};
+
+	// 焼き込み結果
+	struct Result
+	{
+		uint32_t								faceSize = 0;
+		uint32_t								mipCount = 0;
+		std::vector<std::vector<DirectX::XMFLOAT4>>	mips;						// ミップごとに6面分を面の順に並べたもの
+		DirectX::XMFLOAT4						sh[ShCoefficientCount] = {};	// 畳み込み済みの係数(rgb)
+	};
+
+	// width * height の RGBA の画像から焼き込む
+	static void Bake(const DirectX::XMFLOAT4* pixels, uint32_t width, uint32_t height, const Settings& settings, Result& result);
+
+	// 法線方向の 放射照度 / π を求める(Environment.hlsli と同じ計算)
+	static DirectX::XMFLOAT3 EvaluateIrradiance(const DirectX::XMFLOAT4 sh[ShCoefficientCount], const DirectX::XMFLOAT3& normal);
+
+	// キューブマップの面の uv (0～1) の方向(正規化していない)
+	static DirectX::XMFLOAT3 GetFaceDirection(uint32_t face, float u, float v);
+
+	// 元のファイルの大きさと更新日時から作るキー(ファイルがなければ 0)
+	static uint64_t MakeSourceKey(const char* filename);
+
+	// 焼き込み結果の保存
+	static bool SaveCache(const char* filename, uint64_t sourceKey, const Settings& settings, const Result& result);
+
+	// 焼き込み結果の読み込み(キーか設定が違えば false)
+	static bool LoadCache(const char* filename, uint64_t sourceKey, const Settings& settings, Result& result);
+
+	// 一様な環境と上半分だけ明るい環境を焼き込み、放射照度の値、キューブマップの面の向きと uv の対応、
+	// 粗さによるぼかし、キャッシュの保存と読み込み(元の画像が変われば読み込まない)を確認する
+	static bool RunSelfTest();
+
+private:
+	using Level = std::vector<DirectX::XMFLOAT4>;
+
+	// 正距円筒図法の画像をバイリニアで読む
+	static DirectX::XMVECTOR SampleEquirect(const DirectX::XMFLOAT4* pixels, uint32_t width, uint32_t height, DirectX::FXMVECTOR direction);
+
+	// キューブマップの1ミップをバイリニアで読む
+	static DirectX::XMVECTOR SampleCube(const Level& level, uint32_t size, DirectX::FXMVECTOR direction);
+
+	// 2x2 の平均で半分の大きさのミップを作る
+	static void Downsample(const Level& source, uint32_t sourceSize, Level& destination);
+
+	// ミップ 0 を球面調和関数に射影する
+	static void ProjectSh(const Level& level, uint32_t size, DirectX::XMFLOAT4 sh[ShCoefficientCount]);
+
+	// 1ミップを GGX でぼかす(chain は元のキューブマップのミップチェーン)
+	static void Prefilter(const std::vector<Level>& chain, uint32_t baseSize, float roughness, uint32_t sampleCount, Level& destination, uint32_t size);
+};
@@ -0,0 +1,143 @@
+#include <chrono>
+#include <filesystem>
+#include <DirectXTex.h>
+#include <imgui.h>
+#include "System/Misc.h"
+#include "System/EnvironmentLighting.h"
+
+// コンストラクタ
+EnvironmentLighting::EnvironmentLighting(ID3D11Device* device, const char* filename, const EnvironmentBaker::Settings& settings)
+{
+	// キャッシュが元の画像と設定に合っていれば読み込み、合わなければ焼き込んで保存する
+	const std::filesystem::path filepath(filename);
+	const std::string cacheFilename = std::filesystem::path(filepath).replace_extension(".envcache").string();
+	const uint64_t sourceKey = EnvironmentBaker::MakeSourceKey(filename);
+
+	EnvironmentBaker::Result result;
+	statistics.loadedFromCache = sourceKey != 0 && EnvironmentBaker::LoadCache(cacheFilename.c_str(), sourceKey, settings, result);
+	if (!statistics.loadedFromCache)
+	{
+		// 32bit の RGBA に変換して焼き込む
+		DirectX::ScratchImage image;
+		HRESULT hr = DirectX::LoadFromHDRFile(filepath.wstring().c_str(), nullptr, image);
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+		if (FAILED(hr)) return;
+
+		DirectX::ScratchImage converted;
+		hr = DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_R32G32B32A32_FLOAT,
+			DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+		if (FAILED(hr)) return;
+
+		const DirectX::Image* pixels = converted.GetImage(0, 0, 0);
+		_ASSERT_EXPR(pixels->rowPitch == pixels->width * sizeof(DirectX::XMFLOAT4), L"HDR rows must be tightly packed");
+
+		const auto start = std::chrono::steady_clock::now();
+		EnvironmentBaker::Bake(reinterpret_cast<const DirectX::XMFLOAT4*>(pixels->pixels),
+			static_cast<uint32_t>(pixels->width), static_cast<uint32_t>(pixels->height), settings, result);
+		statistics.bakeMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		if (sourceKey != 0) EnvironmentBaker::SaveCache(cacheFilename.c_str(), sourceKey, settings, result);
+	}
+
+	// キューブマップ(サブリソースは面ごとにミップを並べる)
+	std::vector<D3D11_SUBRESOURCE_DATA> subresources(EnvironmentBaker::FaceCount * result.mipCount);
+	for (UINT face = 0; face < EnvironmentBaker::FaceCount; ++face)
+	{
+		for (UINT mip = 0; mip < result.mipCount; ++mip)
+		{
+			const UINT size = result.faceSize >> mip;
+			D3D11_SUBRESOURCE_DATA& data = subresources[D3D11CalcSubresource(mip, face, result.mipCount)];
+			data.pSysMem = &result.mips[mip][static_cast<size_t>(face) * size * size];
+			data.SysMemPitch = size * sizeof(DirectX::XMFLOAT4);
+			data.SysMemSlicePitch = 0;
+			statistics.textureBytes += static_cast<size_t>(size) * size * sizeof(DirectX::XMFLOAT4);
+		}
+	}
+
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = result.faceSize;
+	desc.Height = result.faceSize;
+	desc.MipLevels = result.mipCount;
+	desc.ArraySize = EnvironmentBaker::FaceCount;
+	desc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	desc.MiscFlags = D3D11_RESOURCE_MISC_TEXTURECUBE;
+
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+	HRESULT hr = device->CreateTexture2D(&desc, subresources.data(), texture.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc = {};
+	viewDesc.Format = desc.Format;
+	viewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+	viewDesc.TextureCube.MostDetailedMip = 0;
+	viewDesc.TextureCube.MipLevels = result.mipCount;
+	hr = device->CreateShaderResourceView(texture.Get(), &viewDesc, shaderResourceView.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	// 球面調和関数は変わらないので書き込んだまま使う
+	CbEnvironment cbEnvironment;
+	for (UINT i = 0; i < EnvironmentBaker::ShCoefficientCount; ++i)
+	{
+		cbEnvironment.sh[i] = result.sh[i];
+	}
+
+	D3D11_BUFFER_DESC bufferDesc = {};
+	bufferDesc.ByteWidth = sizeof(CbEnvironment);
+	bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA bufferData = {};
+	bufferData.pSysMem = &cbEnvironment;
+	hr = device->CreateBuffer(&bufferDesc, &bufferData, constantBuffer.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	mipCount = result.mipCount;
+	statistics.faceSize = result.faceSize;
+	statistics.mipCount = result.mipCount;
+}
+
+// 球面調和関数とキューブマップを設定
+void EnvironmentLighting::Bind(ID3D11DeviceContext* dc) const
+{
+	if (mipCount == 0) return;
+
+	dc->PSSetConstantBuffers(ConstantBufferSlot, 1, constantBuffer.GetAddressOf());
+	dc->PSSetShaderResources(TextureSlot, 1, shaderResourceView.GetAddressOf());
+}
+
+// 設定解除
+void EnvironmentLighting::Unbind(ID3D11DeviceContext* dc) const
+{
+	ID3D11Buffer* nullBuffer = nullptr;
+	ID3D11ShaderResourceView* nullView = nullptr;
+	dc->PSSetConstantBuffers(ConstantBufferSlot, 1, &nullBuffer);
+	dc->PSSetShaderResources(TextureSlot, 1, &nullView);
+}
+
+// デバッグGUI描画
+void EnvironmentLighting::DrawDebugGUI()
+{
+	if (ImGui::CollapsingHeader("Environment Lighting", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::SliderFloat("Intensity", &intensity, 0.0f, 4.0f);
+		ImGui::Text("Source      : %s", statistics.loadedFromCache ? "Cache" : "Baked");
+		ImGui::Text("Bake Time   : %.1f ms", statistics.bakeMilliseconds);
+		ImGui::Text("Face Size   : %u", statistics.faceSize);
+		ImGui::Text("Mips        : %u", statistics.mipCount);
+		ImGui::Text("Texture     : %.1f KB", statistics.textureBytes / 1024.0f);
+
+		if (ImGui::Button("Environment Bake Test"))
+		{
+			selfTestResult = EnvironmentBaker::RunSelfTest() ? 1 : 0;
+		}
+		if (selfTestResult >= 0)
+		{
+			ImGui::SameLine();
+			ImGui::Text(selfTestResult ? "Pass" : "FAIL");
+		}
+	}
+}
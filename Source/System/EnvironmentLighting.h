@@ -0,0 +1,57 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d11.h>
+#include "EnvironmentBaker.h"
+
+// HDR のスカイマップから焼き込んだ環境光(拡散反射の球面調和関数と鏡面反射のキューブマップ)
+// 焼き込みは EnvironmentBaker で行い、結果は元の画像と同じ場所に拡張子 .envcache で保存して次回から読み込む
+class EnvironmentLighting
+{
+public:
+	static const UINT ConstantBufferSlot = 9;	// ピクセルシェーダーの register(b9)
+	static const UINT TextureSlot = 19;			// ピクセルシェーダーの register(t19)
+
+	EnvironmentLighting(ID3D11Device* device, const char* filename, const EnvironmentBaker::Settings& settings = {});
+
+	// 球面調和関数とキューブマップを設定
+	void Bind(ID3D11DeviceContext* dc) const;
+
+	// 設定解除
+	void Unbind(ID3D11DeviceContext* dc) const;
+
+	// キューブマップのミップ数(読み込めなければ 0)
+	UINT GetMipCount() const { return mipCount; }
+
+	// 明るさ
+	float GetIntensity() const { return intensity; }
+	void SetIntensity(float intensity) { this->intensity = intensity; }
+
+	// 統計
+	struct Statistics
+	{
+		bool	loadedFromCache = false;	// キャッシュから読み込んだか
+		float	bakeMilliseconds = 0.0f;	// 焼き込みにかかった時間
+		UINT	faceSize = 0;
+		UINT	mipCount = 0;
+		size_t	textureBytes = 0;
+	};
+	const Statistics& GetStatistics() const { return statistics; }
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+private:
+	// Environment.hlsli と同じ配置
+	struct CbEnvironment
+	{
+		DirectX::XMFLOAT4	sh[EnvironmentBaker::ShCoefficientCount];
+	};
+
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				constantBuffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	shaderResourceView;
+	UINT												mipCount = 0;
+	float												intensity = 1.0f;
+	Statistics											statistics;
+	int													selfTestResult = -1;
+};
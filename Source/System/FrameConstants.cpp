@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cstring>
+#include <d3d11_1.h>
+#include "Misc.h"
+#include "System/FrameConstants.h"
+#include "System/EnvironmentLighting.h"
+#include "System/Profiler.h"
+
+// 陰影の調整値(全シェーダー共通)
+static const float AmbientIntensity = 0.02f;
+static const float Exposure = 0.3f;
+
+// コンストラクタ
+FrameConstants::FrameConstants(ID3D11Device* device)
+	: device(device)
+{
+	// 定数バッファのオフセット指定と、それに書き足すための WRITE_NO_OVERWRITE は D3D11.1 の任意機能
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+	if (SUCCEEDED(device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+	{
+		constantBufferOffsetting = options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+	}
+
+	D3D11_BUFFER_DESC desc{};
+	desc.ByteWidth = SlotSize * (constantBufferOffsetting ? SlotCount : 1);
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	HRESULT hr = device->CreateBuffer(&desc, nullptr, constantBuffer.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+}
+
+// ビューの定数を作ってリングバッファに書き込む
+void FrameConstants::Update(const RenderContext& rc)
+{
+	PROFILE_SCOPE("FrameConstants::Update");
+
+	ID3D11DeviceContext* dc = rc.deviceContext;
+
+	static const LightManager defaultLightManager;
+	const LightManager* lightManager = rc.lightManager ? rc.lightManager : &defaultLightManager;
+
+	CbScene cbScene{};
+
+	// カメラ
+	const DirectX::XMFLOAT4X4& view = rc.camera->GetView();
+	DirectX::XMMATRIX V = DirectX::XMLoadFloat4x4(&view);
+	DirectX::XMMATRIX P = DirectX::XMLoadFloat4x4(&rc.camera->GetProjection());
+	DirectX::XMStoreFloat4x4(&cbScene.viewProjection, V * P);
+
+	const DirectX::XMFLOAT3& eye = rc.camera->GetEye();
+	cbScene.cameraPosition = { eye.x, eye.y, eye.z, 1.0f };
+
+	// 平行光源
+	const DirectionalLight& directionalLight = lightManager->GetDirectionalLight();
+	cbScene.lightDirection = { directionalLight.direction.x, directionalLight.direction.y, directionalLight.direction.z, 0.0f };
+	cbScene.lightColor = { directionalLight.color.x, directionalLight.color.y, directionalLight.color.z, 1.0f };
+
+	cbScene.ambientIntensity = AmbientIntensity;
+	cbScene.exposure = Exposure;
+
+	// 環境光
+	if (rc.environment)
+	{
+		cbScene.environmentMipCount = static_cast<float>(rc.environment->GetMipCount());
+		cbScene.environmentIntensity = rc.environment->GetIntensity();
+	}
+
+	// 点光源とスポットライトをクラスタに割り当てる(番号は LightManager の配列の番号なので、ライトは全て送る)
+	const std::vector<PointLight>& srcPointLights = lightManager->GetAllPointLights();
+	const std::vector<SpotLight>& srcSpotLights = lightManager->GetAllSpotLights();
+	lightCuller.Build(view, rc.camera->GetProjection(), srcPointLights, srcSpotLights);
+
+	pointLights.resize(srcPointLights.size());
+	for (size_t i = 0; i < srcPointLights.size(); ++i)
+	{
+		pointLights[i].position = srcPointLights[i].position;
+		pointLights[i].range = srcPointLights[i].range;
+		pointLights[i].color = srcPointLights[i].color;
+		pointLights[i].intensity = srcPointLights[i].intensity;
+	}
+
+	spotLights.resize(srcSpotLights.size());
+	for (size_t i = 0; i < srcSpotLights.size(); ++i)
+	{
+		spotLights[i].position = srcSpotLights[i].position;
+		spotLights[i].range = srcSpotLights[i].range;
+		spotLights[i].direction = srcSpotLights[i].direction;
+		spotLights[i].innerConeAngle = DirectX::XMConvertToRadians(srcSpotLights[i].innerConeAngle);
+		spotLights[i].color = srcSpotLights[i].color;
+		spotLights[i].outerConeAngle = DirectX::XMConvertToRadians(srcSpotLights[i].outerConeAngle);
+		spotLights[i].intensity = srcSpotLights[i].intensity;
+		spotLights[i].pad = { 0.0f, 0.0f, 0.0f };
+	}
+
+	const std::vector<LightCuller::Cluster>& clusters = lightCuller.GetClusters();
+	const std::vector<uint32_t>& lightIndices = lightCuller.GetLightIndices();
+	UpdateStructuredBuffer(dc, pointLights.data(), static_cast<UINT>(pointLights.size()), sizeof(GpuPointLight),
+		pointLightBuffer, pointLightSRV, pointLightCapacity);
+	UpdateStructuredBuffer(dc, spotLights.data(), static_cast<UINT>(spotLights.size()), sizeof(GpuSpotLight),
+		spotLightBuffer, spotLightSRV, spotLightCapacity);
+	UpdateStructuredBuffer(dc, clusters.data(), static_cast<UINT>(clusters.size()), sizeof(LightCuller::Cluster),
+		clusterBuffer, clusterSRV, clusterCapacity);
+	UpdateStructuredBuffer(dc, lightIndices.data(), static_cast<UINT>(lightIndices.size()), sizeof(uint32_t),
+		lightIndexBuffer, lightIndexSRV, lightIndexCapacity);
+
+	// ピクセルが属するクラスタを求めるための係数
+	cbScene.viewDepth = { view._13, view._23, view._33, view._43 };
+	cbScene.clusterDepthScale = lightCuller.GetDepthSliceScale();
+	cbScene.clusterDepthBias = lightCuller.GetDepthSliceBias();
+
+	D3D11_VIEWPORT viewport{};
+	UINT viewportCount = 1;
+	dc->RSGetViewports(&viewportCount, &viewport);
+	if (viewportCount == 0 || viewport.Width <= 0.0f || viewport.Height <= 0.0f)
+	{
+		viewport.Width = 1.0f;
+		viewport.Height = 1.0f;
+	}
+	cbScene.clusterTileScale = { LightCuller::ClusterCountX / viewport.Width, LightCuller::ClusterCountY / viewport.Height };
+	cbScene.clusterTileOffset = { viewport.TopLeftX, viewport.TopLeftY };
+
+	// GPU が前のビューの定数を読んでいるかもしれないので、使っていないスロットに書き足す
+	D3D11_MAP mapType = D3D11_MAP_WRITE_DISCARD;
+	if (constantBufferOffsetting)
+	{
+		if (slotCursor >= SlotCount) slotCursor = 0;
+		if (slotCursor > 0) mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+		currentSlot = slotCursor++;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mapped{};
+	HRESULT hr = dc->Map(constantBuffer.Get(), 0, mapType, 0, &mapped);
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	if (SUCCEEDED(hr))
+	{
+		std::memcpy(static_cast<uint8_t*>(mapped.pData) + currentSlot * SlotSize, &cbScene, sizeof(cbScene));
+		dc->Unmap(constantBuffer.Get(), 0);
+	}
+
+	PROFILE_COUNTER("Clustered light indices", lightIndices.size());
+	PROFILE_COUNTER("Max lights per cluster", lightCuller.GetMaxLightsPerCluster());
+}
+
+// 書き込んだ定数とライトを設定
+void FrameConstants::Bind(ID3D11DeviceContext* dc) const
+{
+	ID3D11Buffer* cbs[] = { constantBuffer.Get() };
+
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext1> dc1;
+	if (constantBufferOffsetting && SUCCEEDED(dc->QueryInterface(IID_PPV_ARGS(dc1.GetAddressOf()))))
+	{
+		// オフセットと個数は16バイトの定数単位
+		const UINT firstConstant = currentSlot * SlotSize / 16;
+		const UINT numConstants = SlotSize / 16;
+		dc1->VSSetConstantBuffers1(ConstantBufferSlot, _countof(cbs), cbs, &firstConstant, &numConstants);
+		dc1->PSSetConstantBuffers1(ConstantBufferSlot, _countof(cbs), cbs, &firstConstant, &numConstants);
+	}
+	else
+	{
+		dc->VSSetConstantBuffers(ConstantBufferSlot, _countof(cbs), cbs);
+		dc->PSSetConstantBuffers(ConstantBufferSlot, _countof(cbs), cbs);
+	}
+
+	ID3D11ShaderResourceView* srvs[LightBufferCount] =
+	{
+		pointLightSRV.Get(),
+		spotLightSRV.Get(),
+		clusterSRV.Get(),
+		lightIndexSRV.Get(),
+	};
+	dc->PSSetShaderResources(LightBufferSlot, _countof(srvs), srvs);
+}
+
+// 設定解除
+void FrameConstants::Unbind(ID3D11DeviceContext* dc) const
+{
+	ID3D11Buffer* cbs[] = { nullptr };
+	dc->VSSetConstantBuffers(ConstantBufferSlot, _countof(cbs), cbs);
+	dc->PSSetConstantBuffers(ConstantBufferSlot, _countof(cbs), cbs);
+
+	ID3D11ShaderResourceView* srvs[LightBufferCount] = {};
+	dc->PSSetShaderResources(LightBufferSlot, _countof(srvs), srvs);
+}
+
+// 動的な StructuredBuffer の内容を置き換える
+void FrameConstants::UpdateStructuredBuffer(ID3D11DeviceContext* dc, const void* data, UINT count, UINT stride,
+	Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv, UINT& capacity)
+{
+	// 足りなければ2倍ずつ大きくして作り直す(空でもSRVは設定できるようにしておく)
+	if (!buffer || count > capacity)
+	{
+		UINT newCapacity = (std::max)(capacity, 64u);
+		while (newCapacity < count) newCapacity *= 2;
+
+		D3D11_BUFFER_DESC desc{};
+		desc.ByteWidth = stride * newCapacity;
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+		desc.StructureByteStride = stride;
+
+		buffer.Reset();
+		srv.Reset();
+		HRESULT hr = device->CreateBuffer(&desc, nullptr, buffer.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+		srvDesc.Buffer.FirstElement = 0;
+		srvDesc.Buffer.NumElements = newCapacity;
+		hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, srv.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+		capacity = newCapacity;
+	}
+
+	if (count == 0) return;
+
+	D3D11_MAPPED_SUBRESOURCE mapped{};
+	HRESULT hr = dc->Map(buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	if (FAILED(hr)) return;
+	std::memcpy(mapped.pData, data, static_cast<size_t>(stride) * count);
+	dc->Unmap(buffer.Get(), 0);
+}
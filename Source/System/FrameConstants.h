@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <wrl.h>
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include "RenderContext.h"
+#include "LightCuller.h"
+
+// ビューごとのシーン定数(カメラ、ライト、クラスタ)
+// 1ビューにつき1回だけ作り、シェーダーは設定済みのものを参照するだけにする
+class FrameConstants
+{
+public:
+	static const UINT ConstantBufferSlot = 7;	// 頂点・ピクセルシェーダーの register(b7)
+	static const UINT LightBufferSlot = 6;		// ピクセルシェーダーの register(t6)～(t9)
+	static const UINT LightBufferCount = 4;
+
+	FrameConstants(ID3D11Device* device);
+
+	// ビューの定数を作ってリングバッファに書き込み、ライトをクラスタに割り当てる
+	void Update(const RenderContext& rc);
+
+	// 書き込んだ定数とライトを設定
+	void Bind(ID3D11DeviceContext* dc) const;
+
+	// 設定解除
+	void Unbind(ID3D11DeviceContext* dc) const;
+
+private:
+	// Scene.hlsli と同じ配置
+	struct CbScene
+	{
+		DirectX::XMFLOAT4X4	viewProjection;
+		DirectX::XMFLOAT4	lightDirection;
+		DirectX::XMFLOAT4	lightColor;
+		DirectX::XMFLOAT4	cameraPosition;
+		DirectX::XMFLOAT4	viewDepth;			// ビュー行列の z 列(ワールド座標から深度を求める)
+		DirectX::XMFLOAT2	clusterTileScale;	// ピクセル座標からタイル番号への係数
+		DirectX::XMFLOAT2	clusterTileOffset;	// ビューポートの左上
+		float				clusterDepthScale;
+		float				clusterDepthBias;
+		float				ambientIntensity;
+		float				exposure;
+		float				environmentMipCount;	// 環境光のキューブマップのミップ数(0 なら環境光なし)
+		float				environmentIntensity;
+		DirectX::XMFLOAT2	environmentPad;
+	};
+
+	// ライト(StructuredBuffer register(t6)、(t7))
+	struct GpuPointLight
+	{
+		DirectX::XMFLOAT3	position;
+		float				range;
+		DirectX::XMFLOAT3	color;
+		float				intensity;
+	};
+
+	struct GpuSpotLight
+	{
+		DirectX::XMFLOAT3	position;
+		float				range;
+		DirectX::XMFLOAT3	direction;
+		float				innerConeAngle;
+		DirectX::XMFLOAT3	color;
+		float				outerConeAngle;
+		float				intensity;
+		DirectX::XMFLOAT3	pad;
+	};
+
+	// 定数バッファのオフセット指定は 256 バイト(16定数)単位
+	static const UINT SlotSize = 256;
+	static const UINT SlotCount = 64;	// リングバッファに入るビュー数
+	static_assert(sizeof(CbScene) <= SlotSize, "CbScene must fit in a ring buffer slot");
+
+	// 動的な StructuredBuffer の内容を置き換える(足りなければ作り直す)
+	void UpdateStructuredBuffer(ID3D11DeviceContext* dc, const void* data, UINT count, UINT stride,
+		Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv, UINT& capacity);
+
+private:
+	ID3D11Device*							device;
+
+	// シーン定数のリングバッファ
+	// D3D11.1 の定数バッファのオフセット指定が使えれば WRITE_NO_OVERWRITE で書き足し、
+	// 使えなければ先頭のスロットだけを WRITE_DISCARD で毎回書き換える
+	Microsoft::WRL::ComPtr<ID3D11Buffer>	constantBuffer;
+	bool									constantBufferOffsetting = false;
+	UINT									slotCursor = 0;
+	UINT									currentSlot = 0;
+
+	// クラスタ単位のライト割り当て
+	LightCuller								lightCuller;
+	std::vector<GpuPointLight>				pointLights;
+	std::vector<GpuSpotLight>				spotLights;
+
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				pointLightBuffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	pointLightSRV;
+	UINT												pointLightCapacity = 0;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				spotLightBuffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	spotLightSRV;
+	UINT												spotLightCapacity = 0;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				clusterBuffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	clusterSRV;
+	UINT												clusterCapacity = 0;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				lightIndexBuffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	lightIndexSRV;
+	UINT												lightIndexCapacity = 0;
+};
@@ -0,0 +1,183 @@
+#include "System/FrustumCuller.h"
+#include "System/JobSystem.h"
+
+// ビュープロジェクション行列から視錐台を設定
+void FrustumCuller::SetViewProjection(const DirectX::XMFLOAT4X4& viewProjection, const DirectX::XMFLOAT3& eye, float maxDistance, float projectionScale)
+{
+	const DirectX::XMFLOAT4X4& m = viewProjection;
+
+	// 行ベクトル形式なのでクリップ座標は行列の各列との内積になる(深度は 0～w)
+	const DirectX::XMVECTOR Column0 = DirectX::XMVectorSet(m._11, m._21, m._31, m._41);
+	const DirectX::XMVECTOR Column1 = DirectX::XMVectorSet(m._12, m._22, m._32, m._42);
+	const DirectX::XMVECTOR Column2 = DirectX::XMVectorSet(m._13, m._23, m._33, m._43);
+	const DirectX::XMVECTOR Column3 = DirectX::XMVectorSet(m._14, m._24, m._34, m._44);
+
+	const DirectX::XMVECTOR Planes[6] =
+	{
+		DirectX::XMVectorAdd(Column3, Column0),			// 左
+		DirectX::XMVectorSubtract(Column3, Column0),	// 右
+		DirectX::XMVectorAdd(Column3, Column1),			// 下
+		DirectX::XMVectorSubtract(Column3, Column1),	// 上
+		Column2,										// 近
+		DirectX::XMVectorSubtract(Column3, Column2),	// 遠
+	};
+	for (int i = 0; i < 6; ++i)
+	{
+		DirectX::XMStoreFloat4(&planes[i], DirectX::XMPlaneNormalize(Planes[i]));
+	}
+
+	this->eye = eye;
+	this->maxDistance = maxDistance;
+	this->projectionScale = projectionScale;
+}
+
+// 判定対象をクリア
+void FrustumCuller::Clear()
+{
+	count = 0;
+}
+
+// 判定対象のボックス追加
+size_t FrustumCuller::AddBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents)
+{
+	// BatchSize 単位で確保する(確保した領域は次のフレームも使い回す)
+	if (count == centerX.size())
+	{
+		const size_t capacity = count + BatchSize;
+		centerX.resize(capacity, 0.0f);
+		centerY.resize(capacity, 0.0f);
+		centerZ.resize(capacity, 0.0f);
+		extentX.resize(capacity, 0.0f);
+		extentY.resize(capacity, 0.0f);
+		extentZ.resize(capacity, 0.0f);
+		results.resize(capacity, CullResult::Visible);
+		screenSizes.resize(capacity, 0.0f);
+	}
+
+	centerX[count] = center.x;
+	centerY[count] = center.y;
+	centerZ[count] = center.z;
+	extentX[count] = extents.x;
+	extentY[count] = extents.y;
+	extentZ[count] = extents.z;
+	return count++;
+}
+
+// 追加したボックスをまとめて判定
+void FrustumCuller::Cull()
+{
+	const DirectX::XMVECTOR Zero = DirectX::XMVectorZero();
+
+	// 平面の各成分を4要素に複製しておく
+	DirectX::XMVECTOR PlaneX[6], PlaneY[6], PlaneZ[6], PlaneW[6];
+	DirectX::XMVECTOR AbsX[6], AbsY[6], AbsZ[6];
+	for (int i = 0; i < 6; ++i)
+	{
+		PlaneX[i] = DirectX::XMVectorReplicate(planes[i].x);
+		PlaneY[i] = DirectX::XMVectorReplicate(planes[i].y);
+		PlaneZ[i] = DirectX::XMVectorReplicate(planes[i].z);
+		PlaneW[i] = DirectX::XMVectorReplicate(planes[i].w);
+		AbsX[i] = DirectX::XMVectorAbs(PlaneX[i]);
+		AbsY[i] = DirectX::XMVectorAbs(PlaneY[i]);
+		AbsZ[i] = DirectX::XMVectorAbs(PlaneZ[i]);
+	}
+
+	const bool useDistance = maxDistance > 0.0f;
+	const DirectX::XMVECTOR EyeX = DirectX::XMVectorReplicate(eye.x);
+	const DirectX::XMVECTOR EyeY = DirectX::XMVectorReplicate(eye.y);
+	const DirectX::XMVECTOR EyeZ = DirectX::XMVectorReplicate(eye.z);
+	const DirectX::XMVECTOR MaxDistance = DirectX::XMVectorReplicate(maxDistance);
+	const DirectX::XMVECTOR ProjectionScale = DirectX::XMVectorReplicate(projectionScale);
+
+	// 8個のボックスを4要素のベクトル2本ずつで処理する(まとまった数ごとにワーカースレッドに分ける)
+	const size_t batchCount = (count + BatchSize - 1) / BatchSize;
+	JobSystem::Instance().ParallelFor(0, batchCount, CullGrainSize, [&](size_t beginBatch, size_t endBatch)
+	{
+		for (size_t batch = beginBatch; batch < endBatch; ++batch)
+		{
+			const size_t base = batch * BatchSize;
+			for (size_t half = 0; half < BatchSize; half += 4)
+			{
+				const size_t index = base + half;
+				const DirectX::XMVECTOR CenterX = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&centerX[index]));
+				const DirectX::XMVECTOR CenterY = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&centerY[index]));
+				const DirectX::XMVECTOR CenterZ = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&centerZ[index]));
+				const DirectX::XMVECTOR ExtentX = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&extentX[index]));
+				const DirectX::XMVECTOR ExtentY = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&extentY[index]));
+				const DirectX::XMVECTOR ExtentZ = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&extentZ[index]));
+
+				// 中心の符号付き距離に、平面の法線方向へ投影した半径を足しても負なら完全に外側
+				DirectX::XMVECTOR Outside = DirectX::XMVectorFalseInt();
+				for (int i = 0; i < 6; ++i)
+				{
+					DirectX::XMVECTOR Distance = DirectX::XMVectorMultiplyAdd(CenterX, PlaneX[i], PlaneW[i]);
+					Distance = DirectX::XMVectorMultiplyAdd(CenterY, PlaneY[i], Distance);
+					Distance = DirectX::XMVectorMultiplyAdd(CenterZ, PlaneZ[i], Distance);
+
+					DirectX::XMVECTOR Radius = DirectX::XMVectorMultiply(ExtentX, AbsX[i]);
+					Radius = DirectX::XMVectorMultiplyAdd(ExtentY, AbsY[i], Radius);
+					Radius = DirectX::XMVectorMultiplyAdd(ExtentZ, AbsZ[i], Radius);
+
+					Outside = DirectX::XMVectorOrInt(Outside, DirectX::XMVectorLess(DirectX::XMVectorAdd(Distance, Radius), Zero));
+				}
+
+				// 視点から中心までの距離と外接球の半径
+				const DirectX::XMVECTOR DeltaX = DirectX::XMVectorSubtract(CenterX, EyeX);
+				const DirectX::XMVECTOR DeltaY = DirectX::XMVectorSubtract(CenterY, EyeY);
+				const DirectX::XMVECTOR DeltaZ = DirectX::XMVectorSubtract(CenterZ, EyeZ);
+				DirectX::XMVECTOR DistanceSq = DirectX::XMVectorMultiply(DeltaX, DeltaX);
+				DistanceSq = DirectX::XMVectorMultiplyAdd(DeltaY, DeltaY, DistanceSq);
+				DistanceSq = DirectX::XMVectorMultiplyAdd(DeltaZ, DeltaZ, DistanceSq);
+
+				DirectX::XMVECTOR RadiusSq = DirectX::XMVectorMultiply(ExtentX, ExtentX);
+				RadiusSq = DirectX::XMVectorMultiplyAdd(ExtentY, ExtentY, RadiusSq);
+				RadiusSq = DirectX::XMVectorMultiplyAdd(ExtentZ, ExtentZ, RadiusSq);
+				const DirectX::XMVECTOR Radius = DirectX::XMVectorSqrt(RadiusSq);
+
+				// 描画距離と外接球の半径の和より遠ければ描画しない
+				DirectX::XMVECTOR Far = DirectX::XMVectorFalseInt();
+				if (useDistance)
+				{
+					const DirectX::XMVECTOR Limit = DirectX::XMVectorAdd(Radius, MaxDistance);
+					Far = DirectX::XMVectorGreater(DistanceSq, DirectX::XMVectorMultiply(Limit, Limit));
+				}
+
+				// 画面サイズ(球の中に視点がある場合は画面を覆うものとして扱う)
+				const DirectX::XMVECTOR Distance = DirectX::XMVectorMax(DirectX::XMVectorSqrt(DistanceSq), Radius);
+				const DirectX::XMVECTOR ScreenSize = DirectX::XMVectorDivide(DirectX::XMVectorMultiply(Radius, ProjectionScale),
+					DirectX::XMVectorMax(Distance, DirectX::XMVectorReplicate(1e-6f)));
+				DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(&screenSizes[index]), ScreenSize);
+
+				uint32_t outsideMask[4], farMask[4];
+				DirectX::XMStoreInt4(outsideMask, Outside);
+				DirectX::XMStoreInt4(farMask, Far);
+				for (size_t lane = 0; lane < 4; ++lane)
+				{
+					results[index + lane] =
+						outsideMask[lane] ? CullResult::FrustumCulled :
+						farMask[lane] ? CullResult::DistanceCulled :
+						CullResult::Visible;
+				}
+			}
+		}
+	});
+}
+
+// ローカル空間の範囲をワールド行列で変換し、それを囲むワールド空間の中心と半分の大きさを求める
+void FrustumCuller::TransformBounds(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax,
+	const DirectX::XMFLOAT4X4& worldTransform, DirectX::XMFLOAT3& center, DirectX::XMFLOAT3& extents)
+{
+	const DirectX::XMVECTOR Min = DirectX::XMLoadFloat3(&boundsMin);
+	const DirectX::XMVECTOR Max = DirectX::XMLoadFloat3(&boundsMax);
+	const DirectX::XMVECTOR Center = DirectX::XMVectorScale(DirectX::XMVectorAdd(Min, Max), 0.5f);
+	const DirectX::XMVECTOR Extents = DirectX::XMVectorScale(DirectX::XMVectorSubtract(Max, Min), 0.5f);
+
+	// 半分の大きさは行列の回転拡縮成分の絶対値で変換する
+	const DirectX::XMMATRIX M = DirectX::XMLoadFloat4x4(&worldTransform);
+	DirectX::XMVECTOR WorldExtents = DirectX::XMVectorMultiply(DirectX::XMVectorSplatX(Extents), DirectX::XMVectorAbs(M.r[0]));
+	WorldExtents = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatY(Extents), DirectX::XMVectorAbs(M.r[1]), WorldExtents);
+	WorldExtents = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatZ(Extents), DirectX::XMVectorAbs(M.r[2]), WorldExtents);
+
+	DirectX::XMStoreFloat3(&center, DirectX::XMVector3Transform(Center, M));
+	DirectX::XMStoreFloat3(&extents, WorldExtents);
+}
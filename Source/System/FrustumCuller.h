@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+// 判定結果
+enum class CullResult : uint8_t
+{
+	Visible,
+	FrustumCulled,		// 視錐台の外
+	DistanceCulled,		// 描画距離より遠い
+};
+
+// 視錐台カリング
+// ワールド空間の境界ボックスを成分ごとの配列に溜めておき、8個ずつまとめて6平面と描画距離で判定する
+class FrustumCuller
+{
+public:
+	static const size_t BatchSize = 8;	// 1回の判定で処理するボックス数
+	static const size_t CullGrainSize = 64;	// 並列化する際の1ジョブあたりの BatchSize 単位の数
+
+	// ビュープロジェクション行列から視錐台を設定(maxDistance が 0 以下なら距離では判定しない)
+	// projectionScale はプロジェクション行列の _22 (画面サイズの計算に使う)
+	void SetViewProjection(const DirectX::XMFLOAT4X4& viewProjection, const DirectX::XMFLOAT3& eye, float maxDistance, float projectionScale);
+
+	// 判定対象をクリア
+	void Clear();
+
+	// 判定対象のボックス追加(戻り値は結果を取得する際の番号)
+	size_t AddBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents);
+
+	// 追加したボックスをまとめて判定
+	void Cull();
+
+	// 判定結果取得
+	CullResult GetResult(size_t index) const { return results[index]; }
+
+	// 画面サイズ取得(外接球の直径が画面の高さに占める割合)
+	float GetScreenSize(size_t index) const { return screenSizes[index]; }
+
+	// 判定対象のボックス数取得
+	size_t GetCount() const { return count; }
+
+	// ローカル空間の範囲をワールド行列で変換し、それを囲むワールド空間の中心と半分の大きさを求める
+	static void TransformBounds(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax,
+		const DirectX::XMFLOAT4X4& worldTransform, DirectX::XMFLOAT3& center, DirectX::XMFLOAT3& extents);
+
+private:
+	// 境界ボックス(BatchSize 単位で確保し、端数の要素も判定するが結果は使わない)
+	std::vector<float>		centerX;
+	std::vector<float>		centerY;
+	std::vector<float>		centerZ;
+	std::vector<float>		extentX;
+	std::vector<float>		extentY;
+	std::vector<float>		extentZ;
+	std::vector<CullResult>	results;
+	std::vector<float>		screenSizes;
+	size_t					count = 0;
+
+	DirectX::XMFLOAT4		planes[6] = {};		// 内側を向いた正規化済みの平面(左、右、下、上、近、遠)
+	DirectX::XMFLOAT3		eye = { 0, 0, 0 };
+	float					maxDistance = 0.0f;
+	float					projectionScale = 1.0f;
+};
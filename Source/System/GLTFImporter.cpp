@@ -7,6 +7,7 @@
 #include "Misc.h"
 #include "GpuResourceUtils.h"
 #include "GLTFImporter.h"
+#include "JobSystem.h"
 
 bool LoadImageData(tinygltf::Image*, const int, std::string*,
 	std::string*, int, int,
@@ -16,17 +17,17 @@ bool LoadImageData(tinygltf::Image*, const int, std::string*,
 	return true;
 }
 
-// RXgN^
+// コンストラクタ
 GLTFImporter::GLTFImporter(const char* filename)
 	: filepath(filename) 
 {
-	// gq擾
+	// 拡張子取得
 	std::string extension = filepath.extension().string();
-	std::transform(extension.begin(), extension.end(), extension.begin(), tolower);	// 
+	std::transform(extension.begin(), extension.end(), extension.begin(), tolower);	// 小文字化
 
 	tinygltf::TinyGLTF gltf;
 
-	// ɃC[Wǂݍ܂Ȃ悤ɂ
+	// 勝手にイメージを読み込まないようにする
 	gltf.SetImageLoader(LoadImageData, this);
 
 	std::string error, warning;
@@ -52,7 +53,7 @@ GLTFImporter::GLTFImporter(const char* filename)
 	}
 }
 
-// m[hf[^ǂݍ
+// ノードデータを読み込み
 void GLTFImporter::LoadNodes(NodeList& nodes)
 {
 	Model::Node& node = nodes.emplace_back();
@@ -64,7 +65,7 @@ void GLTFImporter::LoadNodes(NodeList& nodes)
 		const tinygltf::Node& gltfNode = gltfModel.nodes.at(gltfNodeIndex);
 		Model::Node& node = nodes.at(gltfNodeIndex);
 
-		// f[^擾
+		// データ取得
 		node.name = gltfNode.name;
 		
 		for (int gltfChildNodeIndex : gltfNode.children)
@@ -98,14 +99,18 @@ void GLTFImporter::LoadNodes(NodeList& nodes)
 				node.position = gltfVector3ToXMFLOAT3(gltfNode.translation);
 			}
 		}
-		// Wnϊ
+		// 座標系変換
 		ConvertNodeAxisSystem(node);
 	}
 }
 
-// bVf[^ǂݍ
+// メッシュデータを読み込み
 void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 {
+	// タンジェント計算と座標系変換はメッシュごとに独立しているので、読み込み後にまとめて並列で行う
+	const size_t firstMeshIndex = meshes.size();
+	std::vector<bool> computeTangents;
+
 	for (int gltfNodeIndex = 0; gltfNodeIndex < gltfModel.nodes.size(); ++gltfNodeIndex)
 	{
 		const tinygltf::Node& gltfNode = gltfModel.nodes.at(gltfNodeIndex);
@@ -119,7 +124,7 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 			mesh.nodeIndex = gltfNodeIndex;
 			mesh.materialIndex = gltfPrimitive.material;
 
-			// {[
+			// ボーン
 			if (gltfNode.skin >= 0)
 			{
 				const tinygltf::Skin& gltfSkin = gltfModel.skins.at(gltfNode.skin);
@@ -135,7 +140,7 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 				}
 			}
 
-			// CfbNXobt@
+			// インデックスバッファ
 			{
 				const tinygltf::Accessor& gltfAccessor = gltfModel.accessors.at(gltfPrimitive.indices);
 				const tinygltf::BufferView& gltfBufferView = gltfModel.bufferViews.at(gltfAccessor.bufferView);
@@ -163,7 +168,7 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 				}
 			}
 
-			// _obt@̈m
+			// 頂点バッファ領域確保
 			{
 				std::map<std::string, int>::const_iterator gltfAttribute = gltfPrimitive.attributes.find("POSITION");
 				_ASSERT_EXPR(gltfAttribute != gltfPrimitive.attributes.end(), "");
@@ -171,7 +176,7 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 				mesh.vertices.resize(gltfAccessor.count);
 			}
 
-			// _obt@
+			// 頂点バッファ
 			for (std::map<std::string, int>::const_reference gltfAttribute : gltfPrimitive.attributes)
 			{
 				const tinygltf::Accessor& gltfAccessor = gltfModel.accessors.at(gltfAttribute.second);
@@ -355,25 +360,37 @@ void GLTFImporter::LoadMeshes(MeshList& meshes, const NodeList& nodes)
 				}
 			}
 
-			// ^WFgȂꍇ͎͂ŌvZ
-			if (gltfPrimitive.attributes.find("TANGENT") == gltfPrimitive.attributes.end() &&
+			// タンジェントがなかった場合は自力で計算
+			computeTangents.push_back(
+				gltfPrimitive.attributes.find("TANGENT") == gltfPrimitive.attributes.end() &&
 				gltfPrimitive.attributes.find("POSITION") != gltfPrimitive.attributes.end() &&
-				gltfPrimitive.attributes.find("TEXCOORD_0") != gltfPrimitive.attributes.end())
+				gltfPrimitive.attributes.find("TEXCOORD_0") != gltfPrimitive.attributes.end());
+		}
+	}
+
+	JobSystem::Instance().ParallelFor(0, computeTangents.size(), 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			Model::Mesh& mesh = meshes.at(firstMeshIndex + i);
+			if (computeTangents[i])
 			{
 				ComputeTangents(mesh.vertices, mesh.indices);
 			}
 
-			// Wnϊ
+			// 座標系変換
 			ConvertMeshAxisSystem(mesh);
-		}
-	}
 
+			// 変換後の頂点座標で範囲を計算
+			mesh.ComputeBounds();
+		}
+	});
 }
 
-// }eAf[^ǂݍ
+// マテリアルデータを読み込み
 void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 {
-	// fBNgpX擾
+	// ディレクトリパス取得
 	std::filesystem::path dirpath(filepath.parent_path());
 
 	for (const tinygltf::Material& gltfMaterial : gltfModel.materials)
@@ -454,24 +471,24 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 				}
 				else
 				{
-					// eNX`t@CpX쐬
+					// テクスチャファイルパス作成
 					std::filesystem::path textureFilePath(gltfImage.uri);
 					if (textureFilePath == "")
 					{
-						// eNX`t@CȂꍇ̓}eAƃeNX`^Cv쐬
+						// テクスチャファイル名がなかった場合はマテリアル名とテクスチャタイプから作成
 						std::string extension(std::filesystem::path(gltfImage.mimeType).filename().string());
 						textureFilePath = material.name + "_" + textureType + "." + extension;
 					}
 					textureFilePath = "Textures" / textureFilePath.filename();
 
-					// ߍ݃eNX`o͂fBNgmF
+					// 埋め込みテクスチャを出力するディレクトリを確認
 					std::filesystem::path outputDirPath(dirpath / textureFilePath.parent_path());
 					if (!std::filesystem::exists(outputDirPath))
 					{
-						// ȂfBNg쐬
+						// なかったらディレクトリ作成
 						std::filesystem::create_directories(outputDirPath);
 					}
-					// o̓fBNgɉ摜t@Cۑ
+					// 出力ディレクトリに画像ファイルを保存
 					std::filesystem::path outputFilePath(dirpath / textureFilePath);
 					if (!std::filesystem::exists(outputFilePath))
 					{
@@ -486,7 +503,7 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 						}
 						else
 						{
-							// jAȉ摜f[^.pngŏo
+							// リニアな画像データは.pngで出力
 							textureFilePath = textureFilePath.replace_extension(".png");
 							stbi_write_png(
 								outputFilePath.string().c_str(),
@@ -496,7 +513,7 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 								gltfImage.image.data(), 0);
 						}
 					}
-					// eNX`t@CpXi[
+					// テクスチャファイルパスを格納
 					textureFilename = textureFilePath.string();
 				}
 			}
@@ -513,7 +530,7 @@ void GLTFImporter::LoadMaterials(MaterialList& materials, ID3D11Device* device)
 	}
 }
 
-// Aj[Vf[^ǂݍ
+// アニメーションデータを読み込み
 void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nodes, float sampleRate)
 {
 	DirectX::XMVECTOR Epsilon = DirectX::XMVectorReplicate(0.00001f);
@@ -529,7 +546,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 		float maxTime = 0;
 		for (const tinygltf::AnimationChannel& gltfAnimationChannel : gltfAnimation.channels)
 		{
-			// m[hAj[Vf[^ǂݎJn
+			// ノードアニメーションデータを読み取り開始
 			Model::NodeAnim& nodeAnim = animation.nodeAnims.at(gltfAnimationChannel.target_node);
 			const tinygltf::AnimationSampler& gltfAnimationSampler = gltfAnimation.samplers.at(gltfAnimationChannel.sampler);
 			const tinygltf::Accessor& gltfInputAccessor = gltfModel.accessors.at(gltfAnimationSampler.input);
@@ -543,7 +560,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 
 			if (gltfAnimationChannel.target_path == "scale")
 			{
-				// L[t[f[^擾
+				// キーフレームデータ取得
 				const DirectX::XMFLOAT3* gltfKeyframeValues = reinterpret_cast<const DirectX::XMFLOAT3*>(gltfModel.buffers.at(gltfOutputBufferView.buffer).data.data() + gltfOutputBufferView.byteOffset + gltfOutputAccessor.byteOffset);
 				for (int i = 0; i < gltfInputAccessor.count; ++i)
 				{
@@ -551,7 +568,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 					keyframe.seconds = gltfKeyframeTimes[i];
 					keyframe.value = gltfKeyframeValues[i];
 				}
-				// L[t[̒lSēȂŏ̃L[t[ȊOȂ
+				// キーフレームの値が全て同じなら最初のキーフレーム以外省く
 				bool result = true;
 				DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&nodeAnim.scaleKeyframes.at(0).value);
 				for (size_t i = 1; i < nodeAnim.scaleKeyframes.size(); ++i)
@@ -570,12 +587,12 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 			}
 			else if (gltfAnimationChannel.target_path == "rotation")
 			{
-				// L[t[f[^擾
+				// キーフレームデータ取得
 				const DirectX::XMFLOAT4* gltfKeyframeValues = reinterpret_cast<const DirectX::XMFLOAT4*>(gltfModel.buffers.at(gltfOutputBufferView.buffer).data.data() + gltfOutputBufferView.byteOffset + gltfOutputAccessor.byteOffset);
 				for (int i = 0; i < gltfInputAccessor.count; ++i)
 				{
-					// ȂUnityŏo͂Aj[Vf[^ɂ̓S~ƎvL[t[݂ĂꍇB
-					// _݂t[iԁjS~f[^ۂ̂ŏOB
+					// なぜかUnityで出力したアニメーションデータにはゴミと思われるキーフレームが存在している場合がある。
+					// 小数点が存在するフレーム（時間）がゴミデータっぽいので除外する。
 					float frame = gltfKeyframeTimes[i] * sampleRate;
 					if (fabs(std::round(frame) - frame) > 0.001) continue;
 
@@ -584,7 +601,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 					keyframe.value = gltfKeyframeValues[i];
 				}
 
-				// L[t[̒lSēȂŏ̃L[t[ȊOȂ
+				// キーフレームの値が全て同じなら最初のキーフレーム以外省く
 				bool result = true;
 				DirectX::XMVECTOR A = DirectX::XMLoadFloat4(&nodeAnim.rotationKeyframes.at(0).value);
 				for (size_t i = 1; i < nodeAnim.rotationKeyframes.size(); ++i)
@@ -603,7 +620,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 			}
 			else if (gltfAnimationChannel.target_path == "translation")
 			{
-				// L[t[f[^擾
+				// キーフレームデータ取得
 				const DirectX::XMFLOAT3* gltfKeyframeValues = reinterpret_cast<const DirectX::XMFLOAT3*>(gltfModel.buffers.at(gltfOutputBufferView.buffer).data.data() + gltfOutputBufferView.byteOffset + gltfOutputAccessor.byteOffset);
 				for (int i = 0; i < gltfInputAccessor.count; ++i)
 				{
@@ -612,7 +629,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 					keyframe.value = gltfKeyframeValues[i];
 				}
 
-				// L[t[̒lSēȂŏ̃L[t[ȊOȂ
+				// キーフレームの値が全て同じなら最初のキーフレーム以外省く
 				bool result = true;
 				DirectX::XMVECTOR A = DirectX::XMLoadFloat3(&nodeAnim.positionKeyframes.at(0).value);
 				for (size_t i = 1; i < nodeAnim.positionKeyframes.size(); ++i)
@@ -631,7 +648,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 			}
 		}
 
-		// 擪L[t[̎Ԃ0Ȃꍇ̂Œ
+		// 先頭キーフレームの時間が0じゃない場合があるので調整する
 		for (Model::NodeAnim& nodeAnim : animation.nodeAnims)
 		{
 			for (Model::VectorKeyframe& keyframe : nodeAnim.positionKeyframes)
@@ -647,18 +664,18 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 				keyframe.seconds -= minTime;
 			}
 		}
-		// Aj[VĐ
+		// アニメーション再生時間
 		animation.secondsLength = maxTime - minTime;
 
-		// Wnϊ
+		// 座標系変換
 		ConvertAnimationAxisSystem(animation);
 
-		// Aj[VȂm[hɑ΂ďp̃L[t[ǉ
+		// アニメーションがなかったノードに対して初期姿勢のキーフレームを追加する
 		for (size_t nodeIndex = 0; nodeIndex < animation.nodeAnims.size(); ++nodeIndex)
 		{
 			const Model::Node& node = nodes.at(nodeIndex);
 			Model::NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
-			// ړ
+			// 移動
 			if (nodeAnim.positionKeyframes.size() == 0)
 			{
 				Model::VectorKeyframe& keyframe = nodeAnim.positionKeyframes.emplace_back();
@@ -671,7 +688,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 				keyframe.seconds = animation.secondsLength;
 				keyframe.value = nodeAnim.positionKeyframes.at(0).value;
 			}
-			// ]
+			// 回転
 			if (nodeAnim.rotationKeyframes.size() == 0)
 			{
 				Model::QuaternionKeyframe& keyframe = nodeAnim.rotationKeyframes.emplace_back();
@@ -684,7 +701,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 				keyframe.seconds = animation.secondsLength;
 				keyframe.value = nodeAnim.rotationKeyframes.at(0).value;
 			}
-			// XP[
+			// スケール
 			if (nodeAnim.scaleKeyframes.size() == 0)
 			{
 				Model::VectorKeyframe& keyframe = nodeAnim.scaleKeyframes.emplace_back();
@@ -701,7 +718,7 @@ void GLTFImporter::LoadAnimations(AnimationList& animations, const NodeList& nod
 	}
 }
 
-// gltfVector3  XMFLOAT3
+// gltfVector3 → XMFLOAT3
 DirectX::XMFLOAT3 GLTFImporter::gltfVector3ToXMFLOAT3(const std::vector<double>& gltfValue)
 {
 	return DirectX::XMFLOAT3(
@@ -711,7 +728,7 @@ DirectX::XMFLOAT3 GLTFImporter::gltfVector3ToXMFLOAT3(const std::vector<double>&
 	);
 }
 
-// gltfQuaternion  XMFLOAT4
+// gltfQuaternion → XMFLOAT4
 DirectX::XMFLOAT4 GLTFImporter::gltfQuaternionToXMFLOAT4(const std::vector<double>& gltfValue)
 {
 	return DirectX::XMFLOAT4(
@@ -722,7 +739,7 @@ DirectX::XMFLOAT4 GLTFImporter::gltfQuaternionToXMFLOAT4(const std::vector<doubl
 	);
 }
 
-// gltfMatrix  XMFLOAT4X4
+// gltfMatrix → XMFLOAT4X4
 DirectX::XMFLOAT4X4 GLTFImporter::gltfMatrixToXMFLOAT4X4(const std::vector<double>& gltfValue)
 {
 	return DirectX::XMFLOAT4X4(
@@ -745,7 +762,7 @@ DirectX::XMFLOAT4X4 GLTFImporter::gltfMatrixToXMFLOAT4X4(const std::vector<doubl
 	);
 }
 
-// Wnϊ
+// 座標系変換
 void GLTFImporter::ConvertPositionAxisSystem(DirectX::XMFLOAT3& v)
 {
 	v.x = -v.x;
@@ -815,7 +832,7 @@ void GLTFImporter::ConvertAnimationAxisSystem(Model::Animation& animation)
 	}
 }
 
-// ^WFgvZ
+// タンジェント計算
 void GLTFImporter::ComputeTangents(std::vector<Model::Vertex>& vertices, const std::vector<uint32_t>& indices)
 {
 	size_t vertexCount = vertices.size();
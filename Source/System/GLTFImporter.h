@@ -16,29 +16,29 @@ private:
 public:
 	GLTFImporter(const char* filename);
 
-	// m[hf[^ǂݍ
+	// ノードデータを読み込み
 	void LoadNodes(NodeList& nodes);
 
-	// bVf[^ǂݍ
+	// メッシュデータを読み込み
 	void LoadMeshes(MeshList& meshes, const NodeList& nodes);
 
-	// }eAf[^ǂݍ
+	// マテリアルデータを読み込み
 	void LoadMaterials(MaterialList& materials, ID3D11Device* device = nullptr);
 
-	// Aj[Vf[^ǂݍ
+	// アニメーションデータを読み込み
 	void LoadAnimations(AnimationList& animations, const NodeList& nodes, float sampleRate = 60);
 
 private:
-	// gltfVector3  XMFLOAT3
+	// gltfVector3 → XMFLOAT3
 	static DirectX::XMFLOAT3 gltfVector3ToXMFLOAT3(const std::vector<double>& gltfValue);
 
-	// gltfQuaternion  XMFLOAT4
+	// gltfQuaternion → XMFLOAT4
 	static DirectX::XMFLOAT4 gltfQuaternionToXMFLOAT4(const std::vector<double>& gltfValue);
 
-	// gltfMatrix  XMFLOAT4X4
+	// gltfMatrix → XMFLOAT4X4
 	static DirectX::XMFLOAT4X4 gltfMatrixToXMFLOAT4X4(const std::vector<double>& gltfValue);
 
-	// Wnϊ
+	// 座標系変換
 	static void ConvertPositionAxisSystem(DirectX::XMFLOAT3& v);
 	static void ConvertPositionAxisSystem(DirectX::XMFLOAT4& v);
 	static void ConvertRotationAxisSystem(DirectX::XMFLOAT4& q);
@@ -47,7 +47,7 @@ private:
 	static void ConvertMeshAxisSystem(Model::Mesh& mesh);
 	static void ConvertAnimationAxisSystem(Model::Animation& animation);
 
-	// ^WFgvZ
+	// タンジェント計算
 	static void ComputeTangents(std::vector<Model::Vertex>& vertices, const std::vector<uint32_t>& indices);
 
 private:
@@ -2,7 +2,7 @@
 
 using GamePadButton = unsigned int;
 
-// Q[pbh
+// ゲームパッド
 class GamePad
 {
 public:
@@ -27,37 +27,37 @@ public:
 	GamePad() {}
 	~GamePad() {}
 
-	// XV
+	// 更新
 	void Update();
 
-	// Xbgݒ
+	// スロット設定
 	void SetSlot(int slot) { this->slot = slot; }
 
-	// {^͏Ԃ̎擾
+	// ボタン入力状態の取得
 	GamePadButton GetButton() const { return buttonState[0]; }
 
-	// {^Ԃ̎擾
+	// ボタン押下状態の取得
 	GamePadButton GetButtonDown() const { return buttonDown; }
 
-	// {^Ԃ̎擾
+	// ボタン押上状態の取得
 	GamePadButton GetButtonUp() const { return buttonUp; }
 
-	// XeBbNX͏Ԃ̎擾
+	// 左スティックX軸入力状態の取得
 	float GetAxisLX() const { return axisLx; }
 
-	// XeBbNY͏Ԃ̎擾
+	// 左スティックY軸入力状態の取得
 	float GetAxisLY() const { return axisLy; }
 
-	// EXeBbNX͏Ԃ̎擾
+	// 右スティックX軸入力状態の取得
 	float GetAxisRX() const { return axisRx; }
 
-	// EXeBbNY͏Ԃ̎擾
+	// 右スティックY軸入力状態の取得
 	float GetAxisRY() const { return axisRy; }
 
-	// gK[͏Ԃ̎擾
+	// 左トリガー入力状態の取得
 	float GetTriggerL() const { return triggerL; }
 
-	// EgK[͏Ԃ̎擾
+	// 右トリガー入力状態の取得
 	float GetTriggerR() const { return triggerR; }
 
 private:
@@ -3,8 +3,9 @@
 #include <DirectXTex.h>
 #include "Misc.h"
 #include "GpuResourceUtils.h"
+#include "ShaderCache.h"
 
-// _VF[_[ǂݍ
+// 頂点シェーダー読み込み
 HRESULT GpuResourceUtils::LoadVertexShader(
 	ID3D11Device* device,
 	const char* filename,
@@ -13,81 +14,74 @@ HRESULT GpuResourceUtils::LoadVertexShader(
 	ID3D11InputLayout** inputLayout,
 	ID3D11VertexShader** vertexShader)
 {
-	// t@CJ
-	FILE* fp = nullptr;
-	fopen_s(&fp, filename, "rb");
 	OutputDebugStringA(filename);
 	OutputDebugStringA("\n");
-	_ASSERT_EXPR_A(fp, "Vertex Shader File not found");
 
-	// t@C̃TCY߂
-	fseek(fp, 0, SEEK_END);
-	long size = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
+	// バイトコードとシェーダーはキャッシュから取り出す(同じファイルのシェーダーは共有する)
+	ShaderCache& shaderCache = ShaderCache::Instance();
+	const std::vector<uint8_t>* bytecode = shaderCache.GetBytecode(filename);
+	_ASSERT_EXPR_A(bytecode, "Vertex Shader File not found");
+	if (bytecode == nullptr) return E_FAIL;
 
-	// ɒ_VF[_[f[^i[̈pӂ
-	std::unique_ptr<u_char[]> data = std::make_unique<u_char[]>(size);
-	fread(data.get(), size, 1, fp);
-	fclose(fp);
+	*vertexShader = shaderCache.GetVertexShader(device, filename);
+	if (*vertexShader == nullptr) return E_FAIL;
+	(*vertexShader)->AddRef();
 
-	// _VF[_[
-	HRESULT hr = device->CreateVertexShader(data.get(), size, nullptr, vertexShader);
-	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-
-	// ̓CAEg
+	// 入力レイアウト
+	HRESULT hr = S_OK;
 	if (inputLayout != nullptr)
 	{
-		hr = device->CreateInputLayout(inputElementDescs, inputElementCount, data.get(), size, inputLayout);
+		hr = device->CreateInputLayout(inputElementDescs, inputElementCount, bytecode->data(), bytecode->size(), inputLayout);
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
 	return hr;
 }
 
-// sNZVF[_[ǂݍ
+// ピクセルシェーダー読み込み
 HRESULT GpuResourceUtils::LoadPixelShader(
 	ID3D11Device* device,
 	const char* filename,
 	ID3D11PixelShader** pixelShader)
 {
-	// t@CJ
-	FILE* fp = nullptr;
-	fopen_s(&fp, filename, "rb");
-	_ASSERT_EXPR_A(fp, "Pixel Shader File not found");
-
-	// t@C̃TCY߂
-	fseek(fp, 0, SEEK_END);
-	long size = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
-
-	// ɒ_VF[_[f[^i[̈pӂ
-	std::unique_ptr<u_char[]> data = std::make_unique<u_char[]>(size);
-	fread(data.get(), size, 1, fp);
-	fclose(fp);
-
-	// sNZVF[_[
-	HRESULT hr = device->CreatePixelShader(data.get(), size, nullptr, pixelShader);
-	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	*pixelShader = ShaderCache::Instance().GetPixelShader(device, filename);
+	_ASSERT_EXPR_A(*pixelShader, "Pixel Shader File not found");
+	if (*pixelShader == nullptr) return E_FAIL;
+	(*pixelShader)->AddRef();
 
-	return hr;
+	return S_OK;
+}
+
+// コンピュートシェーダー読み込み
+HRESULT GpuResourceUtils::LoadComputeShader(
+	ID3D11Device* device,
+	const char* filename,
+	ID3D11ComputeShader** computeShader)
+{
+	*computeShader = ShaderCache::Instance().GetComputeShader(device, filename);
+	_ASSERT_EXPR_A(*computeShader, "Compute Shader File not found");
+	if (*computeShader == nullptr) return E_FAIL;
+	(*computeShader)->AddRef();
+
+	return S_OK;
 }
 
-// eNX`ǂݍ
+// テクスチャ読み込み
 HRESULT GpuResourceUtils::LoadTexture(
 	ID3D11Device* device,
 	const wchar_t* filename,
 	ID3D11ShaderResourceView** shaderResourceView,
 	D3D11_TEXTURE2D_DESC* texture2dDesc)
 {
-	// gq擾
+	// 拡張子を取得
 	std::filesystem::path filepath(filename);
 	std::string extension = filepath.extension().string();
-	std::transform(extension.begin(), extension.end(), extension.begin(), tolower);	// 
+	std::transform(extension.begin(), extension.end(), extension.begin(), tolower);	// 小文字化
 
-	// Chɕϊ
+	// ワイド文字に変換
 	std::wstring wfilename = filepath.wstring();
 
-	// tH[}bgɉ摜ǂݍݏ
+	// フォーマット毎に画像読み込み処理
 	HRESULT hr;
 	DirectX::TexMetadata metadata;
 	DirectX::ScratchImage scratch_image;
@@ -124,12 +118,12 @@ HRESULT GpuResourceUtils::LoadTexture(
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// VF[_[\[Xr[쐬
+	// シェーダーリソースビュー作成
 	hr = DirectX::CreateShaderResourceView(device, scratch_image.GetImages(), scratch_image.GetImageCount(),
 		metadata, shaderResourceView);
 	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
-	// eNX`擾
+	// テクスチャ情報取得
 	if (texture2dDesc != nullptr)
 	{
 		Microsoft::WRL::ComPtr<ID3D11Resource> resource;
@@ -149,15 +143,15 @@ HRESULT GpuResourceUtils::LoadTexture(
 	ID3D11ShaderResourceView** shaderResourceView,
 	D3D11_TEXTURE2D_DESC* texture2dDesc)
 {
-	// gq擾
+	// 拡張子を取得
 	std::filesystem::path filepath(filename);
 	std::string extension = filepath.extension().string();
-	std::transform(extension.begin(), extension.end(), extension.begin(), tolower);	// 
+	std::transform(extension.begin(), extension.end(), extension.begin(), tolower);	// 小文字化
 
-	// Chɕϊ
+	// ワイド文字に変換
 	std::wstring wfilename = filepath.wstring();
 
-	// tH[}bgɉ摜ǂݍݏ
+	// フォーマット毎に画像読み込み処理
 	HRESULT hr;
 	DirectX::TexMetadata metadata;
 	DirectX::ScratchImage scratch_image;
@@ -194,12 +188,12 @@ HRESULT GpuResourceUtils::LoadTexture(
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// VF[_[\[Xr[쐬
+	// シェーダーリソースビュー作成
 	hr = DirectX::CreateShaderResourceView(device, scratch_image.GetImages(), scratch_image.GetImageCount(),
 		metadata, shaderResourceView);
 	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
-	// eNX`擾
+	// テクスチャ情報取得
 	if (texture2dDesc != nullptr)
 	{
 		Microsoft::WRL::ComPtr<ID3D11Resource> resource;
@@ -214,7 +208,7 @@ HRESULT GpuResourceUtils::LoadTexture(
 }
 
 
-// eNX`ǂݍ
+// テクスチャ読み込み
 HRESULT GpuResourceUtils::LoadTexture(
 	ID3D11Device* device,
 	const void* data,
@@ -222,7 +216,7 @@ HRESULT GpuResourceUtils::LoadTexture(
 	ID3D11ShaderResourceView** shaderResourceView,
 	D3D11_TEXTURE2D_DESC* texture2dDesc)
 {
-	// tH[}bgɉ摜ǂݍݏ
+	// フォーマット毎に画像読み込み処理
 	HRESULT hr = E_FAIL;
 	DirectX::TexMetadata metadata;
 	DirectX::ScratchImage scratch_image;
@@ -266,12 +260,12 @@ HRESULT GpuResourceUtils::LoadTexture(
 		return hr;
 	}
 
-	// VF[_[\[Xr[쐬
+	// シェーダーリソースビュー作成
 	hr = DirectX::CreateShaderResourceView(device, scratch_image.GetImages(), scratch_image.GetImageCount(),
 		metadata, shaderResourceView);
 	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
-	// eNX`擾
+	// テクスチャ情報取得
 	if (texture2dDesc != nullptr)
 	{
 		Microsoft::WRL::ComPtr<ID3D11Resource> resource;
@@ -285,7 +279,7 @@ HRESULT GpuResourceUtils::LoadTexture(
 	return hr;
 }
 
-// _~[eNX`쐬
+// ダミーテクスチャ作成
 HRESULT GpuResourceUtils::CreateDummyTexture(
 	ID3D11Device* device,
 	UINT color,
@@ -315,7 +309,7 @@ HRESULT GpuResourceUtils::CreateDummyTexture(
 	hr = device->CreateShaderResourceView(texture.Get(), nullptr, shaderResourceView);
 	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
-	// eNX`擾
+	// テクスチャ情報取得
 	if (texture2dDesc != nullptr)
 	{
 		Microsoft::WRL::ComPtr<ID3D11Resource> resource;
@@ -330,7 +324,7 @@ HRESULT GpuResourceUtils::CreateDummyTexture(
 	return hr;
 }
 
-// 萔obt@쐬
+// 定数バッファ作成
 HRESULT GpuResourceUtils::CreateConstantBuffer(
 	ID3D11Device* device,
 	UINT bufferSize,
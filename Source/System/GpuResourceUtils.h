@@ -2,11 +2,11 @@
 
 #include <d3d11.h>
 
-// GPU\[X[eBeB
+// GPUリソースユーティリティ
 class GpuResourceUtils
 {
 public:
-	// _VF[_[ǂݍ
+	// 頂点シェーダー読み込み
 	static HRESULT LoadVertexShader(
 		ID3D11Device* device,
 		const char* filename,
@@ -15,13 +15,19 @@ public:
 		ID3D11InputLayout** inputLayout,
 		ID3D11VertexShader** vertexShader);
 
-	// sNZVF[_[ǂݍ
+	// ピクセルシェーダー読み込み
 	static HRESULT LoadPixelShader(
 		ID3D11Device* device,
 		const char* filename,
 		ID3D11PixelShader** pixelShader);
 
-	// eNX`ǂݍ
+	// コンピュートシェーダー読み込み
+	static HRESULT LoadComputeShader(
+		ID3D11Device* device,
+		const char* filename,
+		ID3D11ComputeShader** computeShader);
+
+	// テクスチャ読み込み
 	static HRESULT LoadTexture(
 		ID3D11Device* device,
 		const wchar_t* filename,
@@ -34,7 +40,7 @@ public:
 		ID3D11ShaderResourceView** shaderResourceView,
 		D3D11_TEXTURE2D_DESC* texture2dDesc = nullptr);
 
-	// eNX`ǂݍ
+	// テクスチャ読み込み
 	static HRESULT LoadTexture(
 		ID3D11Device* device,
 		const void* data,
@@ -42,14 +48,14 @@ public:
 		ID3D11ShaderResourceView** shaderResourceView,
 		D3D11_TEXTURE2D_DESC* texture2dDesc = nullptr);
 
-	// _~[eNX`쐬
+	// ダミーテクスチャ作成
 	static HRESULT CreateDummyTexture(
 		ID3D11Device* device,
 		UINT color,
 		ID3D11ShaderResourceView** shaderResourceView,
 		D3D11_TEXTURE2D_DESC* texture2dDesc = nullptr);
 
-	// 萔obt@쐬
+	// 定数バッファ作成
 	static HRESULT CreateConstantBuffer(
 		ID3D11Device* device,
 		UINT bufferSize,
@@ -1,11 +1,11 @@
 #include "Misc.h"
 #include "Graphics.h"
 
-// 
+// 初期化
 void Graphics::Initialize(HWND hWnd)
 {
 	this->hWnd = hWnd;
-	// ʂ̃TCY擾B
+	// 画面のサイズを取得する。
 	RECT rc;
 	GetClientRect(hWnd, &rc);
 	UINT screenWidth = rc.right - rc.left;
@@ -16,7 +16,7 @@ void Graphics::Initialize(HWND hWnd)
 
 	HRESULT hr = S_OK;
 
-	// foCXXbv`F[̐
+	// デバイス＆スワップチェーンの生成
 	{
 		UINT createDeviceFlags = 0;
 #if defined(DEBUG) || defined(_DEBUG)
@@ -32,7 +32,7 @@ void Graphics::Initialize(HWND hWnd)
 			D3D_FEATURE_LEVEL_9_1,
 		};
 
-		// Xbv`F[쐬邽߂̐ݒIvV
+		// スワップチェーンを作成するための設定オプション
 		DXGI_SWAP_CHAIN_DESC swapchainDesc;
 		{
 			swapchainDesc.BufferDesc.Width = screenWidth;
@@ -54,7 +54,7 @@ void Graphics::Initialize(HWND hWnd)
 
 		D3D_FEATURE_LEVEL featureLevel;
 
-		// foCXXbv`F[̐
+		// デバイス＆スワップチェーンの生成
 		hr = D3D11CreateDeviceAndSwapChain(
 			nullptr,
 			D3D_DRIVER_TYPE_HARDWARE,
@@ -72,10 +72,10 @@ void Graphics::Initialize(HWND hWnd)
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// _[^[Qbgr[̐
+	// レンダーターゲットビューの生成
 	{
-		// Xbv`F[obNobt@eNX`擾B
-		// Xbv`F[ɓĂobNobt@eNX`'F'ރeNX`B
+		// スワップチェーンからバックバッファテクスチャを取得する。
+		// ※スワップチェーンに内包されているバックバッファテクスチャは'色'を書き込むテクスチャ。
 		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture2d;
 		hr = swapchain->GetBuffer(
 			0,
@@ -83,14 +83,14 @@ void Graphics::Initialize(HWND hWnd)
 			reinterpret_cast<void**>(texture2d.GetAddressOf()));
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
-		// obNobt@eNX`ւ݂̏̑ƂȂ郌_[^[Qbgr[𐶐B
+		// バックバッファテクスチャへの書き込みの窓口となるレンダーターゲットビューを生成する。
 		hr = device->CreateRenderTargetView(texture2d.Get(), nullptr, renderTargetView.GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// [xXeVr[̐
+	// 深度ステンシルビューの生成
 	{
-		// [xXeVނ߂̃eNX`쐬B
+		// 深度ステンシル情報を書き込むためのテクスチャを作成する。
 		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture2d;
 		D3D11_TEXTURE2D_DESC texture2dDesc;
 		texture2dDesc.Width = screenWidth;
@@ -104,15 +104,36 @@ void Graphics::Initialize(HWND hWnd)
 		texture2dDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
 		texture2dDesc.CPUAccessFlags = 0;
 		texture2dDesc.MiscFlags = 0;
+
+		// 遮蔽判定(Hi-Z)で深度を読めるように、対応していればシェーダーリソースとしても作る
+		const bool readableDepth = device->GetFeatureLevel() >= D3D_FEATURE_LEVEL_10_0;
+		if (readableDepth)
+		{
+			texture2dDesc.Format = DXGI_FORMAT_R24G8_TYPELESS;
+			texture2dDesc.BindFlags |= D3D11_BIND_SHADER_RESOURCE;
+		}
 		hr = device->CreateTexture2D(&texture2dDesc, nullptr, texture2d.GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
-		// [xXeVeNX`ւ݂̏ɑɂȂ[xXeVr[쐬B
-		hr = device->CreateDepthStencilView(texture2d.Get(), nullptr, depthStencilView.GetAddressOf());
+		// 深度ステンシルテクスチャへの書き込みに窓口になる深度ステンシルビューを作成する。
+		D3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc{};
+		depthStencilViewDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+		depthStencilViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+		hr = device->CreateDepthStencilView(texture2d.Get(), &depthStencilViewDesc, depthStencilView.GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+		if (readableDepth)
+		{
+			D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDesc{};
+			shaderResourceViewDesc.Format = DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+			shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+			shaderResourceViewDesc.Texture2D.MipLevels = 1;
+			hr = device->CreateShaderResourceView(texture2d.Get(), &shaderResourceViewDesc, depthShaderResourceView.GetAddressOf());
+			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+		}
 	}
 
-	// r[|[g
+	// ビューポート
 	{
 		viewport.Width = static_cast<float>(screenWidth);
 		viewport.Height = static_cast<float>(screenHeight);
@@ -122,17 +143,19 @@ void Graphics::Initialize(HWND hWnd)
 		viewport.TopLeftY = 0.0f;
 	}
 
-	// _[Xe[g
+	// レンダーステート生成
 	renderState = std::make_unique<RenderState>(device.Get());
 
-	// _
-	primitiveRenderer = std::make_unique<PrimitiveRenderer>(device.Get());
-	shapeRenderer = std::make_unique<ShapeRenderer>(device.Get());
+	// レンダラ生成(デバッグ表示の頂点は1つのリングバッファで共有する)
+	transientVertexBuffer = std::make_unique<TransientVertexBuffer>(device.Get());
+	primitiveRenderer = std::make_unique<PrimitiveRenderer>(device.Get(), transientVertexBuffer.get());
+	shapeRenderer = std::make_unique<ShapeRenderer>(device.Get(), transientVertexBuffer.get());
 	modelRenderer = std::make_unique<ModelRenderer>(device.Get());
+	spriteBatch = std::make_unique<SpriteBatch>(device.Get());
 
 }
 
-// NA
+// クリア
 void Graphics::Clear(float r, float g, float b, float a)
 {
 	float color[4]{ r, g, b, a };
@@ -140,14 +163,14 @@ void Graphics::Clear(float r, float g, float b, float a)
 	immediateContext->ClearDepthStencilView(depthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 }
 
-// _[^[Qbgݒ
+// レンダーターゲット設定
 void Graphics::SetRenderTargets()
 {
 	immediateContext->RSSetViewports(1, &viewport);
 	immediateContext->OMSetRenderTargets(1, renderTargetView.GetAddressOf(), depthStencilView.Get());
 }
 
-// ʕ\
+// 画面表示
 void Graphics::Present(UINT syncInterval)
 {
 	swapchain->Present(syncInterval, 0);
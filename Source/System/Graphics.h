@@ -7,9 +7,10 @@
 #include "PrimitiveRenderer.h"
 #include "ShapeRenderer.h"
 #include "ModelRenderer.h"
+#include "SpriteBatch.h"
 #include <mutex>
 
-// OtBbNX
+// グラフィックス
 class Graphics
 {
 private:
@@ -17,52 +18,61 @@ private:
 	~Graphics() = default;
 
 public:
-	// CX^X擾
+	// インスタンス取得
 	static Graphics& Instance()
 	{
 		static Graphics instance;
 		return instance;
 	}
 
-	// 
+	// 初期化
 	void Initialize(HWND hWnd);
 
-	// NA
+	// クリア
 	void Clear(float r, float g, float b, float a);
 
-	// _[^[Qbgݒ
+	// レンダーターゲット設定
 	void SetRenderTargets();
 
-	// ʕ\
+	// 画面表示
 	void Present(UINT syncInterval);
 
-	// EChEnh擾
+	// ウインドウハンドル取得
 	HWND GetWindowHandle() { return hWnd; }
 
-	// foCX擾
+	// デバイス取得
 	ID3D11Device* GetDevice() { return device.Get(); }
 
-	// foCXReLXg擾
+	// デバイスコンテキスト取得
 	ID3D11DeviceContext* GetDeviceContext() { return immediateContext.Get(); }
 
-	// XN[擾
+	// スクリーン幅取得
 	float GetScreenWidth() const { return screenWidth; }
 
-	// XN[擾
+	// スクリーン高さ取得
 	float GetScreenHeight() const { return screenHeight; }
 
-	// _[Xe[g擾
+	// 深度バッファのシェーダーリソースビュー取得(読めない環境では nullptr)
+	ID3D11ShaderResourceView* GetDepthShaderResourceView() const { return depthShaderResourceView.Get(); }
+
+	// レンダーステート取得
 	RenderState* GetRenderState() { return renderState.get(); }
 
-	// v~eBu_擾
+	// 使い捨て頂点バッファ取得
+	TransientVertexBuffer* GetTransientVertexBuffer() const { return transientVertexBuffer.get(); }
+
+	// プリミティブレンダラ取得
 	PrimitiveRenderer* GetPrimitiveRenderer() const { return primitiveRenderer.get(); }
 
-	// VFCv_擾
+	// シェイプレンダラ取得
 	ShapeRenderer* GetShapeRenderer() const { return shapeRenderer.get(); }
 
-	// f_擾
+	// モデルレンダラ取得
 	ModelRenderer* GetModelRenderer() const { return modelRenderer.get(); }
 
+	// スプライトバッチ取得
+	SpriteBatch* GetSpriteBatch() const { return spriteBatch.get(); }
+
 	std::mutex& GetMutex() { return mutex; }
 
 private:
@@ -72,15 +82,18 @@ private:
 	Microsoft::WRL::ComPtr<IDXGISwapChain>			swapchain;
 	Microsoft::WRL::ComPtr<ID3D11RenderTargetView>	renderTargetView;
 	Microsoft::WRL::ComPtr<ID3D11DepthStencilView>	depthStencilView;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	depthShaderResourceView;
 	D3D11_VIEWPORT									viewport;
 
 	float	screenWidth = 0;
 	float	screenHeight = 0;
 
 	std::unique_ptr<RenderState>					renderState;
+	std::unique_ptr<TransientVertexBuffer>			transientVertexBuffer;
 	std::unique_ptr<PrimitiveRenderer>				primitiveRenderer;
 	std::unique_ptr<ShapeRenderer>					shapeRenderer;
 	std::unique_ptr<ModelRenderer>					modelRenderer;
+	std::unique_ptr<SpriteBatch>					spriteBatch;
 
 	std::mutex mutex;
 };
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include "Misc.h"
+#include "GpuResourceUtils.h"
+#include "System/HiZBuffer.h"
+
+// コンストラクタ
+HiZBuffer::HiZBuffer(ID3D11Device* device)
+	: device(device)
+{
+	GpuResourceUtils::LoadComputeShader(device, "Data/Shader/HiZBuildCS.cso", buildShader.GetAddressOf());
+	GpuResourceUtils::LoadComputeShader(device, "Data/Shader/OcclusionTestCS.cso", testShader.GetAddressOf());
+
+	GpuResourceUtils::CreateConstantBuffer(device, sizeof(CbHiZBuild), buildConstantBuffer.GetAddressOf());
+	GpuResourceUtils::CreateConstantBuffer(device, sizeof(CbOcclusionTest), testConstantBuffer.GetAddressOf());
+}
+
+// コンピュートシェーダーと深度バッファの読み込みに対応しているか
+bool HiZBuffer::IsSupported(ID3D11Device* device)
+{
+	// cs_5_0 と深度バッファのシェーダーリソースビュー
+	return device->GetFeatureLevel() >= D3D_FEATURE_LEVEL_11_0;
+}
+
+// ミップを作り直す
+void HiZBuffer::Resize(UINT width, UINT height)
+{
+	if (width == this->width && height == this->height) return;
+	this->width = width;
+	this->height = height;
+
+	// level 0 は深度バッファの半分(端数は切り上げ)で、1x1 まで続ける
+	const UINT baseWidth = (std::max)((width + 1) / 2, 1u);
+	const UINT baseHeight = (std::max)((height + 1) / 2, 1u);
+	mipCount = 1;
+	for (UINT w = baseWidth, h = baseHeight; w > 1 || h > 1; ++mipCount)
+	{
+		w = (std::max)((w + 1) / 2, 1u);
+		h = (std::max)((h + 1) / 2, 1u);
+	}
+
+	D3D11_TEXTURE2D_DESC textureDesc{};
+	textureDesc.Width = baseWidth;
+	textureDesc.Height = baseHeight;
+	textureDesc.MipLevels = mipCount;
+	textureDesc.ArraySize = 1;
+	textureDesc.Format = DXGI_FORMAT_R32_FLOAT;
+	textureDesc.SampleDesc.Count = 1;
+	textureDesc.SampleDesc.Quality = 0;
+	textureDesc.Usage = D3D11_USAGE_DEFAULT;
+	textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+	HRESULT hr = device->CreateTexture2D(&textureDesc, nullptr, texture.ReleaseAndGetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
+	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.MipLevels = mipCount;
+	hr = device->CreateShaderResourceView(texture.Get(), &srvDesc, shaderResourceView.ReleaseAndGetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	// 縮小は1つ前のミップを読み、次のミップに書き込む
+	mipShaderResourceViews.resize(mipCount);
+	mipUnorderedAccessViews.resize(mipCount);
+	for (UINT mip = 0; mip < mipCount; ++mip)
+	{
+		srvDesc.Texture2D.MostDetailedMip = mip;
+		srvDesc.Texture2D.MipLevels = 1;
+		hr = device->CreateShaderResourceView(texture.Get(), &srvDesc, mipShaderResourceViews[mip].ReleaseAndGetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc{};
+		uavDesc.Format = DXGI_FORMAT_R32_FLOAT;
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
+		uavDesc.Texture2D.MipSlice = mip;
+		hr = device->CreateUnorderedAccessView(texture.Get(), &uavDesc, mipUnorderedAccessViews[mip].ReleaseAndGetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+}
+
+// 深度バッファからミップを作る
+void HiZBuffer::Build(ID3D11DeviceContext* dc, ID3D11ShaderResourceView* depthShaderResourceView, UINT width, UINT height)
+{
+	Resize(width, height);
+
+	// 深度バッファを書き込み先から外す(書き込み先のままではシェーダーリソースとして設定できない)
+	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> savedRenderTargetView;
+	Microsoft::WRL::ComPtr<ID3D11DepthStencilView> savedDepthStencilView;
+	dc->OMGetRenderTargets(1, savedRenderTargetView.GetAddressOf(), savedDepthStencilView.GetAddressOf());
+	ID3D11RenderTargetView* rtv = savedRenderTargetView.Get();
+	dc->OMSetRenderTargets(rtv ? 1 : 0, rtv ? &rtv : nullptr, nullptr);
+
+	dc->CSSetShader(buildShader.Get(), nullptr, 0);
+	dc->CSSetConstantBuffers(0, 1, buildConstantBuffer.GetAddressOf());
+
+	UINT sourceWidth = width, sourceHeight = height;
+	UINT destinationWidth = (std::max)((width + 1) / 2, 1u), destinationHeight = (std::max)((height + 1) / 2, 1u);
+	for (UINT mip = 0; mip < mipCount; ++mip)
+	{
+		CbHiZBuild cbHiZBuild{};
+		cbHiZBuild.sourceSize[0] = sourceWidth;
+		cbHiZBuild.sourceSize[1] = sourceHeight;
+		cbHiZBuild.destinationSize[0] = destinationWidth;
+		cbHiZBuild.destinationSize[1] = destinationHeight;
+		dc->UpdateSubresource(buildConstantBuffer.Get(), 0, nullptr, &cbHiZBuild, 0, 0);
+
+		// level 0 は深度バッファから、それ以降は1つ前のミップから縮小する
+		ID3D11ShaderResourceView* source = mip == 0 ? depthShaderResourceView : mipShaderResourceViews[mip - 1].Get();
+		dc->CSSetShaderResources(0, 1, &source);
+		dc->CSSetUnorderedAccessViews(0, 1, mipUnorderedAccessViews[mip].GetAddressOf(), nullptr);
+		dc->Dispatch(
+			(destinationWidth + BuildGroupSize - 1) / BuildGroupSize,
+			(destinationHeight + BuildGroupSize - 1) / BuildGroupSize,
+			1);
+
+		// 次のミップで読めるように書き込み先から外す
+		ID3D11ShaderResourceView* nullSrvs[] = { nullptr };
+		ID3D11UnorderedAccessView* nullUavs[] = { nullptr };
+		dc->CSSetShaderResources(0, _countof(nullSrvs), nullSrvs);
+		dc->CSSetUnorderedAccessViews(0, _countof(nullUavs), nullUavs, nullptr);
+
+		sourceWidth = destinationWidth;
+		sourceHeight = destinationHeight;
+		destinationWidth = (std::max)((destinationWidth + 1) / 2, 1u);
+		destinationHeight = (std::max)((destinationHeight + 1) / 2, 1u);
+	}
+
+	ID3D11Buffer* nullCbs[] = { nullptr };
+	dc->CSSetConstantBuffers(0, _countof(nullCbs), nullCbs);
+	dc->CSSetShader(nullptr, nullptr, 0);
+
+	dc->OMSetRenderTargets(rtv ? 1 : 0, rtv ? &rtv : nullptr, savedDepthStencilView.Get());
+}
+
+// 判定対象をクリア
+void HiZBuffer::ClearBoxes()
+{
+	boxes.clear();
+}
+
+// 判定対象のボックス追加
+size_t HiZBuffer::AddBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents)
+{
+	Box& box = boxes.emplace_back();
+	box.center = center;
+	box.pad0 = 0.0f;
+	box.extents = extents;
+	box.pad1 = 0.0f;
+	return boxes.size() - 1;
+}
+
+// 判定対象のバッファを count 個以上入る大きさで作り直す
+void HiZBuffer::ReserveBoxes(UINT count)
+{
+	if (count <= boxCapacity) return;
+
+	// 足りなくなるたびに作り直さないよう、倍々で増やす
+	boxCapacity = (std::max)(count, (std::max)(boxCapacity * 2, TestGroupSize));
+
+	D3D11_BUFFER_DESC bufferDesc{};
+	bufferDesc.ByteWidth = sizeof(Box) * boxCapacity;
+	bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	bufferDesc.StructureByteStride = sizeof(Box);
+	HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, boxBuffer.ReleaseAndGetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+	srvDesc.Buffer.FirstElement = 0;
+	srvDesc.Buffer.NumElements = boxCapacity;
+	hr = device->CreateShaderResourceView(boxBuffer.Get(), &srvDesc, boxShaderResourceView.ReleaseAndGetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	// 結果はボックスごとの uint
+	bufferDesc.ByteWidth = sizeof(UINT) * boxCapacity;
+	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+	bufferDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+	bufferDesc.CPUAccessFlags = 0;
+	bufferDesc.StructureByteStride = sizeof(UINT);
+	hr = device->CreateBuffer(&bufferDesc, nullptr, resultBuffer.ReleaseAndGetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc{};
+	uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+	uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+	uavDesc.Buffer.FirstElement = 0;
+	uavDesc.Buffer.NumElements = boxCapacity;
+	hr = device->CreateUnorderedAccessView(resultBuffer.Get(), &uavDesc, resultUnorderedAccessView.ReleaseAndGetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+}
+
+// 追加したボックスをまとめて判定し、結果を読み戻し用バッファにコピーする
+bool HiZBuffer::TestBoxes(ID3D11DeviceContext* dc, const DirectX::XMFLOAT4X4& viewProjection, UINT& submission)
+{
+	const UINT boxCount = static_cast<UINT>(boxes.size());
+	if (boxCount == 0 || !shaderResourceView) return false;
+
+	// 全て結果待ちなら、GPU を待たないように今回は判定しない(前回までの結果を使い続ける)
+	if (nextSubmission - nextRead >= ReadbackBufferCount) return false;
+
+	ReserveBoxes(boxCount);
+
+	// 読み戻し用バッファは結果待ちでないものだけを作り直す
+	Readback& readback = readbacks[nextSubmission % ReadbackBufferCount];
+	if (readback.capacity < boxCapacity)
+	{
+		D3D11_BUFFER_DESC bufferDesc{};
+		bufferDesc.ByteWidth = sizeof(UINT) * boxCapacity;
+		bufferDesc.Usage = D3D11_USAGE_STAGING;
+		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+		HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, readback.buffer.ReleaseAndGetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+		readback.capacity = boxCapacity;
+	}
+	readback.boxCount = boxCount;
+
+	D3D11_MAPPED_SUBRESOURCE mapped{};
+	HRESULT hr = dc->Map(boxBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	memcpy(mapped.pData, boxes.data(), sizeof(Box) * boxCount);
+	dc->Unmap(boxBuffer.Get(), 0);
+
+	CbOcclusionTest cbOcclusionTest{};
+	cbOcclusionTest.viewProjection = viewProjection;
+	cbOcclusionTest.screenSize[0] = static_cast<float>(width);
+	cbOcclusionTest.screenSize[1] = static_cast<float>(height);
+	cbOcclusionTest.mipCount = mipCount;
+	cbOcclusionTest.boxCount = boxCount;
+	dc->UpdateSubresource(testConstantBuffer.Get(), 0, nullptr, &cbOcclusionTest, 0, 0);
+
+	ID3D11ShaderResourceView* srvs[] = { shaderResourceView.Get(), boxShaderResourceView.Get() };
+	dc->CSSetShader(testShader.Get(), nullptr, 0);
+	dc->CSSetConstantBuffers(0, 1, testConstantBuffer.GetAddressOf());
+	dc->CSSetShaderResources(0, _countof(srvs), srvs);
+	dc->CSSetUnorderedAccessViews(0, 1, resultUnorderedAccessView.GetAddressOf(), nullptr);
+	dc->Dispatch((boxCount + TestGroupSize - 1) / TestGroupSize, 1, 1);
+
+	ID3D11ShaderResourceView* nullSrvs[] = { nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUavs[] = { nullptr };
+	ID3D11Buffer* nullCbs[] = { nullptr };
+	dc->CSSetShaderResources(0, _countof(nullSrvs), nullSrvs);
+	dc->CSSetUnorderedAccessViews(0, _countof(nullUavs), nullUavs, nullptr);
+	dc->CSSetConstantBuffers(0, _countof(nullCbs), nullCbs);
+	dc->CSSetShader(nullptr, nullptr, 0);
+
+	// 判定した分だけを読み戻し用バッファにコピーする(読み出しは ReadResults() で GPU が書き終えてから)
+	D3D11_BOX region{};
+	region.left = 0;
+	region.right = sizeof(UINT) * boxCount;
+	region.top = 0;
+	region.bottom = 1;
+	region.front = 0;
+	region.back = 1;
+	dc->CopySubresourceRegion(readback.buffer.Get(), 0, 0, 0, 0, resultBuffer.Get(), 0, &region);
+
+	submission = nextSubmission++;
+	return true;
+}
+
+// GPU が書き終えた結果を古い順に1回分読み出す
+bool HiZBuffer::ReadResults(ID3D11DeviceContext* dc, UINT& submission)
+{
+	if (nextRead == nextSubmission) return false;
+
+	// まだ書き終えていなければ待たずに戻る(次のフレームで読み出す)
+	Readback& readback = readbacks[nextRead % ReadbackBufferCount];
+	D3D11_MAPPED_SUBRESOURCE mapped{};
+	HRESULT hr = dc->Map(readback.buffer.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped);
+	if (hr == DXGI_ERROR_WAS_STILL_DRAWING) return false;
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	const UINT* results = static_cast<const UINT*>(mapped.pData);
+	visible.resize(readback.boxCount);
+	for (UINT i = 0; i < readback.boxCount; ++i)
+	{
+		visible[i] = results[i] != 0 ? 1 : 0;
+	}
+	dc->Unmap(readback.buffer.Get(), 0);
+
+	submission = nextRead++;
+	return true;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <wrl.h>
+#include <d3d11.h>
+#include <DirectXMath.h>
+
+// 深度バッファから最大深度のミップ(Hi-Z)をコンピュートシェーダーで作り、境界ボックスが隠れているか GPU で判定する
+// 判定方法は OcclusionRasterizer と同じで、ミップの level 0 は深度バッファの半分の解像度
+// 判定結果は読み戻し用バッファに順にコピーし、GPU が書き終えたものだけを待たずに読み出す
+// (CPU は GPU を待たない代わりに、結果は1～数フレーム遅れて届く)
+class HiZBuffer
+{
+public:
+	static const UINT BuildGroupSize = 8;	// HiZBuildCS の numthreads(8, 8, 1)
+	static const UINT TestGroupSize = 64;	// OcclusionTestCS の numthreads(64, 1, 1)
+	static const UINT ReadbackBufferCount = 3;	// 読み戻し用バッファの数(結果を待たずに判定できる回数)
+
+	HiZBuffer(ID3D11Device* device);
+
+	// コンピュートシェーダーと深度バッファの読み込みに対応しているか
+	static bool IsSupported(ID3D11Device* device);
+
+	// 深度バッファからミップを作る(大きさが変わっていればテクスチャを作り直す)
+	// 深度バッファを書き込み先から一時的に外すので、描画中の設定は退避して戻す
+	void Build(ID3D11DeviceContext* dc, ID3D11ShaderResourceView* depthShaderResourceView, UINT width, UINT height);
+
+	// 判定対象をクリア
+	void ClearBoxes();
+
+	// 判定対象のボックス追加(戻り値は結果を取得する際の番号)
+	size_t AddBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents);
+
+	// 追加したボックスをまとめて判定し、結果を読み戻し用バッファにコピーする(GPU を待たない)
+	// 読み戻し用バッファが全て結果待ちなら判定せずに false を返す。submission には結果を受け取る際の番号が入る
+	bool TestBoxes(ID3D11DeviceContext* dc, const DirectX::XMFLOAT4X4& viewProjection, UINT& submission);
+
+	// GPU が書き終えた結果を古い順に1回分読み出す(GPU を待たない)
+	// 読み出せたら true を返し、submission に TestBoxes() が返した番号が入る
+	bool ReadResults(ID3D11DeviceContext* dc, UINT& submission);
+
+	// 読み出した結果の取得(番号は判定した回の AddBox() が返した番号)
+	bool IsVisible(size_t index) const { return visible[index] != 0; }
+
+	// ミップの数
+	UINT GetMipCount() const { return mipCount; }
+
+private:
+	// ミップを作り直す
+	void Resize(UINT width, UINT height);
+
+	// 判定対象のバッファを count 個以上入る大きさで作り直す
+	void ReserveBoxes(UINT count);
+
+	// 読み戻し用バッファ
+	struct Readback
+	{
+		Microsoft::WRL::ComPtr<ID3D11Buffer>	buffer;
+		UINT									capacity = 0;
+		UINT									boxCount = 0;
+	};
+
+	// OcclusionTestCS の StructuredBuffer<Box> と同じ配置
+	struct Box
+	{
+		DirectX::XMFLOAT3	center;
+		float				pad0;
+		DirectX::XMFLOAT3	extents;
+		float				pad1;
+	};
+
+	struct CbHiZBuild
+	{
+		UINT	sourceSize[2];
+		UINT	destinationSize[2];
+	};
+
+	struct CbOcclusionTest
+	{
+		DirectX::XMFLOAT4X4	viewProjection;
+		float				screenSize[2];		// 深度バッファの大きさ(ピクセル)
+		UINT				mipCount;
+		UINT				boxCount;
+	};
+
+private:
+	ID3D11Device*										device;
+	UINT												width = 0;		// 深度バッファの大きさ
+	UINT												height = 0;
+	UINT												mipCount = 0;
+
+	Microsoft::WRL::ComPtr<ID3D11ComputeShader>			buildShader;
+	Microsoft::WRL::ComPtr<ID3D11ComputeShader>			testShader;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				buildConstantBuffer;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				testConstantBuffer;
+
+	// 最大深度のミップ(ミップごとの読み書き用のビューと、判定用の全ミップのビュー)
+	Microsoft::WRL::ComPtr<ID3D11Texture2D>				texture;
+	std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>	mipShaderResourceViews;
+	std::vector<Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView>>	mipUnorderedAccessViews;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	shaderResourceView;
+
+	// 判定対象と結果
+	UINT												boxCapacity = 0;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				boxBuffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	boxShaderResourceView;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				resultBuffer;
+	Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView>	resultUnorderedAccessView;
+
+	// 判定の番号 n の結果は readbacks[n % ReadbackBufferCount] に入る([nextRead, nextSubmission) が結果待ち)
+	Readback											readbacks[ReadbackBufferCount];
+	UINT												nextSubmission = 0;
+	UINT												nextRead = 0;
+
+	std::vector<Box>									boxes;
+	std::vector<uint8_t>								visible;
+};
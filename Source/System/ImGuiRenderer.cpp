@@ -4,7 +4,7 @@
 
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
-// 
+// 初期化
 void ImGuiRenderer::Initialize(HWND hWnd, ID3D11Device* device, ID3D11DeviceContext* dc)
 {
 	// Setup Dear ImGui context
@@ -60,7 +60,7 @@ void ImGuiRenderer::Initialize(HWND hWnd, ID3D11Device* device, ID3D11DeviceCont
 	IM_ASSERT(font != NULL);
 }
 
-// I
+// 終了化
 void ImGuiRenderer::Finalize()
 {
 	ImGui_ImplDX11_Shutdown();
@@ -68,7 +68,7 @@ void ImGuiRenderer::Finalize()
 	ImGui::DestroyContext();
 }
 
-// t[Jn
+// フレーム開始処理
 void ImGuiRenderer::NewFrame()
 {
 	ImGui_ImplDX11_NewFrame();
@@ -115,7 +115,7 @@ void ImGuiRenderer::NewFrame()
 #endif
 }
 
-// `
+// 描画
 void ImGuiRenderer::Render(ID3D11DeviceContext* context)
 {
 	// Rendering
@@ -132,7 +132,7 @@ void ImGuiRenderer::Render(ID3D11DeviceContext* context)
 	}
 }
 
-// WIN32bZ[Wnh[
+// WIN32メッセージハンドラー
 LRESULT ImGuiRenderer::HandleMessage(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	return ImGui_ImplWin32_WndProcHandler(hWnd, msg, wParam, lParam);
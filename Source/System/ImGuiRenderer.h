@@ -6,18 +6,18 @@
 class ImGuiRenderer
 {
 public:
-	// 
+	// 初期化
 	static void Initialize(HWND hWnd, ID3D11Device* device, ID3D11DeviceContext* dc);
 	
-	// I
+	// 終了化
 	static void Finalize();
 
-	// t[Jn
+	// フレーム開始処理
 	static void NewFrame();
 
-	// `s
+	// 描画実行
 	static void Render(ID3D11DeviceContext* context);
 
-	// WIN32bZ[Wnh[
+	// WIN32メッセージハンドラー
 	static LRESULT HandleMessage(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 };
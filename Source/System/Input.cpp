@@ -1,13 +1,13 @@
 #include "System/Input.h"
 
-// 
+// 初期化
 void Input::Initialize(HWND hWnd)
 {
 	gamePad = std::make_unique<GamePad>();
 	mouse = std::make_unique<Mouse>(hWnd);
 }
 
-// XV
+// 更新処理
 void Input::Update()
 {
 	gamePad->Update();
@@ -4,7 +4,7 @@
 #include "System/GamePad.h"
 #include "System/Mouse.h"
 
-// Cvbg
+// インプット
 class Input
 {
 private:
@@ -12,23 +12,23 @@ private:
 	~Input() = default;
 
 public:
-	// CX^X擾
+	// インスタンス取得
 	static Input& Instance()
 	{
 		static Input instance;
 		return instance;
 	}
 
-	// 
+	// 初期化
 	void Initialize(HWND hWnd);
 
-	// XV
+	// 更新処理
 	void Update();
 
-	// Q[pbh擾
+	// ゲームパッド取得
 	GamePad& GetGamePad() { return *gamePad; }
 
-	// }EX擾
+	// マウス取得
 	Mouse& GetMouse() { return *mouse; }
 
 private:
@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <string>
+#include <imgui.h>
+#include "System/JobSystem.h"
+#include "System/Profiler.h"
+
+// デストラクタ
+JobSystem::~JobSystem()
+{
+	Finalize();
+}
+
+// 初期化
+void JobSystem::Initialize(int workerCount)
+{
+	if (IsInitialized()) return;
+
+	if (workerCount < 0)
+	{
+		const int coreCount = static_cast<int>(std::thread::hardware_concurrency());
+		workerCount = std::max(coreCount - 1, 0);
+	}
+
+	// ワーカーごとのキューとワーカー以外のスレッド用のキュー
+	for (int i = 0; i < workerCount + 1; ++i)
+	{
+		queues.emplace_back(std::make_unique<WorkQueue>());
+	}
+
+	running = true;
+	for (int i = 0; i < workerCount; ++i)
+	{
+		workers.emplace_back(&JobSystem::WorkerThread, this, i);
+	}
+}
+
+// 終了化
+void JobSystem::Finalize()
+{
+	if (!IsInitialized()) return;
+
+	// 残っているジョブを片付ける
+	while (TryExecute()) {}
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		running = false;
+	}
+	wakeCondition.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+	queues.clear();
+}
+
+// ジョブ登録
+void JobSystem::Run(std::function<void()> function, JobCounter* counter, JobCounter* dependency)
+{
+	Job job;
+	job.function = std::move(function);
+	job.counter = counter;
+
+	if (counter != nullptr)
+	{
+		counter->value.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// 未初期化ならその場で実行する
+	if (!IsInitialized())
+	{
+		if (dependency != nullptr) Wait(dependency);
+		job.function();
+		Finish(job.counter);
+		return;
+	}
+
+	if (dependency != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(dependency->mutex);
+		if (dependency->value.load(std::memory_order_acquire) > 0)
+		{
+			// 依存先が終わったときに投入される
+			dependency->continuations.emplace_back(std::move(job));
+			return;
+		}
+	}
+
+	Push(std::move(job));
+}
+
+// カウンタが 0 になるまで待つ
+void JobSystem::Wait(JobCounter* counter)
+{
+	if (counter == nullptr) return;
+
+	while (counter->value.load(std::memory_order_acquire) > 0)
+	{
+		// 待っている間は他のジョブを手伝う
+		if (!TryExecute())
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// 最後のジョブが Finish() でロックを握っている間に破棄されないようにする
+	std::lock_guard<std::mutex> lock(counter->mutex);
+}
+
+// 範囲を分割して並列実行
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize,
+	const std::function<void(size_t, size_t)>& function)
+{
+	if (begin >= end) return;
+	grainSize = std::max<size_t>(grainSize, 1);
+
+	// 分割する意味がなければその場で実行する
+	if (end - begin <= grainSize || workers.empty())
+	{
+		function(begin, end);
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+	{
+		const size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+		Run([&function, chunkBegin, chunkEnd]() { function(chunkBegin, chunkEnd); }, &counter);
+	}
+	Wait(&counter);
+}
+
+// 統計取得
+JobSystem::Statistics JobSystem::GetStatistics() const
+{
+	Statistics statistics;
+	statistics.executedCount = executedCount.load(std::memory_order_relaxed);
+	statistics.stealCount = stealCount.load(std::memory_order_relaxed);
+	statistics.sleepCount = sleepCount.load(std::memory_order_relaxed);
+	return statistics;
+}
+
+// デバッグGUI描画
+void JobSystem::DrawDebugGUI()
+{
+	if (ImGui::CollapsingHeader("Job System", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const Statistics statistics = GetStatistics();
+		ImGui::Text("Workers : %d (+ main)", GetWorkerCount());
+		ImGui::Text("Executed : %llu", statistics.executedCount);
+		ImGui::Text("Steals : %llu", statistics.stealCount);
+		ImGui::Text("Sleeps : %llu", statistics.sleepCount);
+
+		// 参加スレッド数ごとの速度比
+		if (ImGui::TreeNode("Scaling Benchmark"))
+		{
+			if (ImGui::Button("Run"))
+			{
+				const int coreCount = static_cast<int>(std::thread::hardware_concurrency());
+				benchmarkResults = JobSystemBenchmark::Run(std::max(coreCount - 1, 0));
+			}
+			for (const JobSystemBenchmark::Result& result : benchmarkResults)
+			{
+				ImGui::Text("%2d threads  %7.2f ms  x%.2f",
+					result.threadCount, result.seconds * 1000.0f, result.speedup);
+			}
+			ImGui::TreePop();
+		}
+	}
+}
+
+// ワーカースレッド
+void JobSystem::WorkerThread(int index)
+{
+	workerIndex = index;
+	workerOwner = this;
+
+	std::string name = "Worker " + std::to_string(index);
+	PROFILE_THREAD_NAME(name.c_str());
+
+	while (running.load(std::memory_order_acquire))
+	{
+		if (TryExecute()) continue;
+
+		// 少しだけ回ってから眠る(ジョブが続けて積まれる場合の起床待ちを避ける)
+		bool executed = false;
+		for (int spin = 0; spin < 64 && !executed; ++spin)
+		{
+			std::this_thread::yield();
+			executed = TryExecute();
+		}
+		if (executed) continue;
+
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		if (running && queuedCount.load(std::memory_order_acquire) == 0)
+		{
+			sleepCount.fetch_add(1, std::memory_order_relaxed);
+			wakeCondition.wait(lock, [this]()
+			{
+				return !running || queuedCount.load(std::memory_order_acquire) > 0;
+			});
+		}
+	}
+	workerIndex = -1;
+	workerOwner = nullptr;
+}
+
+// キューに積む
+void JobSystem::Push(Job&& job)
+{
+	WorkQueue& queue = *queues[GetQueueIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.emplace_back(std::move(job));
+	}
+	queuedCount.fetch_add(1, std::memory_order_release);
+
+	// 眠っているワーカーを起こす(ロックを経由して起床の取りこぼしを防ぐ)
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+	}
+	wakeCondition.notify_one();
+}
+
+// ジョブを1つ取り出して実行する
+bool JobSystem::TryExecute()
+{
+	Job job;
+	if (!Pop(job)) return false;
+
+	job.function();
+	executedCount.fetch_add(1, std::memory_order_relaxed);
+	Finish(job.counter);
+	return true;
+}
+
+// 取り出し
+bool JobSystem::Pop(Job& job)
+{
+	if (queuedCount.load(std::memory_order_acquire) == 0) return false;
+
+	const int queueCount = static_cast<int>(queues.size());
+	const int ownIndex = GetQueueIndex();
+
+	// 自分のキューの末尾(直前に積んだものほどキャッシュに残っている)
+	{
+		WorkQueue& queue = *queues[ownIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			queuedCount.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// 他のキューの先頭から盗む
+	for (int i = 1; i < queueCount; ++i)
+	{
+		WorkQueue& queue = *queues[(ownIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			queuedCount.fetch_sub(1, std::memory_order_relaxed);
+			stealCount.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+// ジョブの完了処理
+void JobSystem::Finish(JobCounter* counter)
+{
+	if (counter == nullptr) return;
+
+	std::vector<Job> continuations;
+	{
+		std::lock_guard<std::mutex> lock(counter->mutex);
+		if (counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			continuations.swap(counter->continuations);
+		}
+	}
+
+	// ロックを離してから依存ジョブを投入する(ここから先は counter に触れない)
+	for (Job& job : continuations)
+	{
+		if (IsInitialized())
+		{
+			Push(std::move(job));
+		}
+		else
+		{
+			job.function();
+			Finish(job.counter);
+		}
+	}
+}
+
+// 呼び出したスレッドが使うキューの番号
+int JobSystem::GetQueueIndex() const
+{
+	// ほかのインスタンスのワーカーから呼ばれた場合はワーカー以外のスレッドとして扱う
+	return workerOwner == this ? workerIndex : static_cast<int>(queues.size()) - 1;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Windows.h>
+#include "System/JobSystemBenchmark.h"
+
+class JobCounter;
+
+// ジョブ
+struct Job
+{
+	std::function<void()>	function;
+	JobCounter*				counter = nullptr;	// 完了時に減らすカウンタ
+};
+
+// ジョブの完了待ち用カウンタ
+// 登録したジョブの数だけ増え、ジョブが終わるたびに減る
+// 0 になった時点で、このカウンタに依存して待たされていたジョブが投入される
+// 破棄する前に必ず JobSystem::Wait() で完了を待つこと
+class JobCounter
+{
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	// 全てのジョブが完了したか
+	bool IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<int>	value = 0;
+	std::mutex			mutex;				// 依存ジョブの登録と 0 になる瞬間の排他
+	std::vector<Job>	continuations;		// 0 になったら投入するジョブ
+};
+
+// ワークスティーリング方式のジョブシステム
+// ワーカースレッドごとに両端キューを持ち、自分のキューは末尾から(LIFO)、
+// 他のキューは先頭から(FIFO)取り出す。待っているスレッドはその間ほかのジョブを手伝う
+class JobSystem
+{
+private:
+	// ベンチマークは実行中のジョブを邪魔しないように専用のインスタンスを作る
+	friend class JobSystemBenchmark;
+
+	JobSystem() = default;
+	~JobSystem();
+
+public:
+	// インスタンス取得
+	static JobSystem& Instance()
+	{
+		static JobSystem instance;
+		return instance;
+	}
+
+	// 統計
+	struct Statistics
+	{
+		UINT64	executedCount = 0;		// 実行したジョブ数
+		UINT64	stealCount = 0;			// 他のキューから盗んだ数
+		UINT64	sleepCount = 0;			// ワーカーが眠った回数
+	};
+
+	// 初期化(workerCount が負の場合は論理コア数 - 1)
+	// ワーカー 0 でも動作し、その場合は Wait() を呼んだスレッドが全て実行する
+	void Initialize(int workerCount = -1);
+
+	// 終了化(残っているジョブを全て実行してからワーカーを止める)
+	void Finalize();
+
+	// 初期化済みか
+	bool IsInitialized() const { return !queues.empty(); }
+
+	// ワーカー数取得(メインスレッドは含まない)
+	int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+
+	// ジョブ登録
+	// counter を指定すると完了時に減らす
+	// dependency を指定するとそのカウンタが 0 になってから実行する
+	void Run(std::function<void()> function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+	// カウンタが 0 になるまで待つ(待っている間は他のジョブを実行する)
+	void Wait(JobCounter* counter);
+
+	// [begin, end) を grainSize ずつに分けて並列実行し、全て終わるまで待つ
+	// function には分割した範囲 [begin, end) が渡される
+	void ParallelFor(size_t begin, size_t end, size_t grainSize,
+		const std::function<void(size_t, size_t)>& function);
+
+	// 統計取得
+	Statistics GetStatistics() const;
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+private:
+	// スレッドごとのキュー
+	struct WorkQueue
+	{
+		std::mutex			mutex;
+		std::deque<Job>		jobs;
+	};
+
+	// ワーカースレッド
+	void WorkerThread(int index);
+
+	// キューに積む
+	void Push(Job&& job);
+
+	// ジョブを1つ取り出して実行する(なければ false)
+	bool TryExecute();
+
+	// 取り出し(自分のキューの末尾、なければ他のキューの先頭から盗む)
+	bool Pop(Job& job);
+
+	// ジョブの完了処理
+	void Finish(JobCounter* counter);
+
+	// 呼び出したスレッドが使うキューの番号
+	int GetQueueIndex() const;
+
+private:
+	static inline thread_local int				workerIndex = -1;			// ワーカー以外は -1
+	static inline thread_local const JobSystem*	workerOwner = nullptr;		// ワーカーが属するインスタンス
+
+	std::vector<std::unique_ptr<WorkQueue>>	queues;		// 最後の1つはワーカー以外のスレッド用
+	std::vector<std::thread>				workers;
+
+	std::atomic<bool>		running = false;
+	std::atomic<int>		queuedCount = 0;
+	std::mutex				wakeMutex;
+	std::condition_variable	wakeCondition;
+
+	std::atomic<UINT64>		executedCount = 0;
+	std::atomic<UINT64>		stealCount = 0;
+	std::atomic<UINT64>		sleepCount = 0;
+
+	std::vector<JobSystemBenchmark::Result>	benchmarkResults;
+};
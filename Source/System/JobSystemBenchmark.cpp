@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <cmath>
+#include "Misc.h"
+#include "System/JobSystem.h"
+#include "System/JobSystemBenchmark.h"
+
+// ベンチマーク実行
+std::vector<JobSystemBenchmark::Result> JobSystemBenchmark::Run(int maxWorkerCount, size_t itemCount, int iterations)
+{
+	std::vector<Result> results;
+
+	// 読み込みスレッドなどが使っている共有のインスタンスは止めない
+	JobSystem jobSystem;
+
+	std::vector<float> output(itemCount);
+	const size_t grainSize = 1024;
+
+	for (int workerCount = 0; workerCount <= maxWorkerCount; ++workerCount)
+	{
+		jobSystem.Finalize();
+		jobSystem.Initialize(workerCount);
+
+		auto execute = [&]()
+		{
+			jobSystem.ParallelFor(0, itemCount, grainSize, [&output](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					output[i] = Compute(i);
+				}
+			});
+		};
+
+		// ワーカーの起床とキャッシュを温める
+		execute();
+
+		Benchmark benchmark;
+		benchmark.begin();
+		for (int i = 0; i < iterations; ++i)
+		{
+			execute();
+		}
+
+		Result& result = results.emplace_back();
+		result.threadCount = workerCount + 1;
+		result.seconds = benchmark.end() / iterations;
+		result.speedup = results.front().seconds / std::max(result.seconds, 1e-9f);
+	}
+
+	jobSystem.Finalize();
+	return results;
+}
+
+// 1要素分の計算
+float JobSystemBenchmark::Compute(size_t index)
+{
+	float x = static_cast<float>(index) * 0.001f;
+	float sum = 0.0f;
+	for (int i = 0; i < 64; ++i)
+	{
+		sum += std::sin(x) * std::cos(x * 0.5f);
+		x = x * 1.0001f + 0.01f;
+	}
+	return sum;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+// ジョブシステムのスケーリングベンチマーク
+// 同じ計算量の ParallelFor をワーカー数を変えて実行し、1スレッド時との速度比を測る
+class JobSystemBenchmark
+{
+public:
+	struct Result
+	{
+		int		threadCount = 0;	// 実行に参加したスレッド数(メインスレッド含む)
+		float	seconds = 0.0f;		// 1回あたりの平均時間
+		float	speedup = 0.0f;		// 1スレッド時に対する速度比
+	};
+
+	// ベンチマーク実行
+	// 専用の JobSystem でワーカー数を 0 から maxWorkerCount まで変えて測定する
+	// JobSystem::Instance() には触れないので、ほかのスレッドがジョブを実行中でも呼べる
+	static std::vector<Result> Run(int maxWorkerCount, size_t itemCount = 1 << 18, int iterations = 5);
+
+	// 1要素分の計算(適度に重い浮動小数点演算)
+	static float Compute(size_t index);
+};
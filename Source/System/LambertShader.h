@@ -8,13 +8,13 @@ public:
 	LambertShader(ID3D11Device* device);
 	~LambertShader() override = default;
 
-	// Jn
+	// 開始処理
 	void Begin(const RenderContext& rc) override;
 
-	// XV
-	void Update(const RenderContext& rc, const Model::Mesh& mesh) override;
+	// 更新処理
+	void Update(const RenderContext& rc, RenderBackend& backend, const Model::Mesh& mesh) override;
 
-	// I
+	// 終了処理
 	void End(const RenderContext& rc) override;
 
 private:
@@ -23,8 +23,8 @@ private:
 		DirectX::XMFLOAT4		materialColor;
 	};
 
-	Microsoft::WRL::ComPtr<ID3D11VertexShader>		vertexShader;
+	Microsoft::WRL::ComPtr<ID3D11VertexShader>		vertexShaders[static_cast<int>(Model::VertexFormat::Count)];
 	Microsoft::WRL::ComPtr<ID3D11PixelShader>		pixelShader;
-	Microsoft::WRL::ComPtr<ID3D11InputLayout>		inputLayout;
+	Microsoft::WRL::ComPtr<ID3D11InputLayout>		inputLayouts[static_cast<int>(Model::VertexFormat::Count)];
 	Microsoft::WRL::ComPtr<ID3D11Buffer>			meshConstantBuffer;
 };
@@ -0,0 +1,454 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <random>
+#include "System/LightCuller.h"
+#include "System/JobSystem.h"
+
+namespace
+{
+	// 球と境界ボックスの交差判定
+	bool IntersectSphereAabb(const DirectX::XMFLOAT3& center, float radius,
+		const DirectX::XMFLOAT3& boxMin, const DirectX::XMFLOAT3& boxMax)
+	{
+		const float dx = (std::max)((std::max)(boxMin.x - center.x, center.x - boxMax.x), 0.0f);
+		const float dy = (std::max)((std::max)(boxMin.y - center.y, center.y - boxMax.y), 0.0f);
+		const float dz = (std::max)((std::max)(boxMin.z - center.z, center.z - boxMax.z), 0.0f);
+		return dx * dx + dy * dy + dz * dz <= radius * radius;
+	}
+}
+
+// クラスタを作り、ライトを割り当てる
+void LightCuller::Build(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection,
+	const std::vector<PointLight>& pointLights, const std::vector<SpotLight>& spotLights)
+{
+	UpdateClusterBounds(projection);
+
+	// ライトをビュー空間の球にする
+	const DirectX::XMMATRIX View = DirectX::XMLoadFloat4x4(&view);
+	pointSpheres.clear();
+	for (size_t i = 0; i < pointLights.size(); ++i)
+	{
+		const PointLight& light = pointLights[i];
+		if (!light.enabled || light.range <= 0.0f) continue;
+
+		LightSphere& sphere = pointSpheres.emplace_back();
+		DirectX::XMStoreFloat3(&sphere.center, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&light.position), View));
+		sphere.radius = light.range;
+		sphere.index = static_cast<uint32_t>(i);
+	}
+
+	// スポットライトは円錐を囲む最小の球にする
+	spotSpheres.clear();
+	for (size_t i = 0; i < spotLights.size(); ++i)
+	{
+		const SpotLight& light = spotLights[i];
+		if (!light.enabled || light.range <= 0.0f) continue;
+
+		const float angle = DirectX::XMConvertToRadians(light.outerConeAngle);
+		const float cosAngle = std::cos(angle);
+		float distance, radius;
+		if (angle >= DirectX::XM_PIDIV2)
+		{
+			// 半角が90度以上の円錐は半球より広いので、光源を中心に届く距離を半径とする球
+			distance = 0.0f;
+			radius = light.range;
+		}
+		else if (angle > DirectX::XM_PIDIV4)
+		{
+			// 広い円錐は底面の円を囲む球
+			distance = light.range * cosAngle;
+			radius = light.range * std::sin(angle);
+		}
+		else
+		{
+			// 狭い円錐は頂点と底面の円を通る球
+			distance = light.range / (2.0f * cosAngle);
+			radius = distance;
+		}
+
+		DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&light.direction));
+		DirectX::XMVECTOR Center = DirectX::XMVectorMultiplyAdd(Direction, DirectX::XMVectorReplicate(distance),
+			DirectX::XMLoadFloat3(&light.position));
+
+		LightSphere& sphere = spotSpheres.emplace_back();
+		DirectX::XMStoreFloat3(&sphere.center, DirectX::XMVector3TransformCoord(Center, View));
+		sphere.radius = radius;
+		sphere.index = static_cast<uint32_t>(i);
+	}
+
+	// 深度方向のスライスは互いに独立しているので並列で割り当てる
+	sliceIndices.resize(ClusterCountZ);
+	sliceCandidates.resize(ClusterCountZ);
+	sliceHits.resize(ClusterCountZ);
+	JobSystem::Instance().ParallelFor(0, ClusterCountZ, 1,
+		[this](size_t begin, size_t end)
+		{
+			for (size_t z = begin; z < end; ++z)
+			{
+				BuildSlice(static_cast<uint32_t>(z));
+			}
+		});
+
+	// スライスごとの番号を1つの配列にまとめる
+	lightIndices.clear();
+	maxLightsPerCluster = 0;
+	const uint32_t clustersPerSlice = ClusterCountX * ClusterCountY;
+	for (uint32_t z = 0; z < ClusterCountZ; ++z)
+	{
+		const uint32_t base = static_cast<uint32_t>(lightIndices.size());
+		for (uint32_t i = 0; i < clustersPerSlice; ++i)
+		{
+			Cluster& cluster = clusters[z * clustersPerSlice + i];
+			cluster.offset += base;
+
+			const uint32_t lightCount = (cluster.lightCounts & 0xFFFF) + (cluster.lightCounts >> 16);
+			maxLightsPerCluster = (std::max)(maxLightsPerCluster, lightCount);
+		}
+		lightIndices.insert(lightIndices.end(), sliceIndices[z].begin(), sliceIndices[z].end());
+	}
+}
+
+// 画面上の位置と深度が属するクラスタの番号
+uint32_t LightCuller::GetClusterIndex(float pixelX, float pixelY, float viewportWidth, float viewportHeight, float depth) const
+{
+	const float fx = pixelX * ClusterCountX / viewportWidth;
+	const float fy = pixelY * ClusterCountY / viewportHeight;
+	const float fz = std::log((std::max)(depth, nearZ)) * depthSliceScale + depthSliceBias;
+
+	const uint32_t x = static_cast<uint32_t>(std::clamp(fx, 0.0f, static_cast<float>(ClusterCountX - 1)));
+	const uint32_t y = static_cast<uint32_t>(std::clamp(fy, 0.0f, static_cast<float>(ClusterCountY - 1)));
+	const uint32_t z = static_cast<uint32_t>(std::clamp(fz, 0.0f, static_cast<float>(ClusterCountZ - 1)));
+	return x + (y + z * ClusterCountY) * ClusterCountX;
+}
+
+// クラスタの境界ボックスを作り直す
+void LightCuller::UpdateClusterBounds(const DirectX::XMFLOAT4X4& projection)
+{
+	if (!clusters.empty() && std::memcmp(&projection, &clusterProjection, sizeof(projection)) == 0) return;
+	clusterProjection = projection;
+
+	// 左手系の透視投影(深度は 0～1)からクリップ距離を求める
+	const DirectX::XMFLOAT4X4& p = projection;
+	nearZ = -p._43 / p._33;
+	farZ = p._43 / (1.0f - p._33);
+
+	// 深度は対数で分割する(手前ほど細かい)
+	const float logRatio = std::log(farZ / nearZ);
+	depthSliceScale = ClusterCountZ / logRatio;
+	depthSliceBias = -static_cast<float>(ClusterCountZ) * std::log(nearZ) / logRatio;
+
+	clusters.resize(ClusterCount);
+	clusterMin.resize(ClusterCount);
+	clusterMax.resize(ClusterCount);
+
+	for (uint32_t z = 0; z < ClusterCountZ; ++z)
+	{
+		const float depths[2] =
+		{
+			nearZ * std::pow(farZ / nearZ, static_cast<float>(z) / ClusterCountZ),
+			nearZ * std::pow(farZ / nearZ, static_cast<float>(z + 1) / ClusterCountZ),
+		};
+
+		for (uint32_t y = 0; y < ClusterCountY; ++y)
+		{
+			// 画面の上が y = 0
+			const float ndcY[2] =
+			{
+				1.0f - 2.0f * (y + 1) / ClusterCountY,
+				1.0f - 2.0f * y / ClusterCountY,
+			};
+
+			for (uint32_t x = 0; x < ClusterCountX; ++x)
+			{
+				const float ndcX[2] =
+				{
+					-1.0f + 2.0f * x / ClusterCountX,
+					-1.0f + 2.0f * (x + 1) / ClusterCountX,
+				};
+
+				// タイルの四隅を両端の深度で視点から延ばした8点を囲む
+				DirectX::XMFLOAT3 boxMin = { FLT_MAX, FLT_MAX, depths[0] };
+				DirectX::XMFLOAT3 boxMax = { -FLT_MAX, -FLT_MAX, depths[1] };
+				for (float depth : depths)
+				{
+					for (int i = 0; i < 2; ++i)
+					{
+						const float vx = (ndcX[i] - p._31) * depth / p._11;
+						const float vy = (ndcY[i] - p._32) * depth / p._22;
+						boxMin.x = (std::min)(boxMin.x, vx);
+						boxMax.x = (std::max)(boxMax.x, vx);
+						boxMin.y = (std::min)(boxMin.y, vy);
+						boxMax.y = (std::max)(boxMax.y, vy);
+					}
+				}
+
+				const uint32_t index = x + (y + z * ClusterCountY) * ClusterCountX;
+				clusterMin[index] = boxMin;
+				clusterMax[index] = boxMax;
+			}
+		}
+	}
+}
+
+// 深度方向の1スライス分を割り当てる
+void LightCuller::BuildSlice(uint32_t z)
+{
+	std::vector<uint32_t>& indices = sliceIndices[z];
+	indices.clear();
+
+	const uint32_t clustersPerSlice = ClusterCountX * ClusterCountY;
+	const uint32_t first = z * clustersPerSlice;
+
+	// スライスの深度の範囲にかかるライトだけを候補にする
+	const float sliceNear = clusterMin[first].z;
+	const float sliceFar = clusterMax[first].z;
+	auto overlapsSlice = [sliceNear, sliceFar](const LightSphere& sphere)
+		{
+			return sphere.center.z + sphere.radius >= sliceNear && sphere.center.z - sphere.radius <= sliceFar;
+		};
+
+	std::vector<uint32_t>& candidates = sliceCandidates[z];
+	candidates.clear();
+	for (uint32_t i = 0; i < pointSpheres.size(); ++i)
+	{
+		if (overlapsSlice(pointSpheres[i])) candidates.push_back(i);
+	}
+	const size_t pointCandidateCount = candidates.size();
+	for (uint32_t i = 0; i < spotSpheres.size(); ++i)
+	{
+		if (overlapsSlice(spotSpheres[i])) candidates.push_back(i);
+	}
+
+	// 候補ごとに画面上でかかるタイルの範囲を求め、その範囲のクラスタだけ判定する
+	const DirectX::XMFLOAT4X4& p = clusterProjection;
+	std::vector<uint32_t>& hits = sliceHits[z];
+	hits.clear();
+	uint32_t pointCounts[ClusterCountX * ClusterCountY] = {};
+	uint32_t spotCounts[ClusterCountX * ClusterCountY] = {};
+	for (size_t k = 0; k < candidates.size(); ++k)
+	{
+		const bool spot = k >= pointCandidateCount;
+		const LightSphere& sphere = spot ? spotSpheres[candidates[k]] : pointSpheres[candidates[k]];
+		const DirectX::XMFLOAT3& c = sphere.center;
+		const float r = sphere.radius;
+
+		// 球を囲む箱のうちスライス内の部分を画面に投影した範囲(x / depth は depth について単調なので両端で足りる)
+		const float depthMin = (std::max)(c.z - r, sliceNear);
+		const float depthMax = (std::min)(c.z + r, sliceFar);
+		const float ndcMinX = (std::min)((c.x - r) / depthMin, (c.x - r) / depthMax) * p._11 + p._31;
+		const float ndcMaxX = (std::max)((c.x + r) / depthMin, (c.x + r) / depthMax) * p._11 + p._31;
+		const float ndcMinY = (std::min)((c.y - r) / depthMin, (c.y - r) / depthMax) * p._22 + p._32;
+		const float ndcMaxY = (std::max)((c.y + r) / depthMin, (c.y + r) / depthMax) * p._22 + p._32;
+		if (ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f) continue;
+
+		auto toTile = [](float t, uint32_t count)
+			{
+				return static_cast<uint32_t>(std::clamp(t * count, 0.0f, static_cast<float>(count - 1)));
+			};
+		const uint32_t x0 = toTile((ndcMinX + 1.0f) * 0.5f, ClusterCountX);
+		const uint32_t x1 = toTile((ndcMaxX + 1.0f) * 0.5f, ClusterCountX);
+		const uint32_t y0 = toTile((1.0f - ndcMaxY) * 0.5f, ClusterCountY);
+		const uint32_t y1 = toTile((1.0f - ndcMinY) * 0.5f, ClusterCountY);
+
+		for (uint32_t y = y0; y <= y1; ++y)
+		{
+			for (uint32_t x = x0; x <= x1; ++x)
+			{
+				const uint32_t local = x + y * ClusterCountX;
+				uint32_t& count = spot ? spotCounts[local] : pointCounts[local];
+				if (count == 0xFFFF) continue;
+				if (!IntersectSphereAabb(c, r, clusterMin[first + local], clusterMax[first + local])) continue;
+
+				hits.push_back(local);
+				hits.push_back(sphere.index);
+				++count;
+			}
+		}
+	}
+
+	// クラスタごとにまとめる(候補は点光源、スポットライトの順なので、クラスタ内でもその順に並ぶ)
+	uint32_t cursors[ClusterCountX * ClusterCountY];
+	uint32_t offset = 0;
+	for (uint32_t i = 0; i < clustersPerSlice; ++i)
+	{
+		Cluster& cluster = clusters[first + i];
+		cluster.offset = offset;
+		cluster.lightCounts = pointCounts[i] | (spotCounts[i] << 16);
+		cursors[i] = offset;
+		offset += pointCounts[i] + spotCounts[i];
+	}
+	indices.resize(offset);
+	for (size_t h = 0; h < hits.size(); h += 2)
+	{
+		indices[cursors[hits[h]]++] = hits[h + 1];
+	}
+}
+
+// クラスタごとのライトを総当たりの判定と突き合わせる
+bool LightCuller::RunSelfTest()
+{
+	const float viewportWidth = 1280.0f, viewportHeight = 720.0f;
+	DirectX::XMFLOAT4X4 view, projection;
+	DirectX::XMStoreFloat4x4(&view, DirectX::XMMatrixLookToLH(DirectX::XMVectorSet(1.0f, 3.0f, -2.0f, 1.0f),
+		DirectX::XMVectorSet(0.2f, -0.3f, 1.0f, 0.0f), DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+	DirectX::XMStoreFloat4x4(&projection, DirectX::XMMatrixPerspectiveFovLH(DirectX::XMConvertToRadians(60.0f),
+		viewportWidth / viewportHeight, 0.1f, 200.0f));
+
+	// 視点の周りにライトを散らす(スポットライトは狭い円錐から半球を超える円錐まで)
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> positionDistribution(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> rangeDistribution(1.0f, 15.0f);
+	std::uniform_real_distribution<float> unitDistribution(-1.0f, 1.0f);
+	const float coneAngles[] = { 10.0f, 30.0f, 60.0f, 89.0f, 100.0f, 135.0f, 170.0f };
+
+	std::vector<PointLight> pointLights(48);
+	for (PointLight& light : pointLights)
+	{
+		light.position = { positionDistribution(random), positionDistribution(random) * 0.2f, positionDistribution(random) + 20.0f };
+		light.range = rangeDistribution(random);
+	}
+	pointLights[5].enabled = false;
+
+	std::vector<SpotLight> spotLights(42);
+	for (size_t i = 0; i < spotLights.size(); ++i)
+	{
+		SpotLight& light = spotLights[i];
+		light.position = { positionDistribution(random), positionDistribution(random) * 0.2f, positionDistribution(random) + 20.0f };
+		light.direction = { unitDistribution(random), unitDistribution(random), unitDistribution(random) };
+		light.range = rangeDistribution(random);
+		light.outerConeAngle = coneAngles[i % std::size(coneAngles)];
+		light.innerConeAngle = light.outerConeAngle * 0.5f;
+	}
+
+	LightCuller culler;
+	culler.Build(view, projection, pointLights, spotLights);
+	if (culler.clusters.size() != ClusterCount) return false;
+
+	// 全てのクラスタと全てのライトを総当たりで確かめる
+	// ・割り当てたライトは、点光源、スポットライトの順に番号の昇順で並び、球がクラスタの境界ボックスと交差する
+	// ・クラスタの区画内の点(頂点、辺と面の中点、中心)を含む球のライトは、必ず割り当てられている
+	const DirectX::XMFLOAT4X4& p = projection;
+	for (uint32_t i = 0; i < ClusterCount; ++i)
+	{
+		const Cluster& cluster = culler.clusters[i];
+		const uint32_t pointCount = cluster.lightCounts & 0xFFFF;
+		const uint32_t spotCount = cluster.lightCounts >> 16;
+		if (cluster.offset + pointCount + spotCount > culler.lightIndices.size()) return false;
+		const uint32_t* points = culler.lightIndices.data() + cluster.offset;
+		const uint32_t* spots = points + pointCount;
+		if (std::adjacent_find(points, spots, std::greater_equal<uint32_t>()) != spots) return false;
+		if (std::adjacent_find(spots, spots + spotCount, std::greater_equal<uint32_t>()) != spots + spotCount) return false;
+
+		const uint32_t x = i % ClusterCountX;
+		const uint32_t y = (i / ClusterCountX) % ClusterCountY;
+		DirectX::XMFLOAT3 samples[27];
+		for (int s = 0; s < 27; ++s)
+		{
+			const float tx = (x + 0.5f * (s % 3)) / ClusterCountX;
+			const float ty = (y + 0.5f * ((s / 3) % 3)) / ClusterCountY;
+			const float depth = culler.clusterMin[i].z + (culler.clusterMax[i].z - culler.clusterMin[i].z) * 0.5f * (s / 9);
+			samples[s] = { (tx * 2.0f - 1.0f - p._31) * depth / p._11, (1.0f - ty * 2.0f - p._32) * depth / p._22, depth };
+		}
+
+		auto check = [&](const std::vector<LightSphere>& spheres, const uint32_t* first, uint32_t count)
+			{
+				for (const LightSphere& sphere : spheres)
+				{
+					const bool assigned = std::find(first, first + count, sphere.index) != first + count;
+					if (assigned)
+					{
+						if (!IntersectSphereAabb(sphere.center, sphere.radius, culler.clusterMin[i], culler.clusterMax[i])) return false;
+						continue;
+					}
+					for (const DirectX::XMFLOAT3& sample : samples)
+					{
+						const float dx = sample.x - sphere.center.x, dy = sample.y - sphere.center.y, dz = sample.z - sphere.center.z;
+						if (dx * dx + dy * dy + dz * dz < sphere.radius * sphere.radius * 0.998f) return false;
+					}
+				}
+				// 割り当てたライトは全て有効なライト
+				return static_cast<size_t>(std::count_if(spheres.begin(), spheres.end(), [&](const LightSphere& sphere)
+					{
+						return std::find(first, first + count, sphere.index) != first + count;
+					})) == count;
+			};
+		if (!check(culler.pointSpheres, points, pointCount)) return false;
+		if (!check(culler.spotSpheres, spots, spotCount)) return false;
+	}
+
+	// ライトの届く範囲(スポットライトは円錐の内側)の点は、その点が属するクラスタに割り当てられている
+	const DirectX::XMMATRIX View = DirectX::XMLoadFloat4x4(&view);
+	auto isAssigned = [&](const DirectX::XMVECTOR& Position, uint32_t lightIndex, bool spot)
+		{
+			DirectX::XMFLOAT3 v;
+			DirectX::XMStoreFloat3(&v, DirectX::XMVector3TransformCoord(Position, View));
+			if (v.z < culler.nearZ || v.z > culler.farZ) return true;
+			const float ndcX = v.x / v.z * p._11 + p._31;
+			const float ndcY = v.y / v.z * p._22 + p._32;
+			if (std::fabs(ndcX) > 1.0f || std::fabs(ndcY) > 1.0f) return true;
+
+			const Cluster& cluster = culler.clusters[culler.GetClusterIndex(
+				(ndcX + 1.0f) * 0.5f * viewportWidth, (1.0f - ndcY) * 0.5f * viewportHeight, viewportWidth, viewportHeight, v.z)];
+			const uint32_t pointCount = cluster.lightCounts & 0xFFFF;
+			const auto first = culler.lightIndices.begin() + cluster.offset + (spot ? pointCount : 0);
+			const auto last = spot ? first + (cluster.lightCounts >> 16) : first + pointCount;
+			return std::find(first, last, lightIndex) != last;
+		};
+
+	// 距離の半分は届く距離の際から選ぶ(球の大きさが足りないと最初に外れるところ)
+	std::uniform_real_distribution<float> fractionDistribution(0.0f, 0.99f);
+	std::uniform_real_distribution<float> edgeDistribution(0.97f, 0.999f);
+	std::uniform_real_distribution<float> turnDistribution(0.0f, DirectX::XM_2PI);
+	for (uint32_t i = 0; i < static_cast<uint32_t>(pointLights.size()); ++i)
+	{
+		const PointLight& light = pointLights[i];
+		if (!light.enabled) continue;
+		for (int s = 0; s < 256; ++s)
+		{
+			const DirectX::XMVECTOR Direction = DirectX::XMVector3Normalize(DirectX::XMVectorSet(
+				unitDistribution(random), unitDistribution(random), unitDistribution(random), 0.0f));
+			const DirectX::XMVECTOR Position = DirectX::XMVectorMultiplyAdd(Direction,
+				DirectX::XMVectorReplicate(light.range * ((s & 1) ? edgeDistribution(random) : fractionDistribution(random))),
+				DirectX::XMLoadFloat3(&light.position));
+			if (!isAssigned(Position, i, false)) return false;
+		}
+	}
+	for (uint32_t i = 0; i < static_cast<uint32_t>(spotLights.size()); ++i)
+	{
+		const SpotLight& light = spotLights[i];
+		const DirectX::XMVECTOR Axis = DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&light.direction));
+		const DirectX::XMVECTOR Side = DirectX::XMVector3Normalize(DirectX::XMVector3Cross(Axis,
+			std::fabs(light.direction.y) < 0.9f ? DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f) : DirectX::XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f)));
+		const DirectX::XMVECTOR Up = DirectX::XMVector3Cross(Axis, Side);
+		const float outerAngle = DirectX::XMConvertToRadians(light.outerConeAngle);
+		const LightSphere* sphere = nullptr;
+		for (const LightSphere& spotSphere : culler.spotSpheres)
+		{
+			if (spotSphere.index == i) sphere = &spotSphere;
+		}
+		if (!sphere) return false;
+		const DirectX::XMVECTOR SphereCenter = DirectX::XMLoadFloat3(&sphere->center);
+
+		for (int s = 0; s < 256; ++s)
+		{
+			// 軸から円錐の縁までの角度と、軸周りの角度で向きを選ぶ
+			const float theta = outerAngle * fractionDistribution(random);
+			const float phi = turnDistribution(random);
+			const DirectX::XMVECTOR Direction = DirectX::XMVectorAdd(DirectX::XMVectorScale(Axis, std::cos(theta)),
+				DirectX::XMVectorAdd(DirectX::XMVectorScale(Side, std::sin(theta) * std::cos(phi)),
+					DirectX::XMVectorScale(Up, std::sin(theta) * std::sin(phi))));
+			const DirectX::XMVECTOR Position = DirectX::XMVectorMultiplyAdd(Direction,
+				DirectX::XMVectorReplicate(light.range * ((s & 1) ? edgeDistribution(random) : fractionDistribution(random))),
+				DirectX::XMLoadFloat3(&light.position));
+			// 円錐の内側の点は割り当てに使う球に含まれる(境界ボックスの余裕に頼らず球そのものを確かめる)
+			const float distance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(
+				DirectX::XMVector3TransformCoord(Position, View), SphereCenter)));
+			if (distance > sphere->radius * 1.0001f) return false;
+			if (!isAssigned(Position, i, true)) return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Light.h"
+
+// クラスタ(視錐台を画面のタイルと深度で分割した小区画)ごとのライト割り当て
+// 各クラスタに影響するライトの番号をビュー空間で求め、シェーダーはピクセルが属するクラスタのライトだけを計算する
+class LightCuller
+{
+public:
+	// 画面の分割数(16:9 の画面でタイルがほぼ正方形になる数)と深度の分割数
+	static const uint32_t ClusterCountX = 16;
+	static const uint32_t ClusterCountY = 9;
+	static const uint32_t ClusterCountZ = 24;
+	static const uint32_t ClusterCount = ClusterCountX * ClusterCountY * ClusterCountZ;
+
+	// 1クラスタ分のライト番号の範囲(lightIndices[offset] から点光源、続けてスポットライトが並ぶ)
+	struct Cluster
+	{
+		uint32_t	offset;
+		uint32_t	lightCounts;	// 下位16bit: 点光源の数、上位16bit: スポットライトの数
+	};
+
+	// ビュー行列とプロジェクション行列(左手系の透視投影)からクラスタを作り、ライトを割り当てる
+	// ライトの番号は渡した配列の番号(無効なライトは割り当てない)
+	void Build(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection,
+		const std::vector<PointLight>& pointLights, const std::vector<SpotLight>& spotLights);
+
+	// クラスタ取得(x、y、z の順で並ぶ。y は画面の上から)
+	const std::vector<Cluster>& GetClusters() const { return clusters; }
+
+	// ライト番号取得
+	const std::vector<uint32_t>& GetLightIndices() const { return lightIndices; }
+
+	// ビュー空間の深度から深度方向のクラスタ番号を求める係数(z = log(depth) * scale + bias)
+	float GetDepthSliceScale() const { return depthSliceScale; }
+	float GetDepthSliceBias() const { return depthSliceBias; }
+
+	// 画面上の位置(ピクセル)と深度が属するクラスタの番号
+	uint32_t GetClusterIndex(float pixelX, float pixelY, float viewportWidth, float viewportHeight, float depth) const;
+
+	// クラスタごとのライト数の最大値
+	uint32_t GetMaxLightsPerCluster() const { return maxLightsPerCluster; }
+
+	// 合成したカメラとライト(半角が90度を超えるスポットライトを含む)で、
+	// クラスタごとのライトを総当たりの判定と、ライトの届く範囲の点が属するクラスタと突き合わせる
+	static bool RunSelfTest();
+
+private:
+	// ビュー空間の球
+	struct LightSphere
+	{
+		DirectX::XMFLOAT3	center;
+		float				radius;
+		uint32_t			index;
+	};
+
+	// プロジェクション行列が変わったときだけクラスタの境界ボックスを作り直す
+	void UpdateClusterBounds(const DirectX::XMFLOAT4X4& projection);
+
+	// 深度方向の1スライス分を割り当てる
+	void BuildSlice(uint32_t z);
+
+private:
+	std::vector<Cluster>	clusters;
+	std::vector<uint32_t>	lightIndices;
+
+	// ビュー空間のクラスタの境界ボックス
+	std::vector<DirectX::XMFLOAT3>	clusterMin;
+	std::vector<DirectX::XMFLOAT3>	clusterMax;
+	DirectX::XMFLOAT4X4				clusterProjection = {};
+
+	std::vector<LightSphere>	pointSpheres;
+	std::vector<LightSphere>	spotSpheres;
+
+	// スライスごとの作業領域(並列に書き込むので分けておく)
+	std::vector<std::vector<uint32_t>>	sliceIndices;
+	std::vector<std::vector<uint32_t>>	sliceCandidates;	// 深度の範囲にかかるライト(点光源、スポットライトの順)
+	std::vector<std::vector<uint32_t>>	sliceHits;			// クラスタ番号とライト番号の組
+
+	float		nearZ = 0.1f;
+	float		farZ = 1000.0f;
+	float		depthSliceScale = 1.0f;
+	float		depthSliceBias = 0.0f;
+	uint32_t	maxLightsPerCluster = 0;
+};
@@ -0,0 +1,336 @@
+#include <algorithm>
+#include "System/Misc.h"
+#include "System/MaterialTable.h"
+
+// コンストラクタ
+MaterialTable::MaterialTable(ID3D11Device* device)
+	: device(device)
+{
+}
+
+// モデルのマテリアルを登録
+void MaterialTable::Register(const std::shared_ptr<Model>& model)
+{
+	std::vector<Model::Material>& srcMaterials = model->GetMaterials();
+	if (srcMaterials.empty() || srcMaterials.front().tableIndex >= 0) return;
+
+	// 破棄されたモデルのテクスチャのアドレスが、このモデルのテクスチャに使い回されていることがあるので先に外す
+	ReleaseExpiredModels();
+
+	ModelEntry& entry = models.emplace_back();
+	entry.model = model;
+	entry.materialIndices.reserve(srcMaterials.size());
+
+	for (Model::Material& srcMaterial : srcMaterials)
+	{
+		PBR_MaterialConstants material = {};
+
+		material.emissiveFactor = srcMaterial.emissiveColor;
+		material.alphaMode = static_cast<int>(srcMaterial.alphaMode);
+		material.alphaCutoff = srcMaterial.alphaCutoff;
+		material.doubleSided = 0;
+
+		material.pbrMetallicRoughness.basecolorFactor = srcMaterial.baseColor;
+		material.pbrMetallicRoughness.metallicFactor = srcMaterial.metalness;
+		material.pbrMetallicRoughness.roughnessFactor = srcMaterial.roughness;
+		material.normalTexture.scale = 1.0f;
+		material.occlusionTexture.strength = srcMaterial.occlusionStrength;
+
+		// テクスチャの番号(PBRShader が設定するスロットの順)
+		int* textureIndices[] = {
+			&material.pbrMetallicRoughness.basecolorTexture.index,
+			&material.pbrMetallicRoughness.metallicRoughnessTexture.index,
+			&material.normalTexture.index,
+			&material.emissiveTexture.index,
+			&material.occlusionTexture.index,
+		};
+		ID3D11ShaderResourceView* textures[] = {
+			srcMaterial.baseMap.Get(),
+			srcMaterial.metalnessRoughnessMap.Get(),
+			srcMaterial.normalMap.Get(),
+			srcMaterial.emissiveMap.Get(),
+			srcMaterial.occlusionMap.Get(),
+		};
+		static_assert(_countof(textureIndices) == _countof(textures));
+
+		bool bindTextures = false;
+		for (size_t i = 0; i < _countof(textures); ++i)
+		{
+			*textureIndices[i] = AddTexture(textures[i], entry);
+			bindTextures |= *textureIndices[i] == TextureBound;
+		}
+
+		// 1つでも配列にまとめられなければ、全てのテクスチャを描画ごとに設定する
+		if (bindTextures)
+		{
+			for (size_t i = 0; i < _countof(textures); ++i)
+			{
+				if (textures[i]) *textureIndices[i] = TextureBound;
+			}
+			++entry.boundMaterialCount;
+		}
+
+		// 破棄されたモデルが空けた番号があれば使い回す
+		int tableIndex = static_cast<int>(materials.size());
+		if (!freeMaterials.empty())
+		{
+			tableIndex = freeMaterials.back();
+			freeMaterials.pop_back();
+			materials[tableIndex] = material;
+		}
+		else
+		{
+			materials.emplace_back(material);
+		}
+
+		srcMaterial.tableIndex = tableIndex;
+		srcMaterial.bindTextures = bindTextures;
+		entry.materialIndices.emplace_back(tableIndex);
+	}
+	boundMaterialCount += entry.boundMaterialCount;
+	materialsDirty = true;
+}
+
+// 破棄されたモデルのマテリアルとテクスチャを空ける
+void MaterialTable::ReleaseExpiredModels()
+{
+	for (size_t i = 0; i < models.size();)
+	{
+		ModelEntry& entry = models[i];
+		if (!entry.model.expired())
+		{
+			++i;
+			continue;
+		}
+
+		freeMaterials.insert(freeMaterials.end(), entry.materialIndices.begin(), entry.materialIndices.end());
+		boundMaterialCount -= entry.boundMaterialCount;
+		for (ID3D11Resource* resource : entry.textures)
+		{
+			ReleaseTexture(resource);
+		}
+
+		entry = std::move(models.back());
+		models.pop_back();
+	}
+}
+
+// テクスチャの参照を1つ減らす
+void MaterialTable::ReleaseTexture(ID3D11Resource* resource)
+{
+	auto it = textureIndices.find(resource);
+	_ASSERT_EXPR(it != textureIndices.end(), L"MaterialTable: released texture is not registered");
+	if (--it->second.referenceCount > 0) return;
+
+	// 使われなくなったスライスを空け、まだ写していなければ元のテクスチャも手放す
+	const UINT arrayIndex = static_cast<UINT>(it->second.index) >> 16;
+	const UINT slice = static_cast<UINT>(it->second.index) & 0xffff;
+	TextureArray& textureArray = textureArrays[arrayIndex];
+	textureArray.freeSlices.emplace_back(slice);
+	std::erase_if(textureArray.pendingSlices,
+		[slice](const TextureArray::PendingSlice& pending) { return pending.slice == slice; });
+
+	textureIndices.erase(it);
+}
+
+// テクスチャの番号を求める
+int MaterialTable::AddTexture(ID3D11ShaderResourceView* shaderResourceView, ModelEntry& entry)
+{
+	if (shaderResourceView == nullptr) return TextureNone;
+
+	Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+	shaderResourceView->GetResource(resource.GetAddressOf());
+
+	auto it = textureIndices.find(resource.Get());
+	if (it != textureIndices.end())
+	{
+		++it->second.referenceCount;
+		entry.textures.emplace_back(resource.Get());
+		return it->second.index;
+	}
+
+	// 全ミップを見る1枚の2Dテクスチャだけをまとめる
+	D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc;
+	shaderResourceView->GetDesc(&viewDesc);
+	if (viewDesc.ViewDimension != D3D11_SRV_DIMENSION_TEXTURE2D || viewDesc.Texture2D.MostDetailedMip != 0) return TextureBound;
+
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+	if (FAILED(resource->QueryInterface<ID3D11Texture2D>(texture.GetAddressOf()))) return TextureBound;
+
+	D3D11_TEXTURE2D_DESC desc;
+	texture->GetDesc(&desc);
+	if (desc.ArraySize != 1 || desc.SampleDesc.Count != 1 || (desc.MiscFlags & D3D11_RESOURCE_MISC_TEXTURECUBE) != 0) return TextureBound;
+
+	// 形式、大きさ、ミップ数が同じ配列を探し、なければ追加する
+	UINT arrayIndex = 0;
+	for (; arrayIndex < textureArrayCount; ++arrayIndex)
+	{
+		const TextureArray& textureArray = textureArrays[arrayIndex];
+		if (textureArray.textureFormat == desc.Format && textureArray.viewFormat == viewDesc.Format &&
+			textureArray.width == desc.Width && textureArray.height == desc.Height && textureArray.mipLevels == desc.MipLevels)
+		{
+			break;
+		}
+	}
+	if (arrayIndex == textureArrayCount)
+	{
+		if (textureArrayCount == MaxTextureArrays) return TextureBound;
+
+		TextureArray& textureArray = textureArrays[textureArrayCount++];
+		textureArray.textureFormat = desc.Format;
+		textureArray.viewFormat = viewDesc.Format;
+		textureArray.width = desc.Width;
+		textureArray.height = desc.Height;
+		textureArray.mipLevels = desc.MipLevels;
+	}
+
+	// 空いたスライスがあれば使い回す
+	TextureArray& textureArray = textureArrays[arrayIndex];
+	UINT slice = textureArray.sliceCount;
+	if (!textureArray.freeSlices.empty())
+	{
+		slice = textureArray.freeSlices.back();
+		textureArray.freeSlices.pop_back();
+	}
+	else
+	{
+		if (textureArray.sliceCount >= MaxArraySlices) return TextureBound;
+		++textureArray.sliceCount;
+	}
+
+	const int index = static_cast<int>((arrayIndex << 16) | slice);
+	textureArray.pendingSlices.push_back({ slice, texture });
+	textureIndices[resource.Get()] = { index, 1 };
+	entry.textures.emplace_back(resource.Get());
+	return index;
+}
+
+// GPU に反映
+void MaterialTable::Update(ID3D11DeviceContext* dc)
+{
+	// 破棄されたモデルのテクスチャは、ここで参照を外して解放できるようにする
+	ReleaseExpiredModels();
+
+	// マテリアルの構造化バッファ(足りなければ2倍ずつ大きくして作り直す)
+	if (materialsDirty)
+	{
+		const UINT count = static_cast<UINT>(materials.size());
+		if (count > bufferCapacity)
+		{
+			UINT capacity = (std::max)(bufferCapacity, 64u);
+			while (capacity < count) capacity *= 2;
+
+			D3D11_BUFFER_DESC desc = {};
+			desc.ByteWidth = sizeof(PBR_MaterialConstants) * capacity;
+			desc.Usage = D3D11_USAGE_DEFAULT;
+			desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+			desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+			desc.StructureByteStride = sizeof(PBR_MaterialConstants);
+
+			buffer.Reset();
+			HRESULT hr = device->CreateBuffer(&desc, nullptr, buffer.GetAddressOf());
+			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+			D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc = {};
+			viewDesc.Format = DXGI_FORMAT_UNKNOWN;
+			viewDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+			viewDesc.Buffer.FirstElement = 0;
+			viewDesc.Buffer.NumElements = capacity;
+
+			shaderResourceView.Reset();
+			hr = device->CreateShaderResourceView(buffer.Get(), &viewDesc, shaderResourceView.GetAddressOf());
+			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+			bufferCapacity = capacity;
+		}
+
+		D3D11_BOX box = { 0, 0, 0, sizeof(PBR_MaterialConstants) * count, 1, 1 };
+		dc->UpdateSubresource(buffer.Get(), 0, &box, materials.data(), 0, 0);
+		materialsDirty = false;
+	}
+
+	// テクスチャ配列
+	for (UINT i = 0; i < textureArrayCount; ++i)
+	{
+		if (!textureArrays[i].pendingSlices.empty())
+		{
+			UpdateTextureArray(dc, textureArrays[i], i);
+		}
+	}
+}
+
+// 追加したテクスチャを配列に写す
+void MaterialTable::UpdateTextureArray(ID3D11DeviceContext* dc, TextureArray& textureArray, UINT arrayIndex)
+{
+	const UINT count = textureArray.sliceCount;
+
+	// 入りきらなければ作り直し、前の配列のスライスを新しい配列に移す
+	if (count > textureArray.capacity)
+	{
+		UINT capacity = (std::max)(textureArray.capacity, 4u);
+		while (capacity < count) capacity *= 2;
+		capacity = (std::min)(capacity, MaxArraySlices);
+
+		D3D11_TEXTURE2D_DESC desc = {};
+		desc.Width = textureArray.width;
+		desc.Height = textureArray.height;
+		desc.MipLevels = textureArray.mipLevels;
+		desc.ArraySize = capacity;
+		desc.Format = textureArray.textureFormat;
+		desc.SampleDesc.Count = 1;
+		desc.Usage = D3D11_USAGE_DEFAULT;
+		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+		HRESULT hr = device->CreateTexture2D(&desc, nullptr, texture.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+		for (UINT slice = 0; slice < textureArray.capacity; ++slice)
+		{
+			for (UINT mip = 0; mip < textureArray.mipLevels; ++mip)
+			{
+				const UINT subresource = D3D11CalcSubresource(mip, slice, textureArray.mipLevels);
+				dc->CopySubresourceRegion(texture.Get(), subresource, 0, 0, 0, textureArray.texture.Get(), subresource, nullptr);
+			}
+		}
+
+		D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc = {};
+		viewDesc.Format = textureArray.viewFormat;
+		viewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+		viewDesc.Texture2DArray.MostDetailedMip = 0;
+		viewDesc.Texture2DArray.MipLevels = textureArray.mipLevels;
+		viewDesc.Texture2DArray.FirstArraySlice = 0;
+		viewDesc.Texture2DArray.ArraySize = capacity;
+
+		textureArray.shaderResourceView.Reset();
+		hr = device->CreateShaderResourceView(texture.Get(), &viewDesc, textureArray.shaderResourceView.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+		textureArray.texture = texture;
+		textureArray.capacity = capacity;
+		textureArrayViews[arrayIndex] = textureArray.shaderResourceView.Get();
+	}
+
+	// 追加したテクスチャ(写したら元のテクスチャの参照は手放す)
+	for (const TextureArray::PendingSlice& pending : textureArray.pendingSlices)
+	{
+		for (UINT mip = 0; mip < textureArray.mipLevels; ++mip)
+		{
+			dc->CopySubresourceRegion(textureArray.texture.Get(), D3D11CalcSubresource(mip, pending.slice, textureArray.mipLevels),
+				0, 0, 0, pending.source.Get(), mip, nullptr);
+		}
+	}
+	textureArray.pendingSlices.clear();
+}
+
+// 統計
+MaterialTable::Statistics MaterialTable::GetStatistics() const
+{
+	Statistics statistics;
+	statistics.materialCount = static_cast<UINT>(materials.size() - freeMaterials.size());
+	statistics.textureArrayCount = textureArrayCount;
+	statistics.textureCount = static_cast<UINT>(textureIndices.size());
+	statistics.boundMaterialCount = boundMaterialCount;
+	statistics.modelCount = static_cast<UINT>(models.size());
+	return statistics;
+}
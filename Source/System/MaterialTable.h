@@ -0,0 +1,127 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <wrl.h>
+#include <d3d11.h>
+#include "Model.h"
+#include "PBRMaterialConstants.h"
+
+// 読み込んだ全モデルの PBR マテリアルを1つの構造化バッファにまとめたテーブル
+// テクスチャは形式、大きさ、ミップ数が同じものをテクスチャ配列にまとめ、マテリアルには (配列 << 16 | スライス) の番号を書き込む
+// 描画ではマテリアルの番号を定数バッファで渡すだけで、テーブルとテクスチャ配列はシェーダーの Begin() で1回だけ設定する
+// 配列の数が足りないなど、まとめられなかったテクスチャを使うマテリアルは描画ごとにテクスチャを設定する
+// 登録はモデルごとに管理し、モデルが破棄されたらマテリアルとスライスを空けて、次に登録するモデルで使い回す
+class MaterialTable
+{
+public:
+	static const UINT MaxTextureArrays = 8;			// MaterialTable.hlsli の MATERIAL_TEXTURE_ARRAY_MAX と合わせる
+	static const UINT MaxArraySlices = D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION;
+	static const UINT MaterialSlot = 0;				// materials のレジスタ(t0)
+	static const UINT TextureArraySlot = 11;		// material_texture_arrays の先頭のレジスタ(t11)
+	static const int TextureNone = -1;				// テクスチャなし
+	static const int TextureBound = -2;				// 描画ごとに material_textures に設定したテクスチャを使う
+
+	MaterialTable(ID3D11Device* device);
+
+	// モデルのマテリアルを登録(登録済みなら何もしない)
+	// マテリアルの tableIndex と bindTextures を設定し、GPU への反映は Update() で行う
+	void Register(const std::shared_ptr<Model>& model);
+
+	// 破棄されたモデルの登録を外し、登録したマテリアルとテクスチャを GPU に反映(描画の記録を始める前に呼ぶ)
+	void Update(ID3D11DeviceContext* dc);
+
+	// マテリアルの構造化バッファ取得(1つも登録していなければ nullptr)
+	ID3D11ShaderResourceView* GetShaderResourceView() const { return shaderResourceView.Get(); }
+
+	// テクスチャ配列取得(MaxTextureArrays 個、使っていない配列は nullptr)
+	ID3D11ShaderResourceView* const* GetTextureArrayViews() const { return textureArrayViews; }
+
+	// 統計
+	struct Statistics
+	{
+		UINT	materialCount = 0;			// 登録したマテリアル数
+		UINT	textureArrayCount = 0;		// テクスチャ配列の数
+		UINT	textureCount = 0;			// テクスチャ配列にまとめたテクスチャ数
+		UINT	modelCount = 0;				// 登録中のモデル数
+		UINT	boundMaterialCount = 0;		// 描画ごとにテクスチャを設定するマテリアル数
+	};
+	Statistics GetStatistics() const;
+
+private:
+	// 形式、大きさ、ミップ数が同じテクスチャをまとめた配列
+	struct TextureArray
+	{
+		DXGI_FORMAT											textureFormat = DXGI_FORMAT_UNKNOWN;
+		DXGI_FORMAT											viewFormat = DXGI_FORMAT_UNKNOWN;
+		UINT												width = 0;
+		UINT												height = 0;
+		UINT												mipLevels = 0;
+
+		// 配列にまだ写していないテクスチャ(写したら参照を手放す)
+		struct PendingSlice
+		{
+			UINT										slice;
+			Microsoft::WRL::ComPtr<ID3D11Texture2D>		source;
+		};
+		std::vector<PendingSlice>							pendingSlices;
+		std::vector<UINT>									freeSlices;		// 空いたスライス
+		UINT												sliceCount = 0;	// 使ったことのあるスライス数
+		UINT												capacity = 0;	// 配列のスライス数
+		Microsoft::WRL::ComPtr<ID3D11Texture2D>				texture;
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	shaderResourceView;
+	};
+
+	// 配列にまとめたテクスチャ
+	struct TextureEntry
+	{
+		int		index = 0;			// (配列 << 16 | スライス)
+		UINT	referenceCount = 0;	// 使っているマテリアルのテクスチャ数
+	};
+
+	// 登録したモデル
+	struct ModelEntry
+	{
+		std::weak_ptr<Model>			model;
+		std::vector<int>				materialIndices;	// 使っているマテリアルの番号
+		std::vector<ID3D11Resource*>	textures;			// 参照を数えたテクスチャ(参照ごとに1つ)
+		UINT							boundMaterialCount = 0;
+	};
+
+	// テクスチャの番号を求める(なければ TextureNone、配列にまとめられなければ TextureBound)
+	// 配列にまとめたテクスチャは参照を数え、entry に記録する
+	int AddTexture(ID3D11ShaderResourceView* shaderResourceView, ModelEntry& entry);
+
+	// テクスチャの参照を1つ減らし、使われなくなったらスライスを空ける
+	void ReleaseTexture(ID3D11Resource* resource);
+
+	// 破棄されたモデルのマテリアルとテクスチャを空ける
+	void ReleaseExpiredModels();
+
+	// 追加したテクスチャを配列に写す(入りきらなければ配列を作り直す)
+	void UpdateTextureArray(ID3D11DeviceContext* dc, TextureArray& textureArray, UINT arrayIndex);
+
+private:
+	ID3D11Device*										device;
+
+	// マテリアル
+	std::vector<PBR_MaterialConstants>					materials;
+	std::vector<int>									freeMaterials;		// 空いたマテリアルの番号
+	bool												materialsDirty = false;
+	UINT												bufferCapacity = 0;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				buffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	shaderResourceView;
+	UINT												boundMaterialCount = 0;
+
+	// 登録中のモデル
+	std::vector<ModelEntry>								models;
+
+	// テクスチャ配列
+	// 元のテクスチャは登録中のモデルが参照を持つので、textureIndices のアドレスが別のテクスチャに使い回されることはない
+	// (モデルが破棄されたら、次のモデルを登録する前に ReleaseExpiredModels() で外す)
+	TextureArray										textureArrays[MaxTextureArrays];
+	UINT												textureArrayCount = 0;
+	ID3D11ShaderResourceView*							textureArrayViews[MaxTextureArrays] = {};
+	std::map<ID3D11Resource*, TextureEntry>				textureIndices;
+};
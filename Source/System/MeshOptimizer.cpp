@@ -0,0 +1,322 @@
+#include <algorithm>
+#include <cmath>
+#include "System/MeshOptimizer.h"
+
+namespace
+{
+	// Forsyth の手法で使う LRU キャッシュのサイズと重み
+	const int ScoringCacheSize = 32;
+	const float CacheDecayPower = 1.5f;
+	const float LastTriangleScore = 0.75f;
+	const float ValenceBoostScale = 2.0f;
+	const float ValenceBoostPower = 0.5f;
+
+	// 頂点のスコア(キャッシュ内の位置と、まだ描いていない三角形の数から求める)
+	float VertexScore(int cachePosition, uint32_t remainingTriangles)
+	{
+		if (remainingTriangles == 0) return -1.0f;
+
+		float score = 0.0f;
+		if (cachePosition >= 0)
+		{
+			if (cachePosition < 3)
+			{
+				// 直前の三角形の頂点は、どの順で使っても同じなので一定値にする
+				score = LastTriangleScore;
+			}
+			else
+			{
+				const float scaler = 1.0f / (ScoringCacheSize - 3);
+				score = std::pow(1.0f - (cachePosition - 3) * scaler, CacheDecayPower);
+			}
+		}
+
+		// 残りの三角形が少ない頂点を優先して使い切る
+		score += ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+		return score;
+	}
+
+	// 三角形の面積で重み付けした法線(正規化しない)
+	DirectX::XMFLOAT3 TriangleNormal(const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2)
+	{
+		const float e1x = p1.x - p0.x, e1y = p1.y - p0.y, e1z = p1.z - p0.z;
+		const float e2x = p2.x - p0.x, e2y = p2.y - p0.y, e2z = p2.z - p0.z;
+		return DirectX::XMFLOAT3(e1y * e2z - e1z * e2y, e1z * e2x - e1x * e2z, e1x * e2y - e1y * e2x);
+	}
+}
+
+// 頂点キャッシュに当たりやすいよう三角形を並べ替える
+void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0) return;
+
+	// 頂点ごとの三角形リスト
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (size_t i = 0; i < triangleCount * 3; ++i) ++adjacencyOffsets[indices[i] + 1];
+	for (size_t i = 0; i < vertexCount; ++i) adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+		{
+			adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<uint32_t> remainingTriangles(vertexCount);
+	std::vector<int> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		remainingTriangles[v] = adjacencyOffsets[v + 1] - adjacencyOffsets[v];
+		vertexScores[v] = VertexScore(-1, remainingTriangles[v]);
+	}
+
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<uint8_t> emitted(triangleCount, 0);
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+	}
+
+	std::vector<uint32_t> result;
+	result.reserve(triangleCount * 3);
+
+	// キャッシュ(先頭が最新)。追加した3頂点ぶんはみ出すので余分に確保する
+	std::vector<uint32_t> cache, nextCache;
+	cache.reserve(ScoringCacheSize + 3);
+	nextCache.reserve(ScoringCacheSize + 3);
+
+	size_t scanCursor = 0;
+	int64_t bestTriangle = -1;
+	for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+	{
+		// キャッシュ内に候補がなければ、スコアが最も高い未出力の三角形を探す
+		if (bestTriangle < 0)
+		{
+			float bestScore = -1.0f;
+			while (scanCursor < triangleCount && emitted[scanCursor]) ++scanCursor;
+			for (size_t t = scanCursor; t < triangleCount; ++t)
+			{
+				if (!emitted[t] && triangleScores[t] > bestScore)
+				{
+					bestScore = triangleScores[t];
+					bestTriangle = static_cast<int64_t>(t);
+				}
+			}
+		}
+
+		const uint32_t* triangle = &indices[bestTriangle * 3];
+		result.insert(result.end(), triangle, triangle + 3);
+		emitted[bestTriangle] = 1;
+
+		// 出力した三角形を頂点の三角形リストから外す
+		for (int k = 0; k < 3; ++k)
+		{
+			const uint32_t v = triangle[k];
+			uint32_t* begin = &adjacency[adjacencyOffsets[v]];
+			uint32_t* end = begin + remainingTriangles[v];
+			std::iter_swap(std::find(begin, end, static_cast<uint32_t>(bestTriangle)), end - 1);
+			--remainingTriangles[v];
+		}
+
+		// 出力した頂点をキャッシュの先頭に移す
+		nextCache.assign(triangle, triangle + 3);
+		for (uint32_t v : cache)
+		{
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2]) nextCache.push_back(v);
+		}
+		for (size_t i = ScoringCacheSize; i < nextCache.size(); ++i)
+		{
+			cachePositions[nextCache[i]] = -1;
+			vertexScores[nextCache[i]] = VertexScore(-1, remainingTriangles[nextCache[i]]);
+		}
+		nextCache.resize((std::min)(nextCache.size(), static_cast<size_t>(ScoringCacheSize)));
+		cache.swap(nextCache);
+
+		// キャッシュ内の頂点のスコアを更新し、それを使う三角形から次の候補を選ぶ
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			cachePositions[cache[i]] = static_cast<int>(i);
+			vertexScores[cache[i]] = VertexScore(static_cast<int>(i), remainingTriangles[cache[i]]);
+		}
+
+		bestTriangle = -1;
+		float bestScore = -1.0f;
+		for (uint32_t v : cache)
+		{
+			const uint32_t* begin = &adjacency[adjacencyOffsets[v]];
+			for (uint32_t a = 0; a < remainingTriangles[v]; ++a)
+			{
+				const uint32_t t = begin[a];
+				const float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+				triangleScores[t] = score;
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestTriangle = t;
+				}
+			}
+		}
+	}
+
+	std::copy(result.begin(), result.end(), indices);
+}
+
+// キャッシュ効率を保ったまま、外側を向いたクラスタが先に描かれるよう並べ替える
+void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+	const DirectX::XMFLOAT3* positions, size_t positionStride, size_t vertexCount)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0) return;
+
+	auto position = [&](uint32_t index) -> const DirectX::XMFLOAT3&
+	{
+		return *reinterpret_cast<const DirectX::XMFLOAT3*>(
+			reinterpret_cast<const uint8_t*>(positions) + positionStride * index);
+	};
+
+	// キャッシュを再現し、3頂点ともミスした三角形(キャッシュの流れが切れる位置)でクラスタを区切る
+	std::vector<size_t> clusterStarts;
+	{
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		uint32_t time = CacheSize + 1;
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			int misses = 0;
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t v = indices[t * 3 + k];
+				if (time - timestamps[v] > CacheSize)
+				{
+					timestamps[v] = time++;
+					++misses;
+				}
+			}
+			if (t == 0 || misses == 3) clusterStarts.push_back(t);
+		}
+	}
+
+	// メッシュ全体の重心
+	double meshCenter[3] = { 0, 0, 0 };
+	double meshArea = 0;
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		const DirectX::XMFLOAT3& p0 = position(indices[t * 3]);
+		const DirectX::XMFLOAT3& p1 = position(indices[t * 3 + 1]);
+		const DirectX::XMFLOAT3& p2 = position(indices[t * 3 + 2]);
+		const DirectX::XMFLOAT3 n = TriangleNormal(p0, p1, p2);
+		const double area = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+		meshCenter[0] += area * (p0.x + p1.x + p2.x) / 3;
+		meshCenter[1] += area * (p0.y + p1.y + p2.y) / 3;
+		meshCenter[2] += area * (p0.z + p1.z + p2.z) / 3;
+		meshArea += area;
+	}
+	if (meshArea > 0)
+	{
+		meshCenter[0] /= meshArea;
+		meshCenter[1] /= meshArea;
+		meshCenter[2] /= meshArea;
+	}
+
+	// クラスタの重心が法線方向へどれだけ外側にあるか(大きいほど他を隠しやすい)
+	struct Cluster
+	{
+		size_t	start;
+		size_t	count;
+		float	sortKey;
+	};
+	std::vector<Cluster> clusters(clusterStarts.size());
+	for (size_t c = 0; c < clusterStarts.size(); ++c)
+	{
+		Cluster& cluster = clusters[c];
+		cluster.start = clusterStarts[c];
+		cluster.count = (c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : triangleCount) - cluster.start;
+
+		double center[3] = { 0, 0, 0 }, normal[3] = { 0, 0, 0 };
+		double area = 0;
+		for (size_t t = cluster.start; t < cluster.start + cluster.count; ++t)
+		{
+			const DirectX::XMFLOAT3& p0 = position(indices[t * 3]);
+			const DirectX::XMFLOAT3& p1 = position(indices[t * 3 + 1]);
+			const DirectX::XMFLOAT3& p2 = position(indices[t * 3 + 2]);
+			const DirectX::XMFLOAT3 n = TriangleNormal(p0, p1, p2);
+			const double triangleArea = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+			center[0] += triangleArea * (p0.x + p1.x + p2.x) / 3;
+			center[1] += triangleArea * (p0.y + p1.y + p2.y) / 3;
+			center[2] += triangleArea * (p0.z + p1.z + p2.z) / 3;
+			normal[0] += n.x;
+			normal[1] += n.y;
+			normal[2] += n.z;
+			area += triangleArea;
+		}
+
+		const double normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (area > 0 && normalLength > 0)
+		{
+			cluster.sortKey = static_cast<float>(
+				((center[0] / area - meshCenter[0]) * normal[0] +
+				 (center[1] / area - meshCenter[1]) * normal[1] +
+				 (center[2] / area - meshCenter[2]) * normal[2]) / normalLength);
+		}
+		else
+		{
+			cluster.sortKey = 0.0f;
+		}
+	}
+
+	std::stable_sort(clusters.begin(), clusters.end(),
+		[](const Cluster& lhs, const Cluster& rhs) { return lhs.sortKey > rhs.sortKey; });
+
+	std::vector<uint32_t> result;
+	result.reserve(triangleCount * 3);
+	for (const Cluster& cluster : clusters)
+	{
+		result.insert(result.end(), indices + cluster.start * 3, indices + (cluster.start + cluster.count) * 3);
+	}
+	std::copy(result.begin(), result.end(), indices);
+}
+
+// 最初に参照される順に頂点を並べるための対応表を作り、インデックスを付け替える
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount)
+{
+	const uint32_t Unused = ~0u;
+	std::vector<uint32_t> newIndices(vertexCount, Unused);
+	std::vector<uint32_t> remap;
+	remap.reserve(vertexCount);
+
+	for (size_t i = 0; i < indexCount; ++i)
+	{
+		uint32_t& newIndex = newIndices[indices[i]];
+		if (newIndex == Unused)
+		{
+			newIndex = static_cast<uint32_t>(remap.size());
+			remap.push_back(indices[i]);
+		}
+		indices[i] = newIndex;
+	}
+	return remap;
+}
+
+// 平均キャッシュミス率を計算
+float MeshOptimizer::ComputeAcmr(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0) return 0.0f;
+
+	// FIFO キャッシュ(入った時刻が CacheSize 以上前なら追い出されている)
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	uint32_t time = CacheSize + 1;
+	size_t misses = 0;
+	for (size_t i = 0; i < triangleCount * 3; ++i)
+	{
+		const uint32_t v = indices[i];
+		if (time - timestamps[v] > CacheSize)
+		{
+			timestamps[v] = time++;
+			++misses;
+		}
+	}
+	return static_cast<float>(misses) / triangleCount;
+}
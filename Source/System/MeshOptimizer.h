@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+// GPU向けのインデックス・頂点の並べ替え
+// 頂点変換後キャッシュに当たりやすい三角形の順序、手前から描かれやすいクラスタの順序、
+// 頂点フェッチが連続するような頂点の順序を求める
+class MeshOptimizer
+{
+public:
+	// 頂点キャッシュの評価に使うキャッシュサイズ(一般的なGPUのFIFO相当)
+	static const size_t CacheSize = 16;
+
+	// 頂点キャッシュに当たりやすいよう三角形を並べ替える(Forsyth の手法)
+	static void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+	// キャッシュ効率を保ったまま、外側を向いたクラスタが先に描かれるよう並べ替える
+	// OptimizeVertexCache() を通した後のインデックスに使う
+	static void OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+		const DirectX::XMFLOAT3* positions, size_t positionStride, size_t vertexCount);
+
+	// 最初に参照される順に頂点を並べるための対応表を作り、インデックスを付け替える
+	// 戻り値は新しい頂点番号から元の頂点番号への対応表(参照されない頂点は含まない)
+	static std::vector<uint32_t> OptimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+	// 平均キャッシュミス率(三角形あたりの頂点変換回数、0.5～3.0)を計算
+	static float ComputeAcmr(const uint32_t* indices, size_t indexCount, size_t vertexCount);
+};
@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include "System/MeshSimplifier.h"
+
+namespace
+{
+	// 二次誤差(平面からの距離の二乗和を x^T A x + 2 b・x + c の形で持つ)
+	struct Quadric
+	{
+		double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+		double b0 = 0, b1 = 0, b2 = 0;
+		double c = 0;
+
+		// 平面 n・p + d = 0 を追加
+		void AddPlane(double nx, double ny, double nz, double d)
+		{
+			a00 += nx * nx; a01 += nx * ny; a02 += nx * nz;
+			a11 += ny * ny; a12 += ny * nz;
+			a22 += nz * nz;
+			b0 += nx * d; b1 += ny * d; b2 += nz * d;
+			c += d * d;
+		}
+
+		void Add(const Quadric& q)
+		{
+			a00 += q.a00; a01 += q.a01; a02 += q.a02;
+			a11 += q.a11; a12 += q.a12;
+			a22 += q.a22;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+		}
+
+		// 点 p での誤差
+		double Evaluate(const DirectX::XMFLOAT3& p) const
+		{
+			const double x = p.x, y = p.y, z = p.z;
+			const double error =
+				a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z +
+				a11 * y * y + 2 * a12 * y * z +
+				a22 * z * z +
+				2 * (b0 * x + b1 * y + b2 * z) + c;
+			return error > 0 ? error : 0;
+		}
+	};
+
+	// 縮約の候補
+	struct Collapse
+	{
+		uint32_t	from;		// 縮約元の頂点
+		uint32_t	to;			// 縮約先の頂点
+		double		error;
+	};
+
+	// 座標をキーにした検索用
+	struct PositionKey
+	{
+		uint32_t x, y, z;
+
+		bool operator==(const PositionKey& other) const
+		{
+			return x == other.x && y == other.y && z == other.z;
+		}
+	};
+
+	struct PositionKeyHash
+	{
+		size_t operator()(const PositionKey& key) const
+		{
+			return (key.x * 73856093u) ^ (key.y * 19349663u) ^ (key.z * 83492791u);
+		}
+	};
+
+	// 三角形の法線(正規化しない)
+	DirectX::XMFLOAT3 TriangleNormal(const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2)
+	{
+		const float e1x = p1.x - p0.x, e1y = p1.y - p0.y, e1z = p1.z - p0.z;
+		const float e2x = p2.x - p0.x, e2y = p2.y - p0.y, e2z = p2.z - p0.z;
+		return DirectX::XMFLOAT3(e1y * e2z - e1z * e2y, e1z * e2x - e1x * e2z, e1x * e2y - e1y * e2x);
+	}
+}
+
+// 簡略化したインデックス列を作成
+std::vector<uint32_t> MeshSimplifier::Simplify(
+	const DirectX::XMFLOAT3* positions, size_t positionStride, size_t vertexCount,
+	const std::vector<uint32_t>& indices, size_t targetIndexCount, float maxError,
+	float* resultError)
+{
+	std::vector<uint32_t> result(indices);
+	if (resultError != nullptr) *resultError = 0.0f;
+	if (result.size() <= targetIndexCount || vertexCount == 0) return result;
+
+	auto position = [&](uint32_t index) -> const DirectX::XMFLOAT3&
+	{
+		return *reinterpret_cast<const DirectX::XMFLOAT3*>(
+			reinterpret_cast<const uint8_t*>(positions) + positionStride * index);
+	};
+
+	// 同じ座標の頂点(UVや法線の継ぎ目で分かれた頂点)を代表の頂点にまとめ、継ぎ目は固定する
+	std::vector<uint32_t> canonical(vertexCount);
+	std::vector<uint8_t> locked(vertexCount, 0);
+	{
+		std::unordered_map<PositionKey, uint32_t, PositionKeyHash> table;
+		table.reserve(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; ++i)
+		{
+			PositionKey key;
+			std::memcpy(&key, &position(i), sizeof(key));
+			auto inserted = table.emplace(key, i);
+			canonical[i] = inserted.first->second;
+			if (!inserted.second) locked[canonical[i]] = 1;
+		}
+	}
+
+	// メッシュの大きさ(誤差の基準)
+	DirectX::XMFLOAT3 boundsMin = position(0), boundsMax = position(0);
+	for (uint32_t i = 1; i < vertexCount; ++i)
+	{
+		const DirectX::XMFLOAT3& p = position(i);
+		boundsMin.x = (std::min)(boundsMin.x, p.x); boundsMax.x = (std::max)(boundsMax.x, p.x);
+		boundsMin.y = (std::min)(boundsMin.y, p.y); boundsMax.y = (std::max)(boundsMax.y, p.y);
+		boundsMin.z = (std::min)(boundsMin.z, p.z); boundsMax.z = (std::max)(boundsMax.z, p.z);
+	}
+	const double extent = (std::max)({ boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z, 1e-6f });
+	const double errorLimit = (maxError * extent) * (maxError * extent);
+
+	// 面の平面を頂点の二次誤差に集める
+	std::vector<Quadric> quadrics(vertexCount);
+	std::unordered_map<uint64_t, uint32_t> edgeCounts;
+	for (size_t i = 0; i + 2 < result.size(); i += 3)
+	{
+		const uint32_t v[3] = { canonical[result[i]], canonical[result[i + 1]], canonical[result[i + 2]] };
+
+		const DirectX::XMFLOAT3 n = TriangleNormal(position(v[0]), position(v[1]), position(v[2]));
+		const double length = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+		if (length > 0)
+		{
+			const double nx = n.x / length, ny = n.y / length, nz = n.z / length;
+			const DirectX::XMFLOAT3& p = position(v[0]);
+			const double d = -(nx * p.x + ny * p.y + nz * p.z);
+			for (uint32_t vertex : v)
+			{
+				quadrics[vertex].AddPlane(nx, ny, nz, d);
+			}
+		}
+
+		for (int e = 0; e < 3; ++e)
+		{
+			const uint32_t a = (std::min)(v[e], v[(e + 1) % 3]);
+			const uint32_t b = (std::max)(v[e], v[(e + 1) % 3]);
+			++edgeCounts[(uint64_t(a) << 32) | b];
+		}
+	}
+
+	// 2枚の三角形で共有されていない辺(境界や非多様体)の頂点は固定する
+	for (const auto& edgeCount : edgeCounts)
+	{
+		if (edgeCount.second != 2)
+		{
+			locked[edgeCount.first >> 32] = 1;
+			locked[edgeCount.first & 0xFFFFFFFF] = 1;
+		}
+	}
+
+	std::vector<uint32_t> remap(vertexCount);
+	for (uint32_t i = 0; i < vertexCount; ++i) remap[i] = i;
+
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+	std::vector<uint32_t> adjacency;
+	std::vector<Collapse> collapses;
+	std::vector<uint8_t> touched(vertexCount);
+	double worstError = 0;
+
+	// 候補を誤差順に並べ、互いに影響しない縮約をまとめて行うことを繰り返す
+	while (result.size() > targetIndexCount)
+	{
+		const size_t triangleCount = result.size() / 3;
+
+		// 頂点ごとの三角形リスト
+		std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+		for (uint32_t index : result) ++adjacencyOffsets[canonical[index] + 1];
+		for (size_t i = 0; i < vertexCount; ++i) adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+		adjacency.resize(result.size());
+		{
+			std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i = 0; i < result.size(); ++i)
+			{
+				adjacency[cursor[canonical[result[i]]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		collapses.clear();
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int e = 0; e < 3; ++e)
+			{
+				const uint32_t i0 = result[i + e];
+				const uint32_t i1 = result[i + (e + 1) % 3];
+				const uint32_t c0 = canonical[i0];
+				const uint32_t c1 = canonical[i1];
+
+				Quadric q = quadrics[c0];
+				q.Add(quadrics[c1]);
+				if (!locked[c0]) collapses.push_back({ i0, i1, q.Evaluate(position(c1)) });
+				if (!locked[c1]) collapses.push_back({ i1, i0, q.Evaluate(position(c0)) });
+			}
+		}
+		if (collapses.empty()) break;
+
+		std::sort(collapses.begin(), collapses.end(),
+			[](const Collapse& lhs, const Collapse& rhs) { return lhs.error < rhs.error; });
+
+		// 縮約1回でおよそ2枚減るので、目標を超えて減らしすぎないように回数を抑える
+		const size_t collapseGoal = (std::max)((triangleCount - targetIndexCount / 3) / 2, size_t(1));
+		size_t collapseCount = 0;
+		std::fill(touched.begin(), touched.end(), 0);
+
+		for (const Collapse& collapse : collapses)
+		{
+			if (collapseCount >= collapseGoal || collapse.error > errorLimit) break;
+
+			const uint32_t from = canonical[collapse.from];
+			const uint32_t to = canonical[collapse.to];
+			if (touched[from] || touched[to]) continue;
+
+			// 縮約元を含む三角形が裏返らないか確認
+			bool flipped = false;
+			for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1] && !flipped; ++a)
+			{
+				const size_t t = adjacency[a] * 3;
+				uint32_t v[3] = { canonical[result[t]], canonical[result[t + 1]], canonical[result[t + 2]] };
+				if (v[0] == to || v[1] == to || v[2] == to) continue;	// 縮約で消える三角形
+
+				const DirectX::XMFLOAT3 before = TriangleNormal(position(v[0]), position(v[1]), position(v[2]));
+				for (uint32_t& vertex : v)
+				{
+					if (vertex == from) vertex = to;
+				}
+				const DirectX::XMFLOAT3 after = TriangleNormal(position(v[0]), position(v[1]), position(v[2]));
+				flipped = before.x * after.x + before.y * after.y + before.z * after.z <= 0.0f;
+			}
+			if (flipped) continue;
+
+			// 周囲の三角形の形が変わるので、このパスでは周囲の頂点も動かさない
+			for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; ++a)
+			{
+				const size_t t = adjacency[a] * 3;
+				touched[canonical[result[t]]] = 1;
+				touched[canonical[result[t + 1]]] = 1;
+				touched[canonical[result[t + 2]]] = 1;
+			}
+			touched[to] = 1;
+
+			remap[collapse.from] = collapse.to;
+			quadrics[to].Add(quadrics[from]);
+			worstError = (std::max)(worstError, collapse.error);
+			++collapseCount;
+		}
+		if (collapseCount == 0) break;
+
+		// インデックスを付け替えて、縮退した三角形を取り除く
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const uint32_t i0 = remap[result[i]];
+			const uint32_t i1 = remap[result[i + 1]];
+			const uint32_t i2 = remap[result[i + 2]];
+			const uint32_t c0 = canonical[i0], c1 = canonical[i1], c2 = canonical[i2];
+			if (c0 == c1 || c1 == c2 || c2 == c0) continue;
+
+			result[write++] = i0;
+			result[write++] = i1;
+			result[write++] = i2;
+		}
+		result.resize(write);
+	}
+
+	if (resultError != nullptr)
+	{
+		*resultError = static_cast<float>(std::sqrt(worstError) / extent);
+	}
+	return result;
+}
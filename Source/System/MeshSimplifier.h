@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+// メッシュ簡略化
+// 二次誤差が小さい辺から順に、一方の頂点をもう一方へ縮約していく
+// 頂点の追加や移動はせず新しいインデックス列だけを作るので、頂点バッファは元のメッシュと共有できる
+// 境界の頂点と、UVの継ぎ目などで同じ座標に複数ある頂点は動かさない
+class MeshSimplifier
+{
+public:
+	// 簡略化したインデックス列を作成
+	// targetIndexCount まで減らすか、誤差が maxError を超える手前で止める
+	// maxError と resultError はメッシュの境界ボックスの最大辺に対する割合
+	static std::vector<uint32_t> Simplify(
+		const DirectX::XMFLOAT3* positions, size_t positionStride, size_t vertexCount,
+		const std::vector<uint32_t>& indices, size_t targetIndexCount, float maxError,
+		float* resultError = nullptr);
+};
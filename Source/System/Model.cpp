@@ -1,5 +1,13 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <DirectXPackedVector.h>
 #include <cereal/cereal.hpp>
 #include <cereal/archives/binary.hpp>
 #include <cereal/types/string.hpp>
@@ -7,18 +15,120 @@
 #include "Misc.h"
 #include "GLTFImporter.h"
 #include "GpuResourceUtils.h"
+#include "JobSystem.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "Model.h"
 
-const std::vector<D3D11_INPUT_ELEMENT_DESC> Model::InputElementDescs =
+CEREAL_CLASS_VERSION(Model::Mesh, 2)
+
+// LOD自動生成の設定
+static const size_t LodMinTriangleCount = 256;				// これより三角形が少ないメッシュには作らない
+static const float LodIndexRatios[] = { 0.5f, 0.25f };		// LOD1以降のインデックス数(LOD0に対する割合)
+static const float LodMaxError = 0.05f;						// 許容する誤差(メッシュの大きさに対する割合)
+
+// LODを切り替える画面サイズに持たせる幅(割合)
+static const float LodHysteresis = 0.1f;
+
+// 静的メッシュ用の入力レイアウト
+static const std::vector<D3D11_INPUT_ELEMENT_DESC> StaticInputElementDescs =
+{
+	{ "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "NORMAL",       0, DXGI_FORMAT_R16G16_SNORM,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TANGENT",      0, DXGI_FORMAT_R8G8B8A8_SNORM,     0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+};
+
+// スキンメッシュ用の入力レイアウト
+static const std::vector<D3D11_INPUT_ELEMENT_DESC> SkinnedInputElementDescs =
 {
 	{ "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "NORMAL",       0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "TANGENT",      0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "TEXCOORD",     0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "BONE_WEIGHTS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	{ "BONE_INDICES", 0, DXGI_FORMAT_R32G32B32A32_UINT,  0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "NORMAL",       0, DXGI_FORMAT_R16G16_SNORM,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TANGENT",      0, DXGI_FORMAT_R8G8B8A8_SNORM,     0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "BONE_WEIGHTS", 0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "BONE_INDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT,      0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 };
 
+static_assert(sizeof(Model::StaticVertex) == 24, "StaticVertex must match StaticInputElementDescs");
+static_assert(sizeof(Model::SkinnedVertex) == 32, "SkinnedVertex must match SkinnedInputElementDescs");
+
+// 単位ベクトルを八面体に写像して2成分にする
+static void EncodeOctahedral(const DirectX::XMFLOAT3& v, float& x, float& y)
+{
+	const float length = std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z);
+	if (length <= 0.0f)
+	{
+		x = y = 0.0f;
+		return;
+	}
+
+	x = v.x / length;
+	y = v.y / length;
+	if (v.z < 0.0f)
+	{
+		// 下半分は対角線で折り返す
+		const float fx = x, fy = y;
+		x = (1.0f - std::fabs(fy)) * (fx >= 0.0f ? 1.0f : -1.0f);
+		y = (1.0f - std::fabs(fx)) * (fy >= 0.0f ? 1.0f : -1.0f);
+	}
+}
+
+static int16_t ToSnorm16(float value)
+{
+	return static_cast<int16_t>(std::lround((std::clamp)(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+static int8_t ToSnorm8(float value)
+{
+	return static_cast<int8_t>(std::lround((std::clamp)(value, -1.0f, 1.0f) * 127.0f));
+}
+
+// 頂点の共通部分を圧縮
+template<class PackedVertex>
+static void PackVertex(const Model::Vertex& vertex, PackedVertex& packed)
+{
+	packed.position = vertex.position;
+
+	float x, y;
+	EncodeOctahedral(vertex.normal, x, y);
+	packed.normal[0] = ToSnorm16(x);
+	packed.normal[1] = ToSnorm16(y);
+
+	EncodeOctahedral(DirectX::XMFLOAT3(vertex.tangent.x, vertex.tangent.y, vertex.tangent.z), x, y);
+	packed.tangent[0] = ToSnorm8(x);
+	packed.tangent[1] = ToSnorm8(y);
+	packed.tangent[2] = vertex.tangent.w < 0.0f ? -127 : 127;
+	packed.tangent[3] = 0;
+
+	packed.texcoord[0] = DirectX::PackedVector::XMConvertFloatToHalf(vertex.texcoord.x);
+	packed.texcoord[1] = DirectX::PackedVector::XMConvertFloatToHalf(vertex.texcoord.y);
+}
+
+// ボーンの重みを合計が255になるよう量子化
+static void PackBoneWeights(const DirectX::XMFLOAT4& weight, uint8_t packed[4])
+{
+	const float weights[4] = { weight.x, weight.y, weight.z, weight.w };
+	const float sum = weights[0] + weights[1] + weights[2] + weights[3];
+	if (sum <= 0.0f)
+	{
+		packed[0] = 255;
+		packed[1] = packed[2] = packed[3] = 0;
+		return;
+	}
+
+	int total = 0, largest = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		packed[i] = static_cast<uint8_t>(std::lround((std::clamp)(weights[i] / sum, 0.0f, 1.0f) * 255.0f));
+		total += packed[i];
+		if (packed[i] > packed[largest]) largest = i;
+	}
+
+	// 丸めの誤差は最も大きい重みで吸収する
+	packed[largest] = static_cast<uint8_t>(packed[largest] + (255 - total));
+}
+
 namespace DirectX
 {
 	template<class Archive>
@@ -141,7 +251,16 @@ void Model::Bone::serialize(Archive& archive)
 }
 
 template<class Archive>
-void Model::Mesh::serialize(Archive& archive)
+void Model::Lod::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(indexStart),
+		CEREAL_NVP(indexCount)
+	);
+}
+
+template<class Archive>
+void Model::Mesh::serialize(Archive& archive, int version)
 {
 	archive(
 		CEREAL_NVP(vertices),
@@ -150,6 +269,126 @@ void Model::Mesh::serialize(Archive& archive)
 		CEREAL_NVP(nodeIndex),
 		CEREAL_NVP(materialIndex)
 	);
+
+	if (version >= 1)
+	{
+		archive(
+			CEREAL_NVP(boundsMin),
+			CEREAL_NVP(boundsMax)
+		);
+	}
+	else
+	{
+		// 範囲を保存していない古いファイルは読み込み時に計算する
+		ComputeBounds();
+	}
+
+	if (version >= 2)
+	{
+		archive(
+			CEREAL_NVP(lodIndices),
+			CEREAL_NVP(lods)
+		);
+	}
+	else
+	{
+		// LODを保存していない古いファイルは読み込み時に作成する
+		GenerateLods();
+	}
+}
+
+// 頂点座標から範囲を計算
+void Model::Mesh::ComputeBounds()
+{
+	if (vertices.empty())
+	{
+		boundsMin = boundsMax = { 0, 0, 0 };
+		return;
+	}
+
+	DirectX::XMVECTOR Min = DirectX::XMLoadFloat3(&vertices.front().position);
+	DirectX::XMVECTOR Max = Min;
+	for (const Vertex& vertex : vertices)
+	{
+		DirectX::XMVECTOR P = DirectX::XMLoadFloat3(&vertex.position);
+		Min = DirectX::XMVectorMin(Min, P);
+		Max = DirectX::XMVectorMax(Max, P);
+	}
+	DirectX::XMStoreFloat3(&boundsMin, Min);
+	DirectX::XMStoreFloat3(&boundsMax, Max);
+}
+
+// 簡略化したインデックスを作成してLODを追加
+void Model::Mesh::GenerateLods()
+{
+	lodIndices.clear();
+	lods.clear();
+	if (indices.size() / 3 < LodMinTriangleCount) return;
+
+	size_t previousIndexCount = indices.size();
+	for (float ratio : LodIndexRatios)
+	{
+		const size_t targetIndexCount = static_cast<size_t>(indices.size() * ratio) / 3 * 3;
+		std::vector<uint32_t> simplified = MeshSimplifier::Simplify(
+			&vertices.front().position, sizeof(Vertex), vertices.size(),
+			indices, targetIndexCount, LodMaxError);
+
+		// 誤差の範囲内で前のLODから1割も減らせなければ打ち切る
+		if (simplified.size() > previousIndexCount * 9 / 10) break;
+
+		Lod& lod = lods.emplace_back();
+		lod.indexStart = static_cast<uint32_t>(indices.size() + lodIndices.size());
+		lod.indexCount = static_cast<uint32_t>(simplified.size());
+		lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+		previousIndexCount = simplified.size();
+	}
+}
+
+// GPU向けに三角形と頂点を並べ替える
+void Model::Mesh::Optimize()
+{
+	if (indices.empty()) return;
+
+	// 三角形の順序(LOD0 はオーバードローも考慮する)
+	MeshOptimizer::OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+	MeshOptimizer::OptimizeOverdraw(indices.data(), indices.size(),
+		&vertices.front().position, sizeof(Vertex), vertices.size());
+	for (const Lod& lod : lods)
+	{
+		uint32_t* lodIndexData = lodIndices.data() + (lod.indexStart - indices.size());
+		MeshOptimizer::OptimizeVertexCache(lodIndexData, lod.indexCount, vertices.size());
+	}
+
+	// LOD0、LOD1… の順に最初に使われる順へ頂点を並べ直す(どのLODからも使われない頂点は除く)
+	std::vector<uint32_t> allIndices(indices);
+	allIndices.insert(allIndices.end(), lodIndices.begin(), lodIndices.end());
+	const std::vector<uint32_t> remap = MeshOptimizer::OptimizeVertexFetch(allIndices.data(), allIndices.size(), vertices.size());
+
+	std::copy(allIndices.begin(), allIndices.begin() + indices.size(), indices.begin());
+	std::copy(allIndices.begin() + indices.size(), allIndices.end(), lodIndices.begin());
+
+	std::vector<Vertex> remappedVertices(remap.size());
+	for (size_t i = 0; i < remap.size(); ++i)
+	{
+		remappedVertices[i] = vertices[remap[i]];
+	}
+	vertices.swap(remappedVertices);
+	ComputeBounds();
+}
+
+// 詳細度に対応するインデックス範囲取得
+void Model::Mesh::GetLodRange(int lod, UINT& indexStart, UINT& indexCount) const
+{
+	if (lod <= 0 || lods.empty())
+	{
+		indexStart = 0;
+		indexCount = static_cast<UINT>(indices.size());
+		return;
+	}
+
+	const Lod& range = lods.at((std::min)(static_cast<size_t>(lod), lods.size()) - 1);
+	indexStart = range.indexStart;
+	indexCount = range.indexCount;
 }
 
 template<class Archive>
@@ -190,7 +429,7 @@ void Model::Animation::serialize(Archive& archive)
 	);
 }
 
-// RXgN^
+// コンストラクタ
 Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
 {
 	std::filesystem::path filepath(filename);
@@ -198,31 +437,70 @@ Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
 
 	std::filesystem::path extension = filepath.extension();
 
-	// Ǝ`̃ft@C̑݊mF
+	// 独自形式のモデルファイルの存在確認
 	filepath.replace_extension(".cereal");
 	if (std::filesystem::exists(filepath))
 	{
-		// Ǝ`̃ft@C̓ǂݍ
+		// 独自形式のモデルファイルの読み込み
 		Deserialize(filepath.string().c_str());
 	}
 	else if (extension == ".gltf" || extension == ".glb")
 	{
-		// ėpft@C̓ǂݍ
+		// 汎用モデルファイルの読み込み
 		GLTFImporter importer(filename);
 
-		// }eAf[^ǂݎ
+		// マテリアルデータ読み取り
 		importer.LoadMaterials(materials, device);
 
-		// m[hf[^ǂݎ
+		// ノードデータ読み取り
 		importer.LoadNodes(nodes);
 
-		// bVf[^ǂݎ
+		// メッシュデータ読み取り
 		importer.LoadMeshes(meshes, nodes);
 
-		// Aj[Vf[^ǂݎ
+		// LOD構築(用意されたLODがないメッシュは簡略化して作る)と、GPU向けの並べ替え
+		MergeAuthoredLods();
+		std::vector<float> acmrs(meshes.size() * 2, 0.0f);
+		JobSystem::Instance().ParallelFor(0, meshes.size(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				Mesh& mesh = meshes.at(i);
+				if (mesh.lods.empty())
+				{
+					mesh.GenerateLods();
+				}
+
+				acmrs[i * 2] = MeshOptimizer::ComputeAcmr(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+				mesh.Optimize();
+				acmrs[i * 2 + 1] = MeshOptimizer::ComputeAcmr(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+			}
+		});
+
+		// 並べ替えの効果(LOD0 の三角形数で重み付けした平均キャッシュミス率)
+		{
+			double acmrBefore = 0, acmrAfter = 0;
+			size_t triangleCount = 0;
+			for (size_t i = 0; i < meshes.size(); ++i)
+			{
+				const size_t count = meshes[i].indices.size() / 3;
+				acmrBefore += acmrs[i * 2] * count;
+				acmrAfter += acmrs[i * 2 + 1] * count;
+				triangleCount += count;
+			}
+			if (triangleCount > 0)
+			{
+				char message[512];
+				sprintf_s(message, "%s : ACMR %.3f -> %.3f (%zu triangles)\n",
+					filename, acmrBefore / triangleCount, acmrAfter / triangleCount, triangleCount);
+				OutputDebugStringA(message);
+			}
+		}
+
+		// アニメーションデータ読み取り
 		importer.LoadAnimations(animations, nodes, sampleRate);
 
-		// Ǝ`̃ft@Cۑ
+		// 独自形式のモデルファイルを保存
 		//Serialize(filepath.string().c_str());
 	}
 	else
@@ -230,21 +508,21 @@ Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
 		_ASSERT_EXPR_A(false, "found not model file");
 	}
 
-	// }eA\z
+	// マテリアル構築
 	for (Material& material : materials)
 	{
 		if (material.baseMap == nullptr)
 		{
 			if (material.baseTextureFileName.empty())
 			{
-				// _~[eNX`쐬
+				// ダミーテクスチャ作成
 				HRESULT hr = GpuResourceUtils::CreateDummyTexture(device, 0xFFFFFFFF,
 					material.baseMap.GetAddressOf());
 				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 			}
 			else
 			{
-				// x[XeNX`ǂݍ
+				// ベーステクスチャ読み込み
 				std::filesystem::path diffuseTexturePath(dirpath / material.baseTextureFileName);
 				HRESULT hr = GpuResourceUtils::LoadTexture(device, diffuseTexturePath.string().c_str(),
 					material.baseMap.GetAddressOf());
@@ -256,14 +534,14 @@ Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
 		{
 			if (material.normalTextureFileName.empty())
 			{
-				// @_~[eNX`쐬
+				// 法線ダミーテクスチャ作成
 				HRESULT hr = GpuResourceUtils::CreateDummyTexture(device, 0xFFFF7F7F,
 					material.normalMap.GetAddressOf());
 				_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 			}
 			else
 			{
-				// @eNX`ǂݍ
+				// 法線テクスチャ読み込み
 				std::filesystem::path texturePath(dirpath / material.normalTextureFileName);
 				HRESULT hr = GpuResourceUtils::LoadTexture(device, texturePath.string().c_str(),
 					material.normalMap.GetAddressOf());
@@ -272,12 +550,12 @@ Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
 		}
 	}
 
-	// m[h\z
+	// ノード構築
 	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
 	{
 		Node& node = nodes.at(nodeIndex);
 
-		// eq֌W\z
+		// 親子関係を構築
 		node.parent = node.parentIndex >= 0 ? &nodes.at(node.parentIndex) : nullptr;
 		if (node.parent != nullptr)
 		{
@@ -285,67 +563,144 @@ Model::Model(ID3D11Device* device, const char* filename, float sampleRate)
 		}
 	}
 
-	// bV\z
+	// メッシュ構築
 	for (Mesh& mesh : meshes)
 	{
-		// Qƃ}eAݒ
+		// 参照マテリアル設定
 		mesh.material = &materials.at(mesh.materialIndex);
 
-		// Qƃm[hݒ
+		// 参照ノード設定
 		mesh.node = &nodes.at(mesh.nodeIndex);
 
-		// _obt@
-		{
-			D3D11_BUFFER_DESC bufferDesc = {};
-			D3D11_SUBRESOURCE_DATA subresourceData = {};
+		// 頂点バッファ
+		CreateVertexBuffer(device, mesh);
 
-			bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * mesh.vertices.size());
-			bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-			bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-			bufferDesc.CPUAccessFlags = 0;
-			bufferDesc.MiscFlags = 0;
-			bufferDesc.StructureByteStride = 0;
-			subresourceData.pSysMem = mesh.vertices.data();
-			subresourceData.SysMemPitch = 0;
-			subresourceData.SysMemSlicePitch = 0;
+		// インデックスバッファ(LOD1以降のインデックスを後ろに続ける。頂点数が収まれば16ビットにする)
+		{
+			std::vector<uint32_t> indices(mesh.indices);
+			indices.insert(indices.end(), mesh.lodIndices.begin(), mesh.lodIndices.end());
 
-			HRESULT hr = device->CreateBuffer(&bufferDesc, &subresourceData, mesh.vertexBuffer.GetAddressOf());
-			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-		}
+			std::vector<uint16_t> shortIndices;
+			const void* indexData = indices.data();
+			UINT indexSize = sizeof(uint32_t);
+			mesh.indexFormat = DXGI_FORMAT_R32_UINT;
+			if (mesh.vertices.size() <= 0x10000)
+			{
+				shortIndices.resize(indices.size());
+				std::transform(indices.begin(), indices.end(), shortIndices.begin(),
+					[](uint32_t index) { return static_cast<uint16_t>(index); });
+				indexData = shortIndices.data();
+				indexSize = sizeof(uint16_t);
+				mesh.indexFormat = DXGI_FORMAT_R16_UINT;
+			}
 
-		// CfbNXobt@
-		{
 			D3D11_BUFFER_DESC bufferDesc = {};
 			D3D11_SUBRESOURCE_DATA subresourceData = {};
 
-			bufferDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * mesh.indices.size());
+			bufferDesc.ByteWidth = static_cast<UINT>(indexSize * indices.size());
 			bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
 			bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 			bufferDesc.CPUAccessFlags = 0;
 			bufferDesc.MiscFlags = 0;
 			bufferDesc.StructureByteStride = 0;
-			subresourceData.pSysMem = mesh.indices.data();
+			subresourceData.pSysMem = indexData;
 			subresourceData.SysMemPitch = 0;
 			subresourceData.SysMemSlicePitch = 0;
 			HRESULT hr = device->CreateBuffer(&bufferDesc, &subresourceData, mesh.indexBuffer.GetAddressOf());
 			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 		}
 
-		// {[\z
+		// ボーン構築
 		for (Bone& bone : mesh.bones)
 		{
-			// Qƃm[hݒ
+			// 参照ノード設定
 			bone.node = &nodes.at(bone.nodeIndex);
 		}
+
+		lodCount = (std::max)(lodCount, static_cast<int>(mesh.lods.size()) + 1);
 	}
 
-	// s񏉊
+	// 行列初期化
 	DirectX::XMFLOAT4X4 worldTransform;
 	DirectX::XMStoreFloat4x4(&worldTransform, DirectX::XMMatrixIdentity());
 	UpdateTransform(worldTransform);
+
+	// 境界ボックス計算
+	ComputeModelBounds();
+}
+
+// 頂点形式に対応する入力レイアウト取得
+const std::vector<D3D11_INPUT_ELEMENT_DESC>& Model::GetInputElementDescs(VertexFormat format)
+{
+	return format == VertexFormat::Skinned ? SkinnedInputElementDescs : StaticInputElementDescs;
+}
+
+// 頂点形式に対応する1頂点のバイト数取得
+UINT Model::GetVertexStride(VertexFormat format)
+{
+	return format == VertexFormat::Skinned ? sizeof(SkinnedVertex) : sizeof(StaticVertex);
 }
 
-// Aj[Vǉǂݍ
+// 頂点を圧縮して頂点バッファを作成
+void Model::CreateVertexBuffer(ID3D11Device* device, Mesh& mesh)
+{
+	// ボーンを持たないメッシュは重みと番号を省く
+	mesh.vertexFormat = mesh.bones.empty() ? VertexFormat::Static : VertexFormat::Skinned;
+	_ASSERT_EXPR_A(mesh.bones.size() <= 256, "bone index must fit in uint8");
+
+	std::vector<uint8_t> data(GetVertexStride(mesh.vertexFormat) * mesh.vertices.size());
+	if (mesh.vertexFormat == VertexFormat::Skinned)
+	{
+		SkinnedVertex* packed = reinterpret_cast<SkinnedVertex*>(data.data());
+		for (size_t i = 0; i < mesh.vertices.size(); ++i)
+		{
+			const Vertex& vertex = mesh.vertices[i];
+			PackVertex(vertex, packed[i]);
+			PackBoneWeights(vertex.boneWeight, packed[i].boneWeight);
+			packed[i].boneIndex[0] = static_cast<uint8_t>(vertex.boneIndex.x);
+			packed[i].boneIndex[1] = static_cast<uint8_t>(vertex.boneIndex.y);
+			packed[i].boneIndex[2] = static_cast<uint8_t>(vertex.boneIndex.z);
+			packed[i].boneIndex[3] = static_cast<uint8_t>(vertex.boneIndex.w);
+		}
+	}
+	else
+	{
+		StaticVertex* packed = reinterpret_cast<StaticVertex*>(data.data());
+		for (size_t i = 0; i < mesh.vertices.size(); ++i)
+		{
+			PackVertex(mesh.vertices[i], packed[i]);
+		}
+	}
+
+	D3D11_BUFFER_DESC bufferDesc = {};
+	D3D11_SUBRESOURCE_DATA subresourceData = {};
+
+	bufferDesc.ByteWidth = static_cast<UINT>(data.size());
+	bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	bufferDesc.CPUAccessFlags = 0;
+	bufferDesc.MiscFlags = 0;
+	bufferDesc.StructureByteStride = 0;
+	subresourceData.pSysMem = data.data();
+	subresourceData.SysMemPitch = 0;
+	subresourceData.SysMemSlicePitch = 0;
+
+	HRESULT hr = device->CreateBuffer(&bufferDesc, &subresourceData, mesh.vertexBuffer.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+}
+
+// 頂点バッファのバイト数取得
+size_t Model::GetVertexBufferSize(bool compressed) const
+{
+	size_t size = 0;
+	for (const Mesh& mesh : meshes)
+	{
+		size += mesh.vertices.size() * (compressed ? GetVertexStride(mesh.vertexFormat) : sizeof(Vertex));
+	}
+	return size;
+}
+
+// アニメーション追加読み込み
 void Model::AppendAnimations(const char* filename)
 {
 	std::filesystem::path filepath(filename);
@@ -354,10 +709,10 @@ void Model::AppendAnimations(const char* filename)
 	if (filepath.extension() == ".gltf" ||
 		filepath.extension() == ".glb")
 	{
-		// ėpft@C̓ǂݍ
+		// 汎用モデルファイルの読み込み
 		GLTFImporter importer(filename);
 
-		// Aj[Vf[^ǂݎ
+		// アニメーションデータ読み取り
 		importer.LoadAnimations(animations, nodes);
 	}
 	else
@@ -366,7 +721,7 @@ void Model::AppendAnimations(const char* filename)
 	}
 }
 
-// Aj[VCfbNX擾
+// アニメーションインデックス取得
 int Model::GetAnimationIndex(const char* name) const
 {
 	for (size_t animationIndex = 0; animationIndex < animations.size(); ++animationIndex)
@@ -379,7 +734,7 @@ int Model::GetAnimationIndex(const char* name) const
 	return -1;
 }
 
-// m[hCfbNX擾
+// ノードインデックス取得
 int Model::GetNodeIndex(const char* name) const
 {
 	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
@@ -392,20 +747,20 @@ int Model::GetNodeIndex(const char* name) const
 	return -1;
 }
 
-// gXtH[XV
+// トランスフォーム更新処理
 void Model::UpdateTransform(const DirectX::XMFLOAT4X4& worldTransform)
 {
 	DirectX::XMMATRIX ParentWorldTransform = DirectX::XMLoadFloat4x4(&worldTransform);
 
 	for (Node& node : nodes)
 	{
-		// [JsZo
+		// ローカル行列算出
 		DirectX::XMMATRIX S = DirectX::XMMatrixScaling(node.scale.x, node.scale.y, node.scale.z);
 		DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&node.rotation));
 		DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(node.position.x, node.position.y, node.position.z);
 		DirectX::XMMATRIX LocalTransform = S * R * T;
 
-		// O[osZo
+		// グローバル行列算出
 		DirectX::XMMATRIX ParentGlobalTransform;
 		if (node.parent != nullptr)
 		{
@@ -417,10 +772,10 @@ void Model::UpdateTransform(const DirectX::XMFLOAT4X4& worldTransform)
 		}
 		DirectX::XMMATRIX GlobalTransform = LocalTransform * ParentGlobalTransform;
 
-		// [hsZo
+		// ワールド行列算出
 		DirectX::XMMATRIX WorldTransform = GlobalTransform * ParentWorldTransform;
 
-		// vZʂi[
+		// 計算結果を格納
 		DirectX::XMStoreFloat4x4(&node.localTransform, LocalTransform);
 		DirectX::XMStoreFloat4x4(&node.globalTransform, GlobalTransform);
 		DirectX::XMStoreFloat4x4(&node.worldTransform, WorldTransform);
@@ -432,66 +787,66 @@ void Model::ComputeAnimation(int animationIndex, int nodeIndex, float time, Node
 	const Animation& animation = animations.at(animationIndex);
 	const NodeAnim& nodeAnim = animation.nodeAnims.at(nodeIndex);
 
-	// ʒu
+	// 位置
 	for (size_t index = 0; index < nodeAnim.positionKeyframes.size() - 1; ++index)
 	{
-		// ݂̎Ԃǂ̃L[t[̊Ԃɂ邩肷
+		// 現在の時間がどのキーフレームの間にいるか判定する
 		const VectorKeyframe& keyframe0 = nodeAnim.positionKeyframes.at(index);
 		const VectorKeyframe& keyframe1 = nodeAnim.positionKeyframes.at(index + 1);
 		if (time >= keyframe0.seconds && time <= keyframe1.seconds)
 		{
-			// ĐԂƃL[t[̎Ԃ⊮Zo
+			// 再生時間とキーフレームの時間から補完率を算出する
 			float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
 
-			// ÕL[t[Ǝ̃L[t[̎p⊮
+			// 前のキーフレームと次のキーフレームの姿勢を補完
 			DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
 			DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
 			DirectX::XMVECTOR V = DirectX::XMVectorLerp(V0, V1, rate);
-			// vZʂm[hɊi[
+			// 計算結果をノードに格納
 			DirectX::XMStoreFloat3(&nodePose.position, V);
 		}
 	}
-	// ]
+	// 回転
 	for (size_t index = 0; index < nodeAnim.rotationKeyframes.size() - 1; ++index)
 	{
-		// ݂̎Ԃǂ̃L[t[̊Ԃɂ邩肷
+		// 現在の時間がどのキーフレームの間にいるか判定する
 		const QuaternionKeyframe& keyframe0 = nodeAnim.rotationKeyframes.at(index);
 		const QuaternionKeyframe& keyframe1 = nodeAnim.rotationKeyframes.at(index + 1);
 		if (time >= keyframe0.seconds && time <= keyframe1.seconds)
 		{
-			// ĐԂƃL[t[̎Ԃ⊮Zo
+			// 再生時間とキーフレームの時間から補完率を算出する
 			float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
 
-			// ÕL[t[Ǝ̃L[t[̎p⊮
+			// 前のキーフレームと次のキーフレームの姿勢を補完
 			DirectX::XMVECTOR Q0 = DirectX::XMLoadFloat4(&keyframe0.value);
 			DirectX::XMVECTOR Q1 = DirectX::XMLoadFloat4(&keyframe1.value);
 			DirectX::XMVECTOR Q = DirectX::XMQuaternionSlerp(Q0, Q1, rate);
-			// vZʂm[hɊi[
+			// 計算結果をノードに格納
 			DirectX::XMStoreFloat4(&nodePose.rotation, Q);
 		}
 	}
-	// XP[
+	// スケール
 	for (size_t index = 0; index < nodeAnim.scaleKeyframes.size() - 1; ++index)
 	{
-		// ݂̎Ԃǂ̃L[t[̊Ԃɂ邩肷
+		// 現在の時間がどのキーフレームの間にいるか判定する
 		const VectorKeyframe& keyframe0 = nodeAnim.scaleKeyframes.at(index);
 		const VectorKeyframe& keyframe1 = nodeAnim.scaleKeyframes.at(index + 1);
 		if (time >= keyframe0.seconds && time <= keyframe1.seconds)
 		{
-			// ĐԂƃL[t[̎Ԃ⊮Zo
+			// 再生時間とキーフレームの時間から補完率を算出する
 			float rate = (time - keyframe0.seconds) / (keyframe1.seconds - keyframe0.seconds);
 
-			// ÕL[t[Ǝ̃L[t[̎p⊮
+			// 前のキーフレームと次のキーフレームの姿勢を補完
 			DirectX::XMVECTOR V0 = DirectX::XMLoadFloat3(&keyframe0.value);
 			DirectX::XMVECTOR V1 = DirectX::XMLoadFloat3(&keyframe1.value);
 			DirectX::XMVECTOR V = DirectX::XMVectorLerp(V0, V1, rate);
-			// vZʂm[hɊi[
+			// 計算結果をノードに格納
 			DirectX::XMStoreFloat3(&nodePose.scale, V);
 		}
 	}
 }
 
-// Aj[VvZ
+// アニメーション計算
 void Model::ComputeAnimation(int animationIndex, float time, std::vector<NodePose>& nodePoses) const
 {
 	if (nodePoses.size() != nodes.size())
@@ -504,7 +859,7 @@ void Model::ComputeAnimation(int animationIndex, float time, std::vector<NodePos
 	}
 }
 
-// m[h|[Yݒ
+// ノードポーズ設定
 void Model::SetNodePoses(const std::vector<NodePose>& nodePoses)
 {
 	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
@@ -518,7 +873,7 @@ void Model::SetNodePoses(const std::vector<NodePose>& nodePoses)
 	}
 }
 
-// m[h|[Y擾
+// ノードポーズ取得
 void Model::GetNodePoses(std::vector<NodePose>& nodePoses) const
 {
 	if (nodePoses.size() != nodes.size())
@@ -536,7 +891,152 @@ void Model::GetNodePoses(std::vector<NodePose>& nodePoses) const
 	}
 }
 
-// VACY
+// メッシュの範囲と初期姿勢のノード行列からモデル全体の範囲を計算
+void Model::ComputeModelBounds()
+{
+	DirectX::XMVECTOR Min = DirectX::XMVectorReplicate(FLT_MAX);
+	DirectX::XMVECTOR Max = DirectX::XMVectorReplicate(-FLT_MAX);
+	for (const Mesh& mesh : meshes)
+	{
+		if (mesh.vertices.empty()) continue;
+
+		// スキンメッシュの頂点はモデル空間、それ以外はノード空間で格納されている
+		DirectX::XMMATRIX Transform = mesh.bones.empty()
+			? DirectX::XMLoadFloat4x4(&mesh.node->globalTransform)
+			: DirectX::XMMatrixIdentity();
+
+		// 範囲の8頂点を変換して囲む
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			DirectX::XMFLOAT3 p(
+				(corner & 1) ? mesh.boundsMax.x : mesh.boundsMin.x,
+				(corner & 2) ? mesh.boundsMax.y : mesh.boundsMin.y,
+				(corner & 4) ? mesh.boundsMax.z : mesh.boundsMin.z);
+			DirectX::XMVECTOR P = DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&p), Transform);
+			Min = DirectX::XMVectorMin(Min, P);
+			Max = DirectX::XMVectorMax(Max, P);
+		}
+	}
+
+	if (DirectX::XMVector3Greater(Min, Max))
+	{
+		// 頂点がなければ原点の点とする
+		Min = Max = DirectX::XMVectorZero();
+	}
+	DirectX::XMStoreFloat3(&boundsMin, Min);
+	DirectX::XMStoreFloat3(&boundsMax, Max);
+}
+
+// 名前が "_LOD<n>" で終わるノードのメッシュを、元のメッシュのLODとしてまとめる
+// LODのメッシュは元のメッシュと同じ位置に置かれている前提で、頂点を元のメッシュの後ろに追加する
+void Model::MergeAuthoredLods()
+{
+	// ノード名からLOD番号を取り出す(LODの名前でなければ -1)
+	auto parseLodName = [](const std::string& name, std::string& baseName) -> int
+	{
+		const size_t pos = name.rfind("_LOD");
+		if (pos == std::string::npos || pos + 4 >= name.size()) return -1;
+		for (size_t i = pos + 4; i < name.size(); ++i)
+		{
+			if (!std::isdigit(static_cast<unsigned char>(name[i]))) return -1;
+		}
+		baseName = name.substr(0, pos);
+		return std::atoi(name.c_str() + pos + 4);
+	};
+
+	auto sameBones = [](const Mesh& lhs, const Mesh& rhs)
+	{
+		if (lhs.bones.size() != rhs.bones.size()) return false;
+		for (size_t i = 0; i < lhs.bones.size(); ++i)
+		{
+			if (lhs.bones[i].nodeIndex != rhs.bones[i].nodeIndex) return false;
+		}
+		return true;
+	};
+
+	// LODのメッシュと、まとめ先のメッシュを探す
+	struct LodMesh
+	{
+		size_t	meshIndex;
+		size_t	baseMeshIndex;
+		int		lod;
+	};
+	std::vector<LodMesh> lodMeshes;
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		std::string baseName;
+		const int lod = parseLodName(nodes.at(meshes[i].nodeIndex).name, baseName);
+		if (lod <= 0) continue;
+
+		for (size_t j = 0; j < meshes.size(); ++j)
+		{
+			const std::string& name = nodes.at(meshes[j].nodeIndex).name;
+			std::string otherBaseName;
+			const bool isBase = name == baseName || (parseLodName(name, otherBaseName) == 0 && otherBaseName == baseName);
+			if (isBase && meshes[j].materialIndex == meshes[i].materialIndex && sameBones(meshes[j], meshes[i]))
+			{
+				lodMeshes.push_back({ i, j, lod });
+				break;
+			}
+		}
+	}
+	if (lodMeshes.empty()) return;
+
+	std::sort(lodMeshes.begin(), lodMeshes.end(), [](const LodMesh& lhs, const LodMesh& rhs)
+	{
+		return lhs.baseMeshIndex != rhs.baseMeshIndex ? lhs.baseMeshIndex < rhs.baseMeshIndex : lhs.lod < rhs.lod;
+	});
+
+	std::vector<size_t> mergedMeshIndices;
+	for (const LodMesh& lodMesh : lodMeshes)
+	{
+		Mesh& base = meshes.at(lodMesh.baseMeshIndex);
+		const Mesh& source = meshes.at(lodMesh.meshIndex);
+
+		const uint32_t vertexOffset = static_cast<uint32_t>(base.vertices.size());
+		base.vertices.insert(base.vertices.end(), source.vertices.begin(), source.vertices.end());
+
+		Lod& lod = base.lods.emplace_back();
+		lod.indexStart = static_cast<uint32_t>(base.indices.size() + base.lodIndices.size());
+		lod.indexCount = static_cast<uint32_t>(source.indices.size());
+		for (uint32_t index : source.indices)
+		{
+			base.lodIndices.emplace_back(index + vertexOffset);
+		}
+		base.ComputeBounds();
+
+		mergedMeshIndices.emplace_back(lodMesh.meshIndex);
+	}
+
+	// まとめたメッシュを後ろから取り除く
+	std::sort(mergedMeshIndices.begin(), mergedMeshIndices.end(), std::greater<size_t>());
+	for (size_t meshIndex : mergedMeshIndices)
+	{
+		meshes.erase(meshes.begin() + meshIndex);
+	}
+}
+
+// 画面サイズからLODを選択
+int Model::SelectLod(float screenSize, int currentLod) const
+{
+	const int maxLod = (std::min)(lodCount, static_cast<int>(lodScreenSizes.size()) + 1) - 1;
+	int lod = (std::clamp)(currentLod, 0, (std::max)(maxLod, 0));
+
+	// 切り替えの画面サイズより十分小さくなったら粗くする
+	while (lod < maxLod && screenSize < lodScreenSizes[lod] * (1.0f - LodHysteresis))
+	{
+		++lod;
+	}
+
+	// 切り替えの画面サイズより十分大きくなったら細かくする
+	while (lod > 0 && screenSize > lodScreenSizes[lod - 1] * (1.0f + LodHysteresis))
+	{
+		--lod;
+	}
+	return lod;
+}
+
+// シリアライズ
 void Model::Serialize(const char* filename)
 {
 	std::ofstream ostream(filename, std::ios::binary);
@@ -560,7 +1060,7 @@ void Model::Serialize(const char* filename)
 	}
 }
 
-// fVACY
+// デシリアライズ
 void Model::Deserialize(const char* filename)
 {
 	std::ifstream istream(filename, std::ios::binary);
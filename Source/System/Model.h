@@ -11,7 +11,19 @@ class Model
 public:
 	Model(ID3D11Device* device, const char* filename, float sampleRate = 60);
 
-	static const std::vector<D3D11_INPUT_ELEMENT_DESC> InputElementDescs;
+	// GPUに送る頂点の形式(メッシュごとに、ボーンの有無で選ぶ)
+	enum class VertexFormat
+	{
+		Static,
+		Skinned,
+		Count
+	};
+
+	// 頂点形式に対応する入力レイアウト取得
+	static const std::vector<D3D11_INPUT_ELEMENT_DESC>& GetInputElementDescs(VertexFormat format);
+
+	// 頂点形式に対応する1頂点のバイト数取得
+	static UINT GetVertexStride(VertexFormat format);
 
 	struct Node
 	{
@@ -61,6 +73,9 @@ public:
 		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	occlusionMap;
 		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	metalnessRoughnessMap;
 
+		int					tableIndex = -1;		// MaterialTable に登録した番号(未登録は -1)
+		bool				bindTextures = true;	// テクスチャ配列にまとめられず、描画ごとにテクスチャを設定する
+
 		template<class Archive>
 		void serialize(Archive& archive);
 	};
@@ -78,6 +93,26 @@ public:
 		void serialize(Archive& archive);
 	};
 
+	// 静的メッシュ用の圧縮頂点(法線と接線は八面体写像、UVは半精度)
+	struct StaticVertex
+	{
+		DirectX::XMFLOAT3		position;
+		int16_t					normal[2];		// snorm16
+		int8_t					tangent[4];		// xy: 接線(snorm8)、z: 従法線の向き
+		uint16_t				texcoord[2];	// half
+	};
+
+	// スキンメッシュ用の圧縮頂点(重みは unorm8、ボーン番号は uint8)
+	struct SkinnedVertex
+	{
+		DirectX::XMFLOAT3		position;
+		int16_t					normal[2];
+		int8_t					tangent[4];
+		uint16_t				texcoord[2];
+		uint8_t					boneWeight[4];
+		uint8_t					boneIndex[4];
+	};
+
 	struct Bone
 	{
 		int						nodeIndex;
@@ -88,6 +123,16 @@ public:
 		void serialize(Archive& archive);
 	};
 
+	// 詳細度(LOD)ごとのインデックス範囲
+	struct Lod
+	{
+		uint32_t	indexStart = 0;		// インデックスバッファ上の開始位置
+		uint32_t	indexCount = 0;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
 	struct Mesh
 	{
 		std::vector<Vertex>		vertices;
@@ -97,11 +142,33 @@ public:
 		int			materialIndex = 0;
 		Material*	material = nullptr;
 		Node*		node = nullptr;
+		VertexFormat	vertexFormat = VertexFormat::Static;
+		DXGI_FORMAT		indexFormat = DXGI_FORMAT_R32_UINT;		// 頂点数が少なければ16ビット
 		Microsoft::WRL::ComPtr<ID3D11Buffer>	vertexBuffer;
 		Microsoft::WRL::ComPtr<ID3D11Buffer>	indexBuffer;
 
+		// 頂点座標の範囲(インポート時に計算し、独自形式のモデルファイルに保存する)
+		DirectX::XMFLOAT3	boundsMin = { 0, 0, 0 };
+		DirectX::XMFLOAT3	boundsMax = { 0, 0, 0 };
+
+		// LOD1以降のインデックス(indices の後ろに続けてインデックスバッファに格納する)
+		std::vector<uint32_t>	lodIndices;
+		std::vector<Lod>		lods;
+
+		// 頂点座標から範囲を計算
+		void ComputeBounds();
+
+		// 簡略化したインデックスを作成してLODを追加
+		void GenerateLods();
+
+		// GPU向けに三角形と頂点を並べ替える(頂点キャッシュ、オーバードロー、頂点フェッチ)
+		void Optimize();
+
+		// 詳細度に対応するインデックス範囲取得(LODが足りない場合は最も粗いものを使う)
+		void GetLodRange(int lod, UINT& indexStart, UINT& indexCount) const;
+
 		template<class Archive>
-		void serialize(Archive& archive);
+		void serialize(Archive& archive, int version);
 	};
 
 	struct VectorKeyframe
@@ -149,55 +216,88 @@ public:
 		DirectX::XMFLOAT3	scale = { 1, 1, 1 };
 	};
 
-	// Aj[Vǉǂݍ
+	// アニメーション追加読み込み
 	void AppendAnimations(const char* filename);
 
-	// }eAf[^擾
+	// マテリアルデータ取得
 	const std::vector<Material>& GetMaterials() const { return materials; }
+	std::vector<Material>& GetMaterials() { return materials; }
 
-	// bVf[^擾
+	// メッシュデータ取得
 	const std::vector<Mesh>& GetMeshes() const { return meshes; }
 
-	// Aj[Vf[^擾
+	// アニメーションデータ取得
 	const std::vector<Animation>& GetAnimations() const { return animations; }
 
-	// Aj[VCfbNX擾
+	// アニメーションインデックス取得
 	int GetAnimationIndex(const char* name) const;
 
-	// m[hf[^擾
+	// ノードデータ取得
 	const std::vector<Node>& GetNodes() const { return nodes; }
 	std::vector<Node>& GetNodes() { return nodes; }
 
-	// [gm[h擾
+	// ルートノード取得
 	Node* GetRootNode() { return nodes.data(); }
 
-	// m[hCfbNX擾
+	// ノードインデックス取得
 	int GetNodeIndex(const char* name) const;
 
-	// gXtH[XV
+	// トランスフォーム更新処理
 	void UpdateTransform(const DirectX::XMFLOAT4X4& worldTransform);
 
-	// Aj[VvZ
+	// アニメーション計算
 	void ComputeAnimation(int animationIndex, int nodeIndex, float time, NodePose& nodePose) const;
 	void ComputeAnimation(int animationIndex, float time, std::vector<NodePose>& nodePoses) const;
 
-	// m[h|[Yݒ
+	// ノードポーズ設定
 	void SetNodePoses(const std::vector<NodePose>& nodePoses);
 
-	// m[h|[Y擾
+	// ノードポーズ取得
 	void GetNodePoses(std::vector<NodePose>& nodePoses) const;
 
+	// モデル空間の境界ボックス取得(初期姿勢の全メッシュを囲む。アニメーションではみ出す分は含まない)
+	const DirectX::XMFLOAT3& GetBoundsMin() const { return boundsMin; }
+	const DirectX::XMFLOAT3& GetBoundsMax() const { return boundsMax; }
+
+	// 頂点バッファのバイト数取得(compressed が false なら Vertex のまま送った場合)
+	size_t GetVertexBufferSize(bool compressed = true) const;
+
+	// LOD数取得(LOD0を含む)
+	int GetLodCount() const { return lodCount; }
+
+	// LODを切り替える画面サイズ設定(要素 i 未満でLOD i+1 を使う。大きい順に並べる)
+	void SetLodScreenSizes(const std::vector<float>& screenSizes) { lodScreenSizes = screenSizes; }
+	const std::vector<float>& GetLodScreenSizes() const { return lodScreenSizes; }
+
+	// 画面サイズからLODを選択(境界付近で切り替わり続けないよう、現在のLODから離れる側に幅を持たせる)
+	int SelectLod(float screenSize, int currentLod) const;
+
 private:
-	// VACY
+	// シリアライズ
 	void Serialize(const char* filename);
 
-	// fVACY
+	// デシリアライズ
 	void Deserialize(const char* filename);
 
+	// メッシュの範囲と初期姿勢のノード行列からモデル全体の範囲を計算
+	void ComputeModelBounds();
+
+	// 頂点を圧縮して頂点バッファを作成
+	static void CreateVertexBuffer(ID3D11Device* device, Mesh& mesh);
+
+	// 名前が "_LOD<n>" で終わるノードのメッシュを、元のメッシュのLODとしてまとめる
+	void MergeAuthoredLods();
+
 private:
 
 	std::vector<Material>	materials;
 	std::vector<Mesh>		meshes;
 	std::vector<Node>		nodes;
 	std::vector<Animation>	animations;
+
+	DirectX::XMFLOAT3		boundsMin = { 0, 0, 0 };
+	DirectX::XMFLOAT3		boundsMax = { 0, 0, 0 };
+
+	int						lodCount = 1;
+	std::vector<float>		lodScreenSizes = { 0.25f, 0.1f };
 };
\ No newline at end of file
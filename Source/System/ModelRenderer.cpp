@@ -2,22 +2,31 @@
 #include "BasicShader.h"
 #include "LambertShader.h"
 #include "PBRShader.h"
-#include "PBRMaterialConstants.h"
 #include "Misc.h"
 #include "GpuResourceUtils.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "EnvironmentLighting.h"
 #include <algorithm>
 
-// ModelRenderer.cpp ̃RXgN^C
+// ソートキー用にアドレスを番号にする(同じアドレスは同じ番号になるので、並べ替えると隣り合う)
+static uint32_t HashSortId(const void* pointer)
+{
+    uint64_t x = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return static_cast<uint32_t>(x);
+}
+
+// ModelRenderer.cpp のコンストラクタを修正
 ModelRenderer::ModelRenderer(ID3D11Device* device)
     : device(device)
 {
     OutputDebugStringA("ModelRenderer constructor START\n");
 
-    GpuResourceUtils::CreateConstantBuffer(
-        device,
-        sizeof(CbScene),
-        sceneConstantBuffer.GetAddressOf());
-    OutputDebugStringA("Scene constant buffer created\n");
+    frameConstants = std::make_unique<FrameConstants>(device);
+    OutputDebugStringA("Frame constants created\n");
 
     GpuResourceUtils::CreateConstantBuffer(
         device,
@@ -25,6 +34,13 @@ ModelRenderer::ModelRenderer(ID3D11Device* device)
         skeletonConstantBuffer.GetAddressOf());
     OutputDebugStringA("Skeleton constant buffer created\n");
 
+    // SRV に使う動的バッファへの WRITE_NO_OVERWRITE は D3D11.1 以降の任意機能
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+    if (SUCCEEDED(device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)))) {
+        bonePaletteNoOverwrite = options.MapNoOverwriteOnDynamicBufferSRV != FALSE;
+    }
+    CreateBonePaletteBuffer(kBonePaletteInitialCapacity);
+
     OutputDebugStringA("Creating BasicShader\n");
     shaders[static_cast<int>(ShaderId::Basic)] = std::make_unique<BasicShader>(device);
     OutputDebugStringA("BasicShader created\n");
@@ -37,228 +53,462 @@ ModelRenderer::ModelRenderer(ID3D11Device* device)
     shaders[static_cast<int>(ShaderId::PBR)] = std::make_unique<PBRShader>(device);
     OutputDebugStringA("PBRShader created\n");
 
+    materialTable = std::make_unique<MaterialTable>(device);
+    static_cast<PBRShader*>(shaders[static_cast<int>(ShaderId::PBR)].get())->SetMaterialTable(materialTable.get());
+
+    shadowMap = std::make_unique<ShadowMap>(device);
+    OutputDebugStringA("ShadowMap created\n");
+
     OutputDebugStringA("ModelRenderer constructor END\n");
 }
 
-void ModelRenderer::Draw(ShaderId shaderId, std::shared_ptr<Model> model)
+void ModelRenderer::Draw(ShaderId shaderId, std::shared_ptr<Model> model, int lod,
+    const DirectX::XMFLOAT4X4* worldTransform)
 {
     DrawInfo& drawInfo = drawInfos.emplace_back();
     drawInfo.shaderId = shaderId;
     drawInfo.model = model;
+    drawInfo.lod = lod;
+    drawInfo.viewMask = viewMask;
+    drawInfo.hasWorldTransform = worldTransform != nullptr;
+    if (worldTransform) drawInfo.worldTransform = *worldTransform;
 
-    if (shaderId == ShaderId::PBR)
-    {
-        Model* modelPtr = model.get();
-
-        if (materialStructuredBuffers.find(modelPtr) == materialStructuredBuffers.end())
-        {
-            const std::vector<Model::Material>& srcMaterials = model->GetMaterials();
-            std::vector<PBR_MaterialConstants> materials;
-            materials.reserve(srcMaterials.size());
-
-            for (const auto& srcMat : srcMaterials) {
-                PBR_MaterialConstants mat = {};
-
-                mat.emissiveFactor = srcMat.emissiveColor;
-                mat.alphaMode = static_cast<int>(srcMat.alphaMode);
-                mat.alphaCutoff = srcMat.alphaCutoff;
-                mat.doubleSided = 0;
-
-                mat.pbrMetallicRoughness.basecolorFactor = DirectX::XMFLOAT4(
-                    srcMat.baseColor.x, srcMat.baseColor.y,
-                    srcMat.baseColor.z, srcMat.baseColor.w
-                );
-                mat.pbrMetallicRoughness.metallicFactor = srcMat.metalness;
-                mat.pbrMetallicRoughness.roughnessFactor = srcMat.roughness;
-
-                mat.pbrMetallicRoughness.basecolorTexture.index = srcMat.baseMap ? 0 : -1;
-                mat.pbrMetallicRoughness.basecolorTexture.texcoord = 0;
+    // PBR のマテリアルは全モデル共通のテーブルに登録する(GPU への反映は Render() で行う)
+    if (shaderId == ShaderId::PBR) materialTable->Register(model);
+}
+ShadowCascades& ModelRenderer::UpdateShadowCascades(const RenderContext& rc)
+{
+    DirectX::XMFLOAT3 lightDirection = { 0.0f, -1.0f, 0.0f };
+    if (rc.lightManager) lightDirection = rc.lightManager->GetDirectionalLight().direction;
 
-                mat.pbrMetallicRoughness.metallicRoughnessTexture.index =
-                    srcMat.metalnessRoughnessMap ? 0 : -1;
-                mat.pbrMetallicRoughness.metallicRoughnessTexture.texcoord = 0;
+    shadowCascades.Update(rc.camera->GetView(), rc.camera->GetProjection(), lightDirection, shadowSettings);
+    shadowCascadesUpdated = true;
+    return shadowCascades;
+}
 
-                mat.normalTexture.index = srcMat.normalMap ? 0 : -1;
-                mat.normalTexture.texcoord = 0;
-                mat.normalTexture.scale = 1.0f;
+void ModelRenderer::Render(const RenderContext& rc, bool renderShadows)
+{
+    PROFILE_SCOPE("ModelRenderer::Render");
 
-                mat.emissiveTexture.index = srcMat.emissiveMap ? 0 : -1;
-                mat.emissiveTexture.texcoord = 0;
+    ID3D11DeviceContext* dc = rc.deviceContext;
 
-                mat.occlusionTexture.index = srcMat.occlusionMap ? 0 : -1;
-                mat.occlusionTexture.texcoord = 0;
-                mat.occlusionTexture.strength = srcMat.occlusionStrength;
+    // カメラとライトはシェーダーによらないので、ここで1回だけ作って設定する
+    frameConstants->Update(rc);
+    frameConstants->Bind(dc);
 
-                materials.push_back(mat);
-            }
+    // 描画予約で登録したマテリアルとテクスチャをテーブルに反映する
+    materialTable->Update(dc);
 
-            D3D11_BUFFER_DESC bufferDesc = {};
-            bufferDesc.ByteWidth = sizeof(PBR_MaterialConstants) * static_cast<UINT>(materials.size());
-            bufferDesc.Usage = D3D11_USAGE_DEFAULT;
-            bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-            bufferDesc.StructureByteStride = sizeof(PBR_MaterialConstants);
-            bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    // ボーン行列はインスタンスごとに独立しているので、描画前にまとめて並列で計算しておく
+    const size_t paletteBytes = BuildSkinningPalettes(dc);
 
-            D3D11_SUBRESOURCE_DATA initData = {};
-            initData.pSysMem = materials.data();
+    ID3D11Buffer* vsConstantBuffers[] = {
+        skeletonConstantBuffer.Get(),
+    };
+    dc->VSSetConstantBuffers(6, _countof(vsConstantBuffers), vsConstantBuffers);
+    dc->VSSetShaderResources(8, 1, bonePaletteSRV.GetAddressOf());
 
-            Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
-            HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, buffer.GetAddressOf());
-            _ASSERT_EXPR(SUCCEEDED(hr), "Failed to create material structured buffer");
+    ID3D11SamplerState* samplerStates[] = {
+        rc.renderState->GetSamplerState(SamplerState::LinearWrap)
+    };
+    dc->PSSetSamplers(0, _countof(samplerStates), samplerStates);
 
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-            srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-            srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
-            srvDesc.Buffer.FirstElement = 0;
-            srvDesc.Buffer.NumElements = static_cast<UINT>(materials.size());
+    dc->OMSetDepthStencilState(rc.renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
+    dc->RSSetState(rc.renderState->GetRasterizerState(RasterizerState::SolidCullBack));
 
-            Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
-            hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, srv.GetAddressOf());
-            _ASSERT_EXPR(SUCCEEDED(hr), "Failed to create material SRV");
+    // 描画予約をメッシュ単位に分け、ソートキーを付けて並べ替える
+    // 不透明はシェーダー、マテリアル、メッシュの順にまとめて手前から、半透明は奥から描画する
+    BuildRenderQueue(rc);
 
-            materialStructuredBuffers[modelPtr] = buffer;
-            materialStructuredBufferSRVs[modelPtr] = srv;
+    // シャドウマップを先に描画し、メインの描画で読めるように設定する
+    size_t shadowDrawCount = 0;
+    if (renderShadows) {
+        if (!shadowCascadesUpdated) UpdateShadowCascades(rc);
+        shadowMap->Resize(shadowSettings.resolution, shadowCascades.GetCascadeCount());
+        shadowDrawCount = RenderShadows(rc);
+    }
+    shadowMap->Bind(dc, shadowCascades);
+    if (rc.environment) rc.environment->Bind(dc);
+
+    // 並べ替えた描画を区切ってワーカースレッドでコマンドリストに記録する
+    // 記録ではデバイスコンテキストに触れず、定数もコマンドリストにコピーしておく
+    const std::vector<RenderQueue::Entry>& entries = renderQueue.GetEntries();
+    const size_t chunkCount = (entries.size() + kRecordGrainSize - 1) / kRecordGrainSize;
+    if (commandLists.size() < chunkCount) commandLists.resize(chunkCount);
+    chunkStatistics.assign(chunkCount, ChunkStatistics{});
+
+    ID3D11BlendState* blendStates[] = {
+        rc.renderState->GetBlendState(BlendState::Opaque),
+        rc.renderState->GetBlendState(BlendState::Transparency),
+    };
 
-            PBRShader* pbrShader = static_cast<PBRShader*>(shaders[static_cast<int>(ShaderId::PBR)].get());
-            pbrShader->SetMaterialBufferSRV(srv);
-            OutputDebugStringA("Material SRV set to PBRShader\n");
-        }
+    {
+        PROFILE_SCOPE("ModelRenderer::RecordCommands");
+
+        JobSystem::Instance().ParallelFor(0, chunkCount, 1, [&](size_t begin, size_t end)
+            {
+                for (size_t chunk = begin; chunk < end; ++chunk) {
+                    CommandList& commandList = commandLists[chunk];
+                    commandList.Clear();
+
+                    // 区切りごとに独立して冗長な設定を取り除く(先頭では全ての設定を記録する)
+                    RenderStateCache stateCache(commandList);
+                    ChunkStatistics& statistics = chunkStatistics[chunk];
+
+                    const size_t first = chunk * kRecordGrainSize;
+                    const size_t last = (std::min)(first + kRecordGrainSize, entries.size());
+                    for (size_t i = first; i < last; ++i) {
+                        const RenderItem& item = renderItems[entries[i].index];
+                        const Model::Mesh& mesh = *item.mesh;
+                        Shader* shader = shaders[static_cast<int>(item.shaderId)].get();
+
+                        // 不透明の後に半透明が続く
+                        stateCache.SetBlendState(blendStates[static_cast<int>(RenderQueue::GetPass(entries[i].key))]);
+                        stateCache.SetShader(shader);
+
+                        stateCache.SetVertexBuffer(mesh.vertexBuffer.Get(), Model::GetVertexStride(mesh.vertexFormat));
+                        stateCache.SetIndexBuffer(mesh.indexBuffer.Get(), mesh.indexFormat);
+
+                        CbSkeleton cbSkeleton{};
+                        cbSkeleton.boneOffset = bonePaletteBase + item.paletteOffset;
+                        stateCache.UpdateConstantBuffer(skeletonConstantBuffer.Get(), &cbSkeleton, sizeof(cbSkeleton));
+                        statistics.skeletonBytes += sizeof(CbSkeleton);
+
+                        shader->Update(rc, stateCache, mesh);
+
+                        UINT indexStart, indexCount;
+                        mesh.GetLodRange(item.lod, indexStart, indexCount);
+                        stateCache.DrawIndexed(indexCount, indexStart);
+
+                        statistics.fullTriangleCount += mesh.indices.size() / 3;
+                        statistics.drawnTriangleCount += indexCount / 3;
+                    }
+
+                    statistics.issuedCount = stateCache.GetIssuedCount();
+                    statistics.skippedCount = stateCache.GetSkippedCount();
+                    statistics.shaderSkippedCount = stateCache.GetShaderSkippedCount();
+                }
+            });
     }
-}
-void ModelRenderer::Render(const RenderContext& rc)
-{
-    ID3D11DeviceContext* dc = rc.deviceContext;
 
+    // 記録したコマンドを順番に送る(デバイスコンテキストを使うのはここだけ)
+    size_t shaderBindCount = 0;
     {
-        static LightManager defaultLightManager;
-        const LightManager* lightManager = rc.lightManager ? rc.lightManager : &defaultLightManager;
+        PROFILE_SCOPE("ModelRenderer::ExecuteCommands");
 
-        CbScene cbScene{};
-        DirectX::XMMATRIX V = DirectX::XMLoadFloat4x4(&rc.camera->GetView());
-        DirectX::XMMATRIX P = DirectX::XMLoadFloat4x4(&rc.camera->GetProjection());
-        DirectX::XMStoreFloat4x4(&cbScene.viewProjection, V * P);
+        dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-        const DirectionalLight& directionalLight = lightManager->GetDirectionalLight();
-        cbScene.lightDirection = directionalLight.direction;
-        cbScene.lightColor = directionalLight.color;
-        cbScene.cameraPosition = rc.camera->GetEye();
+        D3D11RenderBackend backend(rc);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            commandLists[chunk].Execute(backend);
+        }
+        backend.Finish();
+        shaderBindCount = backend.GetShaderBindCount();
+    }
 
-        dc->UpdateSubresource(sceneConstantBuffer.Get(), 0, 0, &cbScene, 0, 0);
+    renderQueue.Clear();
+    renderItems.clear();
+    drawInfos.clear();
+    viewMask = kViewAll;
+    shadowCascadesUpdated = false;
+
+    // LODを使わなかった場合との比較用の三角形数など
+    // シャドウマップを描画しない追加の描画は、同じフレームの集計に足し込む
+    if (renderShadows) frameStatistics = {};
+    ChunkStatistics& total = frameStatistics.total;
+    for (const ChunkStatistics& statistics : chunkStatistics) {
+        total.fullTriangleCount += statistics.fullTriangleCount;
+        total.drawnTriangleCount += statistics.drawnTriangleCount;
+        total.skeletonBytes += statistics.skeletonBytes;
+        total.issuedCount += statistics.issuedCount;
+        total.skippedCount += statistics.skippedCount;
+        total.shaderSkippedCount += statistics.shaderSkippedCount;
     }
+    frameStatistics.paletteBytes += paletteBytes;
+    frameStatistics.shaderBindCount += shaderBindCount;
+    frameStatistics.commandListCount += chunkCount;
+    frameStatistics.shadowDrawCount += shadowDrawCount;
+
+    PROFILE_COUNTER("Triangles (LOD0)", total.fullTriangleCount);
+    PROFILE_COUNTER("Triangles (drawn)", total.drawnTriangleCount);
+    PROFILE_COUNTER("Skinning bytes uploaded", frameStatistics.paletteBytes + total.skeletonBytes);
+    PROFILE_COUNTER("Shader binds", frameStatistics.shaderBindCount);
+    PROFILE_COUNTER("Redundant shader binds skipped", total.shaderSkippedCount);
+    PROFILE_COUNTER("State changes issued", total.issuedCount);
+    PROFILE_COUNTER("Redundant state changes skipped", total.skippedCount);
+    PROFILE_COUNTER("Command lists", frameStatistics.commandListCount);
+    PROFILE_COUNTER("Shadow cascades", shadowCascades.GetCascadeCount());
+    PROFILE_COUNTER("Shadow caster draws", frameStatistics.shadowDrawCount);
+
+    const MaterialTable::Statistics materialStatistics = materialTable->GetStatistics();
+    PROFILE_COUNTER("Materials", materialStatistics.materialCount);
+    PROFILE_COUNTER("Material texture arrays", materialStatistics.textureArrayCount);
+    PROFILE_COUNTER("Material textures in arrays", materialStatistics.textureCount);
+    PROFILE_COUNTER("Material table models", materialStatistics.modelCount);
+    PROFILE_COUNTER("Materials binding textures per draw", materialStatistics.boundMaterialCount);
 
-    ID3D11Buffer* vsConstantBuffers[] = {
-        skeletonConstantBuffer.Get(),
-        sceneConstantBuffer.Get(),
-    };
-    ID3D11Buffer* psConstantBuffers[] = {
-        sceneConstantBuffer.Get(),
-    };
+    for (ID3D11Buffer*& vsConstantBuffer : vsConstantBuffers) { vsConstantBuffer = nullptr; }
     dc->VSSetConstantBuffers(6, _countof(vsConstantBuffers), vsConstantBuffers);
-    dc->PSSetConstantBuffers(7, _countof(psConstantBuffers), psConstantBuffers);
+    frameConstants->Unbind(dc);
+    shadowMap->Unbind(dc);
+    if (rc.environment) rc.environment->Unbind(dc);
 
-    ID3D11SamplerState* samplerStates[] = {
-        rc.renderState->GetSamplerState(SamplerState::LinearWrap)
-    };
+    for (ID3D11SamplerState*& samplerState : samplerStates) { samplerState = nullptr; }
     dc->PSSetSamplers(0, _countof(samplerStates), samplerStates);
 
-    dc->OMSetDepthStencilState(rc.renderState->GetDepthStencilState(DepthState::TestAndWrite), 0);
-    dc->RSSetState(rc.renderState->GetRasterizerState(RasterizerState::SolidCullBack));
+    ID3D11ShaderResourceView* nullSrvs[6] = { nullptr };
+    dc->PSSetShaderResources(0, 6, nullSrvs);
+    dc->VSSetShaderResources(8, 1, nullSrvs);
+}
 
-    auto drawMesh = [&](const Model::Mesh& mesh, Shader* shader, ShaderId shaderId, Model* modelPtr)
-        {
-            UINT stride = sizeof(Model::Vertex);
-            UINT offset = 0;
-            dc->IASetVertexBuffers(0, 1, mesh.vertexBuffer.GetAddressOf(), &stride, &offset);
-            dc->IASetIndexBuffer(mesh.indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-            dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+void ModelRenderer::BuildRenderQueue(const RenderContext& rc)
+{
+    PROFILE_SCOPE("ModelRenderer::BuildRenderQueue");
 
-            CbSkeleton cbSkeleton{};
-            if (mesh.bones.size() > 0) {
-                for (size_t i = 0; i < mesh.bones.size(); ++i) {
-                    const Model::Bone& bone = mesh.bones.at(i);
-                    DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&bone.node->worldTransform);
-                    DirectX::XMMATRIX OffsetTransform = DirectX::XMLoadFloat4x4(&bone.offsetTransform);
-                    DirectX::XMMATRIX BoneTransform = OffsetTransform * WorldTransform;
-                    DirectX::XMStoreFloat4x4(&cbSkeleton.boneTransforms[i], BoneTransform);
-                }
-            }
-            else {
-                cbSkeleton.boneTransforms[0] = mesh.node->worldTransform;
-            }
-            dc->UpdateSubresource(skeletonConstantBuffer.Get(), 0, 0, &cbSkeleton, 0, 0);
+    // 描画予約ごとのメッシュの先頭位置を決めておき、キー作成は描画予約ごとに並列で行う
+    // 影だけに描画する予約もメッシュは作るが、メインのビューのキューには入れない
+    size_t itemCount = 0;
+    size_t queueCount = 0;
+    for (DrawInfo& drawInfo : drawInfos) {
+        const size_t meshCount = drawInfo.model->GetMeshes().size();
+        drawInfo.itemOffset = static_cast<UINT>(itemCount);
+        drawInfo.queueOffset = static_cast<UINT>(queueCount);
+        itemCount += meshCount;
+        if (drawInfo.viewMask & kViewMain) queueCount += meshCount;
+    }
+    renderItems.resize(itemCount);
+    renderQueue.Resize(queueCount);
+
+    const DirectX::XMFLOAT3 cameraPosition = rc.camera->GetEye();
+    const DirectX::XMFLOAT3 cameraFront = rc.camera->GetFront();
 
-            if (shaderId == ShaderId::PBR) {
-                auto it = materialStructuredBufferSRVs.find(modelPtr);
-                if (it != materialStructuredBufferSRVs.end()) {
-                    dc->PSSetShaderResources(0, 1, it->second.GetAddressOf());
+    JobSystem::Instance().ParallelFor(0, drawInfos.size(), kSortKeyGrainSize, [&](size_t begin, size_t end)
+        {
+            const DirectX::XMVECTOR CameraPosition = DirectX::XMLoadFloat3(&cameraPosition);
+            const DirectX::XMVECTOR CameraFront = DirectX::XMLoadFloat3(&cameraFront);
+
+            for (size_t i = begin; i < end; ++i) {
+                const DrawInfo& drawInfo = drawInfos[i];
+
+                const bool mainView = (drawInfo.viewMask & kViewMain) != 0;
+                UINT itemIndex = drawInfo.itemOffset;
+                UINT queueIndex = drawInfo.queueOffset;
+                UINT paletteOffset = drawInfo.paletteOffset;
+                for (const Model::Mesh& mesh : drawInfo.model->GetMeshes()) {
+                    const UINT meshPaletteOffset = paletteOffset;
+                    paletteOffset += static_cast<UINT>((std::max)(mesh.bones.size(), size_t(1)));
+
+                    // カメラの向きに沿ったメッシュの原点までの距離
+                    DirectX::XMVECTOR Position;
+                    if (drawInfo.hasWorldTransform) {
+                        const DirectX::XMFLOAT4X4& globalTransform = mesh.node->globalTransform;
+                        Position = DirectX::XMVector3TransformCoord(DirectX::XMVectorSet(
+                            globalTransform._41, globalTransform._42, globalTransform._43, 1.0f),
+                            DirectX::XMLoadFloat4x4(&drawInfo.worldTransform));
+                    }
+                    else {
+                        const DirectX::XMFLOAT4X4& nodeWorldTransform = mesh.node->worldTransform;
+                        Position = DirectX::XMVectorSet(
+                            nodeWorldTransform._41, nodeWorldTransform._42, nodeWorldTransform._43, 1.0f);
+                    }
+                    const float depth = DirectX::XMVectorGetX(DirectX::XMVector3Dot(
+                        CameraFront, DirectX::XMVectorSubtract(Position, CameraPosition)));
+
+                    RenderItem& item = renderItems[itemIndex];
+                    item.shaderId = drawInfo.shaderId;
+                    item.mesh = &mesh;
+                    item.lod = drawInfo.lod;
+                    item.paletteOffset = meshPaletteOffset;
+
+                    // 頂点シェーダーは頂点形式ごとに違うので、シェーダーと頂点形式の組で1つの番号にする
+                    // マテリアルとメッシュは同じものが隣り合えばよいので、アドレスから作った番号を使う
+                    // テクスチャ配列にまとめたマテリアルは設定が変わらないので、ピクセルシェーダーのパーミュテーションだけで分けてメッシュでまとめる
+                    const uint32_t shaderKey = static_cast<uint32_t>(drawInfo.shaderId) *
+                        static_cast<uint32_t>(Model::VertexFormat::Count) + static_cast<uint32_t>(mesh.vertexFormat);
+                    const uint32_t materialKey = mesh.material->bindTextures ? HashSortId(mesh.material)
+                        : shaders[static_cast<int>(drawInfo.shaderId)]->GetPermutation(mesh);
+                    const uint32_t meshKey = HashSortId(&mesh);
+
+                    const bool transparent = mesh.material->alphaMode == Model::AlphaMode::Blend ||
+                        (mesh.material->baseColor.w > 0.01f && mesh.material->baseColor.w < 0.99f);
+                    item.castsShadow = !transparent;
+
+                    if (mainView) {
+                        const uint64_t key = transparent
+                            ? RenderQueue::MakeTransparentKey(depth, shaderKey, materialKey, meshKey)
+                            : RenderQueue::MakeOpaqueKey(shaderKey, materialKey, meshKey, depth);
+                        renderQueue.Set(queueIndex++, key, itemIndex);
+                    }
+                    ++itemIndex;
                 }
             }
+        });
 
-            shader->Update(rc, mesh);
+    renderQueue.Sort();
+}
 
-            dc->DrawIndexed(static_cast<UINT>(mesh.indices.size()), 0, 0);
-        };
+size_t ModelRenderer::RenderShadows(const RenderContext& rc)
+{
+    PROFILE_SCOPE("ModelRenderer::RenderShadows");
 
-    DirectX::XMVECTOR CameraPosition = DirectX::XMLoadFloat3(&rc.camera->GetEye());
-    DirectX::XMVECTOR CameraFront = DirectX::XMLoadFloat3(&rc.camera->GetFront());
+    const UINT cascadeCount = shadowCascades.GetCascadeCount();
+    if (cascadeCount == 0) return 0;
 
-    dc->OMSetBlendState(rc.renderState->GetBlendState(BlendState::Opaque), nullptr, 0xFFFFFFFF);
+    ID3D11DeviceContext* dc = rc.deviceContext;
+    shadowMap->Begin(dc);
+    dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    // 深度だけなのでマテリアルは問わず、頂点形式とメッシュでまとめる
+    // 半透明のマスク(アルファテスト)も不透明として描画する
+    D3D11RenderBackend backend(rc);
+    size_t drawCount = 0;
+    for (UINT cascade = 0; cascade < cascadeCount; ++cascade) {
+        const uint32_t cascadeBit = ShadowViewMask(1u << cascade);
+
+        shadowQueue.Clear();
+        for (const DrawInfo& drawInfo : drawInfos) {
+            if ((drawInfo.viewMask & cascadeBit) == 0) continue;
+
+            const UINT itemEnd = drawInfo.itemOffset + static_cast<UINT>(drawInfo.model->GetMeshes().size());
+            for (UINT itemIndex = drawInfo.itemOffset; itemIndex < itemEnd; ++itemIndex) {
+                const RenderItem& item = renderItems[itemIndex];
+                if (!item.castsShadow) continue;
+                shadowQueue.Add(RenderQueue::MakeOpaqueKey(
+                    static_cast<uint32_t>(item.mesh->vertexFormat), 0, HashSortId(item.mesh), 0.0f), itemIndex);
+            }
+        }
+        shadowQueue.Sort();
 
-    for (DrawInfo& drawInfo : drawInfos) {
-        Shader* shader = shaders[static_cast<int>(drawInfo.shaderId)].get();
-        shader->Begin(rc);
+        shadowMap->BeginCascade(dc, cascade, shadowCascades.GetCascade(cascade).viewProjection);
 
-        for (const Model::Mesh& mesh : drawInfo.model->GetMeshes()) {
-            if (mesh.material->alphaMode == Model::AlphaMode::Blend ||
-                (mesh.material->baseColor.w > 0.01f && mesh.material->baseColor.w < 0.99f)) {
-                TransparencyDrawInfo& transparencyDrawInfo = transparencyDrawInfos.emplace_back();
-                transparencyDrawInfo.shaderId = drawInfo.shaderId;
-                transparencyDrawInfo.mesh = &mesh;
-
-                DirectX::XMVECTOR Position = DirectX::XMVectorSet(
-                    mesh.node->worldTransform._41,
-                    mesh.node->worldTransform._42,
-                    mesh.node->worldTransform._43,
-                    0.0f);
-                DirectX::XMVECTOR Vec = DirectX::XMVectorSubtract(Position, CameraPosition);
-                transparencyDrawInfo.distance = DirectX::XMVectorGetX(DirectX::XMVector3Dot(CameraFront, Vec));
-
-                continue;
-            }
+        // カスケードごとにシャドウマップの定数を書き換えたので、設定の記憶は引き継がない
+        RenderStateCache stateCache(backend);
+        for (const RenderQueue::Entry& entry : shadowQueue.GetEntries()) {
+            const RenderItem& item = renderItems[entry.index];
+            const Model::Mesh& mesh = *item.mesh;
 
-            drawMesh(mesh, shader, drawInfo.shaderId, drawInfo.model.get());
-        }
+            stateCache.SetVertexShader(shadowMap->GetVertexShader(mesh.vertexFormat));
+            stateCache.SetInputLayout(shadowMap->GetInputLayout(mesh.vertexFormat));
+            stateCache.SetVertexBuffer(mesh.vertexBuffer.Get(), Model::GetVertexStride(mesh.vertexFormat));
+            stateCache.SetIndexBuffer(mesh.indexBuffer.Get(), mesh.indexFormat);
 
-        shader->End(rc);
+            CbSkeleton cbSkeleton{};
+            cbSkeleton.boneOffset = bonePaletteBase + item.paletteOffset;
+            stateCache.UpdateConstantBuffer(skeletonConstantBuffer.Get(), &cbSkeleton, sizeof(cbSkeleton));
+
+            // 遠いカスケードは1テクセルが大きいので、メインの描画より粗い詳細度で足りる
+            UINT indexStart, indexCount;
+            mesh.GetLodRange(item.lod + static_cast<int>(cascade), indexStart, indexCount);
+            stateCache.DrawIndexed(indexCount, indexStart);
+            ++drawCount;
+        }
     }
-    drawInfos.clear();
-
-    dc->OMSetBlendState(rc.renderState->GetBlendState(BlendState::Transparency), nullptr, 0xFFFFFFFF);
+    shadowQueue.Clear();
 
-    std::sort(transparencyDrawInfos.begin(), transparencyDrawInfos.end(),
-        [](const TransparencyDrawInfo& lhs, const TransparencyDrawInfo& rhs) {
-            return lhs.distance > rhs.distance;
-        });
+    shadowMap->End(dc);
+    return drawCount;
+}
 
-    for (const TransparencyDrawInfo& transparencyDrawInfo : transparencyDrawInfos) {
-        Shader* shader = shaders[static_cast<int>(transparencyDrawInfo.shaderId)].get();
+size_t ModelRenderer::BuildSkinningPalettes(ID3D11DeviceContext* dc)
+{
+    PROFILE_SCOPE("ModelRenderer::BuildSkinningPalettes");
 
-        shader->Begin(rc);
+    // インスタンスごとにパレット内の位置を割り当てる
+    // 同じモデルでもインスタンスごとに姿勢と位置が違うので、メッシュ単位ではまとめない
+    UINT paletteSize = 0;
+    for (DrawInfo& drawInfo : drawInfos) {
+        drawInfo.paletteOffset = paletteSize;
+        for (const Model::Mesh& mesh : drawInfo.model->GetMeshes()) {
+            paletteSize += static_cast<UINT>((std::max)(mesh.bones.size(), size_t(1)));
+        }
+    }
+    if (paletteSize == 0) return 0;
 
-        drawMesh(*transparencyDrawInfo.mesh, shader, transparencyDrawInfo.shaderId, nullptr);
+    // 入りきらなければ作り直す(作り直した直後は先頭から使う)
+    if (paletteSize > bonePaletteCapacity) {
+        UINT capacity = bonePaletteCapacity;
+        while (capacity < paletteSize) capacity *= 2;
+        CreateBonePaletteBuffer(capacity);
+    }
 
-        shader->End(rc);
+    // まだGPUが読んでいるかもしれない範囲は上書きせず、後ろに書き足す
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if (!bonePaletteNoOverwrite || bonePaletteCursor + paletteSize > bonePaletteCapacity) {
+        mapType = D3D11_MAP_WRITE_DISCARD;
+        bonePaletteCursor = 0;
     }
-    transparencyDrawInfos.clear();
 
-    for (ID3D11Buffer*& vsConstantBuffer : vsConstantBuffers) { vsConstantBuffer = nullptr; }
-    for (ID3D11Buffer*& psConstantBuffer : psConstantBuffers) { psConstantBuffer = nullptr; }
-    dc->VSSetConstantBuffers(6, _countof(vsConstantBuffers), vsConstantBuffers);
-    dc->PSSetConstantBuffers(7, _countof(psConstantBuffers), psConstantBuffers);
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    HRESULT hr = dc->Map(bonePaletteBuffer.Get(), 0, mapType, 0, &mapped);
+    _ASSERT_EXPR(SUCCEEDED(hr), "Failed to map bone palette buffer");
+    if (FAILED(hr)) return 0;
+
+    bonePaletteBase = bonePaletteCursor;
+    bonePaletteCursor += paletteSize;
+    DirectX::XMFLOAT4X4* palette = static_cast<DirectX::XMFLOAT4X4*>(mapped.pData) + bonePaletteBase;
+
+    // マップしたメモリへ直接書き込む(書き込み結合メモリなので読み戻さない)
+    JobSystem::Instance().ParallelFor(0, drawInfos.size(), kSkinningGrainSize,
+        [this, palette](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const DrawInfo& drawInfo = drawInfos[i];
+                const std::vector<Model::Node>& nodes = drawInfo.model->GetNodes();
+                DirectX::XMMATRIX InstanceTransform = DirectX::XMLoadFloat4x4(&drawInfo.worldTransform);
+
+                // 予約時に渡された行列があればそれを、なければノードのワールド行列を使う
+                auto nodeWorldTransform = [&](const Model::Node& node) {
+                    if (!drawInfo.hasWorldTransform) return DirectX::XMLoadFloat4x4(&node.worldTransform);
+                    return DirectX::XMLoadFloat4x4(&node.globalTransform) * InstanceTransform;
+                };
+
+                DirectX::XMFLOAT4X4* boneTransforms = palette + drawInfo.paletteOffset;
+                for (const Model::Mesh& mesh : drawInfo.model->GetMeshes()) {
+                    if (mesh.bones.size() > 0) {
+                        for (size_t j = 0; j < mesh.bones.size(); ++j) {
+                            const Model::Bone& bone = mesh.bones.at(j);
+                            DirectX::XMMATRIX WorldTransform = nodeWorldTransform(nodes.at(bone.nodeIndex));
+                            DirectX::XMMATRIX OffsetTransform = DirectX::XMLoadFloat4x4(&bone.offsetTransform);
+                            DirectX::XMStoreFloat4x4(&boneTransforms[j], OffsetTransform * WorldTransform);
+                        }
+                        boneTransforms += mesh.bones.size();
+                    }
+                    else {
+                        DirectX::XMStoreFloat4x4(boneTransforms, nodeWorldTransform(*mesh.node));
+                        boneTransforms += 1;
+                    }
+                }
+            }
+        });
 
-    for (ID3D11SamplerState*& samplerState : samplerStates) { samplerState = nullptr; }
-    dc->PSSetSamplers(0, _countof(samplerStates), samplerStates);
+    dc->Unmap(bonePaletteBuffer.Get(), 0);
 
-    ID3D11ShaderResourceView* nullSrvs[6] = { nullptr };
-    dc->PSSetShaderResources(0, 6, nullSrvs);
-}
\ No newline at end of file
+    return paletteSize * sizeof(DirectX::XMFLOAT4X4);
+}
+
+void ModelRenderer::CreateBonePaletteBuffer(UINT boneCount)
+{
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = sizeof(DirectX::XMFLOAT4X4) * boneCount;
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    bufferDesc.StructureByteStride = sizeof(DirectX::XMFLOAT4X4);
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+
+    bonePaletteBuffer.Reset();
+    bonePaletteSRV.Reset();
+    HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, bonePaletteBuffer.GetAddressOf());
+    _ASSERT_EXPR(SUCCEEDED(hr), "Failed to create bone palette buffer");
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.FirstElement = 0;
+    srvDesc.Buffer.NumElements = boneCount;
+
+    hr = device->CreateShaderResourceView(bonePaletteBuffer.Get(), &srvDesc, bonePaletteSRV.GetAddressOf());
+    _ASSERT_EXPR(SUCCEEDED(hr), "Failed to create bone palette SRV");
+
+    bonePaletteCapacity = boneCount;
+    bonePaletteCursor = 0;
+}
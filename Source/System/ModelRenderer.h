@@ -2,13 +2,19 @@
 
 #include <memory>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <wrl.h>
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include "RenderContext.h"
 #include "Model.h"
 #include "Shader.h"
+#include "FrameConstants.h"
+#include "RenderQueue.h"
+#include "CommandList.h"
+#include "ShadowCascades.h"
+#include "ShadowMap.h"
+#include "MaterialTable.h"
 
 enum class ShaderId
 {
@@ -26,60 +32,145 @@ public:
     {
         OutputDebugStringA("ModelRenderer destructor START\n");
 
-        // shaders̉
+        // shadersの解放
         for (auto& shader : shaders) {
-            shader.reset();  // IɃZbg
+            shader.reset();  // 明示的にリセット
         }
 
         OutputDebugStringA("ModelRenderer destructor END\n");
     }
 
-    // `\
-    void Draw(ShaderId shaderId, std::shared_ptr<Model> model);
+    // 描画予約(lod は Model::SelectLod() で選んだ詳細度)
+    // worldTransform を渡すと、同じモデルを共有する他のインスタンスに行列を上書きされても
+    // 予約した時点のインスタンスの位置で描画する(省略時はノードのワールド行列をそのまま使う)
+    void Draw(ShaderId shaderId, std::shared_ptr<Model> model, int lod = 0,
+        const DirectX::XMFLOAT4X4* worldTransform = nullptr);
 
-    // `s
-    void Render(const RenderContext& rc);
+    // 以降の描画予約を描画するビュー(kViewMain とカスケードごとのビットの組み合わせ)
+    // 描画予約の前に World がカリングの結果から設定する(設定しなければ全てのビューに描画する)
+    static constexpr uint32_t kViewMain = 1u << 0;
+    static constexpr uint32_t kViewAll = ~0u;
+    static constexpr uint32_t ShadowViewMask(uint32_t cascadeMask) { return cascadeMask << 1; }
+    void SetViewMask(uint32_t viewMask) { this->viewMask = viewMask; }
+
+    // 影の設定(解像度とカスケード数は次の描画でシャドウマップに反映する)
+    void SetShadowSettings(const ShadowCascades::Settings& settings) { shadowSettings = settings; }
+    const ShadowCascades::Settings& GetShadowSettings() const { return shadowSettings; }
+
+    // 今フレームのカメラと平行光源からカスケードを求める
+    // 描画予約の前に呼ぶと、戻り値でキャスターを判定できる(呼ばなければ Render() で求める)
+    ShadowCascades& UpdateShadowCascades(const RenderContext& rc);
+
+    // 描画実行
+    // renderShadows が false ならシャドウマップは描画せず、同じフレームで先に描画したものを使う
+    // (遮蔽判定の後に追加で描画する2回目など)
+    void Render(const RenderContext& rc, bool renderShadows = true);
 
 private:
-    struct CbScene
-    {
-        DirectX::XMFLOAT4X4 viewProjection;
-        DirectX::XMFLOAT3   lightDirection;
-        float               pad1;
-        DirectX::XMFLOAT3   lightColor;
-        float               pad2;
-        DirectX::XMFLOAT3   cameraPosition;
-        float               pad3;
-    };
+    // 描画予約されたインスタンスのボーン行列をまとめて計算し、パレットに書き込む
+    // 戻り値はアップロードしたバイト数
+    size_t BuildSkinningPalettes(ID3D11DeviceContext* dc);
 
+    // 描画予約をメッシュ単位の描画に分け、ソートキーで並べ替える
+    void BuildRenderQueue(const RenderContext& rc);
+
+    // 影を落とす描画予約をカスケードごとにシャドウマップへ描画する
+    // 戻り値は描画したメッシュの数
+    size_t RenderShadows(const RenderContext& rc);
+
+    // パレット用バッファを boneCount 個以上の行列が入る大きさで作り直す
+    void CreateBonePaletteBuffer(UINT boneCount);
+
+private:
+    // ボーン行列そのものはパレット(StructuredBuffer)にあり、定数バッファは読み出し位置だけを持つ
     struct CbSkeleton
     {
-        DirectX::XMFLOAT4X4 boneTransforms[256];
+        UINT boneOffset;
+        UINT pad[3];
     };
 
     struct DrawInfo
     {
         ShaderId shaderId;
         std::shared_ptr<Model> model;
+        int lod = 0;
+        bool hasWorldTransform = false;
+        DirectX::XMFLOAT4X4 worldTransform;
+        UINT paletteOffset = 0;     // パレット内でのこのインスタンスの先頭位置
+        UINT itemOffset = 0;        // renderItems 内でのこのインスタンスの先頭位置
+        UINT queueOffset = 0;       // renderQueue 内でのこのインスタンスの先頭位置(メインのビューに描画する場合)
+        uint32_t viewMask = kViewAll;
     };
 
-    struct TransparencyDrawInfo
+    // メッシュ1つ分の描画(ソートキーからは renderItems の番号で参照する)
+    struct RenderItem
     {
         ShaderId shaderId = ShaderId::Basic;
-        const Model::Mesh* mesh;
-        float distance;
+        const Model::Mesh* mesh = nullptr;
+        int lod = 0;
+        UINT paletteOffset = 0;
+        bool castsShadow = false;   // 半透明は影を落とさない
     };
 
-    Microsoft::WRL::ComPtr<ID3D11Buffer> sceneConstantBuffer;
+    static constexpr size_t kSkinningGrainSize = 4;         // 並列化する際の1ジョブあたりのインスタンス数
+    static constexpr size_t kSortKeyGrainSize = 16;         // ソートキー作成の1ジョブあたりの描画予約数
+    static constexpr size_t kRecordGrainSize = 128;         // 1つのコマンドリストに記録する描画数
+    static constexpr UINT kBonePaletteInitialCapacity = 4096; // パレットの初期容量(行列数)
+
     Microsoft::WRL::ComPtr<ID3D11Buffer> skeletonConstantBuffer;
 
+    // カメラとライトの定数(全シェーダー共通で、Render の先頭で1回だけ書き込む)
+    std::unique_ptr<FrameConstants> frameConstants;
+
+    // ボーン行列のパレット
+    // フレームごとに使った範囲だけを書き足していくリングバッファで、末尾に達したら破棄して先頭に戻る
+    Microsoft::WRL::ComPtr<ID3D11Buffer> bonePaletteBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> bonePaletteSRV;
+    UINT bonePaletteCapacity = 0;
+    UINT bonePaletteCursor = 0;
+    bool bonePaletteNoOverwrite = false;    // SRV に使うバッファへの WRITE_NO_OVERWRITE が使えるか
+
     std::unique_ptr<Shader> shaders[static_cast<int>(ShaderId::Max)];
     std::vector<DrawInfo> drawInfos;
-    std::vector<TransparencyDrawInfo> transparencyDrawInfos;
+    std::vector<RenderItem> renderItems;
+    RenderQueue renderQueue;
+    uint32_t viewMask = kViewAll;
+
+    // カスケードシャドウマップ
+    ShadowCascades::Settings shadowSettings;
+    ShadowCascades shadowCascades;
+    bool shadowCascadesUpdated = false;     // 今フレームの UpdateShadowCascades() を呼んだか
+    std::unique_ptr<ShadowMap> shadowMap;
+    RenderQueue shadowQueue;
+
+    // 区切りごとのコマンドリストと集計(ワーカースレッドで記録し、描画スレッドでまとめて送る)
+    struct ChunkStatistics
+    {
+        size_t fullTriangleCount = 0;
+        size_t drawnTriangleCount = 0;
+        size_t skeletonBytes = 0;
+        size_t issuedCount = 0;
+        size_t skippedCount = 0;
+        size_t shaderSkippedCount = 0;
+    };
+    std::vector<CommandList> commandLists;
+    std::vector<ChunkStatistics> chunkStatistics;
+
+    // フレームの集計(遮蔽判定で2回に分けて描画する場合も合わせて表示する)
+    struct FrameStatistics
+    {
+        ChunkStatistics total;
+        size_t paletteBytes = 0;
+        size_t shaderBindCount = 0;
+        size_t commandListCount = 0;
+        size_t shadowDrawCount = 0;
+    };
+    FrameStatistics frameStatistics;
+
+    UINT bonePaletteBase = 0;   // 今フレームのパレットのバッファ内での先頭位置
 
-    // PBRVF[_[p: fƂStructuredBufferǗ
-    std::map<Model*, Microsoft::WRL::ComPtr<ID3D11Buffer>> materialStructuredBuffers;
-    std::map<Model*, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> materialStructuredBufferSRVs;
+    // PBRシェーダー用: 全モデルのマテリアルをまとめたテーブル
+    std::unique_ptr<MaterialTable> materialTable;
 
-    ID3D11Device* device; // StructuredBuffer쐬p
+    ID3D11Device* device;
 };
\ No newline at end of file
@@ -21,7 +21,7 @@ const std::vector<D3D11_INPUT_ELEMENT_DESC> ModelResource::InputElementDescs =
 	{ "BONE_INDICES", 0, DXGI_FORMAT_R32G32B32A32_UINT,  0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 };
 
-// CEREALo[W`
+// CEREALバージョン定義
 CEREAL_CLASS_VERSION(ModelResource::Node, 1)
 CEREAL_CLASS_VERSION(ModelResource::Material, 1)
 CEREAL_CLASS_VERSION(ModelResource::Subset, 1)
@@ -32,7 +32,7 @@ CEREAL_CLASS_VERSION(ModelResource::Keyframe, 1)
 CEREAL_CLASS_VERSION(ModelResource::Animation, 1)
 CEREAL_CLASS_VERSION(ModelResource, 1)
 
-// VACY
+// シリアライズ
 namespace DirectX
 {
 	template<class Archive>
@@ -180,35 +180,35 @@ void ModelResource::Animation::serialize(Archive& archive, int version)
 	);
 }
 
-// ǂݍ
+// 読み込み
 void ModelResource::Load(ID3D11Device* device, const char* filename)
 {
-	// fBNgpX擾
+	// ディレクトリパス取得
 	char drive[32], dir[256], dirname[256];
 	::_splitpath_s(filename, drive, sizeof(drive), dir, sizeof(dir), nullptr, 0, nullptr, 0);
 	::_makepath_s(dirname, sizeof(dirname), drive, dir, nullptr, nullptr);
 
-	// fVACY
+	// デシリアライズ
 	Deserialize(filename);
 
-	// f\z
+	// モデル構築
 	BuildModel(device, dirname);
 }
 
-// f\z
+// モデル構築
 void ModelResource::BuildModel(ID3D11Device* device, const char* dirname)
 {
 	for (Material& material : materials)
 	{
-		// ΃pX̉
+		// 相対パスの解決
 		char filename[256];
 		::_makepath_s(filename, 256, nullptr, dirname, material.textureFilename.c_str(), nullptr);
 
-		// }`oCg烏Ch֕ϊ
+		// マルチバイト文字からワイド文字へ変換
 		wchar_t wfilename[256];
 		::MultiByteToWideChar(CP_ACP, 0, filename, -1, wfilename, 256);
 
-		// eNX`ǂݍ
+		// テクスチャ読み込み
 		Microsoft::WRL::ComPtr<ID3D11Resource> resource;
 		HRESULT hr = GpuResourceUtils::LoadTexture(device, filename, material.shaderResourceView.GetAddressOf());
 		if (FAILED(hr))
@@ -220,13 +220,13 @@ void ModelResource::BuildModel(ID3D11Device* device, const char* dirname)
 
 	for (Mesh& mesh : meshes)
 	{
-		// TuZbg
+		// サブセット
 		for (Subset& subset : mesh.subsets)
 		{
 			subset.material = &materials.at(subset.materialIndex);
 		}
 
-		// _obt@
+		// 頂点バッファ
 		{
 			D3D11_BUFFER_DESC bufferDesc = {};
 			D3D11_SUBRESOURCE_DATA subresourceData = {};
@@ -246,7 +246,7 @@ void ModelResource::BuildModel(ID3D11Device* device, const char* dirname)
 			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 		}
 
-		// CfbNXobt@
+		// インデックスバッファ
 		{
 			D3D11_BUFFER_DESC bufferDesc = {};
 			D3D11_SUBRESOURCE_DATA subresourceData = {};
@@ -267,7 +267,7 @@ void ModelResource::BuildModel(ID3D11Device* device, const char* dirname)
 	}
 }
 
-// VACY
+// シリアライズ
 void ModelResource::Serialize(const char* filename)
 {
 	std::ofstream ostream(filename, std::ios::binary);
@@ -294,7 +294,7 @@ void ModelResource::Serialize(const char* filename)
 	}
 }
 
-// fVACY
+// デシリアライズ
 void ModelResource::Deserialize(const char* filename)
 {
 	std::ifstream istream(filename, std::ios::binary);
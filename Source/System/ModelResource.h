@@ -116,23 +116,23 @@ public:
 		void serialize(Archive& archive, int version);
 	};
 
-	// ef[^擾
+	// 各種データ取得
 	const std::vector<Mesh>& GetMeshes() const { return meshes; }
 	const std::vector<Node>& GetNodes() const { return nodes; }
 	const std::vector<Animation>& GetAnimations() const { return animations; }
 	const std::vector<Material>& GetMaterials() const { return materials; }
 
-	// ǂݍ
+	// 読み込み
 	void Load(ID3D11Device* device, const char* filename);
 
 protected:
-	// fZbgAbv
+	// モデルセットアップ
 	void BuildModel(ID3D11Device* device, const char* dirname);
 
-	// VACY
+	// シリアライズ
 	void Serialize(const char* filename);
 
-	// fVACY
+	// デシリアライズ
 	void Deserialize(const char* filename);
 
 protected:
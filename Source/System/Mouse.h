@@ -4,7 +4,7 @@
 
 using MouseButton = unsigned int;
 
-// }EX
+// マウス
 class Mouse
 {
 public:
@@ -16,46 +16,46 @@ public:
 	Mouse(HWND hWnd);
 	~Mouse() {}
 
-	// XV
+	// 更新
 	void Update();
 
-	// {^͏Ԃ̎擾
+	// ボタン入力状態の取得
 	MouseButton GetButton() const { return buttonState[0]; }
 
-	// {^Ԃ̎擾
+	// ボタン押下状態の取得
 	MouseButton GetButtonDown() const { return buttonDown; }
 
-	// {^Ԃ̎擾
+	// ボタン押上状態の取得
 	MouseButton GetButtonUp() const { return buttonUp; }
 
-	// zC[l̐ݒ
+	// ホイール値の設定
 	void SetWheel(int wheel) { this->wheel[0] += wheel; }
 
-	// zC[l̎擾
+	// ホイール値の取得
 	int GetWheel() const { return wheel[1]; }
 
-	// }EXJ[\XW擾
+	// マウスカーソルX座標取得
 	int GetPositionX() const { return positionX[0]; }
 
-	// }EXJ[\YW擾
+	// マウスカーソルY座標取得
 	int GetPositionY() const { return positionY[0]; }
 
-	// Õ}EXJ[\XW擾
+	// 前回のマウスカーソルX座標取得
 	int GetOldPositionX() const { return positionX[1]; }
 
-	// Õ}EXJ[\YW擾
+	// 前回のマウスカーソルY座標取得
 	int GetOldPositionY() const { return positionY[1]; }
 
-	// XN[ݒ
+	// スクリーン幅設定
 	void SetScreenWidth(int width) { screenWidth = width; }
 
-	// XN[ݒ
+	// スクリーン高さ設定
 	void SetScreenHeight(int height) { screenHeight = height; }
 
-	// XN[擾
+	// スクリーン幅取得
 	int GetScreenWidth() const { return screenWidth; }
 
-	// XN[擾
+	// スクリーン高さ取得
 	int GetScreenHeight() const { return screenHeight; }
 
 private:
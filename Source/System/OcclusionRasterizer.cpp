@@ -0,0 +1,340 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "System/OcclusionRasterizer.h"
+#include "System/JobSystem.h"
+
+// これより w が小さい頂点は近クリップ面をまたぐものとして扱う
+static const float MinClipW = 1e-4f;
+
+// 判定に使うミップの1辺のテクセル数の上限(これを超えるなら粗いミップに移る)
+static const int MaxTestTexels = 4;
+
+// コンストラクタ
+OcclusionRasterizer::OcclusionRasterizer()
+{
+	Resize(DefaultWidth, DefaultHeight);
+}
+
+// 深度バッファの大きさを設定
+void OcclusionRasterizer::Resize(uint32_t width, uint32_t height)
+{
+	width = (std::max)((width + 3) & ~3u, 4u);
+	height = (std::max)(height, 1u);
+	if (width == this->width && height == this->height) return;
+
+	this->width = width;
+	this->height = height;
+
+	// 1x1 になるまで半分(端数は切り上げ)にしていく
+	levels.clear();
+	uint32_t w = width, h = height;
+	for (;;)
+	{
+		Level& level = levels.emplace_back();
+		level.width = w;
+		level.height = h;
+		level.depth.assign(static_cast<size_t>(w) * h, 1.0f);
+		if (w == 1 && h == 1) break;
+		w = (w + 1) / 2;
+		h = (h + 1) / 2;
+	}
+}
+
+// 描画開始
+void OcclusionRasterizer::Begin(const DirectX::XMFLOAT4X4& viewProjection)
+{
+	this->viewProjection = viewProjection;
+	std::fill(levels[0].depth.begin(), levels[0].depth.end(), 1.0f);
+	triangleCount = 0;
+}
+
+// 遮蔽物の三角形を描画
+void OcclusionRasterizer::RasterizeMesh(const DirectX::XMFLOAT3* positions, size_t stride, size_t vertexCount,
+	const uint32_t* indices, size_t indexCount, const DirectX::XMFLOAT4X4& world)
+{
+	const DirectX::XMMATRIX WorldViewProjection = DirectX::XMMatrixMultiply(
+		DirectX::XMLoadFloat4x4(&world), DirectX::XMLoadFloat4x4(&viewProjection));
+
+	// 頂点ごとにスクリーン座標へ変換しておく
+	screenVertices.resize(vertexCount);
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(positions);
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		const DirectX::XMFLOAT3& position = *reinterpret_cast<const DirectX::XMFLOAT3*>(bytes + i * stride);
+		DirectX::XMFLOAT4 clip;
+		DirectX::XMStoreFloat4(&clip, DirectX::XMVector4Transform(
+			DirectX::XMVectorSet(position.x, position.y, position.z, 1.0f), WorldViewProjection));
+
+		DirectX::XMFLOAT4& screen = screenVertices[i];
+		if (clip.w < MinClipW || clip.z < 0.0f)
+		{
+			screen = { 0.0f, 0.0f, 0.0f, 0.0f };
+			continue;
+		}
+		const float invW = 1.0f / clip.w;
+		screen.x = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width);
+		screen.y = (-clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height);
+		screen.z = clip.z * invW;
+		screen.w = 1.0f;
+	}
+
+	for (size_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		const DirectX::XMFLOAT4& v0 = screenVertices[indices[i + 0]];
+		const DirectX::XMFLOAT4& v1 = screenVertices[indices[i + 1]];
+		const DirectX::XMFLOAT4& v2 = screenVertices[indices[i + 2]];
+		if (v0.w == 0.0f || v1.w == 0.0f || v2.w == 0.0f) continue;
+
+		RasterizeTriangle({ v0.x, v0.y, v0.z }, { v1.x, v1.y, v1.z }, { v2.x, v2.y, v2.z });
+	}
+}
+
+// スクリーン座標の三角形を描画
+void OcclusionRasterizer::RasterizeTriangle(const DirectX::XMFLOAT3& v0, const DirectX::XMFLOAT3& v1, const DirectX::XMFLOAT3& v2)
+{
+	// 表裏どちらを向いていても描画するので、面積が正になる順に並べる
+	float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+	if (std::fabs(area) < 1e-8f) return;
+	const DirectX::XMFLOAT3& a = v0;
+	const DirectX::XMFLOAT3& b = area > 0.0f ? v1 : v2;
+	const DirectX::XMFLOAT3& c = area > 0.0f ? v2 : v1;
+	area = std::fabs(area);
+
+	// 画面内に切り詰めた範囲(横は4ピクセル単位に揃える)
+	const float minX = (std::min)({ a.x, b.x, c.x });
+	const float maxX = (std::max)({ a.x, b.x, c.x });
+	const float minY = (std::min)({ a.y, b.y, c.y });
+	const float maxY = (std::max)({ a.y, b.y, c.y });
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height)) return;
+
+	const int x0 = (std::max)(static_cast<int>(std::floor(minX)), 0) & ~3;
+	const int x1 = (std::min)(static_cast<int>(std::ceil(maxX)), static_cast<int>(width) - 1);
+	const int y0 = (std::max)(static_cast<int>(std::floor(minY)), 0);
+	const int y1 = (std::min)(static_cast<int>(std::ceil(maxY)), static_cast<int>(height) - 1);
+
+	// 辺関数 E(x, y) = A * x + B * y + C (内側で正)
+	const float A0 = b.y - c.y, B0 = c.x - b.x, C0 = b.x * c.y - b.y * c.x;	// 辺 bc (a の重み)
+	const float A1 = c.y - a.y, B1 = a.x - c.x, C1 = c.x * a.y - c.y * a.x;	// 辺 ca (b の重み)
+	const float A2 = a.y - b.y, B2 = b.x - a.x, C2 = a.x * b.y - a.y * b.x;	// 辺 ab (c の重み)
+
+	// 深度は重心座標で補間する(z/w はスクリーン空間で線形)
+	const float invArea = 1.0f / area;
+	const float ZA = (A0 * a.z + A1 * b.z + A2 * c.z) * invArea;
+	const float ZB = (B0 * a.z + B1 * b.z + B2 * c.z) * invArea;
+	const float ZC = (C0 * a.z + C1 * b.z + C2 * c.z) * invArea;
+
+	// 4ピクセル分の x 座標(ピクセル中心)を1本のベクトルで扱う
+	const DirectX::XMVECTOR Zero = DirectX::XMVectorZero();
+	const DirectX::XMVECTOR Offset = DirectX::XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const DirectX::XMVECTOR EdgeA0 = DirectX::XMVectorReplicate(A0);
+	const DirectX::XMVECTOR EdgeA1 = DirectX::XMVectorReplicate(A1);
+	const DirectX::XMVECTOR EdgeA2 = DirectX::XMVectorReplicate(A2);
+	const DirectX::XMVECTOR DepthA = DirectX::XMVectorReplicate(ZA);
+
+	std::vector<float>& depth = levels[0].depth;
+	for (int y = y0; y <= y1; ++y)
+	{
+		const float py = static_cast<float>(y) + 0.5f;
+		const DirectX::XMVECTOR Row0 = DirectX::XMVectorReplicate(B0 * py + C0);
+		const DirectX::XMVECTOR Row1 = DirectX::XMVectorReplicate(B1 * py + C1);
+		const DirectX::XMVECTOR Row2 = DirectX::XMVectorReplicate(B2 * py + C2);
+		const DirectX::XMVECTOR RowDepth = DirectX::XMVectorReplicate(ZB * py + ZC);
+
+		float* row = &depth[static_cast<size_t>(y) * width];
+		for (int x = x0; x <= x1; x += 4)
+		{
+			const DirectX::XMVECTOR PX = DirectX::XMVectorAdd(DirectX::XMVectorReplicate(static_cast<float>(x)), Offset);
+
+			const DirectX::XMVECTOR E0 = DirectX::XMVectorMultiplyAdd(EdgeA0, PX, Row0);
+			const DirectX::XMVECTOR E1 = DirectX::XMVectorMultiplyAdd(EdgeA1, PX, Row1);
+			const DirectX::XMVECTOR E2 = DirectX::XMVectorMultiplyAdd(EdgeA2, PX, Row2);
+			DirectX::XMVECTOR Inside = DirectX::XMVectorGreaterOrEqual(E0, Zero);
+			Inside = DirectX::XMVectorAndInt(Inside, DirectX::XMVectorGreaterOrEqual(E1, Zero));
+			Inside = DirectX::XMVectorAndInt(Inside, DirectX::XMVectorGreaterOrEqual(E2, Zero));
+			if (DirectX::XMVector4EqualInt(Inside, DirectX::XMVectorFalseInt())) continue;
+
+			// 手前の深度だけを残す
+			const DirectX::XMVECTOR Depth = DirectX::XMVectorMultiplyAdd(DepthA, PX, RowDepth);
+			const DirectX::XMVECTOR Old = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&row[x]));
+			const DirectX::XMVECTOR New = DirectX::XMVectorSelect(Old, DirectX::XMVectorMin(Old, Depth), Inside);
+			DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(&row[x]), New);
+		}
+	}
+	++triangleCount;
+}
+
+// 描画終了
+void OcclusionRasterizer::End()
+{
+	// 2x2 の最大値で縮小する(端数の列と行は端を繰り返す)
+	for (size_t i = 1; i < levels.size(); ++i)
+	{
+		const Level& source = levels[i - 1];
+		Level& level = levels[i];
+		for (uint32_t y = 0; y < level.height; ++y)
+		{
+			const uint32_t sy0 = y * 2;
+			const uint32_t sy1 = (std::min)(sy0 + 1, source.height - 1);
+			for (uint32_t x = 0; x < level.width; ++x)
+			{
+				const uint32_t sx0 = x * 2;
+				const uint32_t sx1 = (std::min)(sx0 + 1, source.width - 1);
+				level.depth[static_cast<size_t>(y) * level.width + x] = (std::max)(
+					(std::max)(source.depth[static_cast<size_t>(sy0) * source.width + sx0], source.depth[static_cast<size_t>(sy0) * source.width + sx1]),
+					(std::max)(source.depth[static_cast<size_t>(sy1) * source.width + sx0], source.depth[static_cast<size_t>(sy1) * source.width + sx1]));
+			}
+		}
+	}
+}
+
+// 判定対象をクリア
+void OcclusionRasterizer::ClearBoxes()
+{
+	centers.clear();
+	extents.clear();
+}
+
+// 判定対象のボックス追加
+size_t OcclusionRasterizer::AddBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents)
+{
+	centers.push_back(center);
+	this->extents.push_back(extents);
+	return centers.size() - 1;
+}
+
+// 追加したボックスをまとめて判定
+void OcclusionRasterizer::TestBoxes()
+{
+	visible.resize(centers.size());
+	JobSystem::Instance().ParallelFor(0, centers.size(), TestGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			visible[i] = TestBox(centers[i], extents[i]) ? 1 : 0;
+		}
+	});
+}
+
+// 1つのボックスを判定
+bool OcclusionRasterizer::TestBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents) const
+{
+	const DirectX::XMMATRIX ViewProjection = DirectX::XMLoadFloat4x4(&viewProjection);
+
+	// 8頂点を投影して、画面上の範囲と最も手前の深度を求める
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+	for (int i = 0; i < 8; ++i)
+	{
+		const DirectX::XMVECTOR Corner = DirectX::XMVectorSet(
+			center.x + ((i & 1) ? extents.x : -extents.x),
+			center.y + ((i & 2) ? extents.y : -extents.y),
+			center.z + ((i & 4) ? extents.z : -extents.z),
+			1.0f);
+		DirectX::XMFLOAT4 clip;
+		DirectX::XMStoreFloat4(&clip, DirectX::XMVector4Transform(Corner, ViewProjection));
+
+		// 近クリップ面より手前にかかるボックスは隠れていないものとする
+		if (clip.w < MinClipW || clip.z < 0.0f) return true;
+
+		const float invW = 1.0f / clip.w;
+		const float x = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width);
+		const float y = (-clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height);
+		minX = (std::min)(minX, x);
+		maxX = (std::max)(maxX, x);
+		minY = (std::min)(minY, y);
+		maxY = (std::max)(maxY, y);
+		minZ = (std::min)(minZ, clip.z * invW);
+	}
+
+	// 画面外の判定は視錐台カリングに任せる
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height)) return true;
+
+	int x0 = (std::max)(static_cast<int>(std::floor(minX)), 0);
+	int x1 = (std::min)(static_cast<int>(std::floor(maxX)), static_cast<int>(width) - 1);
+	int y0 = (std::max)(static_cast<int>(std::floor(minY)), 0);
+	int y1 = (std::min)(static_cast<int>(std::floor(maxY)), static_cast<int>(height) - 1);
+
+	// 範囲が数テクセルに収まるミップを選ぶ
+	size_t levelIndex = 0;
+	while ((x1 - x0 >= MaxTestTexels || y1 - y0 >= MaxTestTexels) && levelIndex + 1 < levels.size())
+	{
+		x0 >>= 1; x1 >>= 1;
+		y0 >>= 1; y1 >>= 1;
+		++levelIndex;
+	}
+
+	// 範囲内の最も奥の深度より奥にあれば隠れている
+	const Level& level = levels[levelIndex];
+	float maxDepth = 0.0f;
+	for (int y = y0; y <= y1; ++y)
+	{
+		for (int x = x0; x <= x1; ++x)
+		{
+			maxDepth = (std::max)(maxDepth, level.depth[static_cast<size_t>(y) * level.width + x]);
+		}
+	}
+	return minZ <= maxDepth;
+}
+
+// 壁の前後と横に置いたボックスの判定を合成したカメラで確認する
+bool OcclusionRasterizer::RunSelfTest()
+{
+	// 原点から +Z を向いたカメラ
+	DirectX::XMFLOAT4X4 viewProjection;
+	DirectX::XMStoreFloat4x4(&viewProjection, DirectX::XMMatrixMultiply(
+		DirectX::XMMatrixLookAtLH(DirectX::XMVectorSet(0, 0, 0, 1), DirectX::XMVectorSet(0, 0, 1, 1), DirectX::XMVectorSet(0, 1, 0, 0)),
+		DirectX::XMMatrixPerspectiveFovLH(DirectX::XMConvertToRadians(60.0f), 2.0f, 0.1f, 100.0f)));
+
+	OcclusionRasterizer rasterizer;
+	rasterizer.Resize(DefaultWidth, DefaultHeight);
+
+	// 遮蔽物がなければ何も隠れない
+	rasterizer.Begin(viewProjection);
+	rasterizer.End();
+	bool passed = rasterizer.TestBox({ 0, 0, 20 }, { 1, 1, 1 });
+
+	// Z = 10 の 10m 四方の壁(ワールド行列で移動して描画する)
+	const DirectX::XMFLOAT3 wall[] =
+	{
+		{ -5, -5, 0 }, { -5, 5, 0 }, { 5, 5, 0 }, { 5, -5, 0 },
+	};
+	const uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+	DirectX::XMFLOAT4X4 world;
+	DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixTranslation(0, 0, 10));
+
+	rasterizer.Begin(viewProjection);
+	rasterizer.RasterizeMesh(wall, sizeof(DirectX::XMFLOAT3), _countof(wall), indices, _countof(indices), world);
+	rasterizer.End();
+	passed = passed && rasterizer.GetTriangleCount() == 2;
+
+	// 壁の真後ろは隠れ、手前、壁にめり込むもの、横、縁にかかるものは見える
+	rasterizer.ClearBoxes();
+	const size_t behind = rasterizer.AddBox({ 0, 0, 20 }, { 1, 1, 1 });
+	const size_t front = rasterizer.AddBox({ 0, 0, 5 }, { 1, 1, 1 });
+	const size_t intersecting = rasterizer.AddBox({ 0, 0, 10 }, { 1, 1, 1 });
+	const size_t beside = rasterizer.AddBox({ 15, 0, 20 }, { 1, 1, 1 });
+	const size_t edge = rasterizer.AddBox({ 10, 0, 20 }, { 1, 1, 1 });
+	const size_t behindLarge = rasterizer.AddBox({ 0, 0, 40 }, { 8, 8, 8 });
+	rasterizer.TestBoxes();
+
+	passed = passed && !rasterizer.IsVisible(behind);
+	passed = passed && rasterizer.IsVisible(front);
+	passed = passed && rasterizer.IsVisible(intersecting);
+	passed = passed && rasterizer.IsVisible(beside);
+	passed = passed && rasterizer.IsVisible(edge);
+	passed = passed && !rasterizer.IsVisible(behindLarge);
+
+	// 近クリップ面をまたぐ床は描画しない(何も隠さない)
+	DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixIdentity());
+	const DirectX::XMFLOAT3 floor[] =
+	{
+		{ -5, -1, -5 }, { -5, -1, 50 }, { 5, -1, 50 }, { 5, -1, -5 },
+	};
+	rasterizer.Begin(viewProjection);
+	rasterizer.RasterizeMesh(floor, sizeof(DirectX::XMFLOAT3), _countof(floor), indices, _countof(indices), world);
+	rasterizer.End();
+	passed = passed && rasterizer.GetTriangleCount() == 0;
+	passed = passed && rasterizer.TestBox({ 0, 0, 20 }, { 1, 1, 1 });
+
+	return passed;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+// CPU で遮蔽物を低解像度の深度バッファに描画し、境界ボックスが隠れているか判定する
+// 深度は D3D と同じ向き(手前 0、奥 1)で、ピクセルごとに最も手前の深度を残す
+// 判定は深度バッファから作った最大深度のミップ(Hi-Z)で行い、ボックスの最も手前の深度がそれより奥なら隠れている
+// コンピュートシェーダーが使えない環境でも HiZBuffer と同じ判定ができる
+class OcclusionRasterizer
+{
+public:
+	static const uint32_t DefaultWidth = 256;		// 4の倍数
+	static const uint32_t DefaultHeight = 128;
+	static const size_t TestGrainSize = 64;			// 判定を並列化する際の1ジョブあたりのボックス数
+
+	OcclusionRasterizer();
+
+	// 深度バッファの大きさを設定(幅は4の倍数に切り上げる)
+	void Resize(uint32_t width, uint32_t height);
+
+	// 描画開始(ビュープロジェクション行列を設定し、深度を奥でクリア)
+	void Begin(const DirectX::XMFLOAT4X4& viewProjection);
+
+	// 遮蔽物の三角形を描画(positions は stride バイトおきの vertexCount 個の座標、world はワールド行列)
+	// 近クリップ面をまたぐ三角形は描画しない(隠す範囲が狭くなるだけなので判定は保守的なまま)
+	void RasterizeMesh(const DirectX::XMFLOAT3* positions, size_t stride, size_t vertexCount,
+		const uint32_t* indices, size_t indexCount, const DirectX::XMFLOAT4X4& world);
+
+	// 描画終了(判定用のミップを作る)
+	void End();
+
+	// 判定対象をクリア
+	void ClearBoxes();
+
+	// 判定対象のボックス追加(戻り値は結果を取得する際の番号)
+	size_t AddBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents);
+
+	// 追加したボックスをまとめて判定
+	void TestBoxes();
+
+	// 判定結果取得
+	bool IsVisible(size_t index) const { return visible[index] != 0; }
+
+	// 1つのボックスを判定
+	bool TestBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents) const;
+
+	// 描画した三角形の数
+	size_t GetTriangleCount() const { return triangleCount; }
+
+	uint32_t GetWidth() const { return width; }
+	uint32_t GetHeight() const { return height; }
+
+	// 深度バッファ取得(行ごとに width 個)
+	const std::vector<float>& GetDepth() const { return levels[0].depth; }
+
+	// 壁の前後と横に置いたボックスの判定を合成したカメラで確認する
+	static bool RunSelfTest();
+
+private:
+	// スクリーン座標の頂点(x, y はピクセル、z は深度)
+	void RasterizeTriangle(const DirectX::XMFLOAT3& v0, const DirectX::XMFLOAT3& v1, const DirectX::XMFLOAT3& v2);
+
+	// 最大深度のミップ(level 0 が深度バッファそのもの)
+	struct Level
+	{
+		uint32_t			width = 0;
+		uint32_t			height = 0;
+		std::vector<float>	depth;
+	};
+
+	uint32_t				width = 0;
+	uint32_t				height = 0;
+	std::vector<Level>		levels;
+	DirectX::XMFLOAT4X4		viewProjection = {};
+	size_t					triangleCount = 0;
+	std::vector<DirectX::XMFLOAT4>	screenVertices;		// RasterizeMesh() の作業用(w が 0 なら近クリップ面より手前)
+
+	// 判定対象
+	std::vector<DirectX::XMFLOAT3>	centers;
+	std::vector<DirectX::XMFLOAT3>	extents;
+	std::vector<uint8_t>			visible;
+};
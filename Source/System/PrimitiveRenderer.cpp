@@ -2,15 +2,16 @@
 #include "GpuResourceUtils.h"
 #include "PrimitiveRenderer.h"
 
-// RXgN^
-PrimitiveRenderer::PrimitiveRenderer(ID3D11Device* device)
+// コンストラクタ
+PrimitiveRenderer::PrimitiveRenderer(ID3D11Device* device, TransientVertexBuffer* transientVertexBuffer)
+	: transientVertexBuffer(transientVertexBuffer)
 {
 	D3D11_INPUT_ELEMENT_DESC inputElementDesc[]
 	{
 		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 		{ "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 	};
-	// _VF[_[
+	// 頂点シェーダー
 	GpuResourceUtils::LoadVertexShader(
 		device,
 		"Data/Shader/PrimitiveRendererVS.cso",
@@ -19,31 +20,20 @@ PrimitiveRenderer::PrimitiveRenderer(ID3D11Device* device)
 		inputLayout.GetAddressOf(),
 		vertexShader.GetAddressOf());
 
-	// sNZVF[_[
+	// ピクセルシェーダー
 	GpuResourceUtils::LoadPixelShader(
 		device,
 		"Data/Shader/PrimitiveRendererPS.cso",
 		pixelShader.GetAddressOf());
 
-	// 萔obt@
+	// 定数バッファ
 	GpuResourceUtils::CreateConstantBuffer(
 		device,
 		sizeof(CbScene),
 		constantBuffer.GetAddressOf());
-
-	// _obt@
-	D3D11_BUFFER_DESC desc;
-	desc.ByteWidth = sizeof(Vertex) * VertexCapacity;
-	desc.Usage = D3D11_USAGE_DYNAMIC;
-	desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-	desc.MiscFlags = 0;
-	desc.StructureByteStride = 0;
-	HRESULT hr = device->CreateBuffer(&desc, nullptr, vertexBuffer.GetAddressOf());
-	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 }
 
-// _ǉ
+// 頂点追加
 void PrimitiveRenderer::AddVertex(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& color)
 {
 	Vertex& v = vertices.emplace_back();
@@ -51,7 +41,7 @@ void PrimitiveRenderer::AddVertex(const DirectX::XMFLOAT3& position, const Direc
 	v.color = color;
 }
 
-// `
+// 軸描画
 void PrimitiveRenderer::DrawAxis(const DirectX::XMFLOAT4X4& transform, const DirectX::XMFLOAT4& color)
 {
 	DirectX::XMMATRIX W = DirectX::XMLoadFloat4x4(&transform);
@@ -68,7 +58,7 @@ void PrimitiveRenderer::DrawAxis(const DirectX::XMFLOAT4X4& transform, const Dir
 	AddVertex(z, { 0, 0, 1, 1 });
 }
 
-// Obh`
+// グリッド描画
 void PrimitiveRenderer::DrawGrid(int subdivisions, float scale)
 {
 	int numLines = (subdivisions + 1) * 2;
@@ -119,7 +109,7 @@ void PrimitiveRenderer::DrawGrid(int subdivisions, float scale)
 		s += step;
 	}
 
-	// X
+	// X軸
 	{
 		const DirectX::XMFLOAT4 red = DirectX::XMFLOAT4(1, 0, 0, 1);
 		V = DirectX::XMVectorSet(0, 0, 0, 0);
@@ -133,7 +123,7 @@ void PrimitiveRenderer::DrawGrid(int subdivisions, float scale)
 		AddVertex(position, red);
 	}
 
-	// Y
+	// Y軸
 	{
 		const DirectX::XMFLOAT4 green = DirectX::XMFLOAT4(0, 1, 0, 1);
 		V = DirectX::XMVectorSet(0, 0, 0, 0);
@@ -147,7 +137,7 @@ void PrimitiveRenderer::DrawGrid(int subdivisions, float scale)
 		AddVertex(position, green);
 	}
 
-	// Z
+	// Z軸
 	{
 		const DirectX::XMFLOAT4 blue = DirectX::XMFLOAT4(0, 0, 1, 1);
 		V = DirectX::XMVectorSet(0, 0, 0, 0);
@@ -162,60 +152,57 @@ void PrimitiveRenderer::DrawGrid(int subdivisions, float scale)
 	}
 }
 
-// `s
+// 描画実行
 void PrimitiveRenderer::Render(
 	ID3D11DeviceContext* dc,
 	const DirectX::XMFLOAT4X4& view,
 	const DirectX::XMFLOAT4X4& projection,
 	D3D11_PRIMITIVE_TOPOLOGY primitiveTopology)
 {
-	// VF[_[ݒ
+	// シェーダー設定
 	dc->VSSetShader(vertexShader.Get(), nullptr, 0);
 	dc->PSSetShader(pixelShader.Get(), nullptr, 0);
 	dc->IASetInputLayout(inputLayout.Get());
 
-	// 萔obt@ݒ
+	// 定数バッファ設定
 	dc->VSSetConstantBuffers(0, 1, constantBuffer.GetAddressOf());
 
-	// r[vWFNVs쐬
+	// ビュープロジェクション行列作成
 	DirectX::XMMATRIX V = DirectX::XMLoadFloat4x4(&view);
 	DirectX::XMMATRIX P = DirectX::XMLoadFloat4x4(&projection);
 	DirectX::XMMATRIX VP = V * P;
 
-	// 萔obt@XV
+	// 定数バッファ更新
 	CbScene cbScene;
 	DirectX::XMStoreFloat4x4(&cbScene.viewProjection, VP);
 	dc->UpdateSubresource(constantBuffer.Get(), 0, 0, &cbScene, 0, 0);
 
-	// _obt@ݒ
-	UINT stride = sizeof(Vertex);
-	UINT offset = 0;
+	// プリミティブ設定
 	dc->IASetPrimitiveTopology(primitiveTopology);
 	dc->IASetIndexBuffer(nullptr, DXGI_FORMAT_R32_UINT, 0);
-	dc->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
 
-	// `
+	// 描画(最大容量を超える分は線分と三角形を切らない頂点数ずつ分割する)
+	const UINT maxCount = TransientVertexBuffer::GetMaxCount(sizeof(Vertex)) / 6 * 6;
 	UINT totalVertexCount = static_cast<UINT>(vertices.size());
-	UINT start = 0;
-	UINT count = (totalVertexCount < VertexCapacity) ? totalVertexCount : VertexCapacity;
-
-	while (start < totalVertexCount)
+	for (UINT start = 0; start < totalVertexCount; )
 	{
-		D3D11_MAPPED_SUBRESOURCE mappedSubresource;
-		HRESULT hr = dc->Map(vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
-		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
-
-		memcpy(mappedSubresource.pData, &vertices[start], sizeof(Vertex) * count);
+		UINT count = totalVertexCount - start;
+		TransientVertexBuffer::Allocation allocation;
+		if (!transientVertexBuffer->Map(dc, sizeof(Vertex), count, allocation))
+		{
+			count = maxCount;
+			transientVertexBuffer->Map(dc, sizeof(Vertex), count, allocation);
+		}
+		memcpy(allocation.data, &vertices[start], sizeof(Vertex) * count);
+		transientVertexBuffer->Unmap(dc);
 
-		dc->Unmap(vertexBuffer.Get(), 0);
+		// 頂点バッファ設定
+		UINT stride = sizeof(Vertex);
+		dc->IASetVertexBuffers(0, 1, &allocation.buffer, &stride, &allocation.offset);
 
 		dc->Draw(count, 0);
 
 		start += count;
-		if ((start + count) > totalVertexCount)
-		{
-			count = totalVertexCount - start;
-		}
 	}
 
 	vertices.clear();
@@ -4,22 +4,23 @@
 #include <wrl.h>
 #include <d3d11.h>
 #include <DirectXMath.h>
+#include "TransientVertexBuffer.h"
 
 class PrimitiveRenderer
 {
 public:
-	PrimitiveRenderer(ID3D11Device* device);
+	PrimitiveRenderer(ID3D11Device* device, TransientVertexBuffer* transientVertexBuffer);
 
-	// _ǉ
+	// 頂点追加
 	void AddVertex(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& color);
 
-	// `(D3D11_PRIMITIVE_TOPOLOGY_LINELIST)
+	// 軸描画(D3D11_PRIMITIVE_TOPOLOGY_LINELIST)
 	void DrawAxis(const DirectX::XMFLOAT4X4& transform, const DirectX::XMFLOAT4& color);
 
-	// Obh`(D3D11_PRIMITIVE_TOPOLOGY_LINELIST)
+	// グリッド描画(D3D11_PRIMITIVE_TOPOLOGY_LINELIST)
 	void DrawGrid(int subdivisions, float scale);
 
-	// `s
+	// 描画実行
 	void Render(
 		ID3D11DeviceContext* dc,
 		const DirectX::XMFLOAT4X4& view,
@@ -27,8 +28,6 @@ public:
 		D3D11_PRIMITIVE_TOPOLOGY primitiveTopology);
 
 private:
-	static const UINT VertexCapacity = 3 * 1024;
-
 	struct CbScene
 	{
 		DirectX::XMFLOAT4X4		viewProjection;
@@ -45,6 +44,6 @@ private:
 	Microsoft::WRL::ComPtr<ID3D11VertexShader>	vertexShader;
 	Microsoft::WRL::ComPtr<ID3D11PixelShader>	pixelShader;
 	Microsoft::WRL::ComPtr<ID3D11InputLayout>	inputLayout;
-	Microsoft::WRL::ComPtr<ID3D11Buffer>		vertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D11Buffer>		constantBuffer;
+	TransientVertexBuffer*						transientVertexBuffer;
 };
@@ -0,0 +1,352 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <imgui.h>
+#include "System/Profiler.h"
+
+// フレーム開始
+void Profiler::BeginFrame()
+{
+	if (frequency == 0)
+	{
+		LARGE_INTEGER value;
+		QueryPerformanceFrequency(&value);
+		frequency = value.QuadPart;
+
+		frameTimes.assign(FrameHistoryCount, 0.0f);
+		capturedFrames.resize(CapturedFrameCount);
+	}
+	frameBegin = GetTimestamp();
+}
+
+// フレーム終了
+void Profiler::EndFrame()
+{
+	if (frequency == 0) return;
+
+	LONGLONG frameEnd = GetTimestamp();
+
+	frameTimes[frameTimeIndex] = static_cast<float>(ToMilliseconds(frameEnd - frameBegin));
+	frameTimeIndex = (frameTimeIndex + 1) % FrameHistoryCount;
+	++frameCount;
+
+	// 一時停止中も回収だけは行い、バッファを溢れさせない
+	Frame* frame = nullptr;
+	if (!paused)
+	{
+		frame = &capturedFrames[capturedFrameIndex];
+		capturedFrameIndex = (capturedFrameIndex + 1) % CapturedFrameCount;
+
+		frame->begin = frameBegin;
+		frame->end = frameEnd;
+		frame->events.clear();
+	}
+
+	std::lock_guard<std::mutex> lock(registerMutex);
+	for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+	{
+		UINT32 write = buffer->writeIndex.load(std::memory_order_acquire);
+		UINT32 read = buffer->readIndex.load(std::memory_order_relaxed);
+		if (frame != nullptr)
+		{
+			for (UINT32 i = read; i != write; ++i)
+			{
+				frame->events.push_back(buffer->events[i % EventCapacity]);
+			}
+		}
+		buffer->readIndex.store(write, std::memory_order_release);
+	}
+
+	if (frame != nullptr)
+	{
+		std::sort(frame->events.begin(), frame->events.end(), [](const Event& a, const Event& b)
+			{
+				if (a.threadIndex != b.threadIndex) return a.threadIndex < b.threadIndex;
+				return a.begin < b.begin;
+			});
+	}
+}
+
+// 計測区間の記録
+void Profiler::Record(const char* name, LONGLONG begin, LONGLONG end, UINT32 depth)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	// 読み込み側に追い付いたら捨てる(書き込み側は待たない)
+	UINT32 write = buffer->writeIndex.load(std::memory_order_relaxed);
+	UINT32 read = buffer->readIndex.load(std::memory_order_acquire);
+	if (write - read >= EventCapacity)
+	{
+		buffer->dropCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Event& event = buffer->events[write % EventCapacity];
+	event.name = name;
+	event.begin = begin;
+	event.end = end;
+	event.threadIndex = buffer->index;
+	event.depth = depth;
+
+	buffer->writeIndex.store(write + 1, std::memory_order_release);
+}
+
+// 呼び出したスレッドの名前設定
+void Profiler::SetThreadName(const char* name)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(registerMutex);
+	buffer->name = name;
+}
+
+// 計測値の設定
+void Profiler::SetCounter(const char* name, double value)
+{
+	for (Counter& counter : counters)
+	{
+		if (std::strcmp(counter.name, name) == 0)
+		{
+			counter.value = value;
+			return;
+		}
+	}
+	counters.push_back({ name, value });
+}
+
+// 直近のフレーム時間のパーセンタイル取得
+float Profiler::GetFrameTimePercentile(float percent) const
+{
+	UINT32 count = static_cast<UINT32>((std::min)(frameCount, static_cast<UINT64>(frameTimes.size())));
+	if (count == 0) return 0.0f;
+
+	std::vector<float> samples(frameTimes.begin(), frameTimes.begin() + count);
+	return Percentile(samples, percent);
+}
+
+// Chrome のトレース形式で書き出す
+bool Profiler::ExportChromeTrace(const char* filename) const
+{
+	FILE* fp = nullptr;
+	if (fopen_s(&fp, filename, "w") != 0 || fp == nullptr) return false;
+
+	// 名前に含まれる '"' と '\' をエスケープする
+	auto writeString = [fp](const char* text)
+		{
+			fputc('"', fp);
+			for (const char* c = text; *c != '\0'; ++c)
+			{
+				if (*c == '"' || *c == '\\') fputc('\\', fp);
+				fputc(*c, fp);
+			}
+			fputc('"', fp);
+		};
+
+	fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	// スレッド名(フレーム区間は専用の行に出す)
+	const UINT32 frameThread = 0xffff;
+	fprintf(fp, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Frame\"}}", frameThread);
+	{
+		std::lock_guard<std::mutex> lock(registerMutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+		{
+			fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", buffer->index);
+			writeString(buffer->name.c_str());
+			fprintf(fp, "}}");
+		}
+	}
+
+	// 古いフレームから順に書き出す(時刻はマイクロ秒)
+	LONGLONG origin = 0;
+	for (UINT32 i = 0; i < CapturedFrameCount && !capturedFrames.empty(); ++i)
+	{
+		const Frame& frame = capturedFrames[(capturedFrameIndex + i) % CapturedFrameCount];
+		if (frame.end == 0) continue;
+		if (origin == 0) origin = frame.begin;
+
+		fprintf(fp, ",\n{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+			frameThread, ToMilliseconds(frame.begin - origin) * 1000.0, ToMilliseconds(frame.end - frame.begin) * 1000.0);
+
+		for (const Event& event : frame.events)
+		{
+			fprintf(fp, ",\n{\"name\":");
+			writeString(event.name);
+			fprintf(fp, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				event.threadIndex, ToMilliseconds(event.begin - origin) * 1000.0, ToMilliseconds(event.end - event.begin) * 1000.0);
+		}
+	}
+
+	fprintf(fp, "\n]}\n");
+	fclose(fp);
+	return true;
+}
+
+// デバッグGUI描画
+void Profiler::DrawDebugGUI()
+{
+	if (frequency == 0) return;
+
+	ImGui::Begin("Profiler");
+
+	ImGui::Text("Frame : p50 %.2f ms  p95 %.2f ms  p99 %.2f ms",
+		GetFrameTimePercentile(50.0f), GetFrameTimePercentile(95.0f), GetFrameTimePercentile(99.0f));
+
+	// フレーム時間の推移
+	ImGui::PlotLines("##FrameTimes", frameTimes.data(), static_cast<int>(frameTimes.size()),
+		static_cast<int>(frameTimeIndex), "Frame Time (ms)", 0.0f, 33.3f, ImVec2(0, 60));
+
+	ImGui::Checkbox("Pause", &paused);
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(200);
+	ImGui::SliderInt("Frame", &selectedFrame, 0, CapturedFrameCount - 1, selectedFrame == 0 ? "latest" : "-%d");
+	ImGui::SameLine();
+	if (ImGui::Button("Export Trace"))
+	{
+		ExportChromeTrace("profile_trace.json");
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(registerMutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+		{
+			UINT32 drops = buffer->dropCount.load(std::memory_order_relaxed);
+			if (drops > 0)
+			{
+				ImGui::TextColored(ImVec4(1, 0.5f, 0, 1), "%s : %u events dropped", buffer->name.c_str(), drops);
+			}
+		}
+	}
+
+	for (const Counter& counter : counters)
+	{
+		ImGui::Text("%s : %.0f", counter.name, counter.value);
+	}
+
+	// capturedFrameIndex は次に書き込む位置なので、その1つ前が最新
+	UINT32 index = (capturedFrameIndex + CapturedFrameCount * 2 - 1 - selectedFrame) % CapturedFrameCount;
+	DrawTimeline(capturedFrames[index]);
+
+	ImGui::End();
+}
+
+// パーセンタイル計算
+float Profiler::Percentile(std::vector<float>& samples, float percent)
+{
+	if (samples.empty()) return 0.0f;
+
+	size_t n = static_cast<size_t>((samples.size() - 1) * std::clamp(percent, 0.0f, 100.0f) / 100.0f + 0.5f);
+	std::nth_element(samples.begin(), samples.begin() + n, samples.end());
+	return samples[n];
+}
+
+// 呼び出したスレッドのバッファ取得
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+	static thread_local ThreadBufferOwner owner;
+	if (owner.buffer != nullptr) return owner.buffer;
+
+	std::lock_guard<std::mutex> lock(registerMutex);
+
+	// 読み込みスレッドなどは作り直されるので、終了したスレッドのバッファを回収し終えていれば使い回す
+	ThreadBuffer* buffer = nullptr;
+	for (const std::unique_ptr<ThreadBuffer>& candidate : threadBuffers)
+	{
+		if (!candidate->inUse.load(std::memory_order_acquire) &&
+			candidate->readIndex.load(std::memory_order_relaxed) == candidate->writeIndex.load(std::memory_order_relaxed))
+		{
+			buffer = candidate.get();
+			break;
+		}
+	}
+	if (buffer == nullptr)
+	{
+		buffer = threadBuffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+		buffer->index = static_cast<UINT32>(threadBuffers.size() - 1);
+	}
+
+	buffer->inUse.store(true, std::memory_order_relaxed);
+	buffer->dropCount.store(0, std::memory_order_relaxed);
+	buffer->threadId = GetCurrentThreadId();
+	buffer->name = "Thread " + std::to_string(buffer->threadId);
+
+	owner.buffer = buffer;
+	return buffer;
+}
+
+// タイムライン描画
+void Profiler::DrawTimeline(const Frame& frame)
+{
+	if (frame.end <= frame.begin) return;
+
+	const float labelWidth = 100.0f;
+	const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+	const double frameMs = ToMilliseconds(frame.end - frame.begin);
+
+	ImGui::Text("%.3f ms, %d zones", frameMs, static_cast<int>(frame.events.size()));
+
+	ImGui::BeginChild("Timeline", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	float width = (std::max)(ImGui::GetContentRegionAvail().x - labelWidth, 100.0f);
+	double scale = width / static_cast<double>(frame.end - frame.begin);
+
+	std::lock_guard<std::mutex> lock(registerMutex);
+
+	// スレッドごとに深さの分だけ行を使う
+	float rowTop = origin.y;
+	size_t cursor = 0;
+	for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+	{
+		size_t first = cursor;
+		UINT32 maxDepth = 0;
+		while (cursor < frame.events.size() && frame.events[cursor].threadIndex == buffer->index)
+		{
+			maxDepth = (std::max)(maxDepth, frame.events[cursor].depth);
+			++cursor;
+		}
+		if (cursor == first) continue;
+
+		drawList->AddText(ImVec2(origin.x, rowTop), IM_COL32(200, 200, 200, 255), buffer->name.c_str());
+
+		for (size_t i = first; i < cursor; ++i)
+		{
+			const Event& event = frame.events[i];
+
+			float x0 = origin.x + labelWidth + static_cast<float>((std::max)(event.begin - frame.begin, 0LL) * scale);
+			float x1 = origin.x + labelWidth + static_cast<float>((std::min)(event.end - frame.begin, frame.end - frame.begin) * scale);
+			x1 = (std::max)(x1, x0 + 1.0f);
+			float y0 = rowTop + event.depth * rowHeight;
+			float y1 = y0 + rowHeight - 1.0f;
+
+			// 名前ごとに色を固定する
+			UINT32 hash = static_cast<UINT32>(reinterpret_cast<UINT_PTR>(event.name) * 2654435761u);
+			ImU32 color = IM_COL32(80 + (hash & 0x7f), 80 + ((hash >> 8) & 0x7f), 80 + ((hash >> 16) & 0x7f), 255);
+			drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), color);
+
+			if (x1 - x0 > 30.0f)
+			{
+				drawList->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+				drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name);
+				drawList->PopClipRect();
+			}
+
+			if (ImGui::IsMouseHoveringRect(ImVec2(x0, y0), ImVec2(x1, y1)))
+			{
+				ImGui::SetTooltip("%s\n%.3f ms", event.name, ToMilliseconds(event.end - event.begin));
+			}
+		}
+
+		rowTop += (maxDepth + 1) * rowHeight + 4.0f;
+	}
+
+	ImGui::Dummy(ImVec2(labelWidth + width, rowTop - origin.y));
+	ImGui::EndChild();
+}
+
+// カウンタ値をミリ秒に変換
+double Profiler::ToMilliseconds(LONGLONG count) const
+{
+	return frequency != 0 ? static_cast<double>(count) * 1000.0 / static_cast<double>(frequency) : 0.0;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <Windows.h>
+
+// プロファイラの有効化(0 にすると PROFILE_SCOPE は何も生成しない)
+#ifndef PROFILER_ENABLED
+#if defined(DEBUG) || defined(_DEBUG)
+#define PROFILER_ENABLED	1
+#else
+#define PROFILER_ENABLED	0
+#endif
+#endif
+
+// CPUプロファイラ
+// 計測区間はスレッドごとのリングバッファ(単一書き込み・単一読み込み)に積み、
+// フレーム終了時にメインスレッドがまとめて回収する
+class Profiler
+{
+private:
+	Profiler() = default;
+	~Profiler() = default;
+
+public:
+	// インスタンス取得
+	static Profiler& Instance()
+	{
+		static Profiler instance;
+		return instance;
+	}
+
+	// 計測区間
+	struct Event
+	{
+		const char*		name = nullptr;		// 文字列リテラルなど寿命の長い文字列
+		LONGLONG		begin = 0;
+		LONGLONG		end = 0;
+		UINT32			threadIndex = 0;
+		UINT32			depth = 0;
+	};
+
+	// 1フレーム分の計測結果
+	struct Frame
+	{
+		LONGLONG			begin = 0;
+		LONGLONG			end = 0;
+		std::vector<Event>	events;
+	};
+
+	// フレーム開始
+	void BeginFrame();
+
+	// フレーム終了(各スレッドの計測区間を回収する)
+	void EndFrame();
+
+	// 計測区間の記録(呼び出したスレッドのバッファに積む)
+	void Record(const char* name, LONGLONG begin, LONGLONG end, UINT32 depth);
+
+	// 呼び出したスレッドの名前設定
+	void SetThreadName(const char* name);
+
+	// 計測値の設定(描画数など、フレームごとに上書きしてデバッグGUIに表示する。メインスレッドから呼ぶ)
+	void SetCounter(const char* name, double value);
+
+	// 現在時刻取得
+	static LONGLONG GetTimestamp()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	// 直近のフレーム時間(ミリ秒)のパーセンタイル取得(percent は 0～100)
+	float GetFrameTimePercentile(float percent) const;
+
+	// Chrome のトレース形式(chrome://tracing, Perfetto)で保持しているフレームを書き出す
+	bool ExportChromeTrace(const char* filename) const;
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+	// パーセンタイル計算(samples は並べ替えられる)
+	static float Percentile(std::vector<float>& samples, float percent);
+
+private:
+	static const UINT32 EventCapacity = 16384;		// スレッドごとのリングバッファ容量
+	static const UINT32 FrameHistoryCount = 300;	// フレーム時間の保持数
+	static const UINT32 CapturedFrameCount = 120;	// 計測区間を保持するフレーム数
+
+	// スレッドごとのリングバッファ
+	struct ThreadBuffer
+	{
+		std::string				name;
+		DWORD					threadId = 0;
+		UINT32					index = 0;
+		std::atomic<UINT32>		writeIndex = 0;		// 書き込み側のみ更新
+		std::atomic<UINT32>		readIndex = 0;		// 読み込み側のみ更新
+		std::atomic<UINT32>		dropCount = 0;
+		std::atomic<bool>		inUse = true;		// スレッドが終了すると false になり、ほかのスレッドが使い回す
+		Event					events[EventCapacity];
+	};
+
+	// スレッド終了時にバッファを返す
+	struct ThreadBufferOwner
+	{
+		ThreadBuffer*	buffer = nullptr;
+
+		~ThreadBufferOwner()
+		{
+			if (buffer != nullptr) buffer->inUse.store(false, std::memory_order_release);
+		}
+	};
+
+	// 呼び出したスレッドのバッファ取得(初回のみ登録する。終了したスレッドのバッファがあれば使い回す)
+	ThreadBuffer* GetThreadBuffer();
+
+	// 計測値
+	struct Counter
+	{
+		const char*		name = nullptr;		// 文字列リテラルなど寿命の長い文字列
+		double			value = 0.0;
+	};
+
+	// タイムライン描画
+	void DrawTimeline(const Frame& frame);
+
+	// カウンタ値をミリ秒に変換
+	double ToMilliseconds(LONGLONG count) const;
+
+private:
+	mutable std::mutex							registerMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>>	threadBuffers;
+
+	LONGLONG				frequency = 0;
+	LONGLONG				frameBegin = 0;
+	std::vector<float>		frameTimes;			// ミリ秒(リング)
+	UINT32					frameTimeIndex = 0;
+	std::vector<Frame>		capturedFrames;		// リング
+	UINT32					capturedFrameIndex = 0;
+	UINT64					frameCount = 0;
+	std::vector<Counter>	counters;
+
+	bool					paused = false;
+	int						selectedFrame = 0;	// 0 が最新
+};
+
+// 計測区間(スコープを抜けるまでの時間を記録する)
+class ProfileScope
+{
+public:
+	ProfileScope(const char* name)
+		: name(name)
+		, depth(currentDepth++)
+		, begin(Profiler::GetTimestamp())
+	{
+	}
+
+	~ProfileScope()
+	{
+		--currentDepth;
+		Profiler::Instance().Record(name, begin, Profiler::GetTimestamp(), depth);
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	static inline thread_local UINT32	currentDepth = 0;
+
+	const char*		name;
+	UINT32			depth;
+	LONGLONG		begin;
+};
+
+#if PROFILER_ENABLED
+#define PROFILE_CONCAT_INNER(a, b)	a##b
+#define PROFILE_CONCAT(a, b)		PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name)			ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION()			PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_THREAD_NAME(name)	Profiler::Instance().SetThreadName(name)
+#define PROFILE_COUNTER(name, value)	Profiler::Instance().SetCounter(name, static_cast<double>(value))
+#define PROFILE_BEGIN_FRAME()		Profiler::Instance().BeginFrame()
+#define PROFILE_END_FRAME()			Profiler::Instance().EndFrame()
+#else
+#define PROFILE_SCOPE(name)			((void)0)
+#define PROFILE_FUNCTION()			((void)0)
+#define PROFILE_THREAD_NAME(name)	((void)0)
+#define PROFILE_COUNTER(name, value)	((void)0)
+#define PROFILE_BEGIN_FRAME()		((void)0)
+#define PROFILE_END_FRAME()			((void)0)
+#endif
@@ -0,0 +1,259 @@
+#include "System/RenderBackend.h"
+#include "System/RenderContext.h"
+#include "System/Shader.h"
+
+// コンストラクタ
+D3D11RenderBackend::D3D11RenderBackend(const RenderContext& rc)
+	: rc(rc)
+	, dc(rc.deviceContext)
+{
+}
+
+// シェーダー設定
+void D3D11RenderBackend::SetShader(Shader* shader)
+{
+	if (shader == activeShader) return;
+
+	if (activeShader) activeShader->End(rc);
+	if (shader) shader->Begin(rc);
+	activeShader = shader;
+	++shaderBindCount;
+}
+
+// ブレンドステート設定
+void D3D11RenderBackend::SetBlendState(ID3D11BlendState* blendState)
+{
+	dc->OMSetBlendState(blendState, nullptr, 0xFFFFFFFF);
+}
+
+// 入力レイアウト設定
+void D3D11RenderBackend::SetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	dc->IASetInputLayout(inputLayout);
+}
+
+// 頂点シェーダー設定
+void D3D11RenderBackend::SetVertexShader(ID3D11VertexShader* vertexShader)
+{
+	dc->VSSetShader(vertexShader, nullptr, 0);
+}
+
+// ピクセルシェーダー設定
+void D3D11RenderBackend::SetPixelShader(ID3D11PixelShader* pixelShader)
+{
+	dc->PSSetShader(pixelShader, nullptr, 0);
+}
+
+// 頂点バッファ設定
+void D3D11RenderBackend::SetVertexBuffer(ID3D11Buffer* vertexBuffer, UINT stride)
+{
+	UINT offset = 0;
+	dc->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
+}
+
+// インデックスバッファ設定
+void D3D11RenderBackend::SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format)
+{
+	dc->IASetIndexBuffer(indexBuffer, format, 0);
+}
+
+// ピクセルシェーダーのシェーダーリソースビュー設定
+void D3D11RenderBackend::SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* srvs)
+{
+	dc->PSSetShaderResources(startSlot, count, srvs);
+}
+
+// 定数バッファの内容を置き換える
+void D3D11RenderBackend::UpdateConstantBuffer(ID3D11Buffer* buffer, const void* data, UINT size)
+{
+	dc->UpdateSubresource(buffer, 0, 0, data, 0, 0);
+}
+
+// インデックス付き描画
+void D3D11RenderBackend::DrawIndexed(UINT indexCount, UINT startIndex)
+{
+	dc->DrawIndexed(indexCount, startIndex, 0);
+}
+
+// 設定中のシェーダーの End() を呼ぶ
+void D3D11RenderBackend::Finish()
+{
+	if (activeShader) activeShader->End(rc);
+	activeShader = nullptr;
+}
+
+// シェーダー設定
+void RenderStateCache::SetShader(Shader* shader)
+{
+	if (shaderValid && this->shader == shader)
+	{
+		++skippedCount;
+		++shaderSkippedCount;
+		return;
+	}
+	this->shader = shader;
+	shaderValid = true;
+	target.SetShader(shader);
+	++issuedCount;
+
+	InvalidateShaderState();
+}
+
+// ブレンドステート設定
+void RenderStateCache::SetBlendState(ID3D11BlendState* blendState)
+{
+	if (blendStateValid && this->blendState == blendState)
+	{
+		++skippedCount;
+		return;
+	}
+	this->blendState = blendState;
+	blendStateValid = true;
+	target.SetBlendState(blendState);
+	++issuedCount;
+}
+
+
+// 入力レイアウト設定
+void RenderStateCache::SetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	if (inputLayoutValid && this->inputLayout == inputLayout)
+	{
+		++skippedCount;
+		return;
+	}
+	this->inputLayout = inputLayout;
+	inputLayoutValid = true;
+	target.SetInputLayout(inputLayout);
+	++issuedCount;
+}
+
+// 頂点シェーダー設定
+void RenderStateCache::SetVertexShader(ID3D11VertexShader* vertexShader)
+{
+	if (vertexShaderValid && this->vertexShader == vertexShader)
+	{
+		++skippedCount;
+		return;
+	}
+	this->vertexShader = vertexShader;
+	vertexShaderValid = true;
+	target.SetVertexShader(vertexShader);
+	++issuedCount;
+}
+
+// ピクセルシェーダー設定
+void RenderStateCache::SetPixelShader(ID3D11PixelShader* pixelShader)
+{
+	if (pixelShaderValid && this->pixelShader == pixelShader)
+	{
+		++skippedCount;
+		return;
+	}
+	this->pixelShader = pixelShader;
+	pixelShaderValid = true;
+	target.SetPixelShader(pixelShader);
+	++issuedCount;
+}
+
+// 頂点バッファ設定
+void RenderStateCache::SetVertexBuffer(ID3D11Buffer* vertexBuffer, UINT stride)
+{
+	if (vertexBufferValid && this->vertexBuffer == vertexBuffer && vertexStride == stride)
+	{
+		++skippedCount;
+		return;
+	}
+	this->vertexBuffer = vertexBuffer;
+	vertexStride = stride;
+	vertexBufferValid = true;
+	target.SetVertexBuffer(vertexBuffer, stride);
+	++issuedCount;
+}
+
+// インデックスバッファ設定
+void RenderStateCache::SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format)
+{
+	if (indexBufferValid && this->indexBuffer == indexBuffer && indexFormat == format)
+	{
+		++skippedCount;
+		return;
+	}
+	this->indexBuffer = indexBuffer;
+	indexFormat = format;
+	indexBufferValid = true;
+	target.SetIndexBuffer(indexBuffer, format);
+	++issuedCount;
+}
+
+// ピクセルシェーダーのシェーダーリソースビュー設定
+void RenderStateCache::SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* srvs)
+{
+	// 記憶していないスロットにかかる場合はそのまま送る
+	if (startSlot + count > ShaderResourceSlotCount)
+	{
+		for (UINT slot = startSlot; slot < ShaderResourceSlotCount; ++slot)
+		{
+			shaderResourceValid[slot] = false;
+		}
+		target.SetPixelShaderResources(startSlot, count, srvs);
+		++issuedCount;
+		return;
+	}
+
+	// 変わったスロットの範囲だけを1回で送る
+	UINT first = count;
+	UINT last = 0;
+	for (UINT i = 0; i < count; ++i)
+	{
+		const UINT slot = startSlot + i;
+		if (shaderResourceValid[slot] && shaderResources[slot] == srvs[i]) continue;
+
+		shaderResources[slot] = srvs[i];
+		shaderResourceValid[slot] = true;
+		if (first == count) first = i;
+		last = i;
+	}
+
+	if (first == count)
+	{
+		++skippedCount;
+		return;
+	}
+	target.SetPixelShaderResources(startSlot + first, last - first + 1, srvs + first);
+	++issuedCount;
+}
+
+// 定数バッファの内容を置き換える(内容は比較しないので常に送る)
+void RenderStateCache::UpdateConstantBuffer(ID3D11Buffer* buffer, const void* data, UINT size)
+{
+	target.UpdateConstantBuffer(buffer, data, size);
+}
+
+// インデックス付き描画
+void RenderStateCache::DrawIndexed(UINT indexCount, UINT startIndex)
+{
+	target.DrawIndexed(indexCount, startIndex);
+}
+
+// 記憶している設定を破棄する
+void RenderStateCache::Invalidate()
+{
+	shaderValid = false;
+	blendStateValid = false;
+	InvalidateShaderState();
+}
+
+// シェーダーの Begin() が変更しうる設定の記憶を破棄する
+void RenderStateCache::InvalidateShaderState()
+{
+	inputLayoutValid = false;
+	vertexShaderValid = false;
+	pixelShaderValid = false;
+	vertexBufferValid = false;
+	indexBufferValid = false;
+	for (bool& valid : shaderResourceValid)
+	{
+		valid = false;
+	}
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <d3d11.h>
+
+class Shader;
+struct RenderContext;
+
+// 描画コマンドの送り先
+// 頂点バッファやシェーダーの設定をこのインターフェースを通して行うことで、
+// 冗長な設定の除去や、GPU なしでのコマンドの記録ができるようにする
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() = default;
+
+	// シェーダー設定(切り替わるときに前のシェーダーの End() と新しいシェーダーの Begin() を呼ぶ)
+	virtual void SetShader(Shader* shader) = 0;
+
+	// ブレンドステート設定
+	virtual void SetBlendState(ID3D11BlendState* blendState) = 0;
+
+	// 入力レイアウト設定
+	virtual void SetInputLayout(ID3D11InputLayout* inputLayout) = 0;
+
+	// 頂点シェーダー設定
+	virtual void SetVertexShader(ID3D11VertexShader* vertexShader) = 0;
+
+	// ピクセルシェーダー設定(シェーダーのパーミュテーションの切り替え)
+	virtual void SetPixelShader(ID3D11PixelShader* pixelShader) = 0;
+
+	// 頂点バッファ設定(スロット0のみ)
+	virtual void SetVertexBuffer(ID3D11Buffer* vertexBuffer, UINT stride) = 0;
+
+	// インデックスバッファ設定
+	virtual void SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format) = 0;
+
+	// ピクセルシェーダーのシェーダーリソースビュー設定
+	virtual void SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* srvs) = 0;
+
+	// 定数バッファの内容を置き換える(data はこの呼び出しの間だけ有効であればよい)
+	virtual void UpdateConstantBuffer(ID3D11Buffer* buffer, const void* data, UINT size) = 0;
+
+	// インデックス付き描画
+	virtual void DrawIndexed(UINT indexCount, UINT startIndex) = 0;
+};
+
+// デバイスコンテキストにそのまま送るバックエンド
+// シェーダーの Begin()/End() には rc を渡すので、rc.deviceContext を使うスレッドからだけ呼ぶこと
+class D3D11RenderBackend : public RenderBackend
+{
+public:
+	D3D11RenderBackend(const RenderContext& rc);
+
+	void SetShader(Shader* shader) override;
+	void SetBlendState(ID3D11BlendState* blendState) override;
+	void SetInputLayout(ID3D11InputLayout* inputLayout) override;
+	void SetVertexShader(ID3D11VertexShader* vertexShader) override;
+	void SetPixelShader(ID3D11PixelShader* pixelShader) override;
+	void SetVertexBuffer(ID3D11Buffer* vertexBuffer, UINT stride) override;
+	void SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format) override;
+	void SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* srvs) override;
+	void UpdateConstantBuffer(ID3D11Buffer* buffer, const void* data, UINT size) override;
+	void DrawIndexed(UINT indexCount, UINT startIndex) override;
+
+	// 設定中のシェーダーの End() を呼ぶ
+	void Finish();
+
+	// シェーダーを切り替えた回数
+	size_t GetShaderBindCount() const { return shaderBindCount; }
+
+private:
+	const RenderContext&	rc;
+	ID3D11DeviceContext*	dc;
+	Shader*					activeShader = nullptr;
+	size_t					shaderBindCount = 0;
+};
+
+// コマンドの回数だけを記録するバックエンド(テスト・ヘッドレス実行用)
+// ポインタは比較にしか使わないので、実際のリソースでなくてもよい
+class RecordingRenderBackend : public RenderBackend
+{
+public:
+	struct Counters
+	{
+		size_t	shader = 0;
+		size_t	blendState = 0;
+		size_t	inputLayout = 0;
+		size_t	vertexShader = 0;
+		size_t	pixelShader = 0;
+		size_t	vertexBuffer = 0;
+		size_t	indexBuffer = 0;
+		size_t	shaderResources = 0;	// PSSetShaderResources の呼び出し回数
+		size_t	constantBuffer = 0;		// 定数バッファの更新回数
+		size_t	draw = 0;
+
+		// 描画以外の設定の合計
+		size_t GetStateChangeCount() const
+		{
+			return shader + blendState + inputLayout + vertexShader + pixelShader + vertexBuffer + indexBuffer + shaderResources;
+		}
+	};
+
+	void SetShader(Shader*) override { ++counters.shader; }
+	void SetBlendState(ID3D11BlendState*) override { ++counters.blendState; }
+	void SetInputLayout(ID3D11InputLayout*) override { ++counters.inputLayout; }
+	void SetVertexShader(ID3D11VertexShader*) override { ++counters.vertexShader; }
+	void SetPixelShader(ID3D11PixelShader*) override { ++counters.pixelShader; }
+	void SetVertexBuffer(ID3D11Buffer*, UINT) override { ++counters.vertexBuffer; }
+	void SetIndexBuffer(ID3D11Buffer*, DXGI_FORMAT) override { ++counters.indexBuffer; }
+	void SetPixelShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override { ++counters.shaderResources; }
+	void UpdateConstantBuffer(ID3D11Buffer*, const void*, UINT) override { ++counters.constantBuffer; }
+	void DrawIndexed(UINT, UINT) override { ++counters.draw; }
+
+	const Counters& GetCounters() const { return counters; }
+	void Reset() { counters = {}; }
+
+private:
+	Counters	counters;
+};
+
+// 直前と同じ設定を取り除いて別のバックエンドに送るフィルタ
+// シェーダーの Begin()/End() はデバイスコンテキストを直接変更するので、シェーダーが切り替わったら
+// シェーダーとブレンドステート以外の記憶を破棄する
+// バックエンドを通さずにデバイスコンテキストを直接変更した後は Invalidate() を呼ぶこと
+class RenderStateCache : public RenderBackend
+{
+public:
+	static const UINT ShaderResourceSlotCount = 8;	// 記憶しておくピクセルシェーダーのスロット数
+
+	RenderStateCache(RenderBackend& target) : target(target) {}
+
+	void SetShader(Shader* shader) override;
+	void SetBlendState(ID3D11BlendState* blendState) override;
+	void SetInputLayout(ID3D11InputLayout* inputLayout) override;
+	void SetVertexShader(ID3D11VertexShader* vertexShader) override;
+	void SetPixelShader(ID3D11PixelShader* pixelShader) override;
+	void SetVertexBuffer(ID3D11Buffer* vertexBuffer, UINT stride) override;
+	void SetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format) override;
+	void SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* srvs) override;
+	void UpdateConstantBuffer(ID3D11Buffer* buffer, const void* data, UINT size) override;
+	void DrawIndexed(UINT indexCount, UINT startIndex) override;
+
+	// 記憶している設定を破棄する(次の設定は必ず送る)
+	void Invalidate();
+
+	// 送った設定の数と、取り除いた設定の数
+	size_t GetIssuedCount() const { return issuedCount; }
+	size_t GetSkippedCount() const { return skippedCount; }
+
+	// 取り除いたシェーダー設定の数
+	size_t GetShaderSkippedCount() const { return shaderSkippedCount; }
+
+private:
+	// シェーダーの Begin() が変更しうる設定の記憶を破棄する
+	void InvalidateShaderState();
+
+private:
+	RenderBackend&				target;
+
+	// nullptr を設定した状態と区別するため、記憶しているかどうかを別に持つ
+	Shader*						shader = nullptr;
+	ID3D11BlendState*			blendState = nullptr;
+	ID3D11InputLayout*			inputLayout = nullptr;
+	ID3D11VertexShader*			vertexShader = nullptr;
+	ID3D11PixelShader*			pixelShader = nullptr;
+	ID3D11Buffer*				vertexBuffer = nullptr;
+	UINT						vertexStride = 0;
+	ID3D11Buffer*				indexBuffer = nullptr;
+	DXGI_FORMAT					indexFormat = DXGI_FORMAT_UNKNOWN;
+	ID3D11ShaderResourceView*	shaderResources[ShaderResourceSlotCount] = {};
+	bool						shaderValid = false;
+	bool						blendStateValid = false;
+	bool						inputLayoutValid = false;
+	bool						vertexShaderValid = false;
+	bool						pixelShaderValid = false;
+	bool						vertexBufferValid = false;
+	bool						indexBufferValid = false;
+	bool						shaderResourceValid[ShaderResourceSlotCount] = {};
+
+	size_t						issuedCount = 0;
+	size_t						skippedCount = 0;
+	size_t						shaderSkippedCount = 0;
+};
@@ -4,10 +4,13 @@
 #include "RenderState.h"
 #include "Light.h"
 
+class EnvironmentLighting;
+
 struct RenderContext
 {
 	ID3D11DeviceContext*	deviceContext;
 	const RenderState*		renderState;
 	const Camera*			camera;
 	const LightManager*		lightManager = nullptr;
+	const EnvironmentLighting*	environment = nullptr;	// nullptr なら環境光なし
 };
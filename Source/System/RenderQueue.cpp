@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstring>
+#include "System/RenderQueue.h"
+
+// 不透明パスのキー作成
+uint64_t RenderQueue::MakeOpaqueKey(uint32_t shader, uint32_t material, uint32_t mesh, float depth)
+{
+	uint64_t key = static_cast<uint64_t>(Pass::Opaque) << 62;
+	key |= static_cast<uint64_t>(shader & ((1u << ShaderBits) - 1)) << 58;
+	key |= static_cast<uint64_t>(material & ((1u << MaterialBits) - 1)) << 38;
+	key |= static_cast<uint64_t>(mesh & ((1u << MeshBits) - 1)) << 18;
+	key |= QuantizeDepth(depth, OpaqueDepthBits);
+	return key;
+}
+
+// 半透明パスのキー作成
+uint64_t RenderQueue::MakeTransparentKey(float depth, uint32_t shader, uint32_t material, uint32_t mesh)
+{
+	const uint32_t depthMask = (1u << TransparentDepthBits) - 1;
+
+	uint64_t key = static_cast<uint64_t>(Pass::Transparent) << 62;
+	key |= static_cast<uint64_t>(depthMask - QuantizeDepth(depth, TransparentDepthBits)) << 38;
+	key |= static_cast<uint64_t>(shader & ((1u << ShaderBits) - 1)) << 34;
+	key |= static_cast<uint64_t>(material & ((1u << MaterialBits) - 1)) << 14;
+	key |= static_cast<uint64_t>(mesh & ((1u << TransparentMeshBits) - 1));
+	return key;
+}
+
+// 深度を bits ビットの整数にする
+uint32_t RenderQueue::QuantizeDepth(float depth, uint32_t bits)
+{
+	// カメラより後ろや NaN は最も手前として扱う
+	if (!(depth > 0.0f)) return 0;
+
+	uint32_t u;
+	std::memcpy(&u, &depth, sizeof(u));
+
+	// 符号ビットは常に0なので、残りの31ビットの上位を使う
+	return u >> (31 - bits);
+}
+
+// キーの小さい順に並べ替える
+void RenderQueue::Sort()
+{
+	const size_t count = entries.size();
+	if (count < 2) return;
+
+	// 8ビットずつ下位から分配する基数ソート(安定)
+	// 全ての桁のヒストグラムを1回の走査で作り、全要素が同じ値になる桁は飛ばす
+	static const int DigitBits = 8;
+	static const int DigitCount = 64 / DigitBits;
+	static const int BucketCount = 1 << DigitBits;
+
+	size_t histograms[DigitCount][BucketCount] = {};
+	for (const Entry& entry : entries)
+	{
+		for (int digit = 0; digit < DigitCount; ++digit)
+		{
+			++histograms[digit][(entry.key >> (digit * DigitBits)) & (BucketCount - 1)];
+		}
+	}
+
+	scratch.resize(count);
+	Entry* src = entries.data();
+	Entry* dst = scratch.data();
+
+	for (int digit = 0; digit < DigitCount; ++digit)
+	{
+		size_t* histogram = histograms[digit];
+		const uint32_t firstBucket = static_cast<uint32_t>((src[0].key >> (digit * DigitBits)) & (BucketCount - 1));
+		if (histogram[firstBucket] == count) continue;
+
+		// 各値の書き込み開始位置
+		size_t offset = 0;
+		for (int bucket = 0; bucket < BucketCount; ++bucket)
+		{
+			const size_t n = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += n;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32_t bucket = static_cast<uint32_t>((src[i].key >> (digit * DigitBits)) & (BucketCount - 1));
+			dst[histogram[bucket]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+
+	// 奇数回分配した場合は作業領域に結果がある
+	if (src != entries.data())
+	{
+		entries.swap(scratch);
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// ソートキーによる描画順の並べ替え
+// 描画ごとに 64bit のキー(パス、シェーダー、マテリアル、メッシュ、深度)を作って基数ソートし、
+// 同じ設定を使う描画が連続するようにする
+//
+// 不透明パス   : [63-62 パス][61-58 シェーダー][57-38 マテリアル][37-18 メッシュ][17-0 深度(手前から)]
+// 半透明パス   : [63-62 パス][61-38 深度(奥から)][37-34 シェーダー][33-14 マテリアル][13-0 メッシュ]
+class RenderQueue
+{
+public:
+	enum class Pass : uint32_t
+	{
+		Opaque,
+		Transparent,
+	};
+
+	static const uint32_t ShaderBits = 4;
+	static const uint32_t MaterialBits = 20;
+	static const uint32_t MeshBits = 20;
+	static const uint32_t OpaqueDepthBits = 18;
+	static const uint32_t TransparentDepthBits = 24;
+	static const uint32_t TransparentMeshBits = 14;
+
+	struct Entry
+	{
+		uint64_t	key;
+		uint32_t	index;		// 呼び出し側の描画情報の番号
+	};
+
+	// 不透明パスのキー作成(シェーダー、マテリアル、メッシュの番号は小さい値から振ること)
+	static uint64_t MakeOpaqueKey(uint32_t shader, uint32_t material, uint32_t mesh, float depth);
+
+	// 半透明パスのキー作成(奥から手前の順を優先する)
+	static uint64_t MakeTransparentKey(float depth, uint32_t shader, uint32_t material, uint32_t mesh);
+
+	// キーからパスを取得
+	static Pass GetPass(uint64_t key) { return static_cast<Pass>(key >> 62); }
+
+	// 深度を bits ビットの整数にする(正の float のビット列は大小関係が整数と同じなので上位ビットを使う)
+	static uint32_t QuantizeDepth(float depth, uint32_t bits);
+
+	// 全ての描画を破棄
+	void Clear() { entries.clear(); }
+
+	// 描画を追加
+	void Add(uint64_t key, uint32_t index) { entries.push_back({ key, index }); }
+
+	// 描画の数を決める(Set() で位置を指定して書き込めば、複数のスレッドから並列に追加できる)
+	void Resize(size_t count) { entries.resize(count); }
+
+	// position 番目の描画を設定
+	void Set(size_t position, uint64_t key, uint32_t index) { entries[position] = { key, index }; }
+
+	// キーの小さい順に並べ替える(同じキーは追加した順を保つ)
+	void Sort();
+
+	// 並べ替えた描画を取得
+	const std::vector<Entry>& GetEntries() const { return entries; }
+
+private:
+	std::vector<Entry>	entries;
+	std::vector<Entry>	scratch;
+};
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Misc.h"
+#include "System/CommandList.h"
+#include "System/JobSystem.h"
+#include "System/RenderBackend.h"
+#include "System/RenderQueue.h"
+#include "System/RenderQueueBenchmark.h"
+
+namespace
+{
+	// 記録用バックエンドは比較にしか使わないので、番号をそのままポインタにする
+	template<class T>
+	T* MakeHandle(size_t id)
+	{
+		return reinterpret_cast<T*>(static_cast<uintptr_t>(id + 1) * 16);
+	}
+
+	// 合成シーンのメッシュ
+	struct BenchmarkMesh
+	{
+		uint32_t	shader;
+		uint32_t	vertexFormat;
+		uint32_t	material;
+		uint32_t	id;
+	};
+
+	// 合成シーンの描画
+	struct BenchmarkDraw
+	{
+		const BenchmarkMesh*	mesh;
+		float					depth;
+	};
+
+	// ModelRenderer の1描画分と同じ設定を送る
+	void Submit(RenderBackend& backend, const BenchmarkDraw& draw)
+	{
+		const BenchmarkMesh& mesh = *draw.mesh;
+		const size_t shaderFormat = mesh.shader * 2 + mesh.vertexFormat;
+
+		backend.SetShader(MakeHandle<Shader>(mesh.shader));
+		backend.SetVertexBuffer(MakeHandle<ID3D11Buffer>(mesh.id * 2), 32);
+		backend.SetIndexBuffer(MakeHandle<ID3D11Buffer>(mesh.id * 2 + 1), DXGI_FORMAT_R16_UINT);
+		backend.SetInputLayout(MakeHandle<ID3D11InputLayout>(shaderFormat));
+		backend.SetVertexShader(MakeHandle<ID3D11VertexShader>(shaderFormat));
+
+		ID3D11ShaderResourceView* srvs[5];
+		for (size_t i = 0; i < 5; ++i)
+		{
+			srvs[i] = MakeHandle<ID3D11ShaderResourceView>(mesh.material * 5 + i);
+		}
+		backend.SetPixelShaderResources(1, 5, srvs);
+
+		const float constants[4] = { draw.depth, 0.0f, 0.0f, 0.0f };
+		backend.UpdateConstantBuffer(MakeHandle<ID3D11Buffer>(0), constants, sizeof(constants));
+
+		backend.DrawIndexed(36, 0);
+	}
+}
+
+// ベンチマーク実行
+RenderQueueBenchmark::Result RenderQueueBenchmark::Run(size_t instanceCount, size_t modelCount, size_t meshesPerModel,
+	size_t recordGrainSize)
+{
+	std::mt19937 random(12345);
+
+	// モデルごとにシェーダーと頂点形式を決め、マテリアルはモデル内の数種類を使い回す
+	std::vector<BenchmarkMesh> meshes;
+	for (size_t model = 0; model < modelCount; ++model)
+	{
+		const uint32_t shader = static_cast<uint32_t>(random() % 3);
+		const uint32_t vertexFormat = static_cast<uint32_t>(random() % 2);
+		for (size_t i = 0; i < meshesPerModel; ++i)
+		{
+			BenchmarkMesh& mesh = meshes.emplace_back();
+			mesh.shader = shader;
+			mesh.vertexFormat = vertexFormat;
+			mesh.material = static_cast<uint32_t>(model * meshesPerModel + i % 2);
+			mesh.id = static_cast<uint32_t>(meshes.size() - 1);
+		}
+	}
+
+	// インスタンスはゲームオブジェクトの生成順のようにモデルがばらばらに並ぶ
+	std::uniform_real_distribution<float> depthDistribution(1.0f, 500.0f);
+	std::vector<BenchmarkDraw> draws;
+	for (size_t instance = 0; instance < instanceCount; ++instance)
+	{
+		const size_t model = random() % modelCount;
+		const float depth = depthDistribution(random);
+		for (size_t i = 0; i < meshesPerModel; ++i)
+		{
+			draws.push_back({ &meshes[model * meshesPerModel + i], depth });
+		}
+	}
+
+	Result result;
+	result.drawCount = draws.size();
+
+	// 予約順にそのまま送る
+	RecordingRenderBackend recorder;
+	for (const BenchmarkDraw& draw : draws)
+	{
+		Submit(recorder, draw);
+	}
+	result.submissionStateChanges = recorder.GetCounters().GetStateChangeCount();
+
+	// 予約順のまま冗長な設定を取り除く
+	recorder.Reset();
+	{
+		RenderStateCache cache(recorder);
+		for (const BenchmarkDraw& draw : draws)
+		{
+			Submit(cache, draw);
+		}
+	}
+	result.cachedStateChanges = recorder.GetCounters().GetStateChangeCount();
+
+	// キーで並べ替えてから送る
+	RenderQueue queue;
+	Benchmark benchmark;
+	benchmark.begin();
+	for (size_t i = 0; i < draws.size(); ++i)
+	{
+		const BenchmarkMesh& mesh = *draws[i].mesh;
+		queue.Add(RenderQueue::MakeOpaqueKey(mesh.shader * 2 + mesh.vertexFormat, mesh.material, mesh.id, draws[i].depth),
+			static_cast<uint32_t>(i));
+	}
+	queue.Sort();
+	result.sortSeconds = benchmark.end();
+
+	recorder.Reset();
+	{
+		RenderStateCache cache(recorder);
+		for (const RenderQueue::Entry& entry : queue.GetEntries())
+		{
+			Submit(cache, draws[entry.index]);
+		}
+	}
+	result.sortedStateChanges = recorder.GetCounters().GetStateChangeCount();
+
+	// 並べ替えた描画を区切ってワーカースレッドでコマンドリストに記録し、順番に送る
+	const std::vector<RenderQueue::Entry>& entries = queue.GetEntries();
+	const size_t chunkCount = (entries.size() + recordGrainSize - 1) / recordGrainSize;
+	std::vector<CommandList> commandLists(chunkCount);
+
+	benchmark.begin();
+	JobSystem::Instance().ParallelFor(0, chunkCount, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t chunk = begin; chunk < end; ++chunk)
+		{
+			RenderStateCache cache(commandLists[chunk]);
+			const size_t last = std::min(entries.size(), (chunk + 1) * recordGrainSize);
+			for (size_t i = chunk * recordGrainSize; i < last; ++i)
+			{
+				Submit(cache, draws[entries[i].index]);
+			}
+		}
+	});
+	result.recordSeconds = benchmark.end();
+
+	recorder.Reset();
+	for (const CommandList& commandList : commandLists)
+	{
+		commandList.Execute(recorder);
+	}
+	result.commandListCount = chunkCount;
+	result.commandListStateChanges = recorder.GetCounters().GetStateChangeCount();
+	result.commandListDraws = recorder.GetCounters().draw;
+
+	return result;
+}
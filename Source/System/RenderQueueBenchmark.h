@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+// 描画順の並べ替えによる設定変更の削減量を測るベンチマーク
+// 合成したシーンの描画を記録用バックエンドに送り、GPU を使わずに設定変更の回数を数える
+class RenderQueueBenchmark
+{
+public:
+	struct Result
+	{
+		size_t	drawCount = 0;
+		size_t	submissionStateChanges = 0;	// 予約順に毎回全ての設定を送った場合
+		size_t	cachedStateChanges = 0;		// 予約順のまま冗長な設定だけを取り除いた場合
+		size_t	sortedStateChanges = 0;		// キーで並べ替えてから冗長な設定を取り除いた場合
+		float	sortSeconds = 0.0f;			// キー作成と並べ替えの時間
+		size_t	commandListCount = 0;
+		size_t	commandListStateChanges = 0;	// 並べ替えた描画を区切って並列に記録し、順番に送った場合
+		size_t	commandListDraws = 0;			// 記録して送った描画数(drawCount と一致すること)
+		float	recordSeconds = 0.0f;			// コマンドリストへの並列記録の時間
+	};
+
+	// ベンチマーク実行
+	// modelCount 種類のモデル(それぞれ meshesPerModel 個のメッシュ)を instanceCount 個ランダムな順で描画する
+	// コマンドリストは recordGrainSize 個の描画ごとに区切って記録する
+	static Result Run(size_t instanceCount, size_t modelCount = 32, size_t meshesPerModel = 4, size_t recordGrainSize = 128);
+};
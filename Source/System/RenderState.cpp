@@ -1,10 +1,10 @@
 #include "Misc.h"
 #include "RenderState.h"
 
-// RXgN^
+// コンストラクタ
 RenderState::RenderState(ID3D11Device* device)
 {
-	// |CgTvOeNX`JԂ
+	// ポイントサンプリング＆テクスチャ繰り返しあり
 	{
 		D3D11_SAMPLER_DESC desc;
 		desc.MipLODBias = 0.0f;
@@ -24,7 +24,7 @@ RenderState::RenderState(ID3D11Device* device)
 			samplerStates[static_cast<int>(SamplerState::PointWrap)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// |CgTvOeNX`JԂȂ
+	// ポイントサンプリング＆テクスチャ繰り返しなし
 	{
 		D3D11_SAMPLER_DESC desc;
 		desc.MipLODBias = 0.0f;
@@ -44,7 +44,7 @@ RenderState::RenderState(ID3D11Device* device)
 			samplerStates[static_cast<int>(SamplerState::PointClamp)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// jATvOeNX`JԂ
+	// リニアサンプリング＆テクスチャ繰り返しあり
 	{
 		D3D11_SAMPLER_DESC desc;
 		desc.MipLODBias = 0.0f;
@@ -64,7 +64,7 @@ RenderState::RenderState(ID3D11Device* device)
 			samplerStates[static_cast<int>(SamplerState::LinearWrap)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// jATvOeNX`JԂȂ
+	// リニアサンプリング＆テクスチャ繰り返しなし
 	{
 		D3D11_SAMPLER_DESC desc;
 		desc.MipLODBias = 0.0f;
@@ -85,7 +85,7 @@ RenderState::RenderState(ID3D11Device* device)
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// [xeXg聕[x݂
+	// 深度テストあり＆深度書き込みあり
 	{
 		D3D11_DEPTH_STENCIL_DESC desc{};
 		desc.DepthEnable = true;
@@ -95,7 +95,7 @@ RenderState::RenderState(ID3D11Device* device)
 			depthStencilStates[static_cast<int>(DepthState::TestAndWrite)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// [xeXg聕[x݂Ȃ
+	// 深度テストあり＆深度書き込みなし
 	{
 		D3D11_DEPTH_STENCIL_DESC desc{};
 		desc.DepthEnable = true;
@@ -105,7 +105,7 @@ RenderState::RenderState(ID3D11Device* device)
 			depthStencilStates[static_cast<int>(DepthState::TestOnly)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// [xeXgȂ[x݂
+	// 深度テストなし＆深度書き込みあり
 	{
 		D3D11_DEPTH_STENCIL_DESC desc{};
 		desc.DepthEnable = true;
@@ -115,7 +115,7 @@ RenderState::RenderState(ID3D11Device* device)
 			depthStencilStates[static_cast<int>(DepthState::WriteOnly)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// [xeXgȂ[x݂Ȃ
+	// 深度テストなし＆深度書き込みなし
 	{
 		D3D11_DEPTH_STENCIL_DESC desc{};
 		desc.DepthEnable = false;
@@ -126,7 +126,7 @@ RenderState::RenderState(ID3D11Device* device)
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// Ȃ
+	// 合成なし
 	{
 		D3D11_BLEND_DESC desc{};
 		desc.AlphaToCoverageEnable = false;
@@ -143,7 +143,7 @@ RenderState::RenderState(ID3D11Device* device)
 			blendStates[static_cast<int>(BlendState::Opaque)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// ʏ퍇
+	// 通常合成
 	{
 		D3D11_BLEND_DESC desc{};
 		desc.AlphaToCoverageEnable = false;
@@ -160,7 +160,7 @@ RenderState::RenderState(ID3D11Device* device)
 			blendStates[static_cast<int>(BlendState::Transparency)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// Z
+	// 加算合成
 	{
 		D3D11_BLEND_DESC desc{};
 		desc.AlphaToCoverageEnable = false;
@@ -177,7 +177,7 @@ RenderState::RenderState(ID3D11Device* device)
 			blendStates[static_cast<int>(BlendState::Additive)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// Z
+	// 減算合成
 	{
 		D3D11_BLEND_DESC desc{};
 		desc.AlphaToCoverageEnable = false;
@@ -194,7 +194,7 @@ RenderState::RenderState(ID3D11Device* device)
 			blendStates[static_cast<int>(BlendState::Subtraction)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// Z
+	// 乗算合成
 	{
 		D3D11_BLEND_DESC desc{};
 		desc.AlphaToCoverageEnable = false;
@@ -212,7 +212,7 @@ RenderState::RenderState(ID3D11Device* device)
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// x^h聕JOȂ
+	// ベタ塗り＆カリングなし
 	{
 		D3D11_RASTERIZER_DESC desc{};
 		desc.FrontCounterClockwise = false;
@@ -229,7 +229,7 @@ RenderState::RenderState(ID3D11Device* device)
 			rasterizerStates[static_cast<int>(RasterizerState::SolidCullNone)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// x^h聕ʃJO
+	// ベタ塗り＆裏面カリング
 	{
 		D3D11_RASTERIZER_DESC desc{};
 		desc.FrontCounterClockwise = false;
@@ -246,7 +246,7 @@ RenderState::RenderState(ID3D11Device* device)
 			rasterizerStates[static_cast<int>(RasterizerState::SolidCullBack)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// C[t[JOȂ
+	// ワイヤーフレーム＆カリングなし
 	{
 		D3D11_RASTERIZER_DESC desc{};
 		desc.FrontCounterClockwise = false;
@@ -263,7 +263,7 @@ RenderState::RenderState(ID3D11Device* device)
 			rasterizerStates[static_cast<int>(RasterizerState::WireCullNone)].GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
-	// C[t[ʃJO
+	// ワイヤーフレーム＆裏面カリング
 	{
 		D3D11_RASTERIZER_DESC desc{};
 		desc.FrontCounterClockwise = false;
@@ -3,7 +3,7 @@
 #include <wrl.h>
 #include <d3d11.h>
 
-// TvXe[g
+// サンプラステート
 enum class SamplerState
 {
 	PointWrap,
@@ -14,7 +14,7 @@ enum class SamplerState
 	EnumCount
 };
 
-// fvXXe[g
+// デプスステート
 enum class DepthState
 {
 	TestAndWrite,
@@ -25,7 +25,7 @@ enum class DepthState
 	EnumCount
 };
 
-// uhXe[g
+// ブレンドステート
 enum class BlendState
 {
 	Opaque,
@@ -37,7 +37,7 @@ enum class BlendState
 	EnumCount
 };
 
-// X^CUXe[g
+// ラスタライザステート
 enum class RasterizerState
 {
 	SolidCullNone,
@@ -48,32 +48,32 @@ enum class RasterizerState
 	EnumCount
 };
 
-// _[Xe[g
+// レンダーステート
 class RenderState
 {
 public:
 	RenderState(ID3D11Device* device);
 	~RenderState() = default;
 
-	// TvXe[g擾
+	// サンプラステート取得
 	ID3D11SamplerState* GetSamplerState(SamplerState state) const
 	{
 		return samplerStates[static_cast<int>(state)].Get();
 	}
 
-	// fvXXe[g擾
+	// デプスステート取得
 	ID3D11DepthStencilState* GetDepthStencilState(DepthState state) const
 	{
 		return depthStencilStates[static_cast<int>(state)].Get();
 	}
 
-	// uhXe[g擾
+	// ブレンドステート取得
 	ID3D11BlendState* GetBlendState(BlendState state) const
 	{
 		return blendStates[static_cast<int>(state)].Get();
 	}
 
-	// X^CU[Xe[g擾
+	// ラスタライザーステート取得
 	ID3D11RasterizerState* GetRasterizerState(RasterizerState state) const
 	{
 		return rasterizerStates[static_cast<int>(state)].Get();
@@ -3,10 +3,10 @@
 #include "Graphics.h"
 #include "ResourceManager.h"
 
-// f\[Xǂݍ
+// モデルリソース読み込み
 std::shared_ptr<ModelResource> ResourceManager::LoadModelResource(const char* filename)
 {
-	//ǂݍݍς݂ȂԂ
+	//読み込み済みなら既存を返す
 	if (models.find(filename) != models.end())
 	{
 		if (models[filename].expired() == false)
@@ -14,20 +14,20 @@ std::shared_ptr<ModelResource> ResourceManager::LoadModelResource(const char* fi
 			return models[filename].lock();
 		}
 	}
-	//VKf\[X쐬ǂݍ
+	//新規モデルリソース作成＆読み込み
 	auto m = std::make_shared<ModelResource>();
 	m->Load(Graphics::Instance().GetDevice(), filename);
 
-	//ǂݍ݊Ǘpϐɓo^
+	//読み込み管理用変数に登録
 	models[filename] = m;
 
 	return m;
 }
 
-// VKǉ: ModelpiGLTFfj
+// 新規追加: Model用（GLTFモデル）
 std::shared_ptr<Model> ResourceManager::LoadModel(const char* filename, float sampleRate)
 {
-	// ǂݍݍς݂ȂԂ
+	// 読み込み済みなら既存を返す
 	if (gltfModels.find(filename) != gltfModels.end())
 	{
 		if (gltfModels[filename].expired() == false)
@@ -36,20 +36,20 @@ std::shared_ptr<Model> ResourceManager::LoadModel(const char* filename, float sa
 		}
 	}
 
-	// VKModel쐬ǂݍ
+	// 新規Model作成＆読み込み
 	auto model = std::make_shared<Model>(Graphics::Instance().GetDevice(), filename, sampleRate);
 
-	// ǂݍ݊Ǘpϐɓo^
+	// 読み込み管理用変数に登録
 	gltfModels[filename] = model;
 	return model;
 }
 
-// fobOGUI`
+// デバッグGUI描画
 void ResourceManager::DrawDebugGUI()
 {
 	if (ImGui::CollapsingHeader("Resource", ImGuiTreeNodeFlags_DefaultOpen))
 	{
-		// ModelResourcei`j
+		// ModelResource（旧形式）
 		if (ImGui::TreeNode("ModelResource (Legacy)"))
 		{
 			for (auto it = models.begin(); it != models.end(); ++it)
@@ -61,15 +61,28 @@ void ResourceManager::DrawDebugGUI()
 			ImGui::TreePop();
 		}
 
-		// ModeliGLTF`j
+		// Model（GLTF形式）
 		if (ImGui::TreeNode("Model (GLTF)"))
 		{
+			// 頂点圧縮で削減できたGPUメモリ
+			size_t totalSize = 0, totalUncompressedSize = 0;
 			for (auto it = gltfModels.begin(); it != gltfModels.end(); ++it)
 			{
 				std::filesystem::path filepath(it->first);
 				int use_count = it->second.use_count();
 				ImGui::Text("use_count = %5d : %s", use_count, filepath.filename().u8string().c_str());
+
+				if (std::shared_ptr<Model> model = it->second.lock())
+				{
+					const size_t size = model->GetVertexBufferSize();
+					const size_t uncompressedSize = model->GetVertexBufferSize(false);
+					ImGui::Text("    vertex buffer = %8.1f KB (%8.1f KB uncompressed)", size / 1024.0f, uncompressedSize / 1024.0f);
+					totalSize += size;
+					totalUncompressedSize += uncompressedSize;
+				}
 			}
+			ImGui::Text("vertex buffer total = %.1f KB, saved %.1f KB",
+				totalSize / 1024.0f, (totalUncompressedSize - totalSize) / 1024.0f);
 			ImGui::TreePop();
 		}
 	}
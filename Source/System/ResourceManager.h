@@ -5,7 +5,7 @@
 #include <map>
 #include "ModelResource.h"
 
-// \[X}l[W[
+// リソースマネージャー
 class ResourceManager
 {
 private:
@@ -13,14 +13,14 @@ private:
 	~ResourceManager() {}
 
 public:
-	// B̃CX^X擾
+	// 唯一のインスタンス取得
 	static ResourceManager& Instance()
 	{
 		static ResourceManager instance;
 		return instance;
 	}
 
-	// f\[Xǂݍ
+	// モデルリソース読み込み
 	std::shared_ptr<ModelResource> LoadModelResource(const char* filename);
 
 	std::shared_ptr<Model> LoadModel(const char* filename, float sampleRate = 0.0f);
@@ -2,6 +2,7 @@
 
 #include "RenderContext.h"
 #include "Model.h"
+#include "RenderBackend.h"
 
 class Shader
 {
@@ -9,12 +10,16 @@ public:
 	Shader() {}
 	virtual ~Shader() {}
 
-	// Jn
+	// 開始処理
 	virtual void Begin(const RenderContext& rc) = 0;
 
-	// XV
-	virtual void Update(const RenderContext& rc, const Model::Mesh& mesh) = 0;
+	// 更新処理(メッシュごとの設定は backend を通して行い、同じ設定の繰り返しを取り除けるようにする)
+	// ワーカースレッドからコマンドリストに記録するために呼ぶので、rc.deviceContext には触れないこと
+	virtual void Update(const RenderContext& rc, RenderBackend& backend, const Model::Mesh& mesh) = 0;
 
-	// I
+	// 終了処理
 	virtual void End(const RenderContext& rc) = 0;
+
+	// メッシュのマテリアルで決まるパーミュテーションの番号(描画の並べ替えで同じピクセルシェーダーをまとめる)
+	virtual uint32_t GetPermutation(const Model::Mesh& mesh) const { return 0; }
 };
@@ -0,0 +1,283 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <imgui.h>
+#include "System/Misc.h"
+#include "System/ShaderCache.h"
+
+// まとめたファイルの先頭
+// [ヘッダ][索引 × entryCount][名前とバイトコード]
+struct ShaderCacheHeader
+{
+	char		magic[4];
+	uint32_t	version;
+	uint32_t	entryCount;
+	uint32_t	reserved;
+};
+
+// 索引(オフセットはデータ部の先頭から)
+struct ShaderCacheIndex
+{
+	uint64_t	sourceSize;
+	uint64_t	sourceTime;
+	uint32_t	nameOffset;
+	uint32_t	nameLength;
+	uint32_t	bytecodeOffset;
+	uint32_t	bytecodeSize;
+};
+
+static const char CacheMagic[4] = { 'S', 'H', 'D', 'C' };
+static const uint32_t CacheVersion = 1;
+
+// 初期化
+void ShaderCache::Initialize(const char* filename)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	this->filename = filename;
+	entries.clear();
+	statistics = {};
+	dirty = !Load();
+}
+
+// 終了化
+void ShaderCache::Finalize()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (dirty && !filename.empty())
+	{
+		Save();
+		dirty = false;
+	}
+	entries.clear();
+}
+
+// .cso と照合した項目を取得
+ShaderCache::Entry* ShaderCache::FindEntry(const char* filename)
+{
+	auto it = entries.find(filename);
+	if (it != entries.end() && it->second.validated) return &it->second;
+
+	// .cso がなければまとめたファイルの内容をそのまま使い、あれば大きさと更新日時を比べる
+	std::error_code error;
+	const uint64_t size = std::filesystem::file_size(filename, error);
+	if (error)
+	{
+		if (it == entries.end()) return nullptr;
+		it->second.validated = true;
+		++statistics.cacheHitCount;
+		return &it->second;
+	}
+	const uint64_t time = static_cast<uint64_t>(std::filesystem::last_write_time(filename, error).time_since_epoch().count());
+
+	if (it != entries.end() && it->second.sourceSize == size && it->second.sourceTime == time)
+	{
+		it->second.validated = true;
+		++statistics.cacheHitCount;
+		return &it->second;
+	}
+
+	// 読み直す
+	std::ifstream stream(filename, std::ios::binary);
+	if (!stream) return nullptr;
+
+	Entry& entry = entries[filename];
+	entry.bytecode.resize(static_cast<size_t>(size));
+	stream.read(reinterpret_cast<char*>(entry.bytecode.data()), static_cast<std::streamsize>(size));
+	entry.sourceSize = size;
+	entry.sourceTime = time;
+	entry.validated = true;
+	entry.vertexShader.Reset();
+	entry.pixelShader.Reset();
+	entry.computeShader.Reset();
+
+	++statistics.fileLoadCount;
+	dirty = true;
+	return &entry;
+}
+
+// バイトコード取得
+const std::vector<uint8_t>* ShaderCache::GetBytecode(const char* filename)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Entry* entry = FindEntry(filename);
+	return entry ? &entry->bytecode : nullptr;
+}
+
+// 頂点シェーダー取得
+ID3D11VertexShader* ShaderCache::GetVertexShader(ID3D11Device* device, const char* filename)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Entry* entry = FindEntry(filename);
+	if (entry == nullptr) return nullptr;
+
+	if (entry->vertexShader)
+	{
+		++statistics.shaderShareCount;
+		return entry->vertexShader.Get();
+	}
+
+	HRESULT hr = device->CreateVertexShader(entry->bytecode.data(), entry->bytecode.size(), nullptr, entry->vertexShader.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	++statistics.shaderCreateCount;
+	return entry->vertexShader.Get();
+}
+
+// ピクセルシェーダー取得
+ID3D11PixelShader* ShaderCache::GetPixelShader(ID3D11Device* device, const char* filename)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Entry* entry = FindEntry(filename);
+	if (entry == nullptr) return nullptr;
+
+	if (entry->pixelShader)
+	{
+		++statistics.shaderShareCount;
+		return entry->pixelShader.Get();
+	}
+
+	HRESULT hr = device->CreatePixelShader(entry->bytecode.data(), entry->bytecode.size(), nullptr, entry->pixelShader.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	++statistics.shaderCreateCount;
+	return entry->pixelShader.Get();
+}
+
+// コンピュートシェーダー取得
+ID3D11ComputeShader* ShaderCache::GetComputeShader(ID3D11Device* device, const char* filename)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Entry* entry = FindEntry(filename);
+	if (entry == nullptr) return nullptr;
+
+	if (entry->computeShader)
+	{
+		++statistics.shaderShareCount;
+		return entry->computeShader.Get();
+	}
+
+	HRESULT hr = device->CreateComputeShader(entry->bytecode.data(), entry->bytecode.size(), nullptr, entry->computeShader.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	++statistics.shaderCreateCount;
+	return entry->computeShader.Get();
+}
+
+// まとめたファイルの読み込み
+bool ShaderCache::Load()
+{
+	// 1回で全体を読み込んでから索引をたどる
+	std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+	if (!stream) return false;
+	const std::streamsize fileSize = stream.tellg();
+	if (fileSize < static_cast<std::streamsize>(sizeof(ShaderCacheHeader))) return false;
+
+	std::vector<char> data(static_cast<size_t>(fileSize));
+	stream.seekg(0);
+	stream.read(data.data(), fileSize);
+	if (!stream) return false;
+
+	ShaderCacheHeader header;
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (std::memcmp(header.magic, CacheMagic, sizeof(header.magic)) != 0 || header.version != CacheVersion) return false;
+
+	const size_t indexOffset = sizeof(ShaderCacheHeader);
+	const size_t dataOffset = indexOffset + sizeof(ShaderCacheIndex) * header.entryCount;
+	if (dataOffset > data.size()) return false;
+
+	for (uint32_t i = 0; i < header.entryCount; ++i)
+	{
+		ShaderCacheIndex index;
+		std::memcpy(&index, data.data() + indexOffset + sizeof(ShaderCacheIndex) * i, sizeof(index));
+
+		const size_t nameEnd = dataOffset + static_cast<size_t>(index.nameOffset) + index.nameLength;
+		const size_t bytecodeEnd = dataOffset + static_cast<size_t>(index.bytecodeOffset) + index.bytecodeSize;
+		if (nameEnd > data.size() || bytecodeEnd > data.size())
+		{
+			entries.clear();
+			return false;
+		}
+
+		const char* name = data.data() + dataOffset + index.nameOffset;
+		const uint8_t* bytecode = reinterpret_cast<const uint8_t*>(data.data() + dataOffset + index.bytecodeOffset);
+
+		Entry& entry = entries[std::string(name, index.nameLength)];
+		entry.bytecode.assign(bytecode, bytecode + index.bytecodeSize);
+		entry.sourceSize = index.sourceSize;
+		entry.sourceTime = index.sourceTime;
+	}
+
+	statistics.entryCount = header.entryCount;
+	return true;
+}
+
+// まとめたファイルの書き込み
+bool ShaderCache::Save() const
+{
+	// 今回使わなかったパーミュテーションも残す
+	std::vector<ShaderCacheIndex> indices;
+	indices.reserve(entries.size());
+	uint32_t offset = 0;
+	for (const auto& [name, entry] : entries)
+	{
+		ShaderCacheIndex index = {};
+		index.sourceSize = entry.sourceSize;
+		index.sourceTime = entry.sourceTime;
+		index.nameOffset = offset;
+		index.nameLength = static_cast<uint32_t>(name.size());
+		offset += index.nameLength;
+		index.bytecodeOffset = offset;
+		index.bytecodeSize = static_cast<uint32_t>(entry.bytecode.size());
+		offset += index.bytecodeSize;
+		indices.emplace_back(index);
+	}
+
+	std::ofstream stream(filename, std::ios::binary);
+	if (!stream) return false;
+
+	ShaderCacheHeader header = {};
+	std::memcpy(header.magic, CacheMagic, sizeof(header.magic));
+	header.version = CacheVersion;
+	header.entryCount = static_cast<uint32_t>(indices.size());
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	stream.write(reinterpret_cast<const char*>(indices.data()), sizeof(ShaderCacheIndex) * indices.size());
+
+	for (const auto& [name, entry] : entries)
+	{
+		stream.write(name.data(), name.size());
+		stream.write(reinterpret_cast<const char*>(entry.bytecode.data()), entry.bytecode.size());
+	}
+	return stream.good();
+}
+
+// 統計
+ShaderCache::Statistics ShaderCache::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Statistics result = statistics;
+	result.bytecodeBytes = 0;
+	for (const auto& [name, entry] : entries)
+	{
+		result.bytecodeBytes += entry.bytecode.size();
+	}
+	return result;
+}
+
+// デバッグGUI描画
+void ShaderCache::DrawDebugGUI()
+{
+	if (ImGui::CollapsingHeader("Shader Cache", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const Statistics stats = GetStatistics();
+		ImGui::Text("Cached      : %u", stats.entryCount);
+		ImGui::Text("Cache Hits  : %u", stats.cacheHitCount);
+		ImGui::Text("File Loads  : %u", stats.fileLoadCount);
+		ImGui::Text("Created     : %u", stats.shaderCreateCount);
+		ImGui::Text("Shared      : %u", stats.shaderShareCount);
+		ImGui::Text("Bytecode    : %.1f KB", stats.bytecodeBytes / 1024.0f);
+	}
+}
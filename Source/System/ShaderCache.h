@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <wrl.h>
+#include <d3d11.h>
+
+// コンパイル済みシェーダー(.cso)のキャッシュ
+// .cso はビルド時に FxCompile がパーミュテーションごとに作る(define を書いた小さな .hlsl から本体を #include する)
+// 起動時に全ての .cso のバイトコードを索引付きでまとめた1つのファイルを読み込み、シェーダーはファイル名をキーにして取り出す
+// .cso の大きさと更新日時が変わっていればその .cso だけを読み直し、終了時にまとめたファイルを書き直す
+// シェーダーオブジェクトはファイル名ごとに1つだけ作り、同じシェーダーを使うクラスで共有する
+class ShaderCache
+{
+private:
+	ShaderCache() = default;
+	~ShaderCache() = default;
+
+public:
+	// インスタンス取得
+	static ShaderCache& Instance()
+	{
+		static ShaderCache instance;
+		return instance;
+	}
+
+	// 初期化(シェーダーを読み込む前に呼ぶ)
+	void Initialize(const char* filename);
+
+	// 終了化(読み直した .cso があればまとめたファイルを書き直す)
+	void Finalize();
+
+	// バイトコード取得(見つからなければ nullptr、入力レイアウトの作成に使う)
+	const std::vector<uint8_t>* GetBytecode(const char* filename);
+
+	// シェーダー取得(見つからなければ nullptr、参照はキャッシュが持つ)
+	ID3D11VertexShader* GetVertexShader(ID3D11Device* device, const char* filename);
+	ID3D11PixelShader* GetPixelShader(ID3D11Device* device, const char* filename);
+	ID3D11ComputeShader* GetComputeShader(ID3D11Device* device, const char* filename);
+
+	// 統計
+	struct Statistics
+	{
+		UINT	entryCount = 0;			// まとめたファイルに入っているシェーダー数
+		UINT	cacheHitCount = 0;		// まとめたファイルから取り出した数
+		UINT	fileLoadCount = 0;		// .cso から読み直した数
+		UINT	shaderCreateCount = 0;	// 作ったシェーダーオブジェクトの数
+		UINT	shaderShareCount = 0;	// 作ったものを使い回した数
+		size_t	bytecodeBytes = 0;
+	};
+	Statistics GetStatistics() const;
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+private:
+	// 1シェーダー分
+	struct Entry
+	{
+		std::vector<uint8_t>						bytecode;
+		uint64_t									sourceSize = 0;		// 読み込んだ時の .cso の大きさ
+		uint64_t									sourceTime = 0;		// 読み込んだ時の .cso の更新日時
+		bool										validated = false;	// この実行で .cso と照合したか
+		Microsoft::WRL::ComPtr<ID3D11VertexShader>	vertexShader;
+		Microsoft::WRL::ComPtr<ID3D11PixelShader>	pixelShader;
+		Microsoft::WRL::ComPtr<ID3D11ComputeShader>	computeShader;
+	};
+
+	// .cso と照合した項目を取得(古ければ読み直す、見つからなければ nullptr)
+	Entry* FindEntry(const char* filename);
+
+	// まとめたファイルの読み込みと書き込み
+	bool Load();
+	bool Save() const;
+
+private:
+	std::string						filename;
+	std::map<std::string, Entry>	entries;
+	bool							dirty = false;
+	mutable std::mutex				mutex;
+	Statistics						statistics;
+};
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cmath>
+#include "System/ShadowCascades.h"
+
+// カメラとライトからカスケードを求める
+void ShadowCascades::Update(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection,
+	const DirectX::XMFLOAT3& lightDirection, const Settings& settings)
+{
+	cascadeCount = (std::min)(settings.cascadeCount, MaxCascadeCount);
+	if (settings.resolution < 4) cascadeCount = 0;
+	if (cascadeCount == 0) return;
+
+	// 透視投影の行列から近クリップと遠クリップの距離を求める
+	const DirectX::XMFLOAT4X4& p = projection;
+	const float nearZ = -p._43 / p._33;
+	const float farZ = p._43 / (1.0f - p._33);
+	const float shadowFarZ = settings.maxDistance > nearZ ? (std::min)(farZ, settings.maxDistance) : farZ;
+
+	float splits[MaxCascadeCount + 1];
+	ComputeSplits(nearZ, shadowFarZ, cascadeCount, settings.splitLambda, splits);
+
+	// ライトの向きを z 軸とし、原点に置いたビュー行列(カスケードの位置は正射影の範囲で表す)
+	// 向きが変わらなければ行列も変わらないので、テクセルの格子がカメラの移動でずれない
+	DirectX::XMVECTOR LightDirection = DirectX::XMLoadFloat3(&lightDirection);
+	if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(LightDirection)) < 1e-8f)
+	{
+		LightDirection = DirectX::XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f);
+	}
+	LightDirection = DirectX::XMVector3Normalize(LightDirection);
+	const DirectX::XMVECTOR Up = std::fabs(DirectX::XMVectorGetY(LightDirection)) > 0.99f ?
+		DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+	const DirectX::XMMATRIX LightView = DirectX::XMMatrixLookToLH(DirectX::XMVectorZero(), LightDirection, Up);
+
+	const DirectX::XMMATRIX InverseView = DirectX::XMMatrixInverse(nullptr, DirectX::XMLoadFloat4x4(&view));
+	const float resolution = static_cast<float>(settings.resolution);
+
+	for (uint32_t i = 0; i < cascadeCount; ++i)
+	{
+		// 分割した視錐台の8頂点(ビュー空間)
+		DirectX::XMVECTOR Corners[8];
+		DirectX::XMVECTOR Center = DirectX::XMVectorZero();
+		for (int c = 0; c < 8; ++c)
+		{
+			const float depth = (c & 4) ? splits[i + 1] : splits[i];
+			const float ndcX = (c & 1) ? 1.0f : -1.0f;
+			const float ndcY = (c & 2) ? 1.0f : -1.0f;
+			Corners[c] = DirectX::XMVectorSet((ndcX - p._31) * depth / p._11, (ndcY - p._32) * depth / p._22, depth, 1.0f);
+			Center = DirectX::XMVectorAdd(Center, Corners[c]);
+		}
+		Center = DirectX::XMVectorScale(Center, 1.0f / 8.0f);
+
+		// 頂点を囲む球(ビュー空間で求めるのでカメラが回転しても半径は変わらない)
+		// 計算誤差で大きさが揺れないように 1/16m 単位に切り上げる
+		float radius = 0.0f;
+		for (const DirectX::XMVECTOR& Corner : Corners)
+		{
+			radius = (std::max)(radius, DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(Corner, Center))));
+		}
+		radius = std::ceil(radius * 16.0f) / 16.0f;
+
+		// 片側1テクセルの余白を取り、位置をテクセル単位にそろえても球が範囲からはみ出さないようにする
+		const float halfSize = radius * resolution / (resolution - 2.0f);
+		const float texelSize = 2.0f * halfSize / resolution;
+
+		DirectX::XMFLOAT3 lightCenter;
+		DirectX::XMStoreFloat3(&lightCenter, DirectX::XMVector3TransformCoord(
+			DirectX::XMVector3TransformCoord(Center, InverseView), LightView));
+		lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+		lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+
+		// ライト側は球の外にあるキャスターも入るように広げる
+		const float nearPlane = lightCenter.z - radius - settings.casterDistance;
+		const float farPlane = lightCenter.z + radius;
+		const DirectX::XMMATRIX Projection = DirectX::XMMatrixOrthographicOffCenterLH(
+			lightCenter.x - halfSize, lightCenter.x + halfSize,
+			lightCenter.y - halfSize, lightCenter.y + halfSize,
+			nearPlane, farPlane);
+
+		Cascade& cascade = cascades[i];
+		DirectX::XMStoreFloat4x4(&cascade.viewProjection, LightView * Projection);
+		cascade.splitNear = splits[i];
+		cascade.splitFar = splits[i + 1];
+		cascade.texelSize = texelSize;
+		cascade.depthRange = farPlane - nearPlane;
+
+		// 正射影なので距離と画面サイズは使わない
+		casterCullers[i].SetViewProjection(cascade.viewProjection, { 0.0f, 0.0f, 0.0f }, 0.0f, 1.0f);
+	}
+}
+
+// キャスターの判定対象をクリア
+void ShadowCascades::ClearCasters()
+{
+	for (FrustumCuller& culler : casterCullers)
+	{
+		culler.Clear();
+	}
+}
+
+// キャスターの境界ボックス追加
+size_t ShadowCascades::AddCaster(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents)
+{
+	// 使わないカスケードにも追加して、カスケード数によらず番号をそろえる
+	size_t index = 0;
+	for (FrustumCuller& culler : casterCullers)
+	{
+		index = culler.AddBox(center, extents);
+	}
+	return index;
+}
+
+// 追加したキャスターをまとめてカスケードごとに判定
+void ShadowCascades::CullCasters()
+{
+	for (uint32_t i = 0; i < cascadeCount; ++i)
+	{
+		casterCullers[i].Cull();
+	}
+}
+
+// キャスターが影を落とすカスケード
+uint32_t ShadowCascades::GetCasterMask(size_t index) const
+{
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < cascadeCount; ++i)
+	{
+		if (casterCullers[i].GetResult(index) == CullResult::Visible) mask |= 1u << i;
+	}
+	return mask;
+}
+
+// 視錐台の近クリップから遠クリップまでを count 個に分ける
+void ShadowCascades::ComputeSplits(float nearZ, float farZ, uint32_t count, float lambda, float* splits)
+{
+	// 手前ほど細かくなる対数分割と、遠くが粗くなりすぎない均等分割を混ぜる
+	splits[0] = nearZ;
+	for (uint32_t i = 1; i < count; ++i)
+	{
+		const float t = static_cast<float>(i) / count;
+		const float logSplit = nearZ * std::pow(farZ / nearZ, t);
+		const float uniformSplit = nearZ + (farZ - nearZ) * t;
+		splits[i] = lambda * logSplit + (1.0f - lambda) * uniformSplit;
+	}
+	splits[count] = farZ;
+}
+
+// 合成したカメラで確認する
+bool ShadowCascades::RunSelfTest()
+{
+	Settings settings;
+	settings.cascadeCount = 4;
+	settings.resolution = 1024;
+	settings.maxDistance = 100.0f;
+
+	const DirectX::XMFLOAT3 lightDirection = { 0.3f, -1.0f, 0.2f };
+	const DirectX::XMVECTOR Focus = DirectX::XMVectorSet(0.0f, 1.0f, 10.0f, 1.0f);
+	const DirectX::XMVECTOR Up = DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+
+	DirectX::XMFLOAT4X4 projection;
+	DirectX::XMStoreFloat4x4(&projection, DirectX::XMMatrixPerspectiveFovLH(DirectX::XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f));
+
+	// 視点の位置と向きを少しずつ変えた2つのカメラ
+	auto makeView = [&](float offsetX, float offsetZ, float yaw)
+		{
+			const DirectX::XMVECTOR Eye = DirectX::XMVectorSet(offsetX, 2.0f, offsetZ, 1.0f);
+			const DirectX::XMVECTOR Direction = DirectX::XMVector3Transform(
+				DirectX::XMVectorSubtract(Focus, DirectX::XMVectorSet(0.0f, 2.0f, 0.0f, 1.0f)), DirectX::XMMatrixRotationY(yaw));
+			DirectX::XMFLOAT4X4 view;
+			DirectX::XMStoreFloat4x4(&view, DirectX::XMMatrixLookToLH(Eye, Direction, Up));
+			return view;
+		};
+	const DirectX::XMFLOAT4X4 view0 = makeView(0.0f, 0.0f, 0.0f);
+	const DirectX::XMFLOAT4X4 view1 = makeView(0.013f, 0.007f, DirectX::XMConvertToRadians(5.0f));
+
+	ShadowCascades cascades0, cascades1;
+	cascades0.Update(view0, projection, lightDirection, settings);
+	cascades1.Update(view1, projection, lightDirection, settings);
+	if (cascades0.GetCascadeCount() != settings.cascadeCount) return false;
+
+	// 分割は近クリップから描画距離まで単調に増える
+	if (std::fabs(cascades0.GetCascade(0).splitNear - 0.1f) > 1e-4f) return false;
+	if (std::fabs(cascades0.GetCascade(settings.cascadeCount - 1).splitFar - settings.maxDistance) > 1e-3f) return false;
+	for (uint32_t i = 0; i < settings.cascadeCount; ++i)
+	{
+		const Cascade& cascade = cascades0.GetCascade(i);
+		if (!(cascade.splitFar > cascade.splitNear)) return false;
+		if (i > 0 && cascade.splitNear != cascades0.GetCascade(i - 1).splitFar) return false;
+	}
+
+	const DirectX::XMMATRIX InverseView = DirectX::XMMatrixInverse(nullptr, DirectX::XMLoadFloat4x4(&view0));
+	const DirectX::XMFLOAT4X4& p = projection;
+	for (uint32_t i = 0; i < settings.cascadeCount; ++i)
+	{
+		const Cascade& cascade0 = cascades0.GetCascade(i);
+		const Cascade& cascade1 = cascades1.GetCascade(i);
+		const DirectX::XMMATRIX ViewProjection = DirectX::XMLoadFloat4x4(&cascade0.viewProjection);
+
+		// 分割した視錐台の頂点は全てシャドウマップの範囲に入る
+		for (int c = 0; c < 8; ++c)
+		{
+			const float depth = (c & 4) ? cascade0.splitFar : cascade0.splitNear;
+			const float ndcX = (c & 1) ? 1.0f : -1.0f;
+			const float ndcY = (c & 2) ? 1.0f : -1.0f;
+			const DirectX::XMVECTOR Corner = DirectX::XMVector3TransformCoord(
+				DirectX::XMVectorSet((ndcX - p._31) * depth / p._11, (ndcY - p._32) * depth / p._22, depth, 1.0f), InverseView);
+
+			DirectX::XMFLOAT3 clip;
+			DirectX::XMStoreFloat3(&clip, DirectX::XMVector3TransformCoord(Corner, ViewProjection));
+			if (std::fabs(clip.x) > 1.0f || std::fabs(clip.y) > 1.0f || clip.z < 0.0f || clip.z > 1.0f) return false;
+		}
+
+		// 回転しても大きさは変わらず、移動はテクセル単位になる(影の輪郭がちらつかない)
+		if (cascade0.texelSize != cascade1.texelSize) return false;
+		const float texelShiftX = (cascade1.viewProjection._41 - cascade0.viewProjection._41) * settings.resolution * 0.5f;
+		const float texelShiftY = (cascade1.viewProjection._42 - cascade0.viewProjection._42) * settings.resolution * 0.5f;
+		if (std::fabs(texelShiftX - std::round(texelShiftX)) > 1e-2f) return false;
+		if (std::fabs(texelShiftY - std::round(texelShiftY)) > 1e-2f) return false;
+	}
+
+	// 最初のカスケードの真上(ライト側)にある物は影を落とし、遠く離れた物は落とさない
+	const DirectX::XMFLOAT3 nearCenter = { 0.0f, 2.0f, 1.0f };
+	const DirectX::XMVECTOR Light = DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&lightDirection));
+	DirectX::XMFLOAT3 above, distant;
+	DirectX::XMStoreFloat3(&above, DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&nearCenter), DirectX::XMVectorScale(Light, 30.0f)));
+	distant = { 1000.0f, 0.0f, -1000.0f };
+
+	cascades0.ClearCasters();
+	const size_t aboveIndex = cascades0.AddCaster(above, { 0.5f, 0.5f, 0.5f });
+	const size_t distantIndex = cascades0.AddCaster(distant, { 0.5f, 0.5f, 0.5f });
+	cascades0.CullCasters();
+	if ((cascades0.GetCasterMask(aboveIndex) & 1u) == 0) return false;
+	if (cascades0.GetCasterMask(distantIndex) != 0) return false;
+
+	return true;
+}
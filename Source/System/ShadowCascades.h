@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+#include "FrustumCuller.h"
+
+// 平行光源のカスケードシャドウマップの分割と投影
+// カメラの視錐台を深度方向に分割し、それぞれを囲むライト空間の正射影を求める
+// 影を落とすもの(キャスター)はカスケードごとにメインの描画と同じ視錐台カリングで判定する
+class ShadowCascades
+{
+public:
+	static const uint32_t MaxCascadeCount = 4;
+
+	// 画質と負荷の調整値
+	struct Settings
+	{
+		uint32_t	cascadeCount = 3;			// 0 で影なし
+		uint32_t	resolution = 2048;			// 1カスケードあたりの解像度
+		float		maxDistance = 80.0f;		// 影を描画する距離(カメラの遠クリップより遠ければ遠クリップまで)
+		float		splitLambda = 0.75f;		// 分割位置の対数分割と均等分割の混ぜ具合(1 で対数分割)
+		float		casterDistance = 100.0f;	// カスケードよりライト側に何 m までのキャスターを含めるか
+	};
+
+	// 1カスケード分
+	struct Cascade
+	{
+		DirectX::XMFLOAT4X4	viewProjection;		// ワールド座標からシャドウマップのクリップ座標へ
+		float				splitNear;			// カメラのビュー空間での深度の範囲
+		float				splitFar;
+		float				texelSize;			// 1テクセルのワールド空間での大きさ
+		float				depthRange;			// 正射影の奥行き
+	};
+
+	// カメラのビュー行列とプロジェクション行列(左手系の透視投影)、ライトの向きからカスケードを求める
+	void Update(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection,
+		const DirectX::XMFLOAT3& lightDirection, const Settings& settings);
+
+	// カスケード数取得
+	uint32_t GetCascadeCount() const { return cascadeCount; }
+
+	// カスケード取得
+	const Cascade& GetCascade(uint32_t index) const { return cascades[index]; }
+
+	// キャスターの判定対象をクリア
+	void ClearCasters();
+
+	// キャスターの境界ボックス追加(戻り値は結果を取得する際の番号)
+	size_t AddCaster(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents);
+
+	// 追加したキャスターをまとめてカスケードごとに判定
+	void CullCasters();
+
+	// キャスターが影を落とすカスケード(ビット i がカスケード i)
+	uint32_t GetCasterMask(size_t index) const;
+
+	// 視錐台の近クリップから遠クリップまでを count 個に分ける(splits には count + 1 個の深度が入る)
+	static void ComputeSplits(float nearZ, float farZ, uint32_t count, float lambda, float* splits);
+
+	// 分割、投影の範囲、テクセル単位の位置合わせ、キャスターの判定を合成したカメラで確認する
+	static bool RunSelfTest();
+
+private:
+	Cascade			cascades[MaxCascadeCount] = {};
+	uint32_t		cascadeCount = 0;
+
+	// カスケードごとのキャスターの判定(ボックスは全てのカスケードに同じ順で追加する)
+	FrustumCuller	casterCullers[MaxCascadeCount];
+};
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include "Misc.h"
+#include "GpuResourceUtils.h"
+#include "System/ShadowMap.h"
+
+// 受け側を法線方向にずらす量(テクセル単位)
+static const float NormalOffset = 1.5f;
+
+// コンストラクタ
+ShadowMap::ShadowMap(ID3D11Device* device)
+	: device(device)
+{
+	// 深度だけを書き込む頂点シェーダー(頂点形式ごと)
+	const char* vertexShaderFilenames[] =
+	{
+		"Data/Shader/ShadowCasterVS.cso",
+		"Data/Shader/ShadowCasterSkinnedVS.cso",
+	};
+	static_assert(_countof(vertexShaderFilenames) == static_cast<int>(Model::VertexFormat::Count));
+	for (int i = 0; i < static_cast<int>(Model::VertexFormat::Count); ++i)
+	{
+		const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElementDescs =
+			Model::GetInputElementDescs(static_cast<Model::VertexFormat>(i));
+		GpuResourceUtils::LoadVertexShader(
+			device,
+			vertexShaderFilenames[i],
+			inputElementDescs.data(),
+			static_cast<UINT>(inputElementDescs.size()),
+			inputLayouts[i].GetAddressOf(),
+			vertexShaders[i].GetAddressOf());
+	}
+
+	// 定数バッファ
+	GpuResourceUtils::CreateConstantBuffer(device, sizeof(CbShadow), constantBuffer.GetAddressOf());
+	GpuResourceUtils::CreateConstantBuffer(device, sizeof(CbShadowCaster), casterConstantBuffer.GetAddressOf());
+
+	// 比較サンプラ(範囲外は影なしにする)
+	{
+		D3D11_SAMPLER_DESC desc{};
+		desc.Filter = D3D11_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT;
+		desc.AddressU = D3D11_TEXTURE_ADDRESS_BORDER;
+		desc.AddressV = D3D11_TEXTURE_ADDRESS_BORDER;
+		desc.AddressW = D3D11_TEXTURE_ADDRESS_BORDER;
+		desc.ComparisonFunc = D3D11_COMPARISON_LESS_EQUAL;
+		desc.BorderColor[0] = 1.0f;
+		desc.BorderColor[1] = 1.0f;
+		desc.BorderColor[2] = 1.0f;
+		desc.BorderColor[3] = 1.0f;
+		desc.MinLOD = 0.0f;
+		desc.MaxLOD = D3D11_FLOAT32_MAX;
+		HRESULT hr = device->CreateSamplerState(&desc, comparisonSamplerState.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+
+	// キャスター用のラスタライザステート
+	// 傾きに応じたバイアスで自分自身への影を防ぎ、カスケードよりライト側のキャスターは深度をクリップせず手前に張り付ける
+	{
+		D3D11_RASTERIZER_DESC desc{};
+		desc.FillMode = D3D11_FILL_SOLID;
+		desc.CullMode = D3D11_CULL_BACK;
+		desc.FrontCounterClockwise = FALSE;
+		desc.DepthBias = 0;
+		desc.DepthBiasClamp = 0.0f;
+		desc.SlopeScaledDepthBias = 2.0f;
+		desc.DepthClipEnable = FALSE;
+		desc.ScissorEnable = FALSE;
+		desc.MultisampleEnable = FALSE;
+		desc.AntialiasedLineEnable = FALSE;
+		HRESULT hr = device->CreateRasterizerState(&desc, rasterizerState.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+}
+
+// 解像度とカスケード数に合わせてテクスチャを作り直す
+void ShadowMap::Resize(UINT resolution, UINT cascadeCount)
+{
+	if (resolution == this->resolution && cascadeCount == this->cascadeCount) return;
+
+	texture.Reset();
+	shaderResourceView.Reset();
+	depthStencilViews.clear();
+	this->resolution = resolution;
+	this->cascadeCount = cascadeCount;
+	if (resolution == 0 || cascadeCount == 0) return;
+
+	// 深度として書き込み、float としてサンプリングする
+	D3D11_TEXTURE2D_DESC textureDesc{};
+	textureDesc.Width = resolution;
+	textureDesc.Height = resolution;
+	textureDesc.MipLevels = 1;
+	textureDesc.ArraySize = cascadeCount;
+	textureDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+	textureDesc.SampleDesc.Count = 1;
+	textureDesc.SampleDesc.Quality = 0;
+	textureDesc.Usage = D3D11_USAGE_DEFAULT;
+	textureDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE;
+	HRESULT hr = device->CreateTexture2D(&textureDesc, nullptr, texture.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
+	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+	srvDesc.Texture2DArray.MostDetailedMip = 0;
+	srvDesc.Texture2DArray.MipLevels = 1;
+	srvDesc.Texture2DArray.FirstArraySlice = 0;
+	srvDesc.Texture2DArray.ArraySize = cascadeCount;
+	hr = device->CreateShaderResourceView(texture.Get(), &srvDesc, shaderResourceView.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	depthStencilViews.resize(cascadeCount);
+	for (UINT i = 0; i < cascadeCount; ++i)
+	{
+		D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc{};
+		dsvDesc.Format = DXGI_FORMAT_D32_FLOAT;
+		dsvDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+		dsvDesc.Texture2DArray.MipSlice = 0;
+		dsvDesc.Texture2DArray.FirstArraySlice = i;
+		dsvDesc.Texture2DArray.ArraySize = 1;
+		hr = device->CreateDepthStencilView(texture.Get(), &dsvDesc, depthStencilViews[i].GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+}
+
+// 描画開始
+void ShadowMap::Begin(ID3D11DeviceContext* dc)
+{
+	// 前のフレームのシャドウマップを読む設定が残っていると書き込み先にできない
+	Unbind(dc);
+
+	dc->OMGetRenderTargets(1, savedRenderTargetView.ReleaseAndGetAddressOf(), savedDepthStencilView.ReleaseAndGetAddressOf());
+	dc->RSGetState(savedRasterizerState.ReleaseAndGetAddressOf());
+	savedViewportCount = 1;
+	dc->RSGetViewports(&savedViewportCount, &savedViewport);
+
+	// 深度だけを書き込む
+	dc->PSSetShader(nullptr, nullptr, 0);
+	dc->RSSetState(rasterizerState.Get());
+	dc->VSSetConstantBuffers(0, 1, casterConstantBuffer.GetAddressOf());
+
+	D3D11_VIEWPORT viewport{};
+	viewport.Width = static_cast<float>(resolution);
+	viewport.Height = static_cast<float>(resolution);
+	viewport.MinDepth = 0.0f;
+	viewport.MaxDepth = 1.0f;
+	dc->RSSetViewports(1, &viewport);
+}
+
+// カスケードの描画開始
+void ShadowMap::BeginCascade(ID3D11DeviceContext* dc, UINT cascade, const DirectX::XMFLOAT4X4& viewProjection)
+{
+	ID3D11DepthStencilView* dsv = depthStencilViews[cascade].Get();
+	dc->OMSetRenderTargets(0, nullptr, dsv);
+	dc->ClearDepthStencilView(dsv, D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+	CbShadowCaster cbShadowCaster{};
+	cbShadowCaster.viewProjection = viewProjection;
+	dc->UpdateSubresource(casterConstantBuffer.Get(), 0, nullptr, &cbShadowCaster, 0, 0);
+}
+
+// 描画終了
+void ShadowMap::End(ID3D11DeviceContext* dc)
+{
+	ID3D11RenderTargetView* rtv = savedRenderTargetView.Get();
+	dc->OMSetRenderTargets(rtv ? 1 : 0, rtv ? &rtv : nullptr, savedDepthStencilView.Get());
+	dc->RSSetState(savedRasterizerState.Get());
+	if (savedViewportCount > 0) dc->RSSetViewports(savedViewportCount, &savedViewport);
+
+	ID3D11Buffer* cbs[] = { nullptr };
+	dc->VSSetConstantBuffers(0, _countof(cbs), cbs);
+
+	savedRenderTargetView.Reset();
+	savedDepthStencilView.Reset();
+	savedRasterizerState.Reset();
+}
+
+// 描画したシャドウマップとカスケードの定数を設定
+void ShadowMap::Bind(ID3D11DeviceContext* dc, const ShadowCascades& cascades)
+{
+	// テクスチャが作られていないカスケードは影なしとして扱う
+	const UINT count = shaderResourceView ? (std::min)(cascades.GetCascadeCount(), cascadeCount) : 0;
+
+	CbShadow cbShadow{};
+	float splitFar[ShadowCascades::MaxCascadeCount] = {};
+	float texelSize[ShadowCascades::MaxCascadeCount] = {};
+	for (UINT i = 0; i < count; ++i)
+	{
+		const ShadowCascades::Cascade& cascade = cascades.GetCascade(i);
+		cbShadow.viewProjection[i] = cascade.viewProjection;
+		splitFar[i] = cascade.splitFar;
+		texelSize[i] = cascade.texelSize;
+	}
+	cbShadow.splitFar = { splitFar[0], splitFar[1], splitFar[2], splitFar[3] };
+	cbShadow.texelSize = { texelSize[0], texelSize[1], texelSize[2], texelSize[3] };
+	cbShadow.cascadeCount = count;
+	cbShadow.normalOffset = NormalOffset;
+	dc->UpdateSubresource(constantBuffer.Get(), 0, nullptr, &cbShadow, 0, 0);
+
+	dc->PSSetConstantBuffers(ConstantBufferSlot, 1, constantBuffer.GetAddressOf());
+	dc->PSSetSamplers(SamplerSlot, 1, comparisonSamplerState.GetAddressOf());
+	if (count > 0)
+	{
+		dc->PSSetShaderResources(TextureSlot, 1, shaderResourceView.GetAddressOf());
+	}
+}
+
+// 設定解除
+void ShadowMap::Unbind(ID3D11DeviceContext* dc) const
+{
+	ID3D11Buffer* cbs[] = { nullptr };
+	dc->PSSetConstantBuffers(ConstantBufferSlot, _countof(cbs), cbs);
+
+	ID3D11SamplerState* samplers[] = { nullptr };
+	dc->PSSetSamplers(SamplerSlot, _countof(samplers), samplers);
+
+	ID3D11ShaderResourceView* srvs[] = { nullptr };
+	dc->PSSetShaderResources(TextureSlot, _countof(srvs), srvs);
+}
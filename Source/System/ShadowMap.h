@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <wrl.h>
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include "Model.h"
+#include "ShadowCascades.h"
+
+// 平行光源のカスケードシャドウマップ
+// カスケードごとの深度を Texture2DArray の1枚ずつに描画し、ピクセルシェーダーで比較サンプリングする
+class ShadowMap
+{
+public:
+	static const UINT ConstantBufferSlot = 8;	// ピクセルシェーダーの register(b8)
+	static const UINT TextureSlot = 10;			// ピクセルシェーダーの register(t10)
+	static const UINT SamplerSlot = 3;			// ピクセルシェーダーの register(s3)
+
+	ShadowMap(ID3D11Device* device);
+
+	// 解像度とカスケード数に合わせてテクスチャを作り直す(変わっていなければ何もしない)
+	void Resize(UINT resolution, UINT cascadeCount);
+
+	// 描画開始(書き込み先とビューポートを退避し、深度だけを書き込む設定にする)
+	void Begin(ID3D11DeviceContext* dc);
+
+	// カスケードの描画開始(深度をクリアして書き込み先にする)
+	void BeginCascade(ID3D11DeviceContext* dc, UINT cascade, const DirectX::XMFLOAT4X4& viewProjection);
+
+	// 描画終了(退避した書き込み先とビューポートを戻す)
+	void End(ID3D11DeviceContext* dc);
+
+	// 頂点形式ごとのキャスター用頂点シェーダーと入力レイアウト
+	ID3D11VertexShader* GetVertexShader(Model::VertexFormat vertexFormat) const { return vertexShaders[static_cast<int>(vertexFormat)].Get(); }
+	ID3D11InputLayout* GetInputLayout(Model::VertexFormat vertexFormat) const { return inputLayouts[static_cast<int>(vertexFormat)].Get(); }
+
+	// 描画したシャドウマップとカスケードの定数を設定(cascades のカスケード数が 0 なら影なしとして定数だけ設定する)
+	void Bind(ID3D11DeviceContext* dc, const ShadowCascades& cascades);
+
+	// 設定解除
+	void Unbind(ID3D11DeviceContext* dc) const;
+
+	// テクスチャのバイト数
+	size_t GetTextureBytes() const { return static_cast<size_t>(resolution) * resolution * cascadeCount * sizeof(float); }
+
+private:
+	// Shadow.hlsli と同じ配置
+	struct CbShadow
+	{
+		DirectX::XMFLOAT4X4	viewProjection[ShadowCascades::MaxCascadeCount];
+		DirectX::XMFLOAT4	splitFar;			// カメラのビュー空間でのカスケードの終わりの深度
+		DirectX::XMFLOAT4	texelSize;			// 1テクセルのワールド空間での大きさ
+		UINT				cascadeCount;
+		float				normalOffset;		// 受け側を法線方向にずらす量(テクセル単位)
+		float				pad[2];
+	};
+	static_assert(ShadowCascades::MaxCascadeCount == 4, "splitFar and texelSize hold one float per cascade");
+
+	// キャスター用(頂点シェーダーの register(b0))
+	struct CbShadowCaster
+	{
+		DirectX::XMFLOAT4X4	viewProjection;
+	};
+
+private:
+	UINT												resolution = 0;
+	UINT												cascadeCount = 0;
+
+	ID3D11Device*										device;
+	Microsoft::WRL::ComPtr<ID3D11Texture2D>				texture;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	shaderResourceView;
+	std::vector<Microsoft::WRL::ComPtr<ID3D11DepthStencilView>>	depthStencilViews;	// カスケードごと
+
+	Microsoft::WRL::ComPtr<ID3D11VertexShader>			vertexShaders[static_cast<int>(Model::VertexFormat::Count)];
+	Microsoft::WRL::ComPtr<ID3D11InputLayout>			inputLayouts[static_cast<int>(Model::VertexFormat::Count)];
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				constantBuffer;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>				casterConstantBuffer;
+	Microsoft::WRL::ComPtr<ID3D11SamplerState>			comparisonSamplerState;
+	Microsoft::WRL::ComPtr<ID3D11RasterizerState>		rasterizerState;
+
+	// Begin() で退避した書き込み先
+	Microsoft::WRL::ComPtr<ID3D11RenderTargetView>		savedRenderTargetView;
+	Microsoft::WRL::ComPtr<ID3D11DepthStencilView>		savedDepthStencilView;
+	Microsoft::WRL::ComPtr<ID3D11RasterizerState>		savedRasterizerState;
+	D3D11_VIEWPORT										savedViewport = {};
+	UINT												savedViewportCount = 0;
+};
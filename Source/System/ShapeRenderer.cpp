@@ -1,17 +1,24 @@
 #include "Misc.h"
 #include "GpuResourceUtils.h"
+#include "Profiler.h"
 #include "ShapeRenderer.h"
 
-// RXgN^
-ShapeRenderer::ShapeRenderer(ID3D11Device* device)
+// コンストラクタ
+ShapeRenderer::ShapeRenderer(ID3D11Device* device, TransientVertexBuffer* transientVertexBuffer)
+	: transientVertexBuffer(transientVertexBuffer)
 {
-	// ̓CAEg
+	// 入力レイアウト(スロット0は形状の頂点、スロット1はインスタンスごとのワールド行列と色)
 	D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
 	{
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+		{ "WORLD",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "WORLD",    1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "WORLD",    2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "WORLD",    3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
 	};
 
-	// _VF[_[
+	// 頂点シェーダー
 	GpuResourceUtils::LoadVertexShader(
 		device,
 		"Data/Shader/ShapeRendererVS.cso",
@@ -20,44 +27,56 @@ ShapeRenderer::ShapeRenderer(ID3D11Device* device)
 		inputLayout.GetAddressOf(),
 		vertexShader.GetAddressOf());
 
-	// sNZVF[_[
+	// ピクセルシェーダー
 	GpuResourceUtils::LoadPixelShader(
 		device,
 		"Data/Shader/ShapeRendererPS.cso",
 		pixelShader.GetAddressOf());
 
-	// 萔obt@
+	// 定数バッファ
 	GpuResourceUtils::CreateConstantBuffer(
 		device,
-		sizeof(CbMesh),
+		sizeof(CbScene),
 		constantBuffer.GetAddressOf());
 
-	// bV
+	// 箱メッシュ生成
 	CreateBoxMesh(device, 1.0f, 1.0f, 1.0f);
 
-	// bV
+	// 球メッシュ生成
 	CreateSphereMesh(device, 1.0f, 32);
 
-	// bV
+	// 半球メッシュ生成
 	CreateHalfSphereMesh(device, 1.0f, 32);
 
-	// ~bV
+	// 円柱メッシュ生成
 	CreateCylinderMesh(device, 1.0f, 1.0f, 0.0f, 1.0f, 32);
 
-	// bV
+	// 骨メッシュ生成
 	CreateBoneMesh(device, 1.0f);
+
+	meshes[0] = &boxMesh;
+	meshes[1] = &sphereMesh;
+	meshes[2] = &halfSphereMesh;
+	meshes[3] = &cylinderMesh;
+	meshes[4] = &boneMesh;
+}
+
+// インスタンス追加
+ShapeRenderer::Instance& ShapeRenderer::AddInstance(Mesh& mesh, const DirectX::XMFLOAT4& color)
+{
+	Instance& instance = mesh.instances.emplace_back();
+	instance.color = color;
+	return instance;
 }
 
-// `
+// 箱描画
 void ShapeRenderer::DrawBox(
 	const DirectX::XMFLOAT3& position,
 	const DirectX::XMFLOAT3& angle,
 	const DirectX::XMFLOAT3& size,
 	const DirectX::XMFLOAT4& color)
 {
-	Instance& instance = instances.emplace_back();
-	instance.mesh = &boxMesh;
-	instance.color = color;
+	Instance& instance = AddInstance(boxMesh, color);
 
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(size.x, size.y, size.z);
 	DirectX::XMMATRIX R = DirectX::XMMatrixRotationRollPitchYaw(angle.x, angle.y, angle.z);
@@ -65,22 +84,20 @@ void ShapeRenderer::DrawBox(
 	DirectX::XMStoreFloat4x4(&instance.worldTransform, S * R * T);
 }
 
-// `
+// 球描画
 void ShapeRenderer::DrawSphere(
 	const DirectX::XMFLOAT3& position,
 	float radius,
 	const DirectX::XMFLOAT4& color)
 {
-	Instance& instance = instances.emplace_back();
-	instance.mesh = &sphereMesh;
-	instance.color = color;
+	Instance& instance = AddInstance(sphereMesh, color);
 
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(radius, radius, radius);
 	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(position.x, position.y, position.z);
 	DirectX::XMStoreFloat4x4(&instance.worldTransform, S * T);
 }
 
-// JvZ`
+// カプセル描画
 void ShapeRenderer::DrawCapsule(
 	const DirectX::XMFLOAT4X4& transform,
 	float radius,
@@ -89,7 +106,7 @@ void ShapeRenderer::DrawCapsule(
 {
 	DirectX::XMMATRIX Transform = DirectX::XMLoadFloat4x4(&transform);
 
-	//// 㔼
+	//// 上半球
 	//{
 	//	Instance& instance = instances.emplace_back();
 	//	instance.mesh = &halfSphereMesh;
@@ -99,19 +116,17 @@ void ShapeRenderer::DrawCapsule(
 	//	DirectX::XMStoreFloat4x4(&instance.worldTransform, World);
 	//	instance.color = color;
 	//}
-	// ~
+	// 円柱
 	{
-		Instance& instance = instances.emplace_back();
-		instance.mesh = &cylinderMesh;
+		Instance& instance = AddInstance(cylinderMesh, color);
 		DirectX::XMMATRIX World;
 		World.r[0] = DirectX::XMVectorScale(Transform.r[0], radius);
 		World.r[1] = DirectX::XMVectorScale(Transform.r[1], height);
 		World.r[2] = DirectX::XMVectorScale(Transform.r[2], radius);
 		World.r[3] = Transform.r[3];
 		DirectX::XMStoreFloat4x4(&instance.worldTransform, World);
-		instance.color = color;
 	}
-	//// 
+	//// 下半球
 	//{
 	//	Instance& instance = instances.emplace_back();
 	//	instance.mesh = &halfSphereMesh;
@@ -128,15 +143,13 @@ void ShapeRenderer::DrawCapsule(
 	//}
 }
 
-// `
+// 骨描画
 void ShapeRenderer::DrawBone(
 	const DirectX::XMFLOAT4X4& transform,
 	float length,
 	const DirectX::XMFLOAT4& color)
 {
-	Instance& instance = instances.emplace_back();
-	instance.mesh = &boneMesh;
-	instance.color = color;
+	Instance& instance = AddInstance(boneMesh, color);
 
 	DirectX::XMMATRIX W = DirectX::XMLoadFloat4x4(&transform);
 	W.r[0] = DirectX::XMVectorScale(DirectX::XMVector3Normalize(W.r[0]), length);
@@ -145,7 +158,7 @@ void ShapeRenderer::DrawBone(
 	DirectX::XMStoreFloat4x4(&instance.worldTransform, W);
 }
 
-// bV
+// メッシュ生成
 void ShapeRenderer::CreateMesh(ID3D11Device* device, const std::vector<DirectX::XMFLOAT3>& vertices, Mesh& mesh)
 {
 	D3D11_BUFFER_DESC desc = {};
@@ -166,7 +179,7 @@ void ShapeRenderer::CreateMesh(ID3D11Device* device, const std::vector<DirectX::
 	mesh.vertexCount = static_cast<UINT>(vertices.size());
 }
 
-// bV쐬
+// 箱メッシュ作成
 void ShapeRenderer::CreateBoxMesh(ID3D11Device* device, float width, float height, float depth)
 {
 	DirectX::XMFLOAT3 positions[8] =
@@ -184,7 +197,7 @@ void ShapeRenderer::CreateBoxMesh(ID3D11Device* device, float width, float heigh
 	};
 
 	std::vector<DirectX::XMFLOAT3> vertices;
-	vertices.resize(32);
+	vertices.reserve(24);
 
 	// top
 	vertices.emplace_back(positions[0]);
@@ -214,18 +227,18 @@ void ShapeRenderer::CreateBoxMesh(ID3D11Device* device, float width, float heigh
 	vertices.emplace_back(positions[3]);
 	vertices.emplace_back(positions[7]);
 
-	// bV
+	// メッシュ生成
 	CreateMesh(device, vertices, boxMesh);
 }
 
-// bV쐬
+// 球メッシュ作成
 void ShapeRenderer::CreateSphereMesh(ID3D11Device* device, float radius, int subdivisions)
 {
 	float step = DirectX::XM_2PI / subdivisions;
 
 	std::vector<DirectX::XMFLOAT3> vertices;
 
-	// XZ
+	// XZ平面
 	for (int i = 0; i < subdivisions; ++i)
 	{
 		for (int j = 0; j < 2; ++j)
@@ -238,7 +251,7 @@ void ShapeRenderer::CreateSphereMesh(ID3D11Device* device, float radius, int sub
 			p.z = cosf(theta) * radius;
 		}
 	}
-	// XY
+	// XY平面
 	for (int i = 0; i < subdivisions; ++i)
 	{
 		for (int j = 0; j < 2; ++j)
@@ -251,7 +264,7 @@ void ShapeRenderer::CreateSphereMesh(ID3D11Device* device, float radius, int sub
 			p.z = 0.0f;
 		}
 	}
-	// YZ
+	// YZ平面
 	for (int i = 0; i < subdivisions; ++i)
 	{
 		for (int j = 0; j < 2; ++j)
@@ -265,18 +278,18 @@ void ShapeRenderer::CreateSphereMesh(ID3D11Device* device, float radius, int sub
 		}
 	}
 
-	// bV
+	// メッシュ生成
 	CreateMesh(device, vertices, sphereMesh);
 }
 
-// bV쐬
+// 半球メッシュ作成
 void ShapeRenderer::CreateHalfSphereMesh(ID3D11Device* device, float radius, int subdivisions)
 {
 	std::vector<DirectX::XMFLOAT3> vertices;
 
 	float theta_step = DirectX::XM_2PI / subdivisions;
 
-	// XZ
+	// XZ平面
 	for (int i = 0; i < subdivisions; ++i)
 	{
 		for (int j = 0; j < 2; ++j)
@@ -290,7 +303,7 @@ void ShapeRenderer::CreateHalfSphereMesh(ID3D11Device* device, float radius, int
 			v.z = cosf(theta) * radius;
 		}
 	}
-	// XY
+	// XY平面
 	for (int i = 0; i < subdivisions / 2; ++i)
 	{
 		for (int j = 0; j < 2; ++j)
@@ -304,7 +317,7 @@ void ShapeRenderer::CreateHalfSphereMesh(ID3D11Device* device, float radius, int
 			v.z = 0.0f;
 		}
 	}
-	// YZ
+	// YZ平面
 	for (int i = 0; i < subdivisions / 2; ++i)
 	{
 		for (int j = 0; j < 2; ++j)
@@ -319,18 +332,18 @@ void ShapeRenderer::CreateHalfSphereMesh(ID3D11Device* device, float radius, int
 		}
 	}
 
-	// bV
+	// メッシュ生成
 	CreateMesh(device, vertices, halfSphereMesh);
 }
 
-// ~
+// 円柱
 void ShapeRenderer::CreateCylinderMesh(ID3D11Device* device, float radius1, float radius2, float start, float height, int subdivisions)
 {
 	std::vector<DirectX::XMFLOAT3> vertices;
 
 	float theta_step = DirectX::XM_2PI / subdivisions;
 
-	// XZ
+	// XZ平面
 	for (int i = 0; i < subdivisions; ++i)
 	{
 		for (int j = 0; j < 2; ++j)
@@ -357,14 +370,14 @@ void ShapeRenderer::CreateCylinderMesh(ID3D11Device* device, float radius1, floa
 			v.z = cosf(theta) * radius2;
 		}
 	}
-	// XY
+	// XY平面
 	{
 		vertices.emplace_back(DirectX::XMFLOAT3(0.0f, start, radius1));
 		vertices.emplace_back(DirectX::XMFLOAT3(0.0f, start + height, radius2));
 		vertices.emplace_back(DirectX::XMFLOAT3(0.0f, start, -radius1));
 		vertices.emplace_back(DirectX::XMFLOAT3(0.0f, start + height, -radius2));
 	}
-	// YZ
+	// YZ平面
 	{
 		vertices.emplace_back(DirectX::XMFLOAT3(radius1, start, 0.0f));
 		vertices.emplace_back(DirectX::XMFLOAT3(radius2, start + height, 0.0f));
@@ -372,11 +385,11 @@ void ShapeRenderer::CreateCylinderMesh(ID3D11Device* device, float radius1, floa
 		vertices.emplace_back(DirectX::XMFLOAT3(-radius2, start + height, 0.0f));
 	}
 
-	// bV
+	// メッシュ生成
 	CreateMesh(device, vertices, cylinderMesh);
 }
 
-// bV쐬
+// 骨メッシュ作成
 void ShapeRenderer::CreateBoneMesh(ID3D11Device* device, float length)
 {
 	float width = length * 0.25f;
@@ -421,52 +434,74 @@ void ShapeRenderer::CreateBoneMesh(ID3D11Device* device, float length)
 	vertices.emplace_back(positions[5]);
 	vertices.emplace_back(positions[1]);
 
-	// bV
+	// メッシュ生成
 	CreateMesh(device, vertices, boneMesh);
 }
 
-// `s
+// 描画実行
 void ShapeRenderer::Render(
 	ID3D11DeviceContext* dc,
 	const DirectX::XMFLOAT4X4& view,
 	const DirectX::XMFLOAT4X4& projection)
 {
-	// VF[_[ݒ
+	PROFILE_SCOPE("ShapeRenderer::Render");
+
+	// シェーダー設定
 	dc->VSSetShader(vertexShader.Get(), nullptr, 0);
 	dc->PSSetShader(pixelShader.Get(), nullptr, 0);
 	dc->IASetInputLayout(inputLayout.Get());
 
-	// 萔obt@ݒ
+	// 定数バッファ設定
 	dc->VSSetConstantBuffers(0, 1, constantBuffer.GetAddressOf());
 
-	// r[vWFNVs쐬
+	// ビュープロジェクション行列作成
 	DirectX::XMMATRIX V = DirectX::XMLoadFloat4x4(&view);
 	DirectX::XMMATRIX P = DirectX::XMLoadFloat4x4(&projection);
 	DirectX::XMMATRIX VP = V * P;
 
-	// v~eBuݒ
-	UINT stride = sizeof(DirectX::XMFLOAT3);
-	UINT offset = 0;
+	// 定数バッファ更新
+	CbScene cbScene;
+	DirectX::XMStoreFloat4x4(&cbScene.viewProjection, VP);
+	dc->UpdateSubresource(constantBuffer.Get(), 0, 0, &cbScene, 0, 0);
+
+	// プリミティブ設定
 	dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
 
-	for (const Instance& instance : instances)
+	const UINT maxCount = TransientVertexBuffer::GetMaxCount(sizeof(Instance));
+	UINT instanceCount = 0;
+	UINT drawCount = 0;
+	for (Mesh* mesh : meshes)
 	{
-		// _obt@ݒ
-		dc->IASetVertexBuffers(0, 1, instance.mesh->vertexBuffer.GetAddressOf(), &stride, &offset);
-
-		// [hr[vWFNVs쐬
-		DirectX::XMMATRIX W = DirectX::XMLoadFloat4x4(&instance.worldTransform);
-		DirectX::XMMATRIX WVP = W * VP;
-
-		// 萔obt@XV
-		CbMesh cbMesh;
-		DirectX::XMStoreFloat4x4(&cbMesh.worldViewProjection, WVP);
-		cbMesh.color = instance.color;
-
-		dc->UpdateSubresource(constantBuffer.Get(), 0, 0, &cbMesh, 0, 0);
-
-		// `
-		dc->Draw(instance.mesh->vertexCount, 0);
+		// 形状ごとにインスタンスをまとめて描画する(最大容量を超える分は分割する)
+		UINT totalCount = static_cast<UINT>(mesh->instances.size());
+		for (UINT start = 0; start < totalCount; )
+		{
+			UINT count = totalCount - start;
+			TransientVertexBuffer::Allocation allocation;
+			if (!transientVertexBuffer->Map(dc, sizeof(Instance), count, allocation))
+			{
+				count = maxCount;
+				transientVertexBuffer->Map(dc, sizeof(Instance), count, allocation);
+			}
+			memcpy(allocation.data, &mesh->instances[start], sizeof(Instance) * count);
+			transientVertexBuffer->Unmap(dc);
+
+			// 頂点バッファ設定
+			ID3D11Buffer* vertexBuffers[] = { mesh->vertexBuffer.Get(), allocation.buffer };
+			UINT strides[] = { sizeof(DirectX::XMFLOAT3), sizeof(Instance) };
+			UINT offsets[] = { 0, allocation.offset };
+			dc->IASetVertexBuffers(0, 2, vertexBuffers, strides, offsets);
+
+			// 描画
+			dc->DrawInstanced(mesh->vertexCount, count, 0, 0);
+
+			start += count;
+			++drawCount;
+		}
+		instanceCount += totalCount;
+		mesh->instances.clear();
 	}
-	instances.clear();
+
+	PROFILE_COUNTER("Debug shape instances", instanceCount);
+	PROFILE_COUNTER("Debug shape draws", drawCount);
 }
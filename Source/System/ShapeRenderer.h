@@ -4,81 +4,87 @@
 #include <wrl.h>
 #include <d3d11.h>
 #include <DirectXMath.h>
+#include "TransientVertexBuffer.h"
 
+// 当たり判定などのデバッグ表示用の線の形状描画
+// 同じ形状はインスタンスごとの(ワールド行列, 色)を頂点バッファに並べて1回の描画コールで描画する
 class ShapeRenderer
 {
 public:
-	ShapeRenderer(ID3D11Device* device);
+	ShapeRenderer(ID3D11Device* device, TransientVertexBuffer* transientVertexBuffer);
 	~ShapeRenderer() {}
 
-	// `
+	// 箱描画
 	void DrawBox(
 		const DirectX::XMFLOAT3& position,
 		const DirectX::XMFLOAT3& angle,
 		const DirectX::XMFLOAT3& size,
 		const DirectX::XMFLOAT4& color);
 
-	// `
+	// 球描画
 	void DrawSphere(
 		const DirectX::XMFLOAT3& position,
 		float radius,
 		const DirectX::XMFLOAT4& color);
 
-	// JvZ`
+	// カプセル描画
 	void DrawCapsule(
 		const DirectX::XMFLOAT4X4& transform,
 		float radius,
 		float height,
 		const DirectX::XMFLOAT4& color);
 
-	// `
+	// 骨描画
 	void DrawBone(
 		const DirectX::XMFLOAT4X4& transform,
 		float length,
 		const DirectX::XMFLOAT4& color);
 
-	// `s
+	// 描画実行
 	void Render(
 		ID3D11DeviceContext* dc,
 		const DirectX::XMFLOAT4X4& view,
 		const DirectX::XMFLOAT4X4& projection);
 
 private:
+	// ShapeRendererVS の入力スロット1(インスタンスごと)と同じ配置
+	struct Instance
+	{
+		DirectX::XMFLOAT4X4		worldTransform;
+		DirectX::XMFLOAT4		color;
+	};
+
 	struct Mesh
 	{
 		Microsoft::WRL::ComPtr<ID3D11Buffer>	vertexBuffer;
 		UINT									vertexCount;
+		std::vector<Instance>					instances;		// 次の Render() で描画するインスタンス
 	};
 
-	struct Instance
+	struct CbScene
 	{
-		Mesh* mesh;
-		DirectX::XMFLOAT4X4		worldTransform;
-		DirectX::XMFLOAT4		color;
+		DirectX::XMFLOAT4X4		viewProjection;
 	};
 
-	struct CbMesh
-	{
-		DirectX::XMFLOAT4X4		worldViewProjection;
-		DirectX::XMFLOAT4		color;
-	};
+	// インスタンス追加
+	Instance& AddInstance(Mesh& mesh, const DirectX::XMFLOAT4& color);
 
-	// bV
+	// メッシュ生成
 	void CreateMesh(ID3D11Device* device, const std::vector<DirectX::XMFLOAT3>& vertices, Mesh& mesh);
 
-	// bV쐬
+	// 箱メッシュ作成
 	void CreateBoxMesh(ID3D11Device* device, float width, float height, float depth);
 
-	// bV쐬
+	// 球メッシュ作成
 	void CreateSphereMesh(ID3D11Device* device, float radius, int subdivisions);
 
-	// bV쐬
+	// 半球メッシュ作成
 	void CreateHalfSphereMesh(ID3D11Device* device, float radius, int subdivisions);
 
-	// ~
+	// 円柱
 	void CreateCylinderMesh(ID3D11Device* device, float radius1, float radius2, float start, float height, int subdivisions);
 
-	// bV쐬
+	// 骨メッシュ作成
 	void CreateBoneMesh(ID3D11Device* device, float length);
 
 private:
@@ -87,7 +93,8 @@ private:
 	Mesh										halfSphereMesh;
 	Mesh										cylinderMesh;
 	Mesh										boneMesh;
-	std::vector<Instance>						instances;
+	Mesh*										meshes[5];
+	TransientVertexBuffer*						transientVertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D11VertexShader>	vertexShader;
 	Microsoft::WRL::ComPtr<ID3D11PixelShader>	pixelShader;
 	Microsoft::WRL::ComPtr<ID3D11InputLayout>	inputLayout;
@@ -1,22 +1,25 @@
 #include <fstream>
+#include <cstring>
 #include "Sprite.h"
 #include "Misc.h"
 #include "GpuResourceUtils.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
 
-// RXgN^
+// コンストラクタ
 Sprite::Sprite(ID3D11Device* device)
 	: Sprite(device, nullptr)
 {
 }
 
-// RXgN^
+// コンストラクタ
 Sprite::Sprite(ID3D11Device* device, const char* filename)
 {
 	HRESULT hr = S_OK;
 
-	// _obt@̐
+	// 頂点バッファの生成
 	{
-		// _obt@쐬邽߂̐ݒIvV
+		// 頂点バッファを作成するための設定オプション
 		D3D11_BUFFER_DESC buffer_desc = {};
 		buffer_desc.ByteWidth = sizeof(Vertex) * 4;
 		buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
@@ -24,14 +27,14 @@ Sprite::Sprite(ID3D11Device* device, const char* filename)
 		buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 		buffer_desc.MiscFlags = 0;
 		buffer_desc.StructureByteStride = 0;
-		// _obt@IuWFNg̐
+		// 頂点バッファオブジェクトの生成
 		hr = device->CreateBuffer(&buffer_desc, nullptr, vertexBuffer.GetAddressOf());
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// _VF[_[
+	// 頂点シェーダー
 	{
-		// ̓CAEg
+		// 入力レイアウト
 		D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
 		{
 			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
@@ -49,7 +52,7 @@ Sprite::Sprite(ID3D11Device* device, const char* filename)
 
 	}
 
-	// sNZVF[_[
+	// ピクセルシェーダー
 	{
 		hr = GpuResourceUtils::LoadPixelShader(
 			device,
@@ -58,20 +61,33 @@ Sprite::Sprite(ID3D11Device* device, const char* filename)
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 	}
 
-	// eNX`̐	
-	if (filename != nullptr)
+	// テクスチャの生成	
+	if (const TextureAtlas::Entry* entry = TextureAtlas::Instance().Find(filename))
 	{
-		// eNX`t@Cǂݍ
+		// アトラスに含まれる画像はページを共有し、切り抜き位置をずらして参照する
+		shaderResourceView = entry->shaderResourceView;
+
+		textureWidth = entry->width;
+		textureHeight = entry->height;
+		atlasOffset = { entry->x, entry->y };
+		pageWidth = entry->pageWidth;
+		pageHeight = entry->pageHeight;
+	}
+	else if (filename != nullptr)
+	{
+		// テクスチャファイル読み込み
 		D3D11_TEXTURE2D_DESC desc;
 		hr = GpuResourceUtils::LoadTexture(device, filename, shaderResourceView.GetAddressOf(), &desc);
 		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
 		textureWidth = static_cast<float>(desc.Width);
 		textureHeight = static_cast<float>(desc.Height);
+		pageWidth = textureWidth;
+		pageHeight = textureHeight;
 	}
 	else
 	{
-		// _~[eNX`
+		// ダミーテクスチャ生成
 		D3D11_TEXTURE2D_DESC desc;
 		hr = GpuResourceUtils::CreateDummyTexture(device, 0xFFFFFFFF, shaderResourceView.GetAddressOf(),
 			&desc);
@@ -79,104 +95,45 @@ Sprite::Sprite(ID3D11Device* device, const char* filename)
 
 		textureWidth = static_cast<float>(desc.Width);
 		textureHeight = static_cast<float>(desc.Height);
+		pageWidth = textureWidth;
+		pageHeight = textureHeight;
 	}
 }
 
-// `s
+// 描画実行
 void Sprite::Render(ID3D11DeviceContext* dc,
-	float dx, float dy,					// ʒu
-	float dz,							// s
-	float dw, float dh,					// A
-	float sx, float sy,					// 摜؂蔲ʒu
-	float sw, float sh,					// 摜؂蔲TCY
-	float angle,						// px
-	float r, float g, float b, float a	// F
+	float dx, float dy,					// 左上位置
+	float dz,							// 奥行
+	float dw, float dh,					// 幅、高さ
+	float sx, float sy,					// 画像切り抜き位置
+	float sw, float sh,					// 画像切り抜きサイズ
+	float angle,						// 角度
+	float r, float g, float b, float a	// 色
 	) const
 {
-	// _W
-	DirectX::XMFLOAT2 positions[] = {
-		DirectX::XMFLOAT2(dx,      dy),			// 
-		DirectX::XMFLOAT2(dx + dw, dy),			// E
-		DirectX::XMFLOAT2(dx,      dy + dh),	// 
-		DirectX::XMFLOAT2(dx + dw, dy + dh),	// E
-	};
-
-	// eNX`W
-	DirectX::XMFLOAT2 texcoords[] = {
-		DirectX::XMFLOAT2(sx,      sy),			// 
-		DirectX::XMFLOAT2(sx + sw, sy),			// E
-		DirectX::XMFLOAT2(sx,      sy + sh),	// 
-		DirectX::XMFLOAT2(sx + sw, sy + sh),	// E
-	};
-
-	// XvCg̒Sŉ]邽߂ɂS_̒Sʒu
-	// _(0, 0)ɂȂ悤ɈU_ړB
-	float mx = dx + dw * 0.5f;
-	float my = dy + dh * 0.5f;
-	for (auto& p : positions)
-	{
-		p.x -= mx;
-		p.y -= my;
-	}
-
-	// _]
-	float theta = DirectX::XMConvertToRadians(angle);
-	float c = cosf(theta);
-	float s = sinf(theta);
-	for (auto& p : positions)
-	{
-		DirectX::XMFLOAT2 r = p;
-		p.x = c * r.x + -s * r.y;
-		p.y = s * r.x + c * r.y;
-	}
-
-	// ]̂߂Ɉړ_̈ʒuɖ߂
-	for (auto& p : positions)
-	{
-		p.x += mx;
-		p.y += my;
-	}
-
-	// ݐݒ肳Ăr[|[gXN[TCY擾B
+	// 現在設定されているビューポートからスクリーンサイズを取得する。
 	D3D11_VIEWPORT viewport;
 	UINT numViewports = 1;
 	dc->RSGetViewports(&numViewports, &viewport);
-	float screenWidth = viewport.Width;
-	float screenHeight = viewport.Height;
 
-	// XN[WnNDCWn֕ϊB
-	for (DirectX::XMFLOAT2& p : positions)
-	{
-		p.x = 2.0f * p.x / screenWidth - 1.0f;
-		p.y = 1.0f - 2.0f * p.y / screenHeight;
-	}
+	// 頂点生成(SpriteBatch と共通)
+	Vertex vertices[4];
+	SpriteBatch::GenerateQuad(vertices,
+		dx, dy, dz, dw, dh, sx + atlasOffset.x, sy + atlasOffset.y, sw, sh, angle, r, g, b, a,
+		pageWidth, pageHeight, viewport.Width, viewport.Height);
 
-	// _obt@̓e̕ҏWJnB
+	// 頂点バッファの内容の編集を開始する。
 	D3D11_MAPPED_SUBRESOURCE mappedSubresource;
 	HRESULT hr = dc->Map(vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
 	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
 
-	// _obt@̓eҏW
-	Vertex* v = static_cast<Vertex*>(mappedSubresource.pData);
-	for (int i = 0; i < 4; ++i)
-	{
-		v[i].position.x = positions[i].x;
-		v[i].position.y = positions[i].y;
-		v[i].position.z = dz;
-
-		v[i].color.x = r;
-		v[i].color.y = g;
-		v[i].color.z = b;
-		v[i].color.w = a;
-
-		v[i].texcoord.x = texcoords[i].x / textureWidth;
-		v[i].texcoord.y = texcoords[i].y / textureHeight;
-	}
+	// 頂点バッファの内容を編集
+	memcpy(mappedSubresource.pData, vertices, sizeof(vertices));
 
-	// _obt@̓e̕ҏWIB
+	// 頂点バッファの内容の編集を終了する。
 	dc->Unmap(vertexBuffer.Get(), 0);
 
-	// GPUɕ`悷邽߂̃f[^n
+	// GPUに描画するためのデータを渡す
 	UINT stride = sizeof(Vertex);
 	UINT offset = 0;
 	dc->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
@@ -186,17 +143,17 @@ void Sprite::Render(ID3D11DeviceContext* dc,
 	dc->PSSetShader(pixelShader.Get(), nullptr, 0);
 	dc->PSSetShaderResources(0, 1, shaderResourceView.GetAddressOf());
 
-	// `
+	// 描画
 	dc->Draw(4, 0);
 }
 
-// `sieNX`؂蔲wȂj
+// 描画実行（テクスチャ切り抜き指定なし）
 void Sprite::Render(ID3D11DeviceContext* dc,
-	float dx, float dy,					// ʒu
-	float dz,							// s
-	float dw, float dh,					// A
-	float angle,						// px
-	float r, float g, float b, float a	// F
+	float dx, float dy,					// 左上位置
+	float dz,							// 奥行
+	float dw, float dh,					// 幅、高さ
+	float angle,						// 角度
+	float r, float g, float b, float a	// 色
 	) const
 {
 	Render(dc, dx, dy, dz, dw, dh, 0, 0, textureWidth, textureHeight, angle, r, g, b, a);
@@ -4,14 +4,14 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 
-// XvCg
+// スプライト
 class Sprite
 {
 public:
 	Sprite(ID3D11Device* device);
 	Sprite(ID3D11Device* device, const char* filename);
 
-	// _f[^
+	// 頂点データ
 	struct Vertex
 	{
 		DirectX::XMFLOAT3	position;
@@ -19,26 +19,44 @@ public:
 		DirectX::XMFLOAT2	texcoord;
 	};
 
-	// `s
+	// 描画実行
 	void Render(ID3D11DeviceContext* dc,
-		float dx, float dy,					// ʒu
-		float dz,							// s
-		float dw, float dh,					// A
-		float sx, float sy,					// 摜؂蔲ʒu
-		float sw, float sh,					// 摜؂蔲TCY
-		float angle,						// px
-		float r, float g, float b, float a	// F
+		float dx, float dy,					// 左上位置
+		float dz,							// 奥行
+		float dw, float dh,					// 幅、高さ
+		float sx, float sy,					// 画像切り抜き位置
+		float sw, float sh,					// 画像切り抜きサイズ
+		float angle,						// 角度
+		float r, float g, float b, float a	// 色
 	) const;
 
-	// `sieNX`؂蔲wȂj
+	// 描画実行（テクスチャ切り抜き指定なし）
 	void Render(ID3D11DeviceContext* dc,
-		float dx, float dy,					// ʒu
-		float dz,							// s
-		float dw, float dh,					// A
-		float angle,						// px
-		float r, float g, float b, float a	// F
+		float dx, float dy,					// 左上位置
+		float dz,							// 奥行
+		float dw, float dh,					// 幅、高さ
+		float angle,						// 角度
+		float r, float g, float b, float a	// 色
 	) const;
 
+	// シェーダーリソースビュー取得
+	ID3D11ShaderResourceView* GetShaderResourceView() const { return shaderResourceView.Get(); }
+
+	// テクスチャ幅取得
+	float GetTextureWidth() const { return textureWidth; }
+
+	// テクスチャ高さ取得
+	float GetTextureHeight() const { return textureHeight; }
+
+	// テクスチャアトラス内の画像位置取得(アトラス化されていなければ 0, 0)
+	const DirectX::XMFLOAT2& GetAtlasOffset() const { return atlasOffset; }
+
+	// 参照しているテクスチャ全体の幅取得(アトラス化されていればページの幅)
+	float GetPageWidth() const { return pageWidth; }
+
+	// 参照しているテクスチャ全体の高さ取得(アトラス化されていればページの高さ)
+	float GetPageHeight() const { return pageHeight; }
+
 private:
 	Microsoft::WRL::ComPtr<ID3D11VertexShader>			vertexShader;
 	Microsoft::WRL::ComPtr<ID3D11PixelShader>			pixelShader;
@@ -49,4 +67,8 @@ private:
 
 	float textureWidth = 0;
 	float textureHeight = 0;
+
+	DirectX::XMFLOAT2 atlasOffset = { 0, 0 };
+	float pageWidth = 0;
+	float pageHeight = 0;
 };
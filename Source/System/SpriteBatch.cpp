@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <imgui.h>
+#include "System/Misc.h"
+#include "System/GpuResourceUtils.h"
+#include "System/Profiler.h"
+#include "System/SpriteBatch.h"
+
+// コンストラクタ
+SpriteBatch::SpriteBatch(ID3D11Device* device)
+{
+	HRESULT hr = S_OK;
+
+	// 頂点バッファ
+	{
+		D3D11_BUFFER_DESC desc = {};
+		desc.ByteWidth = sizeof(Sprite::Vertex) * 4 * QuadCapacity;
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		hr = device->CreateBuffer(&desc, nullptr, vertexBuffer.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+
+	// インデックスバッファ(四角形ごとに 0,1,2 / 2,1,3 の三角形リスト)
+	{
+		std::vector<UINT16> indices(6 * QuadCapacity);
+		for (UINT i = 0; i < QuadCapacity; ++i)
+		{
+			UINT16 v = static_cast<UINT16>(i * 4);
+			UINT16* index = &indices[i * 6];
+			index[0] = v + 0;
+			index[1] = v + 1;
+			index[2] = v + 2;
+			index[3] = v + 2;
+			index[4] = v + 1;
+			index[5] = v + 3;
+		}
+
+		D3D11_BUFFER_DESC desc = {};
+		desc.ByteWidth = static_cast<UINT>(sizeof(UINT16) * indices.size());
+		desc.Usage = D3D11_USAGE_IMMUTABLE;
+		desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+		D3D11_SUBRESOURCE_DATA data = {};
+		data.pSysMem = indices.data();
+		hr = device->CreateBuffer(&desc, &data, indexBuffer.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+
+	// 頂点シェーダー(Sprite と共通)
+	{
+		D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
+		{
+			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		};
+		hr = GpuResourceUtils::LoadVertexShader(
+			device,
+			"Data/Shader/SpriteVS.cso",
+			inputElementDesc,
+			ARRAYSIZE(inputElementDesc),
+			inputLayout.GetAddressOf(),
+			vertexShader.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+
+	// ピクセルシェーダー
+	{
+		hr = GpuResourceUtils::LoadPixelShader(
+			device,
+			"Data/Shader/SpritePS.cso",
+			pixelShader.GetAddressOf());
+		_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+	}
+}
+
+// 描画開始
+void SpriteBatch::Begin(ID3D11DeviceContext* dc)
+{
+	if (depth++ > 0) return;
+
+	this->dc = dc;
+
+	// 現在設定されているビューポートからスクリーンサイズを取得する。
+	D3D11_VIEWPORT viewport;
+	UINT numViewports = 1;
+	dc->RSGetViewports(&numViewports, &viewport);
+	screenWidth = viewport.Width;
+	screenHeight = viewport.Height;
+}
+
+// 描画終了
+void SpriteBatch::End()
+{
+	_ASSERT_EXPR(depth > 0, L"SpriteBatch::Begin() has not been called");
+	if (--depth > 0) return;
+
+	Flush();
+	dc = nullptr;
+}
+
+// スプライト登録
+void SpriteBatch::Draw(const Sprite* sprite, int layer,
+	float dx, float dy,
+	float dz,
+	float dw, float dh,
+	float sx, float sy,
+	float sw, float sh,
+	float angle,
+	float r, float g, float b, float a)
+{
+	_ASSERT_EXPR(depth > 0, L"SpriteBatch::Begin() has not been called");
+
+	Entry& entry = entries.emplace_back();
+	entry.layer = layer;
+	entry.texture = sprite->GetShaderResourceView();
+	entry.order = static_cast<UINT>(entries.size() - 1);
+	const DirectX::XMFLOAT2& atlasOffset = sprite->GetAtlasOffset();
+	GenerateQuad(entry.vertices,
+		dx, dy, dz, dw, dh, sx + atlasOffset.x, sy + atlasOffset.y, sw, sh, angle, r, g, b, a,
+		sprite->GetPageWidth(), sprite->GetPageHeight(),
+		screenWidth, screenHeight);
+}
+
+// スプライト登録（テクスチャ切り抜き指定なし）
+void SpriteBatch::Draw(const Sprite* sprite, int layer,
+	float dx, float dy,
+	float dz,
+	float dw, float dh,
+	float angle,
+	float r, float g, float b, float a)
+{
+	Draw(sprite, layer, dx, dy, dz, dw, dh,
+		0, 0, sprite->GetTextureWidth(), sprite->GetTextureHeight(),
+		angle, r, g, b, a);
+}
+
+// フレーム開始
+void SpriteBatch::NewFrame()
+{
+	lastFrameStatistics = frameStatistics;
+	frameStatistics = {};
+}
+
+// デバッグGUI描画
+void SpriteBatch::DrawDebugGUI()
+{
+	if (ImGui::CollapsingHeader("Sprite Batch", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::Text("Sprites : %d", lastFrameStatistics.quadCount);
+		ImGui::Text("Batches : %d", lastFrameStatistics.batchCount);
+		ImGui::Text("Flushes : %d", lastFrameStatistics.flushCount);
+	}
+}
+
+// 四角形の頂点生成
+void SpriteBatch::GenerateQuad(Sprite::Vertex vertices[4],
+	float dx, float dy, float dz,
+	float dw, float dh,
+	float sx, float sy,
+	float sw, float sh,
+	float angle,
+	float r, float g, float b, float a,
+	float textureWidth, float textureHeight,
+	float screenWidth, float screenHeight)
+{
+	// 頂点座標
+	DirectX::XMFLOAT2 positions[] = {
+		DirectX::XMFLOAT2(dx,      dy),			// 左上
+		DirectX::XMFLOAT2(dx + dw, dy),			// 右上
+		DirectX::XMFLOAT2(dx,      dy + dh),	// 左下
+		DirectX::XMFLOAT2(dx + dw, dy + dh),	// 右下
+	};
+
+	// テクスチャ座標
+	DirectX::XMFLOAT2 texcoords[] = {
+		DirectX::XMFLOAT2(sx,      sy),			// 左上
+		DirectX::XMFLOAT2(sx + sw, sy),			// 右上
+		DirectX::XMFLOAT2(sx,      sy + sh),	// 左下
+		DirectX::XMFLOAT2(sx + sw, sy + sh),	// 右下
+	};
+
+	// スプライトの中心で回転させる
+	if (angle != 0.0f)
+	{
+		float mx = dx + dw * 0.5f;
+		float my = dy + dh * 0.5f;
+		float theta = DirectX::XMConvertToRadians(angle);
+		float c = cosf(theta);
+		float s = sinf(theta);
+		for (auto& p : positions)
+		{
+			float x = p.x - mx;
+			float y = p.y - my;
+			p.x = c * x + -s * y + mx;
+			p.y = s * x + c * y + my;
+		}
+	}
+
+	// スクリーン座標系からNDC座標系へ変換する。
+	for (int i = 0; i < 4; ++i)
+	{
+		Sprite::Vertex& v = vertices[i];
+		v.position.x = 2.0f * positions[i].x / screenWidth - 1.0f;
+		v.position.y = 1.0f - 2.0f * positions[i].y / screenHeight;
+		v.position.z = dz;
+
+		v.color.x = r;
+		v.color.y = g;
+		v.color.z = b;
+		v.color.w = a;
+
+		v.texcoord.x = texcoords[i].x / textureWidth;
+		v.texcoord.y = texcoords[i].y / textureHeight;
+	}
+}
+
+// 描画コールの範囲を作る
+void SpriteBatch::BuildBatches(std::vector<Entry>& entries, std::vector<Batch>& batches)
+{
+	batches.clear();
+
+	// レイヤー → テクスチャ → 登録順
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+		{
+			if (a.layer != b.layer) return a.layer < b.layer;
+			if (a.texture != b.texture) return std::less<ID3D11ShaderResourceView*>()(a.texture, b.texture);
+			return a.order < b.order;
+		});
+
+	for (UINT i = 0; i < static_cast<UINT>(entries.size()); ++i)
+	{
+		if (batches.empty() || batches.back().texture != entries[i].texture)
+		{
+			Batch& batch = batches.emplace_back();
+			batch.texture = entries[i].texture;
+			batch.start = i;
+		}
+		++batches.back().count;
+	}
+}
+
+// まとめて描画
+void SpriteBatch::Flush()
+{
+	if (entries.empty()) return;
+
+	PROFILE_SCOPE("SpriteBatch::Flush");
+
+	BuildBatches(entries, batches);
+
+	// 描画設定
+	UINT stride = sizeof(Sprite::Vertex);
+	UINT offset = 0;
+	dc->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
+	dc->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0);
+	dc->IASetInputLayout(inputLayout.Get());
+	dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	dc->VSSetShader(vertexShader.Get(), nullptr, 0);
+	dc->PSSetShader(pixelShader.Get(), nullptr, 0);
+
+	for (const Batch& batch : batches)
+	{
+		dc->PSSetShaderResources(0, 1, &batch.texture);
+
+		// 頂点バッファに収まらない分は分割して描画する
+		UINT start = batch.start;
+		UINT remain = batch.count;
+		while (remain > 0)
+		{
+			// 残り容量が足りなければ先頭から書き直す
+			if (writeQuad >= QuadCapacity)
+			{
+				writeQuad = 0;
+			}
+			UINT count = (std::min)(remain, QuadCapacity - writeQuad);
+
+			// 使用済みの領域には触れないので書き込み中でもGPUを待たない
+			D3D11_MAP mapType = writeQuad == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+			D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+			HRESULT hr = dc->Map(vertexBuffer.Get(), 0, mapType, 0, &mappedSubresource);
+			_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+			Sprite::Vertex* v = static_cast<Sprite::Vertex*>(mappedSubresource.pData) + writeQuad * 4;
+			for (UINT i = 0; i < count; ++i)
+			{
+				memcpy(v + i * 4, entries[start + i].vertices, sizeof(Sprite::Vertex) * 4);
+			}
+			dc->Unmap(vertexBuffer.Get(), 0);
+
+			dc->DrawIndexed(count * 6, 0, writeQuad * 4);
+
+			writeQuad += count;
+			start += count;
+			remain -= count;
+			++frameStatistics.batchCount;
+		}
+	}
+
+	frameStatistics.quadCount += static_cast<int>(entries.size());
+	++frameStatistics.flushCount;
+
+	entries.clear();
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <vector>
+#include <wrl.h>
+#include <d3d11.h>
+#include "System/Sprite.h"
+
+// スプライトバッチ
+// Begin() から End() までに登録したスプライトを1つの動的頂点バッファにまとめ、
+// レイヤー、テクスチャの順に並べ替えてできるだけ少ない描画コールで描画する
+// 同じレイヤー内ではテクスチャが異なるスプライト同士の前後関係は保証しない
+// (同じテクスチャ同士は登録順を保つ)ので、重なり順が必要な場合はレイヤーを分けること
+class SpriteBatch
+{
+public:
+	SpriteBatch(ID3D11Device* device);
+
+	// 登録されたスプライト
+	struct Entry
+	{
+		int							layer = 0;
+		ID3D11ShaderResourceView*	texture = nullptr;
+		UINT						order = 0;		// 登録順
+		Sprite::Vertex				vertices[4];
+	};
+
+	// Begin() と End() をスコープで対にする
+	class Scope
+	{
+	public:
+		Scope(SpriteBatch* batch, ID3D11DeviceContext* dc) : batch(batch) { batch->Begin(dc); }
+		~Scope() { batch->End(); }
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+		SpriteBatch* operator->() const { return batch; }
+
+	private:
+		SpriteBatch*	batch;
+	};
+
+	// 1回の描画コールで描画する範囲
+	struct Batch
+	{
+		ID3D11ShaderResourceView*	texture = nullptr;
+		UINT						start = 0;		// 並べ替え後の先頭スプライト
+		UINT						count = 0;		// スプライト数
+	};
+
+	// 描画統計
+	struct Statistics
+	{
+		int		quadCount = 0;		// 描画したスプライト数
+		int		batchCount = 0;		// 描画コール数
+		int		flushCount = 0;		// End() で描画した回数
+	};
+
+	// 描画開始(入れ子にした場合は一番外側の End() でまとめて描画する)
+	void Begin(ID3D11DeviceContext* dc);
+
+	// 描画終了
+	void End();
+
+	// 描画中か
+	bool IsBatching() const { return depth > 0; }
+
+	// スプライト登録
+	void Draw(const Sprite* sprite, int layer,
+		float dx, float dy,					// 左上位置
+		float dz,							// 奥行
+		float dw, float dh,					// 幅、高さ
+		float sx, float sy,					// 画像切り抜き位置
+		float sw, float sh,					// 画像切り抜きサイズ
+		float angle,						// 角度
+		float r, float g, float b, float a	// 色
+	);
+
+	// スプライト登録（テクスチャ切り抜き指定なし）
+	void Draw(const Sprite* sprite, int layer,
+		float dx, float dy,					// 左上位置
+		float dz,							// 奥行
+		float dw, float dh,					// 幅、高さ
+		float angle,						// 角度
+		float r, float g, float b, float a	// 色
+	);
+
+	// フレーム開始(前フレームの統計を確定する)
+	void NewFrame();
+
+	// 前フレームの統計取得
+	const Statistics& GetStatistics() const { return lastFrameStatistics; }
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+	// 四角形の頂点生成(頂点順は左上、右上、左下、右下)
+	// GPUを使わないので単体でテストできる
+	static void GenerateQuad(Sprite::Vertex vertices[4],
+		float dx, float dy, float dz,
+		float dw, float dh,
+		float sx, float sy,
+		float sw, float sh,
+		float angle,
+		float r, float g, float b, float a,
+		float textureWidth, float textureHeight,
+		float screenWidth, float screenHeight);
+
+	// レイヤー、テクスチャ、登録順で並べ替えて描画コールの範囲を作る
+	// GPUを使わないので単体でテストできる
+	static void BuildBatches(std::vector<Entry>& entries, std::vector<Batch>& batches);
+
+private:
+	// まとめて描画
+	void Flush();
+
+private:
+	static const UINT QuadCapacity = 4096;
+
+	Microsoft::WRL::ComPtr<ID3D11VertexShader>	vertexShader;
+	Microsoft::WRL::ComPtr<ID3D11PixelShader>	pixelShader;
+	Microsoft::WRL::ComPtr<ID3D11InputLayout>	inputLayout;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>		vertexBuffer;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>		indexBuffer;
+
+	ID3D11DeviceContext*	dc = nullptr;
+	int						depth = 0;
+	float					screenWidth = 0;
+	float					screenHeight = 0;
+	UINT					writeQuad = 0;		// 頂点バッファの書き込み位置(スプライト単位)
+
+	std::vector<Entry>		entries;
+	std::vector<Batch>		batches;
+
+	Statistics				frameStatistics;
+	Statistics				lastFrameStatistics;
+};
@@ -0,0 +1,448 @@
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <numeric>
+#include <imgui.h>
+#include <DirectXTex.h>
+#include "System/Misc.h"
+#include "System/GpuResourceUtils.h"
+#include "System/TextureAtlas.h"
+#include "JsonUtils.h"
+
+// コンストラクタ
+SkylinePacker::SkylinePacker(int width, int height)
+	: width(width)
+	, height(height)
+{
+	skyline.push_back({ 0, 0, width });
+}
+
+// 矩形を配置する
+bool SkylinePacker::Insert(int width, int height, int& x, int& y)
+{
+	// 置いたときの上端が最も低く、同じなら隙間の少ない位置を選ぶ
+	int bestIndex = -1;
+	int bestTop = INT_MAX;
+	int bestWidth = INT_MAX;
+	for (size_t i = 0; i < skyline.size(); ++i)
+	{
+		int fitY = Fit(i, width, height);
+		if (fitY < 0) continue;
+
+		int top = fitY + height;
+		if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth))
+		{
+			bestIndex = static_cast<int>(i);
+			bestTop = top;
+			bestWidth = skyline[i].width;
+			x = skyline[i].x;
+			y = fitY;
+		}
+	}
+	if (bestIndex < 0) return false;
+
+	// 新しいノードを差し込み、覆い隠された分だけ後続のノードを削る
+	skyline.insert(skyline.begin() + bestIndex, { x, y + height, width });
+	for (size_t i = bestIndex + 1; i < skyline.size(); ++i)
+	{
+		const Node& prev = skyline[i - 1];
+		int prevRight = prev.x + prev.width;
+		if (skyline[i].x >= prevRight) break;
+
+		int shrink = prevRight - skyline[i].x;
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+		if (skyline[i].width > 0) break;
+
+		skyline.erase(skyline.begin() + i);
+		--i;
+	}
+	Merge();
+
+	usedArea += static_cast<long long>(width) * height;
+	return true;
+}
+
+// 使用率取得
+float SkylinePacker::GetOccupancy() const
+{
+	return static_cast<float>(static_cast<double>(usedArea) / (static_cast<double>(width) * height));
+}
+
+// index のノードから置いた場合の高さ
+int SkylinePacker::Fit(size_t index, int width, int height) const
+{
+	int x = skyline[index].x;
+	if (x + width > this->width) return -1;
+
+	int y = skyline[index].y;
+	int widthLeft = width;
+	for (size_t i = index; widthLeft > 0; ++i)
+	{
+		if (i >= skyline.size()) return -1;
+
+		y = (std::max)(y, skyline[i].y);
+		if (y + height > this->height) return -1;
+
+		widthLeft -= skyline[i].width;
+	}
+	return y;
+}
+
+// 同じ高さで隣り合うノードをまとめる
+void SkylinePacker::Merge()
+{
+	for (size_t i = 0; i + 1 < skyline.size(); )
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+// シリアライズ
+template<class Archive>
+void TextureAtlas::Source::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(filename),
+		CEREAL_NVP(fileSize),
+		CEREAL_NVP(writeTime)
+	);
+}
+
+template<class Archive>
+void TextureAtlas::Region::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(filename),
+		CEREAL_NVP(page),
+		CEREAL_NVP(x),
+		CEREAL_NVP(y),
+		CEREAL_NVP(width),
+		CEREAL_NVP(height)
+	);
+}
+
+template<class Archive>
+void TextureAtlas::Manifest::serialize(Archive& archive)
+{
+	archive(
+		CEREAL_NVP(pageSize),
+		CEREAL_NVP(padding),
+		CEREAL_NVP(pages),
+		CEREAL_NVP(sources),
+		CEREAL_NVP(regions)
+	);
+}
+
+// 初期化
+void TextureAtlas::Initialize(ID3D11Device* device, const char* directory, const char* manifestFilename,
+	int pageSize, int maxImageSize, int padding)
+{
+	std::vector<Source> sources = CollectSources(directory, maxImageSize);
+
+	// キャッシュが古ければ作り直す
+	Manifest manifest;
+	if (!JsonUtils::LoadJsonFile(manifest, manifestFilename) || !IsUpToDate(manifest, manifestFilename, sources, pageSize, padding))
+	{
+		if (!Build(sources, manifestFilename, pageSize, padding, manifest))
+		{
+			return;
+		}
+	}
+
+	Load(device, manifestFilename, manifest);
+}
+
+// 終了化
+void TextureAtlas::Finalize()
+{
+	entries.clear();
+	pages.clear();
+}
+
+// 登録されている画像なら配置を返す
+const TextureAtlas::Entry* TextureAtlas::Find(const char* filename) const
+{
+	if (filename == nullptr || entries.empty()) return nullptr;
+
+	auto it = entries.find(NormalizeFilename(filename));
+	return it != entries.end() ? &it->second : nullptr;
+}
+
+// デバッグGUI描画
+void TextureAtlas::DrawDebugGUI()
+{
+	if (ImGui::CollapsingHeader("Texture Atlas", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::Text("Pages : %d", static_cast<int>(pages.size()));
+		ImGui::Text("Images : %d", static_cast<int>(entries.size()));
+		ImGui::Text("Occupancy : %.1f %%", occupancy * 100.0f);
+
+		for (size_t i = 0; i < pages.size(); ++i)
+		{
+			ImGui::PushID(static_cast<int>(i));
+			if (ImGui::TreeNode("Page", "Page %d (%.0fx%.0f)", static_cast<int>(i), pages[i].width, pages[i].height))
+			{
+				ImGui::Image(pages[i].shaderResourceView.Get(), ImVec2(256, 256));
+				ImGui::TreePop();
+			}
+			ImGui::PopID();
+		}
+	}
+}
+
+// 画像を詰め込んでページ画像とマニフェストを書き出す
+bool TextureAtlas::Build(const std::vector<Source>& sources, const char* manifestFilename,
+	int pageSize, int padding, Manifest& manifest)
+{
+	HRESULT hr;
+
+	// 元画像読み込み(フォーマットは RGBA8 に揃える)
+	std::vector<DirectX::ScratchImage> images(sources.size());
+	std::vector<std::pair<int, int>> sizes(sources.size());
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		std::wstring wfilename = std::filesystem::path(sources[i].filename).wstring();
+
+		DirectX::TexMetadata metadata;
+		hr = DirectX::LoadFromWICFile(wfilename.c_str(), DirectX::WIC_FLAGS_NONE, &metadata, images[i]);
+		if (FAILED(hr)) return false;
+
+		if (metadata.format != DXGI_FORMAT_R8G8B8A8_UNORM)
+		{
+			DirectX::ScratchImage converted;
+			hr = DirectX::Convert(*images[i].GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM,
+				DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+			if (FAILED(hr)) return false;
+			images[i] = std::move(converted);
+		}
+
+		sizes[i] = { static_cast<int>(metadata.width), static_cast<int>(metadata.height) };
+	}
+
+	// 配置計算
+	std::vector<Region> regions;
+	int pageCount = Pack(sizes, pageSize, padding, regions);
+
+	// ページ画像作成
+	std::vector<DirectX::ScratchImage> pageImages(pageCount);
+	for (DirectX::ScratchImage& page : pageImages)
+	{
+		hr = page.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, pageSize, pageSize, 1, 1);
+		if (FAILED(hr)) return false;
+		memset(page.GetPixels(), 0, page.GetPixelsSize());
+	}
+
+	for (size_t i = 0; i < regions.size(); ++i)
+	{
+		Region& region = regions[i];
+		region.filename = sources[i].filename;
+		if (region.page < 0) continue;
+
+		const DirectX::Image* src = images[i].GetImage(0, 0, 0);
+		const DirectX::Image* dst = pageImages[region.page].GetImage(0, 0, 0);
+
+		// 余白には端のピクセルを引き伸ばして、バイリニア補間で隣の画像が滲まないようにする
+		for (int py = -padding; py < region.height + padding; ++py)
+		{
+			int sy = std::clamp(py, 0, region.height - 1);
+			const UINT32* srcRow = reinterpret_cast<const UINT32*>(src->pixels + sy * src->rowPitch);
+			UINT32* dstRow = reinterpret_cast<UINT32*>(dst->pixels + (region.y + py) * dst->rowPitch);
+			for (int px = -padding; px < region.width + padding; ++px)
+			{
+				int sx = std::clamp(px, 0, region.width - 1);
+				dstRow[region.x + px] = srcRow[sx];
+			}
+		}
+	}
+
+	// ページ画像書き出し(マニフェストからの相対パス)
+	std::filesystem::path manifestPath(manifestFilename);
+	std::filesystem::create_directories(manifestPath.parent_path());
+
+	manifest = {};
+	manifest.pageSize = pageSize;
+	manifest.padding = padding;
+	manifest.sources = sources;
+	manifest.regions = std::move(regions);
+	for (int i = 0; i < pageCount; ++i)
+	{
+		std::string pageFilename = manifestPath.stem().string() + "_" + std::to_string(i) + ".png";
+		std::wstring wfilename = (manifestPath.parent_path() / pageFilename).wstring();
+
+		hr = DirectX::SaveToWICFile(*pageImages[i].GetImage(0, 0, 0), DirectX::WIC_FLAGS_NONE,
+			DirectX::GetWICCodec(DirectX::WIC_CODEC_PNG), wfilename.c_str());
+		if (FAILED(hr)) return false;
+
+		manifest.pages.push_back(pageFilename);
+	}
+
+	// マニフェスト書き出し
+	JsonUtils::SaveJsonFile(manifest, manifestFilename);
+
+	return true;
+}
+
+// 詰め込み位置の計算
+int TextureAtlas::Pack(const std::vector<std::pair<int, int>>& sizes, int pageSize, int padding,
+	std::vector<Region>& regions)
+{
+	regions.assign(sizes.size(), Region());
+
+	// 高さ、幅の大きい順に詰める
+	std::vector<size_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+		{
+			if (sizes[a].second != sizes[b].second) return sizes[a].second > sizes[b].second;
+			return sizes[a].first > sizes[b].first;
+		});
+
+	std::vector<SkylinePacker> packers;
+	for (size_t index : order)
+	{
+		Region& region = regions[index];
+		region.width = sizes[index].first;
+		region.height = sizes[index].second;
+		region.page = -1;
+
+		// 余白込みでページに収まらない画像はアトラス化しない
+		int w = region.width + padding * 2;
+		int h = region.height + padding * 2;
+		if (region.width <= 0 || region.height <= 0 || w > pageSize || h > pageSize) continue;
+
+		int x = 0, y = 0;
+		for (size_t p = 0; p < packers.size() && region.page < 0; ++p)
+		{
+			if (packers[p].Insert(w, h, x, y)) region.page = static_cast<int>(p);
+		}
+		if (region.page < 0)
+		{
+			SkylinePacker& packer = packers.emplace_back(pageSize, pageSize);
+			packer.Insert(w, h, x, y);
+			region.page = static_cast<int>(packers.size() - 1);
+		}
+		region.x = x + padding;
+		region.y = y + padding;
+	}
+	return static_cast<int>(packers.size());
+}
+
+// ファイル名の正規化
+std::string TextureAtlas::NormalizeFilename(const char* filename)
+{
+	std::string normalized = std::filesystem::path(filename).lexically_normal().generic_string();
+	std::transform(normalized.begin(), normalized.end(), normalized.begin(), tolower);
+	return normalized;
+}
+
+// ディレクトリ内の元画像を列挙する
+std::vector<TextureAtlas::Source> TextureAtlas::CollectSources(const char* directory, int maxImageSize)
+{
+	std::vector<Source> sources;
+
+	std::error_code ec;
+	for (const auto& item : std::filesystem::directory_iterator(directory, ec))
+	{
+		if (!item.is_regular_file()) continue;
+
+		std::string extension = item.path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
+		if (extension != ".png") continue;
+
+		// 背景などの大きな画像はそのまま使う
+		DirectX::TexMetadata metadata;
+		HRESULT hr = DirectX::GetMetadataFromWICFile(item.path().wstring().c_str(), DirectX::WIC_FLAGS_NONE, metadata);
+		if (FAILED(hr)) continue;
+		if (metadata.width > static_cast<size_t>(maxImageSize) || metadata.height > static_cast<size_t>(maxImageSize)) continue;
+
+		Source& source = sources.emplace_back();
+		source.filename = NormalizeFilename(item.path().string().c_str());
+		source.fileSize = item.file_size();
+		source.writeTime = item.last_write_time().time_since_epoch().count();
+	}
+
+	// 列挙順に依存しないように並べる
+	std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b)
+		{
+			return a.filename < b.filename;
+		});
+	return sources;
+}
+
+// マニフェストが元画像と一致しているか
+bool TextureAtlas::IsUpToDate(const Manifest& manifest, const char* manifestFilename,
+	const std::vector<Source>& sources, int pageSize, int padding)
+{
+	if (manifest.pageSize != pageSize || manifest.padding != padding) return false;
+	if (manifest.sources.size() != sources.size()) return false;
+
+	// ページ画像が消されていないか
+	std::filesystem::path directory = std::filesystem::path(manifestFilename).parent_path();
+	for (const std::string& pageFilename : manifest.pages)
+	{
+		if (!std::filesystem::exists(directory / pageFilename)) return false;
+	}
+
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const Source& a = manifest.sources[i];
+		const Source& b = sources[i];
+		if (a.filename != b.filename || a.fileSize != b.fileSize || a.writeTime != b.writeTime) return false;
+	}
+	return true;
+}
+
+// マニフェストからページを読み込む
+bool TextureAtlas::Load(ID3D11Device* device, const char* manifestFilename, const Manifest& manifest)
+{
+	Finalize();
+
+	std::filesystem::path directory = std::filesystem::path(manifestFilename).parent_path();
+	for (const std::string& pageFilename : manifest.pages)
+	{
+		Page& page = pages.emplace_back();
+
+		D3D11_TEXTURE2D_DESC desc;
+		std::string filename = (directory / pageFilename).string();
+		HRESULT hr = GpuResourceUtils::LoadTexture(device, filename.c_str(), page.shaderResourceView.GetAddressOf(), &desc);
+		if (FAILED(hr))
+		{
+			Finalize();
+			return false;
+		}
+		page.width = static_cast<float>(desc.Width);
+		page.height = static_cast<float>(desc.Height);
+	}
+
+	long long usedArea = 0;
+	for (const Region& region : manifest.regions)
+	{
+		if (region.page < 0 || region.page >= static_cast<int>(pages.size())) continue;
+
+		const Page& page = pages[region.page];
+		Entry& entry = entries[region.filename];
+		entry.shaderResourceView = page.shaderResourceView.Get();
+		entry.pageWidth = page.width;
+		entry.pageHeight = page.height;
+		entry.x = static_cast<float>(region.x);
+		entry.y = static_cast<float>(region.y);
+		entry.width = static_cast<float>(region.width);
+		entry.height = static_cast<float>(region.height);
+
+		usedArea += static_cast<long long>(region.width) * region.height;
+	}
+
+	occupancy = pages.empty() ? 0.0f
+		: static_cast<float>(static_cast<double>(usedArea) / (static_cast<double>(manifest.pageSize) * manifest.pageSize * pages.size()));
+	return true;
+}
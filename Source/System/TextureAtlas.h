@@ -0,0 +1,161 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <wrl.h>
+#include <d3d11.h>
+
+// スカイライン法による矩形パッカー
+// 配置済み領域の上端を折れ線(スカイライン)で持ち、最も低く置ける位置に詰める
+// GPUを使わないので単体でテストできる
+class SkylinePacker
+{
+public:
+	SkylinePacker(int width, int height);
+
+	// 矩形を配置する(置けなければ false)
+	bool Insert(int width, int height, int& x, int& y);
+
+	// 使用率取得(0～1)
+	float GetOccupancy() const;
+
+private:
+	struct Node
+	{
+		int		x;
+		int		y;
+		int		width;
+	};
+
+	// index のノードから置いた場合の高さ(置けなければ -1)
+	int Fit(size_t index, int width, int height) const;
+
+	// 同じ高さで隣り合うノードをまとめる
+	void Merge();
+
+private:
+	int					width;
+	int					height;
+	long long			usedArea = 0;
+	std::vector<Node>	skyline;
+};
+
+// テクスチャアトラス
+// 小さなUI画像を数枚のアトラスページに詰め込み、Sprite から透過的に参照させる
+// ページ画像とマニフェスト(JSON)はディスクにキャッシュし、元画像が更新されたら作り直す
+class TextureAtlas
+{
+private:
+	TextureAtlas() = default;
+	~TextureAtlas() = default;
+
+public:
+	// インスタンス取得
+	static TextureAtlas& Instance()
+	{
+		static TextureAtlas instance;
+		return instance;
+	}
+
+	// 元画像の情報(更新検出用)
+	struct Source
+	{
+		std::string			filename;
+		unsigned long long	fileSize = 0;
+		long long			writeTime = 0;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	// ページ内の配置
+	struct Region
+	{
+		std::string			filename;
+		int					page = 0;
+		int					x = 0;
+		int					y = 0;
+		int					width = 0;
+		int					height = 0;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	// マニフェスト
+	struct Manifest
+	{
+		int						pageSize = 0;
+		int						padding = 0;
+		std::vector<std::string> pages;
+		std::vector<Source>		sources;
+		std::vector<Region>		regions;
+
+		template<class Archive>
+		void serialize(Archive& archive);
+	};
+
+	// Sprite から参照する情報
+	struct Entry
+	{
+		ID3D11ShaderResourceView*	shaderResourceView = nullptr;
+		float						pageWidth = 0;
+		float						pageHeight = 0;
+		float						x = 0;
+		float						y = 0;
+		float						width = 0;
+		float						height = 0;
+	};
+
+	// 初期化
+	// directory 内の画像のうち maxImageSize 以下のものをアトラス化する
+	// マニフェストが無いか元画像が更新されていれば作り直してから読み込む
+	void Initialize(ID3D11Device* device, const char* directory, const char* manifestFilename,
+		int pageSize = 2048, int maxImageSize = 1024, int padding = 2);
+
+	// 終了化
+	void Finalize();
+
+	// 登録されている画像なら配置を返す(なければ nullptr)
+	const Entry* Find(const char* filename) const;
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+	// 画像を詰め込んでページ画像とマニフェストを書き出す
+	static bool Build(const std::vector<Source>& sources, const char* manifestFilename,
+		int pageSize, int padding, Manifest& manifest);
+
+	// 詰め込み位置の計算(大きい順に並べて順に詰める)
+	// GPUを使わないので単体でテストできる
+	// sizes[i] の配置が regions[i] に入り、戻り値はページ数
+	static int Pack(const std::vector<std::pair<int, int>>& sizes, int pageSize, int padding,
+		std::vector<Region>& regions);
+
+	// ファイル名の正規化("./Data/a.png" と "Data/a.png" を同じものとして扱う)
+	static std::string NormalizeFilename(const char* filename);
+
+private:
+	// ディレクトリ内の元画像を列挙する
+	static std::vector<Source> CollectSources(const char* directory, int maxImageSize);
+
+	// マニフェストが元画像と一致しているか
+	static bool IsUpToDate(const Manifest& manifest, const char* manifestFilename,
+		const std::vector<Source>& sources, int pageSize, int padding);
+
+	// マニフェストからページを読み込む
+	bool Load(ID3D11Device* device, const char* manifestFilename, const Manifest& manifest);
+
+private:
+	struct Page
+	{
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>	shaderResourceView;
+		float												width = 0;
+		float												height = 0;
+	};
+
+	std::vector<Page>				pages;
+	std::map<std::string, Entry>	entries;
+	float							occupancy = 0;
+};
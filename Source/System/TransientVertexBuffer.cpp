@@ -0,0 +1,102 @@
+#include <imgui.h>
+#include "System/Misc.h"
+#include "System/TransientVertexBuffer.h"
+
+// コンストラクタ
+TransientVertexBuffer::TransientVertexBuffer(ID3D11Device* device, UINT capacity)
+	: device(device)
+{
+	Resize(capacity);
+}
+
+// バッファを作り直す
+void TransientVertexBuffer::Resize(UINT capacity)
+{
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = capacity;
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	// 古いバッファを参照している描画が残っていても、解放は描画の完了まで遅らせられる
+	buffer.Reset();
+	HRESULT hr = device->CreateBuffer(&desc, nullptr, buffer.GetAddressOf());
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	this->capacity = capacity;
+	writeOffset = 0;
+}
+
+// 確保して Map
+bool TransientVertexBuffer::Map(ID3D11DeviceContext* dc, UINT stride, UINT count, Allocation& allocation)
+{
+	UINT size = stride * count;
+	if (count > GetMaxCount(stride))
+	{
+		++frameStatistics.overflowCount;
+		return false;
+	}
+
+	// 入りきらなければ2倍ずつ大きくする
+	if (size > capacity)
+	{
+		UINT newCapacity = capacity;
+		while (newCapacity < size)
+		{
+			newCapacity = (newCapacity < MaxCapacity / 2) ? newCapacity * 2 : MaxCapacity;
+		}
+		Resize(newCapacity);
+		++frameStatistics.growCount;
+	}
+
+	// 要素の先頭をストライドの倍数に揃え、末尾に入らなければ先頭から書き直す
+	UINT offset = (writeOffset + stride - 1) / stride * stride;
+	if (offset + size > capacity)
+	{
+		offset = 0;
+		++frameStatistics.wrapCount;
+	}
+
+	// 使用済みの領域には触れないので書き込み中でもGPUを待たない
+	D3D11_MAP mapType = offset == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+	D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+	HRESULT hr = dc->Map(buffer.Get(), 0, mapType, 0, &mappedSubresource);
+	_ASSERT_EXPR(SUCCEEDED(hr), HRTrace(hr));
+
+	allocation.data = static_cast<BYTE*>(mappedSubresource.pData) + offset;
+	allocation.buffer = buffer.Get();
+	allocation.offset = offset;
+
+	writeOffset = offset + size;
+	frameStatistics.bytes += size;
+	++frameStatistics.allocationCount;
+	return true;
+}
+
+// Map 終了
+void TransientVertexBuffer::Unmap(ID3D11DeviceContext* dc)
+{
+	dc->Unmap(buffer.Get(), 0);
+}
+
+// フレーム開始
+void TransientVertexBuffer::NewFrame()
+{
+	frameStatistics.capacity = capacity;
+	lastFrameStatistics = frameStatistics;
+	frameStatistics = {};
+}
+
+// デバッグGUI描画
+void TransientVertexBuffer::DrawDebugGUI()
+{
+	if (ImGui::CollapsingHeader("Transient Vertex Buffer", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::Text("Capacity    : %u KB", lastFrameStatistics.capacity / 1024);
+		ImGui::Text("Bytes       : %u", lastFrameStatistics.bytes);
+		ImGui::Text("Allocations : %d", lastFrameStatistics.allocationCount);
+		ImGui::Text("Wraps       : %d", lastFrameStatistics.wrapCount);
+		ImGui::Text("Grows       : %d", lastFrameStatistics.growCount);
+		ImGui::Text("Overflows   : %d", lastFrameStatistics.overflowCount);
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d11.h>
+
+// フレーム内で使い捨てる頂点データ用のリングバッファ
+// 1つの動的頂点バッファの使用済み領域の後ろに WRITE_NO_OVERWRITE で書き足し、末尾に達したら WRITE_DISCARD で先頭に戻る
+// 1回の確保が容量を超える場合は最大容量までバッファを作り直して大きくし、それも超える場合は溢れとして数える
+// ShapeRenderer と PrimitiveRenderer で共有する
+class TransientVertexBuffer
+{
+public:
+	static const UINT DefaultCapacity = 256 * 1024;			// バイト
+	static const UINT MaxCapacity = 16 * 1024 * 1024;		// バイト
+
+	TransientVertexBuffer(ID3D11Device* device, UINT capacity = DefaultCapacity);
+
+	// 確保した領域
+	struct Allocation
+	{
+		void*			data = nullptr;		// 書き込み先(Unmap() まで有効)
+		ID3D11Buffer*	buffer = nullptr;	// IASetVertexBuffers() に渡すバッファ
+		UINT			offset = 0;			// IASetVertexBuffers() に渡すオフセット(バイト)
+	};
+
+	// 描画統計
+	struct Statistics
+	{
+		UINT	capacity = 0;			// バッファの大きさ(バイト)
+		UINT	bytes = 0;				// 確保したバイト数
+		int		allocationCount = 0;	// 確保した回数
+		int		wrapCount = 0;			// 先頭に戻った回数
+		int		growCount = 0;			// バッファを作り直して大きくした回数
+		int		overflowCount = 0;		// 最大容量を超えて確保できなかった回数(呼び出し側で分割する)
+	};
+
+	// count 個の stride バイトの要素を書き込めるように確保して Map する
+	// 最大容量を超える場合は false を返す(GetMaxCount() 個ずつに分けて確保すること)
+	bool Map(ID3D11DeviceContext* dc, UINT stride, UINT count, Allocation& allocation);
+
+	// Map() した領域の書き込み終了
+	void Unmap(ID3D11DeviceContext* dc);
+
+	// 1回で確保できる最大の要素数
+	static UINT GetMaxCount(UINT stride) { return MaxCapacity / stride; }
+
+	// フレーム開始(前フレームの統計を確定する)
+	void NewFrame();
+
+	// 前フレームの統計取得
+	const Statistics& GetStatistics() const { return lastFrameStatistics; }
+
+	// デバッグGUI描画
+	void DrawDebugGUI();
+
+private:
+	// capacity バイトのバッファを作り直す
+	void Resize(UINT capacity);
+
+private:
+	ID3D11Device*							device;
+	Microsoft::WRL::ComPtr<ID3D11Buffer>	buffer;
+	UINT									capacity = 0;
+	UINT									writeOffset = 0;	// 書き込み位置(バイト)
+
+	Statistics								frameStatistics;
+	Statistics								lastFrameStatistics;
+};
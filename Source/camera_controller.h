@@ -2,6 +2,7 @@
 #define CAMERA_CONTROLLER_H_
 
 #include "game_object.h"
+#include "world.h"
 #include "Camera.h"
 #include "System/Graphics.h"
 #include <Windows.h>
@@ -19,7 +20,7 @@ public:
         : GameObject(),
         camera_(),
         mode_(CameraMode::kFirstPerson),
-        target_(nullptr),
+        target_(),
         mouse_sensitivity_(0.25f),
         camera_pitch_(0.0f),
         camera_yaw_(0.0f),
@@ -57,8 +58,12 @@ public:
     void SetMode(CameraMode mode) { mode_ = mode; }
     CameraMode GetMode() const { return mode_; }
 
-    void SetTarget(GameObject* target) { target_ = target; }
-    GameObject* GetTarget() const { return target_; }
+    void SetTarget(GameObject* target) { target_ = target ? target->GetHandle() : GameObjectHandle(); }
+    GameObject* GetTarget() const {
+        // 追従対象が破棄されていれば nullptr
+        World* world = GetWorld();
+        return world ? world->Resolve(target_) : nullptr;
+    }
 
     void SetFov(float fov) {
         fov_ = fov;
@@ -95,11 +100,12 @@ private:
         camera_.SetPerspectiveFov(fov_, aspect, near_clip_, far_clip_);
     }
     void UpdateFirstPerson(float elapsed_time) {
-        if (!target_) return;
+        GameObject* target = GetTarget();
+        if (!target) return;
 
         HandleMouseLook(elapsed_time);
 
-        DirectX::XMVECTOR target_pos = target_->GetWorldPositionVector();
+        DirectX::XMVECTOR target_pos = target->GetWorldPositionVector();
         DirectX::XMVECTOR offset = DirectX::XMLoadFloat3(&offset_);
         DirectX::XMVECTOR pos_vec = DirectX::XMVectorAdd(target_pos, offset);
 
@@ -119,11 +125,12 @@ private:
     }
 
     void UpdateThirdPerson(float elapsed_time) {
-        if (!target_) return;
+        GameObject* target = GetTarget();
+        if (!target) return;
 
         HandleMouseLook(elapsed_time);
 
-        DirectX::XMVECTOR target_pos = target_->GetWorldPositionVector();
+        DirectX::XMVECTOR target_pos = target->GetWorldPositionVector();
         DirectX::XMVECTOR offset = DirectX::XMLoadFloat3(&offset_);
         DirectX::XMVECTOR focus_vec = DirectX::XMVectorAdd(target_pos, offset);
 
@@ -196,11 +203,12 @@ private:
     }
 
     void UpdateOrbit(float elapsed_time) {
-        if (!target_) return;
+        GameObject* target = GetTarget();
+        if (!target) return;
 
         HandleMouseLook(elapsed_time);
 
-        DirectX::XMFLOAT3 focus = target_->GetWorldPositionFloat3();
+        DirectX::XMFLOAT3 focus = target->GetWorldPositionFloat3();
 
         if (GetAsyncKeyState(VK_MBUTTON) & 0x8000) {
             float scroll = 0.0f;
@@ -264,7 +272,7 @@ private:
     Camera camera_;
 
     CameraMode mode_;
-    GameObject* target_;
+    GameObjectHandle target_;
 
     float mouse_sensitivity_;
 
@@ -2,6 +2,7 @@
 #define COLLIDER_H_
 
 #include <DirectXMath.h>
+#include "object_pool.h"
 
 class GameObject;
 
@@ -20,6 +21,9 @@ public:
     Collider(ColliderType type) : type_(type), owner_(nullptr), enabled_(true) {}
     virtual ~Collider() = default;
 
+    // 派生クラスごとのサイズで ObjectPool から確保する
+    OBJECT_POOL_ALLOCATION
+
     virtual bool CheckCollision(const Collider* other, GameObject*& out_other) const = 0;
     virtual bool CheckRigidbodyCollision(const Collider* other, 
                                         DirectX::XMFLOAT3& out_correction, 
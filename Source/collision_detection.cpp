@@ -10,7 +10,7 @@
 namespace CollisionDetection {
 
     // ============================================================================
-    // wp[֐
+    // ヘルパー関数
     // ============================================================================
 
     static DirectX::XMVECTOR ClosestPointOnSegment(
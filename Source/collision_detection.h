@@ -3,7 +3,7 @@
 
 #include <DirectXMath.h>
 
-// O錾
+// 前方宣言
 class SphereCollider;
 class BoxCollider;
 class AABBCollider;
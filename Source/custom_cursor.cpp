@@ -3,6 +3,8 @@
 #include "System/Graphics.h"
 #include "System/Sprite.h"
 #include "System/RenderState.h"
+#include "System/SpriteBatch.h"
+#include "render_layer.h"
 #include "Lerp.h"
 #include "mathUtils.h"
 #include <algorithm>
@@ -42,8 +44,12 @@ void CustomCursor::Render(ID3D11DeviceContext* dc)
     dc->OMSetDepthStencilState(rs->GetDepthStencilState(DepthState::NoTestNoWrite), 0);
     dc->OMSetBlendState(rs->GetBlendState(BlendState::Transparency), blendFactor, 0xffffffff);
 
-    RenderParticles(dc, current_alpha);
-    RenderCursor(dc, current_alpha);
+    // パーティクルとカーソルは同じテクスチャなので1回の描画にまとめる
+    SpriteBatch* batch = Graphics::Instance().GetSpriteBatch();
+    batch->Begin(dc);
+    RenderParticles(batch, current_alpha);
+    RenderCursor(batch, current_alpha);
+    batch->End();
 }
 
 void CustomCursor::Show()
@@ -170,7 +176,7 @@ float CustomCursor::GetCurrentAlpha() const
     );
 }
 
-void CustomCursor::RenderParticles(ID3D11DeviceContext* dc, float alpha)
+void CustomCursor::RenderParticles(SpriteBatch* batch, float alpha)
 {
     for (const auto& particle : particles_)
     {
@@ -181,7 +187,7 @@ void CustomCursor::RenderParticles(ID3D11DeviceContext* dc, float alpha)
             Lerp::EASING_TYPE::Normal, 1.0f, 0.0f
         ) * alpha;
 
-        sprite_->Render(dc,
+        batch->Draw(sprite_.get(), RenderLayer::kDefault,
             particle.position.x - 25.0f,
             particle.position.y - offset_y - 25.0f,
             0.0f,
@@ -194,9 +200,9 @@ void CustomCursor::RenderParticles(ID3D11DeviceContext* dc, float alpha)
     }
 }
 
-void CustomCursor::RenderCursor(ID3D11DeviceContext* dc, float alpha)
+void CustomCursor::RenderCursor(SpriteBatch* batch, float alpha)
 {
-    sprite_->Render(dc,
+    batch->Draw(sprite_.get(), RenderLayer::kDefault,
         position_.x - 25.0f,
         position_.y - 25.0f,
         0.0f,
@@ -8,212 +8,213 @@
 #include <vector>
 
 class Sprite;
+class SpriteBatch;
 class Lerp;
 
 /**
  * @class CustomCursor
- * @brief JX^J[\̕`EAj[VǗsVOgNX
+ * @brief カスタムカーソルの描画・アニメーション管理を行うシングルトンクラス
  *
- * XvCgx[X̃JX^J[\`悵Ap[eBNGtFNgA
- * tF[hC/AEgȂǂ̎oʂ񋟂܂B
+ * スプライトベースのカスタムカーソルを描画し、パーティクルエフェクト、
+ * フェードイン/アウトなどの視覚効果を提供します。
  */
 class CustomCursor
 {
 private:
     /**
      * @struct Particle
-     * @brief J[\̃p[eBN
+     * @brief カーソルのパーティクル情報
      */
     struct Particle
     {
-        int type;                                 ///< p[eBN̎
-        std::unique_ptr<Lerp> lifetime_lerp;      ///< ǗpLerp
-        DirectX::XMFLOAT2 position;               ///< p[eBN̈ʒu
-        float angle = 0.0f;                       ///< ]px
+        int type;                                 ///< パーティクルの種類
+        std::unique_ptr<Lerp> lifetime_lerp;      ///< 寿命管理用Lerp
+        DirectX::XMFLOAT2 position;               ///< パーティクルの位置
+        float angle = 0.0f;                       ///< 回転角度
     };
 
 public:
     /**
-     * @brief VOgCX^X擾
-     * @return CustomCursor& CX^Xւ̎Q
+     * @brief シングルトンインスタンスを取得
+     * @return CustomCursor& インスタンスへの参照
      */
     static CustomCursor& Instance();
 
     /**
-     * @brief JX^J[\
-     * @param sprite_path XvCg摜̃pXiftHg: "Data/Sprite/new_cursor.png"j
+     * @brief カスタムカーソルを初期化
+     * @param sprite_path スプライト画像のパス（デフォルト: "Data/Sprite/new_cursor.png"）
      */
     void Initialize(const char* sprite_path = "Data/Sprite/new_cursor.png");
 
     /**
-     * @brief J[\̍XV
-     * @param elapsed_time Ot[̌oߎ(b)
+     * @brief カーソルの更新処理
+     * @param elapsed_time 前フレームからの経過時間(秒)
      *
-     * J[\ʒu̒ǐՁAp[eBN̍XVAtF[hs܂B
+     * カーソル位置の追跡、パーティクルの更新、フェード処理を実行します。
      */
     void Update(float elapsed_time);
 
     /**
-     * @brief J[\`
-     * @param dc Direct3DfoCXReLXg
+     * @brief カーソルを描画
+     * @param dc Direct3Dデバイスコンテキスト
      */
     void Render(ID3D11DeviceContext* dc);
 
     /**
-     * @brief JX^J[\\
+     * @brief カスタムカーソルを表示
      */
     void Show();
 
     /**
-     * @brief JX^J[\\
+     * @brief カスタムカーソルを非表示
      */
     void Hide();
 
     /**
-     * @brief tF[hAEgJn
-     * @param duration tF[h(b)
-     * @param on_complete tF[h̃R[obN֐iIvVj
+     * @brief フェードアウトを開始
+     * @param duration フェード時間(秒)
+     * @param on_complete フェード完了時のコールバック関数（オプション）
      */
     void FadeOut(float duration, std::function<void()> on_complete = nullptr);
 
     /**
-     * @brief tF[hCJn
-     * @param duration tF[h(b)
-     * @param on_complete tF[h̃R[obN֐iIvVj
+     * @brief フェードインを開始
+     * @param duration フェード時間(秒)
+     * @param on_complete フェード完了時のコールバック関数（オプション）
      */
     void FadeIn(float duration, std::function<void()> on_complete = nullptr);
 
     /**
-     * @brief At@l𑦍ɐݒ
-     * @param alpha At@li0.0f`1.0fj
+     * @brief アルファ値を即座に設定
+     * @param alpha アルファ値（0.0f～1.0f）
      */
     void SetAlpha(float alpha);
 
     /**
-     * @brief p[eBNԊuݒ
-     * @param frames Ԋuit[j
+     * @brief パーティクル生成間隔を設定
+     * @param frames 生成間隔（フレーム数）
      */
     void SetParticleSpawnInterval(int frames);
 
     /**
-     * @brief p[eBNL/
-     * @param enable trueŗLAfalseŖ
+     * @brief パーティクル生成を有効/無効化
+     * @param enable trueで有効、falseで無効
      */
     void EnableParticles(bool enable);
 
     /**
-     * @brief J[\̕\Ԃ擾
-     * @return bool \̏ꍇtrue
+     * @brief カーソルの表示状態を取得
+     * @return bool 表示中の場合true
      */
     bool IsVisible() const;
 
     /**
-     * @brief tF[hǂ擾
-     * @return bool tF[h̏ꍇtrue
+     * @brief フェード中かどうかを取得
+     * @return bool フェード中の場合true
      */
     bool IsFading() const;
 
     /**
-     * @brief J[\݈̌ʒu擾
-     * @return DirectX::XMFLOAT2 J[\ʒu
+     * @brief カーソルの現在位置を取得
+     * @return DirectX::XMFLOAT2 カーソル位置
      */
     DirectX::XMFLOAT2 GetPosition() const;
 
 private:
     /**
-     * @brief RXgN^iVOĝprivatej
+     * @brief コンストラクタ（シングルトンのためprivate）
      */
     CustomCursor() = default;
 
     /**
-     * @brief fXgN^
+     * @brief デストラクタ
      */
     ~CustomCursor() = default;
 
     /**
-     * @brief Rs[RXgN^i폜j
+     * @brief コピーコンストラクタ（削除）
      */
     CustomCursor(const CustomCursor&) = delete;
 
     /**
-     * @brief Zqi폜j
+     * @brief 代入演算子（削除）
      */
     CustomCursor& operator=(const CustomCursor&) = delete;
 
     /**
-     * @brief p[eBN̍XV
-     * @param elapsed_time oߎ
+     * @brief パーティクルの更新処理
+     * @param elapsed_time 経過時間
      */
     void UpdateParticles(float elapsed_time);
 
     /**
-     * @brief tF[h̍XV
-     * @param elapsed_time oߎ
+     * @brief フェード処理の更新
+     * @param elapsed_time 経過時間
      */
     void UpdateFade(float elapsed_time);
 
     /**
-     * @brief p[eBN𐶐ׂ
-     * @return bool ꍇtrue
+     * @brief パーティクルを生成すべきか判定
+     * @return bool 生成する場合true
      */
     bool ShouldSpawnParticle();
 
     /**
-     * @brief p[eBN𐶐
+     * @brief パーティクルを生成
      */
     void SpawnParticle();
 
     /**
-     * @brief ݂̃At@l擾itF[hlj
-     * @return float ݂̃At@l
+     * @brief 現在のアルファ値を取得（フェード考慮）
+     * @return float 現在のアルファ値
      */
     float GetCurrentAlpha() const;
 
     /**
-     * @brief p[eBN`
-     * @param dc foCXReLXg
-     * @param alpha {At@l
+     * @brief パーティクルをスプライトバッチに登録
+     * @param batch スプライトバッチ
+     * @param alpha 基本アルファ値
      */
-    void RenderParticles(ID3D11DeviceContext* dc, float alpha);
+    void RenderParticles(SpriteBatch* batch, float alpha);
 
     /**
-     * @brief J[\{̂`
-     * @param dc foCXReLXg
-     * @param alpha At@l
+     * @brief カーソル本体をスプライトバッチに登録
+     * @param batch スプライトバッチ
+     * @param alpha アルファ値
      */
-    void RenderCursor(ID3D11DeviceContext* dc, float alpha);
+    void RenderCursor(SpriteBatch* batch, float alpha);
 
     /**
-     * @brief tF[hJn
-     * @param start_alpha JnAt@l
-     * @param target_alpha ڕWAt@l
-     * @param duration tF[h
-     * @param callback ̃R[obN
+     * @brief フェード処理を開始
+     * @param start_alpha 開始アルファ値
+     * @param target_alpha 目標アルファ値
+     * @param duration フェード時間
+     * @param callback 完了時のコールバック
      */
     void StartFade(float start_alpha, float target_alpha, float duration, std::function<void()> callback);
 
     /**
-     * @brief tF[h~
+     * @brief フェード処理を停止
      */
     void StopFade();
 
 private:
-    std::unique_ptr<Sprite> sprite_;              ///< J[\XvCg
-    DirectX::XMFLOAT2 position_{};                ///< J[\ʒu
-
-    bool is_visible_ = true;                      ///< \
-    float alpha_ = 1.0f;                          ///< At@l
-
-    bool is_fading_ = false;                      ///< tF[htO
-    float fade_start_alpha_ = 1.0f;               ///< tF[hJnAt@l
-    float fade_target_alpha_ = 1.0f;              ///< tF[hڕWAt@l
-    std::unique_ptr<Lerp> fade_lerp_;             ///< tF[hpLerp
-    std::function<void()> on_fade_complete_;      ///< tF[hR[obN
-
-    std::vector<Particle> particles_;             ///< p[eBNXg
-    int particle_timer_ = 0;                      ///< p[eBN^C}[
-    int particle_spawn_interval_ = 30;            ///< p[eBNԊu
-    bool particles_enabled_ = true;               ///< p[eBNLtO
+    std::unique_ptr<Sprite> sprite_;              ///< カーソルスプライト
+    DirectX::XMFLOAT2 position_{};                ///< カーソル位置
+
+    bool is_visible_ = true;                      ///< 表示状態
+    float alpha_ = 1.0f;                          ///< アルファ値
+
+    bool is_fading_ = false;                      ///< フェード中フラグ
+    float fade_start_alpha_ = 1.0f;               ///< フェード開始アルファ値
+    float fade_target_alpha_ = 1.0f;              ///< フェード目標アルファ値
+    std::unique_ptr<Lerp> fade_lerp_;             ///< フェード用Lerp
+    std::function<void()> on_fade_complete_;      ///< フェード完了時コールバック
+
+    std::vector<Particle> particles_;             ///< パーティクルリスト
+    int particle_timer_ = 0;                      ///< パーティクル生成タイマー
+    int particle_spawn_interval_ = 30;            ///< パーティクル生成間隔
+    bool particles_enabled_ = true;               ///< パーティクル有効フラグ
 };
 
 #endif  // CUSTOM_CURSOR_H_
\ No newline at end of file
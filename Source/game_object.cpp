@@ -1,7 +1,10 @@
 #include "game_object.h"
 #include "collider.h"
 #include "rigidbody.h"
+#include "world.h"
+#include "System/Misc.h"
 #include <algorithm>
+#include <limits>
 #include "System/ModelRenderer.h"
 #include "PBRShader.h"
 #include "System/Shader.h"
@@ -14,58 +17,40 @@ GameObject::~GameObject() {
 
     delete rigidbody_;
 
-    for (GameObject* child : children_) {
-        if (child) {
-            child->parent_ = nullptr;
+    // 親の子リストに破棄済みのハンドルを残さない(破棄済みの親や子は Resolve() が nullptr を返す)
+    DetachFromParent();
+    for (const GameObjectHandle& child_handle : children_) {
+        if (GameObject* child = ResolveInWorld(child_handle)) {
+            child->parent_ = GameObjectHandle();
         }
     }
-}
-
-void GameObject::UpdatePosition(float elapsed_time) {
-    if (!IsActiveInHierarchy()) return;
-
-    elapsed_time_ += elapsed_time;
-
-    DirectX::XMVECTOR pos_vec = DirectX::XMLoadFloat3(&position_);
-    DirectX::XMVECTOR vel_vec = DirectX::XMLoadFloat3(&velocity_);
-    DirectX::XMVECTOR scaled_vel = DirectX::XMVectorScale(vel_vec, elapsed_time);
-    pos_vec = DirectX::XMVectorAdd(pos_vec, scaled_vel);
-    DirectX::XMStoreFloat3(&position_, pos_vec);
-
-    UpdateTransform();
 
-    for (GameObject* child : children_) {
-        if (child) {
-            child->UpdatePosition(elapsed_time);
-        }
-    }
+    TransformStorage::Instance().Free(transform_slot_);
 }
 
 void GameObject::Render(const RenderContext& rc, ModelRenderer* model_renderer) {
     if (!IsActiveInHierarchy() || !model_) return;
 
-    model_renderer->Draw(ShaderId::PBR, model_);
-
-    for (GameObject* child : children_) {
-        if (child) {
-            child->Render(rc, model_renderer);
-        }
-    }
+    // モデルは他のオブジェクトと共有されていることがあるので、自分のワールド行列を渡して描画する
+    DirectX::XMFLOAT4X4 world_transform = GetWorldTransformFloat4X4();
+    model_renderer->Draw(ShaderId::PBR, model_, lod_level_, &world_transform);
 }
 
 void GameObject::SetParentTransformOnly(GameObject* parent,
     bool keep_world_position) {
+    _ASSERT_EXPR(!parent || (world_ && parent->world_ == world_), L"GameObject: parent must be registered in the same World");
+
     if (keep_world_position && parent) {
-        // [hWۑ
+        // ワールド座標を保存
         DirectX::XMVECTOR world_pos = GetWorldPositionVector();
 
         DetachFromParent();
 
-        parent_ = parent;
+        parent_ = parent->GetHandle();
         hierarchy_type_ = HierarchyType::kTransformOnly;
-        parent_->children_.push_back(this);
+        parent->children_.push_back(handle_);
 
-        // [JWɕϊ
+        // ローカル座標に変換
         DirectX::XMMATRIX parent_world_inv = DirectX::XMMatrixInverse(
             nullptr, parent->GetWorldTransformMatrix());
         DirectX::XMVECTOR local_pos = DirectX::XMVector3TransformCoord(
@@ -75,11 +60,11 @@ void GameObject::SetParentTransformOnly(GameObject* parent,
     else {
         DetachFromParent();
 
-        parent_ = parent;
+        parent_ = parent ? parent->GetHandle() : GameObjectHandle();
         hierarchy_type_ = HierarchyType::kTransformOnly;
 
-        if (parent_) {
-            parent_->children_.push_back(this);
+        if (parent) {
+            parent->children_.push_back(handle_);
         }
     }
 
@@ -87,17 +72,19 @@ void GameObject::SetParentTransformOnly(GameObject* parent,
 }
 
 void GameObject::SetParent(GameObject* parent, bool keep_world_position) {
+    _ASSERT_EXPR(!parent || (world_ && parent->world_ == world_), L"GameObject: parent must be registered in the same World");
+
     if (keep_world_position && parent) {
-        // [hWۑ
+        // ワールド座標を保存
         DirectX::XMVECTOR world_pos = GetWorldPositionVector();
 
         DetachFromParent();
 
-        parent_ = parent;
+        parent_ = parent->GetHandle();
         hierarchy_type_ = HierarchyType::kFull;
-        parent_->children_.push_back(this);
+        parent->children_.push_back(handle_);
 
-        // [JWɕϊ
+        // ローカル座標に変換
         DirectX::XMMATRIX parent_world_inv = DirectX::XMMatrixInverse(
             nullptr, parent->GetWorldTransformMatrix());
         DirectX::XMVECTOR local_pos = DirectX::XMVector3TransformCoord(
@@ -107,11 +94,11 @@ void GameObject::SetParent(GameObject* parent, bool keep_world_position) {
     else {
         DetachFromParent();
 
-        parent_ = parent;
+        parent_ = parent ? parent->GetHandle() : GameObjectHandle();
         hierarchy_type_ = HierarchyType::kFull;
 
-        if (parent_) {
-            parent_->children_.push_back(this);
+        if (parent) {
+            parent->children_.push_back(handle_);
         }
     }
 
@@ -119,21 +106,31 @@ void GameObject::SetParent(GameObject* parent, bool keep_world_position) {
 }
 
 void GameObject::DetachFromParent() {
-    if (parent_) {
-        auto& siblings = parent_->children_;
+    if (GameObject* parent = GetParent()) {
+        auto& siblings = parent->children_;
         siblings.erase(
-            std::remove(siblings.begin(), siblings.end(), this),
+            std::remove(siblings.begin(), siblings.end(), handle_),
             siblings.end());
-        parent_ = nullptr;
     }
+    parent_ = GameObjectHandle();
     hierarchy_type_ = HierarchyType::kNone;
 }
 
+GameObject* GameObject::GetParent() const {
+    return ResolveInWorld(parent_);
+}
+
+GameObject* GameObject::ResolveInWorld(const GameObjectHandle& handle) const {
+    return world_ && handle.IsSet() ? world_->Resolve(handle) : nullptr;
+}
+
 bool GameObject::IsActiveInHierarchy() const {
     if (!active_) return false;
 
-    if (hierarchy_type_ == HierarchyType::kFull && parent_) {
-        return parent_->IsActiveInHierarchy();
+    if (hierarchy_type_ == HierarchyType::kFull) {
+        if (GameObject* parent = GetParent()) {
+            return parent->IsActiveInHierarchy();
+        }
     }
 
     return true;
@@ -159,8 +156,9 @@ DirectX::XMFLOAT4X4 GameObject::GetWorldTransformFloat4X4() const {
 DirectX::XMMATRIX GameObject::GetWorldTransformMatrix() const {
     DirectX::XMMATRIX local_transform = DirectX::XMLoadFloat4x4(&transform_);
 
-    if (parent_ && hierarchy_type_ != HierarchyType::kNone) {
-        DirectX::XMMATRIX parent_world = parent_->GetWorldTransformMatrix();
+    GameObject* parent = hierarchy_type_ != HierarchyType::kNone ? GetParent() : nullptr;
+    if (parent) {
+        DirectX::XMMATRIX parent_world = parent->GetWorldTransformMatrix();
         return local_transform * parent_world;
     }
 
@@ -191,9 +189,10 @@ void GameObject::SetWorldPosition(float x, float y, float z) {
 }
 
 void GameObject::SetWorldPositionVector(DirectX::FXMVECTOR v) {
-    if (parent_ && hierarchy_type_ != HierarchyType::kNone) {
+    GameObject* parent = hierarchy_type_ != HierarchyType::kNone ? GetParent() : nullptr;
+    if (parent) {
         DirectX::XMMATRIX parent_world_inv = DirectX::XMMatrixInverse(
-            nullptr, parent_->GetWorldTransformMatrix());
+            nullptr, parent->GetWorldTransformMatrix());
         DirectX::XMVECTOR local_pos = DirectX::XMVector3TransformCoord(
             v, parent_world_inv);
         DirectX::XMStoreFloat3(&position_, local_pos);
@@ -289,7 +288,7 @@ void GameObject::RemoveAllColliders() {
 }
 
 void GameObject::SetRigidbody(Rigidbody* rigidbody) {
-    delete rigidbody_;
+    RemoveRigidbody();
     rigidbody_ = rigidbody;
     if (rigidbody_) {
         rigidbody_->SetOwner(this);
@@ -297,7 +296,7 @@ void GameObject::SetRigidbody(Rigidbody* rigidbody) {
 }
 
 Rigidbody* GameObject::AddRigidbody() {
-    delete rigidbody_;
+    RemoveRigidbody();
 
     rigidbody_ = new Rigidbody();
     rigidbody_->SetOwner(this);
@@ -308,13 +307,35 @@ Rigidbody* GameObject::AddRigidbody() {
 void GameObject::RemoveRigidbody() {
     delete rigidbody_;
     rigidbody_ = nullptr;
+
+    // リジッドボディがなければ重力も抵抗も受けない
+    TransformStorage& storage = TransformStorage::Instance();
+    storage.GravityScale(transform_slot_) = 0.0f;
+    storage.Drag(transform_slot_) = 0.0f;
+}
+
+void GameObject::SetActive(bool active) {
+    // 非アクティブになったら World の破棄待ちに積む(フレームの終わりにまだ非アクティブなら破棄される)
+    if (active_ && !active && world_) {
+        world_->MarkPendingKill(this);
+    }
+    active_ = active;
+
+    uint8_t& flags = TransformStorage::Instance().Flags(transform_slot_);
+    if (active) {
+        flags |= TransformStorage::kFlagActive;
+    }
+    else {
+        flags &= ~TransformStorage::kFlagActive;
+    }
 }
 
 void GameObject::Destroy() {
-    active_ = false;
+    SetActive(false);
 
-    std::vector<GameObject*> children_copy = children_;
-    for (GameObject* child : children_copy) {
+    // DetachFromParent() は children_ から自身を取り除くので、後ろから処理する
+    for (size_t i = children_.size(); i > 0; --i) {
+        GameObject* child = ResolveInWorld(children_[i - 1]);
         if (child) {
             if (child->hierarchy_type_ == HierarchyType::kFull) {
                 child->Destroy();
@@ -445,7 +466,7 @@ float GameObject::GetDistanceTo(const DirectX::XMFLOAT3& point) const {
 float GameObject::GetDistanceSquaredTo(const GameObject* other) const {
     if (!other) return 0.0f;
 
-    // SIMDœK: XMVector3LengthSqgp
+    // SIMD最適化: XMVector3LengthSqを使用
     DirectX::XMVECTOR pos1 = GetWorldPositionVector();
     DirectX::XMVECTOR pos2 = other->GetWorldPositionVector();
     DirectX::XMVECTOR diff = DirectX::XMVectorSubtract(pos2, pos1);
@@ -477,6 +498,7 @@ bool GameObject::IsInRange(const GameObject* other, float range) const {
 
 void GameObject::SetTransform(const DirectX::XMFLOAT4X4& transform) {
     transform_ = transform;
+    InvalidateBounds(true);
     if (model_) {
         DirectX::XMFLOAT4X4 world_transform = GetWorldTransformFloat4X4();
         model_->UpdateTransform(world_transform);
@@ -501,6 +523,22 @@ void GameObject::SetSpeed(float speed) {
 }
 
 void GameObject::UpdateTransform() {
+    UpdateLocalTransform();
+    InvalidateBounds(false);
+
+    // 登録先の World が並列更新中のスレッドでは、モデルと子への反映は World がまとめて行う
+    if (world_ && world_->IsTransformPropagationDeferred()) return;
+
+    UpdateModelTransform();
+
+    for (const GameObjectHandle& child_handle : children_) {
+        if (GameObject* child = ResolveInWorld(child_handle)) {
+            child->UpdateTransform();
+        }
+    }
+}
+
+void GameObject::UpdateLocalTransform() {
     DirectX::XMMATRIX scale_matrix = DirectX::XMMatrixScaling(
         scale_.x, scale_.y, scale_.z);
     DirectX::XMMATRIX rotation_matrix = DirectX::XMMatrixRotationRollPitchYaw(
@@ -510,15 +548,23 @@ void GameObject::UpdateTransform() {
     DirectX::XMMATRIX world_matrix = scale_matrix * rotation_matrix *
         translation_matrix;
     DirectX::XMStoreFloat4x4(&transform_, world_matrix);
+}
 
+void GameObject::UpdateModelTransform() {
     if (model_) {
         DirectX::XMFLOAT4X4 world_transform = GetWorldTransformFloat4X4();
         model_->UpdateTransform(world_transform);
     }
+}
 
-    for (GameObject* child : children_) {
-        if (child) {
-            child->UpdateTransform();
+void GameObject::InvalidateBounds(bool recursive) {
+    // 半径を無限大にして、外接球による枝刈りを行わないようにする
+    TransformStorage::Instance().Bounds(transform_slot_).w = std::numeric_limits<float>::infinity();
+
+    if (!recursive) return;
+    for (const GameObjectHandle& child_handle : children_) {
+        if (GameObject* child = ResolveInWorld(child_handle)) {
+            child->InvalidateBounds(true);
         }
     }
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 /**
  * @file game_object.h
- * @brief Q[IuWFNg̊NX`
+ * @brief ゲームオブジェクトの基底クラス定義
  */
 
 #ifndef GAME_OBJECT_H_
@@ -17,51 +17,55 @@
 #include "sphere_collider.h"
 #include "cylinder_collider.h"
 #include "aabb_collider.h"
+#include "transform_storage.h"
+#include "object_pool.h"
+#include "game_object_handle.h"
 
- // O錾
+ // 前方宣言
 class Rigidbody;
+class World;
 class ModelRenderer;
 struct RenderContext;
 
 /**
- * @brief Kw֌W̃^Cv
+ * @brief 階層関係のタイプ
  */
 enum class HierarchyType {
-    kNone,           ///< eq֌WȂ
-    kTransformOnly,  ///< gXtH[̂݌p
-    kFull           ///< SȐeq֌WiANeBuԂpj
+    kNone,           ///< 親子関係なし
+    kTransformOnly,  ///< トランスフォームのみ継承
+    kFull           ///< 完全な親子関係（アクティブ状態も継承）
 };
 
 /**
- * @brief Q[IuWFNg̊NX
+ * @brief ゲームオブジェクトの基底クラス
  *
- * 3DԂɂQ[IuWFNg\NXB
- * ʒuA]AXP[Ȃǂ̃gXtH[A
- * fARC_[AWbh{fBȂǂ̃R|[lgǗB
+ * 3D空間におけるゲームオブジェクトを表現するクラス。
+ * 位置、回転、スケールなどのトランスフォーム情報、
+ * モデル、コライダー、リジッドボディなどのコンポーネントを管理する。
  */
 class GameObject {
 public:
-    /// @brief ftHgRXgN^
+    /// @brief コライダーのリスト（生成と破棄を繰り返してもヒープを使わないよう ObjectPool から確保する）
+    using ColliderList = std::vector<Collider*, PoolAllocator<Collider*>>;
+
+    /// @brief 子オブジェクトのハンドルのリスト（ColliderList と同じく ObjectPool から確保する）
+    using ChildList = std::vector<GameObjectHandle, PoolAllocator<GameObjectHandle>>;
+
+    /// @brief デフォルトコンストラクタ
     GameObject()
-        : position_({ 0.0f, 0.0f, 0.0f }),
-        angle_({ 0.0f, 0.0f, 0.0f }),
-        scale_({ 1.0f, 1.0f, 1.0f }),
-        velocity_({ 0.0f, 0.0f, 0.0f }),
-        rigidbody_(nullptr),
-        parent_(nullptr),
+        : rigidbody_(nullptr),
         hierarchy_type_(HierarchyType::kNone),
-        active_(true),
-        elapsed_time_(0.0f)
+        active_(true)
     {
         UpdateTransform();
     }
 
     /**
-     * @brief fpXAʒuA]AXP[w肵č\z
-     * @param model_filepath ft@C̃pX
-     * @param pos ʒu
-     * @param rotation ]iWAj
-     * @param scale XP[
+     * @brief モデルパス、位置、回転、スケールを指定して構築
+     * @param model_filepath モデルファイルのパス
+     * @param pos 初期位置
+     * @param rotation 初期回転（ラジアン）
+     * @param scale 初期スケール
      */
     GameObject(const char* model_filepath,
         const DirectX::XMFLOAT3& pos = {0.0f, 0.0f, 0.0f }, 
@@ -75,10 +79,10 @@ public:
     }
 
     /**
-     * @brief ʒuA]AXP[w肵č\z
-     * @param pos ʒu
-     * @param rotation ]iWAj
-     * @param scale XP[
+     * @brief 位置、回転、スケールを指定して構築
+     * @param pos 初期位置
+     * @param rotation 初期回転（ラジアン）
+     * @param scale 初期スケール
      */
     //GameObject(
     //    const DirectX::XMFLOAT3& pos,
@@ -90,510 +94,541 @@ public:
     //    UpdateTransform();
     //}
 
-    /// @brief fXgN^
+    /// @brief デストラクタ
     virtual ~GameObject();
 
+    /// @brief コピー禁止（トランスフォームは TransformStorage のスロットを参照するため）
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
+
+    /// @brief 派生クラスごとのサイズで ObjectPool から確保する
+    OBJECT_POOL_ALLOCATION
+
     /**
-     * @brief XV (UpdatePosition()O)
-     * @param elapsed_time Ot[̌oߎԁibj
+     * @brief 更新処理 (座標の積分前)
+     * @param elapsed_time 前フレームからの経過時間（秒）
+     *
+     * 座標の積分は World が TransformStorage の配列をまとめて処理する。
      */
     virtual void Update(float elapsed_time) {};
 
     /**
-	 * @brief WXV (Update())
-     * @param elapsed_time Ot[̌oߎԁibj
+     * @brief 描画処理
+     * @param rc レンダーコンテキスト
+     * @param model_renderer モデルレンダラー
+     *
+     * World::Render() がカリングの後にオブジェクトごとに呼ぶので、子の描画はここでは行わない。
      */
-    void UpdatePosition(float elapsed_time);
+    virtual void Render(const RenderContext& rc, ModelRenderer* model_renderer);
 
     /**
-     * @brief `揈
-     * @param rc _[ReLXg
-     * @param model_renderer f_[
+     * @brief トランスフォーム行列を更新
+     *
+     * 位置、回転、スケールから変換行列を再計算する。
+     * SetPosition等のトランスフォーム変更メソッドから自動的に呼ばれる。
+     * 並列更新中は自身の行列だけを更新し、モデルと子への反映は World がまとめて行う。
      */
-    virtual void Render(const RenderContext& rc, ModelRenderer* model_renderer);
+    void UpdateTransform();
 
     /**
-     * @brief gXtH[sXV
+     * @brief 自身のローカル変換行列のみを更新
+     */
+    void UpdateLocalTransform();
+
+    /**
+     * @brief ワールド変換行列をモデルに反映
+     */
+    void UpdateModelTransform();
+
+    /**
+     * @brief Update() を他のオブジェクトと並列に実行してよいか設定
+     * @param enable trueで並列実行
      *
-     * ʒuA]AXP[ϊsČvZB
-     * SetPositioñgXtH[ύX\bh玩IɌĂ΂B
+     * Update() で自分自身しか書き換えず、他のオブジェクトの状態も読まない場合のみ有効にすること。
+     * 他のオブジェクトへの変更は World::Defer() で同期点まで遅らせる。
      */
-    void UpdateTransform();
+    void SetParallelUpdate(bool enable) { parallel_update_ = enable; }
+
+    /**
+     * @brief Update() を並列に実行してよいか取得
+     * @return 並列実行する場合true
+     */
+    bool IsParallelUpdate() const { return parallel_update_; }
 
     // ========================================
-    // eq֌W
+    // 親子関係
     // ========================================
 
     /**
-     * @brief eIuWFNgݒ
-     * @param parent eIuWFNg
-     * @param keep_world_position truȅꍇA[hWێ
+     * @brief 親オブジェクトを設定
+     * @param parent 親オブジェクト
+     * @param keep_world_position trueの場合、ワールド座標を維持する
      */
     void SetParent(GameObject* parent, bool keep_world_position = false);
 
     /**
-     * @brief gXtH[̂݌peq֌Wݒ
-     * @param parent eIuWFNg
-     * @param keep_world_position truȅꍇA[hWێ
+     * @brief トランスフォームのみ継承する親子関係を設定
+     * @param parent 親オブジェクト
+     * @param keep_world_position trueの場合、ワールド座標を維持する
      */
     void SetParentTransformOnly(GameObject* parent, bool keep_world_position = false);
 
     /**
-     * @brief e؂藣
+     * @brief 親から切り離す
      */
     void DetachFromParent();
 
     /**
-     * @brief eIuWFNg擾
-     * @return eIuWFNgiȂnullptrj
+     * @brief 親オブジェクトを取得
+     * @return 親オブジェクト（なければ、または破棄済みならnullptr）
      */
-    GameObject* GetParent() const { return parent_; }
+    GameObject* GetParent() const;
 
     /**
-     * @brief qIuWFNg̃Xg擾
-     * @return qIuWFNg̃Xg
+     * @brief 子オブジェクトのリストを取得
+     * @return 子オブジェクトのハンドルのリスト（World::Resolve() で取得する）
      */
-    const std::vector<GameObject*>& GetChildren() const { return children_; }
+    const ChildList& GetChildren() const { return children_; }
 
     // ========================================
-    // ʒuE]EXP[
+    // 位置・回転・スケール
     // ========================================
 
     /**
-     * @brief [JWݒ
-     * @param pos [JW
+     * @brief ローカル座標を設定
+     * @param pos ローカル座標
      */
     void SetLocalPosition(const DirectX::XMFLOAT3& pos);
 
     /**
-     * @brief [JWݒ
-     * @param x XW
-     * @param y YW
-     * @param z ZW
+     * @brief ローカル座標を設定
+     * @param x X座標
+     * @param y Y座標
+     * @param z Z座標
      */
     void SetLocalPosition(float x, float y, float z);
 
     /**
-     * @brief [JWݒ
-     * @param v WxNg
+     * @brief ローカル座標を設定
+     * @param v 座標ベクトル
      */
     void SetLocalPositionVector(DirectX::FXMVECTOR v);
 
     /**
-     * @brief WݒiSetLocalPositioñGCAXj
-     * @param pos W
+     * @brief 座標を設定（SetLocalPositionのエイリアス）
+     * @param pos 座標
      */
     void SetPosition(const DirectX::XMFLOAT3& pos) { SetLocalPosition(pos); }
 
     /**
-     * @brief WݒiSetLocalPositioñGCAXj
-     * @param x XW
-     * @param y YW
-     * @param z ZW
+     * @brief 座標を設定（SetLocalPositionのエイリアス）
+     * @param x X座標
+     * @param y Y座標
+     * @param z Z座標
      */
     void SetPosition(float x, float y, float z) { SetLocalPosition(x, y, z); }
 
     /**
-     * @brief WݒiSetLocalPositioñGCAXj
-     * @param v WxNg
+     * @brief 座標を設定（SetLocalPositionのエイリアス）
+     * @param v 座標ベクトル
      */
     void SetPositionVector(DirectX::FXMVECTOR v) { SetLocalPositionVector(v); }
 
     /**
-     * @brief [JW擾
-     * @return [JW
+     * @brief ローカル座標を取得
+     * @return ローカル座標
      */
     const DirectX::XMFLOAT3& GetLocalPositionFloat3() const { return position_; }
 
     /**
-     * @brief [hWݒ
-     * @param world_pos [hW
+     * @brief ワールド座標を設定
+     * @param world_pos ワールド座標
      */
     void SetWorldPosition(const DirectX::XMFLOAT3& world_pos);
 
     /**
-     * @brief [hWݒ
-     * @param x XW
-     * @param y YW
-     * @param z ZW
+     * @brief ワールド座標を設定
+     * @param x X座標
+     * @param y Y座標
+     * @param z Z座標
      */
     void SetWorldPosition(float x, float y, float z);
 
     /**
-     * @brief [hWݒ
-     * @param v WxNg
+     * @brief ワールド座標を設定
+     * @param v 座標ベクトル
      */
     void SetWorldPositionVector(DirectX::FXMVECTOR v);
 
     /**
-     * @brief [hW擾
-     * @return [hW
+     * @brief ワールド座標を取得
+     * @return ワールド座標
      */
     DirectX::XMFLOAT3 GetWorldPositionFloat3() const;
 
     /**
-     * @brief ]ݒiWAj
-     * @param v ]xNgiX, Y, Z̉]pj
+     * @brief 回転を設定（ラジアン）
+     * @param v 回転ベクトル（X, Y, Z軸周りの回転角）
      */
     void SetAngleVector(DirectX::FXMVECTOR v);
 
     /**
-     * @brief ]ݒiWAj
-     * @param angle ]piX, Y, Z̉]pj
+     * @brief 回転を設定（ラジアン）
+     * @param angle 回転角（X, Y, Z軸周りの回転角）
      */
     void SetAngle(const DirectX::XMFLOAT3& angle);
 
     /**
-     * @brief ]ݒiWAj
-     * @param x X̉]p
-     * @param y Ỷ]p
-     * @param z Z̉]p
+     * @brief 回転を設定（ラジアン）
+     * @param x X軸周りの回転角
+     * @param y Y軸周りの回転角
+     * @param z Z軸周りの回転角
      */
     void SetAngle(float x, float y, float z);
 
     /**
-     * @brief ]擾iWAj
-     * @return ]piX, Y, Z̉]pj
+     * @brief 回転を取得（ラジアン）
+     * @return 回転角（X, Y, Z軸周りの回転角）
      */
     const DirectX::XMFLOAT3& GetAngle() const { return angle_; }
 
     /**
-     * @brief ]ݒix@j
-     * @param deg ]pixj
+     * @brief 回転を設定（度数法）
+     * @param deg 回転角（度）
      */
     void SetAngleDegree(const DirectX::XMFLOAT3& deg);
 
     /**
-     * @brief ]ݒix@j
-     * @param x X̉]pixj
-     * @param y Ỷ]pixj
-     * @param z Z̉]pixj
+     * @brief 回転を設定（度数法）
+     * @param x X軸周りの回転角（度）
+     * @param y Y軸周りの回転角（度）
+     * @param z Z軸周りの回転角（度）
      */
     void SetAngleDegree(float x, float y, float z);
 
     /**
-     * @brief ]擾ix@j
-     * @return ]pixj
+     * @brief 回転を取得（度数法）
+     * @return 回転角（度）
      */
     DirectX::XMFLOAT3 GetAngleDegree() const;
 
     /**
-     * @brief XP[ݒ
-     * @param v XP[xNg
+     * @brief スケールを設定
+     * @param v スケールベクトル
      */
     void SetScaleVector(DirectX::FXMVECTOR v);
 
     /**
-     * @brief XP[ݒ
-     * @param scale XP[
+     * @brief スケールを設定
+     * @param scale スケール
      */
     void SetScale(const DirectX::XMFLOAT3& scale) { scale_ = scale; UpdateTransform(); }
 
     /**
-     * @brief XP[ݒ
-     * @param x XXP[
-     * @param y YXP[
-     * @param z ZXP[
+     * @brief スケールを設定
+     * @param x Xスケール
+     * @param y Yスケール
+     * @param z Zスケール
      */
     void SetScale(float x, float y, float z) { scale_ = { x, y, z }; UpdateTransform(); }
 
     /**
-     * @brief XP[擾
-     * @return XP[
+     * @brief スケールを取得
+     * @return スケール
      */
     const DirectX::XMFLOAT3& GetScale() const { return scale_; }
 
     // ========================================
-    // ړE]
+    // 移動・回転操作
     // ========================================
 
     /**
-     * @brief IuWFNgړ
-     * @param offset ړ
+     * @brief オブジェクトを移動
+     * @param offset 移動量
      */
     void Move(const DirectX::XMFLOAT3& offset);
 
     /**
-     * @brief IuWFNgړ
-     * @param x Ẍړ
-     * @param y Ÿړ
-     * @param z Z̈ړ
+     * @brief オブジェクトを移動
+     * @param x X方向の移動量
+     * @param y Y方向の移動量
+     * @param z Z方向の移動量
      */
     void Move(float x, float y, float z);
 
     /**
-     * @brief IuWFNgړ
-     * @param v ړʃxNg
+     * @brief オブジェクトを移動
+     * @param v 移動量ベクトル
      */
     void MoveVector(DirectX::FXMVECTOR v);
 
     /**
-     * @brief OɈړ
-     * @param distance ړ
+     * @brief 前方に移動
+     * @param distance 移動距離
      */
     void MoveForward(float distance);
 
     /**
-     * @brief EɈړ
-     * @param distance ړ
+     * @brief 右方向に移動
+     * @param distance 移動距離
      */
     void MoveRight(float distance);
 
     /**
-     * @brief Ɉړ
-     * @param distance ړ
+     * @brief 上方向に移動
+     * @param distance 移動距離
      */
     void MoveUp(float distance);
 
     /**
-     * @brief ]ZiWAj
-     * @param delta ]
+     * @brief 回転を加算（ラジアン）
+     * @param delta 回転量
      */
     void Rotate(const DirectX::XMFLOAT3& delta);
 
     /**
-     * @brief ]ZiWAj
-     * @param x X̉]
-     * @param y Ỷ]
-     * @param z Z̉]
+     * @brief 回転を加算（ラジアン）
+     * @param x X軸周りの回転量
+     * @param y Y軸周りの回転量
+     * @param z Z軸周りの回転量
      */
     void Rotate(float x, float y, float z);
 
     /**
-     * @brief ]Zix@j
-     * @param x X̉]ʁixj
-     * @param y Ỷ]ʁixj
-     * @param z Z̉]ʁixj
+     * @brief 回転を加算（度数法）
+     * @param x X軸周りの回転量（度）
+     * @param y Y軸周りの回転量（度）
+     * @param z Z軸周りの回転量（度）
      */
     void RotateDegree(float x, float y, float z);
 
     /**
-     * @brief w肵ʒu
-     * @param target ^[Qbgʒu
+     * @brief 指定した位置を向く
+     * @param target ターゲット位置
      */
     void LookAt(const DirectX::XMFLOAT3& target);
 
     /**
-     * @brief w肵ʒu
-     * @param target ^[QbgʒuiXMVECTORj
+     * @brief 指定した位置を向く
+     * @param target ターゲット位置（XMVECTOR）
      */
     void LookAtVector(DirectX::FXMVECTOR target);
 
     // ========================================
-    // xNg
+    // 方向ベクトル
     // ========================================
 
     /**
-     * @brief OxNg擾
-     * @return OxNgiKς݁j
+     * @brief 前方ベクトルを取得
+     * @return 前方ベクトル（正規化済み）
      */
     DirectX::XMVECTOR GetForwardVector() const;
 
     /**
-     * @brief ExNg擾
-     * @return ExNgiKς݁j
+     * @brief 右方向ベクトルを取得
+     * @return 右方向ベクトル（正規化済み）
      */
     DirectX::XMVECTOR GetRightVector() const;
 
     /**
-     * @brief xNg擾
-     * @return xNgiKς݁j
+     * @brief 上方向ベクトルを取得
+     * @return 上方向ベクトル（正規化済み）
      */
     DirectX::XMVECTOR GetUpVector() const;
 
     /**
-     * @brief OxNg擾iXMFLOAT3Łj
-     * @return OxNgiKς݁j
+     * @brief 前方ベクトルを取得（XMFLOAT3版）
+     * @return 前方ベクトル（正規化済み）
      */
     DirectX::XMFLOAT3 GetForwardFloat3() const;
 
     /**
-     * @brief ExNg擾iXMFLOAT3Łj
-     * @return ExNgiKς݁j
+     * @brief 右方向ベクトルを取得（XMFLOAT3版）
+     * @return 右方向ベクトル（正規化済み）
      */
     DirectX::XMFLOAT3 GetRightFloat3() const;
 
     /**
-     * @brief xNg擾iXMFLOAT3Łj
-     * @return xNgiKς݁j
+     * @brief 上方向ベクトルを取得（XMFLOAT3版）
+     * @return 上方向ベクトル（正規化済み）
      */
     DirectX::XMFLOAT3 GetUpFloat3() const;
 
     // ========================================
-    // x
+    // 速度
     // ========================================
 
     /**
-     * @brief xݒ
-     * @param v xxNg
+     * @brief 速度を設定
+     * @param v 速度ベクトル
      */
     void SetVelocityVector(DirectX::FXMVECTOR v);
 
     /**
-     * @brief xݒ
-     * @param vel x
+     * @brief 速度を設定
+     * @param vel 速度
      */
     void SetVelocity(const DirectX::XMFLOAT3& vel) { velocity_ = vel; }
 
     /**
-     * @brief xݒ
-     * @param x X̑x
-     * @param y Y̑x
-     * @param z Z̑x
+     * @brief 速度を設定
+     * @param x X方向の速度
+     * @param y Y方向の速度
+     * @param z Z方向の速度
      */
     void SetVelocity(float x, float y, float z) { velocity_ = { x, y, z }; }
 
     /**
-     * @brief x擾
-     * @return x
+     * @brief 速度を取得
+     * @return 速度
      */
     const DirectX::XMFLOAT3& GetVelocityFloat3() const { return velocity_; }
 
     /**
-     * @brief xZ
-     * @param vel Z鑬x
+     * @brief 速度を加算
+     * @param vel 加算する速度
      */
     void AddVelocity(const DirectX::XMFLOAT3& vel);
 
     /**
-     * @brief xZ
-     * @param x X̑x
-     * @param y Y̑x
-     * @param z Z̑x
+     * @brief 速度を加算
+     * @param x X方向の速度
+     * @param y Y方向の速度
+     * @param z Z方向の速度
      */
     void AddVelocity(float x, float y, float z);
 
     /**
-     * @brief xZ
-     * @param v Z鑬xxNg
+     * @brief 速度を加算
+     * @param v 加算する速度ベクトル
      */
     void AddVelocityVector(DirectX::FXMVECTOR v);
 
     /**
-     * @brief ړ~ix0ɂj
+     * @brief 移動を停止（速度を0にする）
      */
     void StopMovement();
 
     /**
-     * @brief x̑傫擾
-     * @return x̑傫
+     * @brief 速度の大きさを取得
+     * @return 速度の大きさ
      */
     float GetSpeed() const;
 
     /**
-     * @brief x̑傫ݒi͕ێj
-     * @param speed x̑傫
+     * @brief 速度の大きさを設定（方向は保持）
+     * @param speed 速度の大きさ
      */
     void SetSpeed(float speed);
 
     // ========================================
-    // EvZ
+    // 距離・方向計算
     // ========================================
 
     /**
-     * @brief ̃IuWFNgƂ̋擾
-     * @param other ΏۃIuWFNg
-     * @return 
+     * @brief 他のオブジェクトとの距離を取得
+     * @param other 対象オブジェクト
+     * @return 距離
      */
     float GetDistanceTo(const GameObject* other) const;
 
     /**
-     * @brief w肵_Ƃ̋擾
-     * @param point Ώۂ̓_
-     * @return 
+     * @brief 指定した点との距離を取得
+     * @param point 対象の点
+     * @return 距離
      */
     float GetDistanceTo(const DirectX::XMFLOAT3& point) const;
 
     /**
-     * @brief ̃IuWFNgƂ̋̓擾
-     * @param other ΏۃIuWFNg
-     * @return ̓
-     * @note ̌vZȗł邽ߍ
+     * @brief 他のオブジェクトとの距離の二乗を取得
+     * @param other 対象オブジェクト
+     * @return 距離の二乗
+     * @note 平方根の計算を省略できるため高速
      */
     float GetDistanceSquaredTo(const GameObject* other) const;
 
     /**
-     * @brief ̃IuWFNgւ̕xNg擾
-     * @param other ΏۃIuWFNg
-     * @return xNgiKς݁j
+     * @brief 他のオブジェクトへの方向ベクトルを取得
+     * @param other 対象オブジェクト
+     * @return 方向ベクトル（正規化済み）
      */
     DirectX::XMVECTOR GetDirectionTo(const GameObject* other) const;
 
     /**
-     * @brief w肵_ւ̕xNg擾
-     * @param point Ώۂ̓_
-     * @return xNgiKς݁j
+     * @brief 指定した点への方向ベクトルを取得
+     * @param point 対象の点
+     * @return 方向ベクトル（正規化済み）
      */
     DirectX::XMVECTOR GetDirectionTo(const DirectX::XMFLOAT3& point) const;
 
     /**
-     * @brief ̃IuWFNg͈͓ɂ邩
-     * @param other ΏۃIuWFNg
-     * @param range ͈
-     * @return ͈͓Ȃtrue
+     * @brief 他のオブジェクトが範囲内にあるか判定
+     * @param other 対象オブジェクト
+     * @param range 判定範囲
+     * @return 範囲内ならtrue
      */
     bool IsInRange(const GameObject* other, float range) const;
 
     // ========================================
-    // gXtH[
+    // トランスフォーム
     // ========================================
 
     /**
-     * @brief [hϊs擾
-     * @return [hϊs
+     * @brief ワールド変換行列を取得
+     * @return ワールド変換行列
      */
     DirectX::XMFLOAT4X4 GetWorldTransformFloat4X4() const;
 
     /**
-     * @brief [hϊs擾iXMMATRIXŁj
-     * @return [hϊs
+     * @brief ワールド変換行列を取得（XMMATRIX版）
+     * @return ワールド変換行列
      */
     DirectX::XMMATRIX GetWorldTransformMatrix() const;
 
     /**
-     * @brief ϊsݒ
-     * @param transform ϊs
+     * @brief 変換行列を設定
+     * @param transform 変換行列
      */
     void SetTransform(const DirectX::XMFLOAT4X4& transform);
 
     /**
-     * @brief [Jϊs擾
-     * @return [Jϊs
+     * @brief ローカル変換行列を取得
+     * @return ローカル変換行列
      */
     const DirectX::XMFLOAT4X4& GetTransform() const { return transform_; }
 
     // ========================================
-    // f
+    // モデル
     // ========================================
 
     /**
-     * @brief fݒ
-     * @param filepath ft@C̃pX
+     * @brief モデルを設定
+     * @param filepath モデルファイルのパス
      */
     void SetModel(const char* filepath);
 
     /**
-     * @brief fݒ
-     * @param model f̋L|C^
+     * @brief モデルを設定
+     * @param model モデルの共有ポインタ
      */
     void SetModel(const std::shared_ptr<Model>& model);
 
     /**
-     * @brief f擾
-     * @return f̋L|C^
+     * @brief モデルを取得
+     * @return モデルの共有ポインタ
      */
     std::shared_ptr<Model> GetModel() const { return model_; }
 
     // ========================================
-    // RC_[
+    // コライダー
     // ========================================
 
     /**
-     * @brief RC_[ǉ
-     * @tparam T RC_[̌^iCollider̔hNXj
-     * @tparam Args RXgN^̌^
-     * @param args RXgN^ɓn
-     * @return ǉꂽRC_[
+     * @brief コライダーを追加
+     * @tparam T コライダーの型（Colliderの派生クラス）
+     * @tparam Args コンストラクタ引数の型
+     * @param args コンストラクタに渡す引数
+     * @return 追加されたコライダー
      */
     template<typename T, typename... Args>
     T* AddCollider(Args&&... args) {
@@ -608,9 +643,9 @@ public:
     }
 
     /**
-     * @brief Sphere RC_[ǉ
-     * @param radius ̔a
-     * @return ǉꂽ SphereCollider
+     * @brief Sphere コライダーを追加
+     * @param radius 球の半径
+     * @return 追加された SphereCollider
      */
     SphereCollider* AddSphereCollider(float radius = 1.0f) {
         SphereCollider* collider = new SphereCollider(radius);
@@ -620,9 +655,9 @@ public:
     }
 
     /**
-     * @brief Box RC_[ǉiTCYwj
-     * @param size {bNX̃TCYix, y, zj
-     * @return ǉꂽ BoxCollider
+     * @brief Box コライダーを追加（サイズ指定）
+     * @param size ボックスのサイズ（x, y, z）
+     * @return 追加された BoxCollider
      */
     BoxCollider* AddBoxCollider(const DirectX::XMFLOAT3& size) {
         BoxCollider* collider = new BoxCollider(size);
@@ -632,20 +667,20 @@ public:
     }
 
     /**
-     * @brief Box RC_[ǉiewj
-     * @param x X TCY
-     * @param y Y TCY
-     * @param z Z TCY
-     * @return ǉꂽ BoxCollider
+     * @brief Box コライダーを追加（各軸指定）
+     * @param x X サイズ
+     * @param y Y サイズ
+     * @param z Z サイズ
+     * @return 追加された BoxCollider
      */
     BoxCollider* AddBoxCollider(float x, float y, float z) {
         return AddBoxCollider(DirectX::XMFLOAT3(x, y, z));
     }
 
     /**
-     * @brief AABB RC_[ǉiTCYwj
-     * @param size AABB ̃TCYix, y, zj
-     * @return ǉꂽ AABBCollider
+     * @brief AABB コライダーを追加（サイズ指定）
+     * @param size AABB のサイズ（x, y, z）
+     * @return 追加された AABBCollider
      */
     AABBCollider* AddAABBCollider(const DirectX::XMFLOAT3& size) {
         AABBCollider* collider = new AABBCollider(size);
@@ -655,21 +690,21 @@ public:
     }
 
     /**
-     * @brief AABB RC_[ǉiewj
-     * @param x X TCY
-     * @param y Y TCY
-     * @param z Z TCY
-     * @return ǉꂽ AABBCollider
+     * @brief AABB コライダーを追加（各軸指定）
+     * @param x X サイズ
+     * @param y Y サイズ
+     * @param z Z サイズ
+     * @return 追加された AABBCollider
      */
     AABBCollider* AddAABBCollider(float x, float y, float z) {
         return AddAABBCollider(DirectX::XMFLOAT3(x, y, z));
     }
 
     /**
-     * @brief Cylinder RC_[ǉ
-     * @param radius JvZ̔a
-     * @param height JvZ̍
-     * @return ǉꂽ CylinderCollider
+     * @brief Cylinder コライダーを追加
+     * @param radius カプセルの半径
+     * @param height カプセルの高さ
+     * @return 追加された CylinderCollider
      */
     CylinderCollider* AddCylinderCollider(float radius = 0.5f, float height = 2.0f) {
         CylinderCollider* collider = new CylinderCollider(radius, height);
@@ -679,34 +714,34 @@ public:
     }
 
     /**
-     * @brief RC_[폜
-     * @param collider 폜RC_[
+     * @brief コライダーを削除
+     * @param collider 削除するコライダー
      */
     void RemoveCollider(Collider* collider);
 
     /**
-     * @brief ׂẴRC_[폜
+     * @brief すべてのコライダーを削除
      */
     void RemoveAllColliders();
 
     /**
-     * @brief RC_[̃Xg擾
-     * @return RC_[̃Xg
+     * @brief コライダーのリストを取得
+     * @return コライダーのリスト
      */
-    const std::vector<Collider*>& GetColliders() const { return colliders_; }
+    const ColliderList& GetColliders() const { return colliders_; }
 
     /**
-     * @brief w肵CfbNX̃RC_[擾
-     * @param index CfbNX
-     * @return RC_[i݂Ȃꍇnullptrj
+     * @brief 指定したインデックスのコライダーを取得
+     * @param index インデックス
+     * @return コライダー（存在しない場合はnullptr）
      */
     Collider* GetCollider(size_t index = 0) const {
         return index < colliders_.size() ? colliders_[index] : nullptr;
     }
 
     /**
-     * @brief RC_[̐擾
-     * @return RC_[̐
+     * @brief コライダーの数を取得
+     * @return コライダーの数
      */
     size_t GetColliderCount() const { return colliders_.size(); }
 
@@ -715,112 +750,159 @@ public:
     virtual void OnCollisionExit(GameObject* other) {}
 
     // ========================================
-    // Wbh{fB
+    // リジッドボディ
     // ========================================
 
     /**
-     * @brief Wbh{fBǉ
-     * @return ǉꂽWbh{fB
+     * @brief リジッドボディを追加
+     * @return 追加されたリジッドボディ
      */
     Rigidbody* AddRigidbody();
 
     /**
-     * @brief Wbh{fBݒ
-     * @param rigidbody Wbh{fB
+     * @brief リジッドボディを設定
+     * @param rigidbody リジッドボディ
      */
     void SetRigidbody(Rigidbody* rigidbody);
 
     /**
-     * @brief Wbh{fB擾
-     * @return Wbh{fBiȂnullptrj
+     * @brief リジッドボディを取得
+     * @return リジッドボディ（なければnullptr）
      */
     Rigidbody* GetRigidbody() const { return rigidbody_; }
 
     /**
-     * @brief Wbh{fB폜
+     * @brief リジッドボディを削除
      */
     void RemoveRigidbody();
 
     // ========================================
-    // ANeBu
+    // アクティブ状態
     // ========================================
 
     /**
-     * @brief ANeBuԂ擾
-     * @return ANeBuȂtrue
+     * @brief アクティブ状態を取得
+     * @return アクティブならtrue
      */
     bool IsActive() const { return active_; }
 
     /**
-     * @brief ANeBuԂݒ
-     * @param active ANeBu
+     * @brief アクティブ状態を設定
+     * @param active アクティブ状態
+     *
+     * World に登録されたオブジェクトは、非アクティブのままフレームの終わりを迎えると破棄される。
      */
-    void SetActive(bool active) { active_ = active; }
+    void SetActive(bool active);
 
     /**
-     * @brief Kw܂߂ANeBuԂ擾
-     * @return gƐeSăANeBuȂtrue
+     * @brief 階層を含めたアクティブ状態を取得
+     * @return 自身と親が全てアクティブならtrue
      */
     bool IsActiveInHierarchy() const;
 
     DirectX::XMVECTOR GetWorldPositionVector() const;
 
     /**
-     * @brief IuWFNgj
+     * @brief オブジェクトを破棄
      */
     void Destroy();
 
     // ========================================
-    // ̑
+    // その他
     // ========================================
 
     /**
-     * @brief oߎԂ擾
-     * @return oߎԁibj
+     * @brief 経過時間を取得
+     * @return 経過時間（秒）
      */
     float GetElapsedTime() const { return elapsed_time_; }
 
     /**
-     * @brief Kw^Cv擾
-     * @return Kw^Cv
+     * @brief 階層タイプを取得
+     * @return 階層タイプ
      */
     HierarchyType GetHierarchyType() const { return hierarchy_type_; }
 
+    /**
+     * @brief TransformStorage 上のスロット番号を取得
+     * @return スロット番号
+     */
+    uint32_t GetTransformSlot() const { return transform_slot_; }
+
+    /**
+     * @brief 登録先の World 上のハンドルを取得
+     * @return ハンドル（未登録なら無効）
+     */
+    GameObjectHandle GetHandle() const { return handle_; }
+
+    /**
+     * @brief 登録先の World を取得
+     * @return World（未登録ならnullptr）
+     */
+    World* GetWorld() const { return world_; }
+
+    /**
+     * @brief 描画に使うモデルの詳細度を取得
+     * @return LOD番号（World::Render() が画面サイズから毎フレーム選ぶ。0が最も細かい）
+     */
+    int GetLodLevel() const { return lod_level_; }
+
 	template<typename... Args>
     inline void Log(Args&&... args) const {
         ImGuiLogger::Instance().AddLog(std::forward<Args>(args)...);
     }
 
+private:
+    /**
+     * @brief コライダーの外接球を無効化（次の PropagateTransforms() まで常に重なり判定に回す）
+     * @param recursive trueで子孫も無効化
+     */
+    void InvalidateBounds(bool recursive);
+
+    /**
+     * @brief 登録先の World でハンドルを解決
+     * @param handle 親や子のハンドル
+     * @return GameObject* オブジェクト（未登録、または破棄済みならnullptr）
+     */
+    GameObject* ResolveInWorld(const GameObjectHandle& handle) const;
+
+    uint32_t transform_slot_ = TransformStorage::Instance().Allocate();  ///< TransformStorage 上のスロット
+
 protected:
-    // gXtH[
-    DirectX::XMFLOAT3 position_ = { 0.0f, 0.0f, 0.0f };  ///< [JW
-    DirectX::XMFLOAT3 angle_ = { 0.0f, 0.0f, 0.0f };      ///< ]piWAj
-    DirectX::XMFLOAT3 scale_ = { 1.0f, 1.0f, 1.0f };      ///< XP[
-    DirectX::XMFLOAT4X4 transform_ = {                     ///< [Jϊs
-        1, 0, 0, 0,
-        0, 1, 0, 0,
-        0, 0, 1, 0,
-        0, 0, 0, 1
-    };
-
-    // 
-    DirectX::XMFLOAT3 velocity_ = { 0.0f, 0.0f, 0.0f };   ///< x
-
-    // R|[lg
-    std::vector<Collider*> colliders_;  ///< RC_[̃Xg
-    Rigidbody* rigidbody_ = nullptr;    ///< Wbh{fB
-
-    // f
-    std::shared_ptr<Model> model_;  ///< 3Df
-
-    // Kw\
-    GameObject* parent_ = nullptr;              ///< eIuWFNg
-    std::vector<GameObject*> children_;         ///< qIuWFNg̃Xg
-    HierarchyType hierarchy_type_ = HierarchyType::kNone;  ///< Kw^Cv
-
-    // 
-    bool active_ = true;          ///< ANeBu
-    float elapsed_time_ = 0.0f;   ///< oߎ
+    // トランスフォーム（毎フレーム走査する値は TransformStorage の連続配列に置き、ここでは参照する）
+    DirectX::XMFLOAT3& position_ = TransformStorage::Instance().Position(transform_slot_);  ///< ローカル座標
+    DirectX::XMFLOAT3& angle_ = TransformStorage::Instance().Angle(transform_slot_);        ///< 回転角（ラジアン）
+    DirectX::XMFLOAT3& scale_ = TransformStorage::Instance().Scale(transform_slot_);        ///< スケール
+    DirectX::XMFLOAT4X4& transform_ = TransformStorage::Instance().LocalTransform(transform_slot_);  ///< ローカル変換行列
+
+    // 物理
+    DirectX::XMFLOAT3& velocity_ = TransformStorage::Instance().Velocity(transform_slot_);  ///< 速度
+
+    // コンポーネント
+    ColliderList colliders_;  ///< コライダーのリスト
+    Rigidbody* rigidbody_ = nullptr;    ///< リジッドボディ
+
+    // モデル
+    std::shared_ptr<Model> model_;  ///< 3Dモデル
+
+    // 階層構造
+    GameObjectHandle parent_;                   ///< 親オブジェクト
+    ChildList children_;                        ///< 子オブジェクトのリスト
+    HierarchyType hierarchy_type_ = HierarchyType::kNone;  ///< 階層タイプ
+
+    // 状態
+    bool active_ = true;          ///< アクティブ状態
+    float& elapsed_time_ = TransformStorage::Instance().ElapsedTime(transform_slot_);  ///< 経過時間
+    bool parallel_update_ = false; ///< Update() を並列に実行してよいか
+
+private:
+    friend class World;
+
+    World* world_ = nullptr;   ///< 登録先の World
+    GameObjectHandle handle_;  ///< 登録先の World 上のハンドル
+    int lod_level_ = 0;        ///< 描画に使うモデルの詳細度
+    bool occlusion_visible_ = true; ///< 届いている最新の遮蔽判定で見えていたか（World::Render() が更新する）
+    uint32_t occlusion_reset_frame_ = 0; ///< 最後に画面外だった World の描画回数（それ以前に予約した GPU の判定結果は使わない）
 };
 
 #endif  // GAME_OBJECT_H_
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef GAME_OBJECT_HANDLE_H_
+#define GAME_OBJECT_HANDLE_H_
+
+#include <cstdint>
+
+/**
+ * @struct GameObjectHandle
+ * @brief World に登録されたゲームオブジェクトへの世代付き参照
+ *
+ * World の識別子、管理表の番号、世代番号の組です。オブジェクトが破棄されると管理表の世代が進むので、
+ * 古いハンドルを World::Resolve() に渡すと nullptr が返ります。
+ * 別の World のハンドルを渡した場合も nullptr を返します(デバッグビルドではアサートします)。
+ */
+struct GameObjectHandle {
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX; ///< 無効な番号
+
+    uint32_t index = kInvalidIndex; ///< World の管理表の番号
+    uint32_t generation = 0;        ///< 登録時の世代番号
+    uint16_t world_id = 0;          ///< 登録先の World(0 は未登録)
+
+    /**
+     * @brief 何かを指しているか（参照先が生きているかは World::Resolve() で確認する）
+     * @return bool 番号が有効ならtrue
+     */
+    bool IsSet() const { return index != kInvalidIndex; }
+
+    bool operator==(const GameObjectHandle& other) const {
+        return index == other.index && generation == other.generation && world_id == other.world_id;
+    }
+    bool operator!=(const GameObjectHandle& other) const { return !(*this == other); }
+};
+
+#endif  // GAME_OBJECT_HANDLE_H_
@@ -3,7 +3,7 @@
 #include <cstring>
 #include <string>
 #include <vector>
-#include <cstdarg>  // va_listp
+#include <cstdarg>  // va_list用
 
 class ImGuiLogger {
 public:
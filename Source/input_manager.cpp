@@ -16,7 +16,7 @@ void InputManager::UpdateCursorPosition() {
     GetCursorPos(&cursor);
     ScreenToClient(window_handle_, &cursor);
 
-    // J[\̒S_Ƃ
+    // カーソルの中心を基準点とする
     constexpr float kCursorHalfSize = 5.0f;
     cursor_position_.x = static_cast<float>(cursor.x) - kCursorHalfSize;
     cursor_position_.y = static_cast<float>(cursor.y) - kCursorHalfSize;
@@ -111,7 +111,7 @@ InputManager::KeyState& InputManager::GetOrCreateKeyState(int virtual_key) {
     if (it != key_states_.end()) {
         return it->second;
     }
-    // VL[o^
+    // 新しいキーを登録
     key_states_[virtual_key] = KeyState{};
     return key_states_[virtual_key];
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include <Windows.h>
 #include <unordered_map>
 
-// ͏ꌳǗNX
+// 入力処理を一元管理するクラス
 class InputManager {
 public:
     static InputManager& Instance() {
@@ -13,18 +13,18 @@ public:
 
     void Update();
 
-    // }EXʒu擾iXN[Wj
+    // マウス位置取得（スクリーン座標）
     DirectX::XMFLOAT2 GetCursorPosition() const { return cursor_position_; }
 
-    // }EX{^̏
-    bool IsMouseButtonDown(int button) const;  // ꂽu
-    bool IsMouseButtonUp(int button) const;    // ꂽu
-    bool IsMouseButtonHeld(int button) const;  // ꑱĂ
+    // マウスボタンの状態
+    bool IsMouseButtonDown(int button) const;  // 押された瞬間
+    bool IsMouseButtonUp(int button) const;    // 離された瞬間
+    bool IsMouseButtonHeld(int button) const;  // 押され続けている
 
-    // L[{[h̏
-    bool IsKeyDown(int virtual_key);   // ꂽu
-    bool IsKeyUp(int virtual_key);     // ꂽu
-    bool IsKeyHeld(int virtual_key);   // ꑱĂ
+    // キーボードの状態
+    bool IsKeyDown(int virtual_key);   // 押された瞬間
+    bool IsKeyUp(int virtual_key);     // 離された瞬間
+    bool IsKeyHeld(int virtual_key);   // 押され続けている
 
     void SetWindowHandle(HWND hwnd) { window_handle_ = hwnd; }
 
@@ -35,9 +35,9 @@ private:
     InputManager& operator=(const InputManager&) = delete;
 
     struct KeyState {
-        bool down = false;  // ꂽu
-        bool up = false;    // ꂽu
-        bool held = false;  // ꑱĂ
+        bool down = false;  // 押された瞬間
+        bool up = false;    // 離された瞬間
+        bool held = false;  // 押され続けている
     };
 
     static constexpr int kMaxMouseButtons = 3;
@@ -46,7 +46,7 @@ private:
 
     std::unordered_map<int, KeyState> key_states_;
 
-    // }EX{^i0:Left, 1:Right, 2:Middlej
+    // マウスボタン（0:Left, 1:Right, 2:Middle）
     KeyState mouse_buttons_[kMaxMouseButtons];
 
     HWND window_handle_ = nullptr;
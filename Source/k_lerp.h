@@ -7,7 +7,7 @@
 #include <DirectXMath.h>
 #include <algorithm>
 
-// C[WO֐̎
+// イージング関数の種類
 enum class EaseType {
     Linear,
     EaseInQuad,
@@ -28,7 +28,7 @@ enum class EaseType {
     EaseOutBounce
 };
 
-// C[WO֐̎
+// イージング関数の実装
 class Easing {
 public:
     static float Apply(EaseType type, float t) {
@@ -102,7 +102,7 @@ public:
     }
 };
 
-// TweenNX
+// 基底Tweenクラス
 class Tween {
 public:
     Tween(float duration, EaseType ease = EaseType::Linear)
@@ -212,7 +212,7 @@ protected:
     std::function<void()> on_complete_;
 };
 
-// floatlpTween
+// float値用のTween
 class FloatTween : public Tween {
 public:
     FloatTween(float* target, float start, float end, float duration, EaseType ease = EaseType::Linear)
@@ -230,7 +230,7 @@ private:
     float end_;
 };
 
-// XMFLOAT3pTween
+// XMFLOAT3用のTween
 class Float3Tween : public Tween {
 public:
     Float3Tween(DirectX::XMFLOAT3* target, const DirectX::XMFLOAT3& start, const DirectX::XMFLOAT3& end,
@@ -251,7 +251,7 @@ private:
     DirectX::XMFLOAT3 end_;
 };
 
-// J[pTween
+// カラー用のTween
 class Float4Tween : public Tween {
 public:
     Float4Tween(DirectX::XMFLOAT4* target, const DirectX::XMFLOAT4& start, const DirectX::XMFLOAT4& end,
@@ -273,7 +273,7 @@ private:
     DirectX::XMFLOAT4 end_;
 };
 
-// Tween}l[W[
+// Tweenマネージャー
 class TweenManager {
 public:
     static TweenManager& Instance() {
@@ -2,7 +2,7 @@
 #include <stdlib.h>
 #include <random>
 
-//w͈͂̃_lvZ
+//指定範囲のランダム値を計算する
 float MathUtils::RandomRangeFloat(float min, float max)
 {
 	std::random_device dc;
@@ -1,11 +1,11 @@
 #pragma once
 
-//Zp
+//浮動小数算術
 class MathUtils
 {
 public:
-	//w͈̔͂̃_lvZ
+	//指定の範囲のランダム値を計算する
 	static float RandomRangeFloat(float min, float max);
-	//w͈̔͂̃_lvZ
+	//指定の範囲のランダム値を計算する
 	static int RandomRangeInt(int min, int max);
 };
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "object_pool.h"
+#include <new>
+#include "System/Misc.h"
+
+ObjectPool& ObjectPool::Instance() {
+    static ObjectPool instance;
+    return instance;
+}
+
+ObjectPool::~ObjectPool() {
+    for (Pool& pool : pools_) {
+        for (void* slab : pool.slabs) {
+            ::operator delete(slab);
+        }
+    }
+}
+
+void* ObjectPool::Allocate(size_t size) {
+    const size_t size_class = (size + kSlotAlignment - 1) / kSlotAlignment;
+    SlotHeader* header = nullptr;
+
+    if (size_class == 0 || size_class > kSizeClassCount) {
+        // 大きいオブジェクトは通常のヒープから確保する
+        header = static_cast<SlotHeader*>(::operator new(sizeof(SlotHeader) + size));
+        header->state = kSlotLive;
+        header->size_class = static_cast<uint32_t>(kSizeClassCount);
+        heap_allocation_count_.fetch_add(1, std::memory_order_relaxed);
+        return header + 1;
+    }
+
+    Pool& pool = pools_[size_class - 1];
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.free_list) {
+            // スラブを1つ確保して、全スロットを空きリストにつなぐ
+            const size_t stride = sizeof(SlotHeader) + size_class * kSlotAlignment;
+            uint8_t* slab = static_cast<uint8_t*>(::operator new(stride * kSlotsPerSlab));
+            pool.slabs.push_back(slab);
+            heap_allocation_count_.fetch_add(1, std::memory_order_relaxed);
+
+            for (size_t i = kSlotsPerSlab; i > 0; --i) {
+                SlotHeader* slot = reinterpret_cast<SlotHeader*>(slab + stride * (i - 1));
+                slot->state = kSlotFree;
+                slot->size_class = static_cast<uint32_t>(size_class - 1);
+                FreeSlot* free_slot = reinterpret_cast<FreeSlot*>(slot + 1);
+                free_slot->next = pool.free_list;
+                pool.free_list = free_slot;
+            }
+        }
+
+        FreeSlot* free_slot = pool.free_list;
+        pool.free_list = free_slot->next;
+        ++pool.live_count;
+        header = GetHeader(free_slot);
+        _ASSERT_EXPR(header->state == kSlotFree, L"ObjectPool: free list corrupted");
+        header->state = kSlotLive;
+    }
+
+    pool_allocation_count_.fetch_add(1, std::memory_order_relaxed);
+    return header + 1;
+}
+
+void ObjectPool::Free(void* ptr) {
+    if (!ptr) return;
+
+    SlotHeader* header = GetHeader(ptr);
+    if (header->size_class >= kSizeClassCount) {
+        _ASSERT_EXPR(header->state == kSlotLive, L"ObjectPool: double free");
+        header->state = kSlotFree;
+        ::operator delete(header);
+        return;
+    }
+
+    Pool& pool = pools_[header->size_class];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    // スロットごとの印で判定する(使用中の数だけでは、ほかのスロットが使用中だと二重解放を見逃す)
+    _ASSERT_EXPR(header->state == kSlotLive, L"ObjectPool: double free");
+    header->state = kSlotFree;
+
+    FreeSlot* free_slot = static_cast<FreeSlot*>(ptr);
+    free_slot->next = pool.free_list;
+    pool.free_list = free_slot;
+    --pool.live_count;
+}
+
+void ObjectPool::GetStatistics(Statistics& statistics) const {
+    statistics.pools.clear();
+    statistics.pool_allocation_count = pool_allocation_count_.load(std::memory_order_relaxed);
+    statistics.heap_allocation_count = heap_allocation_count_.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < kSizeClassCount; ++i) {
+        Pool& pool = const_cast<Pool&>(pools_[i]);
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (pool.slabs.empty()) continue;
+
+        PoolStatistics& pool_statistics = statistics.pools.emplace_back();
+        pool_statistics.object_size = (i + 1) * kSlotAlignment;
+        pool_statistics.slab_count = pool.slabs.size();
+        pool_statistics.live_count = pool.live_count;
+    }
+}
+
+ObjectPool::SlotHeader* ObjectPool::GetHeader(const void* ptr) {
+    return const_cast<SlotHeader*>(static_cast<const SlotHeader*>(ptr) - 1);
+}
@@ -0,0 +1,158 @@
+#ifndef OBJECT_POOL_H_
+#define OBJECT_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class ObjectPool
+ * @brief ゲームオブジェクト、コライダー、リジッドボディ用のスラブアロケータ（シングルトン）
+ *
+ * オブジェクトのサイズごとにプールを分け、固定数のスロットをまとめたスラブ単位でヒープから確保します。
+ * 解放したスロットはプールの空きリストに戻して再利用し、スラブはヒープへ返しません。
+ * kMaxPooledSize を超えるオブジェクトだけは通常のヒープを使います。
+ * 型ごとにサイズが異なるので、各コライダーやゲームオブジェクトの派生クラスは実質的に専用のプールを持ちます。
+ *
+ * 各スロットの先頭には使用中かどうかの印があり、二重解放や確保していないメモリの解放を検出します。
+ * 破棄済みのオブジェクトの参照には World のハンドル(GameObjectHandle)を使います。
+ */
+class ObjectPool {
+public:
+    static constexpr size_t kSlotAlignment = 16; ///< スロットの境界（XMMATRIX を持つ派生クラスに備える）
+    static constexpr size_t kMaxPooledSize = 4096; ///< これより大きいオブジェクトは通常のヒープから確保
+    static constexpr size_t kSlotsPerSlab = 64; ///< 1スラブあたりのスロット数
+
+    /**
+     * @struct PoolStatistics
+     * @brief サイズごとのプールの統計
+     */
+    struct PoolStatistics {
+        size_t object_size = 0;   ///< オブジェクトのサイズ（kSlotAlignment 単位に切り上げ）
+        size_t slab_count = 0;    ///< 確保済みのスラブ数
+        size_t live_count = 0;    ///< 使用中のスロット数
+    };
+
+    /**
+     * @struct Statistics
+     * @brief 全体の統計
+     */
+    struct Statistics {
+        uint64_t pool_allocation_count = 0; ///< プールから払い出した累計回数
+        uint64_t heap_allocation_count = 0; ///< ObjectPool がヒープから確保した累計回数（スラブと大きいオブジェクト。プロセス全体の回数は AllocationCounter）
+        std::vector<PoolStatistics> pools;  ///< 使われているプールごとの統計
+    };
+
+    /**
+     * @brief シングルトンインスタンスを取得
+     * @return ObjectPool& インスタンスへの参照
+     */
+    static ObjectPool& Instance();
+
+    /**
+     * @brief メモリを確保
+     * @param size オブジェクトのサイズ
+     * @return void* 確保したメモリ（管理情報の直後）
+     */
+    void* Allocate(size_t size);
+
+    /**
+     * @brief メモリを解放
+     * @param ptr Allocate() で確保したメモリ
+     */
+    void Free(void* ptr);
+
+    /**
+     * @brief 統計を取得
+     * @param statistics 書き込み先（pools の容量を使い回すので、毎フレーム呼んでもヒープ確保を増やさない）
+     */
+    void GetStatistics(Statistics& statistics) const;
+
+private:
+    /**
+     * @struct SlotHeader
+     * @brief スロットの先頭に置く管理情報
+     */
+    struct alignas(kSlotAlignment) SlotHeader {
+        uint32_t state;      ///< kSlotLive なら使用中、kSlotFree なら空き
+        uint32_t size_class; ///< 所属するプール（kSizeClassCount なら通常のヒープ）
+    };
+
+    static constexpr uint32_t kSlotLive = 0x4C495645; ///< 使用中のスロットの印
+    static constexpr uint32_t kSlotFree = 0x46524545; ///< 空きスロットの印
+
+    /**
+     * @struct FreeSlot
+     * @brief 空きスロットに書き込む空きリストのリンク
+     */
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    /**
+     * @struct Pool
+     * @brief 同じサイズのスロットを管理するプール
+     */
+    struct Pool {
+        std::mutex mutex;           ///< 確保と解放の排他
+        FreeSlot* free_list = nullptr; ///< 空きスロット
+        std::vector<void*> slabs;   ///< 確保済みのスラブ
+        size_t live_count = 0;      ///< 使用中のスロット数
+    };
+
+    static constexpr size_t kSizeClassCount = kMaxPooledSize / kSlotAlignment;
+
+    ObjectPool() = default;
+    ~ObjectPool();
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    static SlotHeader* GetHeader(const void* ptr);
+
+    Pool pools_[kSizeClassCount]; ///< サイズごとのプール（添字は kSlotAlignment 単位のサイズ - 1）
+    std::atomic<uint64_t> pool_allocation_count_ = 0; ///< プールから払い出した累計回数
+    std::atomic<uint64_t> heap_allocation_count_ = 0; ///< ヒープから確保した累計回数
+};
+
+/**
+ * @class PoolAllocator
+ * @brief ObjectPool から確保する標準コンテナ用のアロケータ
+ * @tparam T 要素の型
+ *
+ * ゲームオブジェクトが持つコライダーや子の一覧に使い、生成と破棄を繰り返してもヒープを使わないようにします。
+ * 伸長後の容量ごとに別のプールになるので、小さい一覧ほど効率よく再利用されます。
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(ObjectPool::Instance().Allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) {
+        ObjectPool::Instance().Free(ptr);
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+};
+
+/**
+ * @brief クラス専用の operator new / delete を ObjectPool に向ける
+ *
+ * 基底クラスに書けば派生クラスも同じ経路で確保されます（サイズが違えば別のプールになります）。
+ */
+#define OBJECT_POOL_ALLOCATION \
+    static void* operator new(size_t size) { return ObjectPool::Instance().Allocate(size); } \
+    static void operator delete(void* ptr) { ObjectPool::Instance().Free(ptr); }
+
+#endif  // OBJECT_POOL_H_
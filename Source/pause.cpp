@@ -30,7 +30,7 @@ void Pause::Initialize() {
     se_pause_back_ = Audio::Instance().LoadAudioSource("Data/Sound/Pause/SE_setting_back.wav");
     se_pause_select_ = Audio::Instance().LoadAudioSource("Data/Sound/Pause/SE_setting_select.wav");
 
-    // |[Yj[쐬iwitj
+    // ポーズメニュー作成（背景付き）
     pose_panel_ = std::make_unique<UiPanel>("./Data/Sprite/setting_default.png");
 
     pose_buttons_[0] = pose_panel_->AddButton(
@@ -42,7 +42,7 @@ void Pause::Initialize() {
         0  // action_id
     );
 
-    // zo[SEĐ
+    // ホバー時のSE再生
     pose_buttons_[0]->SetOnHoverCallback([this]() {
         if (se_pause_select_) {
             se_pause_select_->Stop();
@@ -51,7 +51,7 @@ void Pause::Initialize() {
         });
 
     pose_buttons_[0]->SetOnClickCallback([this]() {
-		ImGuiLogger::Instance().AddLog(u8"|[Yj[̐ݒ{^NbN܂B");
+		ImGuiLogger::Instance().AddLog(u8"ポーズメニューの設定ボタンがクリックされました。");
 		});
 
     pose_panel_->SetActive(false);
@@ -60,9 +60,9 @@ void Pause::Initialize() {
 void Pause::Update(float elapsedTime) {
     auto& input = InputManager::Instance();
 
-    // |[Y̐؂ւ
+    // ポーズの切り替え
     {
-        // |[YJn
+        // ポーズ開始
         if (input.IsKeyDown('P') && !on_pause_) {
             on_pause_ = true;
             is_fade_in_ = true;
@@ -72,11 +72,11 @@ void Pause::Update(float elapsedTime) {
             se_pause_->Stop();
             se_pause_->Play(false);
 
-            // JX^J[\tF[hCŕ\
+            // カスタムカーソルをフェードインで表示
             CustomCursor::Instance().FadeIn(0.3f);
-            SystemCursor::Hide();  // VXeJ[\͔\
+            SystemCursor::Hide();  // システムカーソルは非表示
         }
-        // |[Y
+        // ポーズ解除
         else if (input.IsKeyDown('P') && on_pause_) {
             is_fade_out_ = true;
             is_fade_in_ = false;
@@ -86,9 +86,9 @@ void Pause::Update(float elapsedTime) {
 
 			pose_panel_->FadeOut(0.3f);
 
-            // JX^J[\tF[hAEg
+            // カスタムカーソルをフェードアウト
             CustomCursor::Instance().FadeOut(0.3f, [this]() {
-                // tF[h̏
+                // フェード完了後の処理
                 PoseOffComplete();
                 });
         }
@@ -96,7 +96,7 @@ void Pause::Update(float elapsedTime) {
 
     if (!on_pause_) return;
 
-    // UIpl̍XV
+    // UIパネルの更新
     pose_panel_->Update();
 }
 
@@ -117,6 +117,6 @@ void Pause::PoseOffComplete() {
         settingMenu->SetActive(false);
     }
 
-    // J[\ʒɈړ
+    // カーソルを画面中央に移動
     SystemCursor::CenterCursor();
 }
\ No newline at end of file
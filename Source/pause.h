@@ -36,21 +36,21 @@ public:
         return pose;
     }
 
-    // |[YԐ
+    // ポーズ状態制御
     void SetPose(bool b) { on_pause_ = b; }
     bool IsOnPose() const { return on_pause_; }
 
-    // ݒl擾
+    // 設定値取得
     int GetSenitivity() const { return sensitivity; }
     int GetFov() const { return fov; }
     int GetShake() const { return shake; }
     int GetDrunkenness() const { return drunkenness; }
 
-    // `[gAݒ
+    // チュートリアル設定
     void SetTutorial(bool b) { tutorial = b; }
     bool IsTutorial() const { return tutorial; }
 
-    // XVE`
+    // 更新・描画
     void Update(float elapsedTime);
     void Render(ID3D11DeviceContext* dc);
 
@@ -61,27 +61,27 @@ private:
     Pause& operator=(const Pause&) = delete;
 
     void Initialize();
-    void PoseOffComplete();  // tF[h̏
+    void PoseOffComplete();  // フェード完了後の処理
 
-    // |[Y
+    // ポーズ状態
     bool on_pause_{ false };
     bool is_fade_in_{ false };
     bool is_fade_out_{ false };
     bool tutorial{ false };
 
-    // UI pl
+    // UI パネル
     std::unique_ptr<UiPanel> pose_panel_{ nullptr };
     std::unique_ptr<UiPanel> settingMenu{ nullptr };
 
-    // XvCg
+    // スプライト
     std::unique_ptr<Sprite> sprSetting{ nullptr };
 
-    // I[fBI
+    // オーディオ
     AudioSource* se_pause_{ nullptr };
     AudioSource* se_pause_back_{ nullptr };
     AudioSource* se_pause_select_{ nullptr };
 
-    // ݒl
+    // 設定値
     int sensitivity{ 0 };
     int fov{ 0 };
     int shake{ 0 };
@@ -92,15 +92,15 @@ private:
     int buttonShake{ 0 };
     int buttonDrunkenness{ 0 };
 
-    // IǗ
+    // 選択管理
     int holdNum{ -1 };
     int num{ -1 };
     int num_bank{ -1 };
 
-    // At@liKvɉāj
+    // アルファ値（必要に応じて）
     float alpha{ 0.0f };
 
-    // {^z
+    // ボタン配列
     UiButton* pose_buttons_[4]{ nullptr };
     UiButton* settingButtons[11]{ nullptr };
 };
\ No newline at end of file
@@ -1,6 +1,43 @@
 #include "rigidbody.h"
 #include "collider.h"
 #include "game_object.h"
+#include "transform_storage.h"
+
+void Rigidbody::SetOwner(GameObject* owner) {
+    owner_ = owner;
+    SyncToStorage();
+}
+
+void Rigidbody::SetEnabled(bool enabled) {
+    is_enabled_ = enabled;
+    SyncToStorage();
+}
+
+void Rigidbody::SetKinematic(bool kinematic) {
+    is_kinematic_ = kinematic;
+    SyncToStorage();
+}
+
+void Rigidbody::SetUseGravity(bool use_gravity) {
+    use_gravity_ = use_gravity;
+    SyncToStorage();
+}
+
+void Rigidbody::SetDrag(float drag) {
+    drag_ = drag;
+    SyncToStorage();
+}
+
+void Rigidbody::SyncToStorage() {
+    if (!owner_) return;
+
+    // ApplyGravity()、ApplyDrag() が何もしない条件では係数を0にしておく
+    TransformStorage& storage = TransformStorage::Instance();
+    const uint32_t slot = owner_->GetTransformSlot();
+    const bool is_dynamic = is_enabled_ && !is_kinematic_;
+    storage.GravityScale(slot) = is_dynamic && use_gravity_ ? 1.0f : 0.0f;
+    storage.Drag(slot) = is_dynamic && drag_ > 0.0f ? drag_ : 0.0f;
+}
 
 void Rigidbody::ApplyGravity(float elapsed_time, const DirectX::XMFLOAT3& gravity) {
     if (!is_enabled_ || is_kinematic_ || !use_gravity_ || !owner_) return;
@@ -41,12 +78,12 @@ void Rigidbody::ClampVelocity() {
 void Rigidbody::ResolveCollisions() {
     if (!is_enabled_ || is_kinematic_ || !owner_) return;
 
-    const std::vector<Collider*>& my_colliders = owner_->GetColliders();
+    const GameObject::ColliderList& my_colliders = owner_->GetColliders();
     if (my_colliders.empty()) return;
 
-    // Worldׂ̂ẴIuWFNgƏՓ˔
-    // ̎łWorld::DetectCollisions()Ă΂邱Ƃz
-    // ʂɑ̃IuWFNg̃RC_[Ɣ肷ꍇ͊OĂяo
+    // World内のすべてのオブジェクトと衝突判定
+    // ※この実装ではWorld::DetectCollisions()から呼ばれることを想定
+    // 個別に他のオブジェクトのコライダーと判定する場合は外部から呼び出す
 }
 
 // rigidbody.cpp
@@ -56,19 +93,19 @@ void Rigidbody::ResolveCollision(const Collider* my_collider, const Collider* ot
     DirectX::XMFLOAT3 correction;
     GameObject* other = nullptr;
 
-    // Փ˔ƕ␳xNg擾
+    // 衝突判定と補正ベクトルを取得
     if (!my_collider->CheckRigidbodyCollision(other_collider, correction, other)) return;
 
     DirectX::XMFLOAT3 my_velocity = owner_->GetVelocityFloat3();
 
-    // ʒu␳Kp
+    // 位置補正を適用
     DirectX::XMFLOAT3 current_pos = owner_->GetWorldPositionFloat3();
     owner_->SetWorldPosition(
         current_pos.x + correction.x,
         current_pos.y + correction.y,
         current_pos.z + correction.z);
 
-    // Փ˖@vZ
+    // 衝突法線を計算
     DirectX::XMVECTOR correction_vec = DirectX::XMLoadFloat3(&correction);
     float correction_length = DirectX::XMVectorGetX(DirectX::XMVector3Length(correction_vec));
 
@@ -78,42 +115,42 @@ void Rigidbody::ResolveCollision(const Collider* my_collider, const Collider* ot
     DirectX::XMFLOAT3 normal;
     DirectX::XMStoreFloat3(&normal, correction_normalized);
 
-    // @̑xvZ
+    // 法線方向の速度成分を計算
     float dot = my_velocity.x * normal.x +
         my_velocity.y * normal.y +
         my_velocity.z * normal.z;
 
-    // @ɐiłꍇ̂ݔ
+    // 法線方向に進んでいる場合のみ反射
     if (dot < 0.0f) {
-        // ˑxvZiWlj
+        // 反射速度を計算（反発係数を考慮）
         float reflection_factor = -(1.0f + bounciness_) * dot;
 
         my_velocity.x += normal.x * reflection_factor;
         my_velocity.y += normal.y * reflection_factor;
         my_velocity.z += normal.z * reflection_factor;
 
-        // CKpiڐ̑xj
+        // 摩擦を適用（接線方向の速度を減衰）
         if (friction_ > 0.0f) {
-            // ˌ̖@xČvZ
+            // 反射後の法線方向速度を再計算
             float normal_velocity = my_velocity.x * normal.x +
                 my_velocity.y * normal.y +
                 my_velocity.z * normal.z;
 
-            // ڐ̑xvZ
+            // 接線方向の速度を計算
             DirectX::XMFLOAT3 tangent_velocity = {
                 my_velocity.x - normal.x * normal_velocity,
                 my_velocity.y - normal.y * normal_velocity,
                 my_velocity.z - normal.z * normal_velocity
             };
 
-            // CWKp
+            // 摩擦係数を適用
             float friction_factor = 1.0f - friction_;
             my_velocity.x = normal.x * normal_velocity + tangent_velocity.x * friction_factor;
             my_velocity.y = normal.y * normal_velocity + tangent_velocity.y * friction_factor;
             my_velocity.z = normal.z * normal_velocity + tangent_velocity.z * friction_factor;
         }
 
-        // xᑬ0ɂi艻j
+        // 速度が低速時は0にする（安定化）
         float final_speed_sq = my_velocity.x * my_velocity.x +
             my_velocity.y * my_velocity.y +
             my_velocity.z * my_velocity.z;
@@ -125,6 +162,6 @@ void Rigidbody::ResolveCollision(const Collider* my_collider, const Collider* ot
         owner_->SetVelocity(my_velocity);
     }
 
-    // xKp
+    // 速度制限を適用
     ClampVelocity();
 }
\ No newline at end of file
@@ -6,6 +6,13 @@
 #include "scene_manager.h"
 #include "scene_title.h"
 #include "System/ModelRenderer.h"
+#include "System/TextureAtlas.h"
+#include "System/ShaderCache.h"
+#include "System/JobSystem.h"
+#include "System/RenderQueueBenchmark.h"
+#include "System/AllocationCounter.h"
+#include "System/EnvironmentLighting.h"
+#include "System/LightCuller.h"
 #include "ScoreRender.h"
 #include "pause.h"
 #include "CursorManager.h"
@@ -23,6 +30,7 @@
 #include <vault.h>
 #include "collider.h"
 #include "camera.h"
+#include "transform_storage.h"
 
 SceneGame::SceneGame()
 {
@@ -38,34 +46,38 @@ void SceneGame::Initialize()
 	world.Clear(); // ワールドを初期化 (全シーンのFinalizeで呼ぶが、一応ここでも初期化)
 
 	// プレイヤー初期化
-	player_ = world.CreateObject<Player>();// CreateObjectの引数はmodelパスだが、引数なしだとモデルなしになる。FPSなのでモデルなし
-	player_->SetPosition(2, 0, 0);
-	//player_->AddAABBCollider(1, 1, 1);
-	player_->AddCylinderCollider(0.5f, 1.0f);
-	player_->AddRigidbody();
+	Player* player = world.CreateObject<Player>();// CreateObjectの引数はmodelパスだが、引数なしだとモデルなしになる。FPSなのでモデルなし
+	player->SetPosition(2, 0, 0);
+	//player->AddAABBCollider(1, 1, 1);
+	player->AddCylinderCollider(0.5f, 1.0f);
+	player->AddRigidbody();
+	player_ = player->GetHandle();
 
 	// カメラ初期化
 	{
-		camera_controller_ = world.CreateObject<CameraController>();
-		camera_controller_->SetMode(CameraMode::kFirstPerson); // カメラの設定
-		camera_controller_->SetTarget(player_); // カメラがプレイヤーを追従する
+		CameraController* camera_controller = world.CreateObject<CameraController>();
+		camera_controller->SetMode(CameraMode::kFirstPerson); // カメラの設定
+		camera_controller->SetTarget(player); // カメラがプレイヤーを追従する
+		camera_controller_ = camera_controller->GetHandle();
 
-		player_->SetCameraController(camera_controller_); // プレイヤーが視点によaって移動方向を決めるのでSetが必要
+		player->SetCameraController(camera_controller); // プレイヤーが視点によaって移動方向を決めるのでSetが必要
 	}
 
 	sky_map_ = std::make_unique<sky_map>(dv, L"Data/SkyMapSprite/game_background3.hdr");
+	environment_ = std::make_unique<EnvironmentLighting>(dv, "Data/SkyMapSprite/game_background3.hdr"); // スカイマップと同じ画像から環境光を焼き込む
 
 	world.CreateObject("Data/Model/Temporary_wall.glb", { 9, 0, 2 });
 
 	// 車オブジェクト
-	obj_ = world.CreateObject<Vault>("Data/Model/mech_drone/mech_drone.glb");
-	obj_->AddAABBCollider(6, 2, 3.5f);
-	obj_->AddRigidbody();
+	GameObject* vault = world.CreateObject<Vault>("Data/Model/mech_drone/mech_drone.glb");
+	vault->AddAABBCollider(6, 2, 3.5f);
+	vault->AddRigidbody();
+	obj_ = vault->GetHandle();
 
 	// ロボットオブジェクト
 	{
 		auto obj = world.CreateObject("Data/Model/mech_drone/mech_drone2.glb", DirectX::XMFLOAT3{ 3, 0, 6 }, DirectX::XMFLOAT3{ 0, 0, 0 }, DirectX::XMFLOAT3{ 10.0f, 10.0f, 10.0f });
-		obj->SetParent(obj_);
+		obj->SetParent(vault);
 		obj->AddSphereCollider(1.4f)->SetOffset({ 0, 1.1f, 0 });
 	}
 
@@ -118,9 +130,9 @@ void SceneGame::Initialize()
 		mapLight.priority = 10;
 		light_manager_.AddPointLight(mapLight);
 
-		DirectX::XMFLOAT3 playerPos = player_->GetWorldPositionFloat3();
+		DirectX::XMFLOAT3 playerPos = player->GetWorldPositionFloat3();
 		playerPos.y += 1.0f;
-		DirectX::XMFLOAT3 spotDirection = camera_controller_->GetCamera()->GetFront();
+		DirectX::XMFLOAT3 spotDirection = GetCameraController()->GetCamera()->GetFront();
 
 		light_manager_.SetPlayerSpotLight(
 			playerPos, spotDirection,
@@ -131,7 +143,7 @@ void SceneGame::Initialize()
 
 	// オーディオ
 	{
-		bgm_ = Audio::Instance().LoadAudioSource("Data/Sound/Game/BGM_game.wav");
+		bgm_ = Audio::Instance().LoadStreamingAudioSource("Data/Sound/Game/BGM_game.wav");
 		bgm_->SetVolume(0.4f);
 	}
 }
@@ -150,20 +162,21 @@ void SceneGame::Finalize()
 // 更新処理
 void SceneGame::Update(float elapsed_time)
 {
-	if (camera_controller_) {
+	CameraController* camera_controller = GetCameraController();
+	if (camera_controller) {
 		// カメラモード更新
 		if (InputManager::Instance().IsKeyDown('1')) {
-			camera_controller_->SetMode(CameraMode::kFirstPerson);
+			camera_controller->SetMode(CameraMode::kFirstPerson);
 		}
 		if (InputManager::Instance().IsKeyDown('2')) {
-			camera_controller_->SetMode(CameraMode::kThirdPerson);
-			camera_controller_->SetDistance(5.0f);
+			camera_controller->SetMode(CameraMode::kThirdPerson);
+			camera_controller->SetDistance(5.0f);
 		}
 		if (InputManager::Instance().IsKeyDown('3')) {
-			camera_controller_->SetMode(CameraMode::kFree);
+			camera_controller->SetMode(CameraMode::kFree);
 		}
 		if (InputManager::Instance().IsKeyDown('4')) {
-			camera_controller_->SetMode(CameraMode::kOrbit);
+			camera_controller->SetMode(CameraMode::kOrbit);
 		}
 	}
 
@@ -193,10 +206,11 @@ void SceneGame::Update(float elapsed_time)
 
 	// 自機ライティング更新
 	{
-		if (player_ && camera_controller_) {
-			DirectX::XMFLOAT3 playerPos = player_->GetWorldPositionFloat3();
+		GameObject* player = World::Instance().Resolve(player_);
+		if (player && camera_controller) {
+			DirectX::XMFLOAT3 playerPos = player->GetWorldPositionFloat3();
 			playerPos.y += 1.0f;
-			light_manager_.SetPlayerSpotLight(playerPos, camera_controller_->GetCamera()->GetFront());
+			light_manager_.SetPlayerSpotLight(playerPos, camera_controller->GetCamera()->GetFront());
 		}
 	}
 
@@ -218,11 +232,15 @@ void SceneGame::Update(float elapsed_time)
 // 描画処理
 void SceneGame::Render()
 {
-	/*if (game_limit_ < 0 || player_->GetHP() <= 0.0f)
+	/*if (game_limit_ < 0 || World::Instance().Resolve<Player>(player_)->GetHP() <= 0.0f)
 	{
 		return;
 	}*/
 
+	// カメラが破棄されていれば描画しない
+	CameraController* camera_controller = GetCameraController();
+	if (!camera_controller) return;
+
 	Graphics& graphics           = Graphics::Instance();
 	ID3D11DeviceContext* dc      = graphics.GetDeviceContext();
 	ShapeRenderer* shapeRenderer = graphics.GetShapeRenderer();
@@ -247,8 +265,9 @@ void SceneGame::Render()
 	RenderContext rc;
 	rc.deviceContext = dc;
 	rc.renderState = rs;
-	rc.camera = camera_controller_->GetCamera();
+	rc.camera = camera_controller->GetCamera();
 	rc.lightManager = &light_manager_;
+	rc.environment = environment_.get();
 	
 
 	dc->RSSetState(rs->GetRasterizerState(RasterizerState::SolidCullNone));
@@ -263,7 +282,7 @@ void SceneGame::Render()
 	DirectX::XMMATRIX VP = V * P;
 	DirectX::XMFLOAT4X4 vp;
 	DirectX::XMStoreFloat4x4(&vp, VP);
-	DirectX::XMFLOAT3 Cpos = camera_controller_->GetWorldPositionFloat3();
+	DirectX::XMFLOAT3 Cpos = camera_controller->GetWorldPositionFloat3();
 
 	//スカイマップ描画
 	sky_map_->blit(rc, vp, { Cpos.x,Cpos.y,Cpos.z,1.0f });
@@ -309,14 +328,15 @@ void SceneGame::DrawGUI()
 #ifdef _DEBUG
 	ImGui::Begin("GameDebug", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
 
-	if (ImGui::CollapsingHeader("Camera", ImGuiTreeNodeFlags_DefaultOpen)) {
-		DirectX::XMFLOAT3 camPos = camera_controller_->GetCamera()->GetEye();
+	CameraController* camera_controller = GetCameraController();
+	if (camera_controller && ImGui::CollapsingHeader("Camera", ImGuiTreeNodeFlags_DefaultOpen)) {
+		DirectX::XMFLOAT3 camPos = camera_controller->GetCamera()->GetEye();
 		ImGui::Text("Position: %.2f, %.2f, %.2f", camPos.x, camPos.y, camPos.z);
 
-		DirectX::XMFLOAT3 camTarget = camera_controller_->GetCamera()->GetFocus();
+		DirectX::XMFLOAT3 camTarget = camera_controller->GetCamera()->GetFocus();
 		ImGui::Text("Target: %.2f, %.2f, %.2f", camTarget.x, camTarget.y, camTarget.z);
 
-		DirectX::XMFLOAT3 camFront = camera_controller_->GetCamera()->GetFront();
+		DirectX::XMFLOAT3 camFront = camera_controller->GetCamera()->GetFront();
 		ImGui::Text("Front: %.2f, %.2f, %.2f", camFront.x, camFront.y, camFront.z);
 	}
 
@@ -325,12 +345,169 @@ void SceneGame::DrawGUI()
 		if (ImGui::Checkbox("Draw Colliders", &draw_colliders)) {
 			World::Instance().SetDebugDrawColliders(draw_colliders);
 		}
+
+		bool parallel_update = World::Instance().GetParallelUpdate();
+		if (ImGui::Checkbox("Parallel Update", &parallel_update)) {
+			World::Instance().SetParallelUpdate(parallel_update);
+		}
+
+		// 単一スレッドと並列で更新結果が一致するか
+		static int replay_result = -1;
+		if (ImGui::Button("Replay Test")) {
+			replay_result = World::RunReplayTest() ? 1 : 0;
+		}
+		if (replay_result >= 0) {
+			ImGui::SameLine();
+			ImGui::Text(replay_result ? "Match" : "MISMATCH");
+		}
+
+		// 個別確保のオブジェクトと連続配列で物理演算と積分の時間を比較
+		static std::vector<TransformStorage::BenchmarkResult> storage_benchmark;
+		if (ImGui::Button("SoA Benchmark")) {
+			storage_benchmark = {
+				TransformStorage::RunBenchmark(10000),
+				TransformStorage::RunBenchmark(100000) };
+		}
+		for (const TransformStorage::BenchmarkResult& result : storage_benchmark) {
+			ImGui::Text("%6zu objects  AoS %.3f ms  SoA %.3f ms", result.object_count,
+				result.aos_seconds * 1000.0f, result.soa_seconds * 1000.0f);
+		}
+		ImGui::Text("Transform Slots: %u", TransformStorage::Instance().GetAllocatedCount());
+
+		// 描画順の並べ替えで減る設定変更の数(記録用バックエンドに送って数える)
+		static std::vector<RenderQueueBenchmark::Result> render_queue_benchmark;
+		if (ImGui::Button("Render Queue Benchmark")) {
+			render_queue_benchmark = {
+				RenderQueueBenchmark::Run(1000),
+				RenderQueueBenchmark::Run(10000) };
+		}
+		for (const RenderQueueBenchmark::Result& result : render_queue_benchmark) {
+			ImGui::Text("%6zu draws  states %zu / cached %zu / sorted %zu  sort %.3f ms", result.drawCount,
+				result.submissionStateChanges, result.cachedStateChanges, result.sortedStateChanges,
+				result.sortSeconds * 1000.0f);
+			ImGui::Text("        command lists %zu  states %zu  draws %zu  record %.3f ms", result.commandListCount,
+				result.commandListStateChanges, result.commandListDraws, result.recordSeconds * 1000.0f);
+		}
+
+		// ヒープ確保回数(プロセス全体。前フレームとの差が0なら、そのフレームは一度もヒープを使っていない)
+		static uint64_t previous_allocations = 0;
+		const uint64_t allocations = AllocationCounter::GetAllocationCount();
+		ImGui::Text("Heap Allocations: %llu (+%llu)", allocations, allocations - previous_allocations);
+		previous_allocations = allocations;
+
+		// プールの使用状況(スラブの確保が増えなければ生成と破棄はスロットの再利用で済んでいる)
+		static ObjectPool::Statistics pool_statistics;
+		ObjectPool::Instance().GetStatistics(pool_statistics);
+		ImGui::Text("Pool Slab Allocations: %llu", pool_statistics.heap_allocation_count);
+		ImGui::Text("Pool Allocations: %llu", pool_statistics.pool_allocation_count);
+		if (ImGui::TreeNode("Object Pools")) {
+			for (const ObjectPool::PoolStatistics& pool : pool_statistics.pools) {
+				ImGui::Text("%4zu bytes  live %5zu  slabs %3zu", pool.object_size, pool.live_count, pool.slab_count);
+			}
+			ImGui::TreePop();
+		}
+	}
+
+	if (ImGui::CollapsingHeader("Culling", ImGuiTreeNodeFlags_DefaultOpen)) {
+		bool culling = World::Instance().GetCullingEnabled();
+		if (ImGui::Checkbox("Frustum Culling", &culling)) {
+			World::Instance().SetCullingEnabled(culling);
+		}
+
+		float max_draw_distance = World::Instance().GetMaxDrawDistance();
+		if (ImGui::DragFloat("Max Draw Distance", &max_draw_distance, 1.0f, 0.0f, 1000.0f, "%.0f (0: unlimited)")) {
+			World::Instance().SetMaxDrawDistance(max_draw_distance);
+		}
+
+		bool lod = World::Instance().GetLodEnabled();
+		if (ImGui::Checkbox("LOD", &lod)) {
+			World::Instance().SetLodEnabled(lod);
+		}
+
+		// 遮蔽判定（Hi-Z が使えない環境では CPU の深度バッファで判定する）
+		static const char* occlusion_mode_names[] = { "None", "Software", "Hi-Z (GPU)" };
+		int occlusion_mode = static_cast<int>(World::Instance().GetOcclusionMode());
+		if (ImGui::Combo("Occlusion", &occlusion_mode, occlusion_mode_names, static_cast<int>(_countof(occlusion_mode_names)))) {
+			World::Instance().SetOcclusionMode(static_cast<World::OcclusionMode>(occlusion_mode));
+		}
+
+		const World::CullingStats& culling_stats = World::Instance().GetCullingStats();
+		ImGui::Text("Visible: %zu", culling_stats.visible_count);
+		ImGui::Text("Frustum Culled: %zu", culling_stats.frustum_culled_count);
+		ImGui::Text("Distance Culled: %zu", culling_stats.distance_culled_count);
+		ImGui::Text("Shadow Only: %zu", culling_stats.shadow_only_count);
+		ImGui::Text("Occlusion: %s", occlusion_mode_names[static_cast<int>(culling_stats.occlusion_mode)]);
+		ImGui::Text("Occlusion Culled: %zu", culling_stats.occlusion_culled_count);
+		ImGui::Text("Second Phase: %zu", culling_stats.second_phase_count);
+		ImGui::Text("Occluders: %zu", culling_stats.occluder_count);
+
+		// 壁の後ろのボックスだけが隠れ、手前や横、縁にかかるものは見えるか
+		static int occlusion_test_result = -1;
+		if (ImGui::Button("Occlusion Test")) {
+			occlusion_test_result = OcclusionRasterizer::RunSelfTest() ? 1 : 0;
+		}
+		if (occlusion_test_result >= 0) {
+			ImGui::SameLine();
+			ImGui::Text(occlusion_test_result ? "Pass" : "FAIL");
+		}
+
+		// 半角の広いスポットライトも含めて、クラスタに届くライトを漏れなく割り当てているか
+		static int light_culling_test_result = -1;
+		if (ImGui::Button("Light Culling Test")) {
+			light_culling_test_result = LightCuller::RunSelfTest() ? 1 : 0;
+		}
+		if (light_culling_test_result >= 0) {
+			ImGui::SameLine();
+			ImGui::Text(light_culling_test_result ? "Pass" : "FAIL");
+		}
+	}
+
+	if (ImGui::CollapsingHeader("Shadows", ImGuiTreeNodeFlags_DefaultOpen)) {
+		// 解像度とカスケード数で画質と描画時間を調整する
+		ModelRenderer* model_renderer = Graphics::Instance().GetModelRenderer();
+		ShadowCascades::Settings settings = model_renderer->GetShadowSettings();
+		bool changed = false;
+
+		int cascade_count = static_cast<int>(settings.cascadeCount);
+		if (ImGui::SliderInt("Cascades", &cascade_count, 0, static_cast<int>(ShadowCascades::MaxCascadeCount))) {
+			settings.cascadeCount = static_cast<uint32_t>(cascade_count);
+			changed = true;
+		}
+
+		static const uint32_t resolutions[] = { 512, 1024, 2048, 4096 };
+		static const char* resolution_names[] = { "512", "1024", "2048", "4096" };
+		int resolution_index = 0;
+		for (int i = 0; i < static_cast<int>(_countof(resolutions)); ++i) {
+			if (resolutions[i] == settings.resolution) resolution_index = i;
+		}
+		if (ImGui::Combo("Resolution", &resolution_index, resolution_names, static_cast<int>(_countof(resolution_names)))) {
+			settings.resolution = resolutions[resolution_index];
+			changed = true;
+		}
+
+		changed |= ImGui::DragFloat("Shadow Distance", &settings.maxDistance, 1.0f, 1.0f, 1000.0f, "%.0f");
+		changed |= ImGui::SliderFloat("Split Lambda", &settings.splitLambda, 0.0f, 1.0f);
+		if (changed) {
+			model_renderer->SetShadowSettings(settings);
+		}
+
+		// 分割の深度、投影の範囲、テクセル単位の位置合わせ、キャスターの判定が合っているか
+		static int cascade_test_result = -1;
+		if (ImGui::Button("Shadow Cascade Test")) {
+			cascade_test_result = ShadowCascades::RunSelfTest() ? 1 : 0;
+		}
+		if (cascade_test_result >= 0) {
+			ImGui::SameLine();
+			ImGui::Text(cascade_test_result ? "Pass" : "FAIL");
+		}
 	}
 
 	if (ImGui::CollapsingHeader("Collision Debug", ImGuiTreeNodeFlags_DefaultOpen)) {
-		if (player_ && obj_) {
-			const std::vector<Collider*>& playerColliders = player_->GetColliders();
-			const std::vector<Collider*>& vaultColliders = obj_->GetColliders();
+		GameObject* player = World::Instance().Resolve(player_);
+		GameObject* vault = World::Instance().Resolve(obj_);
+		if (player && vault) {
+			const GameObject::ColliderList& playerColliders = player->GetColliders();
+			const GameObject::ColliderList& vaultColliders = vault->GetColliders();
 
 			if (!playerColliders.empty() && !vaultColliders.empty()) {
 				Collider* col_a = playerColliders[0];
@@ -378,6 +555,20 @@ void SceneGame::DrawGUI()
 		}
 	}
 
+	environment_->DrawDebugGUI();
+
+	Audio::Instance().DrawDebugGUI();
+
+	Graphics::Instance().GetSpriteBatch()->DrawDebugGUI();
+
+	Graphics::Instance().GetTransientVertexBuffer()->DrawDebugGUI();
+
+	TextureAtlas::Instance().DrawDebugGUI();
+
+	ShaderCache::Instance().DrawDebugGUI();
+
+	JobSystem::Instance().DrawDebugGUI();
+
 	ImGui::End();
 
 	light_manager_.DrawGUI();
@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 #include "sky_map.h"
+#include "System/EnvironmentLighting.h"
 #include "Lerp.h"
 #include "math.h"
 #include "System/AudioSource.h"
@@ -13,37 +14,41 @@
 #include <game_object.h>
 #include "player.h"
 
-// Q[V[
+// ゲームシーン
 class SceneGame : public Scene
 {
 private:
-	bool H = false;//fobO
+	bool H = false;//デバッグ
 
-	Player* player_ = nullptr;
-	CameraController* camera_controller_ = nullptr;
+	GameObjectHandle player_; // 破棄されても World::Resolve() が nullptr を返す
+	GameObjectHandle camera_controller_; // 破棄されても GetCameraController() が nullptr を返す
 	std::unique_ptr<sky_map> sky_map_ = nullptr;
-	GameObject* obj_ = nullptr;
+	std::unique_ptr<EnvironmentLighting> environment_ = nullptr; // スカイマップから焼き込んだ環境光
+	GameObjectHandle obj_;
 	AudioSource* bgm_ = nullptr;
 	float game_limit_ = 200.0f;
 	LightManager light_manager_;
 
+	// カメラの取得(破棄されていれば nullptr)
+	CameraController* GetCameraController() const { return World::Instance().Resolve<CameraController>(camera_controller_); }
+
 public:
 	SceneGame();
 	~SceneGame() override {}
 
-	// 
+	// 初期化
 	void Initialize() override;
 
-	// I
+	// 終了化
 	void Finalize() override;
 
-	// XV
+	// 更新処理
 	void Update(float elapsedTime) override;
 
-	// `揈
+	// 描画処理
 	void Render() override;
 
-	// GUI`
+	// GUI描画
 	void DrawGUI() override;
 
 
@@ -1,38 +1,42 @@
 #include "scene_loading.h"
 #include "System/Graphics.h"
 #include "System/Input.h"
+#include "System/Profiler.h"
 #include "scene_manager.h"
 
-//[fBOXbh
+//ローディングスレッド
 void SceneLoading::LoadingThread(SceneLoading* scene)
 {
-	//COM֘ȀŃXbh}CɌĂԕKv
+	PROFILE_THREAD_NAME("Loading");
+	PROFILE_SCOPE("SceneLoading::LoadingThread");
+
+	//COM関連の初期化でスレッドマイに呼ぶ必要がある
 	CoInitialize(nullptr);
 
-	//̃V[̏s
+	//次のシーンの初期化を行う
 	scene->nextScene->Initialize();
 
-	//XbhIOCOM֘AI
+	//スレッドが終わる前にCOM関連書終了化
 	CoUninitialize();
 
-	//̃V[̏ݒ
+	//次のシーンの準備完了設定
 	scene->nextScene->SetReady();
 }
 
 void SceneLoading::Initialize()
 {
-	//XvCg
+	//スプライト初期化
 	auto* device = Graphics::Instance().GetDevice();
 	load_Back = std::make_unique<Sprite>(device, "Data/Sprite/load_background.png");
 	load_Sprite = std::make_unique<Sprite>(device, "Data/Sprite/load_mapchip.png");
 
-	//XbhJn
+	//スレッド開始
 	thread = new std::thread(LoadingThread,this);
 }
 
 void SceneLoading::Finalize()
 {
-	// XbhI҂
+	// スレッド終了待ち
 	if (thread)
 	{
 		if (thread->joinable())
@@ -57,7 +61,7 @@ void SceneLoading::Update(float elapsedTime)
 	{
 		sprPos = 0;
 	}
-	//̃V[̏V[؂ւ
+	//次のシーンの準備が完了したらシーン切り替え
 	if (nextScene->IsReady()/*&&timer > 3.0f*/)
 	{
 		if (thread && thread->joinable())
@@ -80,9 +84,9 @@ void SceneLoading::Render()
 	dc->RSSetState(rs->GetRasterizerState(RasterizerState::SolidCullNone));
 
 
-	//2DXvCg`
+	//2Dスプライト描画
 	{
-		//ʉEɃ[fBO`
+		//画面右下にローディング描画
 		load_Back->Render(dc, 0, 0, 0, 1920, 1080, 0, 1, 1, 1, 1);
 
 		load_Sprite->Render(dc, 1520, 680, 0, 400, 400, sprPos * 400, 400,400,400, 0, 1, 1, 1, 1);
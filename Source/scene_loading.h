@@ -5,7 +5,7 @@
 
 #include <thread>
 
-//[fBO
+//ローディング
 class SceneLoading : public Scene
 {
 private:
@@ -23,7 +23,7 @@ private:
 	std::thread* thread = nullptr;
 
 private:
-	//[fBOXbh
+	//ローディングスレッド
 	static void LoadingThread(SceneLoading* scene);
 
 public:
@@ -31,18 +31,18 @@ public:
 	SceneLoading(Scene* nexetScene): nextScene(nexetScene){}
 	~SceneLoading() override {}
 
-	//
+	//初期化
 	void Initialize() override;
 
-	//I
+	//終了化
 	void Finalize() override;
 
-	//XV
+	//更新処理
 	void Update(float elapsedTime) override;
 
-	//`揈
+	//描画処理
 	void Render() override;
 
-	//GUI`
+	//GUI描画
 	void DrawGUI() override;
 };
\ No newline at end of file
@@ -4,14 +4,14 @@ void SceneManager::Update(float elapsedTime)
 {
 	if (nextScene != nullptr)
 	{
-		//I
+		//終了
 		Clear();
 
-		//VV[ݒ
+		//新しいシーン設定
 		currrentScene = nextScene;
 		nextScene = nullptr;
 
-		//
+		//初期化
 		if (currrentScene->IsReady() == false)
 		{
 			currrentScene->Initialize();
@@ -51,7 +51,7 @@ void SceneManager::Clear()
 	}
 }
 
-//V[؂ւ
+//シーン切り替え
 void SceneManager::ChangeScene(Scene* scene)
 {
 	nextScene = scene;
@@ -2,7 +2,7 @@
 
 #include "Scene.h"
 
-//V[}l[W[
+//シーンマネージャー
 class SceneManager
 {
 private:
@@ -14,25 +14,25 @@ public:
 	~SceneManager() {}
 
 public:
-	//VOg
+	//シングルトン
 	static SceneManager& Instance()
 	{
 		static SceneManager instance;
 		return instance;
 	}
 
-	//XV
+	//更新処理
 	void Update(float elapsedTime);
 
-	//`揈
+	//描画処理
 	void Render();
 
-	//GUI`
+	//GUI描画
 	void DrawGUI();
 
-	//V[NA
+	//シーンクリア
 	void Clear();
 
-	//V[؂ւ
+	//シーン切り替え
 	void ChangeScene(Scene* scene);
 };
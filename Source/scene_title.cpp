@@ -26,7 +26,7 @@ void SceneTitle::Initialize() {
 
     titleStartMenu = std::make_unique<UiPanel>();
 
-    // SXvCgǉ
+    // ロゴスプライト追加
     auto* spr_logo = titleStartMenu->AddSprite();
     spr_logo->SetSprite("Data/Sprite/game_logo_new.png");
     spr_logo->SetPosition(DirectX::XMFLOAT2{ SCREEN_W * 0.2f - 512 * 0.5f, 100 });
@@ -35,7 +35,7 @@ void SceneTitle::Initialize() {
     spr_logo->SetSpritePosition({ 0, 0 });
     spr_logo->SetSpriteSize({ 601, 224 });
 
-    // X^[g{^ǉ
+    // スタートボタン追加
     auto* startButton = titleStartMenu->AddButton(
         "Data/Sprite/gamestart_text_new.png",
         DirectX::XMFLOAT2{ SCREEN_W * 0.2f - 351 * 0.5f - 100,
@@ -54,7 +54,7 @@ void SceneTitle::Initialize() {
         RenderLayer::kButton
     );
 
-    // zo[̃R[obNݒ
+    // ホバー時のコールバック設定
     startButton->SetOnHoverCallback([this]() {
         if (onCursorSE) {
             onCursorSE->Stop();
@@ -62,7 +62,7 @@ void SceneTitle::Initialize() {
         }
         });
 
-    // `[gA{^ǉ
+    // チュートリアルボタン追加
     auto* tutorialButton = titleStartMenu->AddButton(
         "Data/Sprite/tutorial_text_new.png",
         DirectX::XMFLOAT2{ SCREEN_W * 0.2f - 633 * 0.5f + 40,
@@ -76,13 +76,13 @@ void SceneTitle::Initialize() {
                 clickSE->Stop();
                 clickSE->Play(false);
             }
-            //V[ĂȂ
+            //シーン作ってない
             //SceneManager::Instance().ChangeScene(new SceneLoading(new SceneTutorial()));
         },
         RenderLayer::kButton
     );
 
-    // zo[̃R[obNݒ
+    // ホバー時のコールバック設定
     tutorialButton->SetOnHoverCallback([this]() {
         if (onCursorSE) {
             onCursorSE->Stop();
@@ -90,14 +90,14 @@ void SceneTitle::Initialize() {
         }
         });
 
-    // pltF[hC
+    // パネルをフェードイン
     titleStartMenu->FadeIn(2.0f);
 
-    // I[fBIǂݍ
+    // オーディオ読み込み
     clickSE = Audio::Instance().LoadAudioSource("Data/Sound/title/SE_title_click.wav");
     onCursorSE = Audio::Instance().LoadAudioSource("Data/Sound/title/SE_title_cursor.wav");
     onStartSE = Audio::Instance().LoadAudioSource("Data/Sound/title/SE_title_zoom.wav");
-    backGroundMusic = Audio::Instance().LoadAudioSource("Data/Sound/title/BGM_title.wav");
+    backGroundMusic = Audio::Instance().LoadStreamingAudioSource("Data/Sound/title/BGM_title.wav");
 
     skyMap = std::make_unique<sky_map>(graphics.GetDevice(),
         L"Data/SkyMapSprite/game_background3.hdr");
@@ -109,7 +109,7 @@ void SceneTitle::Initialize() {
 
     titleStartMenu->SetActive(true);
 
-    // Jݒ
+    // カメラ設定
     //camera = std::make_unique<CameraController>();
     //DirectX::XMFLOAT3 eye{ 0, 0, 0 };
     //DirectX::XMFLOAT3 focus{ 1, 0, 0 };
@@ -125,7 +125,7 @@ void SceneTitle::Initialize() {
     camera_controller_->GetCamera()->SetEye({ 0, 0, 0 });
     camera_controller_->GetCamera()->SetFocus({ 0, 0, 1 });
 
-    // Cgݒ
+    // ライト設定
     {
         DirectionalLight directionalLight;
         DirectX::XMFLOAT3 dir = { 0.3f, -1.0f, 0.3f };
@@ -154,10 +154,10 @@ void SceneTitle::Initialize() {
         );
     }
 
-    // J[\ݒi^Cgʂł̓JX^J[\\j
-    SystemCursor::Hide();           // VXeJ[\\
-    CustomCursor::Instance().Show(); // JX^J[\\
-    CustomCursor::Instance().FadeIn(1.0f); // tF[hCœo
+    // カーソル設定（タイトル画面ではカスタムカーソルを表示）
+    SystemCursor::Hide();           // システムカーソルを非表示
+    CustomCursor::Instance().Show(); // カスタムカーソルを表示
+    CustomCursor::Instance().FadeIn(1.0f); // フェードインで登場
 }
 
 void SceneTitle::Finalize() {
@@ -170,7 +170,7 @@ void SceneTitle::Finalize() {
     delete onStartSE;
     delete onCursorSE;
 
-    // J[\ZbgĩV[̂߂Ɂj
+    // カーソルをリセット（次のシーンのために）
     CustomCursor::Instance().Hide();
 
     World::Instance().Clear();
@@ -179,21 +179,21 @@ void SceneTitle::Finalize() {
 void SceneTitle::Update(float elapsedTime) {
     backGroundMusic->Play(true);
 
-    // UIplXV
+    // UIパネルを更新
     titleStartMenu->Update();
 
-    // Cxg
+    // イベント処理
     auto events = titleStartMenu->GetPendingEvents();
     for (const auto& event : events) {
         switch (event.type) {
         case UiEventType::Click:
-            // NbNCxg̏iR[obNŊɏĂj
+            // クリックイベントの処理（コールバックで既に処理されている）
             break;
         case UiEventType::HoverBegin:
-            // zo[Jn̒ǉiKvȂj
+            // ホバー開始時の追加処理（必要なら）
             break;
         case UiEventType::HoverEnd:
-            // zo[I̒ǉ
+            // ホバー終了時の追加処理
             break;
         default:
             break;
@@ -211,7 +211,7 @@ void SceneTitle::Render() {
     rc.camera = camera_controller_->GetCamera();
     rc.lightManager = &lightManager;
 
-    // _[Xe[gݒ
+    // レンダーステート設定
     dc->RSSetState(rs->GetRasterizerState(RasterizerState::SolidCullNone));
     dc->OMSetDepthStencilState(rs->GetDepthStencilState(DepthState::TestAndWrite), 0);
     ID3D11SamplerState* s = rs->GetSamplerState(SamplerState::LinearClamp);
@@ -219,7 +219,7 @@ void SceneTitle::Render() {
     const float blendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
     dc->OMSetBlendState(rs->GetBlendState(BlendState::Opaque), blendFactor, 0xffffffff);
 
-    // XJC}bv`
+    // スカイマップ描画
     DirectX::XMMATRIX V = DirectX::XMLoadFloat4x4(&rc.camera->GetView());
     DirectX::XMMATRIX P = DirectX::XMLoadFloat4x4(&rc.camera->GetProjection());
     DirectX::XMMATRIX VP = V * P;
@@ -228,7 +228,7 @@ void SceneTitle::Render() {
     DirectX::XMFLOAT3 Cpos = camera_controller_->GetCamera()->GetEye();
     skyMap->blit(rc, vp, { Cpos.x, Cpos.y, Cpos.z, 1.0f });
 
-    // UI`
+    // UI描画
     dc->OMSetDepthStencilState(rs->GetDepthStencilState(DepthState::NoTestNoWrite), 0);
     dc->OMSetBlendState(rs->GetBlendState(BlendState::Transparency), blendFactor, 0xffffffff);
     dc->PSSetSamplers(0, 1, &s);
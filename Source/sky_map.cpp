@@ -2,13 +2,13 @@
 #include "System/GpuResourceUtils.h"
 #include "System/Misc.h"
 
-//obNobt@̃eNX``ႤŃXJC}bvrȂĂ\
-//hdrłddsł肪ôŃeNX`̖ł͂Ȃ
-//݁@R8G8B8A8_UNORM
-//@@@@ϊ
-//\z@R32G32B32A32_FLOAT
+//バックバッファのテクスチャ形式が違うせいでスカイマップが荒くなってる可能性あり
+//hdrでもddsでも同じ問題が出るのでテクスチャ側の問題ではなさそう
+//現在　R8G8B8A8_UNORM
+//　　　　↓変換したい
+//予想　R32G32B32A32_FLOAT
 // 
-//JhĂ闝R
+//カメラが揺れてる理由
 
 sky_map::sky_map(ID3D11Device* device, const wchar_t* filename, bool generate_mips)
 {
@@ -37,7 +37,7 @@ sky_map::sky_map(ID3D11Device* device, const wchar_t* filename, bool generate_mi
 
 void sky_map::blit(const RenderContext& rc, const DirectX::XMFLOAT4X4& view_projection, const DirectX::XMFLOAT4& cameraPosition)
 {
-	// TvXe[gݒ
+	// サンプラステート設定
 	ID3D11SamplerState* samplerStates[] =
 	{
 		nullptr,
@@ -45,11 +45,11 @@ void sky_map::blit(const RenderContext& rc, const DirectX::XMFLOAT4X4& view_proj
 	};
 	rc.deviceContext->PSSetSamplers(0, _countof(samplerStates), samplerStates);
 
-	// _[Xe[gݒ
+	// レンダーステート設定
 	rc.deviceContext->OMSetDepthStencilState(rc.renderState->GetDepthStencilState(DepthState::TestOnly), 0);
 	//dc->RSSetState(rc.renderState->GetRasterizerState(RasterizerState::SolidCullBack));
 
-	// uhXe[gݒ
+	// ブレンドステート設定
 	rc.deviceContext->OMSetBlendState(rc.renderState->GetBlendState(BlendState::Opaque), nullptr, 0xFFFFFFFF);
 
 
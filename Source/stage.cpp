@@ -1,6 +1,6 @@
 #include "stage.h"
 
-//RXgN^
+//コンストラクタ
 Stage::Stage()
 {
 }
@@ -9,22 +9,22 @@ Stage::~Stage()
 {
 }
 
-//|WVXV
+//ポジション更新
 void Stage::UpdateTransform()
 {
-	//XP[s񐧍
+	//スケール行列制作
 	DirectX::XMMATRIX S = DirectX::XMMatrixScaling(scale.x, scale.y, scale.z);
 
-	//]s𐧍
+	//回転行列を制作
 	DirectX::XMMATRIX R = DirectX::XMMatrixRotationRollPitchYaw(angle.x, angle.y, angle.z);
 
-	//ʒus쐬
+	//位置行列を作成
 	DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(position.x, position.y, position.z);
 
-	//O̍sgݍ킹ă[hs쐬
+	//三つの行列を組み合わせてワールド行列を作成
 	DirectX::XMMATRIX W = S * R * T;
 
-	//vZ[hso
+	//計算したワールド行列を取り出す
 	DirectX::XMStoreFloat4x4(&transform, W);
 }
 
@@ -32,13 +32,13 @@ void Stage::Update(float elapsedTime, const PlayerOld* player)
 {
 }
 
-//`揈
+//描画処理
 void Stage::Render(const RenderContext& rc, ModelRenderer* renderer)
 {
-	//_Ƀf`悵Ă炤
+	//レンダラにモデルを描画してもらう
 	//renderer->Render(rc, transform, model.get(), ShaderId::Lambert);
 
-	// VRendereȑ
+	// 新Rendererの書き方
 	renderer->Draw(ShaderId::Lambert, model);
 
 }
\ No newline at end of file
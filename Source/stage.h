@@ -14,16 +14,16 @@ protected:
 	DirectX::XMFLOAT3	angle = { 0,0,0 };
 	DirectX::XMFLOAT3	scale = { 1,1,1 };
 	DirectX::XMFLOAT4X4 transform = {
-		//XP[x
+		//スケールx
 		1, 0, 0, 0,
-		//XP[y
+		//スケールy
 		0, 1, 0, 0,
-		//]
+		//回転
 		0, 0, 1, 0,
-		//ʒu
+		//位置
 		0, 0, 0, 1
 	};
-	//^C[h
+	//タイルモード
 	int mode;
 	int nowType;
 
@@ -34,7 +34,7 @@ public:
 	Stage();
 	virtual ~Stage();
 
-	//
+	//初期化
 	virtual void Initialize() {};
 
 	void setPosition(DirectX::XMFLOAT3 pos) {this->position = pos;}
@@ -61,10 +61,10 @@ protected:
 
 public:
 
-	//XV
+	//更新処理
 	virtual void Update(float elapsedTime,const PlayerOld* player);
 
-	//`揈
+	//描画処理
 	virtual void Render(const RenderContext& rc, ModelRenderer* renderer);
 
 	virtual void Event() {};
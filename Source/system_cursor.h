@@ -6,48 +6,48 @@
 
 /**
  * @class SystemCursor
- * @brief WindowsVXeJ[\̕\EʒuǗNX
+ * @brief Windowsシステムカーソルの表示・位置制御を管理するクラス
  *
- * Win32 APIgpăVXeJ[\̕\/\Aʒu擾/ݒs܂B
+ * Win32 APIを使用してシステムカーソルの表示/非表示、位置取得/設定を行います。
  */
 class SystemCursor
 {
 public:
     /**
-     * @brief VXeJ[\\
+     * @brief システムカーソルを表示
      */
     static void Show();
 
     /**
-     * @brief VXeJ[\\
+     * @brief システムカーソルを非表示
      */
     static void Hide();
 
     /**
-     * @brief VXeJ[\̕\Ԃ擾
-     * @return bool \̏ꍇtrue
+     * @brief システムカーソルの表示状態を取得
+     * @return bool 表示中の場合true
      */
     static bool IsVisible();
 
     /**
-     * @brief ݂̃J[\ʒu擾iNCAgWnj
-     * @return DirectX::XMFLOAT2 J[\ʒu
+     * @brief 現在のカーソル位置を取得（クライアント座標系）
+     * @return DirectX::XMFLOAT2 カーソル位置
      */
     static DirectX::XMFLOAT2 GetPosition();
 
     /**
-     * @brief J[\ʒuݒiNCAgWnj
-     * @param pos ݒ肷ʒu
+     * @brief カーソル位置を設定（クライアント座標系）
+     * @param pos 設定する位置
      */
     static void SetPosition(const DirectX::XMFLOAT2& pos);
 
     /**
-     * @brief J[\ʒɈړ
+     * @brief カーソルを画面中央に移動
      */
     static void CenterCursor();
 
 private:
-    inline static bool is_visible_ = true; ///< J[\̕\
+    inline static bool is_visible_ = true; ///< カーソルの表示状態
 };
 
 #endif  // SYSTEM_CURSOR_H_
\ No newline at end of file
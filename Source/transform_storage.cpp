@@ -0,0 +1,380 @@
+#include "transform_storage.h"
+#include <algorithm>
+#include "System/Misc.h"
+
+namespace {
+
+// ベンチマーク用: 従来どおりオブジェクトごとに個別確保したリジッドボディ
+struct LegacyRigidbody {
+    bool is_enabled = true;
+    bool is_kinematic = false;
+    bool use_gravity = true;
+    float drag = 0.0f;
+};
+
+// ベンチマーク用: 従来どおりオブジェクトごとに個別確保したゲームオブジェクト
+struct LegacyObject {
+    virtual ~LegacyObject() = default;
+
+    DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 angle = { 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 scale = { 1.0f, 1.0f, 1.0f };
+    DirectX::XMFLOAT4X4 transform = {};
+    DirectX::XMFLOAT3 velocity = { 0.0f, 0.0f, 0.0f };
+    std::vector<void*> colliders;
+    std::unique_ptr<LegacyRigidbody> rigidbody;
+    bool active = true;
+    float elapsed_time = 0.0f;
+};
+
+}  // namespace
+
+TransformStorage& TransformStorage::Instance() {
+    static TransformStorage instance;
+    return instance;
+}
+
+uint32_t TransformStorage::Allocate() {
+    uint32_t slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_slots_.empty()) {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        else {
+            slot = slot_end_.load(std::memory_order_relaxed);
+            _ASSERT_EXPR(slot < kChunkSize * kMaxChunks, L"TransformStorage: slot overflow");
+            std::unique_ptr<Chunk>& chunk = chunks_[slot >> kChunkShift];
+            if (!chunk) chunk = std::make_unique<Chunk>();
+        }
+
+        const uint32_t index = slot & kChunkMask;
+        Chunk& chunk = *chunks_[slot >> kChunkShift];
+        chunk.position[index] = { 0.0f, 0.0f, 0.0f };
+        chunk.angle[index] = { 0.0f, 0.0f, 0.0f };
+        chunk.scale[index] = { 1.0f, 1.0f, 1.0f };
+        chunk.velocity[index] = { 0.0f, 0.0f, 0.0f };
+        DirectX::XMStoreFloat4x4(&chunk.local_transform[index], DirectX::XMMatrixIdentity());
+        DirectX::XMStoreFloat4x4(&chunk.world_transform[index], DirectX::XMMatrixIdentity());
+        chunk.bounds[index] = { 0.0f, 0.0f, 0.0f, std::numeric_limits<float>::infinity() };
+        chunk.elapsed_time[index] = 0.0f;
+        chunk.gravity_scale[index] = 0.0f;
+        chunk.drag[index] = 0.0f;
+        // 所属する World は AssignWorld() から PublishPendingSlots() で設定するまで 0 のままにする
+        // (一括処理は World の識別子が一致したスロットしか読まないので、使い回したスロットを書き換えても競合しない)
+        chunk.world_id[index] = 0;
+        chunk.flags[index] = kFlagAllocated | kFlagActive;
+
+        // 初期化が済んでから走査範囲に含める
+        if (slot == slot_end_.load(std::memory_order_relaxed)) {
+            slot_end_.store(slot + 1, std::memory_order_release);
+        }
+    }
+    allocated_count_.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+void TransformStorage::Free(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Flags(slot) = 0;
+    WorldId(slot) = 0;
+    free_slots_.push_back(slot);
+    allocated_count_.fetch_sub(1, std::memory_order_relaxed);
+
+    // 反映前に破棄された場合は登録を取り消す(使い回したスロットに古い登録が反映されないように)
+    pending_slots_.erase(std::remove_if(pending_slots_.begin(), pending_slots_.end(),
+        [slot](const PendingSlot& pending) { return pending.slot == slot; }), pending_slots_.end());
+}
+
+void TransformStorage::AssignWorld(uint32_t slot, uint16_t world_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_slots_.push_back({ slot, world_id });
+}
+
+void TransformStorage::PublishPendingSlots() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const PendingSlot& pending : pending_slots_) {
+        WorldId(pending.slot) = pending.world_id;
+    }
+    pending_slots_.clear();
+}
+
+template<typename Function>
+void TransformStorage::ForEachChunkRange(uint32_t begin, uint32_t end, Function function) {
+    end = std::min(end, GetSlotEnd());
+    while (begin < end) {
+        const uint32_t chunk_end = std::min((begin | kChunkMask) + 1, end);
+        function(*chunks_[begin >> kChunkShift], begin & kChunkMask, ((chunk_end - 1) & kChunkMask) + 1);
+        begin = chunk_end;
+    }
+}
+
+void TransformStorage::ApplyPhysics(uint16_t world_id, uint32_t begin, uint32_t end,
+    float elapsed_time, const DirectX::XMFLOAT3& gravity) {
+    const DirectX::XMVECTOR gravity_step = DirectX::XMVectorScale(
+        DirectX::XMLoadFloat3(&gravity), elapsed_time);
+
+    // 4スロット分の xyz を並べた3つのベクターに合わせた重力 [x y z x] [y z x y] [z x y z]
+    const DirectX::XMVECTOR gravity_steps[3] = {
+        DirectX::XMVectorSwizzle<0, 1, 2, 0>(gravity_step),
+        DirectX::XMVectorSwizzle<1, 2, 0, 1>(gravity_step),
+        DirectX::XMVectorSwizzle<2, 0, 1, 2>(gravity_step),
+    };
+
+    ForEachChunkRange(begin, end,
+        [world_id, elapsed_time, gravity_step, &gravity_steps](Chunk& chunk, uint32_t first, uint32_t last) {
+            auto is_target = [&chunk, world_id](uint32_t i) {
+                return chunk.world_id[i] == world_id && (chunk.flags[i] & kFlagActive);
+            };
+
+            // 1スロット分(Rigidbody::ApplyGravity()、ApplyDrag() と同じ演算)
+            auto apply = [&chunk, elapsed_time, gravity_step](uint32_t i) {
+                const float gravity_scale = chunk.gravity_scale[i];
+                const float drag = chunk.drag[i];
+                if (gravity_scale == 0.0f && drag == 0.0f) return;
+
+                DirectX::XMVECTOR velocity = DirectX::XMLoadFloat3(&chunk.velocity[i]);
+                if (gravity_scale != 0.0f) {
+                    velocity = DirectX::XMVectorAdd(velocity, gravity_step);
+                }
+                if (drag > 0.0f) {
+                    velocity = DirectX::XMVectorScale(velocity, 1.0f / (1.0f + drag * elapsed_time));
+                }
+                DirectX::XMStoreFloat3(&chunk.velocity[i], velocity);
+            };
+
+            uint32_t i = first;
+            for (; i + 4 <= last; i += 4) {
+                // 4つとも対象のときだけまとめて読み書きする
+                // ほかの World や登録待ちのスロットが混ざる組は、そのスロットを読み書きしないように1つずつ処理する
+                // (読み込みスレッドが Allocate() で初期値を書き込んでいる最中のスロットを上書きしない)
+                bool all = true;
+                for (uint32_t k = 0; k < 4; ++k) {
+                    all &= is_target(i + k);
+                }
+                if (!all) {
+                    for (uint32_t k = 0; k < 4; ++k) {
+                        if (is_target(i + k)) apply(i + k);
+                    }
+                    continue;
+                }
+
+                uint32_t gravity_mask[4];
+                uint32_t drag_mask[4];
+                bool any = false;
+                for (uint32_t k = 0; k < 4; ++k) {
+                    gravity_mask[k] = chunk.gravity_scale[i + k] != 0.0f;
+                    drag_mask[k] = chunk.drag[i + k] > 0.0f;
+                    any |= gravity_mask[k] || drag_mask[k];
+                }
+                if (!any) continue;
+
+                // 重力 → 抵抗の順に適用(Rigidbody::ApplyGravity()、ApplyDrag() と同じ演算)
+                const DirectX::XMVECTOR gravity_select = DirectX::XMVectorSelectControl(
+                    gravity_mask[0], gravity_mask[1], gravity_mask[2], gravity_mask[3]);
+                const DirectX::XMVECTOR drag_select = DirectX::XMVectorSelectControl(
+                    drag_mask[0], drag_mask[1], drag_mask[2], drag_mask[3]);
+                const DirectX::XMVECTOR drag = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&chunk.drag[i]));
+                const DirectX::XMVECTOR drag_factor = DirectX::XMVectorReciprocal(
+                    DirectX::XMVectorAdd(DirectX::XMVectorSplatOne(), DirectX::XMVectorScale(drag, elapsed_time)));
+
+                // スロットごとの値を [0 0 0 1] [1 1 2 2] [2 3 3 3] に広げる
+                const DirectX::XMVECTOR gravity_selects[3] = {
+                    DirectX::XMVectorSwizzle<0, 0, 0, 1>(gravity_select),
+                    DirectX::XMVectorSwizzle<1, 1, 2, 2>(gravity_select),
+                    DirectX::XMVectorSwizzle<2, 3, 3, 3>(gravity_select),
+                };
+                const DirectX::XMVECTOR drag_selects[3] = {
+                    DirectX::XMVectorSwizzle<0, 0, 0, 1>(drag_select),
+                    DirectX::XMVectorSwizzle<1, 1, 2, 2>(drag_select),
+                    DirectX::XMVectorSwizzle<2, 3, 3, 3>(drag_select),
+                };
+                const DirectX::XMVECTOR drag_factors[3] = {
+                    DirectX::XMVectorSwizzle<0, 0, 0, 1>(drag_factor),
+                    DirectX::XMVectorSwizzle<1, 1, 2, 2>(drag_factor),
+                    DirectX::XMVectorSwizzle<2, 3, 3, 3>(drag_factor),
+                };
+
+                DirectX::XMFLOAT4* velocity = reinterpret_cast<DirectX::XMFLOAT4*>(&chunk.velocity[i]);
+                for (int v = 0; v < 3; ++v) {
+                    DirectX::XMVECTOR value = DirectX::XMLoadFloat4(&velocity[v]);
+                    value = DirectX::XMVectorSelect(value, DirectX::XMVectorAdd(value, gravity_steps[v]), gravity_selects[v]);
+                    value = DirectX::XMVectorSelect(value, DirectX::XMVectorMultiply(value, drag_factors[v]), drag_selects[v]);
+                    DirectX::XMStoreFloat4(&velocity[v], value);
+                }
+            }
+
+            // 4つに満たない残り
+            for (; i < last; ++i) {
+                if (is_target(i)) apply(i);
+            }
+        });
+}
+
+void TransformStorage::Integrate(uint16_t world_id, uint32_t begin, uint32_t end, float elapsed_time) {
+    const DirectX::XMVECTOR step = DirectX::XMVectorReplicate(elapsed_time);
+
+    ForEachChunkRange(begin, end,
+        [world_id, elapsed_time, step](Chunk& chunk, uint32_t first, uint32_t last) {
+            auto is_target = [&chunk, world_id](uint32_t i) {
+                return chunk.world_id[i] == world_id && (chunk.flags[i] & kFlagIntegrate);
+            };
+
+            // 1スロット分
+            auto integrate = [&chunk, elapsed_time](uint32_t i) {
+                chunk.flags[i] &= ~kFlagIntegrate;
+
+                chunk.elapsed_time[i] += elapsed_time;
+
+                DirectX::XMVECTOR position = DirectX::XMLoadFloat3(&chunk.position[i]);
+                DirectX::XMVECTOR velocity = DirectX::XMLoadFloat3(&chunk.velocity[i]);
+                position = DirectX::XMVectorAdd(position, DirectX::XMVectorScale(velocity, elapsed_time));
+                DirectX::XMStoreFloat3(&chunk.position[i], position);
+            };
+
+            uint32_t i = first;
+            for (; i + 4 <= last; i += 4) {
+                // 4つとも対象のときだけまとめて読み書きし、ほかは対象のスロットだけを1つずつ処理する(ApplyPhysics() と同じ)
+                bool all = true;
+                for (uint32_t k = 0; k < 4; ++k) {
+                    all &= is_target(i + k);
+                }
+                if (!all) {
+                    for (uint32_t k = 0; k < 4; ++k) {
+                        if (is_target(i + k)) integrate(i + k);
+                    }
+                    continue;
+                }
+
+                for (uint32_t k = 0; k < 4; ++k) {
+                    chunk.flags[i + k] &= ~kFlagIntegrate;
+                }
+
+                DirectX::XMFLOAT4* time = reinterpret_cast<DirectX::XMFLOAT4*>(&chunk.elapsed_time[i]);
+                DirectX::XMStoreFloat4(time, DirectX::XMVectorAdd(DirectX::XMLoadFloat4(time), step));
+
+                // xyz 12要素をまとめて積分する
+                DirectX::XMFLOAT4* position = reinterpret_cast<DirectX::XMFLOAT4*>(&chunk.position[i]);
+                const DirectX::XMFLOAT4* velocity = reinterpret_cast<const DirectX::XMFLOAT4*>(&chunk.velocity[i]);
+                for (int v = 0; v < 3; ++v) {
+                    const DirectX::XMVECTOR value = DirectX::XMLoadFloat4(&position[v]);
+                    DirectX::XMStoreFloat4(&position[v], DirectX::XMVectorAdd(value,
+                        DirectX::XMVectorMultiply(DirectX::XMLoadFloat4(&velocity[v]), step)));
+                }
+            }
+
+            // 4つに満たない残り
+            for (; i < last; ++i) {
+                if (is_target(i)) integrate(i);
+            }
+        });
+}
+
+bool TransformStorage::BoundsOverlap(const DirectX::XMFLOAT4& a, const DirectX::XMFLOAT4& b) {
+    const float dx = a.x - b.x;
+    const float dy = a.y - b.y;
+    const float dz = a.z - b.z;
+    const float radius = a.w + b.w;
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+TransformStorage::BenchmarkResult TransformStorage::RunBenchmark(size_t object_count, int iterations) {
+    BenchmarkResult result;
+    result.object_count = object_count;
+
+    const float elapsed_time = 1.0f / 60.0f;
+    const DirectX::XMFLOAT3 gravity = { 0.0f, -9.8f, 0.0f };
+
+    uint32_t random = 12345;
+    auto next = [&random]() {
+        random = random * 1664525u + 1013904223u;
+        return static_cast<float>(random >> 8) / static_cast<float>(1u << 24);
+    };
+
+    // 従来の配置: 生成と破棄を繰り返した後を想定して、確保順と走査順をばらばらにする
+    {
+        std::vector<std::unique_ptr<LegacyObject>> objects(object_count);
+        for (size_t i = 0; i < object_count; ++i) {
+            objects[i] = std::make_unique<LegacyObject>();
+            objects[i]->velocity = { next() - 0.5f, 0.0f, next() - 0.5f };
+            objects[i]->rigidbody = std::make_unique<LegacyRigidbody>();
+            objects[i]->rigidbody->drag = 0.1f;
+        }
+        for (size_t i = object_count; i > 1; --i) {
+            std::swap(objects[i - 1], objects[static_cast<size_t>(next() * static_cast<float>(i - 1))]);
+        }
+
+        auto update = [&]() {
+            for (const std::unique_ptr<LegacyObject>& obj : objects) {
+                if (!obj->active) continue;
+
+                LegacyRigidbody* rb = obj->rigidbody.get();
+                if (rb && rb->is_enabled && !rb->is_kinematic) {
+                    if (rb->use_gravity) {
+                        obj->velocity.x += gravity.x * elapsed_time;
+                        obj->velocity.y += gravity.y * elapsed_time;
+                        obj->velocity.z += gravity.z * elapsed_time;
+                    }
+                    if (rb->drag > 0.0f) {
+                        const float drag_factor = 1.0f / (1.0f + rb->drag * elapsed_time);
+                        obj->velocity.x *= drag_factor;
+                        obj->velocity.y *= drag_factor;
+                        obj->velocity.z *= drag_factor;
+                    }
+                }
+            }
+            for (const std::unique_ptr<LegacyObject>& obj : objects) {
+                if (!obj->active) continue;
+
+                obj->elapsed_time += elapsed_time;
+                DirectX::XMVECTOR position = DirectX::XMLoadFloat3(&obj->position);
+                DirectX::XMVECTOR velocity = DirectX::XMLoadFloat3(&obj->velocity);
+                position = DirectX::XMVectorAdd(position, DirectX::XMVectorScale(velocity, elapsed_time));
+                DirectX::XMStoreFloat3(&obj->position, position);
+            }
+        };
+
+        update();
+        Benchmark benchmark;
+        benchmark.begin();
+        for (int i = 0; i < iterations; ++i) {
+            update();
+        }
+        result.aos_seconds = benchmark.end() / static_cast<float>(iterations);
+    }
+
+    // 連続配列: 共有のストレージを汚さないように専用のインスタンスで計測する
+    {
+        TransformStorage storage;
+        const uint16_t world_id = 1;
+        for (size_t i = 0; i < object_count; ++i) {
+            const uint32_t slot = storage.Allocate();
+            storage.Velocity(slot) = { next() - 0.5f, 0.0f, next() - 0.5f };
+            storage.GravityScale(slot) = 1.0f;
+            storage.Drag(slot) = 0.1f;
+            storage.WorldId(slot) = world_id;
+        }
+
+        const uint32_t slot_end = storage.GetSlotEnd();
+        auto update = [&]() {
+            storage.ApplyPhysics(world_id, 0, slot_end, elapsed_time, gravity);
+            storage.ForEachChunkRange(0, slot_end, [](Chunk& chunk, uint32_t first, uint32_t last) {
+                for (uint32_t i = first; i < last; ++i) {
+                    chunk.flags[i] |= kFlagIntegrate;
+                }
+            });
+            storage.Integrate(world_id, 0, slot_end, elapsed_time);
+        };
+
+        update();
+        Benchmark benchmark;
+        benchmark.begin();
+        for (int i = 0; i < iterations; ++i) {
+            update();
+        }
+        result.soa_seconds = benchmark.end() / static_cast<float>(iterations);
+    }
+
+    return result;
+}
@@ -0,0 +1,204 @@
+#ifndef TRANSFORM_STORAGE_H_
+#define TRANSFORM_STORAGE_H_
+
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <DirectXMath.h>
+
+/**
+ * @class TransformStorage
+ * @brief ゲームオブジェクトの毎フレーム更新するデータを成分ごとの連続配列で保持するシングルトンクラス
+ *
+ * 位置、速度、行列、コライダーの外接球、リジッドボディの係数を成分ごとに配列へまとめ、
+ * スロット番号で参照します。GameObject はスロットを1つ持ち、従来のメンバは配列要素への参照になります。
+ * 配列は固定長のチャンク単位で確保し、確保済みの要素は移動しないので参照は破棄まで有効です。
+ *
+ * World の一括処理は所属する World の識別子を見てからほかの成分を読みます。
+ * 確保したスロットの World への登録は保留しておき、メインスレッドの同期点(PublishPendingSlots())で反映するので、
+ * 一括処理は対象のスロットにしか書き込まないので、読み込みスレッドでオブジェクトを生成しても同じスロットを同時に触りません。
+ */
+class TransformStorage {
+public:
+    static constexpr uint32_t kChunkShift = 10; ///< チャンクあたりのスロット数(2の冪)
+    static constexpr uint32_t kChunkSize = 1u << kChunkShift;
+    static constexpr uint32_t kChunkMask = kChunkSize - 1;
+    static constexpr uint32_t kMaxChunks = 1024; ///< 最大スロット数は kChunkSize * kMaxChunks
+
+    /**
+     * @brief スロットのフラグ
+     */
+    enum Flag : uint8_t {
+        kFlagAllocated = 1 << 0, ///< 使用中
+        kFlagActive = 1 << 1,    ///< オブジェクトがアクティブ
+        kFlagIntegrate = 1 << 2, ///< このフレームで座標を積分する(積分後に下ろす)
+    };
+
+    /**
+     * @struct Chunk
+     * @brief 成分ごとの配列
+     */
+    struct Chunk {
+        DirectX::XMFLOAT3 position[kChunkSize];         ///< ローカル座標
+        DirectX::XMFLOAT3 angle[kChunkSize];            ///< 回転角（ラジアン）
+        DirectX::XMFLOAT3 scale[kChunkSize];            ///< スケール
+        DirectX::XMFLOAT3 velocity[kChunkSize];         ///< 速度
+        DirectX::XMFLOAT4X4 local_transform[kChunkSize]; ///< ローカル変換行列
+        DirectX::XMFLOAT4X4 world_transform[kChunkSize]; ///< ワールド変換行列(World の更新時に計算)
+        DirectX::XMFLOAT4 bounds[kChunkSize];           ///< コライダー全体の外接球(xyz: 中心, w: 半径。未計算や変更後は無限大)
+        float elapsed_time[kChunkSize];                 ///< 経過時間
+        float gravity_scale[kChunkSize];                ///< 重力を受けるなら1、受けないなら0
+        float drag[kChunkSize];                         ///< 抵抗係数(抵抗を受けないなら0)
+        uint16_t world_id[kChunkSize];                  ///< 所属する World(0 は未所属)
+        uint8_t flags[kChunkSize];                      ///< Flag の組み合わせ
+    };
+
+    /**
+     * @struct BenchmarkResult
+     * @brief レイアウト比較ベンチマークの結果
+     */
+    struct BenchmarkResult {
+        size_t object_count = 0;  ///< オブジェクト数
+        float aos_seconds = 0.0f; ///< オブジェクトごとに個別確保した場合の1フレームあたりの時間
+        float soa_seconds = 0.0f; ///< 連続配列をまとめて処理した場合の1フレームあたりの時間
+    };
+
+    /**
+     * @brief シングルトンインスタンスを取得
+     * @return TransformStorage& インスタンスへの参照
+     */
+    static TransformStorage& Instance();
+
+    /**
+     * @brief スロットを確保して初期値を設定
+     * @return uint32_t スロット番号
+     */
+    uint32_t Allocate();
+
+    /**
+     * @brief スロットを解放
+     * @param slot スロット番号
+     */
+    void Free(uint32_t slot);
+
+    /**
+     * @brief スロットを World に登録する(反映は PublishPendingSlots() まで保留)
+     * @param slot スロット番号
+     * @param world_id 所属する World
+     *
+     * どのスレッドからでも呼べます。
+     */
+    void AssignWorld(uint32_t slot, uint16_t world_id);
+
+    /**
+     * @brief 保留中の登録を反映し、一括処理の対象にする
+     *
+     * 一括処理が走っていない同期点で、World を更新するスレッドから呼びます。
+     */
+    void PublishPendingSlots();
+
+    /**
+     * @brief 使用したことのあるスロット番号の上限を取得
+     * @return uint32_t [0, 戻り値) を走査すれば全ての使用中スロットを含む
+     */
+    uint32_t GetSlotEnd() const { return slot_end_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 使用中のスロット数を取得
+     * @return uint32_t スロット数
+     */
+    uint32_t GetAllocatedCount() const { return allocated_count_.load(std::memory_order_relaxed); }
+
+    DirectX::XMFLOAT3& Position(uint32_t slot) { return GetChunk(slot).position[slot & kChunkMask]; }
+    DirectX::XMFLOAT3& Angle(uint32_t slot) { return GetChunk(slot).angle[slot & kChunkMask]; }
+    DirectX::XMFLOAT3& Scale(uint32_t slot) { return GetChunk(slot).scale[slot & kChunkMask]; }
+    DirectX::XMFLOAT3& Velocity(uint32_t slot) { return GetChunk(slot).velocity[slot & kChunkMask]; }
+    DirectX::XMFLOAT4X4& LocalTransform(uint32_t slot) { return GetChunk(slot).local_transform[slot & kChunkMask]; }
+    DirectX::XMFLOAT4X4& WorldTransform(uint32_t slot) { return GetChunk(slot).world_transform[slot & kChunkMask]; }
+    DirectX::XMFLOAT4& Bounds(uint32_t slot) { return GetChunk(slot).bounds[slot & kChunkMask]; }
+    float& ElapsedTime(uint32_t slot) { return GetChunk(slot).elapsed_time[slot & kChunkMask]; }
+    float& GravityScale(uint32_t slot) { return GetChunk(slot).gravity_scale[slot & kChunkMask]; }
+    float& Drag(uint32_t slot) { return GetChunk(slot).drag[slot & kChunkMask]; }
+    uint16_t& WorldId(uint32_t slot) { return GetChunk(slot).world_id[slot & kChunkMask]; }
+    uint8_t& Flags(uint32_t slot) { return GetChunk(slot).flags[slot & kChunkMask]; }
+
+    /**
+     * @brief 重力と抵抗を速度に適用
+     * @param world_id 対象の World
+     * @param begin 先頭スロット
+     * @param end 終端スロット(含まない)
+     * @param elapsed_time 経過時間
+     * @param gravity 重力ベクトル
+     *
+     * 指定した World に属するアクティブなスロットを連続配列のまま順に処理します。
+     * XMFLOAT3 が隙間なく並ぶので、4スロット分の xyz (12要素) を3つのベクターで読み、4スロットずつ計算します。
+     * まとめて読み書きするのは4つとも対象の組だけで、ほかは対象のスロットだけを1つずつ書き換えます。
+     */
+    void ApplyPhysics(uint16_t world_id, uint32_t begin, uint32_t end,
+        float elapsed_time, const DirectX::XMFLOAT3& gravity);
+
+    /**
+     * @brief 積分フラグの立ったスロットの座標を速度で積分
+     * @param world_id 対象の World
+     * @param begin 先頭スロット
+     * @param end 終端スロット(含まない)
+     * @param elapsed_time 経過時間
+     *
+     * ApplyPhysics() と同じく4スロットずつ計算します。
+     */
+    void Integrate(uint16_t world_id, uint32_t begin, uint32_t end, float elapsed_time);
+
+    /**
+     * @brief 2つの外接球が重なるか
+     * @param a 外接球A
+     * @param b 外接球B
+     * @return bool 重なる可能性がある場合true（半径が無限大なら常にtrue）
+     */
+    static bool BoundsOverlap(const DirectX::XMFLOAT4& a, const DirectX::XMFLOAT4& b);
+
+    /**
+     * @brief オブジェクトごとに個別確保した配置と連続配列で、物理演算と積分の時間を比較
+     * @param object_count オブジェクト数
+     * @param iterations 計測するフレーム数
+     * @return BenchmarkResult 計測結果
+     */
+    static BenchmarkResult RunBenchmark(size_t object_count, int iterations = 10);
+
+private:
+    TransformStorage() = default;
+    ~TransformStorage() = default;
+    TransformStorage(const TransformStorage&) = delete;
+    TransformStorage& operator=(const TransformStorage&) = delete;
+
+    /**
+     * @brief スロットの属するチャンクを取得
+     */
+    Chunk& GetChunk(uint32_t slot) { return *chunks_[slot >> kChunkShift]; }
+
+    /**
+     * @brief [begin, end) をチャンクの境界で区切って処理
+     */
+    template<typename Function>
+    void ForEachChunkRange(uint32_t begin, uint32_t end, Function function);
+
+    std::mutex mutex_; ///< 確保と解放の排他
+    std::unique_ptr<Chunk> chunks_[kMaxChunks]; ///< チャンク(確保後は移動しない)
+    /**
+     * @struct PendingSlot
+     * @brief World への登録を保留中のスロット
+     */
+    struct PendingSlot {
+        uint32_t slot;     ///< スロット番号
+        uint16_t world_id; ///< 所属する World
+    };
+
+    std::vector<uint32_t> free_slots_; ///< 解放済みスロット
+    std::vector<PendingSlot> pending_slots_; ///< World への登録を保留中のスロット
+    std::atomic<uint32_t> slot_end_ = 0; ///< 使用したことのあるスロット番号の上限
+    std::atomic<uint32_t> allocated_count_ = 0; ///< 使用中のスロット数
+};
+
+#endif  // TRANSFORM_STORAGE_H_
@@ -19,7 +19,7 @@ UiButton::UiButton(const char* file_name,
     visual_config_(ButtonVisualConfig::Default()),
     on_click_callback_(std::move(on_click_callback)) {
 
-    // Ԃ̃At@l normal_alpha ɐݒ
+    // 初期状態のアルファ値を normal_alpha に設定
     SetAlphaImmediate(visual_config_.normal_alpha);
 }
 
@@ -43,7 +43,7 @@ UiButton::UiButton(const char* file_name,
     visual_config_(ButtonVisualConfig::Default()),
     on_click_callback_(std::move(on_click_callback)) {
 
-    // Ԃ̃At@l normal_alpha ɐݒ
+    // 初期状態のアルファ値を normal_alpha に設定
     SetAlphaImmediate(visual_config_.normal_alpha);
 }
 
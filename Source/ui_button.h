@@ -7,27 +7,27 @@
 #include "render_layer.h"
 
 /**
- * @brief {^̌ڂɊւݒ\
+ * @brief ボタンの見た目に関する設定構造体
  *
- * zo[ԁ^ʏԂł̃TCYωуAt@l`B
+ * ホバー状態／通常状態でのサイズ変化およびアルファ値を定義する。
  */
 struct ButtonVisualConfig {
-    /** ʏ펞̃TCYItZbg */
+    /** 通常時のサイズオフセット */
     DirectX::XMFLOAT2 normal_size_offset;
 
-    /** zo[̃TCYItZbg */
+    /** ホバー時のサイズオフセット */
     DirectX::XMFLOAT2 hover_size_offset;
 
-    /** ʏ펞̃At@l */
+    /** 通常時のアルファ値 */
     float normal_alpha;
 
-    /** zo[̃At@l */
+    /** ホバー時のアルファ値 */
     float hover_alpha;
 
     /**
-     * @brief ftHg̃{^\ݒ擾
+     * @brief デフォルトのボタン表示設定を取得する
      *
-     * @return ftHgݒ
+     * @return デフォルト設定
      */
     static ButtonVisualConfig Default() {
         return {
@@ -40,25 +40,25 @@ struct ButtonVisualConfig {
 };
 
 /**
- * @brief NbN\UI{^NX
+ * @brief クリック可能なUIボタンクラス
  *
- * }EXJ[\ɂzo[ANbNsA
- * oʁiTCYEAt@ωjуR[obNsǗB
+ * マウスカーソルによるホバー判定、クリック判定を行い、
+ * 視覚効果（サイズ・アルファ変化）およびコールバック実行を管理する。
  */
 class UiButton : public UiElement {
 public:
     /**
-     * @brief UiButton RXgN^iqbg̈悪TCYƓ̏ꍇj
+     * @brief UiButton コンストラクタ（ヒット領域がサイズと同一の場合）
      *
-     * @param file_name XvCg̃t@C
-     * @param position \ʒu
-     * @param size \TCY
-     * @param sprite_position XvCg؂ʒu
-     * @param sprite_size XvCg؂TCY
-     * @param action_id {^ɕRÂANVID
-     * @param on_click_callback NbNɎsR[obN
-     * @param layer `惌C[
-     * @param is_valid LtO
+     * @param file_name スプライトのファイル名
+     * @param position 表示位置
+     * @param size 表示サイズ
+     * @param sprite_position スプライト内切り取り位置
+     * @param sprite_size スプライト内切り取りサイズ
+     * @param action_id ボタンに紐づくアクションID
+     * @param on_click_callback クリック時に実行されるコールバック
+     * @param layer 描画レイヤー
+     * @param is_valid 有効フラグ
      */
     UiButton(const char* file_name = "",
         DirectX::XMFLOAT2 position = { 0, 0 },
@@ -71,21 +71,21 @@ public:
         bool is_valid = true);
 
     /**
-     * @brief UiButton RXgN^iqbg̈ʎwj
+     * @brief UiButton コンストラクタ（ヒット領域を個別指定）
      *
-     * ڂƓ蔻𕪗ꍇɎgpB
+     * 見た目と当たり判定を分離したい場合に使用する。
      *
-     * @param file_name XvCg̃t@C
-     * @param position \ʒu
-     * @param size \TCY
-     * @param sprite_position XvCg؂ʒu
-     * @param sprite_size XvCg؂TCY
-     * @param hit_area_position qbg̈̈ʒu
-     * @param hit_area_size qbg̈̃TCY
-     * @param action_id {^ɕRÂANVID
-     * @param on_click_callback NbNɎsR[obN
-     * @param layer `惌C[
-     * @param is_valid LtO
+     * @param file_name スプライトのファイル名
+     * @param position 表示位置
+     * @param size 表示サイズ
+     * @param sprite_position スプライト内切り取り位置
+     * @param sprite_size スプライト内切り取りサイズ
+     * @param hit_area_position ヒット領域の位置
+     * @param hit_area_size ヒット領域のサイズ
+     * @param action_id ボタンに紐づくアクションID
+     * @param on_click_callback クリック時に実行されるコールバック
+     * @param layer 描画レイヤー
+     * @param is_valid 有効フラグ
      */
     UiButton(const char* file_name = "",
         DirectX::XMFLOAT2 position = { 0, 0 },
@@ -100,98 +100,98 @@ public:
         bool is_valid = true);
 
     /**
-     * @brief J[\ʒuzo[ԂXV
+     * @brief カーソル位置からホバー状態を更新する
      *
-     * @param cursor_position ݂̃J[\ʒu
+     * @param cursor_position 現在のカーソル位置
      */
     void UpdateHoverState(const DirectX::XMFLOAT2& cursor_position);
 
     /**
-     * @brief NbN̏s
+     * @brief クリック時の処理を実行する
      *
-     * o^ꂽNbNR[obNĂяoB
+     * 登録されたクリックコールバックが呼び出される。
      */
     void ExecuteOnClick();
 
     /**
-     * @brief {^ʒuݒ肷
+     * @brief ボタン位置を設定する
      *
-     * qbg̈̈ʒuɍXVB
+     * ヒット領域の位置も同時に更新される。
      *
-     * @param position Vʒu
+     * @param position 新しい位置
      */
     void SetPosition(const DirectX::XMFLOAT2& position) override;
 
     /**
-     * @brief NbÑR[obNݒ肷
+     * @brief クリック時のコールバックを設定する
      *
-     * @param callback s֐
+     * @param callback 実行する関数
      */
     void SetOnClickCallback(std::function<void()> callback);
 
     /**
-     * @brief zo[JñR[obNݒ肷
+     * @brief ホバー開始時のコールバックを設定する
      *
-     * @param callback s֐
+     * @param callback 実行する関数
      */
     void SetOnHoverCallback(std::function<void()> callback);
 
     /**
-     * @brief {^̎oʐݒύX
+     * @brief ボタンの視覚効果設定を変更する
      *
-     * @param config oݒ
+     * @param config 視覚設定
      */
     void SetVisualConfig(const ButtonVisualConfig& config);
 
     /**
-     * @brief ANVID擾
+     * @brief アクションIDを取得する
      *
-     * @return ANVID
+     * @return アクションID
      */
     int GetActionId() const { return action_id_; }
 
     /**
-     * @brief ݃zo[Ԃǂ擾
+     * @brief 現在ホバー状態かどうかを取得する
      *
-     * @return true ̏ꍇzo[
+     * @return true の場合ホバー中
      */
     bool IsHovered() const { return is_hovered_; }
 
 private:
     /**
-     * @brief w肳ꂽʒuqbg̈肷
+     * @brief 指定された位置がヒット領域内か判定する
      *
-     * @param point_position 肷ʒu
-     * @return true ̏ꍇqbg
+     * @param point_position 判定する位置
+     * @return true の場合ヒット
      */
     bool TestHit(const DirectX::XMFLOAT2& point_position) const;
 
     /**
-     * @brief ݂̏ԂɉoʂKp
+     * @brief 現在の状態に応じた視覚効果を適用する
      *
-     * TCYItZbgуAt@l̕ύXsB
+     * サイズオフセットおよびアルファ値の変更を行う。
      */
     void ApplyVisualEffects();
 
-    /** qbg̈̈ʒu */
+    /** ヒット領域の位置 */
     DirectX::XMFLOAT2 hit_area_position_;
 
-    /** qbg̈̃TCY */
+    /** ヒット領域のサイズ */
     DirectX::XMFLOAT2 hit_area_size_;
 
-    /** {^ʗpANVID */
+    /** ボタン識別用アクションID */
     int action_id_;
 
-    /** zo[ԃtO */
+    /** ホバー状態フラグ */
     bool is_hovered_;
 
-    /** oʐݒ */
+    /** 視覚効果設定 */
     ButtonVisualConfig visual_config_;
 
-    /** NbNR[obN */
+    /** クリック時コールバック */
     std::function<void()> on_click_callback_;
 
-    /** zo[JnR[obN */
+    /** ホバー開始時コールバック */
     std::function<void()> on_hover_callback_;
 };
 
@@ -1,6 +1,7 @@
 #include "ui_element.h"
 #include <System/Sprite.h>
 #include <System/graphics.h>
+#include <System/SpriteBatch.h>
 
 UiElement::UiElement(const char* file_name, DirectX::XMFLOAT2 position,
     DirectX::XMFLOAT2 size, DirectX::XMFLOAT2 sprite_position,
@@ -17,6 +18,13 @@ UiElement::UiElement(const char* file_name, DirectX::XMFLOAT2 position,
 }
 
 void UiElement::Render(ID3D11DeviceContext* dc) {
+    SpriteBatch* batch = Graphics::Instance().GetSpriteBatch();
+    batch->Begin(dc);
+    Render(batch);
+    batch->End();
+}
+
+void UiElement::Render(SpriteBatch* batch) {
     if (!is_valid_) {
         return;
     }
@@ -26,7 +34,7 @@ void UiElement::Render(ID3D11DeviceContext* dc) {
         return;
     }
 
-    sprite_->Render(dc,
+    batch->Draw(sprite_.get(), render_layer_,
         position_.x + size_offset_.x,
         position_.y + size_offset_.y,
         0.0f,
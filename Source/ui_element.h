@@ -7,27 +7,28 @@
 #include "render_layer.h"
 
 class Sprite;
+class SpriteBatch;
 struct ID3D11DeviceContext;
 
 /**
- * @brief UIɕ`悳{vfNX
+ * @brief UI上に描画される基本要素クラス
  *
- * XvCg`AʒuETCYǗA`惌C[A
- * At@lуAt@Z̃gWV@\񋟂B
- * UIvf͂̃NXpĎ邱Ƃz肵ĂB
+ * スプライト描画、位置・サイズ管理、描画レイヤー、
+ * アルファ値およびアルファ乗算のトランジション機能を提供する。
+ * 他のUI要素はこのクラスを継承して実装されることを想定している。
  */
 class UiElement {
 public:
     /**
-     * @brief UiElement ̃RXgN^
+     * @brief UiElement のコンストラクタ
      *
-     * @param file_name gpXvCg̃t@C
-     * @param position UIł̕\ʒu
-     * @param size UIvf̕\TCY
-     * @param sprite_position XvCgł̐؂Jnʒu
-     * @param sprite_size XvCgł̐؂TCY
-     * @param layer `惌C[
-     * @param is_valid vfLǂ
+     * @param file_name 使用するスプライトのファイル名
+     * @param position UI上での表示位置
+     * @param size UI要素の表示サイズ
+     * @param sprite_position スプライト内での切り取り開始位置
+     * @param sprite_size スプライト内での切り取りサイズ
+     * @param layer 描画レイヤー
+     * @param is_valid 要素が有効かどうか
      */
     UiElement(const char* file_name = "",
         DirectX::XMFLOAT2 position = { 0, 0 },
@@ -38,197 +39,206 @@ public:
         bool is_valid = true);
 
     /**
-     * @brief zfXgN^
+     * @brief 仮想デストラクタ
      */
     virtual ~UiElement() = default;
 
     /**
-     * @brief UIvf`悷
+     * @brief UI要素を描画する
      *
-     * @param dc DirectX foCXReLXg
+     * @param dc DirectX デバイスコンテキスト
      */
     virtual void Render(ID3D11DeviceContext* dc);
 
     /**
-     * @brief XvCgݒ肷
+     * @brief UI要素をスプライトバッチに登録する
      *
-     * @param file_name XvCg̃t@C
+     * 描画レイヤーをそのままバッチの並べ替えに使う。
+     *
+     * @param batch 描画中のスプライトバッチ
+     */
+    virtual void Render(SpriteBatch* batch);
+
+    /**
+     * @brief スプライトを設定する
+     *
+     * @param file_name スプライトのファイル名
      */
     void SetSprite(const char* file_name);
 
     /**
-     * @brief ݐݒ肳ĂXvCg擾
+     * @brief 現在設定されているスプライトを取得する
      *
-     * @return Sprite |C^inullptr ̉\j
+     * @return Sprite ポインタ（nullptr の可能性あり）
      */
     Sprite* GetSprite() const;
 
     /**
-     * @brief At@l̃gWVJn
+     * @brief アルファ値のトランジションを開始する
      *
-     * @param target_alpha ڕWAt@l
-     * @param duration Jڎԁibj
-     * @param ease C[WO^Cv
+     * @param target_alpha 目標アルファ値
+     * @param duration 遷移時間（秒）
+     * @param ease イージングタイプ
      */
     void StartAlphaTransition(float target_alpha,
         float duration,
         EaseType ease = EaseType::EaseOutQuad);
 
     /**
-     * @brief At@Zl̃gWVJn
+     * @brief アルファ乗算値のトランジションを開始する
      *
-     * @param target_multiplier ڕWZl
-     * @param duration Jڎԁibj
-     * @param ease C[WO^Cv
+     * @param target_multiplier 目標乗算値
+     * @param duration 遷移時間（秒）
+     * @param ease イージングタイプ
      */
     void StartAlphaMultiplierTransition(float target_multiplier,
         float duration,
         EaseType ease = EaseType::EaseOutQuad);
 
     /**
-     * @brief At@l𑦍ɐݒ肷
+     * @brief アルファ値を即座に設定する
      *
-     * gWVɑfB
+     * トランジションを介さずに即時反映される。
      *
-     * @param alpha ݒ肷At@l
+     * @param alpha 設定するアルファ値
      */
     void SetAlphaImmediate(float alpha);
 
     /**
-     * @brief At@Zlݒ肷
+     * @brief アルファ乗算値を設定する
      *
-     * @param multiplier Zl
+     * @param multiplier 乗算値
      */
     void SetAlphaMultiplier(float multiplier);
 
     /**
-     * @brief UIvf̈ʒuݒ肷
+     * @brief UI要素の位置を設定する
      *
-     * @param position Vʒu
+     * @param position 新しい位置
      */
     virtual void SetPosition(const DirectX::XMFLOAT2& position) { position_ = position; }
 
     /**
-     * @brief UIvf̃TCYݒ肷
+     * @brief UI要素のサイズを設定する
      *
-     * @param size VTCY
+     * @param size 新しいサイズ
      */
     void SetSize(const DirectX::XMFLOAT2& size) { size_ = size; }
 
     /**
-     * @brief UIvf̐Fݒ肷
+     * @brief UI要素の色を設定する
      *
-     * @param color RGBAJ[
+     * @param color RGBAカラー
      */
     void SetColor(const DirectX::XMFLOAT4& color) { color_ = color; }
 
     /**
-     * @brief UIvf̗LEݒ肷
+     * @brief UI要素の有効・無効を設定する
      *
-     * @param is_valid true ̏ꍇ`ΏۂƂȂ
+     * @param is_valid true の場合描画対象となる
      */
     void SetValid(bool is_valid) { is_valid_ = is_valid; }
 
     /**
-     * @brief `惌C[ݒ肷
+     * @brief 描画レイヤーを設定する
      *
-     * @param render_layer C[l
+     * @param render_layer レイヤー値
      */
     void SetRenderLayer(int render_layer) { render_layer_ = render_layer; }
 
     /**
-     * @brief XvCg̕\Jnʒuݒ肷
+     * @brief スプライト内の表示開始位置を設定する
      *
-     * @param sprite_position XvCgW
+     * @param sprite_position スプライト内座標
      */
     void SetSpritePosition(const DirectX::XMFLOAT2& sprite_position) {
         sprite_position_ = sprite_position;
     }
 
     /**
-     * @brief XvCg̕\TCYݒ肷
+     * @brief スプライト内の表示サイズを設定する
      *
-     * @param sprite_size XvCgTCY
+     * @param sprite_size スプライトサイズ
      */
     void SetSpriteSize(const DirectX::XMFLOAT2& sprite_size) {
         sprite_size_ = sprite_size;
     }
 
     /**
-     * @brief ݂̈ʒu擾
+     * @brief 現在の位置を取得する
      *
-     * @return ʒu
+     * @return 位置
      */
     const DirectX::XMFLOAT2& GetPosition() const { return position_; }
 
     /**
-     * @brief ݂̃TCY擾
+     * @brief 現在のサイズを取得する
      *
-     * @return TCY
+     * @return サイズ
      */
     const DirectX::XMFLOAT2& GetSize() const { return size_; }
 
     /**
-     * @brief `惌C[擾
+     * @brief 描画レイヤーを取得する
      *
-     * @return C[l
+     * @return レイヤー値
      */
     int GetRenderLayer() const { return render_layer_; }
 
     /**
-     * @brief LԂǂ擾
+     * @brief 有効状態かどうかを取得する
      *
-     * @return true ̏ꍇL
+     * @return true の場合有効
      */
     bool IsValid() const { return is_valid_; }
 
 protected:
     /**
-     * @brief ۂɕ`ɎgpAt@lvZ
+     * @brief 実際に描画に使用するアルファ値を計算する
      *
-     * current_alpha_  alpha_multiplier_ lB
+     * current_alpha_ と alpha_multiplier_ を考慮する。
      *
-     * @return vZ̃At@l
+     * @return 計算後のアルファ値
      */
     float CalculateAlpha() const;
 
-    /** XvCg */
+    /** スプライト */
     std::unique_ptr<Sprite> sprite_;
 
-    /** UIvf̈ʒu */
+    /** UI要素の位置 */
     DirectX::XMFLOAT2 position_;
 
-    /** UIvf̃TCY */
+    /** UI要素のサイズ */
     DirectX::XMFLOAT2 size_;
 
-    /** XvCg̕\Jnʒu */
+    /** スプライト内の表示開始位置 */
     DirectX::XMFLOAT2 sprite_position_;
 
-    /** XvCg̕\TCY */
+    /** スプライト内の表示サイズ */
     DirectX::XMFLOAT2 sprite_size_;
 
-    /** `J[iRGBAj */
+    /** 描画カラー（RGBA） */
     DirectX::XMFLOAT4 color_ = { 1.0f, 1.0f, 1.0f, 1.0f };
 
-    /** `惌C[ */
+    /** 描画レイヤー */
     int render_layer_;
 
-    /** LtO */
+    /** 有効フラグ */
     bool is_valid_;
 
-    /** TCYpItZbg */
+    /** サイズ調整用オフセット */
     DirectX::XMFLOAT2 size_offset_ = { 0.0f, 0.0f };
 
-    /** ݂̃At@l */
+    /** 現在のアルファ値 */
     float current_alpha_ = 1.0f;
 
-    /** At@Zl */
+    /** アルファ乗算値 */
     float alpha_multiplier_ = 1.0f;
 
-    /** At@lpgDC[ */
+    /** アルファ値用トゥイーン */
     FloatTween* alpha_tween_ = nullptr;
 
-    /** At@ZpgDC[ */
+    /** アルファ乗算用トゥイーン */
     FloatTween* multiplier_tween_ = nullptr;
 };
 
@@ -3,7 +3,7 @@
 
 class UiButton;
 
-// UICxg̎
+// UIイベントの種類
 enum class UiEventType {
     Click,
     PressBegin,
@@ -12,7 +12,7 @@ enum class UiEventType {
     HoverEnd
 };
 
-// UICxg
+// UIイベント
 struct UiEvent {
     UiEventType type;
     UiButton* button;
@@ -23,7 +23,7 @@ struct UiEvent {
     }
 };
 
-// j[wi[h
+// メニュー背景モード
 namespace MenuBackgroundMode {
     constexpr int kBackgroundVisible = 0;
     constexpr int kBackgroundHidden = 1;
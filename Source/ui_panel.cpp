@@ -6,6 +6,7 @@
 #include <ranges>
 #include "input_manager.h"
 #include "render_layer.h"
+#include "System/SpriteBatch.h"
 
 UiPanel::UiPanel()
 {
@@ -44,10 +45,10 @@ void UiPanel::Update() {
 void UiPanel::HandleInput() {
     const DirectX::XMFLOAT2 cursor_position = InputManager::Instance().GetCursorPosition();
 
-    // ׂẴ{^̃zo[ԂXV
+    // すべてのボタンのホバー状態を更新
     UpdateButtonStates();
 
-    // }EX{^ꂽu
+    // マウスボタンが押された瞬間
     if (InputManager::Instance().IsMouseButtonDown(0)) { // Left button
         if (hovered_button_) {
             pressed_button_ = hovered_button_;
@@ -55,12 +56,12 @@ void UiPanel::HandleInput() {
         }
     }
 
-    // }EX{^ꂽu
+    // マウスボタンが離された瞬間
     if (InputManager::Instance().IsMouseButtonUp(0)) {
         if (pressed_button_) {
             EnqueueEvent(UiEventType::PressEnd, pressed_button_);
 
-            // {^Ɠ{^ŗꂽꍇ̓NbN
+            // 押したボタンと同じボタン上で離された場合はクリック
             if (pressed_button_ == hovered_button_) {
                 EnqueueEvent(UiEventType::Click, pressed_button_);
                 pressed_button_->ExecuteOnClick();
@@ -75,7 +76,7 @@ void UiPanel::UpdateButtonStates() {
     const DirectX::XMFLOAT2 cursor_position = InputManager::Instance().GetCursorPosition();
     UiButton* new_hovered_button = nullptr;
 
-    // tŔĩC[Dj
+    // 逆順で判定（上のレイヤーが優先）
     for (auto& button : std::ranges::reverse_view(buttons_)) {
         if (!button->IsValid()) {
             continue;
@@ -88,7 +89,7 @@ void UiPanel::UpdateButtonStates() {
         }
     }
 
-    // zo[Ԃ̕ωoăCxg
+    // ホバー状態の変化を検出してイベント生成
     if (new_hovered_button != hovered_button_) {
         if (hovered_button_) {
             EnqueueEvent(UiEventType::HoverEnd, hovered_button_);
@@ -118,28 +119,34 @@ void UiPanel::Render(ID3D11DeviceContext* dc, int background_mode,
         return;
     }
 
-    // wĩ_O
+    // パネル内の要素はまとめて登録し、レイヤーとテクスチャごとに描画する
+    SpriteBatch* batch = Graphics::Instance().GetSpriteBatch();
+    batch->Begin(dc);
+
+    // 背景のレンダリング
     if (has_background_ && background_element_ &&
         background_mode == MenuBackgroundMode::kBackgroundVisible) {
         background_element_->SetColor(background_color_);
-        background_element_->Render(dc);
+        background_element_->Render(batch);
     }
 
-    // XvCg̃_O
+    // スプライトのレンダリング
     for (auto& sprite : sprites_) {
         if (!sprite->IsValid()) {
             continue;
         }
-        sprite->Render(dc);
+        sprite->Render(batch);
     }
 
-    // {^̃_O
+    // ボタンのレンダリング
     for (auto& button : buttons_) {
         if (!button->IsValid()) {
             continue;
         }
-        button->Render(dc);
+        button->Render(batch);
     }
+
+    batch->End();
 }
 
 void UiPanel::ChangeSpritesColor(const DirectX::XMFLOAT4& color) {
@@ -149,7 +156,7 @@ void UiPanel::ChangeSpritesColor(const DirectX::XMFLOAT4& color) {
 }
 
 void UiPanel::FadeIn(float duration, EaseType ease) {
-    // WgăplŜtF[h
+    // 係数を使ってパネル全体をフェード
     if (background_element_) {
         background_element_->StartAlphaMultiplierTransition(1.0f, duration, ease);
     }
@@ -164,7 +171,7 @@ void UiPanel::FadeIn(float duration, EaseType ease) {
 }
 
 void UiPanel::FadeOut(float duration, EaseType ease) {
-    // WgăplŜtF[h
+    // 係数を使ってパネル全体をフェード
     if (background_element_) {
         background_element_->StartAlphaMultiplierTransition(0.0f, duration, ease);
     }
@@ -52,31 +52,31 @@ public:
         return sprite_ptr;
     }
 
-    // XV
+    // 更新
     void Update();
 
-    // _O
+    // レンダリング
     void Render(ID3D11DeviceContext* dc, int background_mode = MenuBackgroundMode::kBackgroundVisible,
         bool freeze_effects = false);
 
-    // plŜ̃tF[hC/AEg
+    // パネル全体のフェードイン/アウト
     void FadeIn(float duration = 0.5f, EaseType ease = EaseType::EaseOutCubic);
     void FadeOut(float duration = 0.5f, EaseType ease = EaseType::EaseInCubic);
 
-    // Cxg擾
+    // イベント取得
     std::vector<UiEvent> GetPendingEvents();
 
-    // XvCg̐FύX
+    // スプライトの色変更
     void ChangeSpritesColor(const DirectX::XMFLOAT4& color);
 
-    // wiTCYݒ
+    // 背景サイズ設定
     void SetBackgroundSize(const DirectX::XMFLOAT2& size);
 
-    // ANeBu
+    // アクティブ状態
     void SetActive(bool active) { is_active_ = active; }
     bool IsActive() const { return is_active_; }
 
-    // wiFݒ
+    // 背景色設定
     void SetBackgroundColor(const DirectX::XMFLOAT4& color) { background_color_ = color; }
 
 protected:
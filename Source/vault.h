@@ -1,5 +1,6 @@
 #pragma once
 #include "game_object.h"
+#include "world.h"
 #include "input_manager.h"
 #include "k_lerp.h"
 #include <imgui_logger.h>
@@ -10,28 +11,39 @@ public:
 
 	//}
 
+	Vault() { SetParallelUpdate(true); }
+
 	void Update(float elapsed_time) override 
+	{
+		// InputManager(初回はキーを登録する)と TweenManager は共有なので、並列更新の後の同期点で触る
+		GetWorld()->Defer([this]() { UpdateInput(); });
+	}
+
+private:
+	// 入力で Tween を始める(同期点で呼ばれる)
+	void UpdateInput()
 	{
 		if (InputManager::Instance().IsKeyDown('G')) {
 			auto * tw = TweenManager::Instance().AddTween<Float3Tween>(
-				&position_, // lerpΏەϐ̃|C^
-				position_, // Jnl
-				DirectX::XMFLOAT3{ position_.x + 1.0f, position_.y + 0.0f, position_.z + 2.0f }, // Il
-				1.2f, // pԁibj
-				EaseType::EaseInElastic // C[WO^Cv
+				&position_, // lerp対象変数のポインタ
+				position_, // 開始値
+				DirectX::XMFLOAT3{ position_.x + 1.0f, position_.y + 0.0f, position_.z + 2.0f }, // 終了値
+				1.2f, // 継続時間（秒）
+				EaseType::EaseInElastic // イージングタイプ
 			);
 			//tw->SetLoop(true);
 			//tw->SetYoyo(true); 
-			tw->SetOnComplete([this]() { // R[obN
+			tw->SetOnComplete([this]() { // 完了時コールバック
 				Log(u8"Vault: lerp Complete!");
 				});
 		}
 	}
 
+public:
 	void OnCollisionEnter(GameObject* other) override {
 		Log("Vault: Collision Enter!");
 
-		// Փˑ̏擾
+		// 衝突相手の情報を取得
 		if (other) {
 			DirectX::XMFLOAT3 other_pos = other->GetWorldPositionFloat3();
 			Log("Other object position: (%.2f, %.2f, %.2f)",
@@ -1,55 +1,441 @@
 #include "world.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include "game_object.h"
 #include "rigidbody.h"
 #include "collider.h"
+#include "transform_storage.h"
+#include "vault.h"
 #include "System/ModelRenderer.h"
+#include "System/HiZBuffer.h"
+#include "System/Graphics.h"
+#include "System/Profiler.h"
+#include "System/JobSystem.h"
+#include "System/Misc.h"
+
+namespace {
+
+// 遅延コマンドの呼び出し元(更新中のオブジェクトの登録順と、その中での呼び出し順)
+thread_local size_t t_deferred_order = SIZE_MAX;
+thread_local uint32_t t_deferred_sequence = 0;
+
+// 並列更新中の World(モデルと子へのトランスフォーム反映を保留する)
+thread_local const World* t_propagation_deferred_world = nullptr;
+
+// 再現性テスト用のオブジェクト
+// 自身は並列に更新し、他のオブジェクトへの影響は遅延コマンドで与える
+class ReplayTestObject : public GameObject {
+public:
+    ReplayTestObject(World* world, GameObjectHandle target) : world_(world), target_(target) {
+        SetParallelUpdate(true);
+    }
+
+    void Update(float elapsed_time) override {
+        Rotate(0.0f, elapsed_time, 0.0f);
+
+        if (GameObject* target = world_->Resolve(target_)) {
+            const DirectX::XMFLOAT3 push = { -position_.x * 0.01f, 0.0f, -position_.z * 0.01f };
+            world_->Defer([target, push]() { target->AddVelocity(push); });
+        }
+    }
+
+    void OnCollisionEnter(GameObject* other) override {
+        world_->Defer([this]() { velocity_.y = -velocity_.y * 0.5f; });
+    }
+
+private:
+    World* world_;
+    GameObjectHandle target_;
+};
+
+// コライダー全体を包む球の半径を求める(詳細判定より必ず大きくなるように見積もる)
+float ComputeBoundsRadius(const GameObject::ColliderList& colliders, const DirectX::XMFLOAT4X4& world_transform) {
+    float radius = 0.0f;
+    for (const Collider* collider : colliders) {
+        if (!collider) continue;
+
+        float extent = 0.0f;
+        switch (collider->GetType()) {
+        case ColliderType::kSphere:
+            extent = static_cast<const SphereCollider*>(collider)->GetRadius();
+            break;
+        case ColliderType::kBox: {
+            const DirectX::XMFLOAT3& size = static_cast<const BoxCollider*>(collider)->GetSize();
+            extent = 0.5f * std::sqrt(size.x * size.x + size.y * size.y + size.z * size.z);
+            break;
+        }
+        case ColliderType::kAABB: {
+            const DirectX::XMFLOAT3& size = static_cast<const AABBCollider*>(collider)->GetSize();
+            extent = 0.5f * std::sqrt(size.x * size.x + size.y * size.y + size.z * size.z);
+            break;
+        }
+        case ColliderType::kCylinder: {
+            const CylinderCollider* cylinder = static_cast<const CylinderCollider*>(collider);
+            extent = cylinder->GetRadius() + cylinder->GetHeight();
+            break;
+        }
+        }
+
+        const DirectX::XMFLOAT3& offset = collider->GetOffset();
+        const float offset_length = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+        radius = (std::max)(radius, offset_length + extent);
+    }
+
+    // ボックスとシリンダーはオーナーのスケールを受けるので、最大の軸スケールを掛けておく
+    const DirectX::XMMATRIX world = DirectX::XMLoadFloat4x4(&world_transform);
+    const float max_scale_sq = (std::max)({
+        DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(world.r[0])),
+        DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(world.r[1])),
+        DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(world.r[2])),
+        1.0f });
+    return radius * std::sqrt(max_scale_sq) * 1.001f + 0.001f;
+}
+
+}  // namespace
 
 World& World::Instance() {
     static World instance;
     return instance;
 }
 
-World::World() : gravity_(0.0f, -9.8f, 0.0f) {}
+World::World() : world_id_(next_world_id_++), gravity_(0.0f, -9.8f, 0.0f) {
+    // オブジェクトの破棄時にスロットとメモリを返すので、先に生成して後に破棄されるようにする
+    TransformStorage::Instance();
+    ObjectPool::Instance();
+}
+
+World::~World() {
+    // 管理表が先に破棄されないよう、オブジェクトを先に削除する
+    Clear();
+}
 
 GameObject* World::CreateObject(
     const char* model_filepath,
     const DirectX::XMFLOAT3& pos,
     const DirectX::XMFLOAT3& rotation,
     const DirectX::XMFLOAT3& scale) {
-    auto obj = std::make_unique<GameObject>(model_filepath, pos, rotation, scale);
+    // 基底クラスの Update() は何もしないので並列に更新してよい
+    GameObject* obj = AddObject(std::make_unique<GameObject>(model_filepath, pos, rotation, scale));
+    obj->SetParallelUpdate(true);
+    return obj;
+}
+
+GameObject* World::AddObject(std::unique_ptr<GameObject> obj) {
     GameObject* ptr = obj.get();
+    TransformStorage::Instance().AssignWorld(ptr->GetTransformSlot(), world_id_);
+
+    uint32_t index;
+    if (!free_entries_.empty()) {
+        index = free_entries_.back();
+        free_entries_.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    }
+    ObjectEntry& entry = entries_[index];
+    entry.object = ptr;
+    entry.dense_index = static_cast<uint32_t>(game_objects_.size());
+
+    ptr->world_ = this;
+    ptr->handle_ = { index, entry.generation, world_id_ };
     game_objects_.emplace_back(std::move(obj));
+
+    // 登録前に非アクティブにされていた場合も破棄待ちに積む
+    if (!ptr->IsActive()) MarkPendingKill(ptr);
     return ptr;
 }
 
 void World::Update(float elapsed_time) {
+    PROFILE_SCOPE("World::Update");
+
+    // 前回の更新以降に(読み込みスレッドなどで)生成されたオブジェクトを一括処理の対象にする
+    TransformStorage::Instance().PublishPendingSlots();
+
     ApplyPhysics(elapsed_time);
+    UpdateObjects(elapsed_time);
 
-    for (auto& obj : game_objects_) {
-        if (obj && obj->IsActive()) {
-            obj->Update(elapsed_time);
-            obj->UpdatePosition(elapsed_time);
-        }
-    }
+    // 更新処理の中で生成されたオブジェクトも、このフレームから積分する
+    TransformStorage::Instance().PublishPendingSlots();
+
+    BuildHierarchyOrder();
+    IntegratePositions(elapsed_time);
+    PropagateTransforms();
 
     DetectCollisions();
-    RemoveInactiveObjects();
+    ApplyDeferredCommands();
+    ProcessPendingKills();
 }
 
 void World::Render(const RenderContext& rc, ModelRenderer* model_renderer) {
-    for (auto& obj : game_objects_) {
-        if (obj && obj->IsActive()) {
-            obj->Render(rc, model_renderer);
+    PROFILE_SCOPE("World::Render");
+
+    TransformStorage& storage = TransformStorage::Instance();
+    const bool culling = culling_enabled_ && rc.camera;
+    const OcclusionMode previous_occlusion_mode = culling_stats_.occlusion_mode;
+    culling_stats_ = {};
+    ++render_frame_;
+
+    // 影のカスケードは描画予約より前に決めておき、キャスターも同じ境界ボックスで判定する
+    ShadowCascades* shadow_cascades = culling && model_renderer ? &model_renderer->UpdateShadowCascades(rc) : nullptr;
+
+    // 遮蔽判定は視錐台カリングで画面内に残ったものだけを対象にする
+    const OcclusionMode occlusion_mode = culling && model_renderer ? ResolveOcclusionMode() : OcclusionMode::kNone;
+    culling_stats_.occlusion_mode = occlusion_mode;
+    if (occlusion_mode == OcclusionMode::kHiZ) {
+        // 前回までに予約した判定のうち、GPU が書き終えた分を今回の1回目の描画に使う
+        if (previous_occlusion_mode != OcclusionMode::kHiZ) hiz_active_since_ = render_frame_;
+        ReceiveHiZResults(rc);
+    }
+    occlusion_rasterizer_.ClearBoxes();
+    if (hiz_buffer_) hiz_buffer_->ClearBoxes();
+    occlusion_boxes_.clear();
+    occluders_.clear();
+
+    // モデルの境界ボックスをワールド空間へ移して、まとめて判定する
+    DirectX::XMFLOAT4X4 view_projection = {};
+    frustum_culler_.Clear();
+    box_centers_.clear();
+    box_extents_.clear();
+    if (shadow_cascades) shadow_cascades->ClearCasters();
+    if (culling) {
+        PROFILE_SCOPE("World::Cull");
+
+        DirectX::XMStoreFloat4x4(&view_projection, DirectX::XMMatrixMultiply(
+            DirectX::XMLoadFloat4x4(&rc.camera->GetView()),
+            DirectX::XMLoadFloat4x4(&rc.camera->GetProjection())));
+        frustum_culler_.SetViewProjection(view_projection, rc.camera->GetEye(), max_draw_distance_,
+            rc.camera->GetProjection()._22);
+
+        for (const std::unique_ptr<GameObject>& obj : game_objects_) {
+            if (!obj->IsActiveInHierarchy() || !obj->GetModel()) continue;
+
+            const Model* model = obj->GetModel().get();
+            DirectX::XMFLOAT3 center, extents;
+            FrustumCuller::TransformBounds(model->GetBoundsMin(), model->GetBoundsMax(),
+                storage.WorldTransform(obj->GetTransformSlot()), center, extents);
+            frustum_culler_.AddBox(center, extents);
+            if (shadow_cascades) shadow_cascades->AddCaster(center, extents);
+            box_centers_.push_back(center);
+            box_extents_.push_back(extents);
         }
+        frustum_culler_.Cull();
+        if (shadow_cascades) shadow_cascades->CullCasters();
     }
 
+    // 判定と同じ順に辿って、残ったものだけ画面サイズからLODを選んで描画予約する(モデルのないオブジェクトは常に呼ぶ)
+    // 画面外でも影を落とすものは、影のカスケードにだけ描画するように予約する
+    // 遮蔽判定が有効なら、前フレームで隠れていたものは画面に描画せず、判定の後に回す
+    size_t box_index = 0;
+    for (size_t object_index = 0; object_index < game_objects_.size(); ++object_index) {
+        GameObject* obj = game_objects_[object_index].get();
+        if (!obj->IsActiveInHierarchy()) continue;
+
+        uint32_t view_mask = ModelRenderer::kViewAll;
+        if (obj->GetModel()) {
+            const size_t index = box_index++;
+            const CullResult result = culling ? frustum_culler_.GetResult(index) : CullResult::Visible;
+            const uint32_t caster_mask = shadow_cascades ? shadow_cascades->GetCasterMask(index) : 0;
+            if (culling) {
+                view_mask = (result == CullResult::Visible ? ModelRenderer::kViewMain : 0) |
+                    ModelRenderer::ShadowViewMask(caster_mask);
+            }
+
+            if (result == CullResult::Visible) {
+                const float screen_size = culling ? frustum_culler_.GetScreenSize(index) : 0.0f;
+                obj->lod_level_ = culling && lod_enabled_ ?
+                    obj->GetModel()->SelectLod(screen_size, obj->lod_level_) : 0;
+
+                if (occlusion_mode != OcclusionMode::kNone) {
+                    // 画面内のものは全て判定し、次のフレームの1回目に描画するかを決める
+                    occlusion_boxes_.push_back(object_index);
+                    if (occlusion_mode == OcclusionMode::kSoftware) {
+                        occlusion_rasterizer_.AddBox(box_centers_[index], box_extents_[index]);
+                    }
+                    else {
+                        hiz_buffer_->AddBox(box_centers_[index], box_extents_[index]);
+                    }
+
+                    if (obj->occlusion_visible_) {
+                        occluders_.emplace_back(screen_size, object_index);
+                    }
+                    else {
+                        view_mask &= ~ModelRenderer::kViewMain;
+                        if (occlusion_mode == OcclusionMode::kHiZ) ++culling_stats_.occlusion_culled_count;
+                    }
+                }
+                if (view_mask & ModelRenderer::kViewMain) ++culling_stats_.visible_count;
+                if (view_mask == 0) continue;
+            }
+            else {
+                // 画面に入ったら、判定を待たずに1回目で描画する
+                obj->occlusion_visible_ = true;
+                obj->occlusion_reset_frame_ = render_frame_;
+
+                if (result == CullResult::FrustumCulled) ++culling_stats_.frustum_culled_count;
+                if (result == CullResult::DistanceCulled) ++culling_stats_.distance_culled_count;
+                if (view_mask == 0) continue;
+
+                // 影にだけ描画する(LODは前回の選択のまま)
+                ++culling_stats_.shadow_only_count;
+            }
+        }
+        if (model_renderer) model_renderer->SetViewMask(view_mask);
+        obj->Render(rc, model_renderer);
+    }
+    if (model_renderer) model_renderer->SetViewMask(ModelRenderer::kViewAll);
+
     if (model_renderer) {
         model_renderer->Render(rc);
     }
+
+    if (occlusion_mode != OcclusionMode::kNone) {
+        RenderSecondPhase(rc, model_renderer, occlusion_mode, view_projection);
+    }
+}
+
+World::OcclusionMode World::ResolveOcclusionMode() {
+    if (occlusion_mode_ != OcclusionMode::kHiZ) return occlusion_mode_;
+
+    // GPU で判定できなければ CPU の判定に切り替える
+    Graphics& graphics = Graphics::Instance();
+    if (!graphics.GetDepthShaderResourceView() || !HiZBuffer::IsSupported(graphics.GetDevice())) {
+        return OcclusionMode::kSoftware;
+    }
+    if (!hiz_buffer_) {
+        hiz_buffer_ = std::make_unique<HiZBuffer>(graphics.GetDevice());
+        hiz_submissions_.resize(HiZBuffer::ReadbackBufferCount);
+    }
+    return OcclusionMode::kHiZ;
+}
+
+void World::ReceiveHiZResults(const RenderContext& rc) {
+    UINT submission = 0;
+    while (hiz_buffer_->ReadResults(rc.deviceContext, submission)) {
+        const HiZSubmission& pending = hiz_submissions_[submission % hiz_submissions_.size()];
+
+        // kHiZ を使っていなかった間に予約した判定は古いので捨てる
+        if (pending.frame < hiz_active_since_) continue;
+
+        for (size_t i = 0; i < pending.objects.size(); ++i) {
+            // 破棄されたものと、予約した後に画面外へ出たもの（画面に入った時点で見える扱いにした）は除く
+            GameObject* obj = Resolve(pending.objects[i]);
+            if (!obj || obj->occlusion_reset_frame_ >= pending.frame) continue;
+            obj->occlusion_visible_ = hiz_buffer_->IsVisible(i);
+        }
+    }
+}
+
+void World::RenderSecondPhase(const RenderContext& rc, ModelRenderer* model_renderer,
+    OcclusionMode occlusion_mode, const DirectX::XMFLOAT4X4& view_projection) {
+    PROFILE_SCOPE("World::Occlusion");
+
+    if (occlusion_mode == OcclusionMode::kSoftware) {
+        RasterizeOccluders(view_projection);
+        occlusion_rasterizer_.TestBoxes();
+    }
+    else {
+        // 1回目で描画した深度バッファから Hi-Z を作り、判定を予約する
+        // 結果は待たずに次のフレーム以降で受け取るので、ここでは追加の描画はしない
+        // (読み戻し用バッファが全て結果待ちなら今回は予約せず、届いている結果を使い続ける)
+        Graphics& graphics = Graphics::Instance();
+        hiz_buffer_->Build(rc.deviceContext, graphics.GetDepthShaderResourceView(),
+            static_cast<UINT>(graphics.GetScreenWidth()), static_cast<UINT>(graphics.GetScreenHeight()));
+
+        UINT submission = 0;
+        if (hiz_buffer_->TestBoxes(rc.deviceContext, view_projection, submission)) {
+            HiZSubmission& pending = hiz_submissions_[submission % hiz_submissions_.size()];
+            pending.frame = render_frame_;
+            pending.objects.clear();
+            for (size_t object_index : occlusion_boxes_) {
+                pending.objects.push_back(game_objects_[object_index]->handle_);
+            }
+        }
+        return;
+    }
+
+    // 判定結果を次のフレームに持ち越し、前フレームは隠れていて今回見えたものを描画予約する
+    for (size_t i = 0; i < occlusion_boxes_.size(); ++i) {
+        GameObject* obj = game_objects_[occlusion_boxes_[i]].get();
+        const bool visible = occlusion_rasterizer_.IsVisible(i);
+        const bool drawn = obj->occlusion_visible_;
+        obj->occlusion_visible_ = visible;
+        if (drawn) continue;
+
+        if (!visible) {
+            ++culling_stats_.occlusion_culled_count;
+            continue;
+        }
+        ++culling_stats_.visible_count;
+        ++culling_stats_.second_phase_count;
+        model_renderer->SetViewMask(ModelRenderer::kViewMain);
+        obj->Render(rc, model_renderer);
+    }
+    model_renderer->SetViewMask(ModelRenderer::kViewAll);
+
+    // 影は1回目で描画済みなので、画面にだけ描画する
+    if (culling_stats_.second_phase_count > 0) {
+        model_renderer->Render(rc, false);
+    }
+}
+
+void World::RasterizeOccluders(const DirectX::XMFLOAT4X4& view_projection) {
+    PROFILE_SCOPE("World::RasterizeOccluders");
+
+    TransformStorage& storage = TransformStorage::Instance();
+
+    // 1回目で描画したもののうち、画面に大きく映るものから遮蔽物にする
+    const size_t occluder_count = (std::min)(occluders_.size(), kMaxOccluders);
+    std::partial_sort(occluders_.begin(), occluders_.begin() + occluder_count, occluders_.end(),
+        [](const std::pair<float, size_t>& a, const std::pair<float, size_t>& b) { return a.first > b.first; });
+
+    occlusion_rasterizer_.Begin(view_projection);
+    for (size_t i = 0; i < occluder_count; ++i) {
+        if (occluders_[i].first < kMinOccluderScreenSize) break;
+
+        const GameObject* obj = game_objects_[occluders_[i].second].get();
+        const DirectX::XMMATRIX WorldTransform = DirectX::XMLoadFloat4x4(&storage.WorldTransform(obj->GetTransformSlot()));
+        for (const Model::Mesh& mesh : obj->GetModel()->GetMeshes()) {
+            // 変形するメッシュと、抜きや半透明で向こうが見えるメッシュは遮蔽物にしない
+            if (mesh.vertexFormat != Model::VertexFormat::Static || mesh.vertices.empty()) continue;
+            if (mesh.material && mesh.material->alphaMode != Model::AlphaMode::Opaque) continue;
+
+            // 最も粗いLODで十分(LOD1以降は indices の後ろに続く位置で表される)
+            const uint32_t* indices = mesh.indices.data();
+            size_t index_count = mesh.indices.size();
+            if (!mesh.lods.empty()) {
+                UINT index_start = 0, lod_index_count = 0;
+                mesh.GetLodRange(static_cast<int>(mesh.lods.size()), index_start, lod_index_count);
+                indices = mesh.lodIndices.data() + (index_start - mesh.indices.size());
+                index_count = lod_index_count;
+            }
+
+            DirectX::XMFLOAT4X4 mesh_transform;
+            DirectX::XMStoreFloat4x4(&mesh_transform, DirectX::XMMatrixMultiply(
+                DirectX::XMLoadFloat4x4(&mesh.node->globalTransform), WorldTransform));
+            occlusion_rasterizer_.RasterizeMesh(&mesh.vertices[0].position, sizeof(Model::Vertex), mesh.vertices.size(),
+                indices, index_count, mesh_transform);
+            ++culling_stats_.occluder_count;
+        }
+    }
+    occlusion_rasterizer_.End();
 }
 
 void World::Clear() {
+    // 残っているハンドルを全て無効にしてから削除する(デストラクタで親子を辿っても破棄済みのオブジェクトを返さない)
+    free_entries_.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(entries_.size()); ++i) {
+        ObjectEntry& entry = entries_[i];
+        if (entry.object) {
+            entry.object = nullptr;
+            ++entry.generation;
+        }
+        free_entries_.push_back(i);
+    }
     game_objects_.clear();
+    pending_kills_.clear();
+    previous_collisions_.clear();
 }
 
 size_t World::GetGameObjectCount() const {
@@ -68,6 +454,118 @@ void World::DestroyGameObject(GameObject* obj) {
     obj->Destroy();
 }
 
+GameObject* World::Resolve(const GameObjectHandle& handle) const {
+    if (!handle.IsSet()) return nullptr;
+
+    // 管理表の番号は World ごとなので、別の World のハンドルでは無関係なオブジェクトを指してしまう
+    _ASSERT_EXPR(handle.world_id == world_id_, L"World::Resolve: handle belongs to another World");
+    if (handle.world_id != world_id_ || handle.index >= entries_.size()) return nullptr;
+
+    const ObjectEntry& entry = entries_[handle.index];
+    return entry.generation == handle.generation ? entry.object : nullptr;
+}
+
+void World::MarkPendingKill(GameObject* obj) {
+    std::lock_guard<std::mutex> lock(pending_kill_mutex_);
+    pending_kills_.push_back(obj->GetHandle());
+}
+
+void World::Defer(std::function<void()> command) {
+    std::lock_guard<std::mutex> lock(deferred_mutex_);
+    const bool is_serial = t_deferred_order == kSerialOrder;
+    deferred_commands_.push_back({
+        t_deferred_order,
+        is_serial ? serial_sequence_++ : t_deferred_sequence++,
+        std::move(command) });
+}
+
+bool World::IsTransformPropagationDeferred() const {
+    return t_propagation_deferred_world == this;
+}
+
+void World::SetParallelUpdate(bool enable) {
+    parallel_update_ = enable;
+}
+
+bool World::GetParallelUpdate() const {
+    return parallel_update_;
+}
+
+uint64_t World::ComputeStateHash() const {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    for (const auto& obj : game_objects_) {
+        if (!obj) continue;
+        const DirectX::XMFLOAT4X4 world_transform = obj->GetWorldTransformFloat4X4();
+        mix(&world_transform, sizeof(world_transform));
+        mix(&obj->GetVelocityFloat3(), sizeof(DirectX::XMFLOAT3));
+        const bool active = obj->IsActive();
+        mix(&active, sizeof(active));
+    }
+    return hash;
+}
+
+bool World::RunReplayTest(int object_count, int frame_count) {
+    auto simulate = [object_count, frame_count](bool parallel) {
+        World world;
+        world.SetParallelUpdate(parallel);
+
+        // 決まった乱数列で配置する
+        uint32_t random = 12345;
+        auto next = [&random](float min, float max) {
+            random = random * 1664525u + 1013904223u;
+            return min + (max - min) * static_cast<float>(random >> 8) / static_cast<float>(1u << 24);
+        };
+
+        // ゲームで使うクラスを混ぜて、ゲームと同じ生成の手順で作る
+        for (int i = 0; i < object_count; ++i) {
+            const GameObjectHandle target = i > 0 ? world.game_objects_[static_cast<size_t>(next(0.0f, static_cast<float>(i)))]->GetHandle() : GameObjectHandle();
+            GameObject* obj = nullptr;
+            switch (i % 4) {
+            case 1:
+                obj = world.CreateObject();
+                break;
+            case 2:
+                obj = world.CreateObject<Vault>();
+                break;
+            default:
+                obj = world.AddObject(std::make_unique<ReplayTestObject>(&world, target));
+                break;
+            }
+            obj->SetLocalPosition(next(-20.0f, 20.0f), next(0.0f, 20.0f), next(-20.0f, 20.0f));
+            obj->SetVelocity(next(-1.0f, 1.0f), 0.0f, next(-1.0f, 1.0f));
+            obj->AddSphereCollider(0.5f);
+
+            if (i % 8 == 7) {
+                // 子は親に付いて動く
+                obj->SetParent(world.game_objects_[i - 1].get());
+                obj->SetLocalPosition(0.0f, 1.0f, 0.0f);
+            }
+            else {
+                Rigidbody* rb = obj->AddRigidbody();
+                rb->SetDrag(0.1f);
+            }
+        }
+
+        for (int frame = 0; frame < frame_count; ++frame) {
+            world.Update(1.0f / 60.0f);
+        }
+        const uint64_t hash = world.ComputeStateHash();
+
+        world.Clear();
+        return hash;
+    };
+
+    return simulate(false) == simulate(true);
+}
+
 void World::SetGravity(const DirectX::XMFLOAT3& gravity) {
     gravity_ = gravity;
 }
@@ -84,13 +582,49 @@ bool World::GetDebugDrawColliders() const {
     return debug_draw_colliders_;
 }
 
+void World::SetCullingEnabled(bool enable) {
+    culling_enabled_ = enable;
+}
+
+bool World::GetCullingEnabled() const {
+    return culling_enabled_;
+}
+
+void World::SetMaxDrawDistance(float distance) {
+    max_draw_distance_ = distance;
+}
+
+float World::GetMaxDrawDistance() const {
+    return max_draw_distance_;
+}
+
+void World::SetLodEnabled(bool enable) {
+    lod_enabled_ = enable;
+}
+
+bool World::GetLodEnabled() const {
+    return lod_enabled_;
+}
+
+void World::SetOcclusionMode(OcclusionMode mode) {
+    occlusion_mode_ = mode;
+}
+
+World::OcclusionMode World::GetOcclusionMode() const {
+    return occlusion_mode_;
+}
+
+const World::CullingStats& World::GetCullingStats() const {
+    return culling_stats_;
+}
+
 void World::DrawDebugPrimitives(ShapeRenderer* shape_renderer) {
     if (!debug_draw_colliders_ || !shape_renderer) return;
 
     for (const auto& obj : game_objects_) {
         if (!obj || !obj->IsActive()) continue;
 
-        const std::vector<Collider*>& colliders = obj->GetColliders();
+        const GameObject::ColliderList& colliders = obj->GetColliders();
         if (colliders.empty()) continue;
 
         const DirectX::XMFLOAT4X4& world_transform = obj->GetWorldTransformFloat4X4();
@@ -132,40 +666,282 @@ void World::DrawDebugPrimitives(ShapeRenderer* shape_renderer) {
     }
 }
 
-void World::RemoveInactiveObjects() {
-    game_objects_.erase(
-        std::remove_if(game_objects_.begin(), game_objects_.end(),
-            [](const std::unique_ptr<GameObject>& obj) {
-                return !obj || !obj->IsActive();
-            }),
-        game_objects_.end());
+void World::ProcessPendingKills() {
+    PROFILE_SCOPE("World::ProcessPendingKills");
+
+    {
+        std::lock_guard<std::mutex> lock(pending_kill_mutex_);
+        kill_handles_.swap(pending_kills_);
+    }
+    if (kill_handles_.empty()) return;
+
+    // 再びアクティブにされたものと重複を除き、削除する位置を集める
+    kill_indices_.clear();
+    for (const GameObjectHandle& handle : kill_handles_) {
+        GameObject* obj = Resolve(handle);
+        if (obj && !obj->IsActive()) {
+            kill_indices_.push_back(entries_[handle.index].dense_index);
+        }
+    }
+    kill_handles_.clear();
+    if (kill_indices_.empty()) return;
+
+    // 後ろから削除すれば、末尾から移ってくる要素は削除対象でないことが保証される(削除順も実行スレッドに依らない)
+    std::sort(kill_indices_.begin(), kill_indices_.end(), std::greater<uint32_t>());
+    kill_indices_.erase(std::unique(kill_indices_.begin(), kill_indices_.end()), kill_indices_.end());
+
+    // 衝突中だった相手に離れたことを通知する
+    for (size_t i = 0; i < previous_collisions_.size();) {
+        GameObject* obj_a = Resolve(previous_collisions_[i].obj_a);
+        GameObject* obj_b = Resolve(previous_collisions_[i].obj_b);
+        const bool killed = !obj_a || !obj_b || !obj_a->IsActive() || !obj_b->IsActive();
+        if (!killed) {
+            ++i;
+            continue;
+        }
+
+        if (obj_a && obj_b) {
+            obj_a->OnCollisionExit(obj_b);
+            obj_b->OnCollisionExit(obj_a);
+        }
+        previous_collisions_[i] = previous_collisions_.back();
+        previous_collisions_.pop_back();
+    }
+
+    for (uint32_t dense_index : kill_indices_) {
+        GameObject* obj = game_objects_[dense_index].get();
+
+        // ハンドルを無効にしてから末尾の要素と入れ替えて削除する
+        ObjectEntry& entry = entries_[obj->handle_.index];
+        entry.object = nullptr;
+        ++entry.generation;
+        free_entries_.push_back(obj->handle_.index);
+
+        if (dense_index + 1 != game_objects_.size()) {
+            game_objects_[dense_index].swap(game_objects_.back());
+            entries_[game_objects_[dense_index]->handle_.index].dense_index = dense_index;
+        }
+        game_objects_.pop_back();
+    }
 }
 
 void World::ApplyPhysics(float elapsed_time) {
-    for (auto& obj : game_objects_) {
+    PROFILE_SCOPE("World::ApplyPhysics");
+
+    // 重力と抵抗の係数は Rigidbody が TransformStorage に書き込んでいるので、配列を先頭から順に処理する
+    TransformStorage& storage = TransformStorage::Instance();
+    ForEachRange(storage.GetSlotEnd(), kSweepGrainSize,
+        [this, &storage, elapsed_time](size_t begin, size_t end) {
+            storage.ApplyPhysics(world_id_, static_cast<uint32_t>(begin), static_cast<uint32_t>(end),
+                elapsed_time, gravity_);
+        });
+}
+
+void World::UpdateObjects(float elapsed_time) {
+    PROFILE_SCOPE("World::UpdateObjects");
+
+    // 更新中に生成されたオブジェクトは次のフレームから更新する
+    parallel_indices_.clear();
+    serial_indices_.clear();
+    for (size_t i = 0; i < game_objects_.size(); ++i) {
+        GameObject* obj = game_objects_[i].get();
+        if (!obj || !obj->IsActive()) continue;
+
+        if (obj->IsParallelUpdate()) {
+            parallel_indices_.push_back(i);
+        }
+        else {
+            serial_indices_.push_back(i);
+        }
+    }
+
+    // 並列更新可のオブジェクトは自分自身しか書き換えないので、モデルと子への反映は後でまとめて行う
+    // 保留はこのジョブを実行しているスレッドとこの World に限る(読み込みスレッドなどで作られるオブジェクトには影響しない)
+    ForEachRange(parallel_indices_.size(), kUpdateGrainSize,
+        [this, elapsed_time](size_t begin, size_t end) {
+            // 待機中に別のジョブを手伝った場合に備えて呼び出し元の状態を戻す
+            const size_t saved_order = t_deferred_order;
+            const uint32_t saved_sequence = t_deferred_sequence;
+            const World* saved_world = t_propagation_deferred_world;
+            t_propagation_deferred_world = this;
+            for (size_t i = begin; i < end; ++i) {
+                const size_t index = parallel_indices_[i];
+                t_deferred_order = index;
+                t_deferred_sequence = 0;
+                game_objects_[index]->Update(elapsed_time);
+            }
+            t_deferred_order = saved_order;
+            t_deferred_sequence = saved_sequence;
+            t_propagation_deferred_world = saved_world;
+        });
+
+    // 残りは従来どおり登録順に更新する(他のオブジェクトを直接書き換えてもよい)
+    for (size_t index : serial_indices_) {
+        GameObject* obj = game_objects_[index].get();
         if (!obj || !obj->IsActive()) continue;
 
-        Rigidbody* rb = obj->GetRigidbody();
-        if (rb && rb->IsEnabled()) {
-            rb->ApplyGravity(elapsed_time, gravity_);
-            rb->ApplyDrag(elapsed_time);
+        t_deferred_order = index;
+        t_deferred_sequence = 0;
+        obj->Update(elapsed_time);
+    }
+    t_deferred_order = kSerialOrder;
+
+    ApplyDeferredCommands();
+}
+
+void World::BuildHierarchyOrder() {
+    PROFILE_SCOPE("World::BuildHierarchyOrder");
+
+    // ルートから幅優先で並べる(親は必ず子より前に来る。子はルートから辿るので二重に処理されない)
+    TransformStorage& storage = TransformStorage::Instance();
+    hierarchy_order_.clear();
+    root_offsets_.clear();
+    for (const auto& root : game_objects_) {
+        if (!root || root->GetParent()) continue;
+
+        const size_t first = hierarchy_order_.size();
+        root_offsets_.push_back(first);
+        hierarchy_order_.push_back(root.get());
+        for (size_t i = first; i < hierarchy_order_.size(); ++i) {
+            GameObject* obj = hierarchy_order_[i];
+            for (const GameObjectHandle& child_handle : obj->GetChildren()) {
+                if (GameObject* child = Resolve(child_handle)) hierarchy_order_.push_back(child);
+            }
+
+            // 子は親が非アクティブでも自身の状態で判定する(kTransformOnly の子がいるため)
+            if (obj->IsActiveInHierarchy()) {
+                storage.Flags(obj->GetTransformSlot()) |= TransformStorage::kFlagIntegrate;
+            }
+        }
+    }
+    root_offsets_.push_back(hierarchy_order_.size());
+}
+
+void World::IntegratePositions(float elapsed_time) {
+    PROFILE_SCOPE("World::IntegratePositions");
+
+    TransformStorage& storage = TransformStorage::Instance();
+    ForEachRange(storage.GetSlotEnd(), kSweepGrainSize,
+        [this, &storage, elapsed_time](size_t begin, size_t end) {
+            storage.Integrate(world_id_, static_cast<uint32_t>(begin), static_cast<uint32_t>(end), elapsed_time);
+        });
+}
+
+void World::PropagateTransforms() {
+    PROFILE_SCOPE("World::PropagateTransforms");
+
+    // 各ルートの子孫は重ならないのでルート単位で並列に処理できる
+    // ワールド行列は親の計算結果に自分のローカル行列を掛けるだけにする(GetWorldTransformMatrix() と同じ演算順)
+    TransformStorage& storage = TransformStorage::Instance();
+    ForEachRange(root_offsets_.size() - 1, kUpdateGrainSize,
+        [this, &storage](size_t begin, size_t end) {
+            for (size_t i = root_offsets_[begin]; i < root_offsets_[end]; ++i) {
+                GameObject* obj = hierarchy_order_[i];
+                obj->UpdateLocalTransform();
+
+                const uint32_t slot = obj->GetTransformSlot();
+                DirectX::XMMATRIX world = DirectX::XMLoadFloat4x4(&obj->GetTransform());
+                GameObject* parent = obj->GetParent();
+                if (parent && obj->GetHierarchyType() != HierarchyType::kNone) {
+                    world = world * DirectX::XMLoadFloat4x4(&storage.WorldTransform(parent->GetTransformSlot()));
+                }
+                DirectX::XMFLOAT4X4& world_transform = storage.WorldTransform(slot);
+                DirectX::XMStoreFloat4x4(&world_transform, world);
+
+                storage.Bounds(slot) = {
+                    world_transform._41, world_transform._42, world_transform._43,
+                    ComputeBoundsRadius(obj->GetColliders(), world_transform) };
+            }
+        });
+
+    // 同じモデルを共有するオブジェクトは同じジョブで階層順に反映する(書き込みの競合と順序の揺れを防ぐ)
+    for (std::vector<GameObject*>& group : model_groups_) {
+        group.clear();
+    }
+    model_group_indices_.clear();
+    size_t group_count = 0;
+    for (GameObject* obj : hierarchy_order_) {
+        if (!obj->IsActiveInHierarchy()) continue;
+
+        Model* model = obj->GetModel().get();
+        if (!model) continue;
+
+        auto result = model_group_indices_.emplace(model, group_count);
+        if (result.second) {
+            if (model_groups_.size() <= group_count) model_groups_.emplace_back();
+            ++group_count;
+        }
+        model_groups_[result.first->second].push_back(obj);
+    }
+
+    ForEachRange(group_count, 1,
+        [this, &storage](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                for (GameObject* obj : model_groups_[i]) {
+                    obj->GetModel()->UpdateTransform(storage.WorldTransform(obj->GetTransformSlot()));
+                }
+            }
+        });
+}
+
+void World::ApplyDeferredCommands() {
+    PROFILE_SCOPE("World::ApplyDeferredCommands");
+
+    // コマンドの中で更に積まれた場合に備えて空になるまで繰り返す
+    // (2つの配列を入れ替えて使い回し、毎フレーム確保し直さない)
+    std::vector<DeferredCommand>& commands = applying_commands_;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(deferred_mutex_);
+            if (deferred_commands_.empty()) break;
+            commands.swap(deferred_commands_);
+            serial_sequence_ = 0;
+        }
+
+        // 実行スレッドに依らない順序に並べる
+        std::sort(commands.begin(), commands.end(),
+            [](const DeferredCommand& lhs, const DeferredCommand& rhs) {
+                if (lhs.order != rhs.order) return lhs.order < rhs.order;
+                return lhs.sequence < rhs.sequence;
+            });
+
+        for (DeferredCommand& command : commands) {
+            command.command();
         }
+        commands.clear();
+    }
+}
+
+void World::ForEachRange(size_t count, size_t grain_size,
+    const std::function<void(size_t, size_t)>& function) {
+    if (parallel_update_) {
+        JobSystem::Instance().ParallelFor(0, count, grain_size, function);
+    }
+    else if (count > 0) {
+        function(0, count);
     }
 }
 
 void World::DetectCollisions() {
-    std::vector<CollisionPair> current_collisions;
-    current_collisions.reserve(previous_collisions_.size() + 16);
+    PROFILE_SCOPE("World::DetectCollisions");
+
+    // 前フレームの配列を使い回してヒープ確保を避ける
+    std::vector<CollisionPair>& current_collisions = current_collisions_;
+    current_collisions.clear();
 
     const size_t object_count = game_objects_.size();
+    TransformStorage& storage = TransformStorage::Instance();
 
     for (size_t i = 0; i < object_count; ++i) {
         GameObject* obj_a = game_objects_[i].get();
         if (!obj_a || !obj_a->IsActive()) continue;
 
-        const std::vector<Collider*>& colliders_a = obj_a->GetColliders();
+        const GameObject::ColliderList& colliders_a = obj_a->GetColliders();
         if (colliders_a.empty()) continue;
 
+        // 判定中に動かされた場合は無限大になり、枝刈りされなくなる
+        const DirectX::XMFLOAT4& bounds_a = storage.Bounds(obj_a->GetTransformSlot());
+
         Rigidbody* rb_a = obj_a->GetRigidbody();
         const bool has_rigidbody = rb_a && rb_a->IsEnabled() && !rb_a->IsKinematic();
 
@@ -178,9 +954,12 @@ void World::DetectCollisions() {
             GameObject* obj_b = game_objects_[j].get();
             if (!obj_b || !obj_b->IsActive()) continue;
 
-            const std::vector<Collider*>& colliders_b = obj_b->GetColliders();
+            const GameObject::ColliderList& colliders_b = obj_b->GetColliders();
             if (colliders_b.empty()) continue;
 
+            // 外接球が離れていれば詳細判定を省く
+            if (!TransformStorage::BoundsOverlap(bounds_a, storage.Bounds(obj_b->GetTransformSlot()))) continue;
+
             bool pair_collided = false;
 
             if (has_rigidbody) {
@@ -236,7 +1015,7 @@ void World::DetectCollisions() {
             }
 
             if (pair_collided) {
-                CollisionPair pair{ obj_a, obj_b };
+                CollisionPair pair{ obj_a->GetHandle(), obj_b->GetHandle() };
                 current_collisions.push_back(pair);
 
                 const bool was_colliding = std::find(
@@ -324,15 +1103,21 @@ void World::DetectCollisions() {
         ) != current_collisions.end();
 
         if (!still_colliding) {
-            if (prev_pair.obj_a && prev_pair.obj_a->IsActive() &&
-                prev_pair.obj_b && prev_pair.obj_b->IsActive()) {
-                prev_pair.obj_a->OnCollisionExit(prev_pair.obj_b);
-                prev_pair.obj_b->OnCollisionExit(prev_pair.obj_a);
+            GameObject* obj_a = Resolve(prev_pair.obj_a);
+            GameObject* obj_b = Resolve(prev_pair.obj_b);
+            if (!obj_a || !obj_b) continue;
+
+            // 破棄待ちのオブジェクトとの組は ProcessPendingKills() で通知するので残しておく
+            if (!obj_a->IsActive() || !obj_b->IsActive()) {
+                current_collisions.push_back(prev_pair);
+                continue;
             }
+            obj_a->OnCollisionExit(obj_b);
+            obj_b->OnCollisionExit(obj_a);
         }
     }
 
-    previous_collisions_ = std::move(current_collisions);
+    previous_collisions_.swap(current_collisions);
 }
 
 bool World::CollisionPair::operator==(const CollisionPair& other) const {
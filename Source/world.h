@@ -4,24 +4,33 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <DirectXMath.h>
+#include "game_object_handle.h"
+#include "System/FrustumCuller.h"
+#include "System/OcclusionRasterizer.h"
 
 class GameObject;
 class ModelRenderer;
 class ShapeRenderer;
+class HiZBuffer;
+class Model;
 struct RenderContext;
 
 /**
  * @class World
- * @brief Q[[hǗVOgNX
+ * @brief ゲームワールドを管理するシングルトンクラス
  *
- * Q[IuWFNg̐AXVA`AZAՓ˔ꌳǗ܂B
+ * ゲームオブジェクトの生成、更新、描画、物理演算、衝突判定を一元管理します。
  */
 class World {
 public:
     /**
-     * @brief VOgCX^X擾
-     * @return World& [hCX^Xւ̎Q
+     * @brief シングルトンインスタンスを取得
+     * @return World& ワールドインスタンスへの参照
      */
     static World& Instance();
 
@@ -39,131 +48,452 @@ public:
         const DirectX::XMFLOAT3& scale = { 1.0f, 1.0f, 1.0f });
 
     /**
-     * @brief [h̍XV
-     * @param elapsed_time Ot[̌oߎ(b)
+     * @brief ワールドの更新処理
+     * @param elapsed_time 前フレームからの経過時間(秒)
      *
-     * ZAQ[IuWFNg̍XVAՓ˔AANeBuIuWFNg̍폜s܂B
+     * 次の順に実行します。並列化の有無に関わらず同じ順序で処理するため、結果はビット単位で一致します。
+     * 1. 物理演算（重力、抵抗。TransformStorage の配列を一括で処理）
+     * 2. ゲームオブジェクトの更新（並列更新可のオブジェクトを並列に、残りを登録順に）
+     * 3. 階層順の並びを作り、座標を積分（TransformStorage の配列を一括で処理）
+     * 4. 階層順にワールド行列とコライダーの外接球を計算し、モデルへ反映
+     * 5. 衝突判定（外接球が重ならない組は詳細判定を省く）
+     * 6. 遅延コマンドの実行と、破棄待ちのオブジェクトの削除
      */
     void Update(float elapsed_time);
 
     /**
-     * @brief [h̑SIuWFNg`
-     * @param rc _OReLXg
-     * @param model_renderer f_[
+     * @brief 他のオブジェクトを変更する処理を同期点まで遅らせる
+     * @param command 実行する処理
+     *
+     * どのスレッドからでも呼べます。更新処理の後と衝突判定の後に、
+     * 呼び出し元オブジェクトの登録順、同じオブジェクト内では呼び出し順で実行されます。
+     * キャプチャがポインタ数個分に収まる処理なら std::function はヒープを使いません
+     * (大きいキャプチャは毎回確保されるので、デバッグGUIのヒープ確保回数で確認してください)。
+     */
+    void Defer(std::function<void()> command);
+
+    /**
+     * @brief 呼び出したスレッドがこの World の並列更新中か取得
+     * @return bool 並列更新中の場合true（モデルと子へのトランスフォーム反映を保留する）
+     *
+     * スレッドと World の組で判定するので、読み込みスレッドや別の World のオブジェクトには影響しません。
+     */
+    bool IsTransformPropagationDeferred() const;
+
+    /**
+     * @brief 更新処理を並列に実行するか設定
+     * @param enable trueでジョブシステムを使って並列実行、falseで単一スレッド実行
+     */
+    void SetParallelUpdate(bool enable);
+
+    /**
+     * @brief 更新処理を並列に実行するか取得
+     * @return bool 並列実行する場合true
+     */
+    bool GetParallelUpdate() const;
+
+    /**
+     * @brief 全オブジェクトのトランスフォームと速度のハッシュ値を計算
+     * @return uint64_t ハッシュ値（浮動小数点値をビット単位で比較する）
+     */
+    uint64_t ComputeStateHash() const;
+
+    /**
+     * @brief 単一スレッド実行と並列実行で結果が一致するか検証
+     * @param object_count テスト用オブジェクト数
+     * @param frame_count 更新するフレーム数
+     * @return bool 全オブジェクトの状態がビット単位で一致した場合true
+     *
+     * 同じ初期配置のワールドを2つ作り、それぞれのモードで更新して比較します。
+     */
+    static bool RunReplayTest(int object_count = 256, int frame_count = 120);
+
+    /**
+     * @enum OcclusionMode
+     * @brief 遮蔽物に隠れたオブジェクトの判定方法
+     */
+    enum class OcclusionMode {
+        kNone,      ///< 判定しない
+        kSoftware,  ///< CPU で遮蔽物を低解像度の深度バッファに描画して判定
+        kHiZ,       ///< 描画した深度バッファから GPU で Hi-Z を作って判定（結果は数フレーム遅れて届く。非対応なら kSoftware）
+    };
+
+    /**
+     * @struct CullingStats
+     * @brief 直前の Render() でのカリング結果
+     */
+    struct CullingStats {
+        size_t visible_count = 0;         ///< 描画したモデル付きオブジェクト数
+        size_t frustum_culled_count = 0;  ///< 視錐台の外で省いた数
+        size_t distance_culled_count = 0; ///< 描画距離より遠くて省いた数
+        size_t shadow_only_count = 0;     ///< 画面外だが影だけを描画した数(上の2つにも含む)
+        size_t occlusion_culled_count = 0; ///< 遮蔽物に隠れて省いた数（kHiZ では届いている最新の判定結果で省いた数）
+        size_t second_phase_count = 0;    ///< 前フレームは隠れていて、判定の後に追加で描画した数（kSoftware のみ。visible_count にも含む）
+        size_t occluder_count = 0;        ///< CPU の深度バッファに描画した遮蔽物のメッシュ数
+        OcclusionMode occlusion_mode = OcclusionMode::kNone; ///< 実際に使った判定方法
+    };
+
+    /**
+     * @brief ワールド内の全オブジェクトを描画
+     * @param rc レンダリングコンテキスト
+     * @param model_renderer モデルレンダラー
+     *
+     * モデルの境界ボックスをワールド行列で変換し、カメラの視錐台と描画距離で判定してから描画予約します。
+     * 各オブジェクトの Render() は1回ずつ呼ばれます（子は親からではなく World から呼ばれます）。
+     * 画面外のオブジェクトも、影のカスケードに入るものは影にだけ描画するように予約します。
+     *
+     * 遮蔽判定が有効な場合は2回に分けて描画します。
+     * 1. 前フレームで見えていたものを描画し、その深度で遮蔽物を用意する（CPU の深度バッファか GPU の Hi-Z）
+     * 2. 画面内の全てのボックスを判定し、前フレームは隠れていて今回見えたものを追加で描画する
+     * 判定結果は次のフレームの1回目に描画するものになります。
      */
     void Render(const RenderContext& rc, ModelRenderer* model_renderer);
 
     /**
-     * @brief [h̑SQ[IuWFNg폜
+     * @brief 描画時のカリングを有効/無効化
+     * @param enable trueで有効、falseで全て描画予約
+     */
+    void SetCullingEnabled(bool enable);
+
+    /**
+     * @brief 描画時のカリングが有効かどうか取得
+     * @return bool 有効な場合true
+     */
+    bool GetCullingEnabled() const;
+
+    /**
+     * @brief 描画距離を設定
+     * @param distance 視点からの距離（0以下で無制限）
+     */
+    void SetMaxDrawDistance(float distance);
+
+    /**
+     * @brief 描画距離を取得
+     * @return float 視点からの距離（0以下で無制限）
+     */
+    float GetMaxDrawDistance() const;
+
+    /**
+     * @brief 画面サイズによるモデルの詳細度切り替えを有効/無効化
+     * @param enable trueで有効、falseで常にLOD0（カリングが無効な場合も LOD0）
+     */
+    void SetLodEnabled(bool enable);
+
+    /**
+     * @brief 詳細度切り替えが有効かどうか取得
+     * @return bool 有効な場合true
+     */
+    bool GetLodEnabled() const;
+
+    /**
+     * @brief 遮蔽判定の方法を設定
+     * @param mode 判定方法（kNone で無効。視錐台カリングが無効な場合も判定しない）
+     */
+    void SetOcclusionMode(OcclusionMode mode);
+
+    /**
+     * @brief 遮蔽判定の方法を取得
+     * @return OcclusionMode 判定方法
+     */
+    OcclusionMode GetOcclusionMode() const;
+
+    /**
+     * @brief 直前の Render() でのカリング結果を取得
+     * @return const CullingStats& カリング結果
+     */
+    const CullingStats& GetCullingStats() const;
+
+    /**
+     * @brief ワールド内の全ゲームオブジェクトを削除
      */
     void Clear();
 
     /**
-     * @brief Q[IuWFNg̑擾
-     * @return size_t IuWFNg
+     * @brief ゲームオブジェクトの総数を取得
+     * @return size_t オブジェクト数
      */
     size_t GetGameObjectCount() const;
 
     /**
-     * @brief CfbNXw肵ăQ[IuWFNg擾
-     * @param index IuWFNg̃CfbNX
-     * @return GameObject* IuWFNgւ̃|C^i͈͊Ȍꍇnullptrj
+     * @brief インデックスを指定してゲームオブジェクトを取得
+     * @param index オブジェクトのインデックス
+     * @return GameObject* オブジェクトへのポインタ（範囲外の場合はnullptr）
      */
     GameObject* GetGameObject(size_t index);
 
     /**
-     * @brief Q[IuWFNgj
-     * @param obj jIuWFNgւ̃|C^
+     * @brief ゲームオブジェクトを破棄
+     * @param obj 破棄するオブジェクトへのポインタ
+     *
+     * その場では非アクティブにして破棄待ちに積むだけで、実際の削除は Update() の最後に行います。
      */
     void DestroyGameObject(GameObject* obj);
 
     /**
-     * @brief d͉xݒ
-     * @param gravity d̓xNgiftHg: (0, -9.8, 0)j
+     * @brief ハンドルからゲームオブジェクトを取得（O(1)）
+     * @param handle ハンドル
+     * @return GameObject* オブジェクト（破棄済みならnullptr）
+     */
+    GameObject* Resolve(const GameObjectHandle& handle) const;
+
+    /**
+     * @brief ハンドルからゲームオブジェクトを型を指定して取得（O(1)）
+     * @tparam T 登録時の型（GameObjectの派生クラス）
+     * @param handle ハンドル
+     * @return T* オブジェクト（破棄済みならnullptr）
+     */
+    template<typename T>
+    T* Resolve(const GameObjectHandle& handle) const {
+        return static_cast<T*>(Resolve(handle));
+    }
+
+    /**
+     * @brief 非アクティブになったオブジェクトを破棄待ちに積む
+     * @param obj オブジェクト
+     *
+     * GameObject::SetActive() から呼ばれます。どのスレッドからでも呼べます。
+     */
+    void MarkPendingKill(GameObject* obj);
+
+    /**
+     * @brief 重力加速度を設定
+     * @param gravity 重力ベクトル（デフォルト: (0, -9.8, 0)）
      */
     void SetGravity(const DirectX::XMFLOAT3& gravity);
 
     /**
-     * @brief ݂̏d͉x擾
-     * @return const DirectX::XMFLOAT3& d̓xNg
+     * @brief 現在の重力加速度を取得
+     * @return const DirectX::XMFLOAT3& 重力ベクトル
      */
     const DirectX::XMFLOAT3& GetGravity() const;
 
     /**
-     * @brief RC_[̃fobO`L/
-     * @param enable trueŗLAfalseŖ
+     * @brief コライダーのデバッグ描画を有効/無効化
+     * @param enable trueで有効、falseで無効
      */
     void SetDebugDrawColliders(bool enable);
 
     /**
-     * @brief RC_[̃fobO`悪Lǂ擾
-     * @return bool Lȏꍇtrue
+     * @brief コライダーのデバッグ描画が有効かどうか取得
+     * @return bool 有効な場合true
      */
     bool GetDebugDrawColliders() const;
 
     /**
-     * @brief fobOp̃RC_[``
-     * @param shape_renderer }``p_[
+     * @brief デバッグ用のコライダー形状を描画
+     * @param shape_renderer 図形描画用レンダラー
      */
     void DrawDebugPrimitives(ShapeRenderer* shape_renderer);
 
 private:
     /**
-     * @brief RXgN^iVOĝprivatej
+     * @brief コンストラクタ（シングルトンのためprivate）
      */
     World();
 
     /**
-     * @brief fXgN^
+     * @brief デストラクタ
      */
-    ~World() = default;
+    ~World();
 
     /**
-     * @brief Rs[RXgN^i폜j
+     * @brief コピーコンストラクタ（削除）
      */
     World(const World&) = delete;
 
     /**
-     * @brief Zqi폜j
+     * @brief 代入演算子（削除）
      */
     World& operator=(const World&) = delete;
 
     /**
-     * @brief ANeBuȃIuWFNgXg폜
+     * @brief 破棄待ちのうち、まだ非アクティブなオブジェクトを削除
+     *
+     * 末尾の要素と入れ替えて削除するので、全オブジェクトを走査しません。
+     * 衝突中だった相手には OnCollisionExit() を通知します。
      */
-    void RemoveInactiveObjects();
+    void ProcessPendingKills();
 
     /**
-     * @brief ZKpid́AŔj
-     * @param elapsed_time oߎ
+     * @brief 物理演算を適用（重力、抵抗力）
+     * @param elapsed_time 経過時間
      */
     void ApplyPhysics(float elapsed_time);
 
     /**
-     * @brief SIuWFNgԂ̏Փ˔ƕs
+     * @brief 各オブジェクトの Update() を実行
+     * @param elapsed_time 経過時間
+     */
+    void UpdateObjects(float elapsed_time);
+
+    /**
+     * @brief ルートから子孫へ辿った並びを作り、積分対象のスロットに印を付ける
+     */
+    void BuildHierarchyOrder();
+
+    /**
+     * @brief 印を付けたスロットの座標を速度で積分
+     * @param elapsed_time 経過時間
+     */
+    void IntegratePositions(float elapsed_time);
+
+    /**
+     * @brief 階層順にトランスフォームとコライダーの外接球を更新し、モデルへ反映
+     */
+    void PropagateTransforms();
+
+    /**
+     * @brief ゲームオブジェクトを登録
+     * @param obj 登録するオブジェクト
+     * @return GameObject* 登録したオブジェクト
+     */
+    GameObject* AddObject(std::unique_ptr<GameObject> obj);
+
+    /**
+     * @brief 遅延コマンドを実行
+     */
+    void ApplyDeferredCommands();
+
+    /**
+     * @brief [0, count) を範囲に分けて処理（並列更新が無効なら一括で処理）
+     * @param count 要素数
+     * @param grain_size 1ジョブあたりの要素数
+     * @param function 範囲 [begin, end) を処理する関数
+     */
+    void ForEachRange(size_t count, size_t grain_size,
+        const std::function<void(size_t, size_t)>& function);
+
+    /**
+     * @brief 全オブジェクト間の衝突判定と物理応答を実行
      */
     void DetectCollisions();
 
+    /**
+     * @brief 使う遮蔽判定の方法を決める（GPU で判定できなければ CPU に切り替え、必要なら Hi-Z を作る）
+     * @return OcclusionMode 今回使う判定方法
+     */
+    OcclusionMode ResolveOcclusionMode();
+
+    /**
+     * @brief GPU の遮蔽判定の結果を、待たずに届いている分だけ各オブジェクトに反映
+     * @param rc レンダリングコンテキスト
+     *
+     * 判定した後に画面外へ出たオブジェクトや、破棄されたオブジェクトの結果は捨てます。
+     */
+    void ReceiveHiZResults(const RenderContext& rc);
+
+    /**
+     * @brief 1回目の描画の後に遮蔽判定し、前フレームは隠れていて今回見えたものを描画
+     * @param rc レンダリングコンテキスト
+     * @param model_renderer モデルレンダラー
+     * @param occlusion_mode 判定方法（kSoftware か kHiZ）
+     * @param view_projection カメラのビュープロジェクション行列
+     *
+     * kHiZ では判定を GPU に予約するだけで、結果は次のフレーム以降の ReceiveHiZResults() で反映します。
+     * 結果を待たないので、追加の描画はしません。
+     */
+    void RenderSecondPhase(const RenderContext& rc, ModelRenderer* model_renderer,
+        OcclusionMode occlusion_mode, const DirectX::XMFLOAT4X4& view_projection);
+
+    /**
+     * @brief 1回目で描画したもののうち画面に大きく映るものを、CPU の深度バッファに描画
+     * @param view_projection カメラのビュープロジェクション行列
+     */
+    void RasterizeOccluders(const DirectX::XMFLOAT4X4& view_projection);
+
     /**
      * @struct CollisionPair
-     * @brief Փ˃yA\\
+     * @brief 衝突ペアを表す構造体
      */
     struct CollisionPair {
-        GameObject* obj_a; ///< IuWFNgA
-        GameObject* obj_b; ///< IuWFNgB
+        GameObjectHandle obj_a; ///< オブジェクトA
+        GameObjectHandle obj_b; ///< オブジェクトB
 
         /**
-         * @brief Փ˃yA̓r
-         * @param other rΏ
-         * @return bool yAisj̏ꍇtrue
+         * @brief 衝突ペアの等価比較
+         * @param other 比較対象
+         * @return bool 同じペア（順序不問）の場合true
          */
         bool operator==(const CollisionPair& other) const;
     };
 
-    bool debug_draw_colliders_ = _DEBUG; ///< fobO`tO
-    std::vector<CollisionPair> previous_collisions_; ///< Ot[̏Փ˃yAXg
-    std::vector<std::unique_ptr<GameObject>> game_objects_; ///< Ǘ̃Q[IuWFNg
-    DirectX::XMFLOAT3 gravity_; ///< d̓xNg
+    /**
+     * @struct DeferredCommand
+     * @brief 遅延コマンド
+     */
+    struct DeferredCommand {
+        size_t order;                   ///< 呼び出し元オブジェクトの登録順
+        uint32_t sequence;              ///< 同じ呼び出し元での呼び出し順
+        std::function<void()> command;  ///< 実行する処理
+    };
+
+    static constexpr size_t kSweepGrainSize = 4096; ///< TransformStorage の配列を並列に走査する際の1ジョブあたりのスロット数
+    static constexpr size_t kUpdateGrainSize = 16; ///< 更新処理を並列化する際の1ジョブあたりのオブジェクト数
+    static constexpr size_t kSerialOrder = SIZE_MAX; ///< オブジェクトの更新処理以外から呼ばれた遅延コマンドの順番
+    static constexpr size_t kMaxOccluders = 32; ///< CPU の深度バッファに描画する遮蔽物のオブジェクト数の上限
+    static constexpr float kMinOccluderScreenSize = 0.05f; ///< 遮蔽物にする画面サイズの下限
+
+    /**
+     * @struct ObjectEntry
+     * @brief ハンドルからオブジェクトを引く管理表の要素
+     */
+    struct ObjectEntry {
+        GameObject* object = nullptr; ///< 登録中のオブジェクト（空きならnullptr）
+        uint32_t generation = 0;      ///< 削除のたびに進む世代番号
+        uint32_t dense_index = 0;     ///< game_objects_ 上の位置
+    };
+
+    /**
+     * @struct HiZSubmission
+     * @brief GPU に予約した遮蔽判定1回分の対象
+     */
+    struct HiZSubmission {
+        uint32_t frame = 0;                    ///< 判定を予約した render_frame_
+        std::vector<GameObjectHandle> objects; ///< 判定したオブジェクト（ボックスの追加順）
+    };
+
+    static inline uint16_t next_world_id_ = 1; ///< 次に生成する World の識別子
+
+    uint16_t world_id_; ///< TransformStorage 上で自分のオブジェクトを見分ける識別子
+    bool parallel_update_ = true; ///< 更新処理を並列に実行するか
+    std::mutex deferred_mutex_; ///< 遅延コマンドの排他
+    std::vector<DeferredCommand> deferred_commands_; ///< 遅延コマンド
+    std::vector<DeferredCommand> applying_commands_; ///< 実行中の遅延コマンド（作業用）
+    uint32_t serial_sequence_ = 0; ///< 更新処理以外から呼ばれた遅延コマンドの呼び出し順
+
+    std::vector<size_t> parallel_indices_; ///< 並列に更新するオブジェクト（作業用）
+    std::vector<size_t> serial_indices_; ///< 登録順に更新するオブジェクト（作業用）
+    std::vector<GameObject*> hierarchy_order_; ///< 階層順に並べたオブジェクト（作業用）
+    std::vector<size_t> root_offsets_; ///< hierarchy_order_ 上の各ルートの先頭（末尾に要素数を追加。作業用）
+    std::vector<std::vector<GameObject*>> model_groups_; ///< 同じモデルを使うオブジェクトのまとまり（作業用）
+    std::unordered_map<Model*, size_t> model_group_indices_; ///< モデルからまとまりへの対応（作業用）
+
+    bool debug_draw_colliders_ = _DEBUG; ///< デバッグ描画フラグ
+    bool culling_enabled_ = true; ///< 描画時のカリングを行うか
+    float max_draw_distance_ = 0.0f; ///< 描画距離（0以下で無制限）
+    bool lod_enabled_ = true; ///< 画面サイズで詳細度を切り替えるか
+    FrustumCuller frustum_culler_; ///< 描画時のカリング（作業用）
+    CullingStats culling_stats_; ///< 直前の Render() でのカリング結果
+    OcclusionMode occlusion_mode_ = OcclusionMode::kNone; ///< 遮蔽判定の方法
+    OcclusionRasterizer occlusion_rasterizer_; ///< CPU の遮蔽判定（作業用）
+    std::unique_ptr<HiZBuffer> hiz_buffer_; ///< GPU の遮蔽判定（最初に使う際に作る）
+    std::vector<HiZSubmission> hiz_submissions_; ///< 結果待ちの判定の対象（HiZBuffer の読み戻し用バッファごと）
+    uint32_t render_frame_ = 0; ///< Render() を呼んだ回数
+    uint32_t hiz_active_since_ = 0; ///< kHiZ で判定し始めた render_frame_（それより前の結果は捨てる）
+    std::vector<size_t> occlusion_boxes_; ///< 遮蔽判定するオブジェクトの game_objects_ 上の位置（作業用）
+    std::vector<std::pair<float, size_t>> occluders_; ///< 遮蔽物の候補の画面サイズと game_objects_ 上の位置（作業用）
+    std::vector<DirectX::XMFLOAT3> box_centers_; ///< 判定したボックスの中心（作業用）
+    std::vector<DirectX::XMFLOAT3> box_extents_; ///< 判定したボックスの半分の大きさ（作業用）
+    std::vector<CollisionPair> previous_collisions_; ///< 前フレームの衝突ペアリスト
+    std::vector<CollisionPair> current_collisions_; ///< 今フレームの衝突ペアリスト（作業用）
+    std::vector<std::unique_ptr<GameObject>> game_objects_; ///< 管理中のゲームオブジェクト
+    std::vector<ObjectEntry> entries_; ///< ハンドルの管理表
+    std::vector<uint32_t> free_entries_; ///< 空いている管理表の番号
+    std::mutex pending_kill_mutex_; ///< 破棄待ちリストの排他
+    std::vector<GameObjectHandle> pending_kills_; ///< 破棄待ちのオブジェクト
+    std::vector<GameObjectHandle> kill_handles_; ///< 今回処理する破棄待ち（作業用）
+    std::vector<uint32_t> kill_indices_; ///< 削除する game_objects_ 上の位置（作業用）
+    DirectX::XMFLOAT3 gravity_; ///< 重力ベクトル
 };
 
 template<typename T>
@@ -173,14 +503,14 @@ T* World::CreateObject(
     const DirectX::XMFLOAT3& rotation,
     const DirectX::XMFLOAT3& scale) {
     static_assert(std::is_base_of<GameObject, T>::value,
-        "NXGameObjectłNX<>Ŏw肵Ă");
+        "基底クラスがGameObjectであるクラスを<>で指定してください");
     auto obj = std::make_unique<T>();
     T* ptr = obj.get();
 	if (model_filepath) ptr->SetModel(model_filepath);
     ptr->SetLocalPosition(pos);
     ptr->SetAngle(rotation);
     ptr->SetScale(scale);
-    game_objects_.emplace_back(std::move(obj));
+    AddObject(std::move(obj));
     return ptr;
 }
 